@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_X86_ENGINE_OPTIONS_H_
 
 #include "ppl/nn/common/common.h"
+#include "ppl/common/types.h"
 #include "ppl/nn/engines/x86/x86_options.h"
 #include <stdint.h>
 
@@ -26,6 +27,19 @@ namespace ppl { namespace nn {
 
 struct PPLNN_PUBLIC X86EngineOptions final {
     uint32_t mm_policy = X86_MM_COMPACT;
+    uint32_t dynamic_tuning_level = X86_TUNING_OFF;
+    /** DATATYPE_FLOAT32 or DATATYPE_BFLOAT16. with bf16, conv/gemm/matmul weights are stored as bf16
+        and accumulated in fp32 on avx512-bf16 or amx-bf16. gemm with a non-constant B rounds both
+        inputs to bf16 on every run, while matmul with a non-constant B stays fp32. tensors between
+        kernels stay fp32. */
+    uint32_t forward_precision = ppl::common::DATATYPE_FLOAT32;
+    /** number of threads each runtime runs kernels with. 0 means omp default. */
+    uint32_t num_threads = 0;
+    /** huge pages for constants, packed weights and runtime buffers. see X86_HUGE_PAGE_*. linux only. */
+    uint32_t huge_page = X86_HUGE_PAGE_NONE;
+    /** numa node that constants, packed weights and runtime buffers are bound to. negative means no binding.
+        linux only. */
+    int32_t numa_node_id = -1;
 };
 
 }} // namespace ppl::nn
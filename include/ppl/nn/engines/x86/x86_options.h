@@ -42,6 +42,75 @@ enum {
     */
     X86_CONF_DISABLE_AVX_FMA3 = 1,
 
+    /**
+       @param file a file used to store selected algorithms and converted weights of kernels
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_EXPORT_PACKED_WEIGHTS, file);
+       @endcode
+    */
+    X86_CONF_EXPORT_PACKED_WEIGHTS = 2,
+
+    /**
+       @param file a file generated by `X86_CONF_EXPORT_PACKED_WEIGHTS`. it is mapped into memory
+       and used to skip algorithm selection and weight conversion. kernels not found in
+       this file, or whose params or source weights differ from the ones recorded in it,
+       are processed as usual.
+
+       @note the file is rejected if it is generated with different isa or library version.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_IMPORT_PACKED_WEIGHTS, file);
+       @endcode
+    */
+    X86_CONF_IMPORT_PACKED_WEIGHTS = 3,
+
+    /**
+       @param file a file used to store tuning results of conv algorithms. results in this file
+       are used if exist, and new results are appended to it.
+
+       @note only works when `X86EngineOptions::dynamic_tuning_level` is not `X86_TUNING_OFF`.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_TUNING_CACHE_FILE, file);
+       @endcode
+    */
+    X86_CONF_SET_TUNING_CACHE_FILE = 4,
+
+    /**
+       @param json_str quantization info in the same json format as `CUDA_CONF_SET_QUANT_INFO`.
+       Conv and Gemm nodes marked as "INT8" in "op_info" whose input tensor has a per-tensor
+       "tensor_max"/"tensor_min" in "quant_info" run with int8 kernels. inputs and outputs
+       of these kernels are still fp32.
+
+       @note int8 kernels use avx512-vnni or avx2 if available and enabled by isa options.
+
+       @note example:
+       @code{.cpp}
+       x86_engine->Configure(X86_CONF_SET_QUANT_INFO, json_str);
+       @endcode
+    */
+    X86_CONF_SET_QUANT_INFO = 5,
+
+    /**
+       @param cores `const int32_t*` cpu ids that kernel threads of runtimes created afterwards are pinned to
+       @param num_cores `uint32_t` number of ids in `cores`. 0 turns off binding.
+
+       @note each runtime uses its own team of `X86EngineOptions::num_threads` threads, pinned to the
+       first `num_threads` cores. runtimes running side by side can be given disjoint cores by
+       calling this before creating each of them.
+
+       @note example:
+       @code{.cpp}
+       int32_t cores[] = {16, 17, 18, 19};
+       x86_engine->Configure(X86_CONF_SET_CORE_BINDING, cores, 4u);
+       @endcode
+    */
+    X86_CONF_SET_CORE_BINDING = 6,
+
     /** max value */
     X86_CONF_MAX,
 };
@@ -55,6 +124,27 @@ enum {
     X86_MM_MRU = 1,
 };
 
+/** @brief pages that constants, packed weights and runtime buffers are allocated from */
+enum {
+    /** regular pages */
+    X86_HUGE_PAGE_NONE = 0,
+
+    /** 2MB huge pages. transparent huge pages are used if no 2MB page is reserved in the system. */
+    X86_HUGE_PAGE_2M = 1,
+
+    /** 1GB huge pages. transparent huge pages are used if no 1GB page is reserved in the system. */
+    X86_HUGE_PAGE_1G = 2,
+};
+
+/** @brief dynamic tuning level */
+enum {
+    /** turn off dynamic tuning */
+    X86_TUNING_OFF = 0,
+
+    /** benchmark all supported algorithms of conv and select the fastest one */
+    X86_TUNING_SELECT_ALGO = 1,
+};
+
 /** @brief options for x86::DeviceContext::Configure() */
 enum {
     /** @brief memory defragmentation. make sure that device is not used when performing defragmentations. */
@@ -26,21 +26,41 @@
 
 namespace ppl { namespace nn {
 
+struct PPLNN_PUBLIC OnnxRuntimeBuilderOptions final {
+    /**
+       dims of model inputs, in the order of inputs of the model. an empty element keeps the corresponding input
+       dynamic. the graph is specialized for these dims: shape computations depending only on them are folded into
+       constants when building, and runtimes created by the builder MUST be fed with inputs of the same shapes.
+    */
+    std::vector<std::vector<int64_t>> input_dims;
+};
+
 class PPLNN_PUBLIC OnnxRuntimeBuilderFactory final {
 public:
     /**
        @brief create an `RuntimeBuilder` instance from a model file
        @param engines used to process this model
-       @note engines are managed by the caller
+       @note engines are managed by the caller. initializers stored as external data are memory-mapped from files
+       relative to the directory of `model_file`, and these files must not be modified while the builder and its
+       runtimes are alive.
     */
     static RuntimeBuilder* Create(const char* model_file, Engine** engines, uint32_t engine_num);
 
     /**
        @brief create an `RuntimeBuilder` instance from a buffer
        @param engines used to process this model
-       @note engines are managed by the caller
+       @note engines are managed by the caller. locations of external data are relative to the current working
+       directory.
     */
     static RuntimeBuilder* Create(const char* model_buf, uint64_t buf_len, Engine** engines, uint32_t engine_num);
+
+    /** @brief same as the above, with graphs specialized by `options` */
+    static RuntimeBuilder* Create(const char* model_file, Engine** engines, uint32_t engine_num,
+                                  const OnnxRuntimeBuilderOptions& options);
+
+    /** @brief same as the above, with graphs specialized by `options` */
+    static RuntimeBuilder* Create(const char* model_buf, uint64_t buf_len, Engine** engines, uint32_t engine_num,
+                                  const OnnxRuntimeBuilderOptions& options);
 };
 
 }} // namespace ppl::nn
@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_BATCH_RUNNER_H_
+#define _ST_HPC_PPL_NN_RUNTIME_BATCH_RUNNER_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/nn/common/common.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include <future>
+#include <vector>
+
+namespace ppl { namespace nn {
+
+struct PPLNN_PUBLIC BatchRunnerOptions final {
+    /** max number of samples run together. a request larger than it is run alone. */
+    uint32_t max_batch_size = 8;
+    /** max time in microseconds that the earliest queued request waits for other requests */
+    uint32_t timeout_us = 1000;
+    /** number of runtimes(and worker threads) running batches at the same time */
+    uint32_t runtime_num = 1;
+};
+
+struct PPLNN_PUBLIC BatchRequest final {
+    /**
+       host data of each input in `DATAFORMAT_NDARRAY`.
+       @note data MUST be valid until the request is done.
+    */
+    std::vector<const void*> inputs;
+    /** shapes of `inputs`. dim 0 is the number of samples, which are usually 1. */
+    std::vector<TensorShape> input_shapes;
+};
+
+struct PPLNN_PUBLIC BatchResult final {
+    ppl::common::RetCode status = ppl::common::RC_SUCCESS;
+    /** shapes of `outputs`. dim 0 is the number of samples of the request. */
+    std::vector<TensorShape> output_shapes;
+    /** host data of each output in `DATAFORMAT_NDARRAY` */
+    std::vector<std::vector<char>> outputs;
+};
+
+/**
+   @class BatchRunner
+   @brief queues requests submitted by different threads, concatenates inputs of requests along dim 0 and runs
+   them with one `Runtime::Run()`, then splits outputs back to requests.
+   @note requests are batched only if their inputs have the same data types and the same dims except dim 0.
+   outputs whose dim 0 does not equal the batch size are copied to every request of the batch.
+*/
+class PPLNN_PUBLIC BatchRunner {
+public:
+    virtual ~BatchRunner() {}
+
+    /** @brief get the number of inputs of each request. */
+    virtual uint32_t GetInputCount() const = 0;
+
+    /** @brief get the number of outputs of each request. */
+    virtual uint32_t GetOutputCount() const = 0;
+
+    /**
+       @brief queues a request. the returned future becomes ready when outputs of the request are available.
+       @note this function is thread-safe.
+    */
+    virtual std::future<BatchResult> Submit(const BatchRequest&) = 0;
+};
+
+}} // namespace ppl::nn
+
+#endif
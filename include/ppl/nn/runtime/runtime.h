@@ -34,6 +34,41 @@ enum {
     */
     RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG = 0,
 
+    /**
+       @brief args: none. runs kernels one by one in topological order. this is the default scheduler.
+    */
+    RUNTIME_CONF_SCHED_SEQ = 1,
+
+    /**
+       @brief args: uint32_t thread_num. runs kernels whose inputs are ready in `thread_num` threads,
+       including the thread calling `Run()`. 0 means the number of hardware threads.
+       @note kernels may use multiple threads themselves(OpenMP for example). make sure that the total number
+       of threads does not exceed the number of available cores.
+    */
+    RUNTIME_CONF_SCHED_PARALLEL = 2,
+
+    /**
+       @brief args: true/false. switches to the sequential scheduler and assigns each intermediate tensor a fixed
+       offset in one arena per device, so that `Run()` does not allocate or free buffers of these tensors.
+       the plan is generated by the first `Run()` after enabling it, and regenerated when shapes of inputs change.
+       @note arena size and peak size of live tensors are printed in INFO level.
+    */
+    RUNTIME_CONF_SET_MEMORY_PLAN_FLAG = 3,
+
+    /**
+       @brief args: true/false. records begin/end timestamps and thread ids of every kernel and every `Run()`, as well
+       as buffer allocations and deallocations. enabling it discards previously recorded events.
+       @note available if `PPLNN_ENABLE_KERNEL_PROFILING` is enabled. events are kept in memory until tracing is
+       disabled, so do not leave it on for long runs.
+    */
+    RUNTIME_CONF_SET_TRACING_FLAG = 4,
+
+    /**
+       @brief args: const char* filename. saves events recorded after enabling `RUNTIME_CONF_SET_TRACING_FLAG` in
+       Chrome trace event format, which can be loaded by chrome://tracing or https://ui.perfetto.dev.
+    */
+    RUNTIME_CONF_SAVE_TRACE = 5,
+
     RUNTIME_CONF_MAX,
 };
 
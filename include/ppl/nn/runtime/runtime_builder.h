@@ -23,9 +23,21 @@
 
 namespace ppl { namespace nn {
 
+/**
+   @class RuntimeBuilder
+   @brief creates `Runtime` instances of a model.
+   @note runtimes created by the same builder share the graph, constants and weights converted by engines,
+   and can `Run()` in different threads at the same time. a `Runtime` MUST NOT be used by more than one thread
+   at a time. see `RuntimePool` for serving requests from multiple threads.
+*/
 class PPLNN_PUBLIC RuntimeBuilder {
 public:
     virtual ~RuntimeBuilder() {}
+
+    /**
+       @brief create a `Runtime` instance that can be used after this builder is released.
+       @note this function is not thread-safe.
+    */
     virtual Runtime* CreateRuntime() = 0;
 };
 
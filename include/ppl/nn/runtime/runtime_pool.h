@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_RUNTIME_POOL_H_
+#define _ST_HPC_PPL_NN_RUNTIME_RUNTIME_POOL_H_
+
+#include "ppl/nn/common/common.h"
+#include "ppl/nn/runtime/runtime.h"
+
+namespace ppl { namespace nn {
+
+/**
+   @class RuntimePool
+   @brief a fixed number of `Runtime` instances created by the same `RuntimeBuilder`, which can be used
+   by different threads at the same time.
+   @note runtimes in a pool share the graph, constants and weights converted by engines. buffers of
+   intermediate tensors and temporary buffers are managed by each runtime separately.
+*/
+class PPLNN_PUBLIC RuntimePool {
+public:
+    virtual ~RuntimePool() {}
+
+    /** @brief get the number of runtimes in this pool */
+    virtual uint32_t GetRuntimeCount() const = 0;
+
+    /**
+       @brief get an idle runtime. blocks until a runtime is released if all runtimes are in use.
+       @note this function is thread-safe.
+    */
+    virtual Runtime* Acquire() = 0;
+
+    /**
+       @brief get an idle runtime, or nullptr if all runtimes are in use.
+       @note this function is thread-safe.
+    */
+    virtual Runtime* TryAcquire() = 0;
+
+    /**
+       @brief put `runtime` returned by `Acquire()` or `TryAcquire()` back into this pool.
+       @return RC_INVALID_VALUE if `runtime` does not belong to this pool or is not in use.
+       @note this function is thread-safe.
+    */
+    virtual ppl::common::RetCode Release(Runtime* runtime) = 0;
+};
+
+}} // namespace ppl::nn
+
+#endif
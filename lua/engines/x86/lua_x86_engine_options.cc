@@ -32,11 +32,34 @@ void RegisterX86EngineOptions(const shared_ptr<LuaState>& lstate, const shared_p
                    },
                    [](X86EngineOptions* options, uint32_t v) -> void {
                        options->mm_policy = v;
+                   })
+        .DefMember("dynamic_tuning_level",
+                   [](const X86EngineOptions* options) -> uint32_t {
+                       return options->dynamic_tuning_level;
+                   },
+                   [](X86EngineOptions* options, uint32_t v) -> void {
+                       options->dynamic_tuning_level = v;
+                   })
+        .DefMember("forward_precision",
+                   [](const X86EngineOptions* options) -> uint32_t {
+                       return options->forward_precision;
+                   },
+                   [](X86EngineOptions* options, uint32_t v) -> void {
+                       options->forward_precision = v;
+                   })
+        .DefMember("num_threads",
+                   [](const X86EngineOptions* options) -> uint32_t {
+                       return options->num_threads;
+                   },
+                   [](X86EngineOptions* options, uint32_t v) -> void {
+                       options->num_threads = v;
                    });
     lmodule->Set("X86EngineOptions", lclass);
 
     lmodule->SetInteger("X86_MM_MRU", X86_MM_MRU);
     lmodule->SetInteger("X86_MM_COMPACT", X86_MM_COMPACT);
+    lmodule->SetInteger("X86_TUNING_OFF", X86_TUNING_OFF);
+    lmodule->SetInteger("X86_TUNING_SELECT_ALGO", X86_TUNING_SELECT_ALGO);
 }
 
 }}}
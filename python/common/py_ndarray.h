@@ -25,6 +25,7 @@ namespace ppl { namespace nn { namespace python {
 
 struct PyNdArray final {
     std::vector<char> data;
+    void* view = nullptr; // points to data owned by others if not null. `data` is unused in this case.
     ppl::common::datatype_t data_type = ppl::common::DATATYPE_UNKNOWN;
     std::vector<int64_t> dims;
     std::vector<uint64_t> strides;
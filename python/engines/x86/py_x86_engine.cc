@@ -31,11 +31,36 @@ static RetCode GenericSetOption(Engine* engine, uint32_t option, const pybind11:
     return engine->Configure(option);
 }
 
+static RetCode SetStringOption(Engine* engine, uint32_t option, const pybind11::args& args) {
+    if (args.size() != 1) {
+        LOG(ERROR) << "expected for 1 parameter but got [" << args.size() << "].";
+        return RC_INVALID_VALUE;
+    }
+
+    auto str = args[0].cast<string>();
+    return engine->Configure(option, str.c_str());
+}
+
+static RetCode SetCoreBindingOption(Engine* engine, uint32_t option, const pybind11::args& args) {
+    if (args.size() != 1) {
+        LOG(ERROR) << "expected for 1 parameter but got [" << args.size() << "].";
+        return RC_INVALID_VALUE;
+    }
+
+    auto cores = args[0].cast<vector<int32_t>>();
+    return engine->Configure(option, cores.data(), (uint32_t)cores.size());
+}
+
 typedef RetCode (*ConfigFunc)(Engine*, uint32_t option, const pybind11::args& args);
 
 static const map<uint32_t, ConfigFunc> g_opt2func = {
     {X86_CONF_DISABLE_AVX512, GenericSetOption},
     {X86_CONF_DISABLE_AVX_FMA3, GenericSetOption},
+    {X86_CONF_EXPORT_PACKED_WEIGHTS, SetStringOption},
+    {X86_CONF_IMPORT_PACKED_WEIGHTS, SetStringOption},
+    {X86_CONF_SET_TUNING_CACHE_FILE, SetStringOption},
+    {X86_CONF_SET_QUANT_INFO, SetStringOption},
+    {X86_CONF_SET_CORE_BINDING, SetCoreBindingOption},
 };
 
 void RegisterX86Engine(pybind11::module* m) {
@@ -56,6 +81,11 @@ void RegisterX86Engine(pybind11::module* m) {
 
     m->attr("X86_CONF_DISABLE_AVX512") = (uint32_t)X86_CONF_DISABLE_AVX512;
     m->attr("X86_CONF_DISABLE_AVX_FMA3") = (uint32_t)X86_CONF_DISABLE_AVX_FMA3;
+    m->attr("X86_CONF_EXPORT_PACKED_WEIGHTS") = (uint32_t)X86_CONF_EXPORT_PACKED_WEIGHTS;
+    m->attr("X86_CONF_IMPORT_PACKED_WEIGHTS") = (uint32_t)X86_CONF_IMPORT_PACKED_WEIGHTS;
+    m->attr("X86_CONF_SET_TUNING_CACHE_FILE") = (uint32_t)X86_CONF_SET_TUNING_CACHE_FILE;
+    m->attr("X86_CONF_SET_QUANT_INFO") = (uint32_t)X86_CONF_SET_QUANT_INFO;
+    m->attr("X86_CONF_SET_CORE_BINDING") = (uint32_t)X86_CONF_SET_CORE_BINDING;
 }
 
 }}} // namespace ppl::nn::python
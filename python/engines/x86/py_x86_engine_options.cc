@@ -23,10 +23,15 @@ namespace ppl { namespace nn { namespace python {
 void RegisterX86EngineOptions(pybind11::module* m) {
     pybind11::class_<X86EngineOptions>(*m, "X86EngineOptions")
         .def(pybind11::init<>())
-        .def_readwrite("mm_policy", &X86EngineOptions::mm_policy);
+        .def_readwrite("mm_policy", &X86EngineOptions::mm_policy)
+        .def_readwrite("dynamic_tuning_level", &X86EngineOptions::dynamic_tuning_level)
+        .def_readwrite("forward_precision", &X86EngineOptions::forward_precision)
+        .def_readwrite("num_threads", &X86EngineOptions::num_threads);
 
     m->attr("X86_MM_COMPACT") = (uint32_t)X86_MM_COMPACT;
     m->attr("X86_MM_MRU") = (uint32_t)X86_MM_MRU;
+    m->attr("X86_TUNING_OFF") = (uint32_t)X86_TUNING_OFF;
+    m->attr("X86_TUNING_SELECT_ALGO") = (uint32_t)X86_TUNING_SELECT_ALGO;
 }
 
 }}} // namespace ppl::nn::python
@@ -23,6 +23,14 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace python {
 
+PyRuntime::~PyRuntime() {
+    if (ptr) {
+        for (uint32_t i = 0; i < ptr->GetInputCount(); ++i) {
+            ReleaseHostBuffer(ptr->GetInputTensor(i));
+        }
+    }
+}
+
 void RegisterRuntime(pybind11::module* m) {
     pybind11::class_<PyRuntime>(*m, "Runtime")
         .def("__bool__",
@@ -33,14 +41,18 @@ void RegisterRuntime(pybind11::module* m) {
              [](const PyRuntime& runtime) -> uint32_t {
                  return runtime.ptr->GetInputCount();
              })
+        // tensors keep the runtime alive because they point to data owned by it
         .def("GetInputTensor",
              [](const PyRuntime& runtime, uint32_t idx) -> PyTensor {
-                 return PyTensor(runtime.ptr->GetInputTensor(idx));
-             })
+                 return PyTensor(runtime.ptr->GetInputTensor(idx), true);
+             },
+             pybind11::keep_alive<0, 1>())
+        // other python threads can run while the model is evaluated
         .def("Run",
              [](const PyRuntime& runtime) -> RetCode {
                  return runtime.ptr->Run();
-             })
+             },
+             pybind11::call_guard<pybind11::gil_scoped_release>())
         .def("GetOutputCount",
              [](const PyRuntime& runtime) -> uint32_t {
                  return runtime.ptr->GetOutputCount();
@@ -48,7 +60,8 @@ void RegisterRuntime(pybind11::module* m) {
         .def("GetOutputTensor",
              [](const PyRuntime& runtime, uint32_t idx) -> PyTensor {
                  return PyTensor(runtime.ptr->GetOutputTensor(idx));
-             })
+             },
+             pybind11::keep_alive<0, 1>())
         .def("GetDeviceContextCount",
              [](const PyRuntime& runtime) -> uint32_t {
                  return runtime.ptr->GetDeviceContextCount();
@@ -28,6 +28,7 @@ struct PyRuntime final {
     PyRuntime(const std::vector<PyEngine>& e, Runtime* r) : engines(e), ptr(r) {}
     PyRuntime(PyRuntime&&) = default;
     PyRuntime& operator=(PyRuntime&&) = default;
+    ~PyRuntime();
 
     std::vector<PyEngine> engines; // retain engines
     std::unique_ptr<Runtime> ptr;
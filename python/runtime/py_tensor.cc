@@ -19,6 +19,7 @@
 #include "../common/py_device_context.h"
 #include "ppl/nn/common/logger.h"
 #include <map>
+#include <string.h>
 using namespace std;
 using namespace ppl::common;
 
@@ -39,9 +40,34 @@ static const map<string, datatype_t> g_format2datatype = {
     {"?", DATATYPE_BOOL}, //  -> unsigned char
 };
 
+/*
+  buffers set by `SetHostBuffer()`. accessed with the GIL held. allocated on heap and never destroyed, because
+  python objects cannot be released after the interpreter is finalized.
+*/
+static map<Tensor*, pybind11::object>* g_tensor2host_buffer = new map<Tensor*, pybind11::object>();
+
+void ReleaseHostBuffer(Tensor* tensor) {
+    auto ref = g_tensor2host_buffer->find(tensor);
+    if (ref != g_tensor2host_buffer->end()) {
+        tensor->SetBufferPtr(nullptr);
+        g_tensor2host_buffer->erase(ref);
+    }
+}
+
+static bool IsHostDevice(const DeviceContext* dev) {
+    if (!dev) {
+        return false;
+    }
+    auto type = dev->GetType();
+    return (strcmp(type, "x86") == 0 || strcmp(type, "arm") == 0 || strcmp(type, "riscv") == 0 ||
+            strcmp(type, "cpu") == 0);
+}
+
 RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
     pybind11::buffer_info info = b.request();
 
+    ReleaseHostBuffer(tensor_);
+
     vector<int64_t> dims(info.ndim);
     for (pybind11::ssize_t i = 0; i < info.ndim; ++i) {
         dims[i] = info.shape[i];
@@ -71,7 +97,10 @@ RetCode PyTensor::ConvertFromHost(const pybind11::buffer& b) {
         return status;
     }
 
-    status = tensor_->ConvertFromHost(info.ptr, src_shape);
+    {
+        pybind11::gil_scoped_release __release__;
+        status = tensor_->ConvertFromHost(info.ptr, src_shape);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "copy data to tensor[" << tensor_->GetName() << "] failed: " << GetRetCodeStr(status);
         return status;
@@ -90,7 +119,11 @@ PyNdArray PyTensor::ConvertToHost() const {
     dst_shape.SetDataFormat(DATAFORMAT_NDARRAY);
 
     arr.data.resize(dst_shape.GetBytesExcludingPadding());
-    auto status = tensor_->ConvertToHost(arr.data.data(), dst_shape);
+    RetCode status;
+    {
+        pybind11::gil_scoped_release __release__;
+        status = tensor_->ConvertToHost(arr.data.data(), dst_shape);
+    }
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "copy data of tensor[" << tensor_->GetName() << "] to host failed: " << GetRetCodeStr(status);
         return arr;
@@ -114,6 +147,89 @@ PyNdArray PyTensor::ConvertToHost() const {
     return arr;
 }
 
+RetCode PyTensor::SetHostBuffer(const pybind11::buffer& b) {
+    if (!is_input_) {
+        LOG(ERROR) << "tensor[" << tensor_->GetName() << "] is not an input of the runtime.";
+        return RC_UNSUPPORTED;
+    }
+    if (!IsHostDevice(tensor_->GetDeviceContext())) {
+        LOG(ERROR) << "tensor[" << tensor_->GetName() << "] is not on a host device.";
+        return RC_UNSUPPORTED;
+    }
+
+    auto shape = tensor_->GetShape();
+    if (shape->GetDataFormat() != DATAFORMAT_NDARRAY) {
+        LOG(ERROR) << "data format of tensor[" << tensor_->GetName() << "] is ["
+                   << GetDataFormatStr(shape->GetDataFormat()) << "], not NDARRAY.";
+        return RC_UNSUPPORTED;
+    }
+
+    pybind11::buffer_info info = b.request();
+
+    auto ref = g_format2datatype.find(info.format);
+    if (ref == g_format2datatype.end()) {
+        LOG(ERROR) << "unsupported data format[\"" << info.format << "\"]";
+        return RC_UNSUPPORTED;
+    }
+    if (ref->second != shape->GetDataType()) {
+        LOG(ERROR) << "data type of array [" << GetDataTypeStr(ref->second) << "] != data type of tensor["
+                   << tensor_->GetName() << "] [" << GetDataTypeStr(shape->GetDataType()) << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    pybind11::ssize_t expected_stride = info.itemsize;
+    for (pybind11::ssize_t i = info.ndim - 1; i >= 0; --i) {
+        if (info.shape[i] > 1 && info.strides[i] != expected_stride) {
+            LOG(ERROR) << "array for tensor[" << tensor_->GetName() << "] is not C-contiguous.";
+            return RC_INVALID_VALUE;
+        }
+        expected_stride *= info.shape[i];
+    }
+
+    vector<int64_t> dims(info.ndim);
+    for (pybind11::ssize_t i = 0; i < info.ndim; ++i) {
+        dims[i] = info.shape[i];
+    }
+
+    ReleaseHostBuffer(tensor_);
+    shape->Reshape(dims);
+    tensor_->SetBufferPtr(info.ptr);
+    (*g_tensor2host_buffer)[tensor_] = b;
+
+    return RC_SUCCESS;
+}
+
+PyNdArray PyTensor::GetHostView() const {
+    auto shape = tensor_->GetShape();
+    if (!IsHostDevice(tensor_->GetDeviceContext()) || shape->GetDataFormat() != DATAFORMAT_NDARRAY ||
+        shape->GetBytesIncludingPadding() != shape->GetBytesExcludingPadding() || !tensor_->GetBufferPtr()) {
+        return ConvertToHost();
+    }
+
+    PyNdArray arr;
+    if (shape->GetBytesExcludingPadding() == 0) {
+        return arr;
+    }
+
+    arr.view = tensor_->GetBufferPtr();
+    arr.data_type = shape->GetDataType();
+
+    auto dim_count = shape->GetRealDimCount();
+
+    arr.dims.resize(dim_count);
+    for (uint32_t i = 0; i < dim_count; ++i) {
+        arr.dims[i] = shape->GetDim(i);
+    }
+
+    arr.strides.resize(dim_count);
+    for (uint32_t i = 1; i < dim_count; ++i) {
+        arr.strides[i - 1] = shape->GetBytesFromDimesionExcludingPadding(i);
+    }
+    arr.strides[dim_count - 1] = GetSizeOfDataType(shape->GetDataType());
+
+    return arr;
+}
+
 void RegisterTensor(pybind11::module* m) {
     pybind11::class_<PyTensor>(*m, "Tensor")
         .def("__bool__",
@@ -135,7 +251,11 @@ void RegisterTensor(pybind11::module* m) {
         .def("GetName", &PyTensor::GetName, pybind11::return_value_policy::reference)
         .def("GetShape", &PyTensor::GetConstShape, pybind11::return_value_policy::reference)
         .def("ConvertFromHost", &PyTensor::ConvertFromHost)
-        .def("ConvertToHost", &PyTensor::ConvertToHost, pybind11::return_value_policy::move);
+        .def("ConvertToHost", &PyTensor::ConvertToHost, pybind11::return_value_policy::move)
+        .def("SetHostBuffer", &PyTensor::SetHostBuffer)
+        // the returned array keeps the tensor alive, which keeps its runtime alive
+        .def("GetHostView", &PyTensor::GetHostView, pybind11::return_value_policy::move,
+             pybind11::keep_alive<0, 1>());
 }
 
 }}} // namespace ppl::nn::python
@@ -26,7 +26,8 @@ namespace ppl { namespace nn { namespace python {
 
 class PyTensor final {
 public:
-    PyTensor(Tensor* tensor) : tensor_(tensor) {}
+    /** @param is_input whether `tensor` is an input of the runtime, which is required by `SetHostBuffer()` */
+    PyTensor(Tensor* tensor, bool is_input = false) : tensor_(tensor), is_input_(is_input) {}
     PyTensor(PyTensor&&) = default;
     PyTensor& operator=(PyTensor&&) = default;
     Tensor* GetPtr() const {
@@ -41,10 +42,30 @@ public:
     ppl::common::RetCode ConvertFromHost(const pybind11::buffer&);
     PyNdArray ConvertToHost() const;
 
+    /**
+       @brief uses data of `b` as the tensor's buffer without copying. `b` is retained until another buffer is set
+       by `ConvertFromHost()`/`SetHostBuffer()` or the tensor is released by `ReleaseHostBuffer()`.
+       @note `b` must be a C-contiguous array of the tensor's data type, and the tensor must be an NDARRAY input
+       tensor of the runtime on a host device.
+    */
+    ppl::common::RetCode SetHostBuffer(const pybind11::buffer& b);
+
+    /**
+       @brief returns an array sharing the tensor's buffer if it is an NDARRAY tensor on a host device, or a copy
+       like `ConvertToHost()` otherwise.
+       @note the returned array keeps the tensor, and therefore the runtime, alive. the shared data is overwritten
+       by the next `Run()` of the runtime, so copy it if it is needed after that.
+    */
+    PyNdArray GetHostView() const;
+
 private:
     Tensor* tensor_;
+    bool is_input_;
 };
 
+/** @brief drops the buffer retained by `PyTensor::SetHostBuffer()` for `tensor`, if any. */
+void ReleaseHostBuffer(Tensor* tensor);
+
 }}} // namespace ppl::nn::python
 
 #endif
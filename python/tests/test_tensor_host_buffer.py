@@ -0,0 +1,99 @@
+# -*- coding: utf-8 -*-
+#!/usr/bin/env python3
+
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+# tests of Tensor.SetHostBuffer() and Tensor.GetHostView(). run with
+#   PYTHONPATH=<pplnn install dir>/lib python3 -m unittest discover -s python/tests
+
+import gc
+import os
+import unittest
+import numpy as np
+from pyppl import nn as pplnn
+from pyppl import common as pplcommon
+
+g_model_file = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "tests", "testdata", "conv.onnx")
+
+def CreateRuntime():
+    engine = pplnn.X86EngineFactory.Create(pplnn.X86EngineOptions())
+    builder = pplnn.OnnxRuntimeBuilderFactory.CreateFromFile(g_model_file, [engine])
+    return builder.CreateRuntime()
+
+def RandomInput(runtime):
+    shape = runtime.GetInputTensor(0).GetShape()
+    return np.random.uniform(-1.0, 1.0, shape.GetDims()).astype(np.float32)
+
+def RunWithCopy(runtime, in_data):
+    status = runtime.GetInputTensor(0).ConvertFromHost(in_data)
+    assert status == pplcommon.RC_SUCCESS
+    assert runtime.Run() == pplcommon.RC_SUCCESS
+    return np.array(runtime.GetOutputTensor(0).ConvertToHost(), copy = True)
+
+@unittest.skipIf(not hasattr(pplnn, "X86EngineFactory"), "x86 engine is not built")
+class TensorHostBufferTest(unittest.TestCase):
+    def test_host_view_shares_output(self):
+        runtime = CreateRuntime()
+        expected = RunWithCopy(runtime, RandomInput(runtime))
+
+        view = np.array(runtime.GetOutputTensor(0).GetHostView(), copy = False)
+        self.assertTrue(np.array_equal(expected, view))
+
+    def test_host_view_keeps_runtime_alive(self):
+        runtime = CreateRuntime()
+        expected = RunWithCopy(runtime, RandomInput(runtime))
+        view = np.array(runtime.GetOutputTensor(0).GetHostView(), copy = False)
+
+        del runtime
+        gc.collect()
+        self.assertTrue(np.array_equal(expected, view))
+
+    def test_set_host_buffer(self):
+        runtime = CreateRuntime()
+        in_data = RandomInput(runtime)
+        expected = RunWithCopy(runtime, in_data)
+
+        runtime2 = CreateRuntime()
+        buf = np.array(in_data, copy = True)
+        self.assertEqual(pplcommon.RC_SUCCESS, runtime2.GetInputTensor(0).SetHostBuffer(buf))
+        self.assertEqual(pplcommon.RC_SUCCESS, runtime2.Run())
+        out = np.array(runtime2.GetOutputTensor(0).ConvertToHost(), copy = True)
+        self.assertTrue(np.allclose(expected, out, rtol = 1e-5, atol = 1e-5))
+
+        # the buffer is used without copying
+        buf[...] = 0.0
+        self.assertEqual(pplcommon.RC_SUCCESS, runtime2.Run())
+        out_zero = np.array(runtime2.GetOutputTensor(0).ConvertToHost(), copy = True)
+        self.assertTrue(np.allclose(RunWithCopy(runtime, np.zeros_like(in_data)), out_zero, rtol = 1e-5, atol = 1e-5))
+
+    def test_set_host_buffer_rejects_output(self):
+        runtime = CreateRuntime()
+        RunWithCopy(runtime, RandomInput(runtime))
+        out_tensor = runtime.GetOutputTensor(0)
+        buf = np.zeros(out_tensor.GetShape().GetDims(), dtype = np.float32)
+        self.assertNotEqual(pplcommon.RC_SUCCESS, out_tensor.SetHostBuffer(buf))
+
+    def test_set_host_buffer_rejects_invalid_arrays(self):
+        runtime = CreateRuntime()
+        in_data = RandomInput(runtime)
+        tensor = runtime.GetInputTensor(0)
+        self.assertNotEqual(pplcommon.RC_SUCCESS, tensor.SetHostBuffer(in_data.astype(np.float64)))
+        self.assertNotEqual(pplcommon.RC_SUCCESS, tensor.SetHostBuffer(in_data[..., ::2]))
+
+if __name__ == "__main__":
+    unittest.main()
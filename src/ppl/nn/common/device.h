@@ -95,6 +95,16 @@ public:
 
     /** @brief get DataConverter that can process data on this device */
     virtual const DataConverter* GetDataConverter() const = 0;
+
+    /**
+       @brief makes buffer management functions of this device safe to be called by
+       kernels running in different threads at the same time.
+       @return RC_UNSUPPORTED if this device can only be used by one kernel at a time.
+       @note it is called by schedulers and MUST NOT be called during Run().
+    */
+    virtual ppl::common::RetCode SetConcurrentAccess(bool) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
 };
 
 }} // namespace ppl::nn
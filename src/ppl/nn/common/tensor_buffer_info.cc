@@ -22,12 +22,55 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn {
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+static thread_local BufferEventListener* g_buffer_event_listener = nullptr;
+
+BufferEventListener* SetThreadBufferEventListener(BufferEventListener* listener) {
+    auto prev = g_buffer_event_listener;
+    g_buffer_event_listener = listener;
+    return prev;
+}
+
+static void FreeDeviceBuffer(Device* device, BufferDesc* buffer) {
+    auto listener = g_buffer_event_listener;
+    if (!listener) {
+        device->Free(buffer);
+        return;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    device->Free(buffer);
+    listener->OnFree(begin, std::chrono::steady_clock::now());
+}
+
+static RetCode ReallocDeviceBuffer(Device* device, const TensorShape& shape, BufferDesc* buffer) {
+    auto listener = g_buffer_event_listener;
+    if (!listener) {
+        return device->Realloc(shape, buffer);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    auto status = device->Realloc(shape, buffer);
+    listener->OnRealloc(shape.GetBytesIncludingPadding(), begin, std::chrono::steady_clock::now());
+    return status;
+}
+#else
+static inline void FreeDeviceBuffer(Device* device, BufferDesc* buffer) {
+    device->Free(buffer);
+}
+
+static inline RetCode ReallocDeviceBuffer(Device* device, const TensorShape& shape, BufferDesc* buffer) {
+    return device->Realloc(shape, buffer);
+}
+#endif
+
 TensorBufferInfo::~TensorBufferInfo() {
     FreeBuffer();
 }
 
 TensorBufferInfo::TensorBufferInfo(TensorBufferInfo&& info) {
     is_buffer_owner_ = info.is_buffer_owner_;
+    capacity_ = info.capacity_;
     buffer_ = info.buffer_;
     device_ = info.device_;
     shape_ = std::move(info.shape_);
@@ -35,14 +78,16 @@ TensorBufferInfo::TensorBufferInfo(TensorBufferInfo&& info) {
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
     info.is_buffer_owner_ = false;
+    info.capacity_ = 0;
 }
 
 TensorBufferInfo& TensorBufferInfo::operator=(TensorBufferInfo&& info) {
     if (is_buffer_owner_ && device_) {
-        device_->Free(&buffer_);
+        FreeDeviceBuffer(device_, &buffer_);
     }
 
     is_buffer_owner_ = info.is_buffer_owner_;
+    capacity_ = info.capacity_;
     buffer_ = info.buffer_;
     device_ = info.device_;
     shape_ = std::move(info.shape_);
@@ -50,6 +95,7 @@ TensorBufferInfo& TensorBufferInfo::operator=(TensorBufferInfo&& info) {
     info.buffer_.addr = nullptr;
     info.device_ = nullptr;
     info.is_buffer_owner_ = false;
+    info.capacity_ = 0;
 
     return *this;
 }
@@ -70,7 +116,7 @@ RetCode TensorBufferInfo::SetDevice(Device* dev) {
 
 void TensorBufferInfo::SetBuffer(const BufferDesc& buf, Device* device, bool is_buffer_owner) {
     if (is_buffer_owner_ && device_) {
-        device_->Free(&buffer_);
+        FreeDeviceBuffer(device_, &buffer_);
     }
 
     if (device) {
@@ -79,6 +125,12 @@ void TensorBufferInfo::SetBuffer(const BufferDesc& buf, Device* device, bool is_
 
     buffer_ = buf;
     is_buffer_owner_ = is_buffer_owner;
+    capacity_ = 0;
+}
+
+void TensorBufferInfo::SetPlannedBuffer(const BufferDesc& buf, uint64_t capacity) {
+    SetBuffer(buf);
+    capacity_ = capacity;
 }
 
 RetCode TensorBufferInfo::ReallocBuffer() {
@@ -88,16 +140,20 @@ RetCode TensorBufferInfo::ReallocBuffer() {
     }
 
     if (!is_buffer_owner_) {
+        if (IsPlannedBuffer() && shape_.GetBytesIncludingPadding() <= capacity_) {
+            return RC_SUCCESS;
+        }
         buffer_.addr = nullptr;
     }
 
-    auto status = device_->Realloc(shape_, &buffer_);
+    auto status = ReallocDeviceBuffer(device_, shape_, &buffer_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "Realloc [" << shape_.GetBytesIncludingPadding() << "] bytes failed: " << GetRetCodeStr(status);
         return status;
     }
 
     is_buffer_owner_ = true;
+    capacity_ = 0;
 
     return RC_SUCCESS;
 }
@@ -106,16 +162,18 @@ BufferDesc TensorBufferInfo::DetachBuffer() {
     auto ret = buffer_;
     buffer_.addr = nullptr;
     is_buffer_owner_ = false;
+    capacity_ = 0;
     return ret;
 }
 
 void TensorBufferInfo::FreeBuffer() {
     if (is_buffer_owner_ && device_) {
-        device_->Free(&buffer_);
+        FreeDeviceBuffer(device_, &buffer_);
         is_buffer_owner_ = false;
     }
 
     buffer_.addr = nullptr;
+    capacity_ = 0;
 }
 
 }} // namespace ppl::nn
@@ -21,11 +21,33 @@
 #include "ppl/nn/common/tensor_shape.h"
 #include "ppl/nn/common/device.h"
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+#include <chrono>
+#endif
+
 namespace ppl { namespace nn {
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+/** @brief receives `Device::Realloc()`/`Device::Free()` calls made by `TensorBufferInfo` in the current thread */
+class BufferEventListener {
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    virtual ~BufferEventListener() {}
+    virtual void OnRealloc(uint64_t bytes, const TimePoint& begin, const TimePoint& end) = 0;
+    virtual void OnFree(const TimePoint& begin, const TimePoint& end) = 0;
+};
+
+/**
+   @brief sets the listener of the current thread. nullptr disables notification.
+   @return the previous listener
+*/
+BufferEventListener* SetThreadBufferEventListener(BufferEventListener*);
+#endif
+
 class TensorBufferInfo final {
 public:
-    TensorBufferInfo() : is_buffer_owner_(false), device_(nullptr) {}
+    TensorBufferInfo() : is_buffer_owner_(false), capacity_(0), device_(nullptr) {}
     TensorBufferInfo(TensorBufferInfo&&);
     TensorBufferInfo& operator=(TensorBufferInfo&&);
     ~TensorBufferInfo();
@@ -51,6 +73,17 @@ public:
     */
     void SetBuffer(const BufferDesc& buf, Device* device = nullptr, bool is_buffer_owner = false);
 
+    /**
+       @brief set a buffer of `capacity` bytes managed by others(a memory plan for example) as this tensor's buffer.
+       ReallocBuffer() keeps using it if the new shape fits in, or allocates a new buffer from device_ otherwise.
+    */
+    void SetPlannedBuffer(const BufferDesc& buf, uint64_t capacity);
+
+    /** @brief returns true if buffer_ is set by SetPlannedBuffer() and has not been replaced. */
+    bool IsPlannedBuffer() const {
+        return (!is_buffer_owner_ && capacity_ > 0 && buffer_.addr);
+    }
+
     /**
        @brief returns buffer_ to caller and reset buffer_.
        @note IsBufferOwner() is unspecified after DetachBuffer().
@@ -84,6 +117,7 @@ public:
 
 private:
     bool is_buffer_owner_;
+    uint64_t capacity_; // size of the planned buffer. 0 if buffer_ is not set by SetPlannedBuffer()
     BufferDesc buffer_;
     Device* device_;
     mutable TensorShape shape_;
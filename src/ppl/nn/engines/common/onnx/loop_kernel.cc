@@ -29,9 +29,25 @@ namespace ppl { namespace nn { namespace common {
 template <typename T>
 void EmptyDeleter(T*) {}
 
+// returns true if the subgraph output `idx` is produced by a node and is not another output of the subgraph,
+// so that its buffer can be provided by the loop kernel.
+static bool IsExclusiveSubgraphOutput(const RuntimeImpl& subgraph, uint32_t idx) {
+    auto tensor = subgraph.GetOutputTensorImpl(idx);
+    if (tensor->GetEdge()->GetProducer() == INVALID_NODEID) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < subgraph.GetOutputCount(); ++i) {
+        if (i != idx && subgraph.GetOutputTensorImpl(i) == tensor) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, const RuntimeGraphInfo* info,
-                                     const RuntimeAuxInfo* aux_info, utils::SharedResource* resource,
-                                     LoopConcatOutputFunc func) {
+                                     const RuntimeAuxInfo* aux_info, utils::SharedResource* resource) {
     auto status = subgraph_.Init(topo, shared_ptr<const RuntimeGraphInfo>(info, EmptyDeleter<const RuntimeGraphInfo>),
                                  shared_ptr<const RuntimeAuxInfo>(aux_info, EmptyDeleter<const RuntimeAuxInfo>),
                                  shared_ptr<utils::SharedResource>(resource, EmptyDeleter<utils::SharedResource>));
@@ -40,7 +56,19 @@ RetCode LoopKernel::SetExecutionInfo(const shared_ptr<ir::GraphTopo>& topo, cons
         return status;
     }
 
-    concat_output_func_ = func;
+    // subgraph inputs: (iteration_num, cond, v_initial...), outputs: (cond, v_final..., scan_outputs...)
+    const uint32_t loop_carried_dep_num = subgraph_.GetInputCount() - 2;
+    carried_dep_buffers_.resize(loop_carried_dep_num);
+    for (uint32_t i = 0; i < loop_carried_dep_num; ++i) {
+        carried_dep_buffers_[i].is_eligible = IsExclusiveSubgraphOutput(subgraph_, i + 1);
+    }
+
+    const uint32_t scan_output_num = subgraph_.GetOutputCount() - 1 - loop_carried_dep_num;
+    scan_output_writable_.resize(scan_output_num);
+    for (uint32_t i = 0; i < scan_output_num; ++i) {
+        scan_output_writable_[i] = IsExclusiveSubgraphOutput(subgraph_, loop_carried_dep_num + i + 1);
+    }
+
     return RC_SUCCESS;
 }
 
@@ -66,56 +94,281 @@ static inline RetCode GetKeepGoing(const KernelExecContext& ctx, bool* keep_goin
     return RC_SUCCESS;
 }
 
+struct ScanOutputInfo final {
+    TensorShape step_shape; // shape of the scan output of one iteration
+    uint64_t step_bytes = 0;
+    int64_t steps = 0; // number of iterations saved in the loop output
+    int64_t capacity = 0; // number of iterations the buffer of the loop output can hold
+};
+
 struct LoopInfo final {
     LoopInfo(const KernelExecContext& ctx) {
         loop_carried_dep_num = ctx.GetInputCount() - 2; // N
         scan_output_num = ctx.GetOutputCount() - loop_carried_dep_num; // K
-        intermediate_outputs.resize(scan_output_num);
+        scan_outputs.resize(scan_output_num);
     }
 
     uint32_t loop_carried_dep_num;
     uint32_t scan_output_num;
-    vector<vector<TensorBufferInfo>> intermediate_outputs;
+    vector<ScanOutputInfo> scan_outputs;
 };
 
-static RetCode SaveSubgraphOutputs(RuntimeImpl* subgraph, LoopInfo* info) {
+// upper bound of the buffer preallocated for a scan output when the trip count is known. grows geometrically after.
+static const uint64_t g_max_preallocated_scan_output_bytes = 64 * 1024 * 1024;
+// initial number of iterations reserved for scan outputs if the trip count is unknown
+static const int64_t g_default_scan_output_capacity = 16;
+// a subgraph output is written into the loop output directly only if every slice keeps this alignment
+static const uint64_t g_scan_output_slice_alignment = 64;
+
+static inline bool IsSameShape(const TensorShape& a, const TensorShape& b) {
+    if (a.GetDataType() != b.GetDataType() || a.GetDataFormat() != b.GetDataFormat() ||
+        a.GetDimCount() != b.GetDimCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetDimCount(); ++i) {
+        if (a.GetDim(i) != b.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline BufferDesc GetScanOutputSlice(const TensorImpl& output, const ScanOutputInfo& info, int64_t step) {
+    BufferDesc slice = output.GetBufferDesc();
+    slice.addr = (char*)slice.addr + step * info.step_bytes;
+    return slice;
+}
+
+/** @brief makes sure that buffer of `output` can hold `steps` iterations. saved iterations are kept. */
+static RetCode ReserveScanOutput(int64_t steps, int64_t max_trip_count, ScanOutputInfo* info, TensorImpl* output) {
+    if (steps <= info->capacity) {
+        return RC_SUCCESS;
+    }
+
+    int64_t capacity;
+    if (info->capacity == 0) {
+        capacity = (max_trip_count == INT64_MAX) ? g_default_scan_output_capacity : max_trip_count;
+        if (info->step_bytes > 0) {
+            capacity = min<int64_t>(capacity, g_max_preallocated_scan_output_bytes / info->step_bytes);
+        }
+    } else {
+        capacity = min(info->capacity * 2, max_trip_count);
+    }
+    capacity = max(capacity, steps);
+
+    auto device = output->GetDevice();
+    BufferDesc buffer;
+    auto status = device->Realloc(capacity * info->step_bytes, &buffer);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "alloc [" << capacity * info->step_bytes << "] bytes for scan output[" << output->GetName()
+                   << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    if (info->steps > 0) {
+        status = device->Copy(&buffer, output->GetBufferDesc(), info->steps * info->step_bytes);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "copy saved iterations of scan output[" << output->GetName()
+                       << "] failed: " << GetRetCodeStr(status);
+            device->Free(&buffer);
+            return status;
+        }
+    }
+
+    output->SetBuffer(buffer, device, true);
+    info->capacity = capacity;
+
+    return RC_SUCCESS;
+}
+
+static inline bool CanWriteScanOutputDirectly(const ScanOutputInfo& info, const TensorImpl& src,
+                                              const TensorImpl& dst) {
+    return (info.steps > 0 && info.step_bytes > 0 && info.step_bytes % g_scan_output_slice_alignment == 0 &&
+            src.GetDevice() == dst.GetDevice());
+}
+
+/**
+   @brief lets subgraph outputs write scan outputs of the next iteration into loop outputs directly.
+   kernels producing these outputs keep using the given slice as long as the shape does not change.
+*/
+static RetCode PrepareScanOutputs(int64_t max_trip_count, const vector<bool>& scan_output_writable,
+                                  RuntimeImpl* subgraph, LoopInfo* info, KernelExecContext* ctx) {
     for (uint32_t i = 0; i < info->scan_output_num; ++i) {
-        auto scan_output = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        if (!scan_output_writable[i]) {
+            continue;
+        }
 
-        TensorBufferInfo output_buffer;
-        if (scan_output->IsBufferOwner()) {
-            output_buffer.Reshape(*scan_output->GetShape());
-            output_buffer.SetBuffer(scan_output->GetBufferDesc(), scan_output->GetDevice(), true);
-            scan_output->DetachBuffer();
-        } else {
-            auto device = scan_output->GetDevice();
+        auto src = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        auto dst = ctx->GetOutput<TensorImpl>(info->loop_carried_dep_num + i);
+        auto& scan_info = info->scan_outputs[i];
+        if (!CanWriteScanOutputDirectly(scan_info, *src, *dst)) {
+            continue;
+        }
 
-            output_buffer.SetDevice(scan_output->GetDevice());
-            output_buffer.Reshape(*scan_output->GetShape());
-            auto status = output_buffer.ReallocBuffer();
+        auto status = ReserveScanOutput(scan_info.steps + 1, max_trip_count, &scan_info, dst);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        src->SetPlannedBuffer(GetScanOutputSlice(*dst, scan_info, scan_info.steps), scan_info.step_bytes);
+    }
+
+    return RC_SUCCESS;
+}
+
+/** @brief appends scan outputs of the current iteration to loop outputs if they are not written there already */
+static RetCode AppendScanOutputs(int64_t max_trip_count, RuntimeImpl* subgraph, LoopInfo* info,
+                                 KernelExecContext* ctx) {
+    for (uint32_t i = 0; i < info->scan_output_num; ++i) {
+        auto src = subgraph->GetOutputTensorImpl(info->loop_carried_dep_num + i + 1); // +1 for skipping `cond`
+        auto dst = ctx->GetOutput<TensorImpl>(info->loop_carried_dep_num + i);
+        auto& scan_info = info->scan_outputs[i];
+
+        auto& src_shape = *src->GetShape();
+        if (scan_info.steps == 0) {
+            scan_info.step_shape = src_shape;
+            scan_info.step_bytes = src_shape.GetBytesIncludingPadding();
+        } else if (!IsSameShape(src_shape, scan_info.step_shape)) {
+            LOG(ERROR) << "shape of scan output[" << src->GetName() << "] changes in iteration[" << scan_info.steps
+                       << "].";
+            return RC_INVALID_VALUE;
+        }
+
+        auto status = ReserveScanOutput(scan_info.steps + 1, max_trip_count, &scan_info, dst);
+        if (status != RC_SUCCESS) {
+            return status;
+        }
+
+        auto slice = GetScanOutputSlice(*dst, scan_info, scan_info.steps);
+        if (scan_info.step_bytes > 0 && src->GetBufferPtr() != slice.addr) {
+            if (src->GetDevice() == dst->GetDevice()) {
+                status = dst->GetDevice()->Copy(&slice, src->GetBufferDesc(), scan_info.step_bytes);
+            } else {
+                vector<char> host_buffer(scan_info.step_bytes);
+                status = src->GetDevice()->CopyToHost(host_buffer.data(), src->GetBufferDesc(), scan_info.step_bytes);
+                if (status == RC_SUCCESS) {
+                    status = dst->GetDevice()->CopyFromHost(&slice, host_buffer.data(), scan_info.step_bytes);
+                }
+            }
             if (status != RC_SUCCESS) {
-                LOG(ERROR) << "alloc buffer for tensor[" << scan_output->GetName()
+                LOG(ERROR) << "copy data from tensor[" << src->GetName() << "] to tensor[" << dst->GetName()
                            << "] failed: " << GetRetCodeStr(status);
                 return status;
             }
+        }
 
-            status =
-                device->Copy(&output_buffer.GetBufferDesc(), scan_output->GetBufferDesc(), *scan_output->GetShape());
-            if (status != RC_SUCCESS) {
-                LOG(ERROR) << "copy data from tensor[" << scan_output->GetName()
-                           << "] failed: " << GetRetCodeStr(status);
-                return status;
+        ++scan_info.steps;
+    }
+
+    return RC_SUCCESS;
+}
+
+/** @brief detaches slices of loop outputs set by PrepareScanOutputs() from subgraph outputs */
+static void DetachScanOutputs(const vector<bool>& scan_output_writable, uint32_t loop_carried_dep_num,
+                              RuntimeImpl* subgraph) {
+    for (uint32_t i = 0; i < scan_output_writable.size(); ++i) {
+        if (scan_output_writable[i]) {
+            auto src = subgraph->GetOutputTensorImpl(loop_carried_dep_num + i + 1);
+            if (src->IsPlannedBuffer()) {
+                src->DetachBuffer();
             }
         }
+    }
+}
+
+/**
+   @brief passes the loop-carried dependency `src` of the last iteration to the subgraph input `dst`.
+   the buffer written by `src` is handed over to `dst` and `src` writes into the other buffer of `bufs` in the next
+   iteration, so that no buffer is allocated as long as the shape does not grow.
+   @return false if the buffer of `src` is not managed by `bufs` and cannot be taken over.
+*/
+static bool PingPongLoopCarriedDep(TensorImpl* src, TensorImpl* dst, LoopCarriedDepBuffers* bufs) {
+    auto device = src->GetDevice();
+    auto cur = &bufs->buffers[bufs->cur];
+
+    if (!cur->GetBufferPtr() || src->GetBufferPtr() != cur->GetBufferPtr()) {
+        if (!src->IsBufferOwner()) {
+            return false;
+        }
+        // the output is (re)allocated by its producer, e.g. in the first iteration or when its shape grows
+        bufs->capacities[bufs->cur] = src->GetShape()->GetBytesIncludingPadding();
+        cur->SetBuffer(src->DetachBuffer(), device, true);
+    }
+
+    dst->SetBuffer(cur->GetBufferDesc());
+    bufs->cur = 1 - bufs->cur;
+
+    auto next = &bufs->buffers[bufs->cur];
+    const uint64_t bytes = src->GetShape()->GetBytesIncludingPadding();
+    if (bufs->capacities[bufs->cur] < bytes) {
+        next->FreeBuffer();
+        next->SetDevice(device);
+        next->Reshape(*src->GetShape());
+        if (next->ReallocBuffer() != RC_SUCCESS) {
+            bufs->capacities[bufs->cur] = 0;
+            src->DetachBuffer();
+            return true; // producer allocates a new buffer for `src` in the next iteration
+        }
+        bufs->capacities[bufs->cur] = bytes;
+    }
+
+    src->SetPlannedBuffer(next->GetBufferDesc(), bufs->capacities[bufs->cur]);
+    return true;
+}
+
+/**
+   @brief tells whether the subgraph output passed to subgraph input `i` may be changed by updating other inputs.
+   such an output does not own its buffer (e.g. a buffer of loop-carried dependencies), is a subgraph input itself,
+   or is shared with other outputs.
+*/
+static bool IsAliasedSubgraphOutput(uint32_t i, const RuntimeImpl& subgraph,
+                                    const vector<LoopCarriedDepBuffers>& carried_dep_buffers) {
+    auto src = subgraph.GetOutputTensorImpl(i - 1);
+    if (i >= 2) {
+        auto& bufs = carried_dep_buffers[i - 2];
+        if (!bufs.is_eligible) {
+            return true;
+        }
+        // written by the producer as planned and taken over by PingPongLoopCarriedDep()
+        return (!src->IsBufferOwner() && src->GetBufferPtr() != bufs.buffers[bufs.cur].GetBufferPtr());
+    }
+    return (!src->IsBufferOwner() || !IsExclusiveSubgraphOutput(subgraph, i - 1));
+}
+
+/**
+   @brief copies subgraph outputs that may be changed by updating other inputs before any input is updated.
+   `copies[i]` is the copy for subgraph input `i`, or has no buffer if the output is passed without a copy.
+*/
+static RetCode CopyAliasedSubgraphOutputs(RuntimeImpl* subgraph,
+                                          const vector<LoopCarriedDepBuffers>& carried_dep_buffers,
+                                          vector<TensorBufferInfo>* copies) {
+    copies->resize(subgraph->GetInputCount());
+    for (uint32_t i = 1; i < subgraph->GetInputCount(); ++i) {
+        auto dst = subgraph->GetInputTensorImpl(i);
+        auto src = subgraph->GetOutputTensorImpl(i - 1);
+        if (!dst->GetDevice() || dst->GetDevice() != src->GetDevice() || !src->GetBufferPtr() ||
+            !IsAliasedSubgraphOutput(i, *subgraph, carried_dep_buffers)) {
+            continue;
+        }
 
-        info->intermediate_outputs[i].emplace_back(std::move(output_buffer));
+        auto copy = &copies->at(i);
+        copy->SetDevice(src->GetDevice());
+        copy->Reshape(*src->GetShape());
+        auto status = copy->ReallocBuffer();
+        if (status == RC_SUCCESS) {
+            status = src->GetDevice()->Copy(&copy->GetBufferDesc(), src->GetBufferDesc(), *src->GetShape());
+        }
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "copy data of tensor[" << src->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
     }
 
     return RC_SUCCESS;
 }
 
-static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
-                                    utils::GenericCpuDevice* tmp_cpu_device) {
+static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph, utils::GenericCpuDevice* tmp_cpu_device,
+                                    vector<LoopCarriedDepBuffers>* carried_dep_buffers) {
     auto trip_count_tensor = subgraph->GetInputTensorImpl(0);
     if (trip_count_tensor->GetDevice()) { // not used by anyone if device is not set
         auto status = trip_count_tensor->CopyFromHost(&trip_count);
@@ -125,6 +378,14 @@ static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
         }
     }
 
+    // copies are made before any input is updated, because updating an input may free or overwrite a buffer
+    // referred by other outputs
+    vector<TensorBufferInfo> copies;
+    auto status = CopyAliasedSubgraphOutputs(subgraph, *carried_dep_buffers, &copies);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
     // starting from 1 to skip trip count
     for (uint32_t i = 1; i < subgraph->GetInputCount(); ++i) {
         auto dst = subgraph->GetInputTensorImpl(i);
@@ -133,8 +394,21 @@ static RetCode UpdateSubgraphInputs(int64_t trip_count, RuntimeImpl* subgraph,
         }
 
         auto src = subgraph->GetOutputTensorImpl(i - 1);
+        auto& copy = copies[i];
+        if (copy.GetBufferPtr()) {
+            *dst->GetShape() = *copy.GetShape();
+            dst->SetBuffer(copy.DetachBuffer(), copy.GetDevice(), true);
+            continue;
+        }
+
         *dst->GetShape() = *src->GetShape();
         if (dst->GetDevice() == src->GetDevice()) {
+            if (i >= 2) {
+                auto bufs = &carried_dep_buffers->at(i - 2);
+                if (bufs->is_eligible && PingPongLoopCarriedDep(src, dst, bufs)) {
+                    continue;
+                }
+            }
             dst->TransferBufferFrom(src);
         } else {
             auto status = utils::CopyTensorBuffer(*src, dst, tmp_cpu_device);
@@ -269,8 +543,7 @@ static RetCode SetOutputsFromInputs(const LoopInfo& info, const string& loop_ker
     return RC_SUCCESS;
 }
 
-static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_device,
-                                      LoopConcatOutputFunc concat_output_func, RuntimeImpl* subgraph,
+static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_device, RuntimeImpl* subgraph,
                                       KernelExecContext* ctx) {
     // copy loop carried deps from subgraph's output
     for (uint32_t i = 0; i < info.loop_carried_dep_num; ++i) {
@@ -288,33 +561,21 @@ static RetCode SetOutputsFromSubgraph(const LoopInfo& info, Device* tmp_cpu_devi
         }
     }
 
-    for (uint32_t i = info.loop_carried_dep_num; i < ctx->GetOutputCount(); ++i) {
-        auto dst = ctx->GetOutput<TensorImpl>(i);
+    // scan outputs are already saved in the buffers of loop outputs. buffers may be larger than needed.
+    for (uint32_t i = 0; i < info.scan_output_num; ++i) {
+        auto& scan_info = info.scan_outputs[i];
+        auto& step_shape = scan_info.step_shape;
 
-        auto& outputs = info.intermediate_outputs[i];
-        auto& output_shape = *outputs[i].GetShape();
-
-        vector<int64_t> dims(1 + output_shape.GetDimCount());
-        dims[0] = outputs.size();
-        for (uint32_t j = 0; j < output_shape.GetDimCount(); ++j) {
-            dims[j + 1] = output_shape.GetDim(j);
+        vector<int64_t> dims(1 + step_shape.GetDimCount());
+        dims[0] = scan_info.steps;
+        for (uint32_t j = 0; j < step_shape.GetDimCount(); ++j) {
+            dims[j + 1] = step_shape.GetDim(j);
         }
 
-        auto dst_shape = dst->GetShape();
-        dst_shape->SetDataType(output_shape.GetDataType());
-        dst_shape->SetDataFormat(output_shape.GetDataFormat());
+        auto dst_shape = ctx->GetOutput<TensorImpl>(info.loop_carried_dep_num + i)->GetShape();
+        dst_shape->SetDataType(step_shape.GetDataType());
+        dst_shape->SetDataFormat(step_shape.GetDataFormat());
         dst_shape->Reshape(dims.data(), dims.size());
-
-        auto status = dst->ReallocBuffer();
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "ReallocBuffer for tensor[" << dst->GetName() << "] failed: " << GetRetCodeStr(status);
-            return status;
-        }
-
-        status = concat_output_func(outputs, &dst->GetBufferDesc());
-        if (status != RC_SUCCESS) {
-            return status;
-        }
     }
 
     return RC_SUCCESS;
@@ -358,6 +619,9 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
     LoopInfo loop_info(*ctx);
     utils::GenericCpuDevice tmp_cpu_device;
 
+    // slices may be left by a failed execution
+    DetachScanOutputs(scan_output_writable_, loop_info.loop_carried_dep_num, &subgraph_);
+
     bool keep_going;
     status = GetKeepGoing(*ctx, &keep_going);
     if (status != RC_SUCCESS) {
@@ -380,14 +644,14 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
     int64_t trip_count = 0;
     while (trip_count < max_trip_count && keep_going) {
         if (trip_count != 0) {
-            status = UpdateSubgraphInputs(trip_count, &subgraph_, &tmp_cpu_device);
+            status = UpdateSubgraphInputs(trip_count, &subgraph_, &tmp_cpu_device, &carried_dep_buffers_);
             if (status != RC_SUCCESS) {
                 LOG(ERROR) << "UpdateSubgraphInputs failed: " << GetRetCodeStr(status);
                 return status;
             }
-            status = SaveSubgraphOutputs(&subgraph_, &loop_info);
+            status = PrepareScanOutputs(max_trip_count, scan_output_writable_, &subgraph_, &loop_info, ctx);
             if (status != RC_SUCCESS) {
-                LOG(ERROR) << "SaveSubgraphOutputs failed: " << GetRetCodeStr(status);
+                LOG(ERROR) << "PrepareScanOutputs failed: " << GetRetCodeStr(status);
                 return status;
             }
         }
@@ -398,6 +662,12 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             return status;
         }
 
+        status = AppendScanOutputs(max_trip_count, &subgraph_, &loop_info, ctx);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "AppendScanOutputs failed: " << GetRetCodeStr(status);
+            return status;
+        }
+
         ++trip_count;
         status = subgraph_.GetOutputTensorImpl(0)->CopyToHost(&keep_going);
         if (status != RC_SUCCESS) {
@@ -406,6 +676,8 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
         }
     }
 
+    DetachScanOutputs(scan_output_writable_, loop_info.loop_carried_dep_num, &subgraph_);
+
     if (trip_count == 0) {
         status = SetOutputsFromInputs(loop_info, GetName(), &tmp_cpu_device, &subgraph_, ctx);
         if (status != RC_SUCCESS) {
@@ -413,8 +685,7 @@ RetCode LoopKernel::DoExecute(KernelExecContext* ctx) {
             return status;
         }
     } else {
-        SaveSubgraphOutputs(&subgraph_, &loop_info);
-        status = SetOutputsFromSubgraph(loop_info, &tmp_cpu_device, concat_output_func_, &subgraph_, ctx);
+        status = SetOutputsFromSubgraph(loop_info, &tmp_cpu_device, &subgraph_, ctx);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "SetOutputsFromSubgraph of loop kernel[" << GetName()
                        << "] failed: " << GetRetCodeStr(status);
@@ -20,23 +20,35 @@
 
 #include "ppl/nn/engines/common/common_kernel_impl.h"
 #include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/common/tensor_buffer_info.h"
+#include <vector>
 
 namespace ppl { namespace nn { namespace common {
 
-typedef ppl::common::RetCode (*LoopConcatOutputFunc)(const std::vector<TensorBufferInfo>&, BufferDesc*);
+/**
+   @brief two buffers that a loop-carried dependency ping-pongs between: the subgraph writes its output into
+   `buffers[cur]` while reading the value of the previous iteration from `buffers[1 - cur]`.
+*/
+struct LoopCarriedDepBuffers final {
+    bool is_eligible = false; // the subgraph output is produced by a node and not shared with other outputs
+    uint32_t cur = 0;
+    uint64_t capacities[2] = {0, 0};
+    TensorBufferInfo buffers[2];
+};
 
 class LoopKernel final : public CommonKernelImpl {
 public:
     LoopKernel(const ir::Node* node) : CommonKernelImpl(node) {}
     ppl::common::RetCode SetExecutionInfo(const std::shared_ptr<ir::GraphTopo>&, const RuntimeGraphInfo*,
-                                          const RuntimeAuxInfo*, utils::SharedResource*, LoopConcatOutputFunc func);
+                                          const RuntimeAuxInfo*, utils::SharedResource*);
 
 protected:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
 private:
     RuntimeImpl subgraph_;
-    LoopConcatOutputFunc concat_output_func_;
+    std::vector<LoopCarriedDepBuffers> carried_dep_buffers_;
+    std::vector<bool> scan_output_writable_; // scan outputs that can be written into loop outputs directly
 };
 
 }}} // namespace ppl::nn::common
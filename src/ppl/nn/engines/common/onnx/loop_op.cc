@@ -25,7 +25,7 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace common {
 
-RetCode LoopOp::Init(utils::SharedResource* resource, LoopParam* loop_param, LoopConcatOutputFunc concat_output_func) {
+RetCode LoopOp::Init(utils::SharedResource* resource, LoopParam* loop_param) {
     auto status = utils::ProcessGraph(resource, &loop_param->graph, &graph_info_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "ProcessGraph failed: " << GetRetCodeStr(status);
@@ -40,14 +40,13 @@ RetCode LoopOp::Init(utils::SharedResource* resource, LoopParam* loop_param, Loo
 
     graph_ = loop_param->graph;
     resource_ = resource;
-    concat_output_func_ = concat_output_func;
 
     return RC_SUCCESS;
 }
 
 KernelImpl* LoopOp::CreateKernelImpl() const {
     auto kernel = unique_ptr<LoopKernel>(new LoopKernel(node_));
-    auto status = kernel->SetExecutionInfo(graph_.topo, &graph_info_, &aux_info_, resource_, concat_output_func_);
+    auto status = kernel->SetExecutionInfo(graph_.topo, &graph_info_, &aux_info_, resource_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "SetExecutionInfo of kernel[" << kernel->GetName() << "] failed: " << GetRetCodeStr(status);
         return nullptr;
@@ -31,7 +31,7 @@ namespace ppl { namespace nn { namespace common {
 class LoopOp final {
 public:
     LoopOp(const ir::Node* node) : node_(node), resource_(nullptr) {}
-    ppl::common::RetCode Init(utils::SharedResource*, LoopParam*, LoopConcatOutputFunc);
+    ppl::common::RetCode Init(utils::SharedResource*, LoopParam*);
     KernelImpl* CreateKernelImpl() const;
 
 private:
@@ -40,7 +40,6 @@ private:
     ir::Graph graph_;
     RuntimeGraphInfo graph_info_;
     RuntimeAuxInfo aux_info_;
-    LoopConcatOutputFunc concat_output_func_;
 };
 
 }}} // namespace ppl::nn::common
@@ -34,6 +34,23 @@ RetCode ConvTransposeOp::Init(const OptKernelOptions& options) {
         return status;
     }
 
+    // the shapes inferred by ReshapeConvTranspose() follow onnx, but the cuda kernel only computes the basic case
+    auto& param = param_.param;
+    if (param.group != 1) {
+        LOG(ERROR) << "ConvTranspose with group [" << param.group << "] is not supported.";
+        return RC_UNSUPPORTED;
+    }
+    for (auto x = param.output_padding.begin(); x != param.output_padding.end(); ++x) {
+        if (*x != 0) {
+            LOG(ERROR) << "ConvTranspose with nonzero output_padding is not supported.";
+            return RC_UNSUPPORTED;
+        }
+    }
+    if (param.pads.size() >= 4 && (param.pads[0] != param.pads[2] || param.pads[1] != param.pads[3])) {
+        LOG(ERROR) << "ConvTranspose with asymmetric pads is not supported.";
+        return RC_UNSUPPORTED;
+    }
+
     infer_type_func_ = [](InputOutputInfo* info, std::vector<CudaTensorQuant>* quant, datatype_t type) -> RetCode {
         type = ppl::common::DATATYPE_FLOAT16;
         ppl::common::RetCode status;
@@ -16,7 +16,6 @@
 // under the License.
 
 #include "ppl/nn/engines/cuda/optimizer/ops/onnx/loop_op.h"
-#include "ppl/nn/common/tensor_buffer_info.h"
 
 using namespace std;
 using namespace ppl::common;
@@ -24,23 +23,6 @@ using namespace ppl::nn::common;
 
 namespace ppl { namespace nn { namespace cuda {
 
-static RetCode ConcatOutputs(const vector<TensorBufferInfo>& outputs, BufferDesc* buf) {
-    auto buf_cursor = *buf;
-    for (auto it = outputs.begin(); it != outputs.end(); ++it) {
-        auto device = it->GetDevice();
-        const uint32_t bytes = it->GetShape()->GetBytesIncludingPadding();
-        auto status = device->Copy(&buf_cursor, it->GetBufferDesc(), bytes);
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "copy data failed: " << GetRetCodeStr(status);
-            return status;
-        }
-
-        buf_cursor.addr = (char*)(buf_cursor.addr) + bytes;
-    }
-
-    return RC_SUCCESS;
-}
-
 RetCode LoopOp::Init(const OptKernelOptions& options) {
     infer_dims_func_ = [](InputOutputInfo* info) -> RetCode {
         for (uint32_t i = 0; i < info->GetOutputCount(); ++i) {
@@ -69,7 +51,7 @@ RetCode LoopOp::Init(const OptKernelOptions& options) {
     }
 
     auto loop_param = static_cast<LoopParam*>(attr_ref->second.get());
-    return op_.Init(options.resource, loop_param, ConcatOutputs);
+    return op_.Init(options.resource, loop_param);
 }
 
 KernelImpl* LoopOp::CreateKernelImpl() const {
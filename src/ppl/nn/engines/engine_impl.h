@@ -51,6 +51,30 @@ public:
     /** @brief tells whether this engine implements `node`. */
     virtual bool Supports(const ir::Node* node) const = 0;
 
+    /**
+       @brief estimated time of running `node`, which is supported by this engine, used by cost-aware graph
+       partitioners to compare engines. the unit is the time a reference cpu takes to run an elementwise op, so that
+       costs of all engines are comparable. shapes are unknown when partitioning, so engines scale the
+       engine-independent `EstimateNodeWork()` by how fast they run the node. engines that do not know better run at
+       the reference speed.
+    */
+    virtual double EstimateNodeCost(const ir::Node* node) const {
+        return EstimateNodeWork(node);
+    }
+
+    /** @brief tells whether `node` is a gemm-like op, which costs `EstimateNodeWork()` more than the others */
+    static bool IsGemmLikeNode(const ir::Node* node) {
+        auto& type = node->GetType();
+        return (type.domain == "" &&
+                (type.name == "Conv" || type.name == "ConvTranspose" || type.name == "Gemm" ||
+                 type.name == "MatMul"));
+    }
+
+    /** @brief engine-independent work of `node` in the unit of `EstimateNodeCost()` */
+    static double EstimateNodeWork(const ir::Node* node) {
+        return IsGemmLikeNode(node) ? 4.0 : 1.0;
+    }
+
     /**
        @brief optimize the compute graph `graph` and fill `info`
        @param graph graph to be optimized and can be modified
@@ -0,0 +1,266 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/conv2d_algo_tuner.h"
+#include "ppl/nn/common/logger.h"
+#include <string.h>
+#include <float.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+namespace ppl { namespace nn { namespace x86 {
+
+/*
+  each line of the file is:
+    <key fields> <algo_type> <isa>
+  see GenKey() for key fields.
+*/
+
+static const uint32_t g_key_field_count = 18;
+static const uint32_t g_input_format_field_idx = 14;
+
+static const uint32_t g_warmup_iter = 1;
+static const uint32_t g_max_iter = 10;
+static const double g_max_time_us = 100 * 1000;
+
+string Conv2dAlgoTuner::GenKey(const TensorShape& src_dims, const conv2d_fp32_param& param,
+                               const conv2d_fp32_algo_info& default_algo_info) const {
+    ostringstream oss;
+    oss << param.kernel_h << " " << param.kernel_w << " " << param.stride_h << " " << param.stride_w << " "
+        << param.dilation_h << " " << param.dilation_w << " " << param.pad_h << " " << param.pad_w << " "
+        << param.channels << " " << param.num_output << " " << param.group << " " << src_dims.GetDim(0) << " "
+        << src_dims.GetDim(2) << " " << src_dims.GetDim(3) << " " << default_algo_info.input_format << " "
+        << default_algo_info.output_format << " " << isa_ << " " << thread_pool_.GetNumThreads();
+    return oss.str();
+}
+
+RetCode Conv2dAlgoTuner::Load(const char* filename) {
+    ifstream ifs(filename);
+    if (!ifs.is_open()) {
+        LOG(ERROR) << "open file[" << filename << "] failed.";
+        return RC_NOT_FOUND;
+    }
+
+    string line;
+    uint32_t line_no = 0;
+    while (getline(ifs, line)) {
+        ++line_no;
+        if (line.empty()) {
+            continue;
+        }
+
+        istringstream iss(line);
+        int64_t fields[g_key_field_count];
+        string key;
+        for (uint32_t i = 0; i < g_key_field_count; ++i) {
+            if (!(iss >> fields[i])) {
+                LOG(ERROR) << "invalid key in line [" << line_no << "] of [" << filename << "].";
+                return RC_INVALID_VALUE;
+            }
+            if (i > 0) {
+                key += " ";
+            }
+            key += std::to_string(fields[i]);
+        }
+
+        conv2d_fp32_algo_info algo_info;
+        if (!(iss >> algo_info.algo_type >> algo_info.isa)) {
+            LOG(ERROR) << "invalid algo info in line [" << line_no << "] of [" << filename << "].";
+            return RC_INVALID_VALUE;
+        }
+        algo_info.input_format = fields[g_input_format_field_idx];
+        algo_info.output_format = fields[g_input_format_field_idx + 1];
+
+        results_[key] = algo_info;
+    }
+
+    LOG(INFO) << "[" << results_.size() << "] tuning results are loaded from [" << filename << "].";
+    return RC_SUCCESS;
+}
+
+RetCode Conv2dAlgoTuner::Save(const char* filename) const {
+    ofstream ofs(filename, ios_base::out | ios_base::trunc);
+    if (!ofs.is_open()) {
+        LOG(ERROR) << "open file[" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    for (auto it = results_.begin(); it != results_.end(); ++it) {
+        ofs << it->first << " " << it->second.algo_type << " " << it->second.isa << "\n";
+    }
+
+    if (!ofs.good()) {
+        LOG(ERROR) << "write file[" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    return RC_SUCCESS;
+}
+
+double Conv2dAlgoTuner::Benchmark(const TensorShape& src_shape, const TensorShape& dst_shape,
+                                  const conv2d_fp32_param& param, const conv2d_fp32_algo_info& algo_info,
+                                  const float* filter, const float* bias, const float* src, float* dst) {
+    double min_time_us = DBL_MAX;
+
+    auto mgr = conv2d_algo_selector::gen_algo(param, algo_info, allocator_);
+    if (!mgr) {
+        return min_time_us;
+    }
+
+    conv2d_fp32_executor* exe = nullptr;
+    void* temp_buffer = nullptr;
+
+    auto status = mgr->gen_cvt_weights(filter, bias);
+    if (status != RC_SUCCESS) {
+        goto out;
+    }
+
+    exe = mgr->gen_executor();
+    if (!exe) {
+        goto out;
+    }
+    exe->set_src_shape(&src_shape);
+    exe->set_dst_shape(&dst_shape);
+    exe->set_sum_src_shape(&dst_shape);
+    exe->set_src(src);
+    exe->set_dst(dst);
+
+    status = exe->prepare();
+    if (status != RC_SUCCESS) {
+        goto out;
+    }
+
+    temp_buffer = allocator_->Alloc(exe->cal_temp_buffer_size());
+    if (!temp_buffer) {
+        goto out;
+    }
+    exe->set_temp_buffer(temp_buffer);
+
+    for (uint32_t i = 0; i < g_warmup_iter; ++i) {
+        status = exe->execute();
+        if (status != RC_SUCCESS) {
+            goto out;
+        }
+    }
+
+    {
+        double total_time_us = 0;
+        for (uint32_t i = 0; i < g_max_iter && total_time_us < g_max_time_us; ++i) {
+            auto begin_ts = std::chrono::high_resolution_clock::now();
+            exe->execute();
+            auto end_ts = std::chrono::high_resolution_clock::now();
+            double time_us = std::chrono::duration_cast<std::chrono::nanoseconds>(end_ts - begin_ts).count() / 1e3;
+            total_time_us += time_us;
+            if (time_us < min_time_us) {
+                min_time_us = time_us;
+            }
+        }
+    }
+
+out:
+    if (temp_buffer) {
+        allocator_->Free(temp_buffer);
+    }
+    delete exe;
+    mgr->release_cvt_weights();
+    delete mgr;
+    return min_time_us;
+}
+
+conv2d_fp32_algo_info Conv2dAlgoTuner::Tune(const TensorShape& src_dims, const conv2d_fp32_param& param,
+                                            const conv2d_fp32_algo_info& default_algo_info, const float* filter,
+                                            const float* bias) {
+    if (src_dims.GetDimCount() != 4) {
+        return default_algo_info;
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (src_dims.GetDim(i) <= 0) {
+            return default_algo_info;
+        }
+    }
+
+    const string key = GenKey(src_dims, param, default_algo_info);
+    auto ref = results_.find(key);
+    if (ref != results_.end()) {
+        return ref->second;
+    }
+
+    auto candidates = conv2d_algo_selector::get_candidate_algos(default_algo_info, param, isa_);
+    if (candidates.size() <= 1) {
+        return default_algo_info;
+    }
+
+    const int64_t src_h = src_dims.GetDim(2);
+    const int64_t src_w = src_dims.GetDim(3);
+    const int64_t dst_h =
+        (src_h + 2 * param.pad_h - param.dilation_h * (param.kernel_h - 1) - 1) / param.stride_h + 1;
+    const int64_t dst_w =
+        (src_w + 2 * param.pad_w - param.dilation_w * (param.kernel_w - 1) - 1) / param.stride_w + 1;
+
+    TensorShape src_shape;
+    src_shape.SetDataType(DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(default_algo_info.input_format);
+    src_shape.Reshape({src_dims.GetDim(0), param.channels, src_h, src_w});
+
+    TensorShape dst_shape;
+    dst_shape.SetDataType(DATATYPE_FLOAT32);
+    dst_shape.SetDataFormat(default_algo_info.output_format);
+    dst_shape.Reshape({src_dims.GetDim(0), param.num_output, dst_h, dst_w});
+
+    auto src = (float*)allocator_->Alloc(src_shape.GetBytesIncludingPadding());
+    auto dst = (float*)allocator_->Alloc(dst_shape.GetBytesIncludingPadding());
+    if (!src || !dst) {
+        LOG(WARNING) << "allocate buffers for tuning failed.";
+        if (src) {
+            allocator_->Free(src);
+        }
+        if (dst) {
+            allocator_->Free(dst);
+        }
+        return default_algo_info;
+    }
+    memset(src, 0, src_shape.GetBytesIncludingPadding());
+
+    thread_pool_.Acquire();
+
+    auto best_algo_info = default_algo_info;
+    double best_time_us = DBL_MAX;
+    for (auto c = candidates.begin(); c != candidates.end(); ++c) {
+        const double time_us = Benchmark(src_shape, dst_shape, param, *c, filter, bias, src, dst);
+        LOG(DEBUG) << "conv2d algo [" << c->algo_type << "] isa [" << c->isa << "] of [" << key << "] costs ["
+                   << time_us << "] us.";
+        if (time_us < best_time_us) {
+            best_time_us = time_us;
+            best_algo_info = *c;
+        }
+    }
+
+    thread_pool_.Release();
+
+    allocator_->Free(src);
+    allocator_->Free(dst);
+
+    results_[key] = best_algo_info;
+    return best_algo_info;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_CONV2D_ALGO_TUNER_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_CONV2D_ALGO_TUNER_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/common/allocator.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/nn/engines/x86/omp_thread_pool.h"
+#include <string>
+#include <map>
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @class Conv2dAlgoTuner
+   @brief selects conv2d algorithms by running all candidates. results are keyed by conv param,
+   input shape, isa and number of threads, and can be saved into a file for later use.
+*/
+class Conv2dAlgoTuner final {
+public:
+    /**
+       @param num_threads, cores threads used by runtimes of the engine, see `OmpThreadPool::Init()`.
+       candidates are benchmarked with the same threads.
+    */
+    Conv2dAlgoTuner(ppl::common::isa_t isa, ppl::common::Allocator* ar, uint32_t num_threads,
+                    const std::vector<int32_t>& cores)
+        : isa_(isa), allocator_(ar) {
+        thread_pool_.Init(num_threads, cores);
+    }
+
+    /** @brief loads results from file `filename` */
+    ppl::common::RetCode Load(const char* filename);
+
+    /** @brief saves results, including those loaded by `Load()`, into file `filename` */
+    ppl::common::RetCode Save(const char* filename) const;
+
+    /**
+       @brief selects the fastest algorithm which has the same input and output formats as `default_algo_info`.
+       @param src_dims dims of input in NCHW. data formats are ignored.
+       @return `default_algo_info` if tuning cannot be performed.
+    */
+    ppl::kernel::x86::conv2d_fp32_algo_info Tune(const TensorShape& src_dims,
+                                                 const ppl::kernel::x86::conv2d_fp32_param& param,
+                                                 const ppl::kernel::x86::conv2d_fp32_algo_info& default_algo_info,
+                                                 const float* filter, const float* bias);
+
+private:
+    std::string GenKey(const TensorShape& src_dims, const ppl::kernel::x86::conv2d_fp32_param& param,
+                       const ppl::kernel::x86::conv2d_fp32_algo_info& default_algo_info) const;
+    double Benchmark(const TensorShape& src_shape, const TensorShape& dst_shape,
+                     const ppl::kernel::x86::conv2d_fp32_param& param,
+                     const ppl::kernel::x86::conv2d_fp32_algo_info& algo_info, const float* filter,
+                     const float* bias, const float* src, float* dst);
+
+private:
+    const ppl::common::isa_t isa_;
+    ppl::common::Allocator* allocator_;
+    OmpThreadPool thread_pool_;
+    std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> results_;
+
+private:
+    Conv2dAlgoTuner(const Conv2dAlgoTuner&) = delete;
+    Conv2dAlgoTuner& operator=(const Conv2dAlgoTuner&) = delete;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
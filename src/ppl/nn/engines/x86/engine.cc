@@ -16,12 +16,14 @@
 // under the License.
 
 #include <stdarg.h>
+#include <fstream>
 
 #include "ppl/nn/engines/x86/engine.h"
 #include "ppl/nn/engines/x86/engine_context.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel_creator_manager.h"
 #include "ppl/nn/engines/x86/optimizer/opt_graph.h"
 #include "ppl/nn/engines/utils.h"
+#include "ppl/nn/quantization/quant_param_parser.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/kernel/x86/common/simd_tools.h"
 #include "ppl/kernel/x86/common/general_include.h"
@@ -42,11 +44,39 @@ X86Engine::X86Engine() : EngineImpl("x86"), device_(X86_DEFAULT_ALIGNMENT, ppl::
 
 RetCode X86Engine::Init(const X86EngineOptions& options) {
     options_ = options;
+
+    if (options_.forward_precision != DATATYPE_FLOAT32 && options_.forward_precision != DATATYPE_BFLOAT16) {
+        LOG(ERROR) << "x86 engine only support fp32 & bf16 forward precision.";
+        return RC_INVALID_VALUE;
+    }
+#ifndef PPL_USE_X86_BF16
+    if (options_.forward_precision == DATATYPE_BFLOAT16) {
+        LOG(WARNING) << "current build does not support avx512-bf16 or amx-bf16, ops run in fp32 instead.";
+    }
+#endif
+
+    if (options_.huge_page == X86_HUGE_PAGE_NONE) {
+        huge_page_size_ = 0;
+    } else if (options_.huge_page == X86_HUGE_PAGE_2M) {
+        huge_page_size_ = utils::HugePageAllocator::kPageSize2M;
+    } else if (options_.huge_page == X86_HUGE_PAGE_1G) {
+        huge_page_size_ = utils::HugePageAllocator::kPageSize1G;
+    } else {
+        LOG(ERROR) << "invalid huge page option [" << options_.huge_page << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    if (huge_page_size_ > 0 || options_.numa_node_id >= 0) {
+        allocator_.reset(new utils::HugePageAllocator(huge_page_size_, options_.numa_node_id, X86_DEFAULT_ALIGNMENT));
+        device_.SetAllocator(allocator_.get());
+    }
+
     return RC_SUCCESS;
 }
 
 EngineContext* X86Engine::CreateEngineContext() {
-    return new X86EngineContext(device_.GetISA(), options_.mm_policy);
+    return new X86EngineContext(device_.GetISA(), options_.mm_policy, options_.num_threads, binding_cores_,
+                                huge_page_size_, options_.numa_node_id);
 }
 
 bool X86Engine::Supports(const ir::Node* node) const {
@@ -54,6 +84,59 @@ bool X86Engine::Supports(const ir::Node* node) const {
     return (OptKernelCreatorManager::Instance()->Find(type.domain, type.name, type.version) != nullptr);
 }
 
+double X86Engine::EstimateNodeCost(const ir::Node* node) const {
+    // fp32 runs at the reference speed, and bf16 doubles the throughput of gemm-like ops
+    auto work = EstimateNodeWork(node);
+    if (options_.forward_precision == DATATYPE_BFLOAT16 && IsGemmLikeNode(node)) {
+        return work / 2.0;
+    }
+    return work;
+}
+
+RetCode X86Engine::InitPackedWeightsCache() {
+    if (packed_weights_cache_ || (export_packed_weights_file_.empty() && import_packed_weights_file_.empty())) {
+        return RC_SUCCESS;
+    }
+
+    packed_weights_cache_.reset(new PackedWeightsCache(device_.GetAllocator()));
+
+    // isa may be changed by options, so that the file is imported just before it is used
+    if (!import_packed_weights_file_.empty()) {
+        auto status = packed_weights_cache_->Import(import_packed_weights_file_.c_str(), device_.GetISA());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "import packed weights from [" << import_packed_weights_file_
+                       << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::InitConv2dAlgoTuner() {
+    if (conv2d_algo_tuner_ || options_.dynamic_tuning_level == X86_TUNING_OFF) {
+        return RC_SUCCESS;
+    }
+
+    conv2d_algo_tuner_.reset(new Conv2dAlgoTuner(device_.GetISA(), device_.GetAllocator(), options_.num_threads,
+                                                 binding_cores_));
+
+    if (!tuning_cache_file_.empty()) {
+        ifstream ifs(tuning_cache_file_);
+        if (ifs.is_open()) { // file will be generated if it does not exist
+            ifs.close();
+            auto status = conv2d_algo_tuner_->Load(tuning_cache_file_.c_str());
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "load tuning results from [" << tuning_cache_file_
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
 RetCode X86Engine::DoOptimize(ir::Graph* graph, utils::SharedResource* resource, RuntimePartitionInfo* info) {
     OptGraph opt_graph;
     auto status = opt_graph.Init(graph, resource, info);
@@ -62,7 +145,20 @@ RetCode X86Engine::DoOptimize(ir::Graph* graph, utils::SharedResource* resource,
         return status;
     }
 
-    status = opt_graph.DoOptimize(&device_);
+    status = InitPackedWeightsCache();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "InitPackedWeightsCache failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    status = InitConv2dAlgoTuner();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "InitConv2dAlgoTuner failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    status = opt_graph.DoOptimize(&device_, packed_weights_cache_.get(), conv2d_algo_tuner_.get(), &quant_info_,
+                                 options_.forward_precision);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "OptGraph DoOptimize failed: " << GetRetCodeStr(status);
         return status;
@@ -131,6 +227,23 @@ RetCode X86Engine::ProcessGraph(utils::SharedResource* resource, ir::Graph* grap
         return status;
     }
 
+    if (conv2d_algo_tuner_ && !tuning_cache_file_.empty()) {
+        status = conv2d_algo_tuner_->Save(tuning_cache_file_.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "save tuning results to [" << tuning_cache_file_ << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    if (!export_packed_weights_file_.empty()) {
+        status = packed_weights_cache_->Export(export_packed_weights_file_.c_str(), device_.GetISA());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "export packed weights to [" << export_packed_weights_file_
+                       << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
     return RC_SUCCESS;
 }
 
@@ -152,9 +265,81 @@ RetCode X86Engine::DisableAVXFMA3(X86Engine* engine, va_list) {
     return RC_SUCCESS;
 }
 
+RetCode X86Engine::ExportPackedWeights(X86Engine* engine, va_list args) {
+    auto file = va_arg(args, const char*);
+    if (!file) {
+        LOG(ERROR) << "file for exporting packed weights is empty.";
+        return RC_INVALID_VALUE;
+    }
+    engine->export_packed_weights_file_ = file;
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::ImportPackedWeights(X86Engine* engine, va_list args) {
+    auto file = va_arg(args, const char*);
+    if (!file) {
+        LOG(ERROR) << "file for importing packed weights is empty.";
+        return RC_INVALID_VALUE;
+    }
+    engine->import_packed_weights_file_ = file;
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetTuningCacheFile(X86Engine* engine, va_list args) {
+    auto file = va_arg(args, const char*);
+    if (!file) {
+        LOG(ERROR) << "tuning cache file is empty.";
+        return RC_INVALID_VALUE;
+    }
+    engine->tuning_cache_file_ = file;
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetQuantInfo(X86Engine* engine, va_list args) {
+    auto json_str = va_arg(args, const char*);
+    if (!json_str) {
+        LOG(ERROR) << "empty quantization info string.";
+        return RC_INVALID_VALUE;
+    }
+
+    auto status = QuantParamParser::ParseBuffer(json_str, &engine->quant_info_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "parse quantization buffer failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    LOG(DEBUG) << "Quant tensor size: " << engine->quant_info_.tensor_params.size();
+    LOG(DEBUG) << "Quant node size: " << engine->quant_info_.node_params.size();
+    return RC_SUCCESS;
+}
+
+RetCode X86Engine::SetCoreBinding(X86Engine* engine, va_list args) {
+    auto cores = va_arg(args, const int32_t*);
+    auto num_cores = va_arg(args, uint32_t);
+    if (num_cores > 0 && !cores) {
+        LOG(ERROR) << "core list is empty.";
+        return RC_INVALID_VALUE;
+    }
+
+    for (uint32_t i = 0; i < num_cores; ++i) {
+        if (cores[i] < 0) {
+            LOG(ERROR) << "invalid core id[" << cores[i] << "].";
+            return RC_INVALID_VALUE;
+        }
+    }
+
+    engine->binding_cores_.assign(cores, cores + num_cores);
+    return RC_SUCCESS;
+}
+
 X86Engine::ConfHandlerFunc X86Engine::conf_handlers_[] = {
     X86Engine::DisableAVX512,
     X86Engine::DisableAVXFMA3,
+    X86Engine::ExportPackedWeights,
+    X86Engine::ImportPackedWeights,
+    X86Engine::SetTuningCacheFile,
+    X86Engine::SetQuantInfo,
+    X86Engine::SetCoreBinding,
 };
 
 RetCode X86Engine::Configure(uint32_t option, ...) {
@@ -21,6 +21,11 @@
 #include "ppl/nn/engines/engine_impl.h"
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/engines/x86/x86_engine_options.h"
+#include "ppl/nn/engines/x86/packed_weights_cache.h"
+#include "ppl/nn/engines/x86/conv2d_algo_tuner.h"
+#include "ppl/nn/quantization/quant_param_info.h"
+#include "ppl/nn/utils/huge_page_allocator.h"
+#include <memory>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -31,11 +36,14 @@ public:
     ppl::common::RetCode Configure(uint32_t, ...) override;
     EngineContext* CreateEngineContext() override;
     bool Supports(const ir::Node*) const override;
+    double EstimateNodeCost(const ir::Node*) const override;
     ppl::common::RetCode ProcessGraph(utils::SharedResource*, ir::Graph*, RuntimePartitionInfo*) override;
 
 private:
     ppl::common::RetCode DoOptimize(ir::Graph*, utils::SharedResource*, RuntimePartitionInfo*);
     ppl::common::RetCode CalDataOmittedConstants(const ir::Graph&, const RuntimePartitionInfo&, std::set<edgeid_t>*) const;
+    ppl::common::RetCode InitPackedWeightsCache();
+    ppl::common::RetCode InitConv2dAlgoTuner();
 
 private:
     /*
@@ -44,13 +52,36 @@ private:
      */
     static ppl::common::RetCode DisableAVX512(X86Engine*, va_list);
     static ppl::common::RetCode DisableAVXFMA3(X86Engine*, va_list);
+    static ppl::common::RetCode ExportPackedWeights(X86Engine*, va_list);
+    static ppl::common::RetCode ImportPackedWeights(X86Engine*, va_list);
+    static ppl::common::RetCode SetTuningCacheFile(X86Engine*, va_list);
+    static ppl::common::RetCode SetQuantInfo(X86Engine*, va_list);
+    static ppl::common::RetCode SetCoreBinding(X86Engine*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(X86Engine*, va_list);
     static ConfHandlerFunc conf_handlers_[X86_CONF_MAX];
 
 private:
+    // used by `device_` if huge pages or numa binding is required. MUST be destroyed after users of `device_`.
+    std::unique_ptr<utils::HugePageAllocator> allocator_;
+    uint64_t huge_page_size_ = 0;
+
     X86Device device_;
     X86EngineOptions options_;
+
+    // created when exporting or importing packed weights is required
+    std::unique_ptr<PackedWeightsCache> packed_weights_cache_;
+    std::string export_packed_weights_file_;
+    std::string import_packed_weights_file_;
+
+    // created when `options_.dynamic_tuning_level` is not X86_TUNING_OFF
+    std::unique_ptr<Conv2dAlgoTuner> conv2d_algo_tuner_;
+    std::string tuning_cache_file_;
+
+    QuantParamInfo quant_info_;
+
+    // cores that threads of runtimes created afterwards are pinned to
+    std::vector<int32_t> binding_cores_;
 };
 
 }}} // namespace ppl::nn::x86
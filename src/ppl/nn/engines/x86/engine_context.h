@@ -20,6 +20,7 @@
 
 #include "ppl/nn/engines/x86/runtime_x86_device.h"
 #include "ppl/nn/engines/engine_context.h"
+#include "ppl/nn/utils/huge_page_allocator.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -27,7 +28,18 @@ namespace ppl { namespace nn { namespace x86 {
 
 class X86EngineContext final : public EngineContext {
 public:
-    X86EngineContext(ppl::common::isa_t isa, uint32_t mm_policy) : device_(X86_DEFAULT_ALIGNMENT, isa, mm_policy) {}
+    /**
+       @param huge_page_size 0 or page size of `utils::HugePageAllocator`
+       @param numa_node_id buffers are bound to this numa node if it is not negative
+    */
+    X86EngineContext(ppl::common::isa_t isa, uint32_t mm_policy, uint32_t num_threads,
+                     const std::vector<int32_t>& cores, uint64_t huge_page_size, int32_t numa_node_id)
+        : device_(X86_DEFAULT_ALIGNMENT, isa, mm_policy,
+                  (huge_page_size > 0 || numa_node_id >= 0)
+                      ? std::make_shared<utils::HugePageAllocator>(huge_page_size, numa_node_id, X86_DEFAULT_ALIGNMENT)
+                      : nullptr) {
+        device_.InitThreadPool(num_threads, cores);
+    }
 
     Device* GetDevice() override {
         return &device_;
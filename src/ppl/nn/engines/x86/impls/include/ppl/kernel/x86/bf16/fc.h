@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_FC_H_
+#define __ST_PPL_KERNEL_X86_BF16_FC_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/fc_common.h"
+#include "ppl/kernel/x86/bf16/gemm_bf16.h"
+#include "ppl/common/allocator.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// bf16 fc on fp32 tensors, y = x * w + b, accumulated in fp32.
+// x is [..., channels], every leading dim is folded into M.
+struct fc_bf16_param {
+    int64_t channels;
+    int64_t num_output;
+    fc_fuse_flag_t fuse_flag;
+};
+
+class fc_bf16_manager {
+public:
+    fc_bf16_manager(const fc_bf16_param &param, const gemm_bf16_isa_t isa, ppl::common::Allocator *allocator)
+        : param_(param), isa_(isa), allocator_(allocator) {}
+    ~fc_bf16_manager()
+    {
+        release_cvt_weights();
+    }
+
+    void set_param(const fc_bf16_param &param)
+    {
+        param_ = param;
+    }
+    const fc_bf16_param &param() const
+    {
+        return param_;
+    }
+    gemm_bf16_isa_t isa() const
+    {
+        return isa_;
+    }
+
+    // filter is [num_output][channels] when filter_trans is true, else [channels][num_output].
+    // bias may be nullptr
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const bool filter_trans, const float *bias);
+    void release_cvt_weights();
+
+    uint64_t cal_temp_buffer_size(const ppl::nn::TensorShape &src_shape) const;
+    ppl::common::RetCode execute(
+        const ppl::nn::TensorShape &src_shape,
+        const float *src,
+        float *dst,
+        void *temp_buffer) const;
+
+private:
+    fc_bf16_param param_;
+    gemm_bf16_isa_t isa_;
+    ppl::common::Allocator *allocator_;
+
+    void *cvt_buffer_       = nullptr;
+    bfloat16_t *cvt_filter_ = nullptr; // [K2][ldb][2]
+    float *cvt_bias_        = nullptr;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
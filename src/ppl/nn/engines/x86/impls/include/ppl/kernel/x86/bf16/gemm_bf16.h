@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_GEMM_BF16_H_
+#define __ST_PPL_KERNEL_X86_BF16_GEMM_BF16_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+typedef uint16_t bfloat16_t;
+
+typedef uint32_t gemm_bf16_isa_t;
+
+class gemm_bf16_isa {
+public:
+    static const gemm_bf16_isa_t REF        = 0;
+    static const gemm_bf16_isa_t AVX512BF16 = 1; // vdpbf16ps
+    static const gemm_bf16_isa_t AMX        = 2; // tdpbf16ps
+};
+
+typedef uint32_t gemm_bf16_post_t;
+
+class gemm_bf16_post {
+public:
+    enum {
+        NONE  = 0,
+        RELU  = 1 << 0,
+        RELU6 = 1 << 1,
+    };
+};
+
+struct gemm_bf16_post_param {
+    const float *m_bias; // per row bias, nullptr means 0.0f
+    const float *n_bias; // per column bias, nullptr means 0.0f
+    gemm_bf16_post_t post;
+};
+
+// k is padded to 32 so that one amx tile row of A covers it exactly
+inline int64_t gemm_bf16_lda(const int64_t K)
+{
+    return (K + 31) / 32 * 32;
+}
+
+inline int64_t gemm_bf16_k2(const int64_t K)
+{
+    return gemm_bf16_lda(K) / 2;
+}
+
+// rows of A which must be readable, rows after M are never stored to C
+inline int64_t gemm_bf16_m_pad(const int64_t M)
+{
+    return (M + 31) / 32 * 32;
+}
+
+inline int64_t gemm_bf16_ldb(const int64_t N)
+{
+    return (N + 31) / 32 * 32;
+}
+
+gemm_bf16_isa_t gemm_bf16_select_isa(const ppl::common::isa_t isa_flags);
+
+void cvt_fp32_to_bf16(const float *src, const int64_t len, bfloat16_t *dst);
+
+/*
+    C[m][n] = post(sum_k(A[m][k] * B[k][n]) + m_bias[m] + n_bias[n]), accumulated in fp32
+
+    A: bf16 [gemm_bf16_m_pad(M)][lda], lda = gemm_bf16_lda(K), k tail must be zero
+    B: bf16 packed as [K2][ldb][2], 2 consecutive k of one column in 4 bytes, k tail must be zero
+    C: fp32 [M][ldc]
+*/
+ppl::common::RetCode gemm_bf16(
+    const gemm_bf16_isa_t isa,
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,34 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#ifndef __ST_PPL_KERNEL_X86_BF16_GEMM_V2_H_
+#define __ST_PPL_KERNEL_X86_BF16_GEMM_V2_H_
+
+#include "ppl/kernel/x86/common/gemm_v2_common.h"
+#include "ppl/kernel/x86/bf16/gemm_bf16.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// gemm_v2 on fp32 tensors with bf16 multiplication and fp32 accumulation, for B that is
+// not constant. A and B are rounded to bf16 into the temp buffer on every call, alpha,
+// beta * C and relu are applied in fp32 afterwards.
+uint64_t gemm_v2_bf16_get_buffer_bytes(const gemm_v2_param_fp32 &param);
+
+ppl::common::RetCode gemm_v2_bf16(const gemm_bf16_isa_t isa, const gemm_v2_param_fp32 &param, void *temp_buffer);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
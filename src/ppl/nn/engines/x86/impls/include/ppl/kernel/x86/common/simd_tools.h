@@ -24,6 +24,15 @@ namespace ppl { namespace kernel { namespace x86 {
 
 void set_denormals_zero(const int32_t on);
 
+// cpu features not covered by ppl::common::isa_t, from cpuid only.
+// callers must also check the os-enabled isa reported by GetCpuISA().
+bool cpu_supports_avx2();
+bool cpu_supports_avx512vnni();
+bool cpu_supports_avx512bf16();
+
+// also requests tile data permission from os for this process when needed
+bool cpu_enable_amx_bf16();
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
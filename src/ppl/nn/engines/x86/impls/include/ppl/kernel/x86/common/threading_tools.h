@@ -29,11 +29,16 @@ namespace ppl { namespace kernel { namespace x86 {
     mode:
         0: binding by core list
         1: binding by omp tid
+        2: every thread may run on any core of the list
 */
 void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const int32_t mode);
 
 int32_t get_omp_max_threads();
 
+// omp keeps the number of threads and the worker team per calling thread,
+// so this only affects parallel regions started from the calling thread.
+void set_omp_num_threads(const int32_t num_threads);
+
 struct single_parallel_loop_config_t {
     int64_t depth_of_loop;
     int64_t num_threads;
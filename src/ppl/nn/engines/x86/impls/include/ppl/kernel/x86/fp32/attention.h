@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_ATTENTION_H_
+#define __ST_PPL_KERNEL_X86_FP32_ATTENTION_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// dst = softmax(scale * q * kt + mask) * v, with softmax over the last dim
+// q: [..., q_len, head_dim], kt: [..., head_dim, kv_len], v: [..., kv_len, v_head_dim], dst: [..., q_len, v_head_dim]
+// leading dims of q, kt and v broadcast like MatMul, so k and v can be shared by heads as in multi-query attention.
+// mask is optional and broadcasts to [..., q_len, kv_len].
+// scores are computed for a small block of queries at a time, so the full [q_len, kv_len] matrix is never stored.
+
+uint64_t scaled_dot_product_attention_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape);
+
+ppl::common::RetCode scaled_dot_product_attention_fp32(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *q,
+    const float *kt,
+    const float *v,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst);
+
+ppl::common::RetCode scaled_dot_product_attention_fp32_fma(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *q,
+    const float *kt,
+    const float *v,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst);
+
+#ifdef PPL_USE_X86_AVX512
+ppl::common::RetCode scaled_dot_product_attention_fp32_avx512(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *q,
+    const float *kt,
+    const float *v,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst);
+#endif
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
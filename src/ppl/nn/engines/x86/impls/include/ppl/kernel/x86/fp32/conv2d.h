@@ -19,6 +19,7 @@
 #define __ST_PPL_KERNEL_X86_FP32_CONV2D_H_
 
 #include <string>
+#include <vector>
 
 #include "ppl/kernel/x86/common/general_include.h"
 #include "ppl/kernel/x86/common/conv_common.h"
@@ -93,6 +94,9 @@ public:
     static const conv2d_fp32_algo_t DIRECT          = 5;
     static const conv2d_fp32_algo_t WINOGRAD_B2F3   = 32;
     static const conv2d_fp32_algo_t WINOGRAD_B4F3   = 33;
+    static const conv2d_fp32_algo_t WINOGRAD_B6F3   = 34;
+    static const conv2d_fp32_algo_t WINOGRAD_B2F5   = 35;
+    static const conv2d_fp32_algo_t WINOGRAD_B4F5   = 36;
     static const conv2d_fp32_algo_t GEMM_DIRECT_V2  = 61;
     static const conv2d_fp32_algo_t DIRECT_V2       = 62;
 };
@@ -349,6 +353,8 @@ class conv2d_algo_selector {
 public:
     static conv2d_fp32_algo_info select_algo(const ppl::common::dataformat_t src_format, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
     static conv2d_fp32_manager *gen_algo(const conv2d_fp32_param &param, const conv2d_fp32_algo_info &algo_info, ppl::common::Allocator *allocator);
+    // all supported algorithms which have the same input and output formats as `algo_info`, used for tuning
+    static std::vector<conv2d_fp32_algo_info> get_candidate_algos(const conv2d_fp32_algo_info &algo_info, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags);
 };
 
 }}}; // namespace ppl::kernel::x86
@@ -19,6 +19,7 @@
 #define __ST_PPL_KERNEL_X86_FP32_CONV_TRANSPOSE_H_
 
 #include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/conv_common.h"
 
 namespace ppl { namespace kernel { namespace x86 {
 
@@ -129,6 +130,55 @@ ppl::common::RetCode conv_transpose_ndarray_fp32_sse(
     float *tmp_buffer,
     float *output);
 
+// filter: (channels, num_output, kernel_h, kernel_w) is converted to (num_output/16, kernel_h, kernel_w, channels, 16),
+// and bias is padded to a multiple of 16. group is not supported.
+uint64_t conv_transpose_n16cx_fp32_fma_get_cvt_filter_bytes(
+    const int32_t channels,
+    const int32_t num_output,
+    const int32_t kernel_h,
+    const int32_t kernel_w);
+
+ppl::common::RetCode conv_transpose_n16cx_fp32_fma_cvt_filter(
+    const float *filter,
+    const int32_t channels,
+    const int32_t num_output,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    float *cvt_filter);
+
+uint64_t conv_transpose_n16cx_fp32_fma_get_cvt_bias_bytes(
+    const int32_t num_output);
+
+// bias can be nullptr
+ppl::common::RetCode conv_transpose_n16cx_fp32_fma_cvt_bias(
+    const float *bias,
+    const int32_t num_output,
+    float *cvt_bias);
+
+// direct convolution over output pixels, each of which only gathers the input pixels that stride onto it
+// fuse_flag accepts conv_fuse_flag::RELU and conv_fuse_flag::RELU6
+ppl::common::RetCode conv_transpose_n16cx_fp32_fma(
+    const float *input,
+    const float *cvt_filter,
+    const float *cvt_bias,
+    const int32_t src_h,
+    const int32_t src_w,
+    const int32_t dst_h,
+    const int32_t dst_w,
+    const int32_t batch,
+    const int32_t channels,
+    const int32_t num_output,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t hole_h,
+    const int32_t hole_w,
+    const conv_fuse_flag_t fuse_flag,
+    float *output);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif
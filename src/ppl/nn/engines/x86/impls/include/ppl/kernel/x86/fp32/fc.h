@@ -242,6 +242,18 @@ public:
         return cvt_bias_size_;
     }
 
+    // converted bias always begins with num_output plain values, so a bias fused later can be accumulated into it
+    ppl::common::RetCode add_cvt_bias(const float *bias)
+    {
+        if (cvt_bias_ == nullptr || cvt_bias_size_ < (uint64_t)param_.num_output) {
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        for (int64_t i = 0; i < param_.num_output; ++i) {
+            cvt_bias_[i] += bias[i];
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
     void release_cvt_weights()
     {
         if (cvt_filter_) {
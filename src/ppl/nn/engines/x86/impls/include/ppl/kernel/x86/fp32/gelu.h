@@ -0,0 +1,45 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_GELU_H_
+#define __ST_PPL_KERNEL_X86_FP32_GELU_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// y = 0.5 * x * (1 + erf(x / sqrt(2)))
+ppl::common::RetCode gelu_fp32(
+    const ppl::nn::TensorShape *x_shape,
+    const float *x,
+    float *y);
+
+ppl::common::RetCode gelu_fp32_fma(
+    const ppl::nn::TensorShape *x_shape,
+    const float *x,
+    float *y);
+
+#ifdef PPL_USE_X86_AVX512
+ppl::common::RetCode gelu_fp32_avx512(
+    const ppl::nn::TensorShape *x_shape,
+    const float *x,
+    float *y);
+#endif
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
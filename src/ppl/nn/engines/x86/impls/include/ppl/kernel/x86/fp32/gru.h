@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_GRU_H_
+#define __ST_PPL_KERNEL_X86_FP32_GRU_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/rnn_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+uint64_t gru_ref_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h);
+
+ppl::common::RetCode gru_ref_fp32(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h);
+
+uint64_t gru_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    const bool has_Y,
+    const bool has_Y_h);
+
+// packs weights into temp_buffer and runs gru_packed_fp32_fma(), for non-constant weights
+ppl::common::RetCode gru_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h);
+
+uint64_t gru_packed_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    const bool has_Y,
+    const bool has_Y_h);
+
+// folded_bias: (num_direction, 3 * hidden_size), bias of gates z and r is (Wb + Rb),
+// and bias of gate h is Wbh, or (Wbh + Rbh) if not linear_before_reset
+// Rbh: (num_direction, hidden_size), only written if linear_before_reset
+// bias can be nullptr
+ppl::common::RetCode gru_fp32_fma_fold_bias(
+    const float *bias,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    float *folded_bias,
+    float *Rbh);
+
+// X_proj: (seq_len, batch, num_direction, 3 * hidden_size), X * W^T + bias folded by gru_fp32_fma_fold_bias()
+// packed_R_weight: R packed by rnn_fp32_fma_pack_recurrent_weight()
+// Rbh: (num_direction, hidden_size), recurrent bias of gate h, only used if linear_before_reset
+// directions run in parallel, and gate activations are applied right after the recurrent gemm of each tile
+ppl::common::RetCode gru_packed_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X_proj,
+    const float *packed_R_weight,
+    const float *Rbh,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -73,6 +73,32 @@ ppl::common::RetCode lstm_fp32_fma(
     float *Y_h,
     float *Y_c);
 
+uint64_t lstm_packed_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h,
+    const bool has_Y_c);
+
+// X_proj: (seq_len, batch, num_direction, 4 * hidden_size), X * W^T + Wb + Rb of all timesteps
+// packed_R_weight: R packed by rnn_fp32_fma_pack_recurrent_weight()
+// directions run in parallel, and gate activations are applied right after the recurrent gemm of each tile
+ppl::common::RetCode lstm_packed_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X_proj,
+    const float *packed_R_weight,
+    const float *P_weight,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const float *initial_c,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h,
+    float *Y_c);
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_GEMM_H_
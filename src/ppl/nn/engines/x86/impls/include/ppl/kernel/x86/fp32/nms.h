@@ -24,17 +24,45 @@ namespace ppl { namespace kernel { namespace x86 {
 
 ppl::common::RetCode nms_ndarray_fp32(
     const float *boxes,
-    const float *scommons,
+    const float *scores,
     const uint32_t num_boxes_in,
     const uint32_t batch,
     const uint32_t num_classes,
     const bool center_point_box,
     const int64_t max_output_boxes_per_batch_per_class,
     const float iou_threshold,
-    const float scommon_threshold,
+    const float score_threshold,
     int64_t *dst,
     int64_t *num_boxes_out);
 
+ppl::common::RetCode nms_ndarray_fp32_fma(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    int64_t *dst,
+    int64_t *num_boxes_out);
+
+#ifdef PPL_USE_X86_AVX512
+ppl::common::RetCode nms_ndarray_fp32_avx512(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    int64_t *dst,
+    int64_t *num_boxes_out);
+#endif
+
 }}}; // namespace ppl::kernel::x86
 
 #endif //! __ST_PPL_KERNEL_X86_FP32_NMS_H_
@@ -0,0 +1,43 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_RNN_H_
+#define __ST_PPL_KERNEL_X86_FP32_RNN_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/rnn_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// recurrent weights R (num_direction, num_gate * hidden_size, hidden_size) are packed into panels of 8 hidden units,
+// in which the weights of all gates of a unit are adjacent, so that every recurrent step of a panel
+// is a single pass over the previous hidden state with all gates in registers.
+uint64_t rnn_fp32_fma_get_packed_recurrent_weight_bytes(
+    const rnn_direction_t direction,
+    const int64_t num_gate,
+    const int64_t hidden_size);
+
+ppl::common::RetCode rnn_fp32_fma_pack_recurrent_weight(
+    const float *R_weight,
+    const rnn_direction_t direction,
+    const int64_t num_gate,
+    const int64_t hidden_size,
+    float *packed_R_weight);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_CONV2D_H_
+#define __ST_PPL_KERNEL_X86_INT8_CONV2D_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/conv_common.h"
+#include "ppl/kernel/x86/int8/gemm_s8u8.h"
+#include "ppl/common/allocator.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// symmetric int8 conv2d on fp32 ndarray tensors. input is quantized with a
+// per-tensor scale while unfolding, filter is quantized per output channel
+// once, and the int32 result is dequantized before being stored.
+struct conv2d_int8_param {
+    int64_t kernel_h;
+    int64_t kernel_w;
+    int64_t stride_h;
+    int64_t stride_w;
+    int64_t dilation_h;
+    int64_t dilation_w;
+    int64_t pad_h;
+    int64_t pad_w;
+    int64_t channels;
+    int64_t num_output;
+    int64_t group;
+    float src_scale; // x_q = clamp(round(x / src_scale), -127, 127)
+    conv_fuse_flag_t fuse_flag; // RELU and RELU6 only
+};
+
+class conv2d_int8_manager {
+public:
+    conv2d_int8_manager(const conv2d_int8_param &param, const gemm_s8u8_isa_t isa, ppl::common::Allocator *allocator)
+        : param_(param), isa_(isa), allocator_(allocator) {}
+    ~conv2d_int8_manager()
+    {
+        release_cvt_weights();
+    }
+
+    void set_param(const conv2d_int8_param &param)
+    {
+        param_ = param;
+    }
+    const conv2d_int8_param &param() const
+    {
+        return param_;
+    }
+    gemm_s8u8_isa_t isa() const
+    {
+        return isa_;
+    }
+
+    // bias may be nullptr
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias);
+    void release_cvt_weights();
+
+    uint64_t cal_temp_buffer_size(const ppl::nn::TensorShape &src_shape, const ppl::nn::TensorShape &dst_shape) const;
+    ppl::common::RetCode execute(
+        const ppl::nn::TensorShape &src_shape,
+        const float *src,
+        const ppl::nn::TensorShape &dst_shape,
+        float *dst,
+        void *temp_buffer) const;
+
+private:
+    conv2d_int8_param param_;
+    gemm_s8u8_isa_t isa_;
+    ppl::common::Allocator *allocator_;
+
+    void *cvt_buffer_       = nullptr;
+    int8_t *cvt_filter_     = nullptr; // [num_output][lda]
+    int32_t *filter_rowsum_ = nullptr;
+    float *filter_scale_    = nullptr;
+    float *cvt_bias_        = nullptr;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_FC_H_
+#define __ST_PPL_KERNEL_X86_INT8_FC_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+#include "ppl/kernel/x86/common/fc_common.h"
+#include "ppl/kernel/x86/int8/gemm_s8u8.h"
+#include "ppl/common/allocator.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// symmetric int8 fc on fp32 tensors, y = x * w^T + b with w in [num_output][channels].
+struct fc_int8_param {
+    int64_t channels;
+    int64_t num_output;
+    float src_scale; // x_q = clamp(round(x / src_scale), -127, 127)
+    fc_fuse_flag_t fuse_flag;
+};
+
+class fc_int8_manager {
+public:
+    fc_int8_manager(const fc_int8_param &param, const gemm_s8u8_isa_t isa, ppl::common::Allocator *allocator)
+        : param_(param), isa_(isa), allocator_(allocator) {}
+    ~fc_int8_manager()
+    {
+        release_cvt_weights();
+    }
+
+    void set_param(const fc_int8_param &param)
+    {
+        param_ = param;
+    }
+    const fc_int8_param &param() const
+    {
+        return param_;
+    }
+    gemm_s8u8_isa_t isa() const
+    {
+        return isa_;
+    }
+
+    // bias may be nullptr
+    ppl::common::RetCode gen_cvt_weights(const float *filter, const float *bias);
+    void release_cvt_weights();
+
+    uint64_t cal_temp_buffer_size(const ppl::nn::TensorShape &src_shape) const;
+    ppl::common::RetCode execute(
+        const ppl::nn::TensorShape &src_shape,
+        const float *src,
+        float *dst,
+        void *temp_buffer) const;
+
+private:
+    fc_int8_param param_;
+    gemm_s8u8_isa_t isa_;
+    ppl::common::Allocator *allocator_;
+
+    void *cvt_buffer_     = nullptr;
+    uint8_t *cvt_filter_  = nullptr; // [K4][ldb][4], shifted by +128
+    float *filter_scale_  = nullptr;
+    float *cvt_bias_      = nullptr;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_GEMM_S8U8_H_
+#define __ST_PPL_KERNEL_X86_INT8_GEMM_S8U8_H_
+
+#include "ppl/kernel/x86/common/general_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+typedef uint32_t gemm_s8u8_isa_t;
+
+class gemm_s8u8_isa {
+public:
+    static const gemm_s8u8_isa_t REF        = 0;
+    static const gemm_s8u8_isa_t AVX2       = 1; // vpmaddwd on zero-extended u8
+    static const gemm_s8u8_isa_t AVX512VNNI = 2; // vpdpbusd
+};
+
+typedef uint32_t gemm_s8u8_post_t;
+
+class gemm_s8u8_post {
+public:
+    enum {
+        NONE  = 0,
+        RELU  = 1 << 0,
+        RELU6 = 1 << 1,
+    };
+};
+
+// dequantize and activation applied on int32 result of each C[m][n]
+struct gemm_s8u8_post_param {
+    const float *m_scale; // per row scale, nullptr means 1.0f
+    const float *n_scale; // per column scale, nullptr means 1.0f
+    const float *m_bias;  // per row bias, nullptr means 0.0f
+    const float *n_bias;  // per column bias, nullptr means 0.0f
+    float alpha;
+    gemm_s8u8_post_t post;
+};
+
+// B is packed as [K4][ldb][4] u8, 4 consecutive k of one column in 4 bytes.
+inline int64_t gemm_s8u8_k4(const int64_t K)
+{
+    return (K + 3) / 4;
+}
+
+inline int64_t gemm_s8u8_ldb(const int64_t N)
+{
+    return (N + 31) / 32 * 32;
+}
+
+// best available int8 gemm path on this cpu under the given isa flags
+gemm_s8u8_isa_t gemm_s8u8_select_isa(const ppl::common::isa_t isa_flags);
+
+/*
+    C[m][n] = post(alpha * m_scale[m] * n_scale[n] * sum_k(A[m][k] * (B[k][n] - 128)) + m_bias[m] + n_bias[n])
+
+    A:        s8 [M][lda], k tail up to K4 * 4 must be zero
+    rowsum_a: sum_k(A[m][k]) of each row, used to remove the +128 shift of B
+    B:        u8 packed as [K4][ldb][4], ldb >= gemm_s8u8_ldb(N)
+    C:        fp32 [M][ldc]
+*/
+ppl::common::RetCode gemm_s8u8(
+    const gemm_s8u8_isa_t isa,
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
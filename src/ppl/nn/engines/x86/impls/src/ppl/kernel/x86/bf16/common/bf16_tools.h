@@ -0,0 +1,118 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_BF16_COMMON_BF16_TOOLS_H_
+#define __ST_PPL_KERNEL_X86_BF16_COMMON_BF16_TOOLS_H_
+
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/bf16/gemm_bf16.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// round to nearest even, nan stays nan
+inline bfloat16_t cvt_fp32_to_bf16(const float x)
+{
+    uint32_t u;
+    memcpy(&u, &x, sizeof(u));
+    if ((u & 0x7fffffffu) > 0x7f800000u) {
+        return (bfloat16_t)((u >> 16) | 0x40);
+    }
+    u += 0x7fffu + ((u >> 16) & 1);
+    return (bfloat16_t)(u >> 16);
+}
+
+inline float cvt_bf16_to_fp32(const bfloat16_t x)
+{
+    const uint32_t u = (uint32_t)x << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+inline float gemm_bf16_post_scalar(const float acc, const int64_t m, const int64_t n, const gemm_bf16_post_param &p)
+{
+    float v = acc;
+    if (p.m_bias) v += p.m_bias[m];
+    if (p.n_bias) v += p.n_bias[n];
+    if (p.post & (gemm_bf16_post::RELU | gemm_bf16_post::RELU6)) v = v > 0.0f ? v : 0.0f;
+    if (p.post & gemm_bf16_post::RELU6) v = v < 6.0f ? v : 6.0f;
+    return v;
+}
+
+inline gemm_bf16_post_t gemm_bf16_post_flag(const bool relu, const bool relu6)
+{
+    if (relu6) return gemm_bf16_post::RELU6;
+    if (relu) return gemm_bf16_post::RELU;
+    return gemm_bf16_post::NONE;
+}
+
+// one M x N block, B points to the first column of the block, post pointers already offset.
+typedef void (*gemm_bf16_kernel_func_t)(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+void gemm_bf16_kernel_bf16_ref(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+#ifdef PPL_USE_X86_BF16
+void gemm_bf16_kernel_bf16_avx512(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+void gemm_bf16_kernel_bf16_amx(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+#endif
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,121 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/fc.h"
+#include "ppl/kernel/x86/bf16/common/bf16_tools.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline int64_t fc_bf16_src_m(const ppl::nn::TensorShape &src_shape)
+{
+    int64_t M = 1;
+    for (uint32_t i = 0; i + 1 < src_shape.GetDimCount(); ++i) {
+        M *= src_shape.GetDim(i);
+    }
+    return M;
+}
+
+ppl::common::RetCode fc_bf16_manager::gen_cvt_weights(const float *filter, const bool filter_trans, const float *bias)
+{
+    if (cvt_buffer_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t N   = param_.num_output;
+    const int64_t K   = param_.channels;
+    const int64_t K2  = gemm_bf16_k2(K);
+    const int64_t ldb = gemm_bf16_ldb(N);
+
+    const uint64_t filter_bytes = round_up(K2 * ldb * 2 * (int64_t)sizeof(bfloat16_t), PPL_X86_CACHELINE_BYTES());
+    const uint64_t bias_bytes   = round_up(ldb * (int64_t)sizeof(float), PPL_X86_CACHELINE_BYTES());
+    cvt_buffer_                 = allocator_->Alloc(filter_bytes + bias_bytes);
+    if (cvt_buffer_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    cvt_filter_ = (bfloat16_t *)cvt_buffer_;
+    cvt_bias_   = (float *)((uint8_t *)cvt_buffer_ + filter_bytes);
+
+    memset(cvt_filter_, 0, K2 * ldb * 2 * sizeof(bfloat16_t));
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t n = 0; n < N; ++n) {
+        for (int64_t k = 0; k < K; ++k) {
+            const float w = filter_trans ? filter[n * K + k] : filter[k * N + n];
+            cvt_filter_[((k / 2) * ldb + n) * 2 + k % 2] = cvt_fp32_to_bf16(w);
+        }
+        cvt_bias_[n] = bias ? bias[n] : 0.0f;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+void fc_bf16_manager::release_cvt_weights()
+{
+    if (cvt_buffer_) {
+        allocator_->Free(cvt_buffer_);
+        cvt_buffer_ = nullptr;
+        cvt_filter_ = nullptr;
+        cvt_bias_   = nullptr;
+    }
+}
+
+uint64_t fc_bf16_manager::cal_temp_buffer_size(const ppl::nn::TensorShape &src_shape) const
+{
+    const int64_t M_pad = gemm_bf16_m_pad(fc_bf16_src_m(src_shape));
+    const int64_t lda   = gemm_bf16_lda(param_.channels);
+    return M_pad * lda * sizeof(bfloat16_t) + PPL_X86_CACHELINE_BYTES();
+}
+
+ppl::common::RetCode fc_bf16_manager::execute(
+    const ppl::nn::TensorShape &src_shape,
+    const float *src,
+    float *dst,
+    void *temp_buffer) const
+{
+    if (cvt_buffer_ == nullptr || src == nullptr || dst == nullptr || temp_buffer == nullptr) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const int64_t M     = fc_bf16_src_m(src_shape);
+    const int64_t M_pad = gemm_bf16_m_pad(M);
+    const int64_t N     = param_.num_output;
+    const int64_t K     = param_.channels;
+    const int64_t lda   = gemm_bf16_lda(K);
+
+    bfloat16_t *A = (bfloat16_t *)round_up((uintptr_t)temp_buffer, PPL_X86_CACHELINE_BYTES());
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t m = 0; m < M_pad; ++m) {
+        bfloat16_t *a = A + m * lda;
+        if (m >= M) {
+            memset(a, 0, lda * sizeof(bfloat16_t));
+            continue;
+        }
+        cvt_fp32_to_bf16(src + m * K, K, a);
+        memset(a + K, 0, (lda - K) * sizeof(bfloat16_t));
+    }
+
+    gemm_bf16_post_param post;
+    post.m_bias = nullptr;
+    post.n_bias = cvt_bias_;
+    post.post   = gemm_bf16_post_flag((param_.fuse_flag & fc_fuse_flag::RELU) != 0, false);
+
+    return gemm_bf16(isa_, A, lda, cvt_filter_, gemm_bf16_ldb(N), M, N, gemm_bf16_k2(K), post, dst, N);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,142 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/common/bf16_tools.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct gemm_bf16_amx_tile_config {
+    uint8_t palette_id;
+    uint8_t start_row;
+    uint8_t reserved[14];
+    uint16_t colsb[16];
+    uint8_t rows[16];
+};
+
+// tmm0-3: 32x32 fp32 block of C as 2x2 tiles
+// tmm4-5: 2 x 16 rows of A, 32 k each
+// tmm6-7: 2 x 16 columns of B, 32 k each, already in vnni pair layout
+static inline void gemm_bf16_amx_load_config()
+{
+    gemm_bf16_amx_tile_config cfg;
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.palette_id = 1;
+    for (int32_t t = 0; t < 8; ++t) {
+        cfg.rows[t]  = 16;
+        cfg.colsb[t] = 64;
+    }
+    _tile_loadconfig(&cfg);
+}
+
+static inline void gemm_bf16_amx_store_c(
+    const float *cbuf,
+    const int64_t m_eff,
+    const int64_t n_eff,
+    const gemm_bf16_post_param &p,
+    const int64_t m0,
+    const int64_t n0,
+    float *C,
+    const int64_t ldc)
+{
+    const __mmask16 mask0 = n_eff >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << n_eff) - 1);
+    const __mmask16 mask1 = n_eff >= 32 ? (__mmask16)0xffff : (n_eff > 16 ? (__mmask16)((1u << (n_eff - 16)) - 1) : (__mmask16)0);
+
+    __m512 n_bias0 = _mm512_setzero_ps();
+    __m512 n_bias1 = _mm512_setzero_ps();
+    if (p.n_bias) {
+        n_bias0 = _mm512_maskz_loadu_ps(mask0, p.n_bias + n0);
+        n_bias1 = _mm512_maskz_loadu_ps(mask1, p.n_bias + n0 + 16);
+    }
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 six  = _mm512_set1_ps(6.0f);
+
+    for (int64_t m = 0; m < m_eff; ++m) {
+        __m512 v0 = _mm512_add_ps(_mm512_loadu_ps(cbuf + m * 32), n_bias0);
+        __m512 v1 = _mm512_add_ps(_mm512_loadu_ps(cbuf + m * 32 + 16), n_bias1);
+        if (p.m_bias) {
+            const __m512 m_bias = _mm512_set1_ps(p.m_bias[m0 + m]);
+            v0                  = _mm512_add_ps(v0, m_bias);
+            v1                  = _mm512_add_ps(v1, m_bias);
+        }
+        if (p.post & (gemm_bf16_post::RELU | gemm_bf16_post::RELU6)) {
+            v0 = _mm512_max_ps(v0, zero);
+            v1 = _mm512_max_ps(v1, zero);
+        }
+        if (p.post & gemm_bf16_post::RELU6) {
+            v0 = _mm512_min_ps(v0, six);
+            v1 = _mm512_min_ps(v1, six);
+        }
+        _mm512_mask_storeu_ps(C + (m0 + m) * ldc + n0, mask0, v0);
+        _mm512_mask_storeu_ps(C + (m0 + m) * ldc + n0 + 16, mask1, v1);
+    }
+}
+
+// M <= 32 guaranteed by driver, A must have 32 readable rows.
+void gemm_bf16_kernel_bf16_amx(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    gemm_bf16_amx_load_config();
+
+    float cbuf[32 * 32];
+    const int64_t a_stride = lda * sizeof(bfloat16_t);
+    const int64_t b_stride = ldb * 2 * sizeof(bfloat16_t);
+    const int64_t k2_tile  = 16;
+    const bool two_m_tile  = M > 16;
+
+    for (int64_t n = 0; n < N; n += 32) {
+        const int64_t n_eff = min<int64_t>(N - n, 32);
+        _tile_zero(0);
+        _tile_zero(1);
+        _tile_zero(2);
+        _tile_zero(3);
+        for (int64_t k2 = 0; k2 < K2; k2 += k2_tile) {
+            _tile_loadd(6, B + (k2 * ldb + n) * 2, b_stride);
+            _tile_loadd(7, B + (k2 * ldb + n + 16) * 2, b_stride);
+            _tile_loadd(4, A + k2 * 2, a_stride);
+            _tile_dpbf16ps(0, 4, 6);
+            _tile_dpbf16ps(1, 4, 7);
+            if (two_m_tile) {
+                _tile_loadd(5, A + 16 * lda + k2 * 2, a_stride);
+                _tile_dpbf16ps(2, 5, 6);
+                _tile_dpbf16ps(3, 5, 7);
+            }
+        }
+        _tile_stored(0, cbuf, 32 * sizeof(float));
+        _tile_stored(1, cbuf + 16, 32 * sizeof(float));
+        if (two_m_tile) {
+            _tile_stored(2, cbuf + 16 * 32, 32 * sizeof(float));
+            _tile_stored(3, cbuf + 16 * 32 + 16, 32 * sizeof(float));
+        }
+        gemm_bf16_amx_store_c(cbuf, M, n_eff, post_param, 0, n, C, ldc);
+    }
+
+    _tile_release();
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/common/bf16_tools.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// lanes run along n, 16 columns x 2 k per zmm of B, accumulated by vdpbf16ps.
+template <int32_t MT>
+static inline void gemm_bf16_avx512_mtx32(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t n_eff,
+    const int64_t K2,
+    const gemm_bf16_post_param &p,
+    const int64_t m0,
+    const int64_t n0,
+    float *C,
+    const int64_t ldc)
+{
+    __m512 acc0[MT], acc1[MT];
+    for (int32_t m = 0; m < MT; ++m) {
+        acc0[m] = _mm512_setzero_ps();
+        acc1[m] = _mm512_setzero_ps();
+    }
+
+    const int64_t b_step = ldb * 2;
+    for (int64_t k2 = 0; k2 < K2; ++k2) {
+        const __m512bh b0 = (__m512bh)_mm512_loadu_si512((const void *)(B + k2 * b_step));
+        const __m512bh b1 = (__m512bh)_mm512_loadu_si512((const void *)(B + k2 * b_step + 32));
+        for (int32_t m = 0; m < MT; ++m) {
+            int32_t a2;
+            memcpy(&a2, A + m * lda + k2 * 2, sizeof(a2));
+            const __m512bh a = (__m512bh)_mm512_set1_epi32(a2);
+            acc0[m]          = _mm512_dpbf16_ps(acc0[m], a, b0);
+            acc1[m]          = _mm512_dpbf16_ps(acc1[m], a, b1);
+        }
+    }
+
+    const __mmask16 mask0 = n_eff >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << n_eff) - 1);
+    const __mmask16 mask1 = n_eff >= 32 ? (__mmask16)0xffff : (n_eff > 16 ? (__mmask16)((1u << (n_eff - 16)) - 1) : (__mmask16)0);
+
+    __m512 n_bias0 = _mm512_setzero_ps();
+    __m512 n_bias1 = _mm512_setzero_ps();
+    if (p.n_bias) {
+        n_bias0 = _mm512_maskz_loadu_ps(mask0, p.n_bias + n0);
+        n_bias1 = _mm512_maskz_loadu_ps(mask1, p.n_bias + n0 + 16);
+    }
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 six  = _mm512_set1_ps(6.0f);
+
+    for (int32_t m = 0; m < MT; ++m) {
+        __m512 v0 = _mm512_add_ps(acc0[m], n_bias0);
+        __m512 v1 = _mm512_add_ps(acc1[m], n_bias1);
+        if (p.m_bias) {
+            const __m512 m_bias = _mm512_set1_ps(p.m_bias[m0 + m]);
+            v0                  = _mm512_add_ps(v0, m_bias);
+            v1                  = _mm512_add_ps(v1, m_bias);
+        }
+        if (p.post & (gemm_bf16_post::RELU | gemm_bf16_post::RELU6)) {
+            v0 = _mm512_max_ps(v0, zero);
+            v1 = _mm512_max_ps(v1, zero);
+        }
+        if (p.post & gemm_bf16_post::RELU6) {
+            v0 = _mm512_min_ps(v0, six);
+            v1 = _mm512_min_ps(v1, six);
+        }
+
+        if (n_eff == 32) {
+            _mm512_storeu_ps(C + m * ldc, v0);
+            _mm512_storeu_ps(C + m * ldc + 16, v1);
+        } else {
+            _mm512_mask_storeu_ps(C + m * ldc, mask0, v0);
+            _mm512_mask_storeu_ps(C + m * ldc + 16, mask1, v1);
+        }
+    }
+}
+
+void gemm_bf16_kernel_bf16_avx512(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    const int64_t m_tile = 4;
+    const int64_t n_tile = 32;
+    for (int64_t n = 0; n < N; n += n_tile) {
+        const int64_t n_eff  = min<int64_t>(N - n, n_tile);
+        const bfloat16_t *b = B + n * 2;
+        int64_t m            = 0;
+        for (; m + m_tile <= M; m += m_tile) {
+            gemm_bf16_avx512_mtx32<4>(A + m * lda, lda, b, ldb, n_eff, K2, post_param, m, n, C + m * ldc + n, ldc);
+        }
+        for (; m < M; ++m) {
+            gemm_bf16_avx512_mtx32<1>(A + m * lda, lda, b, ldb, n_eff, K2, post_param, m, n, C + m * ldc + n, ldc);
+        }
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
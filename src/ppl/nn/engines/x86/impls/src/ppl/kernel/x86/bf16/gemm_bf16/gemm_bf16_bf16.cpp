@@ -0,0 +1,124 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/bf16/common/bf16_tools.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+gemm_bf16_isa_t gemm_bf16_select_isa(const ppl::common::isa_t isa_flags)
+{
+#ifdef PPL_USE_X86_BF16
+    if (isa_flags & ppl::common::ISA_X86_AVX512) {
+        if (cpu_enable_amx_bf16()) {
+            return gemm_bf16_isa::AMX;
+        }
+        if (cpu_supports_avx512bf16()) {
+            return gemm_bf16_isa::AVX512BF16;
+        }
+    }
+#endif
+    return gemm_bf16_isa::REF;
+}
+
+void cvt_fp32_to_bf16(const float *src, const int64_t len, bfloat16_t *dst)
+{
+    for (int64_t i = 0; i < len; ++i) {
+        dst[i] = cvt_fp32_to_bf16(src[i]);
+    }
+}
+
+void gemm_bf16_kernel_bf16_ref(
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    for (int64_t m = 0; m < M; ++m) {
+        const bfloat16_t *a = A + m * lda;
+        for (int64_t n = 0; n < N; ++n) {
+            float acc = 0.0f;
+            for (int64_t k2 = 0; k2 < K2; ++k2) {
+                const bfloat16_t *b = B + (k2 * ldb + n) * 2;
+                acc += cvt_bf16_to_fp32(a[k2 * 2 + 0]) * cvt_bf16_to_fp32(b[0]);
+                acc += cvt_bf16_to_fp32(a[k2 * 2 + 1]) * cvt_bf16_to_fp32(b[1]);
+            }
+            C[m * ldc + n] = gemm_bf16_post_scalar(acc, m, n, post_param);
+        }
+    }
+}
+
+ppl::common::RetCode gemm_bf16(
+    const gemm_bf16_isa_t isa,
+    const bfloat16_t *A,
+    const int64_t lda,
+    const bfloat16_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K2,
+    const gemm_bf16_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    if ((lda & 31) || (K2 & 15) || lda < K2 * 2 || ldb < N || (ldb & 31)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    gemm_bf16_kernel_func_t kernel = gemm_bf16_kernel_bf16_ref;
+#ifdef PPL_USE_X86_BF16
+    if (isa == gemm_bf16_isa::AVX512BF16) {
+        kernel = gemm_bf16_kernel_bf16_avx512;
+    }
+    if (isa == gemm_bf16_isa::AMX) {
+        kernel = gemm_bf16_kernel_bf16_amx;
+    }
+#endif
+
+    const int64_t m_blk = 32;
+    const int64_t num_threads = PPL_OMP_MAX_THREADS();
+    const int64_t m_tasks = div_up(M, m_blk);
+    int64_t n_blk = 256;
+    while (n_blk > 32 && m_tasks * div_up(N, n_blk) < num_threads * 4) {
+        n_blk /= 2;
+    }
+    const int64_t n_tasks = div_up(N, n_blk);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < m_tasks * n_tasks; ++t) {
+        const int64_t m0 = (t / n_tasks) * m_blk;
+        const int64_t n0 = (t % n_tasks) * n_blk;
+        const int64_t m_eff = min<int64_t>(M - m0, m_blk);
+        const int64_t n_eff = min<int64_t>(N - n0, n_blk);
+
+        gemm_bf16_post_param p = post_param;
+        p.m_bias = p.m_bias ? p.m_bias + m0 : nullptr;
+        p.n_bias = p.n_bias ? p.n_bias + n0 : nullptr;
+
+        kernel(A + m0 * lda, lda, B + n0 * 2, ldb, m_eff, n_eff, K2, p, C + m0 * ldc + n0, ldc);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,143 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <string.h>
+
+#include "ppl/kernel/x86/bf16/gemm_v2.h"
+#include "ppl/kernel/x86/bf16/common/bf16_tools.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline uint64_t gemm_v2_bf16_a_bytes(const gemm_v2_param_fp32 &param)
+{
+    return round_up(gemm_bf16_m_pad(param.M) * gemm_bf16_lda(param.K) * (int64_t)sizeof(bfloat16_t), PPL_X86_CACHELINE_BYTES());
+}
+
+static inline uint64_t gemm_v2_bf16_b_bytes(const gemm_v2_param_fp32 &param)
+{
+    return round_up(gemm_bf16_k2(param.K) * gemm_bf16_ldb(param.N) * 2 * (int64_t)sizeof(bfloat16_t), PPL_X86_CACHELINE_BYTES());
+}
+
+uint64_t gemm_v2_bf16_get_buffer_bytes(const gemm_v2_param_fp32 &param)
+{
+    return gemm_v2_bf16_a_bytes(param) + gemm_v2_bf16_b_bytes(param) + PPL_X86_CACHELINE_BYTES();
+}
+
+ppl::common::RetCode gemm_v2_bf16(const gemm_bf16_isa_t isa, const gemm_v2_param_fp32 &param, void *temp_buffer)
+{
+    if (param.src_A == nullptr || param.src_B == nullptr || param.dst_Y == nullptr || temp_buffer == nullptr) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+    if (param.c_type != gemm_v2_C_type::EMPTY && param.src_C == nullptr) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const int64_t M     = param.M;
+    const int64_t N     = param.N;
+    const int64_t K     = param.K;
+    const int64_t M_pad = gemm_bf16_m_pad(M);
+    const int64_t lda   = gemm_bf16_lda(K);
+    const int64_t K2    = gemm_bf16_k2(K);
+    const int64_t ldb   = gemm_bf16_ldb(N);
+
+    bfloat16_t *A = (bfloat16_t *)round_up((uintptr_t)temp_buffer, PPL_X86_CACHELINE_BYTES());
+    bfloat16_t *B = (bfloat16_t *)((uint8_t *)A + gemm_v2_bf16_a_bytes(param));
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t m = 0; m < M_pad; ++m) {
+        bfloat16_t *a = A + m * lda;
+        if (m >= M) {
+            memset(a, 0, lda * sizeof(bfloat16_t));
+            continue;
+        }
+        if (param.trans_A) {
+            for (int64_t k = 0; k < K; ++k) {
+                a[k] = cvt_fp32_to_bf16(param.src_A[k * param.lda + m]);
+            }
+        } else {
+            cvt_fp32_to_bf16(param.src_A + m * param.lda, K, a);
+        }
+        memset(a + K, 0, (lda - K) * sizeof(bfloat16_t));
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t k2 = 0; k2 < K2; ++k2) {
+        bfloat16_t *b = B + k2 * ldb * 2;
+        memset(b, 0, ldb * 2 * sizeof(bfloat16_t));
+        for (int64_t j = 0; j < 2; ++j) {
+            const int64_t k = k2 * 2 + j;
+            if (k >= K) {
+                break;
+            }
+            if (param.trans_B) {
+                for (int64_t n = 0; n < N; ++n) {
+                    b[n * 2 + j] = cvt_fp32_to_bf16(param.src_B[n * param.ldb + k]);
+                }
+            } else {
+                const float *src_b = param.src_B + k * param.ldb;
+                for (int64_t n = 0; n < N; ++n) {
+                    b[n * 2 + j] = cvt_fp32_to_bf16(src_b[n]);
+                }
+            }
+        }
+    }
+
+    const bool fuse_relu = (param.fuse_flag & gemm_v2_fuse_flag::RELU) != 0;
+    const bool need_epilogue = param.alpha != 1.0f || param.c_type != gemm_v2_C_type::EMPTY;
+
+    gemm_bf16_post_param post;
+    post.m_bias = nullptr;
+    post.n_bias = nullptr;
+    post.post   = gemm_bf16_post_flag(fuse_relu && !need_epilogue, false);
+
+    auto status = gemm_bf16(isa, A, lda, B, ldb, M, N, K2, post, param.dst_Y, param.ldy);
+    if (status != ppl::common::RC_SUCCESS || !need_epilogue) {
+        return status;
+    }
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t m = 0; m < M; ++m) {
+        float *y = param.dst_Y + m * param.ldy;
+        for (int64_t n = 0; n < N; ++n) {
+            float c = 0.0f;
+            switch (param.c_type) {
+                case gemm_v2_C_type::SCALAR:
+                    c = param.src_C[0];
+                    break;
+                case gemm_v2_C_type::VECTOR_H:
+                    c = param.src_C[m];
+                    break;
+                case gemm_v2_C_type::VECTOR_W:
+                    c = param.src_C[n];
+                    break;
+                case gemm_v2_C_type::MATRIX:
+                    c = param.src_C[m * param.ldc + n];
+                    break;
+                default:
+                    break;
+            }
+            float v = param.alpha * y[n] + param.beta * c;
+            if (fuse_relu) {
+                v = v > 0.0f ? v : 0.0f;
+            }
+            y[n] = v;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
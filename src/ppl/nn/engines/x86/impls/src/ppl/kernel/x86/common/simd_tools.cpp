@@ -16,6 +16,15 @@
 // under the License.
 
 #include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 
 #include "ppl/kernel/x86/common/internal_include.h"
 #include "ppl/common/sys.h"
@@ -37,4 +46,84 @@ void set_denormals_zero(const int32_t on) {
     }
 }
 
+static void cpuid_count(const uint32_t leaf, const uint32_t subleaf, uint32_t regs[4]) {
+#ifdef _MSC_VER
+    int32_t r[4];
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __cpuid(r, 0);
+    if (leaf > (uint32_t)r[0]) {
+        return;
+    }
+    __cpuidex(r, (int32_t)leaf, (int32_t)subleaf);
+    for (int32_t i = 0; i < 4; ++i) {
+        regs[i] = (uint32_t)r[i];
+    }
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    if (leaf <= __get_cpuid_max(0, nullptr)) {
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    }
+#endif
+}
+
+bool cpu_supports_avx2() {
+    uint32_t regs[4];
+    cpuid_count(7, 0, regs);
+    return (regs[1] & (1u << 5)) != 0; // ebx bit 5
+}
+
+bool cpu_supports_avx512vnni() {
+    uint32_t regs[4];
+    cpuid_count(7, 0, regs);
+    return (regs[2] & (1u << 11)) != 0; // ecx bit 11
+}
+
+bool cpu_supports_avx512bf16() {
+    uint32_t regs[4];
+    cpuid_count(7, 1, regs);
+    return (regs[0] & (1u << 5)) != 0; // eax bit 5
+}
+
+static uint64_t read_xcr0() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+bool cpu_enable_amx_bf16() {
+    static int32_t enabled = -1;
+    if (enabled >= 0) {
+        return enabled == 1;
+    }
+    enabled = 0;
+
+    uint32_t regs[4];
+    cpuid_count(1, 0, regs);
+    if (!(regs[2] & (1u << 27))) { // osxsave
+        return false;
+    }
+    cpuid_count(7, 0, regs);
+    if (!(regs[3] & (1u << 22)) || !(regs[3] & (1u << 24))) { // amx-bf16, amx-tile
+        return false;
+    }
+    const uint64_t xtile_mask = (1ull << 17) | (1ull << 18); // xtilecfg, xtiledata
+    if ((read_xcr0() & xtile_mask) != xtile_mask) {
+        return false;
+    }
+#ifdef __linux__
+    // tile data is disabled for each process until it is requested
+    const long arch_req_xcomp_perm = 0x1023;
+    const long xfeature_xtiledata  = 18;
+    if (syscall(SYS_arch_prctl, arch_req_xcomp_perm, xfeature_xtiledata) != 0) {
+        return false;
+    }
+#endif
+    enabled = 1;
+    return true;
+}
+
 }}};
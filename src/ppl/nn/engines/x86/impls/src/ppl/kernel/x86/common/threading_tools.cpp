@@ -31,7 +31,7 @@ namespace ppl { namespace kernel { namespace x86 {
 
 void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const int32_t mode) {
     int32_t bmode = mode;
-    if (num_cores < PPL_OMP_MAX_THREADS() || mode > 1 || mode < 0) {
+    if ((num_cores < PPL_OMP_MAX_THREADS() && mode != 2) || mode > 2 || mode < 0) {
         bmode = 1;
     }
 #if defined(__linux__)
@@ -44,6 +44,10 @@ void set_omp_core_binding(const int32_t *cores, const int32_t num_cores, const i
             CPU_SET(cores[omp_tid], &cpuset);
         } else if (bmode == 1) {
             CPU_SET(omp_tid, &cpuset);
+        } else if (bmode == 2) {
+            for (int32_t i = 0; i < num_cores; ++i) {
+                CPU_SET(cores[i], &cpuset);
+            }
         }
         if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
             LOG(ERROR) << "Core binding failed";
@@ -56,6 +60,15 @@ int32_t get_omp_max_threads()
 {
     return PPL_OMP_MAX_THREADS();
 }
+
+void set_omp_num_threads(const int32_t num_threads)
+{
+#ifdef PPL_USE_X86_OMP
+    if (num_threads > 0) {
+        omp_set_num_threads(num_threads);
+    }
+#endif
+}
 // A very naive version
 single_parallel_loop_config_t select_single_parallel_loop(
     const std::vector<int64_t> &iter_of_loop,
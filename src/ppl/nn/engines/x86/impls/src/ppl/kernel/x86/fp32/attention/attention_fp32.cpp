@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <float.h>
+
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/attention/attention_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode scaled_dot_product_attention_fp32(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *q,
+    const float *kt,
+    const float *v,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst)
+{
+    sdp_attention_fp32_dims dims;
+    auto rc = sdp_attention_fp32_init_dims(q_shape, kt_shape, v_shape, mask ? mask_shape : nullptr, &dims);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    const int64_t q_len      = dims.q_len;
+    const int64_t kv_len     = dims.kv_len;
+    const int64_t head_dim   = dims.head_dim;
+    const int64_t v_head_dim = dims.v_head_dim;
+
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
+    for (int64_t b = 0; b < dims.batch; ++b) {
+        for (int64_t i = 0; i < q_len; ++i) {
+            const float *l_q  = q + dims.batch_offset(b, dims.q_batch_strides) + i * head_dim;
+            const float *l_kt = kt + dims.batch_offset(b, dims.kt_batch_strides);
+            const float *l_v  = v + dims.batch_offset(b, dims.v_batch_strides);
+            float *l_dst      = dst + (b * q_len + i) * v_head_dim;
+            float *score      = (float *)temp_buffer + PPL_OMP_THREAD_ID() * ATTN_Q_BLK() * kv_len;
+
+            float max_val = -FLT_MAX;
+            for (int64_t j = 0; j < kv_len; ++j) {
+                float s = 0.0f;
+                for (int64_t d = 0; d < head_dim; ++d) {
+                    s += l_q[d] * l_kt[d * kv_len + j];
+                }
+                s *= scale;
+                if (mask) {
+                    s += mask[dims.batch_offset(b, dims.mask_batch_strides) + i * dims.mask_q_stride + j * dims.mask_kv_stride];
+                }
+                score[j] = s;
+                max_val  = max(max_val, s);
+            }
+
+            float exp_sum = 0.0f;
+            for (int64_t j = 0; j < kv_len; ++j) {
+                score[j] = expf(score[j] - max_val);
+                exp_sum += score[j];
+            }
+            const float r_exp_sum = 1.0f / exp_sum;
+
+            for (int64_t c = 0; c < v_head_dim; ++c) {
+                float y = 0.0f;
+                for (int64_t j = 0; j < kv_len; ++j) {
+                    y += score[j] * l_v[j * v_head_dim + c];
+                }
+                l_dst[c] = y * r_exp_sum;
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
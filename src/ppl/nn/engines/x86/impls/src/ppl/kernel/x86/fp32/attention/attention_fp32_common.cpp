@@ -0,0 +1,112 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/attention/attention_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode sdp_attention_fp32_init_dims(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    sdp_attention_fp32_dims *dims)
+{
+    const int64_t dim_count = q_shape->GetDimCount();
+    if (dim_count < 2 || kt_shape->GetDimCount() != dim_count || v_shape->GetDimCount() != dim_count) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    dims->q_len      = q_shape->GetDim(dim_count - 2);
+    dims->head_dim   = q_shape->GetDim(dim_count - 1);
+    dims->kv_len     = kt_shape->GetDim(dim_count - 1);
+    dims->v_head_dim = v_shape->GetDim(dim_count - 1);
+    if (kt_shape->GetDim(dim_count - 2) != dims->head_dim || v_shape->GetDim(dim_count - 2) != dims->kv_len) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    // batch dims broadcast like MatMul, e.g. k and v shared by all heads
+    dims->batch = 1;
+    dims->batch_dims.resize(dim_count - 2);
+    for (int64_t i = 0; i < dim_count - 2; ++i) {
+        const int64_t qd = q_shape->GetDim(i);
+        const int64_t kd = kt_shape->GetDim(i);
+        const int64_t vd = v_shape->GetDim(i);
+        const int64_t d  = max(qd, max(kd, vd));
+        if ((qd != d && qd != 1) || (kd != d && kd != 1) || (vd != d && vd != 1)) {
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        dims->batch_dims[i] = d;
+        dims->batch *= d;
+    }
+
+    dims->q_batch_strides.resize(dim_count - 2);
+    dims->kt_batch_strides.resize(dim_count - 2);
+    dims->v_batch_strides.resize(dim_count - 2);
+    int64_t q_stride  = dims->q_len * dims->head_dim;
+    int64_t kt_stride = dims->head_dim * dims->kv_len;
+    int64_t v_stride  = dims->kv_len * dims->v_head_dim;
+    for (int64_t i = dim_count - 3; i >= 0; --i) {
+        dims->q_batch_strides[i]  = q_shape->GetDim(i) == 1 ? 0 : q_stride;
+        dims->kt_batch_strides[i] = kt_shape->GetDim(i) == 1 ? 0 : kt_stride;
+        dims->v_batch_strides[i]  = v_shape->GetDim(i) == 1 ? 0 : v_stride;
+        q_stride *= q_shape->GetDim(i);
+        kt_stride *= kt_shape->GetDim(i);
+        v_stride *= v_shape->GetDim(i);
+    }
+
+    dims->mask_batch_strides.assign(dim_count - 2, 0);
+    dims->mask_q_stride  = 0;
+    dims->mask_kv_stride = 0;
+    if (mask_shape) {
+        const int64_t mask_dim_count = mask_shape->GetDimCount();
+        if (mask_dim_count > dim_count) {
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        // align mask dims to [batch..., q_len, kv_len] from the right
+        std::vector<int64_t> strides(dim_count, 0);
+        int64_t stride = 1;
+        for (int64_t i = dim_count - 1; i >= 0; --i) {
+            const int64_t mi = i - (dim_count - mask_dim_count);
+            const int64_t md = mi >= 0 ? mask_shape->GetDim(mi) : 1;
+            const int64_t od = i == dim_count - 1 ? dims->kv_len : (i == dim_count - 2 ? dims->q_len : dims->batch_dims[i]);
+            if (md != od && md != 1) {
+                return ppl::common::RC_INVALID_VALUE;
+            }
+            strides[i] = md == 1 ? 0 : stride;
+            stride *= md;
+        }
+        for (int64_t i = 0; i < dim_count - 2; ++i) {
+            dims->mask_batch_strides[i] = strides[i];
+        }
+        dims->mask_q_stride  = strides[dim_count - 2];
+        dims->mask_kv_stride = strides[dim_count - 1];
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+uint64_t scaled_dot_product_attention_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape)
+{
+    const int64_t kv_len = kt_shape->GetDim(kt_shape->GetDimCount() - 1);
+    return (uint64_t)PPL_OMP_MAX_THREADS() * ATTN_Q_BLK() * kv_len * sizeof(float);
+}
+
+}}}; // namespace ppl::kernel::x86
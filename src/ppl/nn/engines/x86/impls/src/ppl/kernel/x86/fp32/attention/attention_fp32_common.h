@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_ATTENTION_ATTENTION_FP32_COMMON_H_
+#define __ST_PPL_KERNEL_X86_FP32_ATTENTION_ATTENTION_FP32_COMMON_H_
+
+#include <vector>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// number of queries whose scores are kept in the temp buffer at a time
+#define ATTN_Q_BLK() 16
+
+struct sdp_attention_fp32_dims {
+    int64_t batch;
+    int64_t q_len;
+    int64_t kv_len;
+    int64_t head_dim;
+    int64_t v_head_dim;
+
+    // batch dims of dst, which q, kt, v and mask broadcast to
+    std::vector<int64_t> batch_dims;
+    // element strides of each batch dim of the inputs, 0 for broadcast dims
+    std::vector<int64_t> q_batch_strides;
+    std::vector<int64_t> kt_batch_strides;
+    std::vector<int64_t> v_batch_strides;
+    std::vector<int64_t> mask_batch_strides;
+    int64_t mask_q_stride;
+    int64_t mask_kv_stride;
+
+    // element offset of the b-th matrix of an input with `strides`
+    int64_t batch_offset(const int64_t b, const std::vector<int64_t> &strides) const
+    {
+        int64_t offset = 0;
+        int64_t idx    = b;
+        for (int64_t i = (int64_t)batch_dims.size() - 1; i >= 0; --i) {
+            offset += (idx % batch_dims[i]) * strides[i];
+            idx /= batch_dims[i];
+        }
+        return offset;
+    }
+};
+
+ppl::common::RetCode sdp_attention_fp32_init_dims(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    sdp_attention_fp32_dims *dims);
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,321 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <math.h>
+#include <float.h>
+
+#include "ppl/kernel/x86/fp32/attention.h"
+#include "ppl/kernel/x86/fp32/attention/attention_fp32_common.h"
+#include "ppl/kernel/x86/common/math_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+#define SIMD_W() 8
+
+// score[rows, kv_len] = scale * q[rows, head_dim] * kt[head_dim, kv_len]
+static void sdp_attention_qk_fp32_fma(
+    const float *q,
+    const float *kt,
+    const int64_t rows,
+    const int64_t head_dim,
+    const int64_t kv_len,
+    const float scale,
+    float *score)
+{
+    const __m256 v_scale = _mm256_set1_ps(scale);
+    int64_t j = 0;
+    for (; j + 2 * SIMD_W() <= kv_len; j += 2 * SIMD_W()) {
+        int64_t r = 0;
+        for (; r + 4 <= rows; r += 4) {
+            const float *l_q  = q + r * head_dim;
+            const float *l_kt = kt + j;
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            for (int64_t d = 0; d < head_dim; ++d) {
+                const __m256 b0 = _mm256_loadu_ps(l_kt + 0 * SIMD_W());
+                const __m256 b1 = _mm256_loadu_ps(l_kt + 1 * SIMD_W());
+                __m256 a;
+                a   = _mm256_set1_ps(l_q[0 * head_dim + d]);
+                c00 = _mm256_fmadd_ps(a, b0, c00);
+                c01 = _mm256_fmadd_ps(a, b1, c01);
+                a   = _mm256_set1_ps(l_q[1 * head_dim + d]);
+                c10 = _mm256_fmadd_ps(a, b0, c10);
+                c11 = _mm256_fmadd_ps(a, b1, c11);
+                a   = _mm256_set1_ps(l_q[2 * head_dim + d]);
+                c20 = _mm256_fmadd_ps(a, b0, c20);
+                c21 = _mm256_fmadd_ps(a, b1, c21);
+                a   = _mm256_set1_ps(l_q[3 * head_dim + d]);
+                c30 = _mm256_fmadd_ps(a, b0, c30);
+                c31 = _mm256_fmadd_ps(a, b1, c31);
+                l_kt += kv_len;
+            }
+            float *l_score = score + r * kv_len + j;
+            _mm256_storeu_ps(l_score + 0 * kv_len + 0 * SIMD_W(), _mm256_mul_ps(c00, v_scale));
+            _mm256_storeu_ps(l_score + 0 * kv_len + 1 * SIMD_W(), _mm256_mul_ps(c01, v_scale));
+            _mm256_storeu_ps(l_score + 1 * kv_len + 0 * SIMD_W(), _mm256_mul_ps(c10, v_scale));
+            _mm256_storeu_ps(l_score + 1 * kv_len + 1 * SIMD_W(), _mm256_mul_ps(c11, v_scale));
+            _mm256_storeu_ps(l_score + 2 * kv_len + 0 * SIMD_W(), _mm256_mul_ps(c20, v_scale));
+            _mm256_storeu_ps(l_score + 2 * kv_len + 1 * SIMD_W(), _mm256_mul_ps(c21, v_scale));
+            _mm256_storeu_ps(l_score + 3 * kv_len + 0 * SIMD_W(), _mm256_mul_ps(c30, v_scale));
+            _mm256_storeu_ps(l_score + 3 * kv_len + 1 * SIMD_W(), _mm256_mul_ps(c31, v_scale));
+        }
+        for (; r < rows; ++r) {
+            const float *l_q  = q + r * head_dim;
+            const float *l_kt = kt + j;
+            __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+            for (int64_t d = 0; d < head_dim; ++d) {
+                const __m256 a = _mm256_set1_ps(l_q[d]);
+                c0 = _mm256_fmadd_ps(a, _mm256_loadu_ps(l_kt + 0 * SIMD_W()), c0);
+                c1 = _mm256_fmadd_ps(a, _mm256_loadu_ps(l_kt + 1 * SIMD_W()), c1);
+                l_kt += kv_len;
+            }
+            _mm256_storeu_ps(score + r * kv_len + j + 0 * SIMD_W(), _mm256_mul_ps(c0, v_scale));
+            _mm256_storeu_ps(score + r * kv_len + j + 1 * SIMD_W(), _mm256_mul_ps(c1, v_scale));
+        }
+    }
+    for (; j + SIMD_W() <= kv_len; j += SIMD_W()) {
+        for (int64_t r = 0; r < rows; ++r) {
+            const float *l_q  = q + r * head_dim;
+            const float *l_kt = kt + j;
+            __m256 c0 = _mm256_setzero_ps();
+            for (int64_t d = 0; d < head_dim; ++d) {
+                c0 = _mm256_fmadd_ps(_mm256_set1_ps(l_q[d]), _mm256_loadu_ps(l_kt), c0);
+                l_kt += kv_len;
+            }
+            _mm256_storeu_ps(score + r * kv_len + j, _mm256_mul_ps(c0, v_scale));
+        }
+    }
+    for (; j < kv_len; ++j) {
+        for (int64_t r = 0; r < rows; ++r) {
+            float s = 0.0f;
+            for (int64_t d = 0; d < head_dim; ++d) {
+                s += q[r * head_dim + d] * kt[d * kv_len + j];
+            }
+            score[r * kv_len + j] = s * scale;
+        }
+    }
+}
+
+// score = exp(score + mask - max) in place, returns 1 / sum of the row
+static float sdp_attention_softmax_fp32_fma(
+    const float *mask,
+    const int64_t mask_kv_stride,
+    const int64_t kv_len,
+    float *score)
+{
+    int64_t j;
+    if (mask) {
+        if (mask_kv_stride) {
+            for (j = 0; j + SIMD_W() <= kv_len; j += SIMD_W()) {
+                _mm256_storeu_ps(score + j, _mm256_add_ps(_mm256_loadu_ps(score + j), _mm256_loadu_ps(mask + j)));
+            }
+            for (; j < kv_len; ++j) {
+                score[j] += mask[j];
+            }
+        } else {
+            const __m256 v_mask = _mm256_set1_ps(mask[0]);
+            for (j = 0; j + SIMD_W() <= kv_len; j += SIMD_W()) {
+                _mm256_storeu_ps(score + j, _mm256_add_ps(_mm256_loadu_ps(score + j), v_mask));
+            }
+            for (; j < kv_len; ++j) {
+                score[j] += mask[0];
+            }
+        }
+    }
+
+    __m256 v_max = _mm256_set1_ps(-FLT_MAX);
+    for (j = 0; j + SIMD_W() <= kv_len; j += SIMD_W()) {
+        v_max = _mm256_max_ps(v_max, _mm256_loadu_ps(score + j));
+    }
+    float m_max[SIMD_W()];
+    _mm256_storeu_ps(m_max, v_max);
+    float max_val = -FLT_MAX;
+    for (int64_t k = 0; k < SIMD_W(); ++k) {
+        max_val = max(max_val, m_max[k]);
+    }
+    for (; j < kv_len; ++j) {
+        max_val = max(max_val, score[j]);
+    }
+
+    v_max = _mm256_set1_ps(max_val);
+    __m256 v_sum = _mm256_setzero_ps();
+    for (j = 0; j + SIMD_W() <= kv_len; j += SIMD_W()) {
+        const __m256 v_exp = _fma_exp_ps(_mm256_sub_ps(_mm256_loadu_ps(score + j), v_max));
+        _mm256_storeu_ps(score + j, v_exp);
+        v_sum = _mm256_add_ps(v_sum, v_exp);
+    }
+    float m_sum[SIMD_W()];
+    _mm256_storeu_ps(m_sum, v_sum);
+    float exp_sum = 0.0f;
+    for (int64_t k = 0; k < SIMD_W(); ++k) {
+        exp_sum += m_sum[k];
+    }
+    for (; j < kv_len; ++j) {
+        score[j] = expf(score[j] - max_val);
+        exp_sum += score[j];
+    }
+
+    return 1.0f / exp_sum;
+}
+
+// dst[rows, v_head_dim] = (p[rows, kv_len] * v[kv_len, v_head_dim]) * r_sum[rows]
+static void sdp_attention_pv_fp32_fma(
+    const float *p,
+    const float *v,
+    const float *r_sum,
+    const int64_t rows,
+    const int64_t kv_len,
+    const int64_t v_head_dim,
+    float *dst)
+{
+    int64_t c = 0;
+    for (; c + 2 * SIMD_W() <= v_head_dim; c += 2 * SIMD_W()) {
+        int64_t r = 0;
+        for (; r + 4 <= rows; r += 4) {
+            const float *l_p = p + r * kv_len;
+            const float *l_v = v + c;
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            for (int64_t j = 0; j < kv_len; ++j) {
+                const __m256 b0 = _mm256_loadu_ps(l_v + 0 * SIMD_W());
+                const __m256 b1 = _mm256_loadu_ps(l_v + 1 * SIMD_W());
+                __m256 a;
+                a   = _mm256_set1_ps(l_p[0 * kv_len + j]);
+                c00 = _mm256_fmadd_ps(a, b0, c00);
+                c01 = _mm256_fmadd_ps(a, b1, c01);
+                a   = _mm256_set1_ps(l_p[1 * kv_len + j]);
+                c10 = _mm256_fmadd_ps(a, b0, c10);
+                c11 = _mm256_fmadd_ps(a, b1, c11);
+                a   = _mm256_set1_ps(l_p[2 * kv_len + j]);
+                c20 = _mm256_fmadd_ps(a, b0, c20);
+                c21 = _mm256_fmadd_ps(a, b1, c21);
+                a   = _mm256_set1_ps(l_p[3 * kv_len + j]);
+                c30 = _mm256_fmadd_ps(a, b0, c30);
+                c31 = _mm256_fmadd_ps(a, b1, c31);
+                l_v += v_head_dim;
+            }
+            float *l_dst = dst + r * v_head_dim + c;
+            __m256 s;
+            s = _mm256_set1_ps(r_sum[r + 0]);
+            _mm256_storeu_ps(l_dst + 0 * v_head_dim + 0 * SIMD_W(), _mm256_mul_ps(c00, s));
+            _mm256_storeu_ps(l_dst + 0 * v_head_dim + 1 * SIMD_W(), _mm256_mul_ps(c01, s));
+            s = _mm256_set1_ps(r_sum[r + 1]);
+            _mm256_storeu_ps(l_dst + 1 * v_head_dim + 0 * SIMD_W(), _mm256_mul_ps(c10, s));
+            _mm256_storeu_ps(l_dst + 1 * v_head_dim + 1 * SIMD_W(), _mm256_mul_ps(c11, s));
+            s = _mm256_set1_ps(r_sum[r + 2]);
+            _mm256_storeu_ps(l_dst + 2 * v_head_dim + 0 * SIMD_W(), _mm256_mul_ps(c20, s));
+            _mm256_storeu_ps(l_dst + 2 * v_head_dim + 1 * SIMD_W(), _mm256_mul_ps(c21, s));
+            s = _mm256_set1_ps(r_sum[r + 3]);
+            _mm256_storeu_ps(l_dst + 3 * v_head_dim + 0 * SIMD_W(), _mm256_mul_ps(c30, s));
+            _mm256_storeu_ps(l_dst + 3 * v_head_dim + 1 * SIMD_W(), _mm256_mul_ps(c31, s));
+        }
+        for (; r < rows; ++r) {
+            const float *l_p = p + r * kv_len;
+            const float *l_v = v + c;
+            __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+            for (int64_t j = 0; j < kv_len; ++j) {
+                const __m256 a = _mm256_set1_ps(l_p[j]);
+                c0 = _mm256_fmadd_ps(a, _mm256_loadu_ps(l_v + 0 * SIMD_W()), c0);
+                c1 = _mm256_fmadd_ps(a, _mm256_loadu_ps(l_v + 1 * SIMD_W()), c1);
+                l_v += v_head_dim;
+            }
+            const __m256 s = _mm256_set1_ps(r_sum[r]);
+            _mm256_storeu_ps(dst + r * v_head_dim + c + 0 * SIMD_W(), _mm256_mul_ps(c0, s));
+            _mm256_storeu_ps(dst + r * v_head_dim + c + 1 * SIMD_W(), _mm256_mul_ps(c1, s));
+        }
+    }
+    for (; c + SIMD_W() <= v_head_dim; c += SIMD_W()) {
+        for (int64_t r = 0; r < rows; ++r) {
+            const float *l_p = p + r * kv_len;
+            const float *l_v = v + c;
+            __m256 c0 = _mm256_setzero_ps();
+            for (int64_t j = 0; j < kv_len; ++j) {
+                c0 = _mm256_fmadd_ps(_mm256_set1_ps(l_p[j]), _mm256_loadu_ps(l_v), c0);
+                l_v += v_head_dim;
+            }
+            _mm256_storeu_ps(dst + r * v_head_dim + c, _mm256_mul_ps(c0, _mm256_set1_ps(r_sum[r])));
+        }
+    }
+    for (; c < v_head_dim; ++c) {
+        for (int64_t r = 0; r < rows; ++r) {
+            float y = 0.0f;
+            for (int64_t j = 0; j < kv_len; ++j) {
+                y += p[r * kv_len + j] * v[j * v_head_dim + c];
+            }
+            dst[r * v_head_dim + c] = y * r_sum[r];
+        }
+    }
+}
+
+ppl::common::RetCode scaled_dot_product_attention_fp32_fma(
+    const ppl::nn::TensorShape *q_shape,
+    const ppl::nn::TensorShape *kt_shape,
+    const ppl::nn::TensorShape *v_shape,
+    const ppl::nn::TensorShape *mask_shape,
+    const float *q,
+    const float *kt,
+    const float *v,
+    const float *mask,
+    const float scale,
+    void *temp_buffer,
+    float *dst)
+{
+    sdp_attention_fp32_dims dims;
+    auto rc = sdp_attention_fp32_init_dims(q_shape, kt_shape, v_shape, mask ? mask_shape : nullptr, &dims);
+    if (rc != ppl::common::RC_SUCCESS) {
+        return rc;
+    }
+
+    const int64_t q_len      = dims.q_len;
+    const int64_t kv_len     = dims.kv_len;
+    const int64_t head_dim   = dims.head_dim;
+    const int64_t v_head_dim = dims.v_head_dim;
+    const int64_t q_blk_cnt  = div_up(q_len, ATTN_Q_BLK());
+
+    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
+    for (int64_t b = 0; b < dims.batch; ++b) {
+        for (int64_t qb = 0; qb < q_blk_cnt; ++qb) {
+            const int64_t q_start = qb * ATTN_Q_BLK();
+            const int64_t rows    = min<int64_t>(q_len - q_start, ATTN_Q_BLK());
+            const float *l_mask   = mask ? mask + dims.batch_offset(b, dims.mask_batch_strides) + q_start * dims.mask_q_stride : nullptr;
+            float *score          = (float *)temp_buffer + PPL_OMP_THREAD_ID() * ATTN_Q_BLK() * kv_len;
+            float r_sum[ATTN_Q_BLK()];
+
+            sdp_attention_qk_fp32_fma(
+                q + dims.batch_offset(b, dims.q_batch_strides) + q_start * head_dim,
+                kt + dims.batch_offset(b, dims.kt_batch_strides),
+                rows, head_dim, kv_len, scale, score);
+            for (int64_t r = 0; r < rows; ++r) {
+                r_sum[r] = sdp_attention_softmax_fp32_fma(
+                    l_mask ? l_mask + r * dims.mask_q_stride : nullptr, dims.mask_kv_stride,
+                    kv_len, score + r * kv_len);
+            }
+            sdp_attention_pv_fp32_fma(
+                score, v + dims.batch_offset(b, dims.v_batch_strides), r_sum,
+                rows, kv_len, v_head_dim, dst + (b * q_len + q_start) * v_head_dim);
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
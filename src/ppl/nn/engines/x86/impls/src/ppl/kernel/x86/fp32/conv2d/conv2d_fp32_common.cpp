@@ -21,6 +21,7 @@
 
 #include "ppl/kernel/x86/fp32/conv2d/gemm_direct/fma/conv2d_n16cx_gemm_direct_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_b4f3_fp32_fma.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/fma/conv2d_n16cx_winograd_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/fma/conv2d_n16cx_depthwise_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/im2col_gemm/fma/conv2d_im2col_gemm_fp32_fma.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/fma/conv2d_n16cx_direct_ndarray_fp32_fma.h"
@@ -32,6 +33,7 @@
 #include "ppl/kernel/x86/fp32/conv2d/depthwise/avx512/conv2d_n16cx_depthwise_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/direct_ndarray/avx512/conv2d_n16cx_direct_ndarray_fp32_avx512.h"
 #include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_b4f3_fp32_avx512.h"
+#include "ppl/kernel/x86/fp32/conv2d/winograd/avx512/conv2d_n16cx_winograd_fp32_avx512.h"
 #endif
 
 #include "ppl/kernel/x86/fp32/conv2d/direct/sse/conv2d_n8cx_direct_fp32_sse.h"
@@ -121,6 +123,22 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
             }
         }
 
+        if (!param.is_depthwise() &&
+            param.kernel_h == 5 && param.kernel_w == 5 &&
+            param.stride_h == 1 && param.stride_w == 1 &&
+            param.dilation_h == 1 && param.dilation_w == 1) {
+            auto wg_mgr    = new conv2d_n16cx_winograd_b4f5_fp32_avx512_manager(param, nullptr);
+            bool supported = wg_mgr->is_supported();
+            delete wg_mgr;
+            if (supported) {
+                return {
+                    conv2d_fp32_algo::WINOGRAD_B4F5,
+                    ppl::common::ISA_X86_AVX512,
+                    ppl::common::DATAFORMAT_N16CX,
+                    ppl::common::DATAFORMAT_N16CX};
+            }
+        }
+
         {
             auto direct_mgr = new conv2d_n16cx_direct_fp32_avx512_manager(param, nullptr);
             bool supported  = direct_mgr->is_supported();
@@ -194,6 +212,22 @@ conv2d_fp32_algo_info conv2d_algo_selector::select_algo(const ppl::common::dataf
             }
         }
 
+        if (!param.is_depthwise() &&
+            param.kernel_h == 5 && param.kernel_w == 5 &&
+            param.stride_h == 1 && param.stride_w == 1 &&
+            param.dilation_h == 1 && param.dilation_w == 1) {
+            auto wg_mgr    = new conv2d_n16cx_winograd_b4f5_fp32_fma_manager(param, nullptr);
+            bool supported = wg_mgr->is_supported();
+            delete wg_mgr;
+            if (supported) {
+                return {
+                    conv2d_fp32_algo::WINOGRAD_B4F5,
+                    ppl::common::ISA_X86_FMA,
+                    ppl::common::DATAFORMAT_N16CX,
+                    ppl::common::DATAFORMAT_N16CX};
+            }
+        }
+
         {
             auto direct_mgr = new conv2d_n16cx_direct_fp32_fma_manager(param, nullptr);
             bool supported  = direct_mgr->is_supported();
@@ -252,6 +286,24 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         return new conv2d_n16cx_winograd_b4f3_fp32_fma_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B6F3 &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b6f3_fp32_fma_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B2F5 &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b2f5_fp32_fma_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B4F5 &&
+        algo_info.isa == ppl::common::ISA_X86_FMA &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b4f5_fp32_fma_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::DIRECT &&
         algo_info.isa == ppl::common::ISA_X86_FMA &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
@@ -277,6 +329,24 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
         algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
         return new conv2d_n16cx_winograd_b4f3_fp32_avx512_manager(param, allocator);
     }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B6F3 &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b6f3_fp32_avx512_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B2F5 &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b2f5_fp32_avx512_manager(param, allocator);
+    }
+    if (algo_info.algo_type == conv2d_fp32_algo::WINOGRAD_B4F5 &&
+        algo_info.isa == ppl::common::ISA_X86_AVX512 &&
+        algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
+        algo_info.output_format == ppl::common::DATAFORMAT_N16CX) {
+        return new conv2d_n16cx_winograd_b4f5_fp32_avx512_manager(param, allocator);
+    }
     if (algo_info.algo_type == conv2d_fp32_algo::DIRECT &&
         algo_info.isa == ppl::common::ISA_X86_AVX512 &&
         algo_info.input_format == ppl::common::DATAFORMAT_N16CX &&
@@ -342,4 +412,45 @@ conv2d_fp32_manager *conv2d_algo_selector::gen_algo(const conv2d_fp32_param &par
     return nullptr;
 }
 
+std::vector<conv2d_fp32_algo_info> conv2d_algo_selector::get_candidate_algos(const conv2d_fp32_algo_info &algo_info, const conv2d_fp32_param &param, const ppl::common::isa_t isa_flags)
+{
+    static const conv2d_fp32_algo_t algo_types[] = {
+        conv2d_fp32_algo::DIRECT,
+        conv2d_fp32_algo::GEMM_DIRECT,
+        conv2d_fp32_algo::WINOGRAD_B4F3,
+        conv2d_fp32_algo::WINOGRAD_B6F3,
+        conv2d_fp32_algo::WINOGRAD_B2F5,
+        conv2d_fp32_algo::WINOGRAD_B4F5,
+        conv2d_fp32_algo::DEPTHWISE,
+        conv2d_fp32_algo::IM2COL_GEMM};
+
+    static const ppl::common::isa_t isas[] = {
+#ifdef PPL_USE_X86_AVX512
+        ppl::common::ISA_X86_AVX512,
+#endif
+        ppl::common::ISA_X86_FMA,
+        ppl::common::ISA_X86_SSE};
+
+    std::vector<conv2d_fp32_algo_info> candidates;
+    for (auto isa : isas) {
+        if (!(isa_flags & isa)) {
+            continue;
+        }
+        for (auto algo_type : algo_types) {
+            conv2d_fp32_algo_info candidate = {algo_type, isa, algo_info.input_format, algo_info.output_format};
+            auto mgr = gen_algo(param, candidate, nullptr);
+            if (!mgr) {
+                continue;
+            }
+            bool supported = mgr->is_supported();
+            delete mgr;
+            if (supported) {
+                candidates.push_back(candidate);
+            }
+        }
+    }
+
+    return candidates;
+}
+
 }}}; // namespace ppl::kernel::x86
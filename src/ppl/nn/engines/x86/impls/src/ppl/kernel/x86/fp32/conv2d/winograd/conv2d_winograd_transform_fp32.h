@@ -0,0 +1,212 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_CONV2D_WINOGRAD_CONV2D_WINOGRAD_TRANSFORM_FP32_H_
+#define __ST_PPL_KERNEL_X86_FP32_CONV2D_WINOGRAD_CONV2D_WINOGRAD_TRANSFORM_FP32_H_
+
+#include <stdint.h>
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// Toom-Cook F(m, r) with interpolation points 0, 1, -1, 2, -2, (1/2, -1/2,) and infinity.
+// dst = AT * [(G * filter * GT) .* (BT * src * B)] * A
+// BT only depends on the input tile size, so F(2,5) shares it with F(4,3), and F(4,5) with F(6,3).
+//
+// The 1-D transforms below apply BT or AT on one row/column of a tile. Rows of the
+// matrices come in pairs of opposite points, so each pair is computed as even +/- odd.
+// vec_t is a gcc vector type, such as __m256 or __m512.
+
+static const float winograd_b6f3_mat_G[8][3] = {
+    {1.f,       0.f,        0.f     },
+    {-2.f/9,    -2.f/9,     -2.f/9  },
+    {-2.f/9,    2.f/9,      -2.f/9  },
+    {1.f/90,    1.f/45,     2.f/45  },
+    {1.f/90,    -1.f/45,    2.f/45  },
+    {32.f/45,   16.f/45,    8.f/45  },
+    {32.f/45,   -16.f/45,   8.f/45  },
+    {0.f,       0.f,        1.f     },
+};
+
+static const float winograd_b2f5_mat_G[6][5] = {
+    {1.f/4,     0.f,        0.f,        0.f,        0.f     },
+    {-1.f/6,    -1.f/6,     -1.f/6,     -1.f/6,     -1.f/6  },
+    {-1.f/6,    1.f/6,      -1.f/6,     1.f/6,      -1.f/6  },
+    {1.f/24,    1.f/12,     1.f/6,      1.f/3,      2.f/3   },
+    {1.f/24,    -1.f/12,    1.f/6,      -1.f/3,     2.f/3   },
+    {0.f,       0.f,        0.f,        0.f,        1.f     },
+};
+
+static const float winograd_b4f5_mat_G[8][5] = {
+    {1.f,       0.f,        0.f,        0.f,        0.f     },
+    {-2.f/9,    -2.f/9,     -2.f/9,     -2.f/9,     -2.f/9  },
+    {-2.f/9,    2.f/9,      -2.f/9,     2.f/9,      -2.f/9  },
+    {1.f/90,    1.f/45,     2.f/45,     4.f/45,     8.f/45  },
+    {1.f/90,    -1.f/45,    2.f/45,     -4.f/45,    8.f/45  },
+    {32.f/45,   16.f/45,    8.f/45,     4.f/45,     2.f/45  },
+    {32.f/45,   -16.f/45,   8.f/45,     -4.f/45,    2.f/45  },
+    {0.f,       0.f,        0.f,        0.f,        1.f     },
+};
+
+// BT of 6x6 tiles
+// {4,  0, -5,  0, 1, 0}
+// {0, -4, -4,  1, 1, 0}
+// {0,  4, -4, -1, 1, 0}
+// {0, -2, -1,  2, 1, 0}
+// {0,  2, -1, -2, 1, 0}
+// {0,  4,  0, -5, 0, 1}
+template <typename vec_t>
+static inline void winograd_t6_src_trans_fp32(const vec_t *d, vec_t *r)
+{
+    vec_t even, odd;
+    r[0] = d[0] * 4.0f - d[2] * 5.0f + d[4];
+
+    even = d[4] - d[2] * 4.0f;
+    odd  = d[3] - d[1] * 4.0f;
+    r[1] = even + odd;
+    r[2] = even - odd;
+
+    even = d[4] - d[2];
+    odd  = (d[3] - d[1]) * 2.0f;
+    r[3] = even + odd;
+    r[4] = even - odd;
+
+    r[5] = d[1] * 4.0f - d[3] * 5.0f + d[5];
+}
+
+// BT of 8x8 tiles
+// {1,  0,    -21/4,  0,     21/4,   0,     -1, 0}
+// {0,  1,    1,      -17/4, -17/4,  1,     1,  0}
+// {0,  -1,   1,      17/4,  -17/4,  -1,    1,  0}
+// {0,  1/2,  1/4,    -5/2,  -5/4,   2,     1,  0}
+// {0,  -1/2, 1/4,    5/2,   -5/4,   -2,    1,  0}
+// {0,  2,    4,      -5/2,  -5,     1/2,   1,  0}
+// {0,  -2,   4,      5/2,   -5,     -1/2,  1,  0}
+// {0,  -1,   0,      21/4,  0,      -21/4, 0,  1}
+template <typename vec_t>
+static inline void winograd_t8_src_trans_fp32(const vec_t *d, vec_t *r)
+{
+    vec_t even, odd;
+    r[0] = d[0] - d[6] + (d[4] - d[2]) * 5.25f;
+
+    even = d[2] + d[6] - d[4] * 4.25f;
+    odd  = d[1] + d[5] - d[3] * 4.25f;
+    r[1] = even + odd;
+    r[2] = even - odd;
+
+    even = d[6] + d[2] * 0.25f - d[4] * 1.25f;
+    odd  = d[1] * 0.5f - d[3] * 2.5f + d[5] * 2.0f;
+    r[3] = even + odd;
+    r[4] = even - odd;
+
+    even = d[6] + (d[2] - d[4] * 1.25f) * 4.0f;
+    odd  = d[1] * 2.0f - d[3] * 2.5f + d[5] * 0.5f;
+    r[5] = even + odd;
+    r[6] = even - odd;
+
+    r[7] = d[7] - d[1] + (d[3] - d[5]) * 5.25f;
+}
+
+// AT of F(6,3)
+// {1, 1,  1,  1,  1,   1,    1,     0}
+// {0, 1, -1,  2, -2,   1/2,  -1/2,  0}
+// {0, 1,  1,  4,  4,   1/4,  1/4,   0}
+// {0, 1, -1,  8, -8,   1/8,  -1/8,  0}
+// {0, 1,  1, 16, 16,   1/16, 1/16,  0}
+// {0, 1, -1, 32, -32,  1/32, -1/32, 1}
+template <typename vec_t>
+static inline void winograd_b6f3_dst_trans_fp32(const vec_t *m, vec_t *y)
+{
+    const vec_t a1 = m[1] + m[2];
+    const vec_t s1 = m[1] - m[2];
+    const vec_t a2 = m[3] + m[4];
+    const vec_t s2 = m[3] - m[4];
+    const vec_t a3 = m[5] + m[6];
+    const vec_t s3 = m[5] - m[6];
+
+    y[0] = m[0] + a1 + a2 + a3;
+    y[1] = s1 + s2 * 2.0f + s3 * 0.5f;
+    y[2] = a1 + a2 * 4.0f + a3 * 0.25f;
+    y[3] = s1 + s2 * 8.0f + s3 * 0.125f;
+    y[4] = a1 + a2 * 16.0f + a3 * 0.0625f;
+    y[5] = s1 + s2 * 32.0f + s3 * 0.03125f + m[7];
+}
+
+// AT of F(2,5)
+// {1, 1,  1, 1,  1, 0}
+// {0, 1, -1, 2, -2, 1}
+template <typename vec_t>
+static inline void winograd_b2f5_dst_trans_fp32(const vec_t *m, vec_t *y)
+{
+    y[0] = m[0] + m[1] + m[2] + m[3] + m[4];
+    y[1] = m[1] - m[2] + (m[3] - m[4]) * 2.0f + m[5];
+}
+
+// AT of F(4,5)
+// {1, 1,  1, 1,  1, 1,   1,    0}
+// {0, 1, -1, 2, -2, 1/2, -1/2, 0}
+// {0, 1,  1, 4,  4, 1/4, 1/4,  0}
+// {0, 1, -1, 8, -8, 1/8, -1/8, 1}
+template <typename vec_t>
+static inline void winograd_b4f5_dst_trans_fp32(const vec_t *m, vec_t *y)
+{
+    const vec_t a1 = m[1] + m[2];
+    const vec_t s1 = m[1] - m[2];
+    const vec_t a2 = m[3] + m[4];
+    const vec_t s2 = m[3] - m[4];
+    const vec_t a3 = m[5] + m[6];
+    const vec_t s3 = m[5] - m[6];
+
+    y[0] = m[0] + a1 + a2 + a3;
+    y[1] = s1 + s2 * 2.0f + s3 * 0.5f;
+    y[2] = a1 + a2 * 4.0f + a3 * 0.25f;
+    y[3] = s1 + s2 * 8.0f + s3 * 0.125f + m[7];
+}
+
+// G: [TILE_OUT + KERNEL - 1, KERNEL], row-major
+template <int64_t TILE_OUT, int64_t KERNEL>
+struct winograd_fp32_transform;
+
+template <>
+struct winograd_fp32_transform<6, 3> {
+    static const float *G() { return winograd_b6f3_mat_G[0]; }
+    template <typename vec_t>
+    static inline void src_trans(const vec_t *d, vec_t *r) { winograd_t8_src_trans_fp32(d, r); }
+    template <typename vec_t>
+    static inline void dst_trans(const vec_t *m, vec_t *y) { winograd_b6f3_dst_trans_fp32(m, y); }
+};
+
+template <>
+struct winograd_fp32_transform<2, 5> {
+    static const float *G() { return winograd_b2f5_mat_G[0]; }
+    template <typename vec_t>
+    static inline void src_trans(const vec_t *d, vec_t *r) { winograd_t6_src_trans_fp32(d, r); }
+    template <typename vec_t>
+    static inline void dst_trans(const vec_t *m, vec_t *y) { winograd_b2f5_dst_trans_fp32(m, y); }
+};
+
+template <>
+struct winograd_fp32_transform<4, 5> {
+    static const float *G() { return winograd_b4f5_mat_G[0]; }
+    template <typename vec_t>
+    static inline void src_trans(const vec_t *d, vec_t *r) { winograd_t8_src_trans_fp32(d, r); }
+    template <typename vec_t>
+    static inline void dst_trans(const vec_t *m, vec_t *y) { winograd_b4f5_dst_trans_fp32(m, y); }
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,225 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/conv_transpose.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static const int64_t OC_DT_BLK = 16;
+static const int64_t IC_DT_BLK = 16;
+static const int64_t MAX_W_BLK = 6; // 12 accumulators, 2 filter and 1 broadcast registers
+
+uint64_t conv_transpose_n16cx_fp32_fma_get_cvt_filter_bytes(
+    const int32_t channels,
+    const int32_t num_output,
+    const int32_t kernel_h,
+    const int32_t kernel_w)
+{
+    return uint64_t(round_up(num_output, OC_DT_BLK)) * kernel_h * kernel_w * channels * sizeof(float);
+}
+
+ppl::common::RetCode conv_transpose_n16cx_fp32_fma_cvt_filter(
+    const float *filter,
+    const int32_t channels,
+    const int32_t num_output,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    float *cvt_filter)
+{
+    const int64_t padded_oc = round_up(num_output, OC_DT_BLK);
+PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t ocb = 0; ocb < padded_oc; ocb += OC_DT_BLK) {
+        const int64_t oc_eff = min<int64_t>(num_output - ocb, OC_DT_BLK);
+        for (int64_t kh = 0; kh < kernel_h; ++kh) {
+            for (int64_t kw = 0; kw < kernel_w; ++kw) {
+                for (int64_t ic = 0; ic < channels; ++ic) {
+                    float *dst = cvt_filter + (((ocb / OC_DT_BLK * kernel_h + kh) * kernel_w + kw) * channels + ic) * OC_DT_BLK;
+                    for (int64_t oc = 0; oc < oc_eff; ++oc) {
+                        dst[oc] = filter[((ic * num_output + ocb + oc) * kernel_h + kh) * kernel_w + kw];
+                    }
+                    for (int64_t oc = oc_eff; oc < OC_DT_BLK; ++oc) {
+                        dst[oc] = 0.0f;
+                    }
+                }
+            }
+        }
+    }
+    return ppl::common::RC_SUCCESS;
+}
+
+uint64_t conv_transpose_n16cx_fp32_fma_get_cvt_bias_bytes(
+    const int32_t num_output)
+{
+    return uint64_t(round_up(num_output, OC_DT_BLK)) * sizeof(float);
+}
+
+ppl::common::RetCode conv_transpose_n16cx_fp32_fma_cvt_bias(
+    const float *bias,
+    const int32_t num_output,
+    float *cvt_bias)
+{
+    const int64_t padded_oc = round_up(num_output, OC_DT_BLK);
+    for (int64_t oc = 0; oc < padded_oc; ++oc) {
+        cvt_bias[oc] = (bias && oc < num_output) ? bias[oc] : 0.0f;
+    }
+    return ppl::common::RC_SUCCESS;
+}
+
+// accumulates one kernel position into W_LEN output pixels of an output channel block.
+// input pixels are adjacent, and output pixels are dst_w_stride apart.
+template <int64_t W_LEN>
+static void conv_transpose_n16cx_kernel_fp32_fma(
+    const float *src,
+    const float *flt,
+    const int64_t channels,
+    const int64_t src_c_stride,
+    const int64_t dst_w_stride,
+    float *dst)
+{
+    __m256 acc[W_LEN * 2];
+    for (int64_t w = 0; w < W_LEN; ++w) {
+        acc[w * 2 + 0] = _mm256_loadu_ps(dst + w * dst_w_stride + 0);
+        acc[w * 2 + 1] = _mm256_loadu_ps(dst + w * dst_w_stride + 8);
+    }
+    for (int64_t icb = 0; icb < channels; icb += IC_DT_BLK) {
+        const int64_t ic_eff = min<int64_t>(channels - icb, IC_DT_BLK);
+        const float *s = src + (icb / IC_DT_BLK) * src_c_stride;
+        const float *f = flt + icb * OC_DT_BLK;
+        for (int64_t ic = 0; ic < ic_eff; ++ic) {
+            const __m256 w0 = _mm256_loadu_ps(f + 0);
+            const __m256 w1 = _mm256_loadu_ps(f + 8);
+            for (int64_t w = 0; w < W_LEN; ++w) {
+                const __m256 x = _mm256_set1_ps(s[w * IC_DT_BLK + ic]);
+                acc[w * 2 + 0] = _mm256_fmadd_ps(x, w0, acc[w * 2 + 0]);
+                acc[w * 2 + 1] = _mm256_fmadd_ps(x, w1, acc[w * 2 + 1]);
+            }
+            f += OC_DT_BLK;
+        }
+    }
+    for (int64_t w = 0; w < W_LEN; ++w) {
+        _mm256_storeu_ps(dst + w * dst_w_stride + 0, acc[w * 2 + 0]);
+        _mm256_storeu_ps(dst + w * dst_w_stride + 8, acc[w * 2 + 1]);
+    }
+}
+
+typedef void (*conv_transpose_n16cx_kernel_fp32_fma_func_t)(const float *, const float *, int64_t, int64_t, int64_t, float *);
+
+static const conv_transpose_n16cx_kernel_fp32_fma_func_t conv_transpose_n16cx_kernel_table[MAX_W_BLK] = {
+    conv_transpose_n16cx_kernel_fp32_fma<1>,
+    conv_transpose_n16cx_kernel_fp32_fma<2>,
+    conv_transpose_n16cx_kernel_fp32_fma<3>,
+    conv_transpose_n16cx_kernel_fp32_fma<4>,
+    conv_transpose_n16cx_kernel_fp32_fma<5>,
+    conv_transpose_n16cx_kernel_fp32_fma<6>,
+};
+
+ppl::common::RetCode conv_transpose_n16cx_fp32_fma(
+    const float *input,
+    const float *cvt_filter,
+    const float *cvt_bias,
+    const int32_t src_h,
+    const int32_t src_w,
+    const int32_t dst_h,
+    const int32_t dst_w,
+    const int32_t batch,
+    const int32_t channels,
+    const int32_t num_output,
+    const int32_t kernel_h,
+    const int32_t kernel_w,
+    const int32_t stride_h,
+    const int32_t stride_w,
+    const int32_t pad_h,
+    const int32_t pad_w,
+    const int32_t hole_h,
+    const int32_t hole_w,
+    const conv_fuse_flag_t fuse_flag,
+    float *output)
+{
+    if (fuse_flag & ~(conv_fuse_flag::RELU | conv_fuse_flag::RELU6)) {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    const int64_t ic_blks = div_up(channels, IC_DT_BLK);
+    const int64_t oc_blks = div_up(num_output, OC_DT_BLK);
+    const int64_t src_c_stride = int64_t(src_h) * src_w * IC_DT_BLK;
+    const int64_t flt_k_stride = int64_t(channels) * OC_DT_BLK;
+    const int64_t dst_w_stride = int64_t(stride_w) * OC_DT_BLK;
+
+    // every output row is owned by one thread, which gathers from the input rows and columns
+    // whose strided positions land on it, so no scatter or col buffer is needed
+PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(3)
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t ocb = 0; ocb < oc_blks; ++ocb) {
+            for (int64_t oh = 0; oh < dst_h; ++oh) {
+                float *dst_row = output + ((b * oc_blks + ocb) * dst_h + oh) * dst_w * OC_DT_BLK;
+                const float *flt_ocb = cvt_filter + ocb * kernel_h * kernel_w * flt_k_stride;
+
+                const __m256 vbias0 = cvt_bias ? _mm256_loadu_ps(cvt_bias + ocb * OC_DT_BLK + 0) : _mm256_setzero_ps();
+                const __m256 vbias1 = cvt_bias ? _mm256_loadu_ps(cvt_bias + ocb * OC_DT_BLK + 8) : _mm256_setzero_ps();
+                for (int64_t ow = 0; ow < dst_w; ++ow) {
+                    _mm256_storeu_ps(dst_row + ow * OC_DT_BLK + 0, vbias0);
+                    _mm256_storeu_ps(dst_row + ow * OC_DT_BLK + 8, vbias1);
+                }
+
+                for (int64_t kh = 0; kh < kernel_h; ++kh) {
+                    // oh = ih * stride_h - pad_h + kh * hole_h
+                    const int64_t ih_s = oh + pad_h - kh * hole_h;
+                    if (ih_s < 0 || ih_s % stride_h != 0 || ih_s / stride_h >= src_h) {
+                        continue;
+                    }
+                    const float *src_row = input + (b * ic_blks * src_h + ih_s / stride_h) * src_w * IC_DT_BLK;
+                    for (int64_t kw = 0; kw < kernel_w; ++kw) {
+                        // ow = iw * stride_w + ow_off
+                        const int64_t ow_off = kw * hole_w - pad_w;
+                        if (dst_w - 1 - ow_off < 0) {
+                            continue;
+                        }
+                        const int64_t iw_start = ow_off >= 0 ? 0 : div_up(-ow_off, stride_w);
+                        const int64_t iw_end = min<int64_t>(src_w, (dst_w - 1 - ow_off) / stride_w + 1);
+                        const float *flt = flt_ocb + (kh * kernel_w + kw) * flt_k_stride;
+                        for (int64_t iw = iw_start; iw < iw_end; iw += MAX_W_BLK) {
+                            const int64_t w_len = min<int64_t>(iw_end - iw, MAX_W_BLK);
+                            conv_transpose_n16cx_kernel_table[w_len - 1](
+                                src_row + iw * IC_DT_BLK, flt, channels, src_c_stride, dst_w_stride,
+                                dst_row + (iw * stride_w + ow_off) * OC_DT_BLK);
+                        }
+                    }
+                }
+
+                if (fuse_flag & (conv_fuse_flag::RELU | conv_fuse_flag::RELU6)) {
+                    const __m256 vzero = _mm256_setzero_ps();
+                    const __m256 vsix = _mm256_set1_ps(6.0f);
+                    for (int64_t i = 0; i < dst_w * OC_DT_BLK; i += 8) {
+                        __m256 v = _mm256_max_ps(_mm256_loadu_ps(dst_row + i), vzero);
+                        if (fuse_flag & conv_fuse_flag::RELU6) {
+                            v = _mm256_min_ps(v, vsix);
+                        }
+                        _mm256_storeu_ps(dst_row + i, v);
+                    }
+                }
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,58 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/common/math_avx512.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode gelu_fp32_avx512(
+    const ppl::nn::TensorShape *x_shape,
+    const float *x,
+    float *y)
+{
+    const int64_t simd_w      = 16;
+    const int64_t n_elem      = x_shape->GetElementsIncludingPadding();
+    const int64_t unroll_n    = 2 * simd_w;
+    const int64_t unroll_body = round(n_elem, unroll_n);
+    const float r_sqrt2       = 0.70710678118654752f;
+
+    const __m512 v_half    = _mm512_set1_ps(0.5f);
+    const __m512 v_r_sqrt2 = _mm512_set1_ps(r_sqrt2);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < unroll_body; i += unroll_n) {
+        __m512 src0 = _mm512_loadu_ps(x + i + 0 * simd_w);
+        __m512 src1 = _mm512_loadu_ps(x + i + 1 * simd_w);
+        __m512 hx0  = _mm512_mul_ps(src0, v_half);
+        __m512 hx1  = _mm512_mul_ps(src1, v_half);
+        __m512 erf0 = _avx512_erf_ps(_mm512_mul_ps(src0, v_r_sqrt2));
+        __m512 erf1 = _avx512_erf_ps(_mm512_mul_ps(src1, v_r_sqrt2));
+        _mm512_storeu_ps(y + i + 0 * simd_w, _mm512_fmadd_ps(hx0, erf0, hx0));
+        _mm512_storeu_ps(y + i + 1 * simd_w, _mm512_fmadd_ps(hx1, erf1, hx1));
+    }
+    for (int64_t i = unroll_body; i < n_elem; ++i) {
+        y[i] = 0.5f * x[i] * (1.0f + erff(x[i] * r_sqrt2));
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
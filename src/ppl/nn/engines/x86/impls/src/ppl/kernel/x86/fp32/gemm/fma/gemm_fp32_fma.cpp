@@ -945,7 +945,7 @@ ppl::common::RetCode gemm_fp32_fma(
             lH += mb * ldh + nb;
         }
 
-        float *lC = C + mb * ldh + nb;
+        float *lC = C + mb * ldc + nb;
 
         const int64_t mb_eff = min(m_task_blk, M - mb);
         const int64_t nb_eff = min(n_task_blk, N - nb);
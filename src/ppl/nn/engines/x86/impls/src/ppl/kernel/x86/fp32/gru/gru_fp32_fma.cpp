@@ -0,0 +1,410 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+#include "ppl/kernel/x86/fp32/rnn/rnn_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/common/avx_tools.h"
+#include "ppl/kernel/x86/common/math_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct gru_packed_fp32_fma_step_param {
+    const float *X_proj;
+    const float *packed_R;
+    const float *Rbh;
+    const int32_t *sequence_lens;
+    const float *h_prev;
+    float *h_next;
+    float *z; // only for !linear_before_reset
+    float *rh; // r (.) h_prev, only for !linear_before_reset
+    float *Y;
+    int64_t seq_len;
+    int64_t batch;
+    int64_t num_direction;
+    int64_t hidden_size;
+    int64_t seq_idx;
+    int64_t nd;
+    bool is_reverse;
+};
+
+static inline int64_t gru_packed_seq_index(const gru_packed_fp32_fma_step_param &p, const int64_t b, bool *valid)
+{
+    const int64_t len = p.sequence_lens ? p.sequence_lens[b] : p.seq_len;
+    *valid = p.seq_idx < len;
+    return p.is_reverse ? (len - 1 - p.seq_idx) : p.seq_idx;
+}
+
+// linear_before_reset: all gates in a single pass
+template <int64_t B_LEN>
+static void gru_packed_step_tile_lbr_fp32_fma(
+    const gru_packed_fp32_fma_step_param &p,
+    const int64_t b0,
+    const int64_t hb)
+{
+    const int64_t G = rnn_num_gate::GRU;
+    const int64_t H = p.hidden_size;
+    const int64_t nd_off = p.nd * p.batch * H;
+    const rnn_h_blk_io_fp32_fma io(min(rnn_kernel_fp32_fma::H_BLK, H - hb));
+
+    __m256 acc[B_LEN][G];
+    rnn_recurrent_kernel_fp32_fma<B_LEN, G, 0, G>(
+        p.h_prev + nd_off + b0 * H, H,
+        p.packed_R + hb * G * H, H, acc);
+
+    const __m256 rbh = p.Rbh ? io.load(p.Rbh + p.nd * H + hb) : _mm256_setzero_ps();
+    for (int64_t r = 0; r < B_LEN; ++r) {
+        const int64_t b = b0 + r;
+        const __m256 hp = io.load(p.h_prev + nd_off + b * H + hb);
+        float *h_next = p.h_next + nd_off + b * H + hb;
+        bool valid;
+        const int64_t t = gru_packed_seq_index(p, b, &valid);
+        if (!valid) { // pass through states, outputs beyond sequence_lens are zeros
+            io.store(h_next, hp);
+            if (p.Y) {
+                io.store(p.Y + ((p.seq_idx * p.num_direction + p.nd) * p.batch + b) * H + hb, _mm256_setzero_ps());
+            }
+            continue;
+        }
+
+        const float *xg = p.X_proj + ((t * p.batch + b) * p.num_direction + p.nd) * G * H + hb;
+        const __m256 zt = _fma_sigmoid_ps(_mm256_add_ps(acc[r][0], io.load(xg + 0 * H)));
+        const __m256 rt = _fma_sigmoid_ps(_mm256_add_ps(acc[r][1], io.load(xg + 1 * H)));
+        const __m256 nt = _fma_tanh_ps(_mm256_fmadd_ps(rt, _mm256_add_ps(acc[r][2], rbh), io.load(xg + 2 * H)));
+        const __m256 hn = _mm256_fmadd_ps(zt, _mm256_sub_ps(hp, nt), nt);
+
+        io.store(h_next, hn);
+        if (p.Y) {
+            io.store(p.Y + ((t * p.num_direction + p.nd) * p.batch + b) * H + hb, hn);
+        }
+    }
+}
+
+// !linear_before_reset, first pass: gates z and r
+template <int64_t B_LEN>
+static void gru_packed_step_tile_zr_fp32_fma(
+    const gru_packed_fp32_fma_step_param &p,
+    const int64_t b0,
+    const int64_t hb)
+{
+    const int64_t G = rnn_num_gate::GRU;
+    const int64_t H = p.hidden_size;
+    const int64_t nd_off = p.nd * p.batch * H;
+    const rnn_h_blk_io_fp32_fma io(min(rnn_kernel_fp32_fma::H_BLK, H - hb));
+
+    __m256 acc[B_LEN][2];
+    rnn_recurrent_kernel_fp32_fma<B_LEN, G, 0, 2>(
+        p.h_prev + nd_off + b0 * H, H,
+        p.packed_R + hb * G * H, H, acc);
+
+    for (int64_t r = 0; r < B_LEN; ++r) {
+        const int64_t b = b0 + r;
+        float *rh = p.rh + nd_off + b * H + hb;
+        bool valid;
+        const int64_t t = gru_packed_seq_index(p, b, &valid);
+        if (!valid) {
+            io.store(rh, _mm256_setzero_ps());
+            continue;
+        }
+
+        const float *xg = p.X_proj + ((t * p.batch + b) * p.num_direction + p.nd) * G * H + hb;
+        const __m256 zt = _fma_sigmoid_ps(_mm256_add_ps(acc[r][0], io.load(xg + 0 * H)));
+        const __m256 rt = _fma_sigmoid_ps(_mm256_add_ps(acc[r][1], io.load(xg + 1 * H)));
+        io.store(p.z + nd_off + b * H + hb, zt);
+        io.store(rh, _mm256_mul_ps(rt, io.load(p.h_prev + nd_off + b * H + hb)));
+    }
+}
+
+// !linear_before_reset, second pass: gate h and the new hidden state
+template <int64_t B_LEN>
+static void gru_packed_step_tile_h_fp32_fma(
+    const gru_packed_fp32_fma_step_param &p,
+    const int64_t b0,
+    const int64_t hb)
+{
+    const int64_t G = rnn_num_gate::GRU;
+    const int64_t H = p.hidden_size;
+    const int64_t nd_off = p.nd * p.batch * H;
+    const rnn_h_blk_io_fp32_fma io(min(rnn_kernel_fp32_fma::H_BLK, H - hb));
+
+    __m256 acc[B_LEN][1];
+    rnn_recurrent_kernel_fp32_fma<B_LEN, G, 2, 1>(
+        p.rh + nd_off + b0 * H, H,
+        p.packed_R + hb * G * H, H, acc);
+
+    for (int64_t r = 0; r < B_LEN; ++r) {
+        const int64_t b = b0 + r;
+        const __m256 hp = io.load(p.h_prev + nd_off + b * H + hb);
+        float *h_next = p.h_next + nd_off + b * H + hb;
+        bool valid;
+        const int64_t t = gru_packed_seq_index(p, b, &valid);
+        if (!valid) {
+            io.store(h_next, hp);
+            if (p.Y) {
+                io.store(p.Y + ((p.seq_idx * p.num_direction + p.nd) * p.batch + b) * H + hb, _mm256_setzero_ps());
+            }
+            continue;
+        }
+
+        const float *xg = p.X_proj + ((t * p.batch + b) * p.num_direction + p.nd) * G * H + hb;
+        const __m256 zt = io.load(p.z + nd_off + b * H + hb);
+        const __m256 nt = _fma_tanh_ps(_mm256_add_ps(acc[r][0], io.load(xg + 2 * H)));
+        const __m256 hn = _mm256_fmadd_ps(zt, _mm256_sub_ps(hp, nt), nt);
+
+        io.store(h_next, hn);
+        if (p.Y) {
+            io.store(p.Y + ((t * p.num_direction + p.nd) * p.batch + b) * H + hb, hn);
+        }
+    }
+}
+
+uint64_t gru_packed_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    const bool has_Y,
+    const bool has_Y_h)
+{
+    if (!has_Y && !has_Y_h)
+        return 64u;
+
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t h_size = 2 * num_direction * batch * hidden_size; // ping-pong
+    const uint64_t zr_size = linear_before_reset ? 0 : 2 * num_direction * batch * hidden_size;
+
+    return (h_size + zr_size) * sizeof(float);
+}
+
+ppl::common::RetCode gru_fp32_fma_fold_bias(
+    const float *bias,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    float *folded_bias,
+    float *Rbh)
+{
+    const int64_t G = rnn_num_gate::GRU;
+    const int64_t H = hidden_size;
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    for (int64_t nd = 0; nd < num_direction; ++nd) {
+        const float *nd_Wb = bias ? bias + nd * 2 * G * H : nullptr;
+        const float *nd_Rb = bias ? nd_Wb + G * H : nullptr;
+        float *nd_folded = folded_bias + nd * G * H;
+        for (int64_t j = 0; j < G * H; ++j) {
+            const bool fold_rb = j < 2 * H || !linear_before_reset;
+            nd_folded[j] = bias ? (nd_Wb[j] + (fold_rb ? nd_Rb[j] : 0.0f)) : 0.0f;
+        }
+        if (linear_before_reset && Rbh) {
+            for (int64_t h = 0; h < H; ++h) {
+                Rbh[nd * H + h] = bias ? nd_Rb[2 * H + h] : 0.0f;
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode gru_packed_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X_proj,
+    const float *packed_R_weight,
+    const float *Rbh,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h)
+{
+    if (!Y && !Y_h) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t H_BLK = rnn_kernel_fp32_fma::H_BLK;
+    const int64_t B_BLK = rnn_kernel_fp32_fma::MAX_B_BLK;
+
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t state_len = num_direction * batch * hidden_size;
+    const int64_t packed_R_len = round_up(hidden_size, H_BLK) * rnn_num_gate::GRU * hidden_size;
+
+    float *h_buf[2];
+    h_buf[0] = reinterpret_cast<float*>(temp_buffer);
+    h_buf[1] = h_buf[0] + state_len;
+    float *z_buf = linear_before_reset ? nullptr : h_buf[1] + state_len;
+    float *rh_buf = linear_before_reset ? nullptr : z_buf + state_len;
+
+    if (initial_h) {
+        memcpy32_avx(h_buf[0], initial_h, state_len);
+    } else {
+        memset32_avx(h_buf[0], 0, state_len);
+    }
+
+    const int64_t num_b_blk = div_up(batch, B_BLK);
+    const int64_t num_h_blk = div_up(hidden_size, H_BLK);
+    const int64_t num_task = num_direction * num_b_blk * num_h_blk;
+
+    gru_packed_fp32_fma_step_param p0;
+    p0.X_proj = X_proj;
+    p0.Rbh = Rbh;
+    p0.sequence_lens = sequence_lens;
+    p0.z = z_buf;
+    p0.rh = rh_buf;
+    p0.Y = Y;
+    p0.seq_len = seq_len;
+    p0.batch = batch;
+    p0.num_direction = num_direction;
+    p0.hidden_size = hidden_size;
+
+    // tasks of all directions are scheduled together, so that directions run in parallel
+PRAGMA_OMP_PARALLEL()
+    for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
+        for (int64_t pass = 0; pass < (linear_before_reset ? 1 : 2); ++pass) {
+PRAGMA_OMP_FOR()
+            for (int64_t task = 0; task < num_task; ++task) {
+                const int64_t nd = task / (num_b_blk * num_h_blk);
+                const int64_t b0 = (task / num_h_blk) % num_b_blk * B_BLK;
+                const int64_t hb = task % num_h_blk * H_BLK;
+                const int64_t b_len = min(B_BLK, batch - b0);
+
+                gru_packed_fp32_fma_step_param p = p0;
+                p.packed_R = packed_R_weight + nd * packed_R_len;
+                p.h_prev = h_buf[seq_idx % 2];
+                p.h_next = h_buf[(seq_idx + 1) % 2];
+                p.seq_idx = seq_idx;
+                p.nd = nd;
+                p.is_reverse = nd || (direction == rnn_direction::REVERSE);
+
+                auto tile_func = gru_packed_step_tile_lbr_fp32_fma<1>;
+                if (linear_before_reset) {
+                    if (b_len == 2) tile_func = gru_packed_step_tile_lbr_fp32_fma<2>;
+                    if (b_len == 3) tile_func = gru_packed_step_tile_lbr_fp32_fma<3>;
+                } else if (pass == 0) {
+                    tile_func = gru_packed_step_tile_zr_fp32_fma<1>;
+                    if (b_len == 2) tile_func = gru_packed_step_tile_zr_fp32_fma<2>;
+                    if (b_len == 3) tile_func = gru_packed_step_tile_zr_fp32_fma<3>;
+                } else {
+                    tile_func = gru_packed_step_tile_h_fp32_fma<1>;
+                    if (b_len == 2) tile_func = gru_packed_step_tile_h_fp32_fma<2>;
+                    if (b_len == 3) tile_func = gru_packed_step_tile_h_fp32_fma<3>;
+                }
+                tile_func(p, b0, hb);
+            }
+        }
+    }
+
+    if (Y_h) {
+        memcpy32_avx(Y_h, h_buf[seq_len % 2], state_len);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+uint64_t gru_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    const bool has_Y,
+    const bool has_Y_h)
+{
+    if (!has_Y && !has_Y_h)
+        return 64u;
+
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t proj_size = seq_len * batch * num_direction * rnn_num_gate::GRU * hidden_size;
+    const uint64_t bias_size = num_direction * (rnn_num_gate::GRU + 1) * hidden_size;
+    const uint64_t packed_R_bytes = rnn_fp32_fma_get_packed_recurrent_weight_bytes(direction, rnn_num_gate::GRU, hidden_size);
+
+    return (proj_size + bias_size) * sizeof(float) + packed_R_bytes +
+        gru_packed_fp32_fma_get_buffer_bytes(X_shape, direction, hidden_size, linear_before_reset, has_Y, has_Y_h);
+}
+
+ppl::common::RetCode gru_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h)
+{
+    if (!Y && !Y_h) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+    const int64_t proj_len = num_direction * rnn_num_gate::GRU * hidden_size;
+
+    float *X_proj = reinterpret_cast<float*>(temp_buffer);
+    float *folded_bias = X_proj + seq_len * batch * proj_len;
+    float *Rbh = folded_bias + proj_len;
+    float *packed_R = Rbh + num_direction * hidden_size;
+    void *packed_temp = reinterpret_cast<char*>(packed_R) +
+        rnn_fp32_fma_get_packed_recurrent_weight_bytes(direction, rnn_num_gate::GRU, hidden_size);
+
+    auto ret = gru_fp32_fma_fold_bias(bias, direction, hidden_size, linear_before_reset, folded_bias, Rbh);
+    if (ret != ppl::common::RC_SUCCESS) {
+        return ret;
+    }
+    ret = rnn_fp32_fma_pack_recurrent_weight(R_weight, direction, rnn_num_gate::GRU, hidden_size, packed_R);
+    if (ret != ppl::common::RC_SUCCESS) {
+        return ret;
+    }
+
+    // input projection of all timesteps and directions in one gemm
+    ret = gemm_fp32_fma(
+        X, X_weight, folded_bias, nullptr,
+        gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+        gemm_v_type::ROW_VEC, gemm_m_type::EMPTY,
+        seq_len * batch, proj_len, input_size,
+        input_size, input_size, proj_len, 0,
+        1.0f, 1.0f, gemm_post::NONE, X_proj);
+    if (ret != ppl::common::RC_SUCCESS) {
+        return ret;
+    }
+
+    return gru_packed_fp32_fma(
+        X_shape, X_proj, packed_R, linear_before_reset ? Rbh : nullptr,
+        sequence_lens, initial_h, direction, hidden_size, linear_before_reset,
+        packed_temp, Y, Y_h);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,165 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline float sigmoidf(const float x) {
+    return 1.0f / (1.0f + expf(-x));
+}
+
+uint64_t gru_ref_fp32_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h)
+{
+    if (!has_Y && !has_Y_h)
+        return 64u;
+
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t h_size = 2 * num_direction * batch * hidden_size; // ping-pong
+    const uint64_t gate_size = 2 * rnn_num_gate::GRU * hidden_size + hidden_size;
+
+    return (h_size + gate_size) * sizeof(float);
+}
+
+ppl::common::RetCode gru_ref_fp32(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X,
+    const float *X_weight,
+    const float *R_weight,
+    const float *bias,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool linear_before_reset,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h)
+{
+    if (!Y && !Y_h) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t G = rnn_num_gate::GRU;
+    const int64_t H = hidden_size;
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t input_size = X_shape->GetDim(2);
+    const int64_t state_len = num_direction * batch * H;
+
+    float *h_buf[2];
+    h_buf[0] = reinterpret_cast<float*>(temp_buffer);
+    h_buf[1] = h_buf[0] + state_len;
+    float *xg = h_buf[1] + state_len; // X[t] * W^T + Wb
+    float *hg = xg + G * H; // H[t-1] * R^T + Rb
+    float *rh = hg + G * H; // r (.) H[t-1]
+
+    if (initial_h) {
+        memcpy(h_buf[0], initial_h, state_len * sizeof(float));
+    } else {
+        memset(h_buf[0], 0, state_len * sizeof(float));
+    }
+
+    for (int64_t nd = 0; nd < num_direction; ++nd) {
+        const bool is_reverse = nd || (direction == rnn_direction::REVERSE);
+
+        const float *nd_W = X_weight + nd * G * H * input_size;
+        const float *nd_R = R_weight + nd * G * H * H;
+        const float *nd_Wb = bias ? bias + nd * 2 * G * H : nullptr;
+        const float *nd_Rb = bias ? nd_Wb + G * H : nullptr;
+
+        for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
+            for (int64_t b = 0; b < batch; ++b) {
+                const int64_t len = sequence_lens ? sequence_lens[b] : seq_len;
+                const float *h_prev = h_buf[seq_idx % 2] + (nd * batch + b) * H;
+                float *h_next = h_buf[(seq_idx + 1) % 2] + (nd * batch + b) * H;
+                if (seq_idx >= len) {
+                    memcpy(h_next, h_prev, H * sizeof(float));
+                    if (Y) {
+                        memset(Y + ((seq_idx * num_direction + nd) * batch + b) * H, 0, H * sizeof(float));
+                    }
+                    continue;
+                }
+
+                const int64_t t = is_reverse ? (len - 1 - seq_idx) : seq_idx;
+                const float *x = X + (t * batch + b) * input_size;
+                for (int64_t j = 0; j < G * H; ++j) {
+                    float sum = nd_Wb ? nd_Wb[j] : 0.0f;
+                    for (int64_t k = 0; k < input_size; ++k) {
+                        sum += x[k] * nd_W[j * input_size + k];
+                    }
+                    xg[j] = sum;
+                }
+                // gate h of hg is computed later if not linear_before_reset
+                const int64_t hg_len = linear_before_reset ? G * H : 2 * H;
+                for (int64_t j = 0; j < hg_len; ++j) {
+                    float sum = nd_Rb ? nd_Rb[j] : 0.0f;
+                    for (int64_t k = 0; k < H; ++k) {
+                        sum += h_prev[k] * nd_R[j * H + k];
+                    }
+                    hg[j] = sum;
+                }
+
+                for (int64_t h = 0; h < H; ++h) {
+                    rh[h] = sigmoidf(xg[H + h] + hg[H + h]); // r
+                }
+                if (!linear_before_reset) {
+                    for (int64_t h = 0; h < H; ++h) {
+                        rh[h] *= h_prev[h];
+                    }
+                    for (int64_t h = 0; h < H; ++h) {
+                        float sum = nd_Rb ? nd_Rb[2 * H + h] : 0.0f;
+                        for (int64_t k = 0; k < H; ++k) {
+                            sum += rh[k] * nd_R[(2 * H + h) * H + k];
+                        }
+                        hg[2 * H + h] = sum;
+                    }
+                }
+
+                for (int64_t h = 0; h < H; ++h) {
+                    const float z = sigmoidf(xg[h] + hg[h]);
+                    const float n = linear_before_reset ? ::tanhf(xg[2 * H + h] + rh[h] * hg[2 * H + h])
+                                                        : ::tanhf(xg[2 * H + h] + hg[2 * H + h]);
+                    h_next[h] = (1.0f - z) * n + z * h_prev[h];
+                }
+                if (Y) {
+                    memcpy(Y + ((t * num_direction + nd) * batch + b) * H, h_next, H * sizeof(float));
+                }
+            }
+        }
+    }
+
+    if (Y_h) {
+        memcpy(Y_h, h_buf[seq_len % 2], state_len * sizeof(float));
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
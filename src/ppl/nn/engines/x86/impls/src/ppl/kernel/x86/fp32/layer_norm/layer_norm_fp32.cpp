@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <math.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode layer_norm_fp32(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const float *scale,
+    const float *shift,
+    const int64_t axis,
+    const float eps,
+    float *dst)
+{
+    int64_t outer_dim = 1;
+    int64_t inner_dim = 1;
+    for (int64_t i = 0; i < axis; ++i) {
+        outer_dim *= src_shape->GetDim(i);
+    }
+    for (int64_t i = axis; i < src_shape->GetDimCount(); ++i) {
+        inner_dim *= src_shape->GetDim(i);
+    }
+    const float r_inner_dim = 1.0f / inner_dim;
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t o = 0; o < outer_dim; ++o) {
+        const float *l_src = src + o * inner_dim;
+        float *l_dst       = dst + o * inner_dim;
+
+        // mean and variance from one pass over the row
+        float sum    = 0.0f;
+        float sq_sum = 0.0f;
+        for (int64_t i = 0; i < inner_dim; ++i) {
+            sum += l_src[i];
+            sq_sum += l_src[i] * l_src[i];
+        }
+        const float mean = sum * r_inner_dim;
+        const float var  = max(sq_sum * r_inner_dim - mean * mean, 0.0f);
+        const float rstd = 1.0f / sqrtf(var + eps);
+
+        for (int64_t i = 0; i < inner_dim; ++i) {
+            float y = (l_src[i] - mean) * rstd;
+            if (scale) y *= scale[i];
+            if (shift) y += shift[i];
+            l_dst[i] = y;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <math.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode layer_norm_fp32_avx512(
+    const ppl::nn::TensorShape *src_shape,
+    const float *src,
+    const float *scale,
+    const float *shift,
+    const int64_t axis,
+    const float eps,
+    float *dst)
+{
+    int64_t outer_dim = 1;
+    int64_t inner_dim = 1;
+    for (int64_t i = 0; i < axis; ++i) {
+        outer_dim *= src_shape->GetDim(i);
+    }
+    for (int64_t i = axis; i < src_shape->GetDimCount(); ++i) {
+        inner_dim *= src_shape->GetDim(i);
+    }
+    const float r_inner_dim = 1.0f / inner_dim;
+
+    const int64_t simd_w      = 16;
+    const int64_t unroll_n    = 2 * simd_w;
+    const int64_t unroll_body = round(inner_dim, unroll_n);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t o = 0; o < outer_dim; ++o) {
+        const float *l_src = src + o * inner_dim;
+        float *l_dst       = dst + o * inner_dim;
+
+        // mean and variance from one pass over the row
+        __m512 v_sum0    = _mm512_setzero_ps();
+        __m512 v_sum1    = _mm512_setzero_ps();
+        __m512 v_sq_sum0 = _mm512_setzero_ps();
+        __m512 v_sq_sum1 = _mm512_setzero_ps();
+        for (int64_t i = 0; i < unroll_body; i += unroll_n) {
+            __m512 v_src0 = _mm512_loadu_ps(l_src + i + 0 * simd_w);
+            __m512 v_src1 = _mm512_loadu_ps(l_src + i + 1 * simd_w);
+            v_sum0       = _mm512_add_ps(v_sum0, v_src0);
+            v_sum1       = _mm512_add_ps(v_sum1, v_src1);
+            v_sq_sum0    = _mm512_fmadd_ps(v_src0, v_src0, v_sq_sum0);
+            v_sq_sum1    = _mm512_fmadd_ps(v_src1, v_src1, v_sq_sum1);
+        }
+        float m_sum[simd_w], m_sq_sum[simd_w];
+        _mm512_storeu_ps(m_sum, _mm512_add_ps(v_sum0, v_sum1));
+        _mm512_storeu_ps(m_sq_sum, _mm512_add_ps(v_sq_sum0, v_sq_sum1));
+        float sum    = 0.0f;
+        float sq_sum = 0.0f;
+        for (int64_t i = 0; i < simd_w; ++i) {
+            sum += m_sum[i];
+            sq_sum += m_sq_sum[i];
+        }
+        for (int64_t i = unroll_body; i < inner_dim; ++i) {
+            sum += l_src[i];
+            sq_sum += l_src[i] * l_src[i];
+        }
+        const float mean = sum * r_inner_dim;
+        const float var  = max(sq_sum * r_inner_dim - mean * mean, 0.0f);
+        const float rstd = 1.0f / sqrtf(var + eps);
+
+        // y = x * rstd - mean * rstd, then scale and shift
+        const __m512 v_rstd     = _mm512_set1_ps(rstd);
+        const __m512 v_neg_mean = _mm512_set1_ps(-mean * rstd);
+        int64_t i = 0;
+        if (scale && shift) {
+            for (; i + simd_w <= inner_dim; i += simd_w) {
+                __m512 v_dst = _mm512_fmadd_ps(_mm512_loadu_ps(l_src + i), v_rstd, v_neg_mean);
+                v_dst       = _mm512_fmadd_ps(v_dst, _mm512_loadu_ps(scale + i), _mm512_loadu_ps(shift + i));
+                _mm512_storeu_ps(l_dst + i, v_dst);
+            }
+        } else if (scale) {
+            for (; i + simd_w <= inner_dim; i += simd_w) {
+                __m512 v_dst = _mm512_fmadd_ps(_mm512_loadu_ps(l_src + i), v_rstd, v_neg_mean);
+                _mm512_storeu_ps(l_dst + i, _mm512_mul_ps(v_dst, _mm512_loadu_ps(scale + i)));
+            }
+        } else if (shift) {
+            for (; i + simd_w <= inner_dim; i += simd_w) {
+                __m512 v_dst = _mm512_fmadd_ps(_mm512_loadu_ps(l_src + i), v_rstd, v_neg_mean);
+                _mm512_storeu_ps(l_dst + i, _mm512_add_ps(v_dst, _mm512_loadu_ps(shift + i)));
+            }
+        } else {
+            for (; i + simd_w <= inner_dim; i += simd_w) {
+                _mm512_storeu_ps(l_dst + i, _mm512_fmadd_ps(_mm512_loadu_ps(l_src + i), v_rstd, v_neg_mean));
+            }
+        }
+        for (; i < inner_dim; ++i) {
+            float y = (l_src[i] - mean) * rstd;
+            if (scale) y *= scale[i];
+            if (shift) y += shift[i];
+            l_dst[i] = y;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,218 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/fp32/lstm.h"
+#include "ppl/kernel/x86/fp32/rnn/rnn_kernel_fp32_fma.h"
+#include "ppl/kernel/x86/common/avx_tools.h"
+#include "ppl/kernel/x86/common/math_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct lstm_packed_fp32_fma_step_param {
+    const float *X_proj;
+    const float *packed_R;
+    const float *P;
+    const int32_t *sequence_lens;
+    const float *h_prev;
+    float *h_next;
+    float *c;
+    float *Y;
+    int64_t seq_len;
+    int64_t batch;
+    int64_t num_direction;
+    int64_t hidden_size;
+    int64_t seq_idx;
+    int64_t nd;
+    bool is_reverse;
+};
+
+// one recurrent step of B_LEN batch rows and a panel of hidden units, with gate activations fused
+template <int64_t B_LEN>
+static void lstm_packed_step_tile_fp32_fma(
+    const lstm_packed_fp32_fma_step_param &p,
+    const int64_t b0,
+    const int64_t hb)
+{
+    const int64_t G = rnn_num_gate::LSTM;
+    const int64_t H = p.hidden_size;
+    const int64_t nd_off = p.nd * p.batch * H;
+    const rnn_h_blk_io_fp32_fma io(min(rnn_kernel_fp32_fma::H_BLK, H - hb));
+
+    __m256 acc[B_LEN][G];
+    rnn_recurrent_kernel_fp32_fma<B_LEN, G, 0, G>(
+        p.h_prev + nd_off + b0 * H, H,
+        p.packed_R + hb * G * H, H, acc);
+
+    for (int64_t r = 0; r < B_LEN; ++r) {
+        const int64_t b = b0 + r;
+        const int64_t len = p.sequence_lens ? p.sequence_lens[b] : p.seq_len;
+        const float *h_prev = p.h_prev + nd_off + b * H + hb;
+        float *h_next = p.h_next + nd_off + b * H + hb;
+        if (p.seq_idx >= len) { // pass through states, outputs beyond sequence_lens are zeros
+            io.store(h_next, io.load(h_prev));
+            if (p.Y) {
+                io.store(p.Y + ((p.seq_idx * p.num_direction + p.nd) * p.batch + b) * H + hb, _mm256_setzero_ps());
+            }
+            continue;
+        }
+
+        const int64_t t = p.is_reverse ? (len - 1 - p.seq_idx) : p.seq_idx;
+        const float *xg = p.X_proj + ((t * p.batch + b) * p.num_direction + p.nd) * G * H + hb;
+        float *c = p.c + nd_off + b * H + hb;
+
+        const __m256 cp = io.load(c);
+        __m256 gi = _mm256_add_ps(acc[r][0], io.load(xg + 0 * H));
+        __m256 go = _mm256_add_ps(acc[r][1], io.load(xg + 1 * H));
+        __m256 gf = _mm256_add_ps(acc[r][2], io.load(xg + 2 * H));
+        __m256 gc = _mm256_add_ps(acc[r][3], io.load(xg + 3 * H));
+        if (p.P) {
+            const float *nd_P = p.P + p.nd * (G - 1) * H + hb;
+            gi = _mm256_fmadd_ps(cp, io.load(nd_P + 0 * H), gi);
+            gf = _mm256_fmadd_ps(cp, io.load(nd_P + 2 * H), gf);
+        }
+        const __m256 it = _fma_sigmoid_ps(gi);
+        const __m256 ft = _fma_sigmoid_ps(gf);
+        const __m256 ct = _fma_tanh_ps(gc);
+        const __m256 cn = _mm256_fmadd_ps(ft, cp, _mm256_mul_ps(it, ct));
+        if (p.P) {
+            go = _mm256_fmadd_ps(cn, io.load(p.P + p.nd * (G - 1) * H + 1 * H + hb), go);
+        }
+        const __m256 ot = _fma_sigmoid_ps(go);
+        const __m256 hn = _mm256_mul_ps(ot, _fma_tanh_ps(cn));
+
+        io.store(c, cn);
+        io.store(h_next, hn);
+        if (p.Y) {
+            io.store(p.Y + ((t * p.num_direction + p.nd) * p.batch + b) * H + hb, hn);
+        }
+    }
+}
+
+uint64_t lstm_packed_fp32_fma_get_buffer_bytes(
+    const ppl::nn::TensorShape *X_shape,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    const bool has_Y,
+    const bool has_Y_h,
+    const bool has_Y_c)
+{
+    if (!has_Y && !has_Y_h && !has_Y_c)
+        return 64u;
+
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    const uint64_t h_size = 2 * num_direction * batch * hidden_size; // ping-pong
+    const uint64_t c_size = has_Y_c ? 0 : num_direction * batch * hidden_size;
+
+    return (h_size + c_size) * sizeof(float);
+}
+
+ppl::common::RetCode lstm_packed_fp32_fma(
+    const ppl::nn::TensorShape *X_shape,
+    const float *X_proj,
+    const float *packed_R_weight,
+    const float *P_weight,
+    const int32_t *sequence_lens,
+    const float *initial_h,
+    const float *initial_c,
+    const rnn_direction_t direction,
+    const int64_t hidden_size,
+    void *temp_buffer,
+    float *Y,
+    float *Y_h,
+    float *Y_c)
+{
+    if (!Y && !Y_h && !Y_c) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    const int64_t H_BLK = rnn_kernel_fp32_fma::H_BLK;
+    const int64_t B_BLK = rnn_kernel_fp32_fma::MAX_B_BLK;
+
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t seq_len = X_shape->GetDim(0);
+    const int64_t batch = X_shape->GetDim(1);
+    const int64_t state_len = num_direction * batch * hidden_size;
+    const int64_t packed_R_len = round_up(hidden_size, H_BLK) * rnn_num_gate::LSTM * hidden_size;
+
+    float *h_buf[2];
+    h_buf[0] = reinterpret_cast<float*>(temp_buffer);
+    h_buf[1] = h_buf[0] + state_len;
+    float *c_buf = Y_c ? Y_c : h_buf[1] + state_len;
+
+    if (initial_h) {
+        memcpy32_avx(h_buf[0], initial_h, state_len);
+    } else {
+        memset32_avx(h_buf[0], 0, state_len);
+    }
+    if (initial_c) {
+        memcpy32_avx(c_buf, initial_c, state_len);
+    } else {
+        memset32_avx(c_buf, 0, state_len);
+    }
+
+    const int64_t num_b_blk = div_up(batch, B_BLK);
+    const int64_t num_h_blk = div_up(hidden_size, H_BLK);
+    const int64_t num_task = num_direction * num_b_blk * num_h_blk;
+
+    lstm_packed_fp32_fma_step_param p0;
+    p0.X_proj = X_proj;
+    p0.P = P_weight;
+    p0.sequence_lens = sequence_lens;
+    p0.c = c_buf;
+    p0.Y = Y;
+    p0.seq_len = seq_len;
+    p0.batch = batch;
+    p0.num_direction = num_direction;
+    p0.hidden_size = hidden_size;
+
+    // tasks of all directions are scheduled together, so that directions run in parallel
+PRAGMA_OMP_PARALLEL()
+    for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
+PRAGMA_OMP_FOR()
+        for (int64_t task = 0; task < num_task; ++task) {
+            const int64_t nd = task / (num_b_blk * num_h_blk);
+            const int64_t b0 = (task / num_h_blk) % num_b_blk * B_BLK;
+            const int64_t hb = task % num_h_blk * H_BLK;
+            const int64_t b_len = min(B_BLK, batch - b0);
+
+            lstm_packed_fp32_fma_step_param p = p0;
+            p.packed_R = packed_R_weight + nd * packed_R_len;
+            p.h_prev = h_buf[seq_idx % 2];
+            p.h_next = h_buf[(seq_idx + 1) % 2];
+            p.seq_idx = seq_idx;
+            p.nd = nd;
+            p.is_reverse = nd || (direction == rnn_direction::REVERSE);
+
+            if (b_len == 3) lstm_packed_step_tile_fp32_fma<3>(p, b0, hb);
+            if (b_len == 2) lstm_packed_step_tile_fp32_fma<2>(p, b0, hb);
+            if (b_len == 1) lstm_packed_step_tile_fp32_fma<1>(p, b0, hb);
+        }
+    }
+
+    if (Y_h) {
+        memcpy32_avx(Y_h, h_buf[seq_len % 2], state_len);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -90,6 +90,10 @@ ppl::common::RetCode lstm_ref_fp32(
     }
     float *gate_buf = temp_buffer_fp32;
 
+    if (Y && sequence_lens) { // outputs beyond sequence_lens are zero
+        memset(Y, 0, seq_len * num_direction * batch * hidden_size * sizeof(float));
+    }
+
     for (int64_t nd = 0; nd < num_direction; ++nd) {
         const bool is_reverse = nd || (direction == rnn_direction::REVERSE);
 
@@ -107,7 +111,6 @@ ppl::common::RetCode lstm_ref_fp32(
         const float *nd_init_c = initial_c ? initial_c + nd * batch * hidden_size : nullptr;
 
         for (int64_t seq_idx = 0; seq_idx < seq_len; ++seq_idx) {
-            const int64_t mapped_seq_index = is_reverse ? (seq_len - seq_idx - 1) : seq_idx;
             const bool is_first_seq = seq_idx == 0;
 
             // X (seq_len, batch, input_size)
@@ -117,18 +120,28 @@ ppl::common::RetCode lstm_ref_fp32(
             // h_n (num_direction, batch, hidden_size)
             // c_n (num_direction, batch, hidden_size)
 
-            const float *sX = X + mapped_seq_index * batch * input_size;
             const float *Y_h_prev = is_first_seq ? nd_init_h : nd_Yh;
             const float *Y_c_prev = is_first_seq ? nd_init_c : nd_Yc;
-            float *sY = nd_Y + mapped_seq_index * num_direction * batch * hidden_size;
 
-            gemm_ref_fp32( // X[s]*W[nd]_{iofc}^T+Wb_{iofc}
-                sX, nd_W, nd_Wb, nullptr,
-                gemm_m_type::NOTRANS, gemm_m_type::TRANS,
-                gemm_v_type::ROW_VEC, gemm_m_type::EMPTY,
-                batch, rnn_num_gate::LSTM * hidden_size, input_size,
-                input_size, input_size, rnn_num_gate::LSTM * hidden_size, 0,
-                1.0f, 1.0f, gemm_post::NONE, gate_buf);
+            // reverse direction walks each row backward from its own sequence_lens
+            auto mapped_seq_index = [&](const int64_t b) {
+                const int64_t len = sequence_lens ? sequence_lens[b] : seq_len;
+                return is_reverse ? (len - seq_idx - 1) : seq_idx;
+            };
+
+            for (int64_t b = 0; b < batch; ++b) {
+                const int64_t sb = mapped_seq_index(b);
+                if (sb < 0) {
+                    continue;
+                }
+                gemm_ref_fp32( // X[s]*W[nd]_{iofc}^T+Wb_{iofc}
+                    X + (sb * batch + b) * input_size, nd_W, nd_Wb, nullptr,
+                    gemm_m_type::NOTRANS, gemm_m_type::TRANS,
+                    gemm_v_type::ROW_VEC, gemm_m_type::EMPTY,
+                    1, rnn_num_gate::LSTM * hidden_size, input_size,
+                    input_size, input_size, rnn_num_gate::LSTM * hidden_size, 0,
+                    1.0f, 1.0f, gemm_post::NONE, gate_buf + b * rnn_num_gate::LSTM * hidden_size);
+            }
 
             const float alpha = !Y_h_prev ? 0.0f : 1.0f; // some hack, gemm will skip aAxB if alpha is 0
             gemm_ref_fp32( // h_0[nd]*R[nd]_{iofc}^T+Rb_{iofc}
@@ -159,7 +172,7 @@ PRAGMA_OMP_PARALLEL_FOR()
                         const float *Cprev = Y_c_prev + b * hidden_size;
                         float *Ct = nd_Yc + b * hidden_size;
                         float *Ht = nd_Yh + b * hidden_size;
-                        float *Yt = sY + b * hidden_size;
+                        float *Yt = nd_Y + (mapped_seq_index(b) * num_direction * batch + b) * hidden_size;
                         for (int64_t h = 0; h < hidden_size; ++h) {
                             const float it = sigmoidf(gI[h]);
                             const float ft = sigmoidf(gF[h]);
@@ -194,7 +207,7 @@ PRAGMA_OMP_PARALLEL_FOR()
                         const float *Cprev = Y_c_prev + b * hidden_size;
                         float *Ct = nd_Yc + b * hidden_size;
                         float *Ht = nd_Yh + b * hidden_size;
-                        float *Yt = sY + b * hidden_size;
+                        float *Yt = nd_Y + (mapped_seq_index(b) * num_direction * batch + b) * hidden_size;
                         for (int64_t h = 0; h < hidden_size; ++h) {
                             const float it = sigmoidf(gI[h] + pI[h] * Cprev[h]);
                             const float ft = sigmoidf(gF[h] + pF[h] * Cprev[h]);
@@ -0,0 +1,76 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/mmcv_nms.h"
+#include "ppl/kernel/x86/fp32/mmcv_nms/mmcv_nms_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct mmcv_nms_fp32_avx512_suppressed {
+    inline bool operator()(
+        const mmcv_nms_fp32_boxes &selected,
+        const int64_t num_selected,
+        const float *box,
+        const float area,
+        const float iou_threshold,
+        const int64_t offset)
+    {
+        const int64_t simd_w = 16;
+        const __m512 v_x1 = _mm512_set1_ps(box[0]);
+        const __m512 v_y1 = _mm512_set1_ps(box[1]);
+        const __m512 v_x2 = _mm512_set1_ps(box[2]);
+        const __m512 v_y2 = _mm512_set1_ps(box[3]);
+        const __m512 v_area = _mm512_set1_ps(area);
+        const __m512 v_thr = _mm512_set1_ps(iou_threshold);
+        const __m512 v_offset = _mm512_set1_ps(offset);
+        const __m512 v_zero = _mm512_setzero_ps();
+
+        for (int64_t j = 0; j < num_selected; j += simd_w) {
+            const __mmask16 k_tail = j + simd_w <= num_selected ? 0xffff : (__mmask16)((1 << (num_selected - j)) - 1);
+            __m512 v_xx1 = _mm512_max_ps(v_x1, _mm512_maskz_loadu_ps(k_tail, selected.x1 + j));
+            __m512 v_yy1 = _mm512_max_ps(v_y1, _mm512_maskz_loadu_ps(k_tail, selected.y1 + j));
+            __m512 v_xx2 = _mm512_min_ps(v_x2, _mm512_maskz_loadu_ps(k_tail, selected.x2 + j));
+            __m512 v_yy2 = _mm512_min_ps(v_y2, _mm512_maskz_loadu_ps(k_tail, selected.y2 + j));
+
+            __m512 v_w = _mm512_max_ps(v_zero, _mm512_add_ps(_mm512_sub_ps(v_xx2, v_xx1), v_offset));
+            __m512 v_h = _mm512_max_ps(v_zero, _mm512_add_ps(_mm512_sub_ps(v_yy2, v_yy1), v_offset));
+
+            __m512 v_inter = _mm512_mul_ps(v_w, v_h);
+            __m512 v_ovr = _mm512_div_ps(v_inter, _mm512_sub_ps(_mm512_add_ps(v_area, _mm512_maskz_loadu_ps(k_tail, selected.area + j)), v_inter));
+            if (_mm512_mask_cmp_ps_mask(k_tail, v_ovr, v_thr, _CMP_GE_OQ)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+ppl::common::RetCode mmcv_nms_ndarray_fp32_avx512(
+        const float *boxes,
+        const float *scores,
+        const uint32_t num_boxes_in,
+        const float iou_threshold,
+        const int64_t offset,
+        int64_t *dst,
+        int64_t *num_boxes_out)
+{
+    return mmcv_nms_ndarray_fp32_impl<mmcv_nms_fp32_avx512_suppressed>(boxes, scores, num_boxes_in, iou_threshold, offset, dst, num_boxes_out);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_MMCV_NMS_MMCV_NMS_FP32_COMMON_H_
+#define __ST_PPL_KERNEL_X86_FP32_MMCV_NMS_MMCV_NMS_FP32_COMMON_H_
+
+#include <vector>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// selected boxes stored as separate arrays for simd
+struct mmcv_nms_fp32_boxes {
+    float *x1;
+    float *y1;
+    float *x2;
+    float *y2;
+    float *area;
+};
+
+/*
+   suppressed_func_t is a functor:
+   bool (const mmcv_nms_fp32_boxes &selected, const int64_t num_selected, const float *box, const float area, const float iou_threshold, const int64_t offset)
+   which returns true if iou of `box` and any of selected boxes is not less than `iou_threshold`.
+*/
+template <typename suppressed_func_t>
+ppl::common::RetCode mmcv_nms_ndarray_fp32_impl(
+        const float *boxes,
+        const float *scores,
+        const uint32_t num_boxes_in,
+        const float iou_threshold,
+        const int64_t offset,
+        int64_t *dst,
+        int64_t *num_boxes_out)
+{
+    std::vector<uint32_t> sorted_index_(num_boxes_in);
+    std::vector<float> areas_(num_boxes_in);
+    std::vector<float> selected_(num_boxes_in * 5);
+    uint32_t *sorted_index = sorted_index_.data();
+    float *areas = areas_.data();
+    mmcv_nms_fp32_boxes selected = {
+        selected_.data() + 0 * num_boxes_in,
+        selected_.data() + 1 * num_boxes_in,
+        selected_.data() + 2 * num_boxes_in,
+        selected_.data() + 3 * num_boxes_in,
+        selected_.data() + 4 * num_boxes_in,
+    };
+
+    for (uint32_t i = 0; i < num_boxes_in; i++) {
+        areas[i] = (boxes[i * 4 + 2] - boxes[i * 4 + 0] + offset) * (boxes[i * 4 + 3] - boxes[i * 4 + 1] + offset);
+    }
+    argsort(scores, sorted_index, num_boxes_in);
+
+    int64_t num_selected = 0;
+    for (uint32_t i = 0; i < num_boxes_in; i++) {
+        int64_t idx = sorted_index[i];
+        const float *box = boxes + idx * 4;
+        if (!suppressed_func_t()(selected, num_selected, box, areas[idx], iou_threshold, offset)) {
+            selected.x1[num_selected] = box[0];
+            selected.y1[num_selected] = box[1];
+            selected.x2[num_selected] = box[2];
+            selected.y2[num_selected] = box[3];
+            selected.area[num_selected] = areas[idx];
+            dst[num_selected++] = idx;
+        }
+    }
+
+    *num_boxes_out = num_selected;
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
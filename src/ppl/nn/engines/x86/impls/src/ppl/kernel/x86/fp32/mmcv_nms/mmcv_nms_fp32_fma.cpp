@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/mmcv_nms.h"
+#include "ppl/kernel/x86/fp32/mmcv_nms/mmcv_nms_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct mmcv_nms_fp32_fma_suppressed {
+    inline bool operator()(
+        const mmcv_nms_fp32_boxes &selected,
+        const int64_t num_selected,
+        const float *box,
+        const float area,
+        const float iou_threshold,
+        const int64_t offset)
+    {
+        const int64_t simd_w = 8;
+        const __m256 v_x1 = _mm256_set1_ps(box[0]);
+        const __m256 v_y1 = _mm256_set1_ps(box[1]);
+        const __m256 v_x2 = _mm256_set1_ps(box[2]);
+        const __m256 v_y2 = _mm256_set1_ps(box[3]);
+        const __m256 v_area = _mm256_set1_ps(area);
+        const __m256 v_thr = _mm256_set1_ps(iou_threshold);
+        const __m256 v_offset = _mm256_set1_ps(offset);
+        const __m256 v_zero = _mm256_setzero_ps();
+
+        int64_t j = 0;
+        for (; j + simd_w <= num_selected; j += simd_w) {
+            __m256 v_xx1 = _mm256_max_ps(v_x1, _mm256_loadu_ps(selected.x1 + j));
+            __m256 v_yy1 = _mm256_max_ps(v_y1, _mm256_loadu_ps(selected.y1 + j));
+            __m256 v_xx2 = _mm256_min_ps(v_x2, _mm256_loadu_ps(selected.x2 + j));
+            __m256 v_yy2 = _mm256_min_ps(v_y2, _mm256_loadu_ps(selected.y2 + j));
+
+            __m256 v_w = _mm256_max_ps(v_zero, _mm256_add_ps(_mm256_sub_ps(v_xx2, v_xx1), v_offset));
+            __m256 v_h = _mm256_max_ps(v_zero, _mm256_add_ps(_mm256_sub_ps(v_yy2, v_yy1), v_offset));
+
+            __m256 v_inter = _mm256_mul_ps(v_w, v_h);
+            __m256 v_ovr = _mm256_div_ps(v_inter, _mm256_sub_ps(_mm256_add_ps(v_area, _mm256_loadu_ps(selected.area + j)), v_inter));
+            if (_mm256_movemask_ps(_mm256_cmp_ps(v_ovr, v_thr, _CMP_GE_OQ))) {
+                return true;
+            }
+        }
+        for (; j < num_selected; j++) {
+            float xx1 = max(box[0], selected.x1[j]);
+            float yy1 = max(box[1], selected.y1[j]);
+            float xx2 = min(box[2], selected.x2[j]);
+            float yy2 = min(box[3], selected.y2[j]);
+
+            float w = max(0.f, xx2 - xx1 + offset);
+            float h = max(0.f, yy2 - yy1 + offset);
+
+            float inter = w * h;
+            float ovr = inter / (area + selected.area[j] - inter);
+            if (ovr >= iou_threshold) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+ppl::common::RetCode mmcv_nms_ndarray_fp32_fma(
+        const float *boxes,
+        const float *scores,
+        const uint32_t num_boxes_in,
+        const float iou_threshold,
+        const int64_t offset,
+        int64_t *dst,
+        int64_t *num_boxes_out)
+{
+    return mmcv_nms_ndarray_fp32_impl<mmcv_nms_fp32_fma_suppressed>(boxes, scores, num_boxes_in, iou_threshold, offset, dst, num_boxes_out);
+}
+
+}}}; // namespace ppl::kernel::x86
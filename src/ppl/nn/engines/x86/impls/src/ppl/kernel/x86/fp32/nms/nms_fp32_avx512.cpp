@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/nms/nms_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct nms_fp32_avx512_suppressed {
+    inline bool operator()(const nms_fp32_boxes &selected, const int64_t num_selected, const float *box, const float area, const float iou_threshold)
+    {
+        const int64_t simd_w = 16;
+        const __m512 v_x1    = _mm512_set1_ps(box[0]);
+        const __m512 v_y1    = _mm512_set1_ps(box[1]);
+        const __m512 v_x2    = _mm512_set1_ps(box[2]);
+        const __m512 v_y2    = _mm512_set1_ps(box[3]);
+        const __m512 v_area  = _mm512_set1_ps(area);
+        const __m512 v_thr   = _mm512_set1_ps(iou_threshold);
+        const __m512 v_zero  = _mm512_setzero_ps();
+
+        for (int64_t j = 0; j < num_selected; j += simd_w) {
+            const __mmask16 k_tail = j + simd_w <= num_selected ? 0xffff : (__mmask16)((1 << (num_selected - j)) - 1);
+            __m512 v_iw      = _mm512_sub_ps(_mm512_min_ps(v_x2, _mm512_maskz_loadu_ps(k_tail, selected.x2 + j)), _mm512_max_ps(v_x1, _mm512_maskz_loadu_ps(k_tail, selected.x1 + j)));
+            __m512 v_ih      = _mm512_sub_ps(_mm512_min_ps(v_y2, _mm512_maskz_loadu_ps(k_tail, selected.y2 + j)), _mm512_max_ps(v_y1, _mm512_maskz_loadu_ps(k_tail, selected.y1 + j)));
+            __mmask16 k_valid = _mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(v_iw, v_zero, _CMP_GT_OQ), v_ih, v_zero, _CMP_GT_OQ) & k_tail;
+            __m512 v_inter   = _mm512_mul_ps(v_iw, v_ih);
+            __m512 v_union   = _mm512_sub_ps(_mm512_add_ps(v_area, _mm512_maskz_loadu_ps(k_tail, selected.area + j)), v_inter);
+            __m512 v_iou     = _mm512_maskz_div_ps(k_valid, v_inter, v_union);
+            if (_mm512_mask_cmp_ps_mask(k_tail, v_iou, v_thr, _CMP_GT_OQ)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+ppl::common::RetCode nms_ndarray_fp32_avx512(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    int64_t *dst,
+    int64_t *num_boxes_out)
+{
+    return nms_ndarray_fp32_impl<nms_fp32_avx512_suppressed>(boxes, scores, num_boxes_in, batch, num_classes, center_point_box, max_output_boxes_per_batch_per_class, iou_threshold, score_threshold, dst, num_boxes_out);
+}
+
+}}}; // namespace ppl::kernel::x86
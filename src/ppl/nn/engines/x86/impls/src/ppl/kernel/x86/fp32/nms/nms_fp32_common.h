@@ -0,0 +1,163 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_NMS_NMS_FP32_COMMON_H_
+#define __ST_PPL_KERNEL_X86_FP32_NMS_NMS_FP32_COMMON_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// boxes in [x1, y1, x2, y2] corners with x1 <= x2 and y1 <= y2, stored as separate arrays for simd
+struct nms_fp32_boxes {
+    float *x1;
+    float *y1;
+    float *x2;
+    float *y2;
+    float *area;
+};
+
+/*
+   suppressed_func_t is a functor:
+   bool (const nms_fp32_boxes &selected, const int64_t num_selected, const float *box, const float area, const float iou_threshold)
+   which returns true if iou of `box` and any of selected boxes is greater than `iou_threshold`.
+*/
+template <typename suppressed_func_t>
+ppl::common::RetCode nms_ndarray_fp32_impl(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    int64_t *dst,
+    int64_t *num_boxes_out)
+{
+    *num_boxes_out = 0;
+    const int64_t max_selected = min<int64_t>(max_output_boxes_per_batch_per_class, num_boxes_in);
+    if (max_selected <= 0 || batch == 0 || num_classes == 0) {
+        return ppl::common::RC_SUCCESS;
+    }
+
+    // convert boxes to corners once for all classes
+    std::vector<float> corners(batch * num_boxes_in * 4);
+    std::vector<float> areas(batch * num_boxes_in);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t i = 0; i < (int64_t)batch * num_boxes_in; ++i) {
+        const float *b = boxes + i * 4;
+        float *p       = corners.data() + i * 4;
+        if (center_point_box) { // tf_format: [x_center, y_center, width, height]
+            p[0] = b[0] - b[2] / 2;
+            p[1] = b[1] - b[3] / 2;
+            p[2] = b[0] + b[2] / 2;
+            p[3] = b[1] + b[3] / 2;
+        } else { // pytorch_format: [y1, x1, y2, x2]
+            p[0] = min(b[1], b[3]);
+            p[1] = min(b[0], b[2]);
+            p[2] = max(b[1], b[3]);
+            p[3] = max(b[0], b[2]);
+        }
+        areas[i] = (p[2] - p[0]) * (p[3] - p[1]);
+    }
+
+    const int64_t num_tasks   = (int64_t)batch * num_classes;
+    const int64_t num_threads = PPL_OMP_MAX_THREADS();
+    std::vector<uint32_t> task_selected(num_tasks * max_selected);
+    std::vector<int64_t> task_num_selected(num_tasks);
+    std::vector<std::vector<uint32_t>> thread_candidates(num_threads);
+    std::vector<std::vector<float>> thread_selected_boxes(num_threads);
+
+    PRAGMA_OMP_PARALLEL_FOR_SCHEDULE(dynamic)
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        const int64_t thread_id = PPL_OMP_THREAD_ID();
+        const int64_t n         = t / num_classes;
+        const float *p_scores   = scores + t * num_boxes_in;
+        const float *p_corners  = corners.data() + n * num_boxes_in * 4;
+        const float *p_areas    = areas.data() + n * num_boxes_in;
+
+        // drop boxes under the threshold before ordering the rest
+        auto &candidates = thread_candidates[thread_id];
+        candidates.clear();
+        for (uint32_t i = 0; i < num_boxes_in; ++i) {
+            if (p_scores[i] > score_threshold) {
+                candidates.push_back(i);
+            }
+        }
+
+        auto &selected_buffer = thread_selected_boxes[thread_id];
+        selected_buffer.resize(max_selected * 5);
+        nms_fp32_boxes selected = {
+            selected_buffer.data() + 0 * max_selected,
+            selected_buffer.data() + 1 * max_selected,
+            selected_buffer.data() + 2 * max_selected,
+            selected_buffer.data() + 3 * max_selected,
+            selected_buffer.data() + 4 * max_selected,
+        };
+
+        // heap pops boxes in the order of a stable descending sort, so only the visited ones are ordered
+        auto lower_priority = [p_scores](const uint32_t a, const uint32_t b) {
+            return p_scores[a] < p_scores[b] || (p_scores[a] == p_scores[b] && a > b);
+        };
+        std::make_heap(candidates.begin(), candidates.end(), lower_priority);
+
+        uint32_t *p_selected_idx = task_selected.data() + t * max_selected;
+        int64_t num_selected     = 0;
+        auto heap_end            = candidates.end();
+        while (heap_end != candidates.begin() && num_selected < max_selected) {
+            std::pop_heap(candidates.begin(), heap_end, lower_priority);
+            --heap_end;
+            const uint32_t idx = *heap_end;
+            const float *box   = p_corners + idx * 4;
+            if (!suppressed_func_t()(selected, num_selected, box, p_areas[idx], iou_threshold)) {
+                selected.x1[num_selected]   = box[0];
+                selected.y1[num_selected]   = box[1];
+                selected.x2[num_selected]   = box[2];
+                selected.y2[num_selected]   = box[3];
+                selected.area[num_selected] = p_areas[idx];
+                p_selected_idx[num_selected] = idx;
+                ++num_selected;
+            }
+        }
+        task_num_selected[t] = num_selected;
+    }
+
+    // gather results in the order of batch and class
+    int64_t out_idx = 0;
+    for (int64_t t = 0; t < num_tasks; ++t) {
+        const uint32_t *p_selected_idx = task_selected.data() + t * max_selected;
+        for (int64_t i = 0; i < task_num_selected[t]; ++i) {
+            int64_t *p_dst = dst + out_idx * 3;
+            p_dst[0]       = t / num_classes;
+            p_dst[1]       = t % num_classes;
+            p_dst[2]       = p_selected_idx[i];
+            out_idx++;
+        }
+    }
+
+    *num_boxes_out = out_idx;
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
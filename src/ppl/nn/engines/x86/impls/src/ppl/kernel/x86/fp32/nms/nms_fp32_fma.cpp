@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/nms/nms_fp32_common.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+struct nms_fp32_fma_suppressed {
+    inline bool operator()(const nms_fp32_boxes &selected, const int64_t num_selected, const float *box, const float area, const float iou_threshold)
+    {
+        const int64_t simd_w = 8;
+        const __m256 v_x1    = _mm256_set1_ps(box[0]);
+        const __m256 v_y1    = _mm256_set1_ps(box[1]);
+        const __m256 v_x2    = _mm256_set1_ps(box[2]);
+        const __m256 v_y2    = _mm256_set1_ps(box[3]);
+        const __m256 v_area  = _mm256_set1_ps(area);
+        const __m256 v_thr   = _mm256_set1_ps(iou_threshold);
+        const __m256 v_zero  = _mm256_setzero_ps();
+
+        int64_t j = 0;
+        for (; j + simd_w <= num_selected; j += simd_w) {
+            __m256 v_iw    = _mm256_sub_ps(_mm256_min_ps(v_x2, _mm256_loadu_ps(selected.x2 + j)), _mm256_max_ps(v_x1, _mm256_loadu_ps(selected.x1 + j)));
+            __m256 v_ih    = _mm256_sub_ps(_mm256_min_ps(v_y2, _mm256_loadu_ps(selected.y2 + j)), _mm256_max_ps(v_y1, _mm256_loadu_ps(selected.y1 + j)));
+            __m256 v_valid = _mm256_and_ps(_mm256_cmp_ps(v_iw, v_zero, _CMP_GT_OQ), _mm256_cmp_ps(v_ih, v_zero, _CMP_GT_OQ));
+            __m256 v_inter = _mm256_mul_ps(v_iw, v_ih);
+            __m256 v_union = _mm256_sub_ps(_mm256_add_ps(v_area, _mm256_loadu_ps(selected.area + j)), v_inter);
+            __m256 v_iou   = _mm256_and_ps(v_valid, _mm256_div_ps(v_inter, v_union));
+            if (_mm256_movemask_ps(_mm256_cmp_ps(v_iou, v_thr, _CMP_GT_OQ))) {
+                return true;
+            }
+        }
+        for (; j < num_selected; j++) {
+            const float iw = min(box[2], selected.x2[j]) - max(box[0], selected.x1[j]);
+            const float ih = min(box[3], selected.y2[j]) - max(box[1], selected.y1[j]);
+            float iou      = 0.0f;
+            if (iw > 0 && ih > 0) {
+                const float inter = iw * ih;
+                iou               = inter / (area + selected.area[j] - inter);
+            }
+            if (iou > iou_threshold) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+ppl::common::RetCode nms_ndarray_fp32_fma(
+    const float *boxes,
+    const float *scores,
+    const uint32_t num_boxes_in,
+    const uint32_t batch,
+    const uint32_t num_classes,
+    const bool center_point_box,
+    const int64_t max_output_boxes_per_batch_per_class,
+    const float iou_threshold,
+    const float score_threshold,
+    int64_t *dst,
+    int64_t *num_boxes_out)
+{
+    return nms_ndarray_fp32_impl<nms_fp32_fma_suppressed>(boxes, scores, num_boxes_in, batch, num_classes, center_point_box, max_output_boxes_per_batch_per_class, iou_threshold, score_threshold, dst, num_boxes_out);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/fp32/rnn.h"
+#include "ppl/kernel/x86/fp32/rnn/rnn_kernel_fp32_fma.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+uint64_t rnn_fp32_fma_get_packed_recurrent_weight_bytes(
+    const rnn_direction_t direction,
+    const int64_t num_gate,
+    const int64_t hidden_size)
+{
+    const int64_t H_BLK = rnn_kernel_fp32_fma::H_BLK;
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    return num_direction * round_up(hidden_size, H_BLK) * num_gate * hidden_size * sizeof(float);
+}
+
+ppl::common::RetCode rnn_fp32_fma_pack_recurrent_weight(
+    const float *R_weight,
+    const rnn_direction_t direction,
+    const int64_t num_gate,
+    const int64_t hidden_size,
+    float *packed_R_weight)
+{
+    const int64_t H_BLK = rnn_kernel_fp32_fma::H_BLK;
+    const int64_t num_direction = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t padded_hidden = round_up(hidden_size, H_BLK);
+
+    // R[nd, g * H + h, k] => packed_R[nd, h / 8, k, g, h % 8]
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < num_direction * padded_hidden / H_BLK; ++t) {
+        const int64_t nd = t / (padded_hidden / H_BLK);
+        const int64_t hb = (t % (padded_hidden / H_BLK)) * H_BLK;
+        const int64_t hb_eff = min(H_BLK, hidden_size - hb);
+        const float *nd_R = R_weight + nd * num_gate * hidden_size * hidden_size;
+        float *dst = packed_R_weight + nd * padded_hidden * num_gate * hidden_size + hb * num_gate * hidden_size;
+        for (int64_t k = 0; k < hidden_size; ++k) {
+            for (int64_t g = 0; g < num_gate; ++g) {
+                for (int64_t h = 0; h < hb_eff; ++h) {
+                    dst[h] = nd_R[(g * hidden_size + hb + h) * hidden_size + k];
+                }
+                for (int64_t h = hb_eff; h < H_BLK; ++h) {
+                    dst[h] = 0.0f;
+                }
+                dst += H_BLK;
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
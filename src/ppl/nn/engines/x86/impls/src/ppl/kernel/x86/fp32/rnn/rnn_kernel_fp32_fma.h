@@ -0,0 +1,90 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_FP32_RNN_RNN_KERNEL_FP32_FMA_H_
+#define __ST_PPL_KERNEL_X86_FP32_RNN_RNN_KERNEL_FP32_FMA_H_
+
+#include <immintrin.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+class rnn_kernel_fp32_fma {
+public:
+    static const int64_t H_BLK = 8; // hidden units of a packed panel
+    static const int64_t MAX_B_BLK = 3; // batch rows of a tile, MAX_B_BLK * 4 gates + MAX_B_BLK + 1 <= 16 ymm
+};
+
+// acc[b][g] = sum_k(h[b, k] * packed_R[k, G_BEGIN + g, :]) for a panel of packed recurrent weights
+template <int64_t B_LEN, int64_t NUM_GATE, int64_t G_BEGIN, int64_t G_LEN>
+inline void rnn_recurrent_kernel_fp32_fma(
+    const float *h,
+    const int64_t ldh,
+    const float *packed_R,
+    const int64_t K,
+    __m256 acc[B_LEN][G_LEN])
+{
+    const int64_t H_BLK = rnn_kernel_fp32_fma::H_BLK;
+    for (int64_t b = 0; b < B_LEN; ++b) {
+        for (int64_t g = 0; g < G_LEN; ++g) {
+            acc[b][g] = _mm256_setzero_ps();
+        }
+    }
+
+    const float *w = packed_R + G_BEGIN * H_BLK;
+    for (int64_t k = 0; k < K; ++k) {
+        __m256 hv[B_LEN];
+        for (int64_t b = 0; b < B_LEN; ++b) {
+            hv[b] = _mm256_broadcast_ss(h + b * ldh + k);
+        }
+        for (int64_t g = 0; g < G_LEN; ++g) {
+            const __m256 wv = _mm256_loadu_ps(w + g * H_BLK);
+            for (int64_t b = 0; b < B_LEN; ++b) {
+                acc[b][g] = _mm256_fmadd_ps(hv[b], wv, acc[b][g]);
+            }
+        }
+        w += NUM_GATE * H_BLK;
+    }
+}
+
+// loads and stores the (maybe partial) 8 hidden units of a panel
+class rnn_h_blk_io_fp32_fma {
+public:
+    rnn_h_blk_io_fp32_fma(const int64_t len) : full_(len == rnn_kernel_fp32_fma::H_BLK) {
+        static const int32_t mask_table[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+        mask_ = _mm256_loadu_si256((const __m256i*)(mask_table + rnn_kernel_fp32_fma::H_BLK - len));
+    }
+    inline __m256 load(const float *src) const {
+        return full_ ? _mm256_loadu_ps(src) : _mm256_maskload_ps(src, mask_);
+    }
+    inline void store(float *dst, const __m256 v) const {
+        if (full_) {
+            _mm256_storeu_ps(dst, v);
+        } else {
+            _mm256_maskstore_ps(dst, mask_, v);
+        }
+    }
+
+private:
+    bool full_;
+    __m256i mask_;
+};
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_COMMON_QUANT_INT8_H_
+#define __ST_PPL_KERNEL_X86_INT8_COMMON_QUANT_INT8_H_
+
+#include <math.h>
+
+#include "ppl/kernel/x86/common/internal_include.h"
+#include "ppl/kernel/x86/int8/gemm_s8u8.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+inline int32_t quant_s8(const float x, const float inv_scale)
+{
+    float v = x * inv_scale;
+    v       = v < -127.0f ? -127.0f : (v > 127.0f ? 127.0f : v);
+    return (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+// symmetric scale of one output channel, zero channel gets scale 0 and all zero codes
+inline float quant_s8_channel_scale(const float *w, const int64_t len)
+{
+    float amax = 0.0f;
+    for (int64_t i = 0; i < len; ++i) {
+        amax = max(amax, fabsf(w[i]));
+    }
+    return amax / 127.0f;
+}
+
+inline float quant_s8_inv_scale(const float scale)
+{
+    return scale > 0.0f ? 1.0f / scale : 0.0f;
+}
+
+inline gemm_s8u8_post_t quant_s8_post_flag(const bool relu, const bool relu6)
+{
+    if (relu6) return gemm_s8u8_post::RELU6;
+    if (relu) return gemm_s8u8_post::RELU;
+    return gemm_s8u8_post::NONE;
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
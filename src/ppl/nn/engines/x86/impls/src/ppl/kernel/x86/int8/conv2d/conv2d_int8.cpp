@@ -0,0 +1,196 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/conv2d.h"
+#include "ppl/kernel/x86/int8/common/quant_int8.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+static inline int64_t conv2d_int8_kernel_k(const conv2d_int8_param &param)
+{
+    return param.channels / param.group * param.kernel_h * param.kernel_w;
+}
+
+ppl::common::RetCode conv2d_int8_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_buffer_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t oc  = param_.num_output;
+    const int64_t K   = conv2d_int8_kernel_k(param_);
+    const int64_t lda = gemm_s8u8_k4(K) * 4;
+
+    const uint64_t filter_bytes = round_up(oc * lda, PPL_X86_CACHELINE_BYTES());
+    const uint64_t vec_bytes    = round_up(oc * (int64_t)sizeof(float), PPL_X86_CACHELINE_BYTES());
+    cvt_buffer_                 = allocator_->Alloc(filter_bytes + 3 * vec_bytes);
+    if (cvt_buffer_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    cvt_filter_    = (int8_t *)cvt_buffer_;
+    filter_rowsum_ = (int32_t *)((uint8_t *)cvt_buffer_ + filter_bytes);
+    filter_scale_  = (float *)((uint8_t *)cvt_buffer_ + filter_bytes + vec_bytes);
+    cvt_bias_      = (float *)((uint8_t *)cvt_buffer_ + filter_bytes + 2 * vec_bytes);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t o = 0; o < oc; ++o) {
+        const float *w      = filter + o * K;
+        const float scale   = quant_s8_channel_scale(w, K);
+        const float inv     = quant_s8_inv_scale(scale);
+        int8_t *q           = cvt_filter_ + o * lda;
+        int32_t sum         = 0;
+        for (int64_t k = 0; k < K; ++k) {
+            q[k] = (int8_t)quant_s8(w[k], inv);
+            sum += q[k];
+        }
+        memset(q + K, 0, lda - K);
+        filter_rowsum_[o] = sum;
+        filter_scale_[o]  = scale;
+        cvt_bias_[o]      = bias ? bias[o] : 0.0f;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+void conv2d_int8_manager::release_cvt_weights()
+{
+    if (cvt_buffer_) {
+        allocator_->Free(cvt_buffer_);
+        cvt_buffer_    = nullptr;
+        cvt_filter_    = nullptr;
+        filter_rowsum_ = nullptr;
+        filter_scale_  = nullptr;
+        cvt_bias_      = nullptr;
+    }
+}
+
+uint64_t conv2d_int8_manager::cal_temp_buffer_size(
+    const ppl::nn::TensorShape &src_shape,
+    const ppl::nn::TensorShape &dst_shape) const
+{
+    const int64_t dst_hw = dst_shape.GetDim(2) * dst_shape.GetDim(3);
+    return gemm_s8u8_k4(conv2d_int8_kernel_k(param_)) * gemm_s8u8_ldb(dst_hw) * 4 + PPL_X86_CACHELINE_BYTES();
+}
+
+// unfold one group of one image into the packed u8 B layout of gemm_s8u8, quantizing on the fly
+static void conv2d_int8_im2col_quant(
+    const conv2d_int8_param &param,
+    const float *src,
+    const int64_t src_h,
+    const int64_t src_w,
+    const int64_t dst_h,
+    const int64_t dst_w,
+    const int64_t K,
+    const int64_t K4,
+    const int64_t ldb,
+    uint8_t *B)
+{
+    const int64_t kernel_hw = param.kernel_h * param.kernel_w;
+    const int64_t dst_hw    = dst_h * dst_w;
+    const float inv_scale   = quant_s8_inv_scale(param.src_scale);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t k4 = 0; k4 < K4; ++k4) {
+        uint8_t *b = B + k4 * ldb * 4;
+        for (int64_t j = 0; j < 4; ++j) {
+            const int64_t k = k4 * 4 + j;
+            if (k >= K) {
+                for (int64_t n = 0; n < ldb; ++n) {
+                    b[n * 4 + j] = 128;
+                }
+                continue;
+            }
+            const int64_t ic     = k / kernel_hw;
+            const int64_t ky     = k % kernel_hw / param.kernel_w;
+            const int64_t kx     = k % param.kernel_w;
+            const float *src_c   = src + ic * src_h * src_w;
+            int64_t n            = 0;
+            for (int64_t oh = 0; oh < dst_h; ++oh) {
+                const int64_t ih = oh * param.stride_h - param.pad_h + ky * param.dilation_h;
+                for (int64_t ow = 0; ow < dst_w; ++ow, ++n) {
+                    const int64_t iw = ow * param.stride_w - param.pad_w + kx * param.dilation_w;
+                    uint8_t v        = 128;
+                    if (ih >= 0 && ih < src_h && iw >= 0 && iw < src_w) {
+                        v = (uint8_t)(quant_s8(src_c[ih * src_w + iw], inv_scale) + 128);
+                    }
+                    b[n * 4 + j] = v;
+                }
+            }
+            for (n = dst_hw; n < ldb; ++n) {
+                b[n * 4 + j] = 128;
+            }
+        }
+    }
+}
+
+ppl::common::RetCode conv2d_int8_manager::execute(
+    const ppl::nn::TensorShape &src_shape,
+    const float *src,
+    const ppl::nn::TensorShape &dst_shape,
+    float *dst,
+    void *temp_buffer) const
+{
+    if (cvt_buffer_ == nullptr || src == nullptr || dst == nullptr || temp_buffer == nullptr) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const int64_t batch  = src_shape.GetDim(0);
+    const int64_t src_h  = src_shape.GetDim(2);
+    const int64_t src_w  = src_shape.GetDim(3);
+    const int64_t dst_h  = dst_shape.GetDim(2);
+    const int64_t dst_w  = dst_shape.GetDim(3);
+    const int64_t dst_hw = dst_h * dst_w;
+    const int64_t ic_g   = param_.channels / param_.group;
+    const int64_t oc_g   = param_.num_output / param_.group;
+    const int64_t K      = conv2d_int8_kernel_k(param_);
+    const int64_t K4     = gemm_s8u8_k4(K);
+    const int64_t lda    = K4 * 4;
+    const int64_t ldb    = gemm_s8u8_ldb(dst_hw);
+
+    uint8_t *B = (uint8_t *)round_up((uintptr_t)temp_buffer, PPL_X86_CACHELINE_BYTES());
+
+    const bool relu  = (param_.fuse_flag & conv_fuse_flag::RELU) != 0;
+    const bool relu6 = (param_.fuse_flag & conv_fuse_flag::RELU6) != 0;
+
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t g = 0; g < param_.group; ++g) {
+            const float *src_g = src + (b * param_.channels + g * ic_g) * src_h * src_w;
+            float *dst_g       = dst + (b * param_.num_output + g * oc_g) * dst_hw;
+            conv2d_int8_im2col_quant(param_, src_g, src_h, src_w, dst_h, dst_w, K, K4, ldb, B);
+
+            gemm_s8u8_post_param post;
+            post.m_scale = filter_scale_ + g * oc_g;
+            post.n_scale = nullptr;
+            post.m_bias  = cvt_bias_ + g * oc_g;
+            post.n_bias  = nullptr;
+            post.alpha   = param_.src_scale;
+            post.post    = quant_s8_post_flag(relu, relu6);
+
+            auto rc = gemm_s8u8(isa_, cvt_filter_ + g * oc_g * lda, lda, filter_rowsum_ + g * oc_g, B, ldb,
+                                oc_g, dst_hw, K4, post, dst_g, dst_hw);
+            if (rc != ppl::common::RC_SUCCESS) {
+                return rc;
+            }
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
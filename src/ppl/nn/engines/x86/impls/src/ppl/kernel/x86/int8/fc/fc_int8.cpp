@@ -0,0 +1,124 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/fc.h"
+#include "ppl/kernel/x86/int8/common/quant_int8.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+ppl::common::RetCode fc_int8_manager::gen_cvt_weights(const float *filter, const float *bias)
+{
+    if (cvt_buffer_ != nullptr) {
+        return ppl::common::RC_PERMISSION_DENIED;
+    }
+
+    const int64_t N   = param_.num_output;
+    const int64_t K   = param_.channels;
+    const int64_t K4  = gemm_s8u8_k4(K);
+    const int64_t ldb = gemm_s8u8_ldb(N);
+
+    const uint64_t filter_bytes = round_up(K4 * ldb * 4, PPL_X86_CACHELINE_BYTES());
+    const uint64_t vec_bytes    = round_up(ldb * (int64_t)sizeof(float), PPL_X86_CACHELINE_BYTES());
+    cvt_buffer_                 = allocator_->Alloc(filter_bytes + 2 * vec_bytes);
+    if (cvt_buffer_ == nullptr) {
+        return ppl::common::RC_OUT_OF_MEMORY;
+    }
+    cvt_filter_   = (uint8_t *)cvt_buffer_;
+    filter_scale_ = (float *)((uint8_t *)cvt_buffer_ + filter_bytes);
+    cvt_bias_     = (float *)((uint8_t *)cvt_buffer_ + filter_bytes + vec_bytes);
+
+    memset(cvt_filter_, 128, K4 * ldb * 4);
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t n = 0; n < N; ++n) {
+        const float *w    = filter + n * K;
+        const float scale = quant_s8_channel_scale(w, K);
+        const float inv   = quant_s8_inv_scale(scale);
+        for (int64_t k = 0; k < K; ++k) {
+            cvt_filter_[((k / 4) * ldb + n) * 4 + k % 4] = (uint8_t)(quant_s8(w[k], inv) + 128);
+        }
+        filter_scale_[n] = scale;
+        cvt_bias_[n]     = bias ? bias[n] : 0.0f;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+void fc_int8_manager::release_cvt_weights()
+{
+    if (cvt_buffer_) {
+        allocator_->Free(cvt_buffer_);
+        cvt_buffer_   = nullptr;
+        cvt_filter_   = nullptr;
+        filter_scale_ = nullptr;
+        cvt_bias_     = nullptr;
+    }
+}
+
+uint64_t fc_int8_manager::cal_temp_buffer_size(const ppl::nn::TensorShape &src_shape) const
+{
+    const int64_t M   = src_shape.GetDim(0);
+    const int64_t lda = gemm_s8u8_k4(param_.channels) * 4;
+    return round_up(M * lda, PPL_X86_CACHELINE_BYTES()) + M * sizeof(int32_t) + PPL_X86_CACHELINE_BYTES();
+}
+
+ppl::common::RetCode fc_int8_manager::execute(
+    const ppl::nn::TensorShape &src_shape,
+    const float *src,
+    float *dst,
+    void *temp_buffer) const
+{
+    if (cvt_buffer_ == nullptr || src == nullptr || dst == nullptr || temp_buffer == nullptr) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const int64_t M   = src_shape.GetDim(0);
+    const int64_t N   = param_.num_output;
+    const int64_t K   = param_.channels;
+    const int64_t K4  = gemm_s8u8_k4(K);
+    const int64_t lda = K4 * 4;
+
+    int8_t *A        = (int8_t *)round_up((uintptr_t)temp_buffer, PPL_X86_CACHELINE_BYTES());
+    int32_t *rowsum  = (int32_t *)(A + round_up(M * lda, PPL_X86_CACHELINE_BYTES()));
+    const float inv  = quant_s8_inv_scale(param_.src_scale);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t m = 0; m < M; ++m) {
+        const float *x = src + m * K;
+        int8_t *a      = A + m * lda;
+        int32_t sum    = 0;
+        for (int64_t k = 0; k < K; ++k) {
+            a[k] = (int8_t)quant_s8(x[k], inv);
+            sum += a[k];
+        }
+        memset(a + K, 0, lda - K);
+        rowsum[m] = sum;
+    }
+
+    gemm_s8u8_post_param post;
+    post.m_scale = nullptr;
+    post.n_scale = filter_scale_;
+    post.m_bias  = nullptr;
+    post.n_bias  = cvt_bias_;
+    post.alpha   = param_.src_scale;
+    post.post    = quant_s8_post_flag((param_.fuse_flag & fc_fuse_flag::RELU) != 0, false);
+
+    return gemm_s8u8(isa_, A, lda, rowsum, cvt_filter_, gemm_s8u8_ldb(N), M, N, K4, post, dst, N);
+}
+
+}}}; // namespace ppl::kernel::x86
@@ -0,0 +1,121 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/gemm_s8u8/gemm_s8u8_kernel.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// lanes run along n, 8 columns x 4 k per 32 bytes of B. u8 and s8 are widened
+// to s16 and multiplied by vpmaddwd, which keeps every product exact.
+template <int32_t MT>
+static inline void gemm_s8u8_avx2_mtx8(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t n_eff,
+    const int64_t K4,
+    const gemm_s8u8_post_param &p,
+    const int64_t m0,
+    const int64_t n0,
+    float *C,
+    const int64_t ldc)
+{
+    __m256i acc_lo[MT], acc_hi[MT];
+    for (int32_t m = 0; m < MT; ++m) {
+        acc_lo[m] = _mm256_setzero_si256();
+        acc_hi[m] = _mm256_setzero_si256();
+    }
+
+    const int64_t b_step = ldb * 4;
+    for (int64_t k4 = 0; k4 < K4; ++k4) {
+        const __m256i b    = _mm256_loadu_si256((const __m256i *)(B + k4 * b_step));
+        const __m256i b_lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b));
+        const __m256i b_hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(b, 1));
+        for (int32_t m = 0; m < MT; ++m) {
+            int32_t a4;
+            memcpy(&a4, A + m * lda + k4 * 4, sizeof(a4));
+            const __m256i a = _mm256_cvtepi8_epi16(_mm_set1_epi32(a4));
+            acc_lo[m]       = _mm256_add_epi32(acc_lo[m], _mm256_madd_epi16(b_lo, a));
+            acc_hi[m]       = _mm256_add_epi32(acc_hi[m], _mm256_madd_epi16(b_hi, a));
+        }
+    }
+
+    const __m256i lane     = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i mask     = _mm256_cmpgt_epi32(_mm256_set1_epi32((int32_t)n_eff), lane);
+    const __m256i perm_idx = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+
+    __m256 n_scale = _mm256_set1_ps(1.0f);
+    __m256 n_bias  = _mm256_setzero_ps();
+    if (p.n_scale) n_scale = _mm256_maskload_ps(p.n_scale + n0, mask);
+    if (p.n_bias) n_bias = _mm256_maskload_ps(p.n_bias + n0, mask);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 six  = _mm256_set1_ps(6.0f);
+
+    for (int32_t m = 0; m < MT; ++m) {
+        __m256i s = _mm256_permutevar8x32_epi32(_mm256_hadd_epi32(acc_lo[m], acc_hi[m]), perm_idx);
+        s         = _mm256_sub_epi32(s, _mm256_set1_epi32(128 * rowsum_a[m]));
+
+        float scale = p.alpha;
+        if (p.m_scale) scale *= p.m_scale[m0 + m];
+        __m256 v = _mm256_mul_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(s), _mm256_set1_ps(scale)), n_scale);
+        v        = _mm256_add_ps(v, n_bias);
+        if (p.m_bias) v = _mm256_add_ps(v, _mm256_set1_ps(p.m_bias[m0 + m]));
+        if (p.post & (gemm_s8u8_post::RELU | gemm_s8u8_post::RELU6)) v = _mm256_max_ps(v, zero);
+        if (p.post & gemm_s8u8_post::RELU6) v = _mm256_min_ps(v, six);
+
+        if (n_eff == 8) {
+            _mm256_storeu_ps(C + m * ldc, v);
+        } else {
+            _mm256_maskstore_ps(C + m * ldc, mask, v);
+        }
+    }
+}
+
+void gemm_s8u8_kernel_int8_avx2(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    const int64_t m_tile = 4;
+    const int64_t n_tile = 8;
+    for (int64_t n = 0; n < N; n += n_tile) {
+        const int64_t n_eff = min<int64_t>(N - n, n_tile);
+        const uint8_t *b    = B + n * 4;
+        int64_t m           = 0;
+        for (; m + m_tile <= M; m += m_tile) {
+            gemm_s8u8_avx2_mtx8<4>(A + m * lda, lda, rowsum_a + m, b, ldb, n_eff, K4, post_param, m, n, C + m * ldc + n, ldc);
+        }
+        for (; m < M; ++m) {
+            gemm_s8u8_avx2_mtx8<1>(A + m * lda, lda, rowsum_a + m, b, ldb, n_eff, K4, post_param, m, n, C + m * ldc + n, ldc);
+        }
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
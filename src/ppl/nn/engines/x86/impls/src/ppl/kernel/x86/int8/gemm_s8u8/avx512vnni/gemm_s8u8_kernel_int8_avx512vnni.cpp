@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <immintrin.h>
+#include <string.h>
+
+#include "ppl/kernel/x86/int8/gemm_s8u8/gemm_s8u8_kernel.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// lanes run along n, 16 columns x 4 k per zmm of B, accumulated by vpdpbusd.
+template <int32_t MT>
+static inline void gemm_s8u8_avx512vnni_mtx32(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t n_eff,
+    const int64_t K4,
+    const gemm_s8u8_post_param &p,
+    const int64_t m0,
+    const int64_t n0,
+    float *C,
+    const int64_t ldc)
+{
+    __m512i acc0[MT], acc1[MT];
+    for (int32_t m = 0; m < MT; ++m) {
+        acc0[m] = _mm512_setzero_si512();
+        acc1[m] = _mm512_setzero_si512();
+    }
+
+    const int64_t b_step = ldb * 4;
+    for (int64_t k4 = 0; k4 < K4; ++k4) {
+        const __m512i b0 = _mm512_loadu_si512((const void *)(B + k4 * b_step));
+        const __m512i b1 = _mm512_loadu_si512((const void *)(B + k4 * b_step + 64));
+        for (int32_t m = 0; m < MT; ++m) {
+            int32_t a4;
+            memcpy(&a4, A + m * lda + k4 * 4, sizeof(a4));
+            const __m512i a = _mm512_set1_epi32(a4);
+            acc0[m]         = _mm512_dpbusd_epi32(acc0[m], b0, a);
+            acc1[m]         = _mm512_dpbusd_epi32(acc1[m], b1, a);
+        }
+    }
+
+    const __mmask16 mask0 = n_eff >= 16 ? (__mmask16)0xffff : (__mmask16)((1u << n_eff) - 1);
+    const __mmask16 mask1 = n_eff >= 32 ? (__mmask16)0xffff : (n_eff > 16 ? (__mmask16)((1u << (n_eff - 16)) - 1) : (__mmask16)0);
+
+    __m512 n_scale0 = _mm512_set1_ps(1.0f);
+    __m512 n_scale1 = _mm512_set1_ps(1.0f);
+    __m512 n_bias0  = _mm512_setzero_ps();
+    __m512 n_bias1  = _mm512_setzero_ps();
+    if (p.n_scale) {
+        n_scale0 = _mm512_maskz_loadu_ps(mask0, p.n_scale + n0);
+        n_scale1 = _mm512_maskz_loadu_ps(mask1, p.n_scale + n0 + 16);
+    }
+    if (p.n_bias) {
+        n_bias0 = _mm512_maskz_loadu_ps(mask0, p.n_bias + n0);
+        n_bias1 = _mm512_maskz_loadu_ps(mask1, p.n_bias + n0 + 16);
+    }
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 six  = _mm512_set1_ps(6.0f);
+
+    for (int32_t m = 0; m < MT; ++m) {
+        const __m512i shift = _mm512_set1_epi32(128 * rowsum_a[m]);
+        float scale         = p.alpha;
+        if (p.m_scale) scale *= p.m_scale[m0 + m];
+        const __m512 vscale = _mm512_set1_ps(scale);
+
+        __m512 v0 = _mm512_mul_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(acc0[m], shift)), vscale), n_scale0);
+        __m512 v1 = _mm512_mul_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_sub_epi32(acc1[m], shift)), vscale), n_scale1);
+        v0        = _mm512_add_ps(v0, n_bias0);
+        v1        = _mm512_add_ps(v1, n_bias1);
+        if (p.m_bias) {
+            const __m512 m_bias = _mm512_set1_ps(p.m_bias[m0 + m]);
+            v0                  = _mm512_add_ps(v0, m_bias);
+            v1                  = _mm512_add_ps(v1, m_bias);
+        }
+        if (p.post & (gemm_s8u8_post::RELU | gemm_s8u8_post::RELU6)) {
+            v0 = _mm512_max_ps(v0, zero);
+            v1 = _mm512_max_ps(v1, zero);
+        }
+        if (p.post & gemm_s8u8_post::RELU6) {
+            v0 = _mm512_min_ps(v0, six);
+            v1 = _mm512_min_ps(v1, six);
+        }
+
+        if (n_eff == 32) {
+            _mm512_storeu_ps(C + m * ldc, v0);
+            _mm512_storeu_ps(C + m * ldc + 16, v1);
+        } else {
+            _mm512_mask_storeu_ps(C + m * ldc, mask0, v0);
+            _mm512_mask_storeu_ps(C + m * ldc + 16, mask1, v1);
+        }
+    }
+}
+
+void gemm_s8u8_kernel_int8_avx512vnni(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    const int64_t m_tile = 4;
+    const int64_t n_tile = 32;
+    for (int64_t n = 0; n < N; n += n_tile) {
+        const int64_t n_eff = min<int64_t>(N - n, n_tile);
+        const uint8_t *b    = B + n * 4;
+        int64_t m           = 0;
+        for (; m + m_tile <= M; m += m_tile) {
+            gemm_s8u8_avx512vnni_mtx32<4>(A + m * lda, lda, rowsum_a + m, b, ldb, n_eff, K4, post_param, m, n, C + m * ldc + n, ldc);
+        }
+        for (; m < M; ++m) {
+            gemm_s8u8_avx512vnni_mtx32<1>(A + m * lda, lda, rowsum_a + m, b, ldb, n_eff, K4, post_param, m, n, C + m * ldc + n, ldc);
+        }
+    }
+}
+
+}}}; // namespace ppl::kernel::x86
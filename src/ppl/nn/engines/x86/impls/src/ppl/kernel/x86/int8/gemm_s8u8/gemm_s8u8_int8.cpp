@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/kernel/x86/int8/gemm_s8u8/gemm_s8u8_kernel.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+gemm_s8u8_isa_t gemm_s8u8_select_isa(const ppl::common::isa_t isa_flags)
+{
+#ifdef PPL_USE_X86_AVX512
+    if ((isa_flags & ppl::common::ISA_X86_AVX512) && cpu_supports_avx512vnni()) {
+        return gemm_s8u8_isa::AVX512VNNI;
+    }
+#endif
+    if ((isa_flags & ppl::common::ISA_X86_FMA) && cpu_supports_avx2()) {
+        return gemm_s8u8_isa::AVX2;
+    }
+    return gemm_s8u8_isa::REF;
+}
+
+void gemm_s8u8_kernel_int8_ref(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    for (int64_t m = 0; m < M; ++m) {
+        const int8_t *a = A + m * lda;
+        for (int64_t n = 0; n < N; ++n) {
+            int32_t acc = 0;
+            for (int64_t k4 = 0; k4 < K4; ++k4) {
+                const uint8_t *b = B + (k4 * ldb + n) * 4;
+                acc += a[k4 * 4 + 0] * b[0] + a[k4 * 4 + 1] * b[1] + a[k4 * 4 + 2] * b[2] + a[k4 * 4 + 3] * b[3];
+            }
+            acc -= 128 * rowsum_a[m];
+            C[m * ldc + n] = gemm_s8u8_post_scalar(acc, m, n, post_param);
+        }
+    }
+}
+
+ppl::common::RetCode gemm_s8u8(
+    const gemm_s8u8_isa_t isa,
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc)
+{
+    if ((lda & 3) || ldb < N || (ldb & 31)) {
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    gemm_s8u8_kernel_func_t kernel = gemm_s8u8_kernel_int8_ref;
+#ifdef PPL_USE_X86_AVX512
+    if (isa == gemm_s8u8_isa::AVX512VNNI) {
+        kernel = gemm_s8u8_kernel_int8_avx512vnni;
+    }
+#endif
+    if (isa == gemm_s8u8_isa::AVX2) {
+        kernel = gemm_s8u8_kernel_int8_avx2;
+    }
+
+    const int64_t m_blk = 32;
+    const int64_t num_threads = PPL_OMP_MAX_THREADS();
+    const int64_t m_tasks = div_up(M, m_blk);
+    int64_t n_blk = 256;
+    while (n_blk > 32 && m_tasks * div_up(N, n_blk) < num_threads * 4) {
+        n_blk /= 2;
+    }
+    const int64_t n_tasks = div_up(N, n_blk);
+
+    PRAGMA_OMP_PARALLEL_FOR()
+    for (int64_t t = 0; t < m_tasks * n_tasks; ++t) {
+        const int64_t m0 = (t / n_tasks) * m_blk;
+        const int64_t n0 = (t % n_tasks) * n_blk;
+        const int64_t m_eff = min<int64_t>(M - m0, m_blk);
+        const int64_t n_eff = min<int64_t>(N - n0, n_blk);
+
+        gemm_s8u8_post_param p = post_param;
+        p.m_scale = p.m_scale ? p.m_scale + m0 : nullptr;
+        p.n_scale = p.n_scale ? p.n_scale + n0 : nullptr;
+        p.m_bias  = p.m_bias ? p.m_bias + m0 : nullptr;
+        p.n_bias  = p.n_bias ? p.n_bias + n0 : nullptr;
+
+        kernel(A + m0 * lda, lda, rowsum_a + m0, B + n0 * 4, ldb, m_eff, n_eff, K4, p, C + m0 * ldc + n0, ldc);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}}; // namespace ppl::kernel::x86
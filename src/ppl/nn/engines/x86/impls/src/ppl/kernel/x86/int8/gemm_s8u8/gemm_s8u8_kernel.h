@@ -0,0 +1,99 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef __ST_PPL_KERNEL_X86_INT8_GEMM_S8U8_GEMM_S8U8_KERNEL_H_
+#define __ST_PPL_KERNEL_X86_INT8_GEMM_S8U8_GEMM_S8U8_KERNEL_H_
+
+#include "ppl/kernel/x86/int8/gemm_s8u8.h"
+#include "ppl/kernel/x86/common/internal_include.h"
+
+namespace ppl { namespace kernel { namespace x86 {
+
+// one M x N block, B points to the first column of the block, post pointers already offset.
+typedef void (*gemm_s8u8_kernel_func_t)(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+void gemm_s8u8_kernel_int8_ref(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+void gemm_s8u8_kernel_int8_avx2(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+
+#ifdef PPL_USE_X86_AVX512
+void gemm_s8u8_kernel_int8_avx512vnni(
+    const int8_t *A,
+    const int64_t lda,
+    const int32_t *rowsum_a,
+    const uint8_t *B,
+    const int64_t ldb,
+    const int64_t M,
+    const int64_t N,
+    const int64_t K4,
+    const gemm_s8u8_post_param &post_param,
+    float *C,
+    const int64_t ldc);
+#endif
+
+inline float gemm_s8u8_post_scalar(
+    const int32_t acc,
+    const int64_t m,
+    const int64_t n,
+    const gemm_s8u8_post_param &p)
+{
+    float v = p.alpha * acc;
+    if (p.m_scale) v *= p.m_scale[m];
+    if (p.n_scale) v *= p.n_scale[n];
+    if (p.m_bias) v += p.m_bias[m];
+    if (p.n_bias) v += p.n_bias[n];
+    if (p.post & (gemm_s8u8_post::RELU | gemm_s8u8_post::RELU6)) v = v > 0.0f ? v : 0.0f;
+    if (p.post & gemm_s8u8_post::RELU6) v = v < 6.0f ? v : 6.0f;
+    return v;
+}
+
+}}}; // namespace ppl::kernel::x86
+
+#endif
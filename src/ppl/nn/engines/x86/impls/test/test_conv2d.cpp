@@ -144,6 +144,33 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_winograd_b6f3_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3,
+            ppl::common::ISA_X86_FMA,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
+    {
+        "n16cx_winograd_b2f5_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B2F5,
+            ppl::common::ISA_X86_FMA,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
+    {
+        "n16cx_winograd_b4f5_fp32_fma",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F5,
+            ppl::common::ISA_X86_FMA,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "n16cx_direct_fp32_fma",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -199,6 +226,33 @@ static std::map<std::string, ppl::kernel::x86::conv2d_fp32_algo_info> algo_table
             ppl::common::DATAFORMAT_N16CX
         })
     },
+    {
+        "n16cx_winograd_b6f3_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3,
+            ppl::common::ISA_X86_AVX512,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
+    {
+        "n16cx_winograd_b2f5_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B2F5,
+            ppl::common::ISA_X86_AVX512,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
+    {
+        "n16cx_winograd_b4f5_fp32_avx512",
+        ppl::kernel::x86::conv2d_fp32_algo_info({
+            ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F5,
+            ppl::common::ISA_X86_AVX512,
+            ppl::common::DATAFORMAT_N16CX,
+            ppl::common::DATAFORMAT_N16CX
+        })
+    },
     {
         "n16cx_direct_fp32_avx512",
         ppl::kernel::x86::conv2d_fp32_algo_info({
@@ -0,0 +1,836 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+
+#include <inttypes.h>
+#include <float.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(__linux__) && defined(PPL_USE_X86_OMP)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#include <omp.h>
+#endif
+
+#include "ppl/kernel/x86/fp32/maxpool2d.h"
+#include "ppl/kernel/x86/fp32/averagepool2d.h"
+#include "ppl/kernel/x86/fp32/reduce.h"
+#include "ppl/kernel/x86/fp32/softmax.h"
+#include "ppl/kernel/x86/fp32/resize2d.h"
+#include "ppl/kernel/x86/fp32/arithmetic.h"
+#include "ppl/kernel/x86/fp32/transpose.h"
+#include "ppl/kernel/x86/fp32/reorder.h"
+#include "ppl/kernel/x86/fp32/gather.h"
+#include "ppl/kernel/x86/fp32/topk.h"
+#include "ppl/kernel/x86/fp32/nms.h"
+#include "ppl/kernel/x86/fp32/lstm.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/gemm.h"
+#include "ppl/kernel/x86/common/simd_tools.h"
+#include "ppl/kernel/x86/common/macros.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/nn/common/tensor_shape.h"
+#include "simple_flags.h"
+
+/*
+  config file: one case per line, "op key=value key=value ...". keys not given take their defaults. e.g.
+    maxpool2d n=1 c=64 h=112 w=112 k=3 s=2 p=1
+    add n=1 c=64 h=56 w=56 bcast=channel
+    lstm seq=32 batch=1 input=256 hidden=256 dir=0
+  run with --help_ops to list ops and their keys.
+*/
+
+Define_bool_opt("--help", Flag_help, false, "show these help information");
+Define_bool(help_ops, false, "(false) list supported ops and keys of config");
+Define_string(cfg, "", "(required) op config file, format: op key=value ...");
+Define_string(isa, "all", "(all) comma separated variants to run: ref, sse, avx, fma, avx512 or all");
+Define_int32(warm_up, 10, "(10) warm up iterations");
+Define_int32(min_iter, 20, "(20) min benchmark iterations");
+Define_float(min_second, 1.0f, "(1.0) min benchmark seconds");
+Define_float(peak_gflops, 0.0f, "(0.0) machine peak gflops, 0 for measuring by a large fp32 gemm");
+Define_float(peak_gbps, 0.0f, "(0.0) machine peak memory bandwidth in GB/s, 0 for measuring by a stream triad");
+
+/********************************************************
+ * benchmark case
+ ********************************************************/
+
+struct bench_variant {
+    std::string isa;
+    ppl::common::isa_t isa_flag; // 0 for reference implementations which run everywhere
+    std::function<ppl::common::RetCode()> execute;
+};
+
+class bench_case {
+public:
+    bench_case() : flops(0.0), bytes(0.0), allocator_(PPL_X86_CACHELINE_BYTES()) {}
+    ~bench_case() {
+        for (auto buf : buffers_) {
+            allocator_.Free(buf);
+        }
+    }
+
+    const ppl::nn::TensorShape *shape(
+        const std::vector<int64_t> &dims,
+        const ppl::common::dataformat_t format = ppl::common::DATAFORMAT_NDARRAY,
+        const ppl::common::datatype_t type = ppl::common::DATATYPE_FLOAT32)
+    {
+        shapes_.emplace_back();
+        auto &s = shapes_.back();
+        s.SetDataType(type);
+        s.SetDataFormat(format);
+        s.Reshape(dims);
+        return &s;
+    }
+
+    // buffers are filled with random values in [-1, 1) and released with the case
+    template <typename T>
+    T *alloc(const uint64_t bytes)
+    {
+        void *buf = allocator_.Alloc(std::max<uint64_t>(bytes, PPL_X86_CACHELINE_BYTES()));
+        if (!buf) {
+            return nullptr;
+        }
+        buffers_.push_back(buf);
+        float *fbuf = (float*)buf;
+        for (uint64_t i = 0; i < bytes / sizeof(float); ++i) {
+            fbuf[i] = (rand() % 2000 - 1000) / 1000.0f;
+        }
+        return (T*)buf;
+    }
+    float *alloc(const ppl::nn::TensorShape *s)
+    {
+        return alloc<float>(s->GetBytesIncludingPadding());
+    }
+
+    void add(const char *isa, const ppl::common::isa_t isa_flag, const std::function<ppl::common::RetCode()> &execute)
+    {
+        variants.push_back({isa, isa_flag, execute});
+    }
+
+public:
+    double flops; // per execution, 0 for data movement ops
+    double bytes; // compulsory memory traffic per execution
+    std::vector<bench_variant> variants;
+
+private:
+    ppl::common::GenericCpuAllocator allocator_;
+    std::deque<ppl::nn::TensorShape> shapes_; // addresses are captured by variants
+    std::vector<void*> buffers_;
+};
+
+class case_args {
+public:
+    bool parse(const std::string &line)
+    {
+        std::istringstream ss(line);
+        if (!(ss >> op)) {
+            return false;
+        }
+        std::string kv;
+        while (ss >> kv) {
+            auto pos = kv.find('=');
+            if (pos == std::string::npos || pos == 0) {
+                return false;
+            }
+            args_[kv.substr(0, pos)] = kv.substr(pos + 1);
+            if (!desc.empty()) desc += " ";
+            desc += kv;
+        }
+        return true;
+    }
+
+    int64_t i(const char *key, const int64_t def) const
+    {
+        auto it = args_.find(key);
+        return it == args_.end() ? def : strtoll(it->second.c_str(), nullptr, 10);
+    }
+    float f(const char *key, const float def) const
+    {
+        auto it = args_.find(key);
+        return it == args_.end() ? def : strtof(it->second.c_str(), nullptr);
+    }
+    std::string s(const char *key, const char *def) const
+    {
+        auto it = args_.find(key);
+        return it == args_.end() ? std::string(def) : it->second;
+    }
+
+public:
+    std::string op;
+    std::string desc; // key=value pairs as written in config
+
+private:
+    std::map<std::string, std::string> args_;
+};
+
+typedef std::function<bool(const case_args&, bench_case*)> case_builder_t;
+
+/********************************************************
+ * ops
+ ********************************************************/
+
+using namespace ppl::kernel::x86;
+using ppl::common::DATAFORMAT_NDARRAY;
+using ppl::common::DATAFORMAT_N16CX;
+using ppl::common::ISA_X86_SSE;
+using ppl::common::ISA_X86_AVX;
+using ppl::common::ISA_X86_FMA;
+using ppl::common::ISA_X86_AVX512;
+
+static bool build_pool2d(const case_args &a, const bool is_max, bench_case *c)
+{
+    const int64_t n = a.i("n", 1), ch = a.i("c", 64), h = a.i("h", 56), w = a.i("w", 56);
+    const int32_t kh = a.i("kh", a.i("k", 3)), kw = a.i("kw", a.i("k", 3));
+    const int32_t sh = a.i("sh", a.i("s", 1)), sw = a.i("sw", a.i("s", 1));
+    const int32_t ph = a.i("ph", a.i("p", 0)), pw = a.i("pw", a.i("p", 0));
+    const int32_t mode = a.i("mode", 1); // averagepool only, 1 for excluding pads, 2 for including pads
+    const int64_t oh = (h + 2 * ph - kh) / sh + 1, ow = (w + 2 * pw - kw) / sw + 1;
+    if (oh <= 0 || ow <= 0) {
+        return false;
+    }
+
+    auto src_nd = c->shape({n, ch, h, w}), dst_nd = c->shape({n, ch, oh, ow});
+    auto src_blk = c->shape({n, ch, h, w}, DATAFORMAT_N16CX), dst_blk = c->shape({n, ch, oh, ow}, DATAFORMAT_N16CX);
+    auto src_nd_buf = c->alloc(src_nd), dst_nd_buf = c->alloc(dst_nd);
+    auto src_blk_buf = c->alloc(src_blk), dst_blk_buf = c->alloc(dst_blk);
+    if (!src_nd_buf || !dst_nd_buf || !src_blk_buf || !dst_blk_buf) {
+        return false;
+    }
+
+    c->flops = double(n) * ch * oh * ow * kh * kw;
+    c->bytes = double(n) * ch * (h * w + oh * ow) * sizeof(float);
+
+#define POOL_ARGS(SRC_SHAPE, DST_SHAPE, SRC) SRC_SHAPE, DST_SHAPE, SRC, kh, kw, sh, sw, ph, pw
+    if (is_max) {
+        c->add("ref", 0, [=]() { return maxpool2d_nchw_normal_fp32(POOL_ARGS(src_nd, dst_nd, src_nd_buf), dst_nd_buf); });
+        c->add("sse", ISA_X86_SSE, [=]() { return maxpool2d_n16chw_blk1x4_fp32_sse(POOL_ARGS(src_blk, dst_blk, src_blk_buf), dst_blk_buf); });
+        c->add("avx", ISA_X86_AVX, [=]() { return maxpool2d_n16chw_blk1x8_fp32_avx(POOL_ARGS(src_blk, dst_blk, src_blk_buf), dst_blk_buf); });
+#ifdef PPL_USE_X86_AVX512
+        c->add("avx512", ISA_X86_AVX512, [=]() { return maxpool2d_n16chw_blk1x16_fp32_avx512(POOL_ARGS(src_blk, dst_blk, src_blk_buf), dst_blk_buf); });
+#endif
+    } else {
+        c->add("ref", 0, [=]() { return averagepool2d_nchw_normal_fp32(POOL_ARGS(src_nd, dst_nd, src_nd_buf), mode, 0, dst_nd_buf); });
+        c->add("sse", ISA_X86_SSE, [=]() { return averagepool2d_n16chw_blk1x4_fp32_sse(POOL_ARGS(src_blk, dst_blk, src_blk_buf), mode, 0, dst_blk_buf); });
+        c->add("avx", ISA_X86_AVX, [=]() { return averagepool2d_n16chw_blk1x8_fp32_avx(POOL_ARGS(src_blk, dst_blk, src_blk_buf), mode, 0, dst_blk_buf); });
+#ifdef PPL_USE_X86_AVX512
+        c->add("avx512", ISA_X86_AVX512, [=]() { return averagepool2d_n16chw_blk1x16_fp32_avx512(POOL_ARGS(src_blk, dst_blk, src_blk_buf), mode, 0, dst_blk_buf); });
+#endif
+    }
+#undef POOL_ARGS
+
+    return true;
+}
+
+typedef decltype(reduce_sum_fp32_avx)* reduce_func_t;
+
+static bool build_reduce(const case_args &a, const reduce_func_t sse_func, const reduce_func_t avx_func, bench_case *c)
+{
+    std::vector<int64_t> src_dims = {a.i("n", 1), a.i("c", 64), a.i("h", 56), a.i("w", 56)};
+    const int32_t axis = a.i("axis", 3);
+    if (axis < 0 || axis >= (int32_t)src_dims.size()) {
+        return false;
+    }
+    auto dst_dims = src_dims;
+    dst_dims[axis] = 1;
+
+    auto src_shape = c->shape(src_dims), dst_shape = c->shape(dst_dims);
+    auto src = c->alloc(src_shape), dst = c->alloc(dst_shape);
+    if (!src || !dst) {
+        return false;
+    }
+
+    c->flops = src_shape->GetElementsExcludingPadding();
+    c->bytes = src_shape->GetBytesExcludingPadding() + dst_shape->GetBytesExcludingPadding();
+
+    const std::vector<int32_t> axes = {axis};
+    c->add("sse", ISA_X86_SSE, [=]() { return sse_func(src_shape, dst_shape, src, axes.data(), 1, dst); });
+    c->add("avx", ISA_X86_AVX, [=]() { return avx_func(src_shape, dst_shape, src, axes.data(), 1, dst); });
+
+    return true;
+}
+
+static bool build_softmax(const case_args &a, bench_case *c)
+{
+    auto shape = c->shape({a.i("n", 1), a.i("c", 1000), a.i("h", 1), a.i("w", 1)});
+    const int64_t axis = a.i("axis", 1);
+    auto src = c->alloc(shape), dst = c->alloc(shape);
+    if (!src || !dst) {
+        return false;
+    }
+
+    // max, exp, sum and scale, counting exp as one flop
+    c->flops = 4.0 * shape->GetElementsExcludingPadding();
+    c->bytes = 2.0 * shape->GetBytesExcludingPadding();
+
+    c->add("ref", 0, [=]() { return softmax_ndarray_fp32(shape, src, axis, dst); });
+    c->add("sse", ISA_X86_SSE, [=]() { return softmax_ndarray_fp32_sse(shape, src, axis, dst); });
+    c->add("fma", ISA_X86_FMA, [=]() { return softmax_ndarray_fp32_fma(shape, src, axis, dst); });
+#ifdef PPL_USE_X86_AVX512
+    c->add("avx512", ISA_X86_AVX512, [=]() { return softmax_ndarray_fp32_avx512(shape, src, axis, dst); });
+#endif
+
+    return true;
+}
+
+static bool build_resize2d(const case_args &a, const bool is_linear, bench_case *c)
+{
+    const int64_t n = a.i("n", 1), ch = a.i("c", 64), h = a.i("h", 56), w = a.i("w", 56);
+    const float scale = a.f("scale", 2.0f);
+    const int64_t oh = int64_t(h * scale), ow = int64_t(w * scale);
+    if (oh <= 0 || ow <= 0) {
+        return false;
+    }
+
+    auto src_nd = c->shape({n, ch, h, w}), dst_nd = c->shape({n, ch, oh, ow});
+    auto src_blk = c->shape({n, ch, h, w}, DATAFORMAT_N16CX), dst_blk = c->shape({n, ch, oh, ow}, DATAFORMAT_N16CX);
+    auto src_nd_buf = c->alloc(src_nd), dst_nd_buf = c->alloc(dst_nd);
+    auto src_blk_buf = c->alloc(src_blk), dst_blk_buf = c->alloc(dst_blk);
+    if (!src_nd_buf || !dst_nd_buf || !src_blk_buf || !dst_blk_buf) {
+        return false;
+    }
+
+    // 4 multiplies and 3 adds for each bilinear output
+    c->flops = is_linear ? 7.0 * dst_nd->GetElementsExcludingPadding() : 0.0;
+    c->bytes = src_nd->GetBytesExcludingPadding() + dst_nd->GetBytesExcludingPadding();
+
+    if (is_linear) {
+        c->add("ref", 0, [=]() { return reisze2d_ndarray_pytorch_linear_floor_fp32(src_nd, dst_nd, src_nd_buf, scale, scale, dst_nd_buf); });
+        c->add("avx", ISA_X86_AVX, [=]() { return resize2d_n16chw_pytorch_2linear_floor_fp32_avx(src_blk, dst_blk, src_blk_buf, scale, scale, dst_blk_buf); });
+#ifdef PPL_USE_X86_AVX512
+        c->add("avx512", ISA_X86_AVX512, [=]() { return resize2d_n16cx_pytorch_2linear_floor_fp32_avx512(src_blk, dst_blk, src_blk_buf, scale, scale, dst_blk_buf); });
+#endif
+    } else {
+        c->add("ref", 0, [=]() { return reisze2d_ndarray_asymmetric_nearest_floor_fp32(src_nd, dst_nd, src_nd_buf, scale, scale, dst_nd_buf); });
+        if (oh == 2 * h && ow == 2 * w) {
+            c->add("sse", ISA_X86_SSE, [=]() { return reisze2d_ndarray_asymmetric_nearest_floor_2times_fp32_sse(src_nd, dst_nd, src_nd_buf, scale, scale, dst_nd_buf); });
+        }
+        c->add("avx", ISA_X86_AVX, [=]() { return reisze2d_n16cx_asymmetric_nearest_floor_fp32_avx(src_blk, dst_blk, src_blk_buf, scale, scale, dst_blk_buf); });
+#ifdef PPL_USE_X86_AVX512
+        c->add("avx512", ISA_X86_AVX512, [=]() { return reisze2d_n16cx_asymmetric_nearest_floor_fp32_avx512(src_blk, dst_blk, src_blk_buf, scale, scale, dst_blk_buf); });
+#endif
+    }
+
+    return true;
+}
+
+typedef decltype(add_fp32_avx)* arithmetic_func_t;
+
+static bool build_arithmetic(const case_args &a, const arithmetic_func_t sse_func, const arithmetic_func_t avx_func, bench_case *c)
+{
+    const int64_t n = a.i("n", 1), ch = a.i("c", 64), h = a.i("h", 56), w = a.i("w", 56);
+    const std::string bcast = a.s("bcast", "none"); // none, channel or scalar
+
+    std::vector<int64_t> src1_dims;
+    if (bcast == "none") {
+        src1_dims = {n, ch, h, w};
+    } else if (bcast == "channel") {
+        src1_dims = {1, ch, 1, 1};
+    } else if (bcast == "scalar") {
+        src1_dims = {1, 1, 1, 1};
+    } else {
+        return false;
+    }
+
+    auto src0_shape = c->shape({n, ch, h, w}), src1_shape = c->shape(src1_dims), dst_shape = c->shape({n, ch, h, w});
+    auto src0 = c->alloc(src0_shape), src1 = c->alloc(src1_shape), dst = c->alloc(dst_shape);
+    if (!src0 || !src1 || !dst) {
+        return false;
+    }
+
+    c->flops = dst_shape->GetElementsExcludingPadding();
+    c->bytes = src0_shape->GetBytesExcludingPadding() + src1_shape->GetBytesExcludingPadding() +
+               dst_shape->GetBytesExcludingPadding();
+
+    c->add("sse", ISA_X86_SSE, [=]() { return sse_func(src0_shape, src1_shape, dst_shape, src0, src1, false, dst); });
+    c->add("avx", ISA_X86_AVX, [=]() { return avx_func(src0_shape, src1_shape, dst_shape, src0, src1, false, dst); });
+
+    return true;
+}
+
+static bool build_transpose(const case_args &a, bench_case *c)
+{
+    const std::vector<int64_t> src_dims = {a.i("n", 1), a.i("c", 64), a.i("h", 56), a.i("w", 56)};
+    const std::string perm_str = a.s("perm", "0231");
+    if (perm_str.size() != src_dims.size()) {
+        return false;
+    }
+
+    std::vector<int32_t> perm(src_dims.size());
+    std::vector<int64_t> dst_dims(src_dims.size());
+    for (size_t i = 0; i < perm.size(); ++i) {
+        perm[i] = perm_str[i] - '0';
+        if (perm[i] < 0 || perm[i] >= (int32_t)src_dims.size()) {
+            return false;
+        }
+        dst_dims[i] = src_dims[perm[i]];
+    }
+
+    auto src_shape = c->shape(src_dims), dst_shape = c->shape(dst_dims);
+    auto src = c->alloc(src_shape), dst = c->alloc(dst_shape);
+    if (!src || !dst) {
+        return false;
+    }
+
+    c->bytes = 2.0 * src_shape->GetBytesExcludingPadding();
+
+    c->add("ref", 0, [=]() { return transpose_ndarray_fp32(src_shape, dst_shape, src, perm.data(), dst); });
+
+    return true;
+}
+
+typedef decltype(reorder_ndarray_n16cx_fp32)* reorder_func_t;
+
+static bool build_reorder(
+    const case_args &a,
+    const ppl::common::dataformat_t src_format,
+    const ppl::common::dataformat_t dst_format,
+    const reorder_func_t ref_func,
+    const reorder_func_t avx_func,
+    bench_case *c)
+{
+    const std::vector<int64_t> dims = {a.i("n", 1), a.i("c", 64), a.i("h", 56), a.i("w", 56)};
+    auto src_shape = c->shape(dims, src_format), dst_shape = c->shape(dims, dst_format);
+    auto src = c->alloc(src_shape), dst = c->alloc(dst_shape);
+    if (!src || !dst) {
+        return false;
+    }
+
+    c->bytes = src_shape->GetBytesIncludingPadding() + dst_shape->GetBytesIncludingPadding();
+
+    c->add("ref", 0, [=]() { return ref_func(src_shape, src, dst); });
+    c->add("avx", ISA_X86_AVX, [=]() { return avx_func(src_shape, src, dst); });
+
+    return true;
+}
+
+static bool build_gather(const case_args &a, bench_case *c)
+{
+    const int64_t outer = a.i("outer", 1), axis_dim = a.i("axis_dim", 30000), inner = a.i("inner", 512);
+    const int64_t num_indices = a.i("indices", 128);
+    if (axis_dim <= 0 || num_indices <= 0) {
+        return false;
+    }
+
+    auto src_shape = c->shape({outer, axis_dim, inner}), dst_shape = c->shape({outer, num_indices, inner});
+    auto src = c->alloc(src_shape), dst = c->alloc(dst_shape);
+    auto indices = c->alloc<int64_t>(num_indices * sizeof(int64_t));
+    if (!src || !dst || !indices) {
+        return false;
+    }
+    for (int64_t i = 0; i < num_indices; ++i) {
+        indices[i] = rand() % axis_dim;
+    }
+
+    c->bytes = 2.0 * dst_shape->GetBytesExcludingPadding() + num_indices * sizeof(int64_t);
+
+    c->add("ref", 0, [=]() { return gather_ndarray_fp32(src, indices, outer, axis_dim, inner, 1, num_indices, dst); });
+
+    return true;
+}
+
+static bool build_topk(const case_args &a, bench_case *c)
+{
+    const int64_t n = a.i("n", 1), len = a.i("len", 8400), k = a.i("k", 100);
+    if (k <= 0 || k > len) {
+        return false;
+    }
+
+    auto src_shape = c->shape({n, len}), values_shape = c->shape({n, k});
+    auto indices_shape = c->shape({n, k}, DATAFORMAT_NDARRAY, ppl::common::DATATYPE_INT64);
+    auto src = c->alloc(src_shape), values = c->alloc(values_shape);
+    auto indices = c->alloc<int64_t>(indices_shape->GetBytesIncludingPadding());
+    auto temp_buffer = c->alloc<void>(topk_ndarray_fp32_get_buffer_bytes(src_shape, 1));
+    if (!src || !values || !indices || !temp_buffer) {
+        return false;
+    }
+
+    c->bytes = src_shape->GetBytesExcludingPadding() + values_shape->GetBytesExcludingPadding() +
+               indices_shape->GetBytesExcludingPadding();
+
+    c->add("ref", 0, [=]() {
+        return topk_ndarray_fp32(src_shape, values_shape, indices_shape, src, k, 1, 1, 1, temp_buffer, values, indices);
+    });
+
+    return true;
+}
+
+static bool build_nms(const case_args &a, bench_case *c)
+{
+    const int64_t num_boxes = a.i("boxes", 1000), num_classes = a.i("classes", 80);
+    const int64_t max_output = a.i("max_output", 100);
+    const float iou_threshold = a.f("iou", 0.5f), score_threshold = a.f("score", 0.0f);
+    if (num_boxes <= 0 || num_classes <= 0 || max_output <= 0) {
+        return false;
+    }
+
+    auto boxes = c->alloc<float>(num_boxes * 4 * sizeof(float));
+    auto scores = c->alloc<float>(num_classes * num_boxes * sizeof(float));
+    auto dst = c->alloc<int64_t>(num_classes * std::min(num_boxes, max_output) * 3 * sizeof(int64_t));
+    if (!boxes || !scores || !dst) {
+        return false;
+    }
+    for (int64_t i = 0; i < num_boxes; ++i) { // y1, x1, y2, x2 in [0, 1)
+        const float y = (rand() % 900) / 1000.0f, x = (rand() % 900) / 1000.0f;
+        boxes[i * 4 + 0] = y;
+        boxes[i * 4 + 1] = x;
+        boxes[i * 4 + 2] = y + (rand() % 100 + 1) / 1000.0f;
+        boxes[i * 4 + 3] = x + (rand() % 100 + 1) / 1000.0f;
+    }
+    for (int64_t i = 0; i < num_classes * num_boxes; ++i) {
+        scores[i] = (rand() % 1000) / 1000.0f;
+    }
+
+    c->bytes = (num_boxes * 4 + num_classes * num_boxes) * sizeof(float);
+
+#define NMS_ARGS() boxes, scores, num_boxes, 1, num_classes, false, max_output, iou_threshold, score_threshold, dst
+    c->add("ref", 0, [=]() { int64_t num_out; return nms_ndarray_fp32(NMS_ARGS(), &num_out); });
+    c->add("fma", ISA_X86_FMA, [=]() { int64_t num_out; return nms_ndarray_fp32_fma(NMS_ARGS(), &num_out); });
+#ifdef PPL_USE_X86_AVX512
+    c->add("avx512", ISA_X86_AVX512, [=]() { int64_t num_out; return nms_ndarray_fp32_avx512(NMS_ARGS(), &num_out); });
+#endif
+#undef NMS_ARGS
+
+    return true;
+}
+
+static bool build_rnn(const case_args &a, const bool is_lstm, bench_case *c)
+{
+    const int64_t seq = a.i("seq", 32), batch = a.i("batch", 1), input_size = a.i("input", 256);
+    const int64_t hidden = a.i("hidden", 256);
+    const rnn_direction_t direction = a.i("dir", 0); // 0 for forward, 1 for reverse, 2 for bidirectional
+    const int64_t num_dir = direction == rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t num_gate = is_lstm ? 4 : 3;
+    if (direction > rnn_direction::BIDIRECTIONAL) {
+        return false;
+    }
+
+    auto X_shape = c->shape({seq, batch, input_size});
+    auto X = c->alloc(X_shape);
+    auto W = c->alloc<float>(num_dir * num_gate * hidden * input_size * sizeof(float));
+    auto R = c->alloc<float>(num_dir * num_gate * hidden * hidden * sizeof(float));
+    auto B = c->alloc<float>(num_dir * 2 * num_gate * hidden * sizeof(float));
+    auto Y = c->alloc<float>(seq * num_dir * batch * hidden * sizeof(float));
+    auto Y_h = c->alloc<float>(num_dir * batch * hidden * sizeof(float));
+    auto Y_c = c->alloc<float>(num_dir * batch * hidden * sizeof(float));
+    if (!X || !W || !R || !B || !Y || !Y_h || !Y_c) {
+        return false;
+    }
+
+    // gemms of inputs and hidden states, element-wise gate computations are ignored
+    c->flops = 2.0 * num_dir * seq * batch * num_gate * hidden * (input_size + hidden);
+    c->bytes = (seq * batch * input_size + num_dir * num_gate * hidden * (input_size + hidden) +
+                seq * num_dir * batch * hidden) * sizeof(float);
+
+    if (is_lstm) {
+        auto ref_temp = c->alloc<void>(lstm_ref_fp32_get_buffer_bytes(X_shape, direction, hidden, true, true, true));
+        auto fma_temp = c->alloc<void>(lstm_fp32_fma_get_buffer_bytes(X_shape, direction, hidden, true, true, true));
+        if (!ref_temp || !fma_temp) {
+            return false;
+        }
+        c->add("ref", 0, [=]() {
+            return lstm_ref_fp32(X_shape, X, W, R, nullptr, B, nullptr, nullptr, nullptr, direction, hidden, ref_temp, Y, Y_h, Y_c);
+        });
+        c->add("fma", ISA_X86_FMA, [=]() {
+            return lstm_fp32_fma(X_shape, X, W, R, nullptr, B, nullptr, nullptr, nullptr, direction, hidden, fma_temp, Y, Y_h, Y_c);
+        });
+    } else {
+        auto ref_temp = c->alloc<void>(gru_ref_fp32_get_buffer_bytes(X_shape, direction, hidden, true, true));
+        auto fma_temp = c->alloc<void>(gru_fp32_fma_get_buffer_bytes(X_shape, direction, hidden, false, true, true));
+        if (!ref_temp || !fma_temp) {
+            return false;
+        }
+        c->add("ref", 0, [=]() {
+            return gru_ref_fp32(X_shape, X, W, R, B, nullptr, nullptr, direction, hidden, false, ref_temp, Y, Y_h);
+        });
+        c->add("fma", ISA_X86_FMA, [=]() {
+            return gru_fp32_fma(X_shape, X, W, R, B, nullptr, nullptr, direction, hidden, false, fma_temp, Y, Y_h);
+        });
+    }
+
+    return true;
+}
+
+struct op_info {
+    case_builder_t build;
+    const char *keys;
+};
+
+static const std::map<std::string, op_info> &op_table()
+{
+    using namespace std::placeholders;
+    static const std::map<std::string, op_info> table = {
+        {"maxpool2d", {std::bind(build_pool2d, _1, true, _2), "n c h w k|kh kw s|sh sw p|ph pw"}},
+        {"averagepool2d", {std::bind(build_pool2d, _1, false, _2), "n c h w k|kh kw s|sh sw p|ph pw mode"}},
+        {"reduce_sum", {std::bind(build_reduce, _1, reduce_sum_fp32_sse, reduce_sum_fp32_avx, _2), "n c h w axis"}},
+        {"reduce_mean", {std::bind(build_reduce, _1, reduce_mean_fp32_sse, reduce_mean_fp32_avx, _2), "n c h w axis"}},
+        {"reduce_max", {std::bind(build_reduce, _1, reduce_max_fp32_sse, reduce_max_fp32_avx, _2), "n c h w axis"}},
+        {"reduce_min", {std::bind(build_reduce, _1, reduce_min_fp32_sse, reduce_min_fp32_avx, _2), "n c h w axis"}},
+        {"softmax", {build_softmax, "n c h w axis"}},
+        {"resize2d_nearest", {std::bind(build_resize2d, _1, false, _2), "n c h w scale"}},
+        {"resize2d_linear", {std::bind(build_resize2d, _1, true, _2), "n c h w scale"}},
+        {"add", {std::bind(build_arithmetic, _1, add_fp32_sse, add_fp32_avx, _2), "n c h w bcast=none|channel|scalar"}},
+        {"sub", {std::bind(build_arithmetic, _1, sub_fp32_sse, sub_fp32_avx, _2), "n c h w bcast=none|channel|scalar"}},
+        {"mul", {std::bind(build_arithmetic, _1, mul_fp32_sse, mul_fp32_avx, _2), "n c h w bcast=none|channel|scalar"}},
+        {"div", {std::bind(build_arithmetic, _1, div_fp32_sse, div_fp32_avx, _2), "n c h w bcast=none|channel|scalar"}},
+        {"transpose", {build_transpose, "n c h w perm=0231"}},
+        {"reorder_ndarray_n16cx", {std::bind(build_reorder, _1, DATAFORMAT_NDARRAY, DATAFORMAT_N16CX, reorder_ndarray_n16cx_fp32, reorder_ndarray_n16cx_fp32_avx, _2), "n c h w"}},
+        {"reorder_n16cx_ndarray", {std::bind(build_reorder, _1, DATAFORMAT_N16CX, DATAFORMAT_NDARRAY, reorder_n16cx_ndarray_fp32, reorder_n16cx_ndarray_fp32_avx, _2), "n c h w"}},
+        {"reorder_n16cx_nxc", {std::bind(build_reorder, _1, DATAFORMAT_N16CX, DATAFORMAT_NDARRAY, reorder_n16cx_nxc_fp32, reorder_n16cx_nxc_fp32_avx, _2), "n c h w"}},
+        {"gather", {build_gather, "outer axis_dim inner indices"}},
+        {"topk", {build_topk, "n len k"}},
+        {"nms", {build_nms, "boxes classes max_output iou score"}},
+        {"lstm", {std::bind(build_rnn, _1, true, _2), "seq batch input hidden dir"}},
+        {"gru", {std::bind(build_rnn, _1, false, _2), "seq batch input hidden dir"}},
+    };
+    return table;
+}
+
+/********************************************************
+ * machine peaks
+ ********************************************************/
+
+static double measure_peak_gflops()
+{
+    if (!(ppl::common::GetCpuISA() & ISA_X86_FMA)) {
+        return 0.0;
+    }
+
+    const int64_t M = 2048, N = 2048, K = 2048;
+    ppl::common::GenericCpuAllocator allocator(PPL_X86_CACHELINE_BYTES());
+    float *A = (float*)allocator.Alloc(M * K * sizeof(float));
+    float *B = (float*)allocator.Alloc(K * N * sizeof(float));
+    float *C = (float*)allocator.Alloc(M * N * sizeof(float));
+    double best_us = DBL_MAX;
+    if (A && B && C) {
+        memset(A, 0, M * K * sizeof(float));
+        memset(B, 0, K * N * sizeof(float));
+        for (int32_t i = 0; i < 5; ++i) {
+            auto start = std::chrono::high_resolution_clock::now();
+            gemm_fp32_fma(A, B, nullptr, nullptr, gemm_m_type::NOTRANS, gemm_m_type::NOTRANS, gemm_v_type::EMPTY,
+                          gemm_m_type::EMPTY, M, N, K, K, N, N, 0, 1.0f, 0.0f, gemm_post::NONE, C);
+            auto end = std::chrono::high_resolution_clock::now();
+            best_us = std::min<double>(best_us, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e3);
+        }
+    }
+    if (A) allocator.Free(A);
+    if (B) allocator.Free(B);
+    if (C) allocator.Free(C);
+
+    return best_us == DBL_MAX ? 0.0 : 2.0 * M * N * K / 1e9 / (best_us / 1e6);
+}
+
+// stream triad on buffers much larger than last level cache
+static double measure_peak_gbps()
+{
+    const int64_t len = 32 * 1024 * 1024;
+    ppl::common::GenericCpuAllocator allocator(PPL_X86_CACHELINE_BYTES());
+    float *a = (float*)allocator.Alloc(len * sizeof(float));
+    float *b = (float*)allocator.Alloc(len * sizeof(float));
+    float *c = (float*)allocator.Alloc(len * sizeof(float));
+    double best_us = DBL_MAX;
+    if (a && b && c) {
+PRAGMA_OMP_PARALLEL_FOR()
+        for (int64_t i = 0; i < len; ++i) {
+            a[i] = 0.0f;
+            b[i] = 1.0f;
+            c[i] = 2.0f;
+        }
+        for (int32_t r = 0; r < 5; ++r) {
+            auto start = std::chrono::high_resolution_clock::now();
+PRAGMA_OMP_PARALLEL_FOR()
+            for (int64_t i = 0; i < len; ++i) {
+                a[i] = b[i] + 3.0f * c[i];
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            best_us = std::min<double>(best_us, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e3);
+        }
+    }
+    if (a) allocator.Free(a);
+    if (b) allocator.Free(b);
+    if (c) allocator.Free(c);
+
+    return best_us == DBL_MAX ? 0.0 : 3.0 * len * sizeof(float) / 1e9 / (best_us / 1e6);
+}
+
+/********************************************************
+ * main
+ ********************************************************/
+
+static bool variant_selected(const std::string &isa)
+{
+    if (Flag_isa == "all") {
+        return true;
+    }
+    std::istringstream ss(Flag_isa);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item == isa) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    simple_flags::parse_args(argc, argv);
+    if (Flag_help) {
+        simple_flags::print_args_info();
+        return 0;
+    }
+    if (Flag_help_ops) {
+        for (auto &it : op_table()) {
+            std::cerr << it.first << ": " << it.second.keys << "\n";
+        }
+        return 0;
+    }
+
+    ppl::kernel::x86::set_denormals_zero(1);
+
+    std::ifstream cfgfile;
+    {
+        cfgfile.open(Flag_cfg, std::ios_base::in | std::ios_base::binary);
+        if (!cfgfile.is_open()) {
+            std::cerr << "cannot open config file\n";
+            simple_flags::print_args_info();
+            return -1;
+        }
+    }
+
+    int32_t num_threads = 1;
+#if defined(__linux__) && defined(PPL_USE_X86_OMP)
+    num_threads = omp_get_max_threads();
+#pragma omp parallel
+    {
+#define handle_error_en(en, msg) do { errno = en; perror(msg); exit(EXIT_FAILURE); } while (0)
+        int i = omp_get_thread_num();
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(i, &cpuset);
+        if (int s = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+            handle_error_en(s, "pthread_setaffinity_np");
+        }
+#undef handle_error_en
+    }
+#endif
+
+    const double peak_gflops = Flag_peak_gflops > 0 ? Flag_peak_gflops : measure_peak_gflops();
+    const double peak_gbps = Flag_peak_gbps > 0 ? Flag_peak_gbps : measure_peak_gbps();
+
+    std::cerr << "==============================================================\n";
+    fprintf(
+        stderr,
+        "num_threads=%d\nwarm_up=%d\nmin_iter=%d\nmin_second=%f\nisa=%s\npeak_gflops=%.2f\npeak_gbps=%.2f\n",
+        num_threads, Flag_warm_up, Flag_min_iter, Flag_min_second, Flag_isa.c_str(), peak_gflops, peak_gbps
+    );
+    std::cerr << "==============================================================\n";
+
+    // results are printed to stdout as csv, gflops and gbps are of the best run.
+    // peak_gbps is dram bandwidth, so cases fitting in cache may report peak_fraction above 1.
+    std::cout << "line_no,op,isa,case,min_ms,avg_ms,gflops,gbps,arith_intensity,attainable_gflops,peak_fraction,bound\n";
+
+    const auto cpu_isa = ppl::common::GetCpuISA();
+    std::string line;
+    int line_no = 0;
+    while (std::getline(cfgfile, line)) {
+        ++line_no;
+
+        // skip comment
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        case_args args;
+        if (!args.parse(line)) {
+            std::cerr << line_no << "," << line << ",invalid format\n";
+            continue;
+        }
+        auto op = op_table().find(args.op);
+        if (op == op_table().end()) {
+            std::cerr << line_no << "," << line << ",unsupported op\n";
+            continue;
+        }
+
+        bench_case bcase;
+        if (!op->second.build(args, &bcase)) {
+            std::cerr << line_no << "," << line << ",invalid case or out of memory\n";
+            continue;
+        }
+
+        for (auto &variant : bcase.variants) {
+            if (!variant_selected(variant.isa) || (variant.isa_flag && !(cpu_isa & variant.isa_flag))) {
+                continue;
+            }
+
+            bool failed = false;
+            for (int32_t i = 0; i < Flag_warm_up && !failed; ++i) {
+                failed = (variant.execute() != ppl::common::RC_SUCCESS);
+            }
+
+            double tot_exe_us = 0.;
+            double min_exe_us = DBL_MAX;
+            int64_t tot_exe_iter = 0;
+            for (; !failed && (tot_exe_iter < Flag_min_iter || tot_exe_us < Flag_min_second * 1e6); ++tot_exe_iter) {
+                auto start = std::chrono::high_resolution_clock::now();
+                failed = (variant.execute() != ppl::common::RC_SUCCESS);
+                auto end = std::chrono::high_resolution_clock::now();
+                double dur = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e3;
+                tot_exe_us += dur;
+                min_exe_us = std::min(min_exe_us, dur);
+            }
+            if (failed) {
+                std::cerr << line_no << "," << args.op << "," << variant.isa << ",execute failed\n";
+                continue;
+            }
+
+            // roofline: attainable = min(peak_gflops, arith_intensity * peak_gbps)
+            const double gflops = bcase.flops / 1e9 / (min_exe_us / 1e6);
+            const double gbps = bcase.bytes / 1e9 / (min_exe_us / 1e6);
+            const double arith_intensity = bcase.bytes > 0 ? bcase.flops / bcase.bytes : 0.0;
+            const double attainable_gflops = std::min(peak_gflops, arith_intensity * peak_gbps);
+            double peak_fraction = 0.0;
+            if (peak_gflops > 0 && bcase.flops > 0) {
+                peak_fraction = std::max(peak_fraction, gflops / peak_gflops);
+            }
+            if (peak_gbps > 0) {
+                peak_fraction = std::max(peak_fraction, gbps / peak_gbps);
+            }
+            const char *bound = (bcase.flops > 0 && arith_intensity * peak_gbps >= peak_gflops) ? "compute" : "memory";
+
+            fprintf(stdout, "%d,%s,%s,%s,%.3f,%.3f,%.2f,%.2f,%.3f,%.2f,%.3f,%s\n",
+                line_no, args.op.c_str(), variant.isa.c_str(), args.desc.c_str(),
+                min_exe_us / 1e3, tot_exe_us / tot_exe_iter / 1e3, gflops, gbps,
+                arith_intensity, attainable_gflops, peak_fraction, bound);
+            fflush(stdout);
+        }
+    }
+
+    cfgfile.close();
+    return 0;
+}
@@ -0,0 +1,73 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/inplace_buffer.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+static bool IsOuterDimsOne(const TensorShape& shape, uint32_t axis) {
+    for (uint32_t i = 0; i < axis; ++i) {
+        if (shape.GetDim(i) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const uint64_t kSlotAlignment = 64; // the same as X86_DEFAULT_ALIGNMENT
+
+bool CalcInplaceSlots(const TensorShape* const* shapes, uint32_t count, uint32_t axis, vector<uint64_t>* offsets,
+                      vector<uint64_t>* bytes) {
+    offsets->resize(count);
+    bytes->resize(count);
+
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& shape = *shapes[i];
+        if (shape.IsScalar() || axis >= shape.GetDimCount()) {
+            return false;
+        }
+
+        auto data_format = shape.GetDataFormat();
+        if (data_format == DATAFORMAT_NDARRAY) {
+            if (!IsOuterDimsOne(shape, axis)) {
+                return false;
+            }
+        } else if (data_format == DATAFORMAT_N16CX) {
+            // channels are padded to 16 in each block, so only the last one may have padding
+            if (axis > 1 || !IsOuterDimsOne(shape, axis) || (axis == 1 && i + 1 < count && shape.GetDim(1) % 16 != 0)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+
+        if (offset % kSlotAlignment != 0) {
+            return false;
+        }
+
+        offsets->at(i) = offset;
+        bytes->at(i) = shape.GetBytesIncludingPadding();
+        offset += bytes->at(i);
+    }
+
+    return true;
+}
+
+}}} // namespace ppl::nn::x86
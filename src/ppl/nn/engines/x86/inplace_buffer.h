@@ -0,0 +1,52 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_INPLACE_BUFFER_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_INPLACE_BUFFER_H_
+
+#include "ppl/nn/common/tensor_shape.h"
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @class InplaceBuffer
+   @brief a buffer owned by a Concat(or Split) kernel and written directly by producers of its inputs.
+   the buffer is divided into slots, one for each tensor placed in it. a slot whose size is 0 is not
+   available and the producer uses a buffer of its own.
+   @note the buffer lives as long as the device, so tensors placed in it are valid until the next run.
+*/
+struct InplaceBuffer final {
+    void* addr = nullptr;
+    uint64_t capacity = 0;
+    std::vector<uint64_t> slot_offsets;
+    std::vector<uint64_t> slot_bytes;
+};
+
+/**
+   @brief calculates offsets and sizes of `shapes` laid out one after another in a buffer, which are also
+   the positions of them in a tensor concatenated along `axis`.
+   @return false if the concatenated tensor is not a sequence of `shapes`, e.g. when dims before `axis` are
+   not all 1, or channels of a N16CX tensor except the last one are not multiples of 16. offsets must also
+   be aligned as buffers allocated by x86 devices because kernels may use aligned loads and stores.
+*/
+bool CalcInplaceSlots(const TensorShape* const* shapes, uint32_t count, uint32_t axis, std::vector<uint64_t>* offsets,
+                      std::vector<uint64_t>* bytes);
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -16,6 +16,7 @@
 // under the License.
 
 #include "ppl/nn/engines/x86/kernel.h"
+#include <string.h>
 using namespace std;
 using namespace ppl::common;
 
@@ -25,16 +26,126 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+static bool ShapeEquals(const TensorShape& a, const TensorShape& b) {
+    if (a.IsScalar() != b.IsScalar() || a.GetDataType() != b.GetDataType() ||
+        a.GetDataFormat() != b.GetDataFormat() || a.GetRealDimCount() != b.GetRealDimCount()) {
+        return false;
+    }
+    return (memcmp(a.GetDims(), b.GetDims(), a.GetRealDimCount() * sizeof(int64_t)) == 0);
+}
+
+bool X86Kernel::InputsMatchLastReshape(const KernelExecContext& ctx) const {
+    if (!has_last_reshape_ || ctx.GetInputCount() != last_inputs_.size() ||
+        ctx.GetOutputCount() != last_output_shapes_.size()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
+        auto tensor = ctx.GetInput<TensorImpl>(i);
+        auto& record = last_inputs_[i];
+        if (!tensor || !record.exists) {
+            if ((!tensor) != (!record.exists)) {
+                return false;
+            }
+            continue;
+        }
+
+        auto shape = tensor->GetShape();
+        if (!ShapeEquals(*shape, record.shape)) {
+            return false;
+        }
+
+        auto bytes = shape->GetBytesExcludingPadding();
+        if (bytes <= kMaxRecordedInputBytes) {
+            auto data = tensor->GetBufferPtr();
+            if (bytes > 0 && (!data || bytes != record.data.size() || memcmp(data, record.data.data(), bytes) != 0)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void X86Kernel::SaveLastReshape(const KernelExecContext& ctx) {
+    has_last_reshape_ = false;
+
+    last_inputs_.resize(ctx.GetInputCount());
+    for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
+        auto tensor = ctx.GetInput<TensorImpl>(i);
+        auto& record = last_inputs_[i];
+        record.exists = (tensor != nullptr);
+        record.data.clear();
+        if (!tensor) {
+            continue;
+        }
+
+        record.shape = *tensor->GetShape();
+        auto bytes = record.shape.GetBytesExcludingPadding();
+        if (bytes > 0 && bytes <= kMaxRecordedInputBytes) {
+            auto data = tensor->GetBufferPtr<char>();
+            if (!data) { // values cannot be compared next time
+                return;
+            }
+            record.data.assign(data, data + bytes);
+        }
+    }
+
+    last_output_shapes_.resize(ctx.GetOutputCount());
+    for (uint32_t i = 0; i < ctx.GetOutputCount(); ++i) {
+        last_output_shapes_[i] = *ctx.GetOutput<TensorImpl>(i)->GetShape();
+    }
+
+    has_last_reshape_ = true;
+}
+
 RetCode X86Kernel::BeforeExecute(KernelExecContext* ctx) {
+    // shape inference is skipped when inputs are the same as the last run, which is the common case in serving
+    if (!OutputShapesDependOnInputData() && InputsMatchLastReshape(*ctx)) {
+        for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+            *ctx->GetOutput<TensorImpl>(i)->GetShape() = last_output_shapes_[i];
+        }
+        return RC_SUCCESS;
+    }
+
     auto status = Reshape(ctx);
     if (status != RC_SUCCESS) {
+        has_last_reshape_ = false;
         LOG(ERROR) << "reshape kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
         return status;
     }
 
+    if (!OutputShapesDependOnInputData()) {
+        SaveLastReshape(*ctx);
+    }
+
     return RC_SUCCESS;
 }
 
+// outputs are placed in in-place buffers of their consumers if sizes are the same as the ones laid out by the consumers
+void X86Kernel::PlaceOutputsInplace(KernelExecContext* ctx) {
+    auto& targets = common_param_->output_inplace_targets;
+    for (uint32_t i = 0; i < targets.size(); ++i) {
+        auto& target = targets[i];
+        if (target.nid == INVALID_NODEID) {
+            continue;
+        }
+
+        auto buffer = GetX86Device()->GetInplaceBuffer(target.nid);
+        if (!buffer || target.slot >= buffer->slot_bytes.size()) {
+            continue;
+        }
+
+        auto tensor = ctx->GetOutput<TensorImpl>(i);
+        auto bytes = buffer->slot_bytes[target.slot];
+        if (!tensor || bytes == 0 || tensor->GetShape()->GetBytesIncludingPadding() != bytes) {
+            continue;
+        }
+
+        tensor->SetPlannedBuffer(BufferDesc((char*)buffer->addr + buffer->slot_offsets[target.slot]), bytes);
+    }
+}
+
 bool X86Kernel::CanDoExecute(const KernelExecContext& ctx) const {
     for (uint32_t i = 0; i < ctx.GetInputCount(); ++i) {
         auto tensor = ctx.GetInput<TensorImpl>(i);
@@ -50,12 +161,18 @@ RetCode X86Kernel::Execute(KernelExecContext* ctx) {
     utils::CpuTimingGuard __timing_guard__(&begin_ts_, &end_ts_, ctx->IsProfilingEnabled());
 #endif
 
+    OmpThreadPoolGuard __thread_pool_guard__(GetX86Device()->GetThreadPool());
+
     auto status = BeforeExecute(ctx);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "BeforeExecute() of kernel[" << GetName() << "] failed: " << GetRetCodeStr(status);
         return status;
     }
 
+    if (common_param_) {
+        PlaceOutputsInplace(ctx);
+    }
+
     if (CanDoExecute(*ctx)) {
         status = DoExecute(ctx);
     } else {
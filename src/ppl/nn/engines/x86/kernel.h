@@ -24,6 +24,7 @@
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/engines/x86/x86_common_param.h"
 #include "ppl/common/sys.h"
+#include <vector>
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
 #include <chrono>
@@ -53,6 +54,14 @@ public:
 protected:
     virtual bool CanDoExecute(const KernelExecContext&) const;
 
+    /**
+       @brief returns true if output shapes may change while input shapes do not, e.g. NonZero.
+       values of small inputs, such as the `shape` of Reshape, are already taken into account.
+    */
+    virtual bool OutputShapesDependOnInputData() const {
+        return false;
+    }
+
     virtual ppl::common::RetCode DoExecute(KernelExecContext*) = 0;
     virtual uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const {
         return 0;
@@ -86,10 +95,25 @@ private:
 
 private:
     ppl::common::RetCode BeforeExecute(KernelExecContext*);
+    void PlaceOutputsInplace(KernelExecContext*);
+    bool InputsMatchLastReshape(const KernelExecContext&) const;
+    void SaveLastReshape(const KernelExecContext&);
 
 private:
+    struct InputRecord final {
+        bool exists = false;
+        TensorShape shape;
+        std::vector<char> data; // only for inputs no larger than `kMaxRecordedInputBytes`
+    };
+    static const uint64_t kMaxRecordedInputBytes = 128;
+
     const X86CommonParam* common_param_ = nullptr;
     std::function<ppl::common::RetCode(InputOutputInfo*)> reshape_func_;
+
+    // inputs and output shapes of the last successful reshaping
+    bool has_last_reshape_ = false;
+    std::vector<InputRecord> last_inputs_;
+    std::vector<TensorShape> last_output_shapes_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -20,6 +20,7 @@
 #include "ppl/kernel/x86/fp32/concat.h"
 #include "ppl/kernel/x86/int64/concat.h"
 #include "ppl/kernel/x86/bool/concat.h"
+#include <string.h> // memcpy
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -60,14 +61,76 @@ ppl::common::RetCode ConcatKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("axis: %d\n", param_->axis);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
+    const int32_t real_axis =
+        param_->axis < 0 ? param_->axis + ctx->GetInput<TensorImpl>(0)->GetShape()->GetDimCount() : param_->axis;
+
+    InplaceBuffer* inplace_buffer = nullptr;
+    if (inplace_) {
+        inplace_buffer = GetX86Device()->GetInplaceBuffer(GetNode()->GetId());
+    }
+    if (!inplace_buffer) {
+        return DoConcat(ctx, real_axis, concat_result);
+    }
+
+    uint64_t total_bytes = 0;
+    bool can_be_inplace = CalcInplaceSlots(src_shape_list_.data(), ctx->GetInputCount(), real_axis, &slot_offsets_,
+                                           &slot_bytes_);
+    if (can_be_inplace) {
+        total_bytes = slot_offsets_.back() + slot_bytes_.back();
+        can_be_inplace = (total_bytes == concat_result->GetShape()->GetBytesIncludingPadding());
+    }
+
+    if (can_be_inplace && inplace_buffer->addr && slot_offsets_ == inplace_buffer->slot_offsets &&
+        slot_bytes_ == inplace_buffer->slot_bytes) {
+        return ConcatInplace(ctx, *inplace_buffer, concat_result);
+    }
+
+    auto status = DoConcat(ctx, real_axis, concat_result);
+    if (status != ppl::common::RC_SUCCESS) {
+        return status;
+    }
+
+    // inputs may be in the old buffer, so the layout is changed after concatenating.
+    inplace_buffer->slot_offsets.clear();
+    inplace_buffer->slot_bytes.clear();
+    if (can_be_inplace) {
+        status = GetX86Device()->ReserveInplaceBuffer(total_bytes, inplace_buffer);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "ReserveInplaceBuffer of kernel[" << GetName()
+                       << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
+        inplace_buffer->slot_offsets = slot_offsets_;
+        inplace_buffer->slot_bytes = slot_bytes_;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+// inputs are copied only if their producers did not write them into the buffer
+ppl::common::RetCode ConcatKernel::ConcatInplace(KernelExecContext* ctx, const InplaceBuffer& inplace_buffer,
+                                                 TensorImpl* concat_result) {
+    for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
+        auto dst = (char*)inplace_buffer.addr + inplace_buffer.slot_offsets[i];
+        if (src_list_[i] != dst && inplace_buffer.slot_bytes[i] > 0) {
+            memcpy(dst, src_list_[i], inplace_buffer.slot_bytes[i]);
+        }
+    }
+
+    concat_result->SetBuffer(BufferDesc(inplace_buffer.addr));
+    PPLNN_X86_DEBUG_TRACE("Output [concat_result]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(concat_result);
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode ConcatKernel::DoConcat(KernelExecContext* ctx, int32_t real_axis, TensorImpl* concat_result) {
     PPLNN_X86_REALLOC_TENSOR_BUFFER(concat_result);
     PPLNN_X86_DEBUG_TRACE("Output [concat_result]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(concat_result);
 
     auto data_type = concat_result->GetShape()->GetDataType();
     auto data_format = concat_result->GetShape()->GetDataFormat();
-    const int32_t real_axis =
-        param_->axis < 0 ? param_->axis + ctx->GetInput<TensorImpl>(0)->GetShape()->GetDimCount() : param_->axis;
 
     if (ppl::common::GetSizeOfDataType(data_type) == 4 && data_format == ppl::common::DATAFORMAT_N16CX &&
         real_axis == 1 && MayUseISA(ppl::common::ISA_X86_AVX)) {
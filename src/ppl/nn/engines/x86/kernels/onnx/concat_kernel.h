@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_CONCAT_KERNEL_H_
 
 #include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/inplace_buffer.h"
 #include "ppl/nn/params/onnx/concat_param.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -31,15 +32,25 @@ public:
         param_ = p;
     }
 
+    void SetInplace(bool inplace) {
+        inplace_ = inplace;
+    }
+
 private:
     uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
     bool CanDoExecute(const KernelExecContext&) const override;
 
+    ppl::common::RetCode DoConcat(KernelExecContext*, int32_t real_axis, TensorImpl* concat_result);
+    ppl::common::RetCode ConcatInplace(KernelExecContext*, const InplaceBuffer&, TensorImpl* concat_result);
+
 private:
+    bool inplace_ = false;
     const ppl::nn::common::ConcatParam* param_ = nullptr;
     std::vector<const void*> src_list_;
     std::vector<const TensorShape*> src_shape_list_;
+    std::vector<uint64_t> slot_offsets_;
+    std::vector<uint64_t> slot_bytes_;
 };
 
 }}} // namespace ppl::nn::x86
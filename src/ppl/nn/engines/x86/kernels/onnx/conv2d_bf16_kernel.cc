@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_bf16_kernel.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t Conv2dBf16Kernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    auto x = ctx.GetInput<TensorImpl>(0);
+    auto y = ctx.GetOutput<TensorImpl>(0);
+    return param_->mgr->cal_temp_buffer_size(*x->GetShape(), *y->GetShape());
+}
+
+ppl::common::RetCode Conv2dBf16Kernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(X, 0);
+    PPLNN_X86_REQUIRED_OUTPUT(Y, 0);
+
+    const ppl::kernel::x86::conv2d_bf16_param& param = param_->mgr->param();
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [X]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(X);
+    PPLNN_X86_DEBUG_TRACE("kernel_shape: %ld %ld\n", param.kernel_h, param.kernel_w);
+    PPLNN_X86_DEBUG_TRACE("dilations: %ld %ld\n", param.dilation_h, param.dilation_w);
+    PPLNN_X86_DEBUG_TRACE("strides: %ld %ld\n", param.stride_h, param.stride_w);
+    PPLNN_X86_DEBUG_TRACE("pads: %ld %ld\n", param.pad_h, param.pad_w);
+    PPLNN_X86_DEBUG_TRACE("group: %ld\n", param.group);
+    PPLNN_X86_DEBUG_TRACE("channels: %ld\n", param.channels);
+    PPLNN_X86_DEBUG_TRACE("num_output: %ld\n", param.num_output);
+    PPLNN_X86_DEBUG_TRACE("fuse_flag: %ld\n", param.fuse_flag);
+    PPLNN_X86_DEBUG_TRACE("bf16 isa: %u\n", param_->mgr->isa());
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+
+    auto rc = param_->mgr->execute(*X->GetShape(), X->GetBufferPtr<float>(), *Y->GetShape(),
+                                   Y->GetBufferPtr<float>(), tmp_buffer);
+    if (rc != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
@@ -22,12 +22,16 @@ namespace ppl { namespace nn { namespace x86 {
 
 uint64_t ConvTransposeKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
     auto x = ctx.GetInput<TensorImpl>(0);
+    if (n16cx_param_ && x->GetShape()->GetDataFormat() == ppl::common::DATAFORMAT_N16CX) {
+        return 0;
+    }
 
     const int32_t batch = x->GetShape()->GetDim(0);
     const int32_t src_h = x->GetShape()->GetDim(2);
     const int32_t src_w = x->GetShape()->GetDim(3);
-    const int32_t num_outputs = ctx.GetInput<TensorImpl>(1)->GetShape()->GetDim(0);
-    const int32_t channels = x->GetShape()->GetDim(1);
+    // the ndarray kernels run a group at a time
+    const int32_t num_outputs = ctx.GetInput<TensorImpl>(1)->GetShape()->GetDim(1);
+    const int32_t channels = x->GetShape()->GetDim(1) / param_->group;
 
     if (false) {
     }
@@ -53,6 +57,36 @@ uint64_t ConvTransposeKernel::CalcTmpBufferSize(const KernelExecContext& ctx) co
     return 0;
 }
 
+ppl::common::RetCode ConvTransposeKernel::ExecuteNdarrayGroup(const float* x, const float* w, const float* b,
+                                                              int32_t batch, int32_t channels, int32_t num_output,
+                                                              int32_t src_h, int32_t src_w, int32_t dst_h,
+                                                              int32_t dst_w, float* tmp_buffer, float* y) {
+    if (false) {
+    }
+#ifdef PPL_USE_X86_AVX512
+    else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+        return kernel::x86::conv_transpose_ndarray_fp32_avx512(
+            x, w, b, src_h, src_w, dst_h, dst_w, batch, channels, num_output, param_->kernel_shape[0],
+            param_->kernel_shape[1], param_->strides[0], param_->strides[1], param_->pads[0], param_->pads[1],
+            param_->dilations[0], param_->dilations[1], tmp_buffer, y);
+    }
+#endif
+    else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+        return kernel::x86::conv_transpose_ndarray_fp32_fma(
+            x, w, b, src_h, src_w, dst_h, dst_w, batch, channels, num_output, param_->kernel_shape[0],
+            param_->kernel_shape[1], param_->strides[0], param_->strides[1], param_->pads[0], param_->pads[1],
+            param_->dilations[0], param_->dilations[1], tmp_buffer, y);
+    } else if (MayUseISA(ppl::common::ISA_X86_SSE)) {
+        return kernel::x86::conv_transpose_ndarray_fp32_sse(
+            x, w, b, src_h, src_w, dst_h, dst_w, batch, channels, num_output, param_->kernel_shape[0],
+            param_->kernel_shape[1], param_->strides[0], param_->strides[1], param_->pads[0], param_->pads[1],
+            param_->dilations[0], param_->dilations[1], tmp_buffer, y);
+    }
+
+    LOG(ERROR) << "unsupported isa: " << GetISA();
+    return ppl::common::RC_UNSUPPORTED;
+}
+
 ppl::common::RetCode ConvTransposeKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_REQUIRED_INPUT(X, 0);
     PPLNN_X86_REQUIRED_INPUT(W, 1);
@@ -111,33 +145,44 @@ ppl::common::RetCode ConvTransposeKernel::DoExecute(KernelExecContext* ctx) {
     const auto data_type = X->GetShape()->GetDataType();
 
     if (data_type == ppl::common::DATATYPE_FLOAT32) {
-        if (data_format == ppl::common::DATAFORMAT_NDARRAY) {
-            if (false) {
+        if (data_format == ppl::common::DATAFORMAT_N16CX && n16cx_param_) {
+            PPLNN_X86_DEBUG_TRACE("fuse_flag: %lu\n", n16cx_param_->fuse_flag);
+            return kernel::x86::conv_transpose_n16cx_fp32_fma(
+                X->GetBufferPtr<float>(), n16cx_param_->cvt_filter, n16cx_param_->cvt_bias, src_h, src_w, dst_h,
+                dst_w, batch, channels, num_output, param_->kernel_shape[0], param_->kernel_shape[1],
+                param_->strides[0], param_->strides[1], param_->pads[0], param_->pads[1], param_->dilations[0],
+                param_->dilations[1], n16cx_param_->fuse_flag, Y->GetBufferPtr<float>());
+        } else if (data_format == ppl::common::DATAFORMAT_NDARRAY) {
+            const int64_t group = param_->group;
+            if (group < 1 || channels % group != 0) {
+                LOG(ERROR) << "channels[" << channels << "] is not a multiple of group[" << group << "].";
+                return ppl::common::RC_INVALID_VALUE;
             }
-#ifdef PPL_USE_X86_AVX512
-            if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
-                return kernel::x86::conv_transpose_ndarray_fp32_avx512(
-                    X->GetBufferPtr<float>(), W->GetBufferPtr<float>(), b_data, src_h, src_w, dst_h, dst_w, batch,
-                    channels, num_output, param_->kernel_shape[0], param_->kernel_shape[1], param_->strides[0],
-                    param_->strides[1], param_->pads[0], param_->pads[1], param_->dilations[0], param_->dilations[1],
-                    (float*)tmp_buffer, Y->GetBufferPtr<float>());
+            if (group == 1) {
+                return ExecuteNdarrayGroup(X->GetBufferPtr<float>(), W->GetBufferPtr<float>(), b_data, batch,
+                                           channels, num_output, src_h, src_w, dst_h, dst_w, (float*)tmp_buffer,
+                                           Y->GetBufferPtr<float>());
             }
-#endif
-            else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
-                return kernel::x86::conv_transpose_ndarray_fp32_fma(
-                    X->GetBufferPtr<float>(), W->GetBufferPtr<float>(), b_data, src_h, src_w, dst_h, dst_w, batch,
-                    channels, num_output, param_->kernel_shape[0], param_->kernel_shape[1], param_->strides[0],
-                    param_->strides[1], param_->pads[0], param_->pads[1], param_->dilations[0], param_->dilations[1],
-                    (float*)tmp_buffer, Y->GetBufferPtr<float>());
-            } else if (MayUseISA(ppl::common::ISA_X86_SSE)) {
-                return kernel::x86::conv_transpose_ndarray_fp32_sse(
-                    X->GetBufferPtr<float>(), W->GetBufferPtr<float>(), b_data, src_h, src_w, dst_h, dst_w, batch,
-                    channels, num_output, param_->kernel_shape[0], param_->kernel_shape[1], param_->strides[0],
-                    param_->strides[1], param_->pads[0], param_->pads[1], param_->dilations[0], param_->dilations[1],
-                    (float*)tmp_buffer, Y->GetBufferPtr<float>());
-            } else {
-                LOG(ERROR) << "unsupported isa: " << GetISA();
+
+            // channels of a group are not contiguous across images, so every image runs group by group
+            const int32_t group_channels = channels / group;
+            const int64_t src_group_len = int64_t(group_channels) * src_h * src_w;
+            const int64_t dst_group_len = int64_t(num_output) * dst_h * dst_w;
+            const int64_t flt_group_len = int64_t(group_channels) * num_output * param_->kernel_shape[0] *
+                param_->kernel_shape[1];
+            for (int64_t b = 0; b < batch; ++b) {
+                for (int64_t g = 0; g < group; ++g) {
+                    auto status = ExecuteNdarrayGroup(
+                        X->GetBufferPtr<float>() + (b * group + g) * src_group_len,
+                        W->GetBufferPtr<float>() + g * flt_group_len, b_data ? b_data + g * num_output : nullptr, 1,
+                        group_channels, num_output, src_h, src_w, dst_h, dst_w, (float*)tmp_buffer,
+                        Y->GetBufferPtr<float>() + (b * group + g) * dst_group_len);
+                    if (status != ppl::common::RC_SUCCESS) {
+                        return status;
+                    }
+                }
             }
+            return ppl::common::RC_SUCCESS;
         } else {
             LOG(ERROR) << "unsupported data format: " << ppl::common::GetDataFormatStr(data_format) << ".";
         }
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/engines/x86/kernel.h"
 #include "ppl/nn/params/onnx/convtranspose_param.h"
+#include "ppl/nn/engines/x86/params/conv_transpose_param.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -31,12 +32,23 @@ public:
         param_ = p;
     }
 
+    // W and B are constants converted by ConvTransposeOp, and X and Y are N16CX
+    void SetN16cxParam(const ConvTransposeN16cxParam* p) {
+        n16cx_param_ = p;
+    }
+
 private:
     uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
+    // runs one group of the ndarray kernels, whose channels and num_output are those of a group
+    ppl::common::RetCode ExecuteNdarrayGroup(const float* x, const float* w, const float* b, int32_t batch,
+                                             int32_t channels, int32_t num_output, int32_t src_h, int32_t src_w,
+                                             int32_t dst_h, int32_t dst_w, float* tmp_buffer, float* y);
+
 private:
     const ppl::nn::common::ConvTransposeParam* param_ = nullptr;
+    const ConvTransposeN16cxParam* n16cx_param_ = nullptr;
 };
 
 }}} // namespace ppl::nn::x86
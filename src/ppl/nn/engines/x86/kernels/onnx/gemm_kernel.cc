@@ -17,6 +17,7 @@
 
 #include "ppl/nn/engines/x86/kernels/onnx/gemm_kernel.h"
 #include "ppl/kernel/x86/fp32/gemm_v2.h"
+#include "ppl/kernel/x86/bf16/gemm_v2.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -41,6 +42,7 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("alpha: %f\n", param_->alpha);
     PPLNN_X86_DEBUG_TRACE("beta: %f\n", param_->beta);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+    PPLNN_X86_DEBUG_TRACE("use_bf16: %d\n", use_bf16_);
 
     PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
     PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
@@ -110,6 +112,23 @@ ppl::common::RetCode GemmKernel::DoExecute(KernelExecContext* ctx) {
         }
     }
 
+    if (use_bf16_) {
+        BufferDesc tmp_buffer_desc;
+        uint64_t tmp_buffer_size = ppl::kernel::x86::gemm_v2_bf16_get_buffer_bytes(param);
+        auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                       << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
+        BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+            GetX86Device()->FreeTmpBuffer(buffer);
+        });
+        PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer_desc.addr);
+
+        return ppl::kernel::x86::gemm_v2_bf16(bf16_isa_, param, tmp_buffer_desc.addr);
+    }
+
     auto executor =
         std::unique_ptr<ppl::kernel::x86::gemm_v2_executor_fp32>(ppl::kernel::x86::create_gemm_v2_executor_fp32(param));
     if (!executor) {
@@ -20,6 +20,7 @@
 
 #include "ppl/nn/engines/x86/kernel.h"
 #include "ppl/nn/params/onnx/gemm_param.h"
+#include "ppl/kernel/x86/bf16/gemm_bf16.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -33,6 +34,11 @@ public:
     void SetFuseReLU(bool fuse_relu) {
         gemm_fuse_relu_ = fuse_relu;
     }
+    /** @brief runs with bf16 multiplication on `isa` instead of fp32 */
+    void SetBf16Isa(ppl::kernel::x86::gemm_bf16_isa_t isa) {
+        use_bf16_ = true;
+        bf16_isa_ = isa;
+    }
 
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
@@ -40,6 +46,8 @@ private:
 private:
     const ppl::nn::common::GemmParam* param_ = nullptr;
     bool gemm_fuse_relu_ = false;
+    bool use_bf16_ = false;
+    ppl::kernel::x86::gemm_bf16_isa_t bf16_isa_ = ppl::kernel::x86::gemm_bf16_isa::REF;
 };
 
 }}} // namespace ppl::nn::x86
@@ -18,6 +18,8 @@
 #include "ppl/nn/engines/x86/kernels/onnx/lstm_kernel.h"
 #include "ppl/kernel/x86/fp32/lstm.h"
 
+#include <algorithm>
+
 namespace ppl { namespace nn { namespace x86 {
 
 bool LSTMKernel::CanDoExecute(const KernelExecContext& ctx) const {
@@ -41,6 +43,13 @@ uint64_t LSTMKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
     const bool has_Y = ctx.GetOutputCount() > 0 && ctx.GetOutput<TensorImpl>(0);
     const bool has_Y_h = ctx.GetOutputCount() > 1 && ctx.GetOutput<TensorImpl>(1);
     const bool has_Y_c = ctx.GetOutputCount() > 2 && ctx.GetOutput<TensorImpl>(2);
+    if (rnn_param_) {
+        // projection of X stays alive through the recurrence, while fc only needs its buffer before it
+        const uint64_t proj_bytes = (dst_shape_.GetBytesExcludingPadding() + 63) & ~(uint64_t)63;
+        const uint64_t lstm_bytes = kernel::x86::lstm_packed_fp32_fma_get_buffer_bytes(
+            X->GetShape(), direction_, param_->hidden_size, has_Y, has_Y_h, has_Y_c);
+        return proj_bytes + std::max<uint64_t>(executor_->cal_temp_buffer_size(), lstm_bytes);
+    }
     if (MayUseISA(ppl::common::ISA_X86_FMA)) {
         return kernel::x86::lstm_fp32_fma_get_buffer_bytes(
             X->GetShape(), direction_, param_->hidden_size, has_Y, has_Y_h, has_Y_c);
@@ -141,6 +150,31 @@ ppl::common::RetCode LSTMKernel::DoExecute(KernelExecContext* ctx) {
         Y_c_data = Y_c->GetBufferPtr<float>();
     }
 
+    const auto data_type = X->GetShape()->GetDataType();
+    const auto data_format = X->GetShape()->GetDataFormat();
+    const bool use_packed = rnn_param_ && data_type == ppl::common::DATATYPE_FLOAT32 &&
+        data_format == ppl::common::DATAFORMAT_NDARRAY;
+
+    if (use_packed) {
+        const int64_t seq_len = X->GetShape()->GetDim(0);
+        const int64_t batch = X->GetShape()->GetDim(1);
+        const int64_t input_size = X->GetShape()->GetDim(2);
+        src_shape_.SetDataType(ppl::common::DATATYPE_FLOAT32);
+        src_shape_.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+        src_shape_.Reshape({seq_len * batch, input_size});
+        dst_shape_.SetDataType(ppl::common::DATATYPE_FLOAT32);
+        dst_shape_.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+        dst_shape_.Reshape({seq_len * batch, rnn_param_->fc_param->param.num_output});
+
+        executor_->set_src_shape(&src_shape_);
+        executor_->set_dst_shape(&dst_shape_);
+        auto rc = executor_->prepare();
+        if (rc != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(rc);
+            return rc;
+        }
+    }
+
     BufferDesc tmp_buffer_desc;
     auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
     auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
@@ -155,8 +189,23 @@ ppl::common::RetCode LSTMKernel::DoExecute(KernelExecContext* ctx) {
     auto tmp_buffer = tmp_buffer_desc.addr;
     PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
 
-    const auto data_type = X->GetShape()->GetDataType();
-    const auto data_format = X->GetShape()->GetDataFormat();
+    if (use_packed) {
+        // X * W^T + Wb + Rb of all timesteps and directions by one fc
+        float* X_proj = (float*)tmp_buffer;
+        void* rnn_tmp_buffer = (char*)tmp_buffer + ((dst_shape_.GetBytesExcludingPadding() + 63) & ~(uint64_t)63);
+        executor_->set_temp_buffer(rnn_tmp_buffer);
+        executor_->set_src(X->GetBufferPtr<const float>());
+        executor_->set_dst(X_proj);
+        status = executor_->execute();
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
+
+        return kernel::x86::lstm_packed_fp32_fma(
+            X->GetShape(), X_proj, rnn_param_->packed_R, P_data, sequence_lens_data, initial_h_data, initial_c_data,
+            direction_, param_->hidden_size, rnn_tmp_buffer, Y_data, Y_h_data, Y_c_data);
+    }
 
     if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_NDARRAY) {
         if (MayUseISA(ppl::common::ISA_X86_FMA)) {
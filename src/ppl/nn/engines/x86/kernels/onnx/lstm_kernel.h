@@ -20,6 +20,7 @@
 
 #include "ppl/nn/params/onnx/lstm_param.h"
 #include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/params/rnn_param.h"
 #include "ppl/kernel/x86/fp32/lstm.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -27,6 +28,11 @@ namespace ppl { namespace nn { namespace x86 {
 class LSTMKernel : public X86Kernel {
 public:
     LSTMKernel(const ir::Node* node) : X86Kernel(node) {}
+    ~LSTMKernel() {
+        if (executor_) {
+            delete executor_;
+        }
+    }
     bool CanDoExecute(const KernelExecContext& ctx) const override;
 
     void SetParam(const ppl::nn::common::LSTMParam* p) {
@@ -42,12 +48,27 @@ public:
         }
     }
 
+    // W, R and B are constants pre-packed by LSTMOp
+    void SetRNNParam(const RNNParam* p) {
+        rnn_param_ = p;
+        if (executor_) {
+            delete executor_;
+        }
+        executor_ = p->fc_param->mgr->gen_executor();
+    }
+
 private:
     uint64_t CalcTmpBufferSize(const KernelExecContext&) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
     const ppl::nn::common::LSTMParam* param_ = nullptr;
     ppl::kernel::x86::rnn_direction_t direction_;
+
+    const RNNParam* rnn_param_ = nullptr;
+    ppl::kernel::x86::fc_fp32_executor* executor_ = nullptr;
+    // 2-D views of X and the projection of X passed to executor_
+    TensorShape src_shape_;
+    TensorShape dst_shape_;
 };
 
 }}} // namespace ppl::nn::x86
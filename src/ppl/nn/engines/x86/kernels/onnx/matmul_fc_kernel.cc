@@ -0,0 +1,160 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/onnx/matmul_fc_kernel.h"
+
+#include <algorithm>
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t MatMulFCKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    // all executors share the same param and shapes
+    return executors_[0]->cal_temp_buffer_size();
+}
+
+ppl::common::RetCode MatMulFCKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(A, 0);
+    PPLNN_X86_REQUIRED_OUTPUT(Y, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [A]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(A);
+
+    const std::vector<int64_t>& b_dims = param_->weight_dims;
+    const uint32_t b_batch_dim_count = b_dims.size() - 2;
+    const int64_t K = b_dims[b_dims.size() - 2];
+    const int64_t N = b_dims[b_dims.size() - 1];
+
+    auto a_shape = A->GetShape();
+    const uint32_t a_dim_count = a_shape->GetDimCount();
+    const uint32_t a_batch_dim_count = a_dim_count > 2 ? a_dim_count - 2 : 0;
+    const int64_t M = a_dim_count > 1 ? a_shape->GetDim(a_dim_count - 2) : 1;
+    if (a_shape->GetDim(a_dim_count - 1) != K) {
+        LOG(ERROR) << "last dim of A[" << a_shape->GetDim(a_dim_count - 1) << "] != K[" << K << "]";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    PPLNN_X86_DEBUG_TRACE("M: %ld, K: %ld, N: %ld\n", M, K, N);
+    PPLNN_X86_DEBUG_TRACE("weight batch: %lu\n", executors_.size());
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    // a constant B with a single matrix lets all leading dims of A be folded into M
+    const int64_t rows = executors_.size() == 1 ? (int64_t)(a_shape->GetElementsExcludingPadding() / K) : M;
+    src_shape_.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    src_shape_.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    src_shape_.Reshape({rows, K});
+    dst_shape_.SetDataType(ppl::common::DATATYPE_FLOAT32);
+    dst_shape_.SetDataFormat(ppl::common::DATAFORMAT_NDARRAY);
+    dst_shape_.Reshape({rows, N});
+
+    ppl::common::RetCode rc;
+    for (auto e : executors_) {
+        e->set_src_shape(&src_shape_);
+        e->set_dst_shape(&dst_shape_);
+        rc = e->prepare();
+        if (ppl::common::RC_SUCCESS != rc) {
+            LOG(ERROR) << "Prepare failed: " << ppl::common::GetRetCodeStr(rc);
+            return rc;
+        }
+    }
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    rc = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (rc != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(rc);
+        return rc;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+
+    const float* src = A->GetBufferPtr<float>();
+    float* dst = Y->GetBufferPtr<float>();
+
+    if (executors_.size() == 1) {
+        auto e = executors_[0];
+        e->set_temp_buffer(tmp_buffer);
+        e->set_src(src);
+        e->set_dst(dst);
+        rc = e->execute();
+        if (ppl::common::RC_SUCCESS != rc) {
+            LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+            return rc;
+        }
+        return ppl::common::RC_SUCCESS;
+    }
+
+    // broadcast batch dims of A and B, aligned to the right
+    const uint32_t batch_dim_count = std::max(a_batch_dim_count, b_batch_dim_count);
+    std::vector<int64_t> out_batch_dims(batch_dim_count, 1);
+    std::vector<int64_t> a_batch_strides(batch_dim_count, 0);
+    std::vector<int64_t> b_batch_strides(batch_dim_count, 0);
+    int64_t a_stride = 1, b_stride = 1;
+    for (int64_t i = (int64_t)batch_dim_count - 1; i >= 0; --i) {
+        const int64_t a_i = i - (batch_dim_count - a_batch_dim_count);
+        const int64_t b_i = i - (batch_dim_count - b_batch_dim_count);
+        const int64_t a_dim = a_i >= 0 ? a_shape->GetDim(a_i) : 1;
+        const int64_t b_dim = b_i >= 0 ? b_dims[b_i] : 1;
+        if (a_dim != b_dim && a_dim != 1 && b_dim != 1) {
+            LOG(ERROR) << "batch dims of A and B cannot be broadcast.";
+            return ppl::common::RC_INVALID_VALUE;
+        }
+        out_batch_dims[i] = std::max(a_dim, b_dim);
+        a_batch_strides[i] = a_dim == 1 ? 0 : a_stride;
+        b_batch_strides[i] = b_dim == 1 ? 0 : b_stride;
+        a_stride *= a_dim;
+        b_stride *= b_dim;
+    }
+
+    int64_t out_batch = 1;
+    for (auto d : out_batch_dims) {
+        out_batch *= d;
+    }
+
+    for (int64_t ob = 0; ob < out_batch; ++ob) {
+        int64_t a_batch = 0, b_batch = 0;
+        int64_t idx = ob;
+        for (int64_t i = (int64_t)batch_dim_count - 1; i >= 0; --i) {
+            const int64_t pos = idx % out_batch_dims[i];
+            idx /= out_batch_dims[i];
+            a_batch += pos * a_batch_strides[i];
+            b_batch += pos * b_batch_strides[i];
+        }
+
+        auto e = executors_[b_batch];
+        e->set_temp_buffer(tmp_buffer);
+        e->set_src(src + a_batch * M * K);
+        e->set_dst(dst + ob * M * N);
+        rc = e->execute();
+        if (ppl::common::RC_SUCCESS != rc) {
+            LOG(ERROR) << "Execute failed: " << ppl::common::GetRetCodeStr(rc);
+            return rc;
+        }
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,65 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_MATMUL_FC_KERNEL_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_MATMUL_FC_KERNEL_H_
+
+#include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/params/matmul_fc_param.h"
+#include "ppl/kernel/x86/fp32/fc.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @brief MatMul with a constant B whose matrices are pre-packed by fc managers.
+   A is viewed as [M, K] matrices, which are broadcast against the leading dims of B.
+*/
+class MatMulFCKernel : public X86Kernel {
+public:
+    MatMulFCKernel(const ir::Node* node) : X86Kernel(node) {}
+    ~MatMulFCKernel() {
+        for (auto e : executors_) {
+            delete e;
+        }
+    }
+
+    void SetParam(const MatMulFCParam* p) {
+        param_ = p;
+        for (auto e : executors_) {
+            delete e;
+        }
+        executors_.clear();
+        for (auto fc_param : p->fc_params) {
+            executors_.push_back(fc_param->mgr->gen_executor());
+        }
+    }
+
+private:
+    uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
+    ppl::common::RetCode DoExecute(KernelExecContext*) override;
+
+private:
+    const MatMulFCParam* param_ = nullptr;
+    std::vector<ppl::kernel::x86::fc_fp32_executor*> executors_;
+    // 2-D views of A and Y passed to executors
+    TensorShape src_shape_;
+    TensorShape dst_shape_;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
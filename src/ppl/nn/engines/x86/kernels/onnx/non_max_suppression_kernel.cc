@@ -50,11 +50,22 @@ ppl::common::RetCode NonMaxSuppressionKernel::DoExecute(KernelExecContext* ctx)
 
     int64_t real_num_boxes_output = 0;
 
-    auto ret = kernel::x86::nms_ndarray_fp32(boxes->GetBufferPtr<const float>(), scores->GetBufferPtr<const float>(),
-                                             boxes->GetShape()->GetDim(1), boxes->GetShape()->GetDim(0),
-                                             scores->GetShape()->GetDim(1), param_->center_point_box != 0,
-                                             max_output_boxes_per_class, iou_threshold, score_threshold,
-                                             output->GetBufferPtr<int64_t>(), &real_num_boxes_output);
+    auto nms_func = kernel::x86::nms_ndarray_fp32;
+    if (false) {
+    }
+#ifdef PPL_USE_X86_AVX512
+    else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+        nms_func = kernel::x86::nms_ndarray_fp32_avx512;
+    }
+#endif
+    else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+        nms_func = kernel::x86::nms_ndarray_fp32_fma;
+    }
+
+    auto ret = nms_func(boxes->GetBufferPtr<const float>(), scores->GetBufferPtr<const float>(),
+                        boxes->GetShape()->GetDim(1), boxes->GetShape()->GetDim(0), scores->GetShape()->GetDim(1),
+                        param_->center_point_box != 0, max_output_boxes_per_class, iou_threshold, score_threshold,
+                        output->GetBufferPtr<int64_t>(), &real_num_boxes_output);
     if (ret != ppl::common::RC_SUCCESS) {
         ctx->GetOutput<TensorImpl>(0)->GetShape()->Reshape({0, 3});
         return ret;
@@ -32,6 +32,9 @@ public:
     }
 
 private:
+    bool OutputShapesDependOnInputData() const override {
+        return true;
+    }
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
 private:
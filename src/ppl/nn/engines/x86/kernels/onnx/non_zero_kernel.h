@@ -27,6 +27,9 @@ public:
     NonZeroKernel(const ir::Node* node) : X86Kernel(node) {}
 
 private:
+    bool OutputShapesDependOnInputData() const override {
+        return true;
+    }
     uint64_t CalcTmpBufferSize(const KernelExecContext& ctx) const override;
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 };
@@ -21,15 +21,13 @@
 #include "ppl/kernel/x86/fp32/split.h"
 #include "ppl/kernel/x86/int64/split.h"
 #include "ppl/kernel/x86/bool/split.h"
+#include <string.h> // memcpy
 
 namespace ppl { namespace nn { namespace x86 {
 
 ppl::common::RetCode SplitKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_REQUIRED_INPUT(input, 0);
 
-    std::vector<void*> dst_list(ctx->GetOutputCount());
-    std::vector<const TensorShape*> dst_shape_list(ctx->GetOutputCount());
-
     PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
     PPLNN_X86_DEBUG_TRACE("Input [input]:\n");
     PPL_X86_TENSOR_PRINT_DEBUG_MSG(input);
@@ -37,6 +35,78 @@ ppl::common::RetCode SplitKernel::DoExecute(KernelExecContext* ctx) {
     PPLNN_X86_DEBUG_TRACE("axis: %d\n", param_->axis);
     PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
 
+    InplaceBuffer* inplace_buffer = nullptr;
+    if (inplace_) {
+        inplace_buffer = GetX86Device()->GetInplaceBuffer(GetNode()->GetId());
+    }
+    if (!inplace_buffer) {
+        return DoSplit(ctx, input);
+    }
+
+    const int32_t real_axis =
+        param_->axis < 0 ? param_->axis + ctx->GetInput<TensorImpl>(0)->GetShape()->GetDimCount() : param_->axis;
+
+    dst_shape_list_.resize(ctx->GetOutputCount());
+    for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+        dst_shape_list_[i] = ctx->GetOutput<TensorImpl>(i)->GetShape();
+    }
+
+    // the input is the only slot of the buffer and outputs are views of it
+    const uint64_t input_bytes = input->GetShape()->GetBytesIncludingPadding();
+    bool can_be_inplace =
+        CalcInplaceSlots(dst_shape_list_.data(), ctx->GetOutputCount(), real_axis, &slot_offsets_, &slot_bytes_);
+    if (can_be_inplace) {
+        can_be_inplace = (slot_offsets_.back() + slot_bytes_.back() == input_bytes);
+    }
+
+    if (can_be_inplace && inplace_buffer->addr && inplace_buffer->slot_bytes.size() == 1 &&
+        inplace_buffer->slot_bytes[0] == input_bytes) {
+        return SplitInplace(ctx, *inplace_buffer, input);
+    }
+
+    auto status = DoSplit(ctx, input);
+    if (status != ppl::common::RC_SUCCESS) {
+        return status;
+    }
+
+    // the input may be in the old buffer, so the layout is changed after splitting.
+    inplace_buffer->slot_offsets.clear();
+    inplace_buffer->slot_bytes.clear();
+    if (can_be_inplace) {
+        status = GetX86Device()->ReserveInplaceBuffer(input_bytes, inplace_buffer);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "ReserveInplaceBuffer of kernel[" << GetName()
+                       << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return status;
+        }
+        inplace_buffer->slot_offsets.push_back(0);
+        inplace_buffer->slot_bytes.push_back(input_bytes);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+// the input is copied only if its producer did not write it into the buffer
+ppl::common::RetCode SplitKernel::SplitInplace(KernelExecContext* ctx, const InplaceBuffer& inplace_buffer,
+                                               TensorImpl* input) {
+    if (input->GetBufferPtr() != inplace_buffer.addr) {
+        memcpy(inplace_buffer.addr, input->GetBufferPtr(), inplace_buffer.slot_bytes[0]);
+    }
+
+    for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+        auto output = ctx->GetOutput<TensorImpl>(i);
+        output->SetBuffer(BufferDesc((char*)inplace_buffer.addr + slot_offsets_[i]));
+        PPLNN_X86_DEBUG_TRACE("Output [outputs[%u]]:\n", i);
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
+    }
+
+    return ppl::common::RC_SUCCESS;
+}
+
+ppl::common::RetCode SplitKernel::DoSplit(KernelExecContext* ctx, TensorImpl* input) {
+    std::vector<void*> dst_list(ctx->GetOutputCount());
+    std::vector<const TensorShape*> dst_shape_list(ctx->GetOutputCount());
+
     for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
         auto output = ctx->GetOutput<TensorImpl>(i);
         PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
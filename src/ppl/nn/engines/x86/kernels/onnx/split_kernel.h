@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_KERNELS_ONNX_SPLIT_KERNEL_H_
 
 #include "ppl/nn/engines/x86/kernel.h"
+#include "ppl/nn/engines/x86/inplace_buffer.h"
 #include "ppl/nn/params/onnx/split_param.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -31,11 +32,22 @@ public:
         param_ = p;
     }
 
+    void SetInplace(bool inplace) {
+        inplace_ = inplace;
+    }
+
 private:
     ppl::common::RetCode DoExecute(KernelExecContext*) override;
 
+    ppl::common::RetCode DoSplit(KernelExecContext*, TensorImpl* input);
+    ppl::common::RetCode SplitInplace(KernelExecContext*, const InplaceBuffer&, TensorImpl* input);
+
 private:
+    bool inplace_ = false;
     const ppl::nn::common::SplitParam* param_ = nullptr;
+    std::vector<const TensorShape*> dst_shape_list_;
+    std::vector<uint64_t> slot_offsets_;
+    std::vector<uint64_t> slot_bytes_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/ppl/attention_kernel.h"
+#include "ppl/kernel/x86/fp32/attention.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+uint64_t AttentionKernel::CalcTmpBufferSize(const KernelExecContext& ctx) const {
+    return ppl::kernel::x86::scaled_dot_product_attention_fp32_get_buffer_bytes(
+        ctx.GetInput<TensorImpl>(0)->GetShape(), ctx.GetInput<TensorImpl>(1)->GetShape());
+}
+
+ppl::common::RetCode AttentionKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(Q, 0);
+    PPLNN_X86_REQUIRED_INPUT(KT, 1);
+    PPLNN_X86_REQUIRED_INPUT(V, 2);
+    PPLNN_X86_OPTIONAL_INPUT(mask, 3);
+    PPLNN_X86_REQUIRED_OUTPUT(Y, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+    PPLNN_X86_DEBUG_TRACE("Input [Q]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Q);
+    PPLNN_X86_DEBUG_TRACE("Input [KT]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(KT);
+    PPLNN_X86_DEBUG_TRACE("Input [V]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(V);
+    if (mask) {
+        PPLNN_X86_DEBUG_TRACE("Input [mask]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(mask);
+    }
+
+    PPLNN_X86_DEBUG_TRACE("scale: %f\n", param_->scale);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(Y);
+    PPLNN_X86_DEBUG_TRACE("Output [Y]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(Y);
+
+    BufferDesc tmp_buffer_desc;
+    auto tmp_buffer_size = CalcTmpBufferSize(*ctx);
+    auto status = GetX86Device()->AllocTmpBuffer(tmp_buffer_size, &tmp_buffer_desc);
+    if (status != ppl::common::RC_SUCCESS) {
+        LOG(ERROR) << "alloc tmp buffer size[" << tmp_buffer_size << "] for kernel[" << GetName()
+                   << "] failed: " << ppl::common::GetRetCodeStr(status);
+        return status;
+    }
+    BufferDescGuard __tmp_buffer_guard(&tmp_buffer_desc, [this](BufferDesc* buffer) -> void {
+        GetX86Device()->FreeTmpBuffer(buffer);
+    });
+    auto tmp_buffer = tmp_buffer_desc.addr;
+    PPLNN_X86_DEBUG_TRACE("buffer: %p\n", tmp_buffer);
+
+    const TensorShape* mask_shape = mask ? mask->GetShape() : nullptr;
+    const float* mask_ptr = mask ? mask->GetBufferPtr<float>() : nullptr;
+    const auto data_type = Q->GetShape()->GetDataType();
+
+    if (data_type == ppl::common::DATATYPE_FLOAT32 && (!mask || mask_shape->GetDataType() == data_type)) {
+        if (false) {
+        }
+#ifdef PPL_USE_X86_AVX512
+        else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+            return ppl::kernel::x86::scaled_dot_product_attention_fp32_avx512(
+                Q->GetShape(), KT->GetShape(), V->GetShape(), mask_shape, Q->GetBufferPtr<float>(),
+                KT->GetBufferPtr<float>(), V->GetBufferPtr<float>(), mask_ptr, param_->scale, tmp_buffer,
+                Y->GetBufferPtr<float>());
+        }
+#endif
+        else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+            return ppl::kernel::x86::scaled_dot_product_attention_fp32_fma(
+                Q->GetShape(), KT->GetShape(), V->GetShape(), mask_shape, Q->GetBufferPtr<float>(),
+                KT->GetBufferPtr<float>(), V->GetBufferPtr<float>(), mask_ptr, param_->scale, tmp_buffer,
+                Y->GetBufferPtr<float>());
+        } else {
+            return ppl::kernel::x86::scaled_dot_product_attention_fp32(
+                Q->GetShape(), KT->GetShape(), V->GetShape(), mask_shape, Q->GetBufferPtr<float>(),
+                KT->GetBufferPtr<float>(), V->GetBufferPtr<float>(), mask_ptr, param_->scale, tmp_buffer,
+                Y->GetBufferPtr<float>());
+        }
+    } else {
+        LOG(ERROR) << "unsupported data type " << ppl::common::GetDataTypeStr(data_type) << ".";
+    }
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}} // namespace ppl::nn::x86
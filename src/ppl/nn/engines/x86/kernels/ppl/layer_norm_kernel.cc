@@ -0,0 +1,96 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/kernels/ppl/layer_norm_kernel.h"
+#include "ppl/kernel/x86/fp32/layer_norm.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+ppl::common::RetCode LayerNormKernel::DoExecute(KernelExecContext* ctx) {
+    PPLNN_X86_REQUIRED_INPUT(input, 0);
+    PPLNN_X86_OPTIONAL_INPUT(scale, 1);
+    PPLNN_X86_OPTIONAL_INPUT(shift, 2);
+    PPLNN_X86_REQUIRED_OUTPUT(output, 0);
+
+    PPLNN_X86_DEBUG_TRACE("Op: %s\n", GetName().c_str());
+
+    PPLNN_X86_DEBUG_TRACE("Input [input]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(input);
+    if (scale) {
+        PPLNN_X86_DEBUG_TRACE("Input [scale]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(scale);
+    }
+    if (shift) {
+        PPLNN_X86_DEBUG_TRACE("Input [shift]:\n");
+        PPL_X86_TENSOR_PRINT_DEBUG_MSG(shift);
+    }
+
+    PPLNN_X86_DEBUG_TRACE("axis: %d\n", param_->axis);
+    PPLNN_X86_DEBUG_TRACE("epsilon: %f\n", param_->epsilon);
+    PPLNN_X86_DEBUG_TRACE("isa: %u\n", GetISA());
+
+    PPLNN_X86_REALLOC_TENSOR_BUFFER(output);
+    PPLNN_X86_DEBUG_TRACE("Output [output]:\n");
+    PPL_X86_TENSOR_PRINT_DEBUG_MSG(output);
+
+    const int64_t dim_count = input->GetShape()->GetDimCount();
+    const int64_t real_axis = param_->axis < 0 ? param_->axis + dim_count : param_->axis;
+    if (real_axis < 0 || real_axis >= dim_count) {
+        LOG(ERROR) << "invalid axis[" << param_->axis << "] for input of " << dim_count << " dims.";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const uint64_t norm_elems = input->GetShape()->GetElementsFromDimensionExcludingPadding(real_axis);
+    if ((scale && scale->GetShape()->GetElementsExcludingPadding() != norm_elems) ||
+        (shift && shift->GetShape()->GetElementsExcludingPadding() != norm_elems)) {
+        LOG(ERROR) << "scale or shift does not match the normalized dims.";
+        return ppl::common::RC_INVALID_VALUE;
+    }
+
+    const float* scale_ptr = scale ? scale->GetBufferPtr<float>() : nullptr;
+    const float* shift_ptr = shift ? shift->GetBufferPtr<float>() : nullptr;
+    const auto data_type = input->GetShape()->GetDataType();
+    const auto data_format = input->GetShape()->GetDataFormat();
+
+    if (data_type == ppl::common::DATATYPE_FLOAT32 && data_format == ppl::common::DATAFORMAT_NDARRAY) {
+        if (false) {
+        }
+#ifdef PPL_USE_X86_AVX512
+        else if (MayUseISA(ppl::common::ISA_X86_AVX512)) {
+            return ppl::kernel::x86::layer_norm_fp32_avx512(input->GetShape(), input->GetBufferPtr<float>(),
+                                                            scale_ptr, shift_ptr, real_axis, param_->epsilon,
+                                                            output->GetBufferPtr<float>());
+        }
+#endif
+        else if (MayUseISA(ppl::common::ISA_X86_FMA)) {
+            return ppl::kernel::x86::layer_norm_fp32_fma(input->GetShape(), input->GetBufferPtr<float>(), scale_ptr,
+                                                         shift_ptr, real_axis, param_->epsilon,
+                                                         output->GetBufferPtr<float>());
+        } else {
+            return ppl::kernel::x86::layer_norm_fp32(input->GetShape(), input->GetBufferPtr<float>(), scale_ptr,
+                                                     shift_ptr, real_axis, param_->epsilon,
+                                                     output->GetBufferPtr<float>());
+        }
+    } else {
+        LOG(ERROR) << "unsupported data type " << ppl::common::GetDataTypeStr(data_type) << " or format "
+                   << ppl::common::GetDataFormatStr(data_format) << ".";
+    }
+
+    return ppl::common::RC_UNSUPPORTED;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/omp_thread_pool.h"
+#include "ppl/kernel/x86/common/threading_tools.h"
+#include <atomic>
+using namespace std;
+
+namespace ppl { namespace nn { namespace x86 {
+
+static atomic<uint64_t> g_pool_id_seq(0);
+
+// id of the pool that sized and pinned the omp team of this thread, 0 for none
+static thread_local uint64_t g_applied_pool_id = 0;
+// whether the team of this thread may run on any core of the pool
+static thread_local bool g_applied_shared = false;
+
+OmpThreadPool::OmpThreadPool() : id_(++g_pool_id_seq), num_threads_(0), active_count_(0) {}
+
+void OmpThreadPool::Init(uint32_t num_threads, const vector<int32_t>& cores) {
+    num_threads_ = num_threads;
+    cores_.clear();
+    if (!cores.empty()) {
+        if (num_threads_ == 0 || num_threads_ > cores.size()) {
+            num_threads_ = cores.size();
+        }
+        cores_.assign(cores.begin(), cores.begin() + num_threads_);
+    } else if (num_threads_ == 0) {
+        // pins the default too, otherwise a thread keeps the size set by a pool it ran before
+        num_threads_ = ppl::kernel::x86::get_omp_max_threads();
+    }
+    id_ = ++g_pool_id_seq; // forces threads that applied the old settings to apply again
+}
+
+void OmpThreadPool::Acquire() const {
+    // only the first of the concurrent callers pins its workers one per core
+    const bool shared = (active_count_.fetch_add(1) > 0 && !cores_.empty());
+    if (g_applied_pool_id == id_ && g_applied_shared == shared) {
+        return;
+    }
+
+    ppl::kernel::x86::set_omp_num_threads(num_threads_);
+    if (!cores_.empty()) {
+        ppl::kernel::x86::set_omp_core_binding(cores_.data(), cores_.size(), shared ? 2 : 0);
+    }
+
+    g_applied_pool_id = id_;
+    g_applied_shared = shared;
+}
+
+void OmpThreadPool::Release() const {
+    active_count_.fetch_sub(1);
+}
+
+}}} // namespace ppl::nn::x86
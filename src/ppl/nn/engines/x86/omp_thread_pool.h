@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_OMP_THREAD_POOL_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_OMP_THREAD_POOL_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @brief threads used by kernels of one engine context.
+
+   omp keeps a separate team of worker threads for each thread that starts a parallel region,
+   and the team size is also a per-thread setting. `Acquire()` sizes and pins the team of the
+   calling thread according to this pool, so that runtimes running in different threads do not
+   share or migrate each other's workers.
+
+   threads which use the same pool at the same time, e.g. workers of a `ParallelScheduler`, would
+   pin their teams to the same cores one by one. a caller that arrives while another one holds the
+   pool lets its team run on any of the cores instead and leaves the placement to the os.
+*/
+class OmpThreadPool final {
+public:
+    OmpThreadPool();
+
+    /**
+       @param num_threads 0 means omp default, or the number of cores if `cores` is not empty
+       @param cores cpu ids the workers are pinned to, one per thread. empty means no binding.
+    */
+    void Init(uint32_t num_threads, const std::vector<int32_t>& cores);
+
+    uint32_t GetNumThreads() const {
+        return num_threads_;
+    }
+    const std::vector<int32_t>& GetCores() const {
+        return cores_;
+    }
+
+    /**
+       @brief applies this pool to the calling thread. cheap if it is already applied.
+       @note every `Acquire()` must be paired with a `Release()` in the same thread.
+    */
+    void Acquire() const;
+    void Release() const;
+
+private:
+    uint64_t id_;
+    uint32_t num_threads_;
+    std::vector<int32_t> cores_;
+
+    /** number of threads between `Acquire()` and `Release()` */
+    mutable std::atomic<uint32_t> active_count_;
+};
+
+/** @brief holds `pool` in the current scope. `pool` can be nullptr. */
+class OmpThreadPoolGuard final {
+public:
+    OmpThreadPoolGuard(const OmpThreadPool* pool) : pool_(pool) {
+        if (pool_) {
+            pool_->Acquire();
+        }
+    }
+    ~OmpThreadPoolGuard() {
+        if (pool_) {
+            pool_->Release();
+        }
+    }
+
+private:
+    const OmpThreadPool* pool_;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -18,6 +18,8 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/conv_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/conv2d_dynamic_kernel.h"
 #include "ppl/nn/engines/x86/kernels/onnx/conv2d_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_int8_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/conv2d_bf16_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_convolution.h"
 #include "ppl/nn/common/logger.h"
 
@@ -38,6 +40,53 @@ ConvOp::~ConvOp() {
         }
         delete conv2d_param_;
     }
+    if (conv2d_int8_param_ != nullptr) {
+        if (conv2d_int8_param_->mgr != nullptr) {
+            conv2d_int8_param_->mgr->release_cvt_weights();
+        }
+        delete conv2d_int8_param_;
+    }
+    if (conv2d_bf16_param_ != nullptr) {
+        if (conv2d_bf16_param_->mgr != nullptr) {
+            conv2d_bf16_param_->mgr->release_cvt_weights();
+        }
+        delete conv2d_bf16_param_;
+    }
+}
+
+// uses converted weights in `cache` if found, or generates them. either of them is added to `cache` to be exported,
+// so that exporting after importing keeps all convolutions.
+static RetCode GenCvtWeights(const string& name, const ppl::kernel::x86::conv2d_fp32_algo_info& algo_info,
+                             const float* weight_data, const float* bias_data, uint64_t weights_hash,
+                             PackedWeightsCache* cache, ppl::kernel::x86::conv2d_fp32_manager* mgr) {
+    if (cache) {
+        auto cached_info = cache->FindConv2dInfo(name, mgr->param(), weights_hash);
+        if (cached_info) {
+            mgr->set_cvt_filter(cached_info->cvt_filter, cached_info->cvt_filter_size);
+            mgr->set_cvt_bias(cached_info->cvt_bias, cached_info->cvt_bias_size);
+            cache->AddConv2dInfo(name, *cached_info);
+            return RC_SUCCESS;
+        }
+    }
+
+    auto status = mgr->gen_cvt_weights(weight_data, bias_data);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    if (cache) {
+        PackedWeightsCache::Conv2dInfo info;
+        info.param = mgr->param();
+        info.algo_info = algo_info;
+        info.cvt_filter = mgr->cvt_filter();
+        info.cvt_filter_size = mgr->cvt_filter_size();
+        info.cvt_bias = mgr->cvt_bias();
+        info.cvt_bias_size = mgr->cvt_bias_size();
+        info.weights_hash = weights_hash;
+        cache->AddConv2dInfo(name, info);
+    }
+
+    return RC_SUCCESS;
 }
 
 RetCode ConvOp::Init(const OptKernelOptions& options) {
@@ -93,6 +142,91 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
         }
     }
 
+    float src_scale = 0.0f;
+    if (kernel_dims == 2 && GetInt8InputScale(options, &src_scale)) {
+        auto int8_isa = ppl::kernel::x86::gemm_s8u8_select_isa(options.device->GetISA());
+        if (int8_isa == ppl::kernel::x86::gemm_s8u8_isa::REF) {
+            LOG(INFO) << "no int8 instructions available for [" << node->GetName() << "], use fp32 instead.";
+        } else {
+            if (!conv2d_int8_param_) {
+                conv2d_int8_param_ = new Conv2dInt8Param;
+            }
+            if (!conv2d_int8_param_) {
+                return ppl::common::RC_OUT_OF_MEMORY;
+            }
+
+            ppl::kernel::x86::conv2d_int8_param& int8_param = conv2d_int8_param_->param;
+            int8_param.kernel_h = conv_param.kernel_shape[0];
+            int8_param.kernel_w = conv_param.kernel_shape[1];
+            int8_param.stride_h = conv_param.strides[0];
+            int8_param.stride_w = conv_param.strides[1];
+            int8_param.pad_h = conv_param.pads[0];
+            int8_param.pad_w = conv_param.pads[1];
+            int8_param.dilation_h = conv_param.dilations[0];
+            int8_param.dilation_w = conv_param.dilations[1];
+            int8_param.group = conv_param.group;
+            int8_param.num_output = conv_param.num_output;
+            int8_param.channels = conv_param.channels;
+            int8_param.src_scale = src_scale;
+            int8_param.fuse_flag = 0;
+
+            if (conv2d_int8_param_->mgr) {
+                delete conv2d_int8_param_->mgr;
+            }
+            conv2d_int8_param_->mgr =
+                new ppl::kernel::x86::conv2d_int8_manager(int8_param, int8_isa, options.device->GetAllocator());
+            auto status = conv2d_int8_param_->mgr->gen_cvt_weights(weight_data, bias_data);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "gen int8 cvt weights for [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            return RC_SUCCESS;
+        }
+    }
+
+    // bf16 only pays off when both gemm dims are wide enough, depthwise and tiny convs stay in fp32
+    const int64_t bf16_oc_g = conv_param.num_output / conv_param.group;
+    const int64_t bf16_k = conv_param.channels / conv_param.group * weight_shape.dims[2] * weight_shape.dims[3];
+    if (kernel_dims == 2 && options.forward_precision == DATATYPE_BFLOAT16 && bf16_oc_g >= 16 && bf16_k >= 32) {
+        auto bf16_isa = ppl::kernel::x86::gemm_bf16_select_isa(options.device->GetISA());
+        if (bf16_isa == ppl::kernel::x86::gemm_bf16_isa::REF) {
+            LOG(INFO) << "no bf16 instructions available for [" << node->GetName() << "], use fp32 instead.";
+        } else {
+            if (!conv2d_bf16_param_) {
+                conv2d_bf16_param_ = new Conv2dBf16Param;
+            }
+            if (!conv2d_bf16_param_) {
+                return ppl::common::RC_OUT_OF_MEMORY;
+            }
+
+            ppl::kernel::x86::conv2d_bf16_param& bf16_param = conv2d_bf16_param_->param;
+            bf16_param.kernel_h = conv_param.kernel_shape[0];
+            bf16_param.kernel_w = conv_param.kernel_shape[1];
+            bf16_param.stride_h = conv_param.strides[0];
+            bf16_param.stride_w = conv_param.strides[1];
+            bf16_param.pad_h = conv_param.pads[0];
+            bf16_param.pad_w = conv_param.pads[1];
+            bf16_param.dilation_h = conv_param.dilations[0];
+            bf16_param.dilation_w = conv_param.dilations[1];
+            bf16_param.group = conv_param.group;
+            bf16_param.num_output = conv_param.num_output;
+            bf16_param.channels = conv_param.channels;
+            bf16_param.fuse_flag = 0;
+
+            if (conv2d_bf16_param_->mgr) {
+                delete conv2d_bf16_param_->mgr;
+            }
+            conv2d_bf16_param_->mgr =
+                new ppl::kernel::x86::conv2d_bf16_manager(bf16_param, bf16_isa, options.device->GetAllocator());
+            auto status = conv2d_bf16_param_->mgr->gen_cvt_weights(weight_data, bias_data);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "gen bf16 cvt weights for [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            return RC_SUCCESS;
+        }
+    }
+
     if (kernel_dims == 2) {
         if (!conv2d_param_) {
             conv2d_param_ = new Conv2dParam;
@@ -115,27 +249,71 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
         conv2d_param.channels = conv_param.channels;
         conv2d_param.fuse_flag = 0;
 
-        conv2d_param_->algo_info = ppl::kernel::x86::conv2d_algo_selector::select_algo(
-            info.GetInput<TensorImpl>(0)->GetShape()->GetDataFormat(), conv2d_param_->param, options.device->GetISA());
+        auto cache = options.packed_weights_cache;
+        auto allocator = cache ? cache->GetAllocator() : options.device->GetAllocator();
+
+        std::vector<float> zero_bias;
+        if (bias_data == nullptr) {
+            zero_bias.resize(conv2d_param.num_output, 0.0f);
+            bias_data = zero_bias.data();
+        }
+
+        uint64_t weights_hash = 0;
+        if (cache) {
+            weights_hash = PackedWeightsCache::HashWeights(weight_data, weight_data_it->second.data.size());
+            weights_hash = PackedWeightsCache::HashWeights(bias_data, conv2d_param.num_output * sizeof(float),
+                                                           weights_hash);
+        }
+
+        auto cached_info = cache ? cache->FindConv2dInfo(node->GetName(), conv2d_param, weights_hash) : nullptr;
+        if (cached_info) {
+            conv2d_param_->algo_info = cached_info->algo_info;
+        } else {
+            auto src_shape = info.GetInput<TensorImpl>(0)->GetShape();
+            conv2d_param_->algo_info = ppl::kernel::x86::conv2d_algo_selector::select_algo(
+                src_shape->GetDataFormat(), conv2d_param_->param, options.device->GetISA());
+            if (options.conv2d_algo_tuner &&
+                conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+                conv2d_param_->algo_info = options.conv2d_algo_tuner->Tune(*src_shape, conv2d_param_->param,
+                                                                           conv2d_param_->algo_info, weight_data,
+                                                                           bias_data);
+            }
+        }
 
         if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
             LOG(INFO) << "Conv select algorithm failed, use fallback kernel";
         } else {
             conv2d_param_->mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
-                conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
+                conv2d_param_->param, conv2d_param_->algo_info, allocator);
 
-            // winograd b4f3 avx512 may fallback to direct
-            if (conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3) {
+            // every winograd algo keeps a direct manager as its fallback, and the kernel runs the direct one when
+            // the output has too few tiles to pay for the input/output transforms. tiles are counted in the output
+            // tile size of the selected algo: 2x2 for b2f5, 4x4 for b4f3 and b4f5, 6x6 for b6f3. so the same output
+            // may fall back for one algo and not for another, e.g. 16x16 is 16 aligned tiles for b4f3 but only 9
+            // unaligned tiles for b6f3. the thresholds (10 aligned or 12 unaligned tiles) and the multi-group rules
+            // below were tuned for b4f3 and are shared by all winograd algos.
+            const auto winograd_algo_type = conv2d_param_->algo_info.algo_type;
+            int64_t winograd_tile = 0;
+            if (winograd_algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B2F5) {
+                winograd_tile = 2;
+            } else if (winograd_algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3 ||
+                       winograd_algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F5) {
+                winograd_tile = 4;
+            } else if (winograd_algo_type == ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B6F3) {
+                winograd_tile = 6;
+            }
+            if (winograd_tile > 0) {
                 conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::DIRECT;
                 conv2d_param_->fallback_mgr = ppl::kernel::x86::conv2d_algo_selector::gen_algo(
-                    conv2d_param_->param, conv2d_param_->algo_info, options.device->GetAllocator());
-                conv2d_param_->infer_fallback_func = [](const TensorImpl* X, const TensorImpl* Y,
-                                                        const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
+                    conv2d_param_->param, conv2d_param_->algo_info, allocator);
+                conv2d_param_->infer_fallback_func = [winograd_tile](const TensorImpl* X, const TensorImpl* Y,
+                                                                     const ppl::kernel::x86::conv2d_fp32_param* param) -> bool {
                     const int64_t dst_h = Y->GetShape()->GetDim(2);
                     const int64_t dst_w = Y->GetShape()->GetDim(3);
                     const int64_t batch = X->GetShape()->GetDim(0);
-                    const int64_t num_tiles = batch * ((dst_h + 3) / 4) * ((dst_w + 3) / 4);
-                    const bool align_tiles = (dst_h % 4 == 0) && (dst_w % 4) == 0;
+                    const int64_t num_tiles = batch * ((dst_h + winograd_tile - 1) / winograd_tile) *
+                        ((dst_w + winograd_tile - 1) / winograd_tile);
+                    const bool align_tiles = (dst_h % winograd_tile == 0) && (dst_w % winograd_tile) == 0;
 
                     const int64_t num_threads = ppl::kernel::x86::get_omp_max_threads();
                     if (num_threads > 4) { // Maybe memory bound. Just maybe.
@@ -150,19 +328,24 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
                     }
                     return num_tiles < (align_tiles ? 10 : 12);
                 };
-                conv2d_param_->algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::WINOGRAD_B4F3;
+                conv2d_param_->algo_info.algo_type = winograd_algo_type;
             }
 
-            if (bias_data != nullptr) {
-                conv2d_param_->mgr->gen_cvt_weights(weight_data, bias_data);
-                if (conv2d_param_->fallback_mgr) {
-                    conv2d_param_->fallback_mgr->gen_cvt_weights(weight_data, bias_data);
-                }
-            } else {
-                std::vector<float> zero_bias(conv2d_param.num_output, 0.0f);
-                conv2d_param_->mgr->gen_cvt_weights(weight_data, zero_bias.data());
-                if (conv2d_param_->fallback_mgr) {
-                    conv2d_param_->fallback_mgr->gen_cvt_weights(weight_data, zero_bias.data());
+            auto status = GenCvtWeights(node->GetName(), conv2d_param_->algo_info, weight_data, bias_data,
+                                        weights_hash, cache, conv2d_param_->mgr);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "gen cvt weights for [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            if (conv2d_param_->fallback_mgr) {
+                auto fallback_algo_info = conv2d_param_->algo_info;
+                fallback_algo_info.algo_type = ppl::kernel::x86::conv2d_fp32_algo::DIRECT;
+                status = GenCvtWeights(node->GetName() + ":fallback", fallback_algo_info, weight_data, bias_data,
+                                       weights_hash, cache, conv2d_param_->fallback_mgr);
+                if (status != RC_SUCCESS) {
+                    LOG(ERROR) << "gen fallback cvt weights for [" << node->GetName()
+                               << "] failed: " << GetRetCodeStr(status);
+                    return status;
                 }
             }
         }
@@ -176,6 +359,12 @@ ppl::common::RetCode ConvOp::SelectAlgorithm(const InputOutputInfo& info, const
 
 RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
                              vector<dataformat_t>* selected_output_formats) {
+    // quantization and bf16 rounding are fused into kernels, which take and give fp32 ndarray
+    if (conv2d_int8_param_ || conv2d_bf16_param_) {
+        selected_input_formats->at(0) = DATAFORMAT_NDARRAY;
+        selected_output_formats->at(0) = DATAFORMAT_NDARRAY;
+        return RC_SUCCESS;
+    }
     if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         selected_input_formats->at(0) = conv2d_param_->algo_info.input_format;
         if (conv2d_param_->mgr->param().fuse_flag & ppl::kernel::x86::conv_fuse_flag::SUM) {
@@ -187,7 +376,8 @@ RetCode ConvOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>*
 }
 
 RetCode ConvOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) {
-    if (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
+    if (conv2d_int8_param_ || conv2d_bf16_param_ ||
+        (conv2d_param_ && conv2d_param_->algo_info.algo_type != ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN)) {
         auto weight_id = GetNode()->GetInput(1);
         auto it = constants_data_refcount->find(weight_id);
         if (it != constants_data_refcount->end()) {
@@ -205,6 +395,18 @@ RetCode ConvOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_re
 }
 
 bool ConvOp::TryFuseReLU() {
+    if (conv2d_int8_param_) {
+        ppl::kernel::x86::conv2d_int8_param param = conv2d_int8_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU;
+        conv2d_int8_param_->mgr->set_param(param);
+        return true;
+    }
+    if (conv2d_bf16_param_) {
+        ppl::kernel::x86::conv2d_bf16_param param = conv2d_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU;
+        conv2d_bf16_param_->mgr->set_param(param);
+        return true;
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         return false;
     }
@@ -218,6 +420,18 @@ bool ConvOp::TryFuseReLU() {
 }
 
 bool ConvOp::TryFuseReLU6() {
+    if (conv2d_int8_param_) {
+        ppl::kernel::x86::conv2d_int8_param param = conv2d_int8_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU6;
+        conv2d_int8_param_->mgr->set_param(param);
+        return true;
+    }
+    if (conv2d_bf16_param_) {
+        ppl::kernel::x86::conv2d_bf16_param param = conv2d_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU6;
+        conv2d_bf16_param_->mgr->set_param(param);
+        return true;
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         return false;
     }
@@ -248,6 +462,12 @@ bool ConvOp::TryFuseSum() {
 }
 
 KernelImpl* ConvOp::CreateKernelImpl() const {
+    if (conv2d_int8_param_) {
+        return CreateKernelImplWithParam<Conv2dInt8Kernel>(conv2d_int8_param_);
+    }
+    if (conv2d_bf16_param_) {
+        return CreateKernelImplWithParam<Conv2dBf16Kernel>(conv2d_bf16_param_);
+    }
     if (!conv2d_param_ || conv2d_param_->algo_info.algo_type == ppl::kernel::x86::conv2d_fp32_algo::UNKNOWN) {
         return CreateKernelImplWithParam<Conv2dDynamicKernel>(param_.get());
     }
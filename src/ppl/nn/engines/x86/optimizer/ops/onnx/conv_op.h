@@ -20,6 +20,8 @@
 
 #include "ppl/nn/params/onnx/convolution_param.h"
 #include "ppl/nn/engines/x86/params/conv_param.h"
+#include "ppl/nn/engines/x86/params/conv_int8_param.h"
+#include "ppl/nn/engines/x86/params/conv_bf16_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -27,7 +29,7 @@ namespace ppl { namespace nn { namespace x86 {
 class PostDepthwiseConvOp;
 class ConvOp final : public X86OptKernel {
 public:
-    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr) {}
+    ConvOp(const ir::Node* node) : X86OptKernel(node), conv2d_param_(nullptr), conv2d_int8_param_(nullptr), conv2d_bf16_param_(nullptr) {}
 
     ~ConvOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
@@ -44,6 +46,8 @@ public:
 
 private:
     Conv2dParam* conv2d_param_;
+    Conv2dInt8Param* conv2d_int8_param_; // not nullptr if this conv runs in int8
+    Conv2dBf16Param* conv2d_bf16_param_; // not nullptr if this conv runs in bf16
     std::shared_ptr<ppl::nn::common::ConvolutionParam> param_;
 
     friend PostDepthwiseConvOp;
@@ -19,11 +19,85 @@
 #include "ppl/nn/engines/x86/kernels/onnx/convtranspose_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_convtranspose.h"
 #include "ppl/nn/common/logger.h"
+#include "ppl/kernel/x86/fp32/conv_transpose.h"
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+ConvTransposeOp::~ConvTransposeOp() {
+    if (n16cx_param_ != nullptr) {
+        delete n16cx_param_;
+    }
+}
+
+RetCode ConvTransposeOp::GenN16cxWeights(const OptKernelOptions& options) {
+    if (!(options.device->GetISA() & ISA_X86_FMA)) {
+        return RC_SUCCESS;
+    }
+    if (param_->group != 1 || param_->kernel_shape.size() != 2 || param_->strides.size() != 2 ||
+        param_->dilations.size() != 2 || param_->pads.size() < 2) {
+        return RC_SUCCESS;
+    }
+
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+    auto weight_data_it = graph_data->constants.find(node->GetInput(1));
+    auto weight_shape_it = graph_data->shapes.find(node->GetInput(1));
+    if (weight_data_it == graph_data->constants.end() || weight_shape_it == graph_data->shapes.end() ||
+        weight_shape_it->second.dims.size() != 4 || weight_shape_it->second.data_type != DATATYPE_FLOAT32) {
+        return RC_SUCCESS;
+    }
+
+    const float* bias_data = nullptr;
+    if (node->GetInputCount() > 2 && node->GetInput(2) != INVALID_EDGEID) {
+        auto bias_data_it = graph_data->constants.find(node->GetInput(2));
+        auto bias_shape_it = graph_data->shapes.find(node->GetInput(2));
+        if (bias_data_it == graph_data->constants.end() || bias_shape_it == graph_data->shapes.end() ||
+            bias_shape_it->second.data_type != DATATYPE_FLOAT32) {
+            return RC_SUCCESS;
+        }
+        bias_data = (const float*)bias_data_it->second.data.data();
+    }
+
+    const auto& weight_dims = weight_shape_it->second.dims;
+    const int32_t channels = weight_dims[0];
+    const int32_t num_output = weight_dims[1];
+    const int32_t kernel_h = weight_dims[2];
+    const int32_t kernel_w = weight_dims[3];
+    if (kernel_h != param_->kernel_shape[0] || kernel_w != param_->kernel_shape[1]) {
+        return RC_SUCCESS;
+    }
+
+    auto allocator = options.device->GetAllocator();
+    n16cx_param_ = new ConvTransposeN16cxParam;
+    if (!n16cx_param_) {
+        return RC_OUT_OF_MEMORY;
+    }
+    n16cx_param_->channels = channels;
+    n16cx_param_->num_output = num_output;
+    n16cx_param_->allocator = allocator;
+
+    const uint64_t cvt_filter_bytes =
+        ppl::kernel::x86::conv_transpose_n16cx_fp32_fma_get_cvt_filter_bytes(channels, num_output, kernel_h, kernel_w);
+    const uint64_t cvt_bias_bytes = ppl::kernel::x86::conv_transpose_n16cx_fp32_fma_get_cvt_bias_bytes(num_output);
+    n16cx_param_->cvt_filter = (float*)allocator->Alloc(cvt_filter_bytes);
+    n16cx_param_->cvt_bias = (float*)allocator->Alloc(cvt_bias_bytes);
+    if (!n16cx_param_->cvt_filter || !n16cx_param_->cvt_bias) {
+        LOG(ERROR) << "alloc converted weights of [" << node->GetName() << "] failed.";
+        delete n16cx_param_;
+        n16cx_param_ = nullptr;
+        return RC_OUT_OF_MEMORY;
+    }
+
+    ppl::kernel::x86::conv_transpose_n16cx_fp32_fma_cvt_filter((const float*)weight_data_it->second.data.data(),
+                                                              channels, num_output, kernel_h, kernel_w,
+                                                              n16cx_param_->cvt_filter);
+    ppl::kernel::x86::conv_transpose_n16cx_fp32_fma_cvt_bias(bias_data, num_output, n16cx_param_->cvt_bias);
+
+    return RC_SUCCESS;
+}
+
 RetCode ConvTransposeOp::Init(const OptKernelOptions& options) {
     auto status = GenericLoadParam(options, &param_);
     if (status != RC_SUCCESS) {
@@ -37,11 +111,52 @@ RetCode ConvTransposeOp::Init(const OptKernelOptions& options) {
 
     infer_type_func_ = GenericInferType;
 
+    return GenN16cxWeights(options);
+}
+
+RetCode ConvTransposeOp::SelectFormat(const InputOutputInfo& info, vector<dataformat_t>* selected_input_formats,
+                                      vector<dataformat_t>* selected_output_formats) {
+    if (n16cx_param_) {
+        selected_input_formats->at(0) = DATAFORMAT_N16CX;
+        selected_output_formats->at(0) = DATAFORMAT_N16CX;
+    }
     return RC_SUCCESS;
 }
 
+RetCode ConvTransposeOp::OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) {
+    if (n16cx_param_) {
+        for (uint32_t i = 1; i <= 2 && i < GetNode()->GetInputCount(); ++i) {
+            auto it = constants_data_refcount->find(GetNode()->GetInput(i));
+            if (it != constants_data_refcount->end()) {
+                it->second--;
+            }
+        }
+    }
+    return RC_SUCCESS;
+}
+
+bool ConvTransposeOp::TryFuseReLU() {
+    if (!n16cx_param_) {
+        return false;
+    }
+    n16cx_param_->fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU;
+    return true;
+}
+
+bool ConvTransposeOp::TryFuseReLU6() {
+    if (!n16cx_param_) {
+        return false;
+    }
+    n16cx_param_->fuse_flag |= ppl::kernel::x86::conv_fuse_flag::RELU6;
+    return true;
+}
+
 KernelImpl* ConvTransposeOp::CreateKernelImpl() const {
-    return CreateKernelImplWithParam<ConvTransposeKernel>(param_.get());
+    auto kernel = CreateKernelImplWithParam<ConvTransposeKernel>(param_.get());
+    if (kernel && n16cx_param_) {
+        kernel->SetN16cxParam(n16cx_param_);
+    }
+    return kernel;
 }
 
 }}} // namespace ppl::nn::x86
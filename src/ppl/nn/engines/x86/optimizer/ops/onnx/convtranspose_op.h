@@ -19,18 +19,30 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_CONVTRANSPOSE_OP_H_
 
 #include "ppl/nn/params/onnx/convtranspose_param.h"
+#include "ppl/nn/engines/x86/params/conv_transpose_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
 class ConvTransposeOp final : public X86OptKernel {
 public:
-    ConvTransposeOp(const ir::Node* node) : X86OptKernel(node) {}
+    ConvTransposeOp(const ir::Node* node) : X86OptKernel(node), n16cx_param_(nullptr) {}
+    ~ConvTransposeOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    ppl::common::RetCode SelectFormat(const InputOutputInfo& info,
+                                      std::vector<ppl::common::dataformat_t>* selected_input_formats,
+                                      std::vector<ppl::common::dataformat_t>* selected_output_formats) override;
+    ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) override;
+    bool TryFuseReLU();
+    bool TryFuseReLU6();
+
+private:
+    ppl::common::RetCode GenN16cxWeights(const OptKernelOptions& options);
 
 private:
     std::shared_ptr<ppl::nn::common::ConvTransposeParam> param_;
+    ConvTransposeN16cxParam* n16cx_param_; // not nullptr if W and B are constants and this op runs in N16CX
 };
 
 }}} // namespace ppl::nn::x86
@@ -18,6 +18,8 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gemm_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/gemm_kernel.h"
 #include "ppl/nn/engines/x86/kernels/onnx/fc_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/fc_int8_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/fc_bf16_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_gemm.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
@@ -32,6 +34,44 @@ GemmOp::~GemmOp() {
         }
         delete fc_param_;
     }
+    if (fc_int8_param_ != nullptr) {
+        if (fc_int8_param_->mgr != nullptr) {
+            fc_int8_param_->mgr->release_cvt_weights();
+        }
+        delete fc_int8_param_;
+    }
+    if (fc_bf16_param_ != nullptr) {
+        if (fc_bf16_param_->mgr != nullptr) {
+            fc_bf16_param_->mgr->release_cvt_weights();
+        }
+        delete fc_bf16_param_;
+    }
+}
+
+// fc kernels take a constant 2-D B and only a constant per column bias with unit alpha and beta
+bool GemmOp::IsFcCompatible(const OptKernelOptions& options, const float* weight_data, const float* bias_data) const {
+    if (weight_data == nullptr || param_->alpha != 1.0f || (param_->bias_term && param_->beta != 1.0f)) {
+        return false;
+    }
+
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+    const ir::Shape& weight_shape = graph_data->shapes.find(node->GetInput(1))->second;
+    if (weight_shape.dims.size() != 2) {
+        return false;
+    }
+    if (!param_->bias_term) {
+        return true;
+    }
+
+    const int64_t num_output = param_->transB ? weight_shape.dims[0] : weight_shape.dims[1];
+    const ir::Shape& bias_shape = graph_data->shapes.find(node->GetInput(2))->second;
+    int64_t bias_len = 1;
+    for (auto dim : bias_shape.dims) {
+        bias_len *= dim;
+    }
+    return (bias_data != nullptr && !bias_shape.dims.empty() && bias_shape.dims.size() <= 2 &&
+            bias_shape.dims.back() == num_output && bias_len == num_output);
 }
 
 RetCode GemmOp::Init(const OptKernelOptions& options) {
@@ -60,7 +100,66 @@ RetCode GemmOp::Init(const OptKernelOptions& options) {
 
     param_->bias_term = (node->GetInputCount() == 3) ? 1 : 0;
 
-    if (!param_->transA && param_->transB && weight_data != nullptr) {
+    // bf16 fc takes B in both layouts, and int8 fc takes a transposed B only
+    bool fc_compatible = IsFcCompatible(options, weight_data, bias_data);
+    bool bf16_supported = options.forward_precision == DATATYPE_BFLOAT16 && !param_->transA && fc_compatible;
+    auto bf16_isa = ppl::kernel::x86::gemm_bf16_select_isa(options.device->GetISA());
+    if (bf16_supported && bf16_isa == ppl::kernel::x86::gemm_bf16_isa::REF) {
+        LOG(INFO) << "no bf16 instructions available for [" << node->GetName() << "], use fp32 instead.";
+        bf16_supported = false;
+    }
+
+    // gemms that do not run as fc, e.g. with a non-constant B, use bf16 gemm_v2 instead
+    if (options.forward_precision == DATATYPE_BFLOAT16 && bf16_isa != ppl::kernel::x86::gemm_bf16_isa::REF) {
+        gemm_bf16_isa_ = bf16_isa;
+        gemm_use_bf16_ = true;
+    }
+
+    float src_scale = 0.0f;
+    auto int8_isa = ppl::kernel::x86::gemm_s8u8_select_isa(options.device->GetISA());
+    if (!param_->transA && param_->transB && fc_compatible && GetInt8InputScale(options, &src_scale) &&
+        int8_isa != ppl::kernel::x86::gemm_s8u8_isa::REF) {
+        if (!fc_int8_param_) {
+            fc_int8_param_ = new FCInt8Param;
+        }
+        if (!fc_int8_param_) {
+            return ppl::common::RC_OUT_OF_MEMORY;
+        }
+
+        const ir::Shape& weight_shape = graph_data->shapes.find(node->GetInput(1))->second;
+        fc_int8_param_->param.num_output = weight_shape.dims[0];
+        fc_int8_param_->param.channels = weight_shape.dims[1];
+        fc_int8_param_->param.src_scale = src_scale;
+        fc_int8_param_->param.fuse_flag = 0;
+
+        fc_int8_param_->mgr = new ppl::kernel::x86::fc_int8_manager(fc_int8_param_->param, int8_isa,
+                                                                    options.device->GetAllocator());
+        status = fc_int8_param_->mgr->gen_cvt_weights(weight_data, bias_data);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "gen int8 cvt weights for [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    } else if (bf16_supported) {
+        if (!fc_bf16_param_) {
+            fc_bf16_param_ = new FCBf16Param;
+        }
+        if (!fc_bf16_param_) {
+            return ppl::common::RC_OUT_OF_MEMORY;
+        }
+
+        const ir::Shape& weight_shape = graph_data->shapes.find(node->GetInput(1))->second;
+        fc_bf16_param_->param.num_output = param_->transB ? weight_shape.dims[0] : weight_shape.dims[1];
+        fc_bf16_param_->param.channels = param_->transB ? weight_shape.dims[1] : weight_shape.dims[0];
+        fc_bf16_param_->param.fuse_flag = 0;
+
+        fc_bf16_param_->mgr = new ppl::kernel::x86::fc_bf16_manager(fc_bf16_param_->param, bf16_isa,
+                                                                    options.device->GetAllocator());
+        status = fc_bf16_param_->mgr->gen_cvt_weights(weight_data, param_->transB, bias_data);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "gen bf16 cvt weights for [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    } else if (!param_->transA && param_->transB && weight_data != nullptr) {
         if (!fc_param_) {
             fc_param_ = new FCParam;
         }
@@ -100,7 +199,7 @@ RetCode GemmOp::Init(const OptKernelOptions& options) {
 }
 
 RetCode GemmOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) {
-    if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
+    if (fc_int8_param_ || fc_bf16_param_ || (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN)) {
         auto weight_id = GetNode()->GetInput(1);
         auto it = constants_data_refcount->find(weight_id);
         if (it != constants_data_refcount->end()) {
@@ -119,6 +218,16 @@ RetCode GemmOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_re
 
 bool GemmOp::TryFuseReLU() {
     gemm_fuse_relu_ = true;
+    if (fc_int8_param_) {
+        ppl::kernel::x86::fc_int8_param param = fc_int8_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
+        fc_int8_param_->mgr->set_param(param);
+    }
+    if (fc_bf16_param_) {
+        ppl::kernel::x86::fc_bf16_param param = fc_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
+        fc_bf16_param_->mgr->set_param(param);
+    }
     if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
         ppl::kernel::x86::fc_fp32_param param = fc_param_->mgr->param();
         param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
@@ -128,11 +237,20 @@ bool GemmOp::TryFuseReLU() {
 }
 
 KernelImpl* GemmOp::CreateKernelImpl() const {
+    if (fc_int8_param_) {
+        return CreateKernelImplWithParam<FCInt8Kernel>(fc_int8_param_);
+    }
+    if (fc_bf16_param_) {
+        return CreateKernelImplWithParam<FCBf16Kernel>(fc_bf16_param_);
+    }
     if (fc_param_ && fc_param_->algo_info.algo_type != ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
         return CreateKernelImplWithParam<FCKernel>(fc_param_);
     } else {
         auto kernel = CreateKernelImplWithParam<GemmKernel>(param_.get());
         kernel->SetFuseReLU(gemm_fuse_relu_);
+        if (gemm_use_bf16_) {
+            kernel->SetBf16Isa(gemm_bf16_isa_);
+        }
         return kernel;
     }
 }
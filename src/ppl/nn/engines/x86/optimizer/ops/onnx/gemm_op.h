@@ -20,23 +20,32 @@
 
 #include "ppl/nn/params/onnx/gemm_param.h"
 #include "ppl/nn/engines/x86/params/fc_param.h"
+#include "ppl/nn/engines/x86/params/fc_int8_param.h"
+#include "ppl/nn/engines/x86/params/fc_bf16_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
 class GemmOp final : public X86OptKernel {
 public:
-    GemmOp(const ir::Node* node) : X86OptKernel(node), fc_param_(nullptr) {}
+    GemmOp(const ir::Node* node) : X86OptKernel(node), fc_param_(nullptr), fc_int8_param_(nullptr), fc_bf16_param_(nullptr) {}
     ~GemmOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
     ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) override;
     bool TryFuseReLU();
 
+private:
+    bool IsFcCompatible(const OptKernelOptions& options, const float* weight_data, const float* bias_data) const;
+
 private:
     FCParam* fc_param_;
+    FCInt8Param* fc_int8_param_; // not nullptr if this gemm runs as int8 fc
+    FCBf16Param* fc_bf16_param_; // not nullptr if this gemm runs as bf16 fc
     std::shared_ptr<ppl::nn::common::GemmParam> param_;
     bool gemm_fuse_relu_ = false;
+    bool gemm_use_bf16_ = false; // runs gemm_v2 in bf16 when not running as fc
+    ppl::kernel::x86::gemm_bf16_isa_t gemm_bf16_isa_ = ppl::kernel::x86::gemm_bf16_isa::REF;
 };
 
 }}} // namespace ppl::nn::x86
@@ -0,0 +1,166 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <float.h>
+#include <string.h>
+
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/gru_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/rnn_common.h"
+#include "ppl/nn/engines/x86/kernels/onnx/gru_kernel.h"
+#include "ppl/nn/oputils/onnx/reshape_gru.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+GRUOp::~GRUOp() {
+    if (rnn_param_ != nullptr) {
+        delete rnn_param_;
+    }
+}
+
+RetCode GRUOp::GenPackedWeights(const OptKernelOptions& options) {
+    if (!(options.device->GetISA() & ISA_X86_FMA)) {
+        return RC_SUCCESS;
+    }
+
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+    auto get_constant = [node, graph_data](uint32_t idx) -> const float* {
+        if (idx >= node->GetInputCount()) {
+            return nullptr;
+        }
+        auto data_it = graph_data->constants.find(node->GetInput(idx));
+        auto shape_it = graph_data->shapes.find(node->GetInput(idx));
+        if (data_it == graph_data->constants.end() || shape_it == graph_data->shapes.end() ||
+            shape_it->second.data_type != DATATYPE_FLOAT32) {
+            return nullptr;
+        }
+        return (const float*)data_it->second.data.data();
+    };
+
+    const float* W = get_constant(1);
+    const float* R = get_constant(2);
+    const float* B = get_constant(3);
+    const bool has_B = node->GetInputCount() > 3 && node->GetInput(3) != INVALID_EDGEID;
+    if (!W || !R || (has_B && !B)) {
+        return RC_SUCCESS;
+    }
+
+    auto direction = ppl::kernel::x86::rnn_direction::FORWARD;
+    if (param_->direction == ppl::nn::common::GRUParam::DIR_REVERSE) {
+        direction = ppl::kernel::x86::rnn_direction::REVERSE;
+    }
+    if (param_->direction == ppl::nn::common::GRUParam::DIR_BIDIRECTIONAL) {
+        direction = ppl::kernel::x86::rnn_direction::BIDIRECTIONAL;
+    }
+    const int64_t num_direction = direction == ppl::kernel::x86::rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::GRU;
+    const int64_t hidden_size = param_->hidden_size;
+    const bool linear_before_reset = param_->linear_before_reset != 0;
+    const auto& W_dims = graph_data->shapes.find(node->GetInput(1))->second.dims;
+    if (W_dims.size() != 3 || W_dims[0] != num_direction || W_dims[1] != num_gate * hidden_size) {
+        return RC_SUCCESS;
+    }
+    const int64_t input_size = W_dims[2];
+
+    vector<float> folded_bias(num_direction * num_gate * hidden_size);
+    vector<float> Rbh(num_direction * hidden_size);
+    auto status = ppl::kernel::x86::gru_fp32_fma_fold_bias(B, direction, hidden_size, linear_before_reset,
+                                                           folded_bias.data(), Rbh.data());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "fold bias of [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    rnn_param_ = new RNNParam;
+    if (!rnn_param_) {
+        return RC_OUT_OF_MEMORY;
+    }
+    status = GenRNNPackedWeights(options.device, W, R, folded_bias.data(), direction, num_gate, hidden_size,
+                                 input_size, rnn_param_);
+    if (status == RC_SUCCESS && linear_before_reset) {
+        rnn_param_->Rbh = (float*)rnn_param_->allocator->Alloc(Rbh.size() * sizeof(float));
+        if (rnn_param_->Rbh) {
+            memcpy(rnn_param_->Rbh, Rbh.data(), Rbh.size() * sizeof(float));
+        } else {
+            status = RC_OUT_OF_MEMORY;
+        }
+    }
+    if (status != RC_SUCCESS) {
+        delete rnn_param_;
+        rnn_param_ = nullptr;
+        if (status == RC_UNSUPPORTED) {
+            LOG(INFO) << "FC select algorithm failed, use fallback kernel";
+            return RC_SUCCESS;
+        }
+        LOG(ERROR) << "pack weights of [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode GRUOp::Init(const OptKernelOptions& options) {
+    auto status = GenericLoadParam(options, &param_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "load param failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    if (param_->activations.size() || param_->activation_alpha.size() || param_->activation_beta.size()) {
+        LOG(ERROR) << "GRU dose not support customize activations and parameters";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    if (param_->clip != FLT_MAX) {
+        LOG(ERROR) << "GRU dose not support clip";
+        return ppl::common::RC_UNSUPPORTED;
+    }
+
+    infer_dims_func_ = [this](InputOutputInfo* info) -> RetCode {
+        return oputils::ReshapeGRU(info, param_.get());
+    };
+
+    infer_type_func_ = GenericInferType;
+
+    return GenPackedWeights(options);
+}
+
+RetCode GRUOp::OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) {
+    if (rnn_param_) {
+        for (uint32_t i = 1; i <= 3 && i < GetNode()->GetInputCount(); ++i) {
+            auto it = constants_data_refcount->find(GetNode()->GetInput(i));
+            if (it != constants_data_refcount->end()) {
+                it->second--;
+            }
+        }
+    }
+    return RC_SUCCESS;
+}
+
+KernelImpl* GRUOp::CreateKernelImpl() const {
+    auto kernel = CreateKernelImplWithParam<GRUKernel>(param_.get());
+    if (kernel && rnn_param_) {
+        kernel->SetRNNParam(rnn_param_);
+    }
+    return kernel;
+}
+
+}}} // namespace ppl::nn::x86
@@ -16,31 +16,12 @@
 // under the License.
 
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/loop_op.h"
-#include "ppl/nn/common/tensor_buffer_info.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
-static RetCode ConcatOutputs(const vector<TensorBufferInfo>& outputs, BufferDesc* buf) {
-    BufferDesc buf_cursor = *buf;
-
-    for (auto it = outputs.begin(); it != outputs.end(); ++it) {
-        auto device = it->GetDevice();
-        const uint32_t bytes = it->GetShape()->GetBytesIncludingPadding();
-        auto status = device->Copy(&buf_cursor, it->GetBufferDesc(), bytes);
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "copy data failed: " << GetRetCodeStr(status);
-            return status;
-        }
-
-        buf_cursor.addr = (char*)(buf_cursor.addr) + bytes;
-    }
-
-    return RC_SUCCESS;
-}
-
 RetCode LoopOp::Init(const OptKernelOptions& options) {
     auto node = GetNode();
     auto graph_data = options.graph_data;
@@ -51,7 +32,7 @@ RetCode LoopOp::Init(const OptKernelOptions& options) {
     }
 
     auto loop_param = static_cast<ppl::nn::common::LoopParam*>(attr_ref->second.get());
-    return op_.Init(options.resource, loop_param, ConcatOutputs);
+    return op_.Init(options.resource, loop_param);
 }
 
 KernelImpl* LoopOp::CreateKernelImpl() const {
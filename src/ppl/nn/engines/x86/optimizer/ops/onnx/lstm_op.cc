@@ -18,6 +18,7 @@
 #include <float.h>
 
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/lstm_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/rnn_common.h"
 #include "ppl/nn/engines/x86/kernels/onnx/lstm_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_lstm.h"
 #include "ppl/nn/common/logger.h"
@@ -26,6 +27,89 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+LSTMOp::~LSTMOp() {
+    if (rnn_param_ != nullptr) {
+        delete rnn_param_;
+    }
+}
+
+RetCode LSTMOp::GenPackedWeights(const OptKernelOptions& options) {
+    if (!(options.device->GetISA() & ISA_X86_FMA)) {
+        return RC_SUCCESS;
+    }
+
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+    auto get_constant = [node, graph_data](uint32_t idx) -> const float* {
+        if (idx >= node->GetInputCount()) {
+            return nullptr;
+        }
+        auto data_it = graph_data->constants.find(node->GetInput(idx));
+        auto shape_it = graph_data->shapes.find(node->GetInput(idx));
+        if (data_it == graph_data->constants.end() || shape_it == graph_data->shapes.end() ||
+            shape_it->second.data_type != DATATYPE_FLOAT32) {
+            return nullptr;
+        }
+        return (const float*)data_it->second.data.data();
+    };
+
+    const float* W = get_constant(1);
+    const float* R = get_constant(2);
+    const float* B = get_constant(3);
+    const bool has_B = node->GetInputCount() > 3 && node->GetInput(3) != INVALID_EDGEID;
+    if (!W || !R || (has_B && !B)) {
+        return RC_SUCCESS;
+    }
+
+    auto direction = ppl::kernel::x86::rnn_direction::FORWARD;
+    if (param_->direction == ppl::nn::common::LSTMParam::DIR_REVERSE) {
+        direction = ppl::kernel::x86::rnn_direction::REVERSE;
+    }
+    if (param_->direction == ppl::nn::common::LSTMParam::DIR_BIDIRECTIONAL) {
+        direction = ppl::kernel::x86::rnn_direction::BIDIRECTIONAL;
+    }
+    const int64_t num_direction = direction == ppl::kernel::x86::rnn_direction::BIDIRECTIONAL ? 2 : 1;
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::LSTM;
+    const int64_t hidden_size = param_->hidden_size;
+    const auto& W_dims = graph_data->shapes.find(node->GetInput(1))->second.dims;
+    if (W_dims.size() != 3 || W_dims[0] != num_direction || W_dims[1] != num_gate * hidden_size) {
+        return RC_SUCCESS;
+    }
+    const int64_t input_size = W_dims[2];
+
+    // Wb and Rb are both added to the projection of X
+    vector<float> folded_bias(num_direction * num_gate * hidden_size, 0.0f);
+    if (B) {
+        for (int64_t nd = 0; nd < num_direction; ++nd) {
+            const float* Wb = B + nd * 2 * num_gate * hidden_size;
+            const float* Rb = Wb + num_gate * hidden_size;
+            float* fb = folded_bias.data() + nd * num_gate * hidden_size;
+            for (int64_t i = 0; i < num_gate * hidden_size; ++i) {
+                fb[i] = Wb[i] + Rb[i];
+            }
+        }
+    }
+
+    rnn_param_ = new RNNParam;
+    if (!rnn_param_) {
+        return RC_OUT_OF_MEMORY;
+    }
+    auto status = GenRNNPackedWeights(options.device, W, R, folded_bias.data(), direction, num_gate, hidden_size,
+                                      input_size, rnn_param_);
+    if (status != RC_SUCCESS) {
+        delete rnn_param_;
+        rnn_param_ = nullptr;
+        if (status == RC_UNSUPPORTED) {
+            LOG(INFO) << "FC select algorithm failed, use fallback kernel";
+            return RC_SUCCESS;
+        }
+        LOG(ERROR) << "pack weights of [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+
 RetCode LSTMOp::Init(const OptKernelOptions& options) {
     auto status = GenericLoadParam(options, &param_);
     if (status != RC_SUCCESS) {
@@ -54,11 +138,27 @@ RetCode LSTMOp::Init(const OptKernelOptions& options) {
 
     infer_type_func_ = GenericInferType;
 
+    return GenPackedWeights(options);
+}
+
+RetCode LSTMOp::OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) {
+    if (rnn_param_) {
+        for (uint32_t i = 1; i <= 3 && i < GetNode()->GetInputCount(); ++i) {
+            auto it = constants_data_refcount->find(GetNode()->GetInput(i));
+            if (it != constants_data_refcount->end()) {
+                it->second--;
+            }
+        }
+    }
     return RC_SUCCESS;
 }
 
 KernelImpl* LSTMOp::CreateKernelImpl() const {
-    return CreateKernelImplWithParam<LSTMKernel>(param_.get());
+    auto kernel = CreateKernelImplWithParam<LSTMKernel>(param_.get());
+    if (kernel && rnn_param_) {
+        kernel->SetRNNParam(rnn_param_);
+    }
+    return kernel;
 }
 
 }}} // namespace ppl::nn::x86
@@ -19,18 +19,25 @@
 #define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_LSTM_OP_H_
 
 #include "ppl/nn/params/onnx/lstm_param.h"
+#include "ppl/nn/engines/x86/params/rnn_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
 class LSTMOp final : public X86OptKernel {
 public:
-    LSTMOp(const ir::Node* node) : X86OptKernel(node) {}
+    LSTMOp(const ir::Node* node) : X86OptKernel(node), rnn_param_(nullptr) {}
+    ~LSTMOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t>* constants_data_refcount) override;
+
+private:
+    ppl::common::RetCode GenPackedWeights(const OptKernelOptions& options);
 
 private:
     std::shared_ptr<ppl::nn::common::LSTMParam> param_;
+    RNNParam* rnn_param_; // not nullptr if W, R and B are constants and pre-packed
 };
 
 }}} // namespace ppl::nn::x86
@@ -17,12 +17,92 @@
 
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/matmul_op.h"
 #include "ppl/nn/engines/x86/kernels/onnx/matmul_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/fc_bf16_kernel.h"
+#include "ppl/nn/engines/x86/kernels/onnx/matmul_fc_kernel.h"
 #include "ppl/nn/oputils/onnx/reshape_matmul.h"
+#include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn { namespace x86 {
 
+MatMulOp::~MatMulOp() {
+    if (fc_bf16_param_ != nullptr) {
+        if (fc_bf16_param_->mgr != nullptr) {
+            fc_bf16_param_->mgr->release_cvt_weights();
+        }
+        delete fc_bf16_param_;
+    }
+    if (fc_param_ != nullptr) {
+        delete fc_param_;
+    }
+}
+
+RetCode MatMulOp::GenFCWeights(const OptKernelOptions& options, const float* weight_data,
+                               const ir::Shape& weight_shape) {
+    const uint32_t dim_count = weight_shape.dims.size();
+    const int64_t K = weight_shape.dims[dim_count - 2];
+    const int64_t N = weight_shape.dims[dim_count - 1];
+    int64_t batch = 1;
+    for (uint32_t i = 0; i < dim_count - 2; ++i) {
+        batch *= weight_shape.dims[i];
+    }
+    if (K <= 0 || N <= 0 || batch <= 0) {
+        return RC_SUCCESS;
+    }
+
+    ppl::kernel::x86::fc_fp32_param param;
+    param.channels = K;
+    param.num_output = N;
+    param.fuse_flag = 0;
+
+    auto algo_info = ppl::kernel::x86::fc_algo_selector::select_algo(DATAFORMAT_NDARRAY, param,
+                                                                     options.device->GetISA());
+    if (algo_info.algo_type == ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
+        LOG(INFO) << "FC select algorithm failed, use fallback kernel";
+        return RC_SUCCESS;
+    }
+
+    fc_param_ = new MatMulFCParam;
+    if (!fc_param_) {
+        return RC_OUT_OF_MEMORY;
+    }
+    fc_param_->weight_dims = weight_shape.dims;
+
+    // fc takes B as [N, K]
+    std::vector<float> trans_weight(N * K);
+    std::vector<float> zero_bias(N, 0.0f);
+    for (int64_t b = 0; b < batch; ++b) {
+        const float* weight = weight_data + b * K * N;
+        for (int64_t k = 0; k < K; ++k) {
+            for (int64_t n = 0; n < N; ++n) {
+                trans_weight[n * K + k] = weight[k * N + n];
+            }
+        }
+
+        auto fc_param = new FCParam;
+        if (!fc_param) {
+            return RC_OUT_OF_MEMORY;
+        }
+        fc_param_->fc_params.push_back(fc_param);
+
+        fc_param->param = param;
+        fc_param->algo_info = algo_info;
+        fc_param->mgr = ppl::kernel::x86::fc_algo_selector::gen_algo(fc_param->param, fc_param->algo_info,
+                                                                     options.device->GetAllocator());
+        if (!fc_param->mgr) {
+            return RC_OUT_OF_MEMORY;
+        }
+        auto status = fc_param->mgr->gen_cvt_weights(trans_weight.data(), zero_bias.data());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "gen cvt weights for [" << GetNode()->GetName() << "] failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
 RetCode MatMulOp::Init(const OptKernelOptions& options) {
     infer_dims_func_ = [](InputOutputInfo* info) -> RetCode {
         return oputils::ReshapeMatMul(info, nullptr);
@@ -30,10 +110,95 @@ RetCode MatMulOp::Init(const OptKernelOptions& options) {
 
     infer_type_func_ = GenericInferType;
 
+    auto node = GetNode();
+    auto graph_data = options.graph_data;
+    auto weight_data_it = graph_data->constants.find(node->GetInput(1));
+    auto weight_shape_it = graph_data->shapes.find(node->GetInput(1));
+    if (weight_data_it == graph_data->constants.end() || weight_shape_it == graph_data->shapes.end() ||
+        weight_shape_it->second.dims.size() < 2 || weight_shape_it->second.data_type != DATATYPE_FLOAT32) {
+        return RC_SUCCESS;
+    }
+
+    const ir::Shape& weight_shape = weight_shape_it->second;
+    const float* weight_data = (const float*)weight_data_it->second.data.data();
+
+    if (options.forward_precision == DATATYPE_BFLOAT16 && weight_shape.dims.size() == 2) {
+        auto bf16_isa = ppl::kernel::x86::gemm_bf16_select_isa(options.device->GetISA());
+        if (bf16_isa != ppl::kernel::x86::gemm_bf16_isa::REF) {
+            if (!fc_bf16_param_) {
+                fc_bf16_param_ = new FCBf16Param;
+            }
+            if (!fc_bf16_param_) {
+                return RC_OUT_OF_MEMORY;
+            }
+
+            fc_bf16_param_->param.channels = weight_shape.dims[0];
+            fc_bf16_param_->param.num_output = weight_shape.dims[1];
+            fc_bf16_param_->param.fuse_flag = 0;
+
+            fc_bf16_param_->mgr = new ppl::kernel::x86::fc_bf16_manager(fc_bf16_param_->param, bf16_isa,
+                                                                        options.device->GetAllocator());
+            auto status = fc_bf16_param_->mgr->gen_cvt_weights(weight_data, false, nullptr);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "gen bf16 cvt weights for [" << node->GetName() << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            return RC_SUCCESS;
+        }
+        LOG(INFO) << "no bf16 instructions available for [" << node->GetName() << "], use fp32 instead.";
+    }
+
+    return GenFCWeights(options, weight_data, weight_shape);
+}
+
+RetCode MatMulOp::OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) {
+    if (fc_bf16_param_ || fc_param_) {
+        auto it = constants_data_refcount->find(GetNode()->GetInput(1));
+        if (it != constants_data_refcount->end()) {
+            it->second--;
+        }
+    }
     return RC_SUCCESS;
 }
 
+bool MatMulOp::TryFuseReLU() {
+    if (fc_bf16_param_) {
+        ppl::kernel::x86::fc_bf16_param param = fc_bf16_param_->mgr->param();
+        param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
+        fc_bf16_param_->mgr->set_param(param);
+        return true;
+    }
+    if (fc_param_) {
+        for (auto p : fc_param_->fc_params) {
+            ppl::kernel::x86::fc_fp32_param param = p->mgr->param();
+            param.fuse_flag |= ppl::kernel::x86::fc_fuse_flag::RELU;
+            p->mgr->set_param(param);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool MatMulOp::TryFuseBias(const float* bias) {
+    // bias is added before relu, so it cannot be fused after it
+    if (!fc_param_ || (fc_param_->fc_params[0]->mgr->param().fuse_flag & ppl::kernel::x86::fc_fuse_flag::RELU)) {
+        return false;
+    }
+    for (auto p : fc_param_->fc_params) {
+        if (p->mgr->add_cvt_bias(bias) != RC_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+}
+
 KernelImpl* MatMulOp::CreateKernelImpl() const {
+    if (fc_bf16_param_) {
+        return CreateKernelImplWithParam<FCBf16Kernel>(fc_bf16_param_);
+    }
+    if (fc_param_) {
+        return CreateKernelImplWithParam<MatMulFCKernel>(fc_param_);
+    }
     return CreateKernelImplWithoutParam<MatMulKernel>();
 }
 
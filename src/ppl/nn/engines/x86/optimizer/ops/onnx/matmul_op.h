@@ -18,15 +18,30 @@
 #ifndef _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_MATMUL_OP_H_
 #define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_MATMUL_OP_H_
 
+#include "ppl/nn/engines/x86/params/fc_bf16_param.h"
+#include "ppl/nn/engines/x86/params/matmul_fc_param.h"
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
 class MatMulOp final : public X86OptKernel {
 public:
-    MatMulOp(const ir::Node* node) : X86OptKernel(node) {}
+    MatMulOp(const ir::Node* node) : X86OptKernel(node), fc_bf16_param_(nullptr), fc_param_(nullptr) {}
+    ~MatMulOp();
     ppl::common::RetCode Init(const OptKernelOptions& options) override;
     KernelImpl* CreateKernelImpl() const override;
+    ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) override;
+    bool TryFuseReLU();
+    // bias has N values and is added to every row of the output
+    bool TryFuseBias(const float* bias);
+
+private:
+    ppl::common::RetCode GenFCWeights(const OptKernelOptions& options, const float* weight_data,
+                                      const ir::Shape& weight_shape);
+
+private:
+    FCBf16Param* fc_bf16_param_; // not nullptr if B is a constant matrix and this matmul runs as bf16 fc
+    MatMulFCParam* fc_param_; // not nullptr if B is constant and its matrices are pre-packed for fp32 fc
 };
 
 }}} // namespace ppl::nn::x86
@@ -0,0 +1,72 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/rnn_common.h"
+#include "ppl/nn/common/logger.h"
+#include "ppl/kernel/x86/fp32/rnn.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+RetCode GenRNNPackedWeights(X86Device* device, const float* W, const float* R, const float* folded_bias,
+                            ppl::kernel::x86::rnn_direction_t direction, int64_t num_gate, int64_t hidden_size,
+                            int64_t input_size, RNNParam* param) {
+    const int64_t num_direction = direction == ppl::kernel::x86::rnn_direction::BIDIRECTIONAL ? 2 : 1;
+
+    // W of all directions and gates is projected by a single fc: [seq_len * batch, input_size] -> [seq_len * batch, num_direction * num_gate * hidden_size]
+    ppl::kernel::x86::fc_fp32_param fc_param;
+    fc_param.channels = input_size;
+    fc_param.num_output = num_direction * num_gate * hidden_size;
+    fc_param.fuse_flag = 0;
+
+    auto algo_info = ppl::kernel::x86::fc_algo_selector::select_algo(DATAFORMAT_NDARRAY, fc_param, device->GetISA());
+    if (algo_info.algo_type == ppl::kernel::x86::fc_fp32_algo::UNKNOWN) {
+        return RC_UNSUPPORTED;
+    }
+
+    auto allocator = device->GetAllocator();
+    param->allocator = allocator;
+
+    param->fc_param = new FCParam;
+    if (!param->fc_param) {
+        return RC_OUT_OF_MEMORY;
+    }
+    param->fc_param->param = fc_param;
+    param->fc_param->algo_info = algo_info;
+    param->fc_param->mgr = ppl::kernel::x86::fc_algo_selector::gen_algo(fc_param, algo_info, allocator);
+    if (!param->fc_param->mgr) {
+        return RC_OUT_OF_MEMORY;
+    }
+    auto status = param->fc_param->mgr->gen_cvt_weights(W, folded_bias);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "gen cvt weights failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    const uint64_t packed_R_bytes =
+        ppl::kernel::x86::rnn_fp32_fma_get_packed_recurrent_weight_bytes(direction, num_gate, hidden_size);
+    param->packed_R = (float*)allocator->Alloc(packed_R_bytes);
+    if (!param->packed_R) {
+        LOG(ERROR) << "alloc packed R of [" << packed_R_bytes << "] bytes failed.";
+        return RC_OUT_OF_MEMORY;
+    }
+    return ppl::kernel::x86::rnn_fp32_fma_pack_recurrent_weight(R, direction, num_gate, hidden_size,
+                                                                param->packed_R);
+}
+
+}}} // namespace ppl::nn::x86
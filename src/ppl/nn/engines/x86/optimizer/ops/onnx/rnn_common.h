@@ -0,0 +1,41 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_RNN_COMMON_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_OPTIMIZER_OPS_ONNX_RNN_COMMON_H_
+
+#include "ppl/nn/engines/x86/params/rnn_param.h"
+#include "ppl/nn/engines/x86/x86_device.h"
+#include "ppl/kernel/x86/common/rnn_common.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @brief pre-packs constant weights of LSTM/GRU.
+   @param W (num_direction, num_gate * hidden_size, input_size)
+   @param R (num_direction, num_gate * hidden_size, hidden_size)
+   @param folded_bias (num_direction, num_gate * hidden_size), biases added to X * W^T of all timesteps
+   @note leaves `param` untouched and returns RC_UNSUPPORTED if no fc algorithm is available.
+*/
+ppl::common::RetCode GenRNNPackedWeights(X86Device* device, const float* W, const float* R,
+                                         const float* folded_bias, ppl::kernel::x86::rnn_direction_t direction,
+                                         int64_t num_gate, int64_t hidden_size, int64_t input_size,
+                                         RNNParam* param);
+
+}}} // namespace ppl::nn::x86
+
+#endif
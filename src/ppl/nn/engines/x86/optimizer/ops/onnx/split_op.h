@@ -32,7 +32,13 @@ public:
                                       std::vector<ppl::common::dataformat_t>* selected_input_formats,
                                       std::vector<ppl::common::dataformat_t>* selected_output_formats) override;
 
+    /** @brief outputs are views of the input buffer. see `InplaceBuffer`. */
+    void SetInplace(bool inplace) {
+        inplace_ = inplace;
+    }
+
 private:
+    bool inplace_ = false;
     std::shared_ptr<ppl::nn::common::SplitParam> param_;
 };
 
@@ -0,0 +1,68 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/attention_op.h"
+#include "ppl/nn/engines/x86/kernels/ppl/attention_kernel.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+RetCode AttentionOp::Init(const OptKernelOptions& options) {
+    param_ = make_shared<ppl::nn::common::AttentionParam>();
+    param_->scale = 1.0f;
+
+    infer_type_func_ = GenericInferType;
+    infer_dims_func_ = [](InputOutputInfo* info) -> RetCode {
+        auto& q_shape = *info->GetInput<TensorImpl>(0)->GetShape();
+        auto& kt_shape = *info->GetInput<TensorImpl>(1)->GetShape();
+        auto& v_shape = *info->GetInput<TensorImpl>(2)->GetShape();
+        const uint32_t dim_count = q_shape.GetDimCount();
+        if (dim_count < 2 || kt_shape.GetDimCount() != dim_count || v_shape.GetDimCount() != dim_count) {
+            LOG(ERROR) << "invalid dim count of q[" << dim_count << "], kt[" << kt_shape.GetDimCount() << "] or v["
+                       << v_shape.GetDimCount() << "].";
+            return RC_INVALID_VALUE;
+        }
+
+        // leading dims broadcast like MatMul
+        std::vector<int64_t> output_dims(q_shape.GetDims(), q_shape.GetDims() + dim_count);
+        for (uint32_t i = 0; i < dim_count - 2; ++i) {
+            const int64_t kd = kt_shape.GetDim(i);
+            const int64_t vd = v_shape.GetDim(i);
+            const int64_t d = std::max(output_dims[i], std::max(kd, vd));
+            if ((output_dims[i] != d && output_dims[i] != 1) || (kd != d && kd != 1) || (vd != d && vd != 1)) {
+                LOG(ERROR) << "leading dim[" << i << "] of q[" << output_dims[i] << "], kt[" << kd << "] and v[" << vd
+                           << "] cannot be broadcast.";
+                return RC_INVALID_VALUE;
+            }
+            output_dims[i] = d;
+        }
+        output_dims.back() = v_shape.GetDim(dim_count - 1);
+        info->GetOutput<TensorImpl>(0)->GetShape()->Reshape(output_dims);
+        return RC_SUCCESS;
+    };
+
+    return RC_SUCCESS;
+}
+
+KernelImpl* AttentionOp::CreateKernelImpl() const {
+    return CreateKernelImplWithParam<AttentionKernel>(param_.get());
+}
+
+}}} // namespace ppl::nn::x86
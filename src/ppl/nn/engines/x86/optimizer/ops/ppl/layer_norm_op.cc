@@ -0,0 +1,39 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/layer_norm_op.h"
+#include "ppl/nn/engines/x86/kernels/ppl/layer_norm_kernel.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+RetCode LayerNormOp::Init(const OptKernelOptions& options) {
+    param_ = make_shared<ppl::nn::common::LayerNormParam>();
+    param_->axis = -1;
+    param_->epsilon = 1e-5f;
+    infer_type_func_ = GenericInferType;
+    infer_dims_func_ = GenericInferDims;
+    return RC_SUCCESS;
+}
+
+KernelImpl* LayerNormOp::CreateKernelImpl() const {
+    return CreateKernelImplWithParam<LayerNormKernel>(param_.get());
+}
+
+}}} // namespace ppl::nn::x86
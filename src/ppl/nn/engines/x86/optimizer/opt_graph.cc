@@ -169,7 +169,9 @@ RetCode OptGraph::TryToInferDims(X86Device* device) {
     return RC_SUCCESS;
 }
 
-RetCode OptGraph::DoOptimize(X86Device* device) {
+RetCode OptGraph::DoOptimize(X86Device* device, PackedWeightsCache* packed_weights_cache,
+                             Conv2dAlgoTuner* conv2d_algo_tuner, const QuantParamInfo* quant_info,
+                             uint32_t forward_precision) {
     OptKernelOptions options;
     options.resource = resource_;
     options.graph_data = graph_->data.get();
@@ -177,6 +179,10 @@ RetCode OptGraph::DoOptimize(X86Device* device) {
     options.tensors = &tensor_impls_;
     options.device = device;
     options.info = info_;
+    options.packed_weights_cache = packed_weights_cache;
+    options.conv2d_algo_tuner = conv2d_algo_tuner;
+    options.quant_info = quant_info;
+    options.forward_precision = forward_precision;
 
     for (auto it = info_->kernels.begin(); it != info_->kernels.end(); ++it) {
         auto kernel = (X86OptKernel*)(it->second.get());
@@ -223,6 +229,9 @@ RetCode OptGraph::DoOptimize(X86Device* device) {
 
     opt_rule_manager->ApplyByTag("AfterLayoutOptimize", options);
 
+    // nodes are not changed any more
+    opt_rule_manager->Apply("", "InplaceConcatSplit", options);
+
 #ifdef SHOW_GRAPH_VIS
     std::string vis = utils::ToGraphviz(graph_->topo.get());
     std::ofstream out_file("./graph.dot");
@@ -32,7 +32,10 @@ class OptGraph final {
 public:
     OptGraph() : tensor_getter_(&tensor_impls_) {}
     ppl::common::RetCode Init(ir::Graph*, utils::SharedResource*, RuntimePartitionInfo*);
-    ppl::common::RetCode DoOptimize(X86Device*);
+    ppl::common::RetCode DoOptimize(X86Device*, PackedWeightsCache* packed_weights_cache = nullptr,
+                                    Conv2dAlgoTuner* conv2d_algo_tuner = nullptr,
+                                    const QuantParamInfo* quant_info = nullptr,
+                                    uint32_t forward_precision = ppl::common::DATATYPE_FLOAT32);
 
 private:
     ppl::common::RetCode InitKernels(const ir::Graph* graph);
@@ -16,7 +16,9 @@
 // under the License.
 
 #include "ppl/nn/engines/x86/optimizer/opt_kernel.h"
+#include "ppl/nn/common/logger.h"
 #include "ppl/common/sys.h"
+#include <math.h>
 using namespace std;
 using namespace ppl::common;
 
@@ -26,4 +28,52 @@ X86OptKernel::X86OptKernel(const ir::Node* node) : OptKernel(node) {
     common_param_.output_formats.resize(node->GetOutputCount(), DATAFORMAT_NDARRAY);
 }
 
+bool X86OptKernel::GetInt8InputScale(const OptKernelOptions& options, float* src_scale) const {
+    if (!options.quant_info) {
+        return false;
+    }
+
+    auto node = GetNode();
+    auto node_param = options.quant_info->node_params.find(node->GetName());
+    if (node_param == options.quant_info->node_params.end()) {
+        return false;
+    }
+    auto data_type = node_param->second.fields.find("data_type");
+    if (data_type == node_param->second.fields.end() || data_type->second.content != "INT8") {
+        return false;
+    }
+
+    auto edge = options.graph_topo->GetEdgeById(node->GetInput(0));
+    auto tensor_param = options.quant_info->tensor_params.find(edge->GetName());
+    if (tensor_param == options.quant_info->tensor_params.end()) {
+        LOG(WARNING) << "quant info of input[" << edge->GetName() << "] of int8 node[" << node->GetName()
+                     << "] not found, use fp32 instead.";
+        return false;
+    }
+
+    auto& fields = tensor_param->second.fields;
+    auto per_channel = fields.find("per_channel");
+    if (per_channel != fields.end() && *(const bool*)per_channel->second.content.data()) {
+        LOG(WARNING) << "per-channel activation of node[" << node->GetName() << "] is not supported, use fp32 instead.";
+        return false;
+    }
+    auto tensor_max = fields.find("tensor_max");
+    auto tensor_min = fields.find("tensor_min");
+    double max_value, min_value;
+    if (tensor_max == fields.end() || tensor_min == fields.end() || !tensor_max->second.GetDouble(&max_value) ||
+        !tensor_min->second.GetDouble(&min_value)) {
+        LOG(WARNING) << "range of input[" << edge->GetName() << "] of int8 node[" << node->GetName()
+                     << "] not found, use fp32 instead.";
+        return false;
+    }
+
+    const double abs_max = max(fabs(max_value), fabs(min_value));
+    if (!(abs_max > 0.0)) {
+        return false;
+    }
+
+    *src_scale = (float)(abs_max / 127.0);
+    return true;
+}
+
 }}} // namespace ppl::nn::x86
@@ -22,7 +22,10 @@
 #include "ppl/nn/runtime/tensor_impl.h"
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/engines/x86/x86_common_param.h"
+#include "ppl/nn/engines/x86/packed_weights_cache.h"
+#include "ppl/nn/engines/x86/conv2d_algo_tuner.h"
 #include "ppl/nn/runtime/runtime_partition_info.h"
+#include "ppl/nn/quantization/quant_param_info.h"
 #include <functional>
 
 namespace ppl { namespace nn { namespace utils {
@@ -38,6 +41,10 @@ struct OptKernelOptions {
     X86Device* device = nullptr;
     RuntimePartitionInfo *info = nullptr;
     std::map<edgeid_t, std::unique_ptr<TensorImpl>> *tensors = nullptr;
+    PackedWeightsCache* packed_weights_cache = nullptr;
+    Conv2dAlgoTuner* conv2d_algo_tuner = nullptr; // nullptr if tuning is off
+    const QuantParamInfo* quant_info = nullptr;
+    uint32_t forward_precision = ppl::common::DATATYPE_FLOAT32; // int8 nodes in `quant_info` take precedence
 };
 
 class X86OptKernel : public OptKernel {
@@ -74,11 +81,28 @@ public:
         common_param_.output_formats[idx] = format;
     }
 
+    /** @brief lets output `idx` be written into slot `slot` of the in-place buffer of node `nid` */
+    void SetOutputInplaceTarget(uint32_t idx, nodeid_t nid, uint32_t slot) {
+        common_param_.output_inplace_targets.resize(common_param_.output_formats.size());
+        common_param_.output_inplace_targets[idx].nid = nid;
+        common_param_.output_inplace_targets[idx].slot = slot;
+    }
+    bool HasOutputInplaceTarget(uint32_t idx) const {
+        return (idx < common_param_.output_inplace_targets.size() &&
+                common_param_.output_inplace_targets[idx].nid != INVALID_NODEID);
+    }
+
     virtual ppl::common::RetCode OmitConstantsData(std::map<edgeid_t, int64_t> *constants_data_refcount) {
         return ppl::common::RC_SUCCESS;
     }
 
 protected:
+    /**
+       @brief returns true if this node is marked as INT8 in `options.quant_info` and
+       input 0 has a per-tensor range. `src_scale` is the symmetric scale of input 0.
+    */
+    bool GetInt8InputScale(const OptKernelOptions& options, float* src_scale) const;
+
     template <typename T>
     ppl::common::RetCode GenericLoadParam(const OptKernelOptions& options, std::shared_ptr<T>* param) const {
         auto node = GetNode();
@@ -42,6 +42,7 @@
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gather_nd_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gemm_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/greater_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/gru_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/identity_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/if_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/leaky_relu_op.h"
@@ -100,6 +101,9 @@
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/shape_operation_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/swish_op.h"
 #include "ppl/nn/engines/x86/optimizer/ops/ppl/post_depthwise_conv_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/layer_norm_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/gelu_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/attention_op.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
 using namespace ppl::common;
@@ -179,6 +183,7 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("", "Gemm", 11, 12, GemmOp);
     REGISTER_OPT_KERNEL_CREATOR("", "GlobalAveragePool", 1, 16, AveragePoolOp);
     REGISTER_OPT_KERNEL_CREATOR("", "Greater", 9, 12, GreaterOp);
+    REGISTER_OPT_KERNEL_CREATOR("", "GRU", 7, 13, GRUOp);
     // I
     REGISTER_OPT_KERNEL_CREATOR("", "Identity", 1, 12, IdentityOp);
     REGISTER_OPT_KERNEL_CREATOR("", "If", 11, 12, IfOp);
@@ -251,6 +256,9 @@ OptKernelCreatorManager::OptKernelCreatorManager() {
     REGISTER_OPT_KERNEL_CREATOR("ppl", "Shape", 1, 1, PPLShapeOperationOp);
     REGISTER_OPT_KERNEL_CREATOR("ppl", "Swish", 1, 1, SwishOp);
     REGISTER_OPT_KERNEL_CREATOR("ppl", "PostDepthwiseConv", 1, 1, PostDepthwiseConvOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "LayerNorm", 1, 1, LayerNormOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "Gelu", 1, 1, GeluOp);
+    REGISTER_OPT_KERNEL_CREATOR("ppl", "Attention", 1, 1, AttentionOp);
 }
 
 }}} // namespace ppl::nn::x86
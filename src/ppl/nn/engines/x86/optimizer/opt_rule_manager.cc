@@ -26,6 +26,11 @@
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_batch_normalization_relu.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_channel_shuffle.h"
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_swish.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_layer_norm.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_gelu.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_attention.h"
+#include "ppl/nn/engines/x86/optimizer/rules/fold_shape_subgraph.h"
+#include "ppl/nn/engines/x86/optimizer/rules/inplace_concat_split.h"
 #include "ppl/nn/engines/x86/optimizer/rules/layout_optimize.h"
 
 namespace ppl { namespace nn { namespace x86 {
@@ -89,7 +94,9 @@ OptRuleManager::~OptRuleManager() {
 
 OptRuleManager::OptRuleManager() {
     REGISTER_OPT_RULE("", "LayoutOptimize", LayoutOptimize);
+    REGISTER_OPT_RULE("", "InplaceConcatSplit", InplaceConcatSplit);
 
+    REGISTER_OPT_RULE("BeforeLayoutOptimize", "FoldShapeSubgraph", FoldShapeSubgraph);
     REGISTER_OPT_RULE("BeforeLayoutOptimize", "FuseChannelShuffle", FuseChannelShuffle);
 
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseConvActivation", FuseConvActivation);
@@ -99,6 +106,9 @@ OptRuleManager::OptRuleManager() {
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseBatchNormalizationReLU", FuseBatchNormalizationReLU);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseGemmActivation", FuseGemmActivation);
     REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseSwish", FuseSwish);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseLayerNorm", FuseLayerNorm);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseGelu", FuseGelu);
+    REGISTER_OPT_RULE("AfterLayoutOptimize", "FuseAttention", FuseAttention);
 }
 
 }}} // namespace ppl::nn::x86
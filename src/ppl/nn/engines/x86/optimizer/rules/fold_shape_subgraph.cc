@@ -0,0 +1,345 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fold_shape_subgraph.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/tensor_getter.h"
+#include "ppl/nn/runtime/kernel_exec_context.h"
+#include "ppl/nn/utils/shared_resource.h"
+#include "ppl/nn/common/logger.h"
+#include <map>
+#include <set>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace x86 {
+
+// outputs larger than this are kept being computed at runtime
+static const uint64_t kMaxFoldedOutputBytes = 1024 * 1024;
+
+// ops reading nothing but dims of input 0
+static bool IsShapeNode(const ir::Node* node) {
+    auto& type = node->GetType();
+    return (type.name == "Shape" && (type.domain == "" || type.domain == "ppl"));
+}
+
+static bool IsFoldableNode(const ir::Node* node) {
+    static const set<string> foldable_ops{
+        "Add",   "And",   "Cast",      "Ceil",    "Concat",    "ConstantOfShape", "Div", "Equal", "Expand",
+        "Floor", "Gather", "Greater",  "Identity", "Less",     "Max",             "Min", "Mul",   "Not",
+        "Range", "ReduceProd", "Reshape", "Slice", "Squeeze", "Sub", "Tile", "Unsqueeze", "Where",
+    };
+    return IsShapeNode(node) ||
+        (node->GetType().domain == "" && foldable_ops.find(node->GetType().name) != foldable_ops.end());
+}
+
+/*
+  returns true if output dims of `node` can be determined by exact input dims and constants.
+  `dims_exact` records edges whose dims do not change when runtimes are fed with declared inputs.
+  ops that are not listed, e.g. NonZero, Loop or custom ops, are assumed to have data-dependent output dims.
+*/
+static bool OutputDimsAreExact(const ir::Node* node, const ir::GraphData* graph_data, const vector<bool>& dims_exact) {
+    // output dims depend on nothing but input dims and attributes
+    static const set<string> dims_only_ops{
+        "Abs",        "Add",           "And",         "ArgMax",          "AveragePool",       "BatchNormalization",
+        "Cast",       "Ceil",          "Clip",        "Concat",          "Conv",              "ConvTranspose",
+        "Cos",        "CumSum",        "DepthToSpace", "Div",            "Equal",             "Erf",
+        "Exp",        "Flatten",       "Floor",       "GRU",             "Gather",            "GatherND",
+        "Gemm",       "GlobalAveragePool", "GlobalMaxPool", "Greater",   "Identity",          "LSTM",
+        "LeakyRelu",  "Less",          "Log",         "MatMul",          "Max",               "MaxPool",
+        "Min",        "Mul",           "Not",         "PRelu",           "Pow",               "ReduceMax",
+        "ReduceMean", "ReduceMin",     "ReduceProd",  "Relu",            "RoiAlign",          "ScatterElements",
+        "ScatterND",  "Shape",         "Sigmoid",     "Sin",             "Softmax",           "Sqrt",
+        "Sub",        "Sum",           "Tanh",        "Transpose",       "Where",
+    };
+    // output dims also depend on data of inputs starting from the given index, which must be constants
+    static const map<string, uint32_t> shape_input_ops{
+        {"ConstantOfShape", 0}, {"Expand", 1}, {"MaxUnpool", 1}, {"OneHot", 1},   {"Pad", 1},
+        {"Range", 0},           {"ReduceSum", 1}, {"Reshape", 1}, {"Resize", 1},  {"Slice", 1},
+        {"Split", 1},           {"Squeeze", 1}, {"Tile", 1},      {"TopK", 1},    {"Unsqueeze", 1},
+        {"Upsample", 1},
+    };
+    static const set<string> ppl_dims_only_ops{
+        "ChannelShuffle", "Reorder", "Shape", "Swish",
+    };
+
+    auto& type = node->GetType();
+    uint32_t first_shape_input = node->GetInputCount();
+    if (type.domain == "") {
+        if (dims_only_ops.find(type.name) == dims_only_ops.end()) {
+            auto ref = shape_input_ops.find(type.name);
+            if (ref == shape_input_ops.end()) {
+                return false;
+            }
+            first_shape_input = ref->second;
+        }
+    } else if (type.domain != "ppl" || ppl_dims_only_ops.find(type.name) == ppl_dims_only_ops.end()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto eid = node->GetInput(i);
+        if (eid == INVALID_EDGEID) {
+            continue;
+        }
+        if (!dims_exact[eid]) {
+            return false;
+        }
+        if (i >= first_shape_input && graph_data->constants.find(eid) == graph_data->constants.end()) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+        auto eid = node->GetExtraInput(i);
+        if (eid != INVALID_EDGEID && !dims_exact[eid]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool CanBeFolded(const ir::Node* node, const OptKernelOptions& options, const vector<bool>& dims_exact) {
+    if (!IsFoldableNode(node)) {
+        return false;
+    }
+
+    auto topo = options.graph_topo;
+    auto& constants = options.graph_data->constants;
+
+    if (IsShapeNode(node)) {
+        auto eid = node->GetInput(0);
+        if (eid == INVALID_EDGEID || !dims_exact[eid]) {
+            return false;
+        }
+    } else {
+        if (node->GetInputCount() == 0) {
+            return false;
+        }
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            auto eid = node->GetInput(i);
+            if (eid != INVALID_EDGEID && constants.find(eid) == constants.end()) {
+                return false;
+            }
+        }
+    }
+
+    // edges consumed by other partitions are outputs of this one, and cannot be turned into constants of this one
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        if (IsGraphOutput(topo, node->GetOutput(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool OutputsCanBeFolded(const InputOutputInfo& info) {
+    for (uint32_t i = 0; i < info.GetOutputCount(); ++i) {
+        auto shape = info.GetOutput<TensorImpl>(i)->GetShape();
+        if (shape->GetDataType() == DATATYPE_UNKNOWN || shape->GetBytesIncludingPadding() > kMaxFoldedOutputBytes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static RetCode EvaluateNode(const ir::Node* node, const OptKernelOptions& options) {
+    auto kernel_ref = options.info->kernels.find(node->GetId());
+    if (kernel_ref == options.info->kernels.end()) {
+        return RC_NOT_FOUND;
+    }
+    auto opt_kernel = static_cast<X86OptKernel*>(kernel_ref->second.get());
+
+    TensorGetter tensor_getter(options.tensors);
+
+    InputOutputInfo IOinfo;
+    IOinfo.SetNode(node);
+    IOinfo.SetAcquireObject(&tensor_getter);
+
+    // checks output sizes before evaluating. some ops, e.g. ppl:Shape, only infer dims when being executed.
+    opt_kernel->InferType(&IOinfo);
+    auto status = opt_kernel->InferDims(&IOinfo);
+    if (status == RC_SUCCESS) {
+        if (!OutputsCanBeFolded(IOinfo)) {
+            return RC_UNSUPPORTED;
+        }
+    } else if (status != RC_NOT_FOUND) {
+        return status;
+    }
+
+    unique_ptr<KernelImpl> kernel(opt_kernel->CreateKernelImpl());
+    if (!kernel) {
+        LOG(ERROR) << "create kernel[" << node->GetName() << "] failed: oom.";
+        return RC_OUT_OF_MEMORY;
+    }
+    kernel->SetDevice(options.device);
+
+    KernelExecContext ctx;
+    ctx.SetNode(node);
+    ctx.SetAcquireObject(&tensor_getter);
+    for (uint32_t i = 0; i < ctx.GetOutputCount(); ++i) {
+        ctx.GetOutput<TensorImpl>(i)->SetDevice(options.device);
+    }
+
+    status = kernel->Execute(&ctx);
+    if (status == RC_SUCCESS && !OutputsCanBeFolded(ctx)) {
+        status = RC_UNSUPPORTED;
+    }
+    if (status != RC_SUCCESS) {
+        for (uint32_t i = 0; i < ctx.GetOutputCount(); ++i) {
+            ctx.GetOutput<TensorImpl>(i)->FreeBuffer();
+        }
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+
+// turns evaluated outputs of `node` into constants and removes `node` from the graph
+static void ReplaceNodeWithConstants(ir::Node* node, const OptKernelOptions& options) {
+    auto topo = options.graph_topo;
+    auto graph_data = options.graph_data;
+    auto tensors = options.tensors;
+    auto nid = node->GetId();
+
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        auto eid = node->GetOutput(i);
+        auto edge = topo->GetEdgeById(eid);
+        auto& tensor_ref = (*tensors)[eid];
+        auto shape = tensor_ref->GetShape();
+
+        auto data = tensor_ref->GetBufferPtr<char>();
+        graph_data->constants[eid].data = string(data, shape->GetBytesExcludingPadding());
+
+        auto& ir_shape = graph_data->shapes[eid];
+        ir_shape.data_type = shape->GetDataType();
+        ir_shape.data_format = DATAFORMAT_NDARRAY;
+        ir_shape.dims.clear();
+        if (!shape->IsScalar()) {
+            ir_shape.dims.assign(shape->GetDims(), shape->GetDims() + shape->GetDimCount());
+        }
+
+        auto constant_tensor = new TensorImpl(edge, TENSORTYPE_RESERVED);
+        *constant_tensor->GetShape() = *shape;
+        constant_tensor->TransferBufferFrom(tensor_ref.get());
+        tensor_ref.reset(constant_tensor);
+
+        topo->MarkAsConstant(eid);
+        edge->SetProducer(INVALID_NODEID);
+    }
+
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto eid = node->GetInput(i);
+        auto edge = topo->GetEdgeById(eid);
+        if (!edge) {
+            continue;
+        }
+        edge->DelConsumer(nid);
+        if (edge->CalcConsumerCount() == 0 && !IsGraphOutput(topo, eid) &&
+            graph_data->constants.find(eid) != graph_data->constants.end()) {
+            graph_data->constants.erase(eid);
+            tensors->erase(eid);
+            topo->DelEdgeById(eid);
+        }
+    }
+
+    options.info->kernels.erase(nid);
+    topo->DelNodeById(nid);
+}
+
+bool FoldShapeSubgraph(const OptKernelOptions& options) {
+    auto resource = options.resource;
+    if (!resource || resource->fixed_input_dims.empty()) {
+        return false;
+    }
+
+    auto topo = options.graph_topo;
+    auto graph_data = options.graph_data;
+
+    vector<bool> dims_exact(topo->GetMaxEdgeId(), false);
+    for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+        auto edge = topo->GetEdgeById(topo->GetInput(i));
+        if (resource->fixed_input_dims.find(edge->GetName()) != resource->fixed_input_dims.end()) {
+            dims_exact[edge->GetId()] = true;
+        }
+    }
+    for (auto it = graph_data->constants.begin(); it != graph_data->constants.end(); ++it) {
+        if (it->first < dims_exact.size()) {
+            dims_exact[it->first] = true;
+        }
+    }
+
+    vector<nodeid_t> sorted_nodes;
+    topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    TensorGetter tensor_getter(options.tensors);
+    bool graph_changed = false;
+
+    for (auto x = sorted_nodes.begin(); x != sorted_nodes.end(); ++x) {
+        auto node = topo->GetNodeById(*x);
+
+        if (CanBeFolded(node, options, dims_exact)) {
+            auto status = EvaluateNode(node, options);
+            if (status == RC_SUCCESS) {
+                for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+                    dims_exact[node->GetOutput(i)] = true;
+                }
+                ReplaceNodeWithConstants(node, options);
+                graph_changed = true;
+                continue;
+            }
+            LOG(DEBUG) << "node[" << node->GetName() << "] is not folded: " << GetRetCodeStr(status);
+        }
+
+        // dims inferred before folding may be based on unknown shape tensors
+        if (graph_changed) {
+            bool all_inputs_have_dims = true;
+            for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+                auto eid = node->GetInput(i);
+                if (eid == INVALID_EDGEID) {
+                    continue;
+                }
+                auto tensor_ref = options.tensors->find(eid);
+                if (tensor_ref == options.tensors->end() || tensor_ref->second->GetShape()->GetDimCount() == 0) {
+                    all_inputs_have_dims = false;
+                    break;
+                }
+            }
+            if (all_inputs_have_dims) {
+                InputOutputInfo IOinfo;
+                IOinfo.SetNode(node);
+                IOinfo.SetAcquireObject(&tensor_getter);
+
+                auto kernel = static_cast<X86OptKernel*>(options.info->kernels[node->GetId()].get());
+                kernel->InferType(&IOinfo);
+                kernel->InferDims(&IOinfo);
+            }
+        }
+
+        const bool outputs_exact = OutputDimsAreExact(node, graph_data, dims_exact);
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            dims_exact[node->GetOutput(i)] = outputs_exact;
+        }
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,257 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_attention.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/attention_op.h"
+#include "ppl/nn/params/onnx/softmax_param.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+
+namespace ppl { namespace nn { namespace x86 {
+
+static bool IsFp32NdarrayTensor(const OptKernelOptions &options, edgeid_t edge_id, uint32_t dim_count) {
+    auto& shape = *(*options.tensors)[edge_id]->GetShape();
+    return shape.GetDataType() == ppl::common::DATATYPE_FLOAT32 &&
+        shape.GetDataFormat() == ppl::common::DATAFORMAT_NDARRAY && shape.GetDimCount() == dim_count;
+}
+
+static bool IsSameShape(const TensorShape& a, const TensorShape& b) {
+    if (a.GetDimCount() != b.GetDimCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetDimCount(); ++i) {
+        if (a.GetDim(i) != b.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the kernel broadcasts leading dims of q, kt and v like MatMul and the mask to the scores, but never enlarges
+// the scores through the mask, as Add would.
+static bool IsSupportedAttentionShape(const OptKernelOptions &options, const ir::Edge* q_edge,
+                                      const ir::Edge* kt_edge, const ir::Edge* v_edge, const ir::Edge* mask_edge,
+                                      const ir::Edge* qk_edge, const ir::Edge* scores_edge, const ir::Edge* y_edge) {
+    auto &tensors = *options.tensors;
+    auto& q_shape = *tensors[q_edge->GetId()]->GetShape();
+    auto& kt_shape = *tensors[kt_edge->GetId()]->GetShape();
+    auto& v_shape = *tensors[v_edge->GetId()]->GetShape();
+    auto& qk_shape = *tensors[qk_edge->GetId()]->GetShape();
+    auto& scores_shape = *tensors[scores_edge->GetId()]->GetShape();
+    const uint32_t dim_count = q_shape.GetDimCount();
+
+    if (!IsSameShape(qk_shape, scores_shape)) {
+        return false;
+    }
+
+    std::vector<int64_t> y_dims(dim_count);
+    for (uint32_t i = 0; i < dim_count - 2; ++i) {
+        const int64_t qd = q_shape.GetDim(i);
+        const int64_t kd = kt_shape.GetDim(i);
+        const int64_t vd = v_shape.GetDim(i);
+        const int64_t d = std::max(qd, std::max(kd, vd));
+        if ((qd != d && qd != 1) || (kd != d && kd != 1) || (vd != d && vd != 1)) {
+            return false;
+        }
+        y_dims[i] = d;
+    }
+    y_dims[dim_count - 2] = q_shape.GetDim(dim_count - 2);
+    y_dims[dim_count - 1] = v_shape.GetDim(dim_count - 1);
+    if (kt_shape.GetDim(dim_count - 2) != q_shape.GetDim(dim_count - 1) ||
+        v_shape.GetDim(dim_count - 2) != kt_shape.GetDim(dim_count - 1)) {
+        return false;
+    }
+
+    auto& y_shape = *tensors[y_edge->GetId()]->GetShape();
+    if (y_shape.GetDimCount() != dim_count) {
+        return false;
+    }
+    for (uint32_t i = 0; i < dim_count; ++i) {
+        if (y_shape.GetDim(i) != y_dims[i] || (i < dim_count - 2 && scores_shape.GetDim(i) != y_dims[i])) {
+            return false;
+        }
+    }
+
+    if (mask_edge) {
+        auto& mask_shape = *tensors[mask_edge->GetId()]->GetShape();
+        const uint32_t mask_dim_count = mask_shape.GetDimCount();
+        if (mask_dim_count > dim_count) {
+            return false;
+        }
+        for (uint32_t i = 0; i < mask_dim_count; ++i) {
+            const int64_t md = mask_shape.GetDim(i);
+            const int64_t sd = scores_shape.GetDim(i + dim_count - mask_dim_count);
+            if (md != sd && md != 1) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+   scores = MatMul(q, kt)
+   [scores = Div(scores, c) | Mul(scores, c)]
+   [scores = Add(scores, mask)]
+   y = MatMul(Softmax(scores, axis = -1), v)
+*/
+bool FuseAttention(const OptKernelOptions &options) {
+    bool graph_changed = false;
+    auto graph_topo = options.graph_topo;
+    auto &tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto softmax_node = it->Get();
+        if (!IsOnnxNode(softmax_node, "Softmax")) {
+            continue;
+        }
+
+        auto scores_edge = graph_topo->GetEdgeById(softmax_node->GetInput(0));
+        const uint32_t dim_count = tensors[scores_edge->GetId()]->GetShape()->GetDimCount();
+        if (dim_count < 2) {
+            continue;
+        }
+        auto attr_it = options.graph_data->attrs.find(softmax_node->GetId());
+        if (attr_it == options.graph_data->attrs.end()) {
+            continue;
+        }
+        auto softmax_param = (const ppl::nn::common::SoftmaxParam*)attr_it->second.get();
+        if (softmax_param->axis != -1 && softmax_param->axis != (int32_t)dim_count - 1) {
+            continue;
+        }
+
+        // softmax -> matmul with v
+        auto prob_edge = graph_topo->GetEdgeById(softmax_node->GetOutput(0));
+        auto pv_node = GetSoleConsumer(graph_topo, prob_edge);
+        if (!IsOnnxNode(pv_node, "MatMul") || pv_node->GetInput(0) != prob_edge->GetId() ||
+            pv_node->GetInput(1) == prob_edge->GetId()) {
+            continue;
+        }
+        auto v_edge = graph_topo->GetEdgeById(pv_node->GetInput(1));
+        auto y_edge = graph_topo->GetEdgeById(pv_node->GetOutput(0));
+
+        std::vector<ir::Node*> nodes{softmax_node, pv_node};
+        ir::Edge* mask_edge = nullptr;
+        float scale = 1.0f;
+
+        // walk back from softmax to the matmul of q and kt
+        auto cur_edge = scores_edge;
+        auto cur_consumer = softmax_node;
+        auto prev_node = graph_topo->GetNodeById(cur_edge->GetProducer());
+        if (IsOnnxNode(prev_node, "Add") && prev_node->GetInputCount() == 2 &&
+            GetSoleConsumer(graph_topo, cur_edge) == cur_consumer) {
+            // scores are produced by the scaling or the matmul and used only here, unlike the mask shared by layers
+            for (uint32_t i = 0; i < 2; ++i) {
+                auto input_edge = graph_topo->GetEdgeById(prev_node->GetInput(i));
+                auto producer = graph_topo->GetNodeById(input_edge->GetProducer());
+                if ((IsOnnxNode(producer, "MatMul") || IsOnnxNode(producer, "Div") || IsOnnxNode(producer, "Mul")) &&
+                    GetSoleConsumer(graph_topo, input_edge) == prev_node) {
+                    mask_edge = graph_topo->GetEdgeById(prev_node->GetInput(1 - i));
+                    cur_edge = input_edge;
+                    break;
+                }
+            }
+            if (!mask_edge || mask_edge == cur_edge) {
+                continue;
+            }
+            nodes.push_back(prev_node);
+            cur_consumer = prev_node;
+            prev_node = graph_topo->GetNodeById(cur_edge->GetProducer());
+        }
+        if ((IsOnnxNode(prev_node, "Div") || IsOnnxNode(prev_node, "Mul")) && prev_node->GetInputCount() == 2 &&
+            GetSoleConsumer(graph_topo, cur_edge) == cur_consumer) {
+            const bool is_div = IsOnnxNode(prev_node, "Div");
+            float value = 0.0f;
+            uint32_t scores_idx = 0;
+            if (GetScalarConstant(options, graph_topo->GetEdgeById(prev_node->GetInput(1)), &value)) {
+                scores_idx = 0;
+            } else if (!is_div && GetScalarConstant(options, graph_topo->GetEdgeById(prev_node->GetInput(0)), &value)) {
+                scores_idx = 1;
+            } else {
+                continue;
+            }
+            if (is_div && value == 0.0f) {
+                continue;
+            }
+            scale = is_div ? 1.0f / value : value;
+            nodes.push_back(prev_node);
+            cur_consumer = prev_node;
+            cur_edge = graph_topo->GetEdgeById(prev_node->GetInput(scores_idx));
+            prev_node = graph_topo->GetNodeById(cur_edge->GetProducer());
+        }
+        if (!IsOnnxNode(prev_node, "MatMul") || GetSoleConsumer(graph_topo, cur_edge) != cur_consumer) {
+            continue;
+        }
+        auto qk_node = prev_node;
+        nodes.push_back(qk_node);
+        auto q_edge = graph_topo->GetEdgeById(qk_node->GetInput(0));
+        auto kt_edge = graph_topo->GetEdgeById(qk_node->GetInput(1));
+
+        // inputs of the fused node must be distinct edges
+        if (q_edge == kt_edge || q_edge == v_edge || kt_edge == v_edge ||
+            (mask_edge && (mask_edge == q_edge || mask_edge == kt_edge || mask_edge == v_edge))) {
+            continue;
+        }
+        if (!IsFp32NdarrayTensor(options, q_edge->GetId(), dim_count) ||
+            !IsFp32NdarrayTensor(options, kt_edge->GetId(), dim_count) ||
+            !IsFp32NdarrayTensor(options, v_edge->GetId(), dim_count) ||
+            (mask_edge && tensors[mask_edge->GetId()]->GetShape()->GetDataType() != ppl::common::DATATYPE_FLOAT32)) {
+            continue;
+        }
+        if (!IsSupportedAttentionShape(options, q_edge, kt_edge, v_edge, mask_edge, cur_edge, scores_edge, y_edge)) {
+            continue;
+        }
+
+        const std::string attention_node_name = "Fused_Attention_" + qk_node->GetName() + "_" + pv_node->GetName();
+        auto node_ret_pair = graph_topo->AddNode(attention_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << attention_node_name << "] already exists.";
+            continue;
+        }
+        auto attention_node = node_ret_pair.first;
+        attention_node->SetType(ir::Node::Type("ppl", "Attention", 1));
+
+        std::vector<ir::Edge*> inputs{q_edge, kt_edge, v_edge};
+        if (mask_edge) {
+            inputs.push_back(mask_edge);
+        }
+        std::vector<ir::Edge*> outputs{y_edge};
+        if (ReplaceSubgraphWithOneNode(options, nodes, inputs, outputs, attention_node) != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Replace sequence nodes with node [" << attention_node_name << "] failed.";
+            graph_topo->DelNodeById(attention_node->GetId());
+            continue;
+        }
+
+        X86OptKernel* opt_kernel = nullptr;
+        auto status = CreateX86OptKernel(options, attention_node, &opt_kernel);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Create OptKernel [" << attention_node_name << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return true; // the subgraph has already been replaced
+        }
+        ((AttentionOp*)opt_kernel)->SetScale(scale);
+        opt_kernel->SetOutputDataFormat(0, ppl::common::DATAFORMAT_NDARRAY);
+
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
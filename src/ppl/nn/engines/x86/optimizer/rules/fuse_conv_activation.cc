@@ -18,6 +18,7 @@
 #include "ppl/nn/engines/x86/optimizer/rules/fuse_conv_activation.h"
 #include "ppl/nn/engines/x86/optimizer/rules/utils.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/conv_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/convtranspose_op.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -65,7 +66,9 @@ bool FuseConvActivation(const OptKernelOptions &options) {
 
     for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
         auto node = it->Get();
-        if (node->GetType().domain == "" && node->GetType().name == "Conv") {
+        const bool is_conv = node->GetType().domain == "" && node->GetType().name == "Conv";
+        const bool is_conv_transpose = node->GetType().domain == "" && node->GetType().name == "ConvTranspose";
+        if (is_conv || is_conv_transpose) {
             auto conv_node = node;
             auto conv_output_edge_id = conv_node->GetOutput(0);
             auto conv_output_edge = graph_topo->GetEdgeById(conv_output_edge_id);
@@ -82,13 +85,21 @@ bool FuseConvActivation(const OptKernelOptions &options) {
                 continue;
             }
 
-            auto conv_kernel = static_cast<ConvOp*>(info->kernels[conv_node->GetId()].get());
+            auto opt_kernel = info->kernels[conv_node->GetId()].get();
+            auto try_fuse_relu = [is_conv, opt_kernel]() -> bool {
+                return is_conv ? static_cast<ConvOp*>(opt_kernel)->TryFuseReLU()
+                               : static_cast<ConvTransposeOp*>(opt_kernel)->TryFuseReLU();
+            };
+            auto try_fuse_relu6 = [is_conv, opt_kernel]() -> bool {
+                return is_conv ? static_cast<ConvOp*>(opt_kernel)->TryFuseReLU6()
+                               : static_cast<ConvTransposeOp*>(opt_kernel)->TryFuseReLU6();
+            };
             if (successor_node->GetType().name == "Relu") {
-                if (!conv_kernel->TryFuseReLU()) { // set fuse flag to conv_op
+                if (!try_fuse_relu()) { // set fuse flag to conv_op
                     continue;
                 }
             } else if (IsReLU6(graph_data, successor_node)) {
-                if (!conv_kernel->TryFuseReLU6()) { // set fuse flag to conv_op
+                if (!try_fuse_relu6()) { // set fuse flag to conv_op
                     continue;
                 }
                 // remove relu6's input min/max's connect in advance
@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_gelu.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/common/logger.h"
+#include <cmath>
+
+namespace ppl { namespace nn { namespace x86 {
+
+// returns true if `input_id` is an input of binary `node` and the other one is a scalar constant close to `expected`
+static bool HasScalarInput(const OptKernelOptions &options, const ir::Node* node, edgeid_t input_id,
+                           float expected) {
+    if (node->GetInputCount() != 2 || (node->GetInput(0) != input_id && node->GetInput(1) != input_id)) {
+        return false;
+    }
+    auto other_id = node->GetInput(0) == input_id ? node->GetInput(1) : node->GetInput(0);
+    float value = 0.0f;
+    return GetScalarConstant(options, options.graph_topo->GetEdgeById(other_id), &value) &&
+        std::fabs(value - expected) < 1e-4f;
+}
+
+/*
+   exported from `0.5 * x * (1 + erf(x / sqrt(2)))` in any order of the multiplications:
+   e = Add(Erf(Div(x, 1.4142) | Mul(x, 0.7071)), 1)
+   y = Mul(Mul(x, e), 0.5) | Mul(Mul(e, 0.5), x) | Mul(Mul(x, 0.5), e)
+*/
+bool FuseGelu(const OptKernelOptions &options) {
+    bool graph_changed = false;
+    auto graph_topo = options.graph_topo;
+    auto &tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto erf_node = it->Get();
+        if (!IsOnnxNode(erf_node, "Erf")) {
+            continue;
+        }
+
+        auto erf_input_edge = graph_topo->GetEdgeById(erf_node->GetInput(0));
+        if (GetSoleConsumer(graph_topo, erf_input_edge) != erf_node) {
+            continue;
+        }
+        auto scale_node = graph_topo->GetNodeById(erf_input_edge->GetProducer());
+        if (!scale_node || scale_node->GetInputCount() != 2) {
+            continue;
+        }
+        ir::Edge* x_edge = nullptr;
+        if (IsOnnxNode(scale_node, "Div")) {
+            if (HasScalarInput(options, scale_node, scale_node->GetInput(0), 1.41421356f)) {
+                x_edge = graph_topo->GetEdgeById(scale_node->GetInput(0));
+            }
+        } else if (IsOnnxNode(scale_node, "Mul")) {
+            for (uint32_t i = 0; i < 2; ++i) {
+                if (HasScalarInput(options, scale_node, scale_node->GetInput(i), 0.70710678f)) {
+                    x_edge = graph_topo->GetEdgeById(scale_node->GetInput(i));
+                }
+            }
+        }
+        if (!x_edge) {
+            continue;
+        }
+        auto& x_shape = *tensors[x_edge->GetId()]->GetShape();
+        if (x_shape.GetDataType() != ppl::common::DATATYPE_FLOAT32 ||
+            x_shape.GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
+            continue;
+        }
+
+        auto erf_output_edge = graph_topo->GetEdgeById(erf_node->GetOutput(0));
+        auto add_node = GetSoleConsumer(graph_topo, erf_output_edge);
+        if (!IsOnnxNode(add_node, "Add") || !HasScalarInput(options, add_node, erf_output_edge->GetId(), 1.0f)) {
+            continue;
+        }
+
+        std::vector<ir::Node*> nodes{scale_node, erf_node, add_node};
+        auto cur_edge = graph_topo->GetEdgeById(add_node->GetOutput(0));
+        bool has_x = false, has_half = false, matched = true;
+        while (!(has_x && has_half)) {
+            auto mul_node = GetSoleConsumer(graph_topo, cur_edge);
+            if (!IsOnnxNode(mul_node, "Mul") || mul_node->GetInputCount() != 2) {
+                matched = false;
+                break;
+            }
+            auto other_id = mul_node->GetInput(0) == cur_edge->GetId() ? mul_node->GetInput(1) : mul_node->GetInput(0);
+            auto other_producer = graph_topo->GetNodeById(graph_topo->GetEdgeById(other_id)->GetProducer());
+            if (!has_x && other_id == x_edge->GetId()) {
+                has_x = true;
+            } else if (!has_half && HasScalarInput(options, mul_node, cur_edge->GetId(), 0.5f)) {
+                has_half = true;
+            } else if (!has_x && !has_half && IsOnnxNode(other_producer, "Mul") &&
+                       HasScalarInput(options, other_producer, x_edge->GetId(), 0.5f) &&
+                       GetSoleConsumer(graph_topo, graph_topo->GetEdgeById(other_id)) == mul_node) {
+                has_x = has_half = true;
+                nodes.push_back(other_producer);
+            } else {
+                matched = false;
+                break;
+            }
+            nodes.push_back(mul_node);
+            cur_edge = graph_topo->GetEdgeById(mul_node->GetOutput(0));
+        }
+        if (!matched) {
+            continue;
+        }
+
+        const std::string gelu_node_name = "Fused_Gelu_" + erf_node->GetName() + "_" + nodes.back()->GetName();
+        auto node_ret_pair = graph_topo->AddNode(gelu_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << gelu_node_name << "] already exists.";
+            continue;
+        }
+        auto gelu_node = node_ret_pair.first;
+        gelu_node->SetType(ir::Node::Type("ppl", "Gelu", 1));
+
+        std::vector<ir::Edge*> inputs{x_edge};
+        std::vector<ir::Edge*> outputs{cur_edge};
+        if (ReplaceSubgraphWithOneNode(options, nodes, inputs, outputs, gelu_node) != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Replace sequence nodes with node [" << gelu_node_name << "] failed.";
+            graph_topo->DelNodeById(gelu_node->GetId());
+            continue;
+        }
+
+        X86OptKernel* opt_kernel = nullptr;
+        auto status = CreateX86OptKernel(options, gelu_node, &opt_kernel);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Create OptKernel [" << gelu_node_name << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return true; // the subgraph has already been replaced
+        }
+        opt_kernel->SetOutputDataFormat(0, ppl::common::DATAFORMAT_NDARRAY);
+
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
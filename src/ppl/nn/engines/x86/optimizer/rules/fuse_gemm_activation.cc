@@ -19,9 +19,90 @@
 #include "ppl/nn/engines/x86/optimizer/rules/utils.h"
 #include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
 #include "ppl/nn/engines/x86/optimizer/ops/onnx/gemm_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/matmul_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/add_op.h"
 
 namespace ppl { namespace nn { namespace x86 {
 
+// returns data of `edge` if it is a constant bias of `num_output` values that does not broadcast the output
+static const float* GetConstantBias(const OptKernelOptions &options, const ir::Edge* edge, uint32_t output_dim_count,
+                                    int64_t num_output) {
+    auto graph_data = options.graph_data;
+    auto data_it = graph_data->constants.find(edge->GetId());
+    auto shape_it = graph_data->shapes.find(edge->GetId());
+    if (data_it == graph_data->constants.end() || shape_it == graph_data->shapes.end()) {
+        return nullptr;
+    }
+
+    auto& dims = shape_it->second.dims;
+    if (shape_it->second.data_type != ppl::common::DATATYPE_FLOAT32 || dims.empty() ||
+        dims.size() > output_dim_count || dims.back() != num_output) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i + 1 < dims.size(); ++i) {
+        if (dims[i] != 1) {
+            return nullptr;
+        }
+    }
+    return (const float*)data_it->second.data.data();
+}
+
+// matmul_node -> matmul_output_edge -> add_node -> add_output_edge
+// matmul_node                                   -> add_output_edge
+static bool FuseMatMulBias(const OptKernelOptions &options, ir::Node* matmul_node, ir::Node* add_node) {
+    auto graph_topo = options.graph_topo;
+    auto info = options.info;
+    auto &tensors = *options.tensors;
+
+    auto matmul_output_edge_id = matmul_node->GetOutput(0);
+    auto& output_shape = *tensors[matmul_output_edge_id]->GetShape();
+    if (output_shape.IsEmpty() || output_shape.GetDimCount() < 1) { // output shape has not been infered
+        return false;
+    }
+    if (add_node->GetInputCount() != 2 ||
+        tensors[add_node->GetOutput(0)]->GetShape()->GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
+        return false;
+    }
+
+    auto bias_edge_id = add_node->GetInput(0) == matmul_output_edge_id ? add_node->GetInput(1) : add_node->GetInput(0);
+    auto bias_edge = graph_topo->GetEdgeById(bias_edge_id);
+    if (!bias_edge || bias_edge_id == matmul_output_edge_id) {
+        return false;
+    }
+    auto bias_data = GetConstantBias(options, bias_edge, output_shape.GetDimCount(),
+                                     output_shape.GetDim(output_shape.GetDimCount() - 1));
+    if (!bias_data) {
+        return false;
+    }
+
+    auto matmul_kernel = reinterpret_cast<MatMulOp*>(info->kernels[matmul_node->GetId()].get());
+    auto add_kernel = reinterpret_cast<AddOp*>(info->kernels[add_node->GetId()].get());
+    if (!matmul_kernel->TryFuseBias(bias_data)) {
+        return false;
+    }
+    if (add_kernel->HasFuseReLU()) {
+        matmul_kernel->TryFuseReLU();
+    }
+
+    auto add_node_id = add_node->GetId();
+    auto add_output_edge_id = add_node->GetOutput(0);
+    auto add_output_edge = graph_topo->GetEdgeById(add_output_edge_id);
+    matmul_node->ReplaceOutput(matmul_output_edge_id, add_output_edge_id);
+    add_output_edge->SetProducer(matmul_node->GetId());
+    bias_edge->DelConsumer(add_node_id);
+
+    info->kernels.erase(add_node_id);
+    tensors.erase(matmul_output_edge_id);
+    graph_topo->DelNodeById(add_node_id);
+    graph_topo->DelEdgeById(matmul_output_edge_id);
+    if (bias_edge->CalcConsumerCount() == 0) {
+        tensors.erase(bias_edge_id);
+        graph_topo->DelEdgeById(bias_edge_id);
+    }
+
+    return true;
+}
+
 bool FuseGemmActivation(const OptKernelOptions &options) {
     bool graph_changed = false;
     auto graph_topo = options.graph_topo;
@@ -30,8 +111,9 @@ bool FuseGemmActivation(const OptKernelOptions &options) {
 
     for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
         auto node = it->Get();
-        if (node->GetType().domain == "" && node->GetType().name == "Gemm") {
+        if (node->GetType().domain == "" && (node->GetType().name == "Gemm" || node->GetType().name == "MatMul")) {
             auto gemm_node = node;
+            const bool is_matmul = node->GetType().name == "MatMul";
             auto gemm_output_edge_id = gemm_node->GetOutput(0);
             auto gemm_output_edge = graph_topo->GetEdgeById(gemm_output_edge_id);
             if (gemm_output_edge->CalcConsumerCount() != 1) {
@@ -47,9 +129,21 @@ bool FuseGemmActivation(const OptKernelOptions &options) {
                 continue;
             }
 
-            auto gemm_kernel = reinterpret_cast<GemmOp*>(info->kernels[gemm_node->GetId()].get());
+            if (is_matmul && successor_node->GetType().name == "Add") {
+                if (FuseMatMulBias(options, gemm_node, successor_node)) {
+                    graph_changed = true;
+                }
+                continue;
+            }
+
             if (successor_node->GetType().name == "Relu") {
-                if (!gemm_kernel->TryFuseReLU()) { // set fuse flag to gemm_op
+                bool fused;
+                if (is_matmul) {
+                    fused = reinterpret_cast<MatMulOp*>(info->kernels[gemm_node->GetId()].get())->TryFuseReLU();
+                } else {
+                    fused = reinterpret_cast<GemmOp*>(info->kernels[gemm_node->GetId()].get())->TryFuseReLU();
+                }
+                if (!fused) { // set fuse flag to gemm_op
                     continue;
                 }
             } else {
@@ -0,0 +1,251 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/fuse_layer_norm.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/engines/x86/optimizer/ops/ppl/layer_norm_op.h"
+#include "ppl/nn/params/onnx/reduce_param.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ppl { namespace nn { namespace x86 {
+
+// returns the first normalized axis if `node` is a ReduceMean over the trailing dims of a `dim_count`-D input
+// with keep_dims, or 0 otherwise
+static int32_t GetTrailingReduceAxis(const OptKernelOptions &options, const ir::Node* node, uint32_t dim_count) {
+    auto attr_it = options.graph_data->attrs.find(node->GetId());
+    if (attr_it == options.graph_data->attrs.end()) {
+        return 0;
+    }
+    auto param = (const ppl::nn::common::ReduceParam*)attr_it->second.get();
+    if (!param->keep_dims || param->axes.empty() || param->axes.size() > dim_count) {
+        return 0;
+    }
+
+    std::vector<int32_t> axes(param->axes);
+    for (auto& axis : axes) {
+        axis = axis < 0 ? axis + dim_count : axis;
+    }
+    std::sort(axes.begin(), axes.end());
+    for (uint32_t i = 0; i < axes.size(); ++i) {
+        if (axes[i] != (int32_t)(dim_count - axes.size() + i)) {
+            return 0;
+        }
+    }
+    return axes[0];
+}
+
+// returns the other input of binary `node`, or nullptr if `edge` is not one of its inputs
+static ir::Edge* GetOtherInput(ir::GraphTopo* graph_topo, const ir::Node* node, const ir::Edge* edge) {
+    if (node->GetInputCount() != 2) {
+        return nullptr;
+    }
+    if (node->GetInput(0) == edge->GetId()) {
+        return graph_topo->GetEdgeById(node->GetInput(1));
+    }
+    if (node->GetInput(1) == edge->GetId()) {
+        return graph_topo->GetEdgeById(node->GetInput(0));
+    }
+    return nullptr;
+}
+
+// returns true if `edge` is a constant fp32 tensor that matches the normalized dims [axis, ...) of `x_shape`
+// exactly, i.e. broadcasts along the leading dims only and never broadcasts the input itself
+static bool IsConstantAffine(const OptKernelOptions &options, const ir::Edge* edge, const TensorShape& x_shape,
+                             uint32_t axis) {
+    if (!edge) {
+        return false;
+    }
+    auto graph_data = options.graph_data;
+    auto shape_it = graph_data->shapes.find(edge->GetId());
+    if (graph_data->constants.find(edge->GetId()) == graph_data->constants.end() || shape_it == graph_data->shapes.end()) {
+        return false;
+    }
+    auto& shape = shape_it->second;
+    const uint32_t dim_count = x_shape.GetDimCount();
+    if (shape.data_type != ppl::common::DATATYPE_FLOAT32 || shape.dims.size() > dim_count) {
+        return false;
+    }
+    // align dims of the constant to x from the right
+    const uint32_t offset = dim_count - shape.dims.size();
+    for (uint32_t i = 0; i < dim_count; ++i) {
+        const int64_t dim = i < offset ? 1 : shape.dims[i - offset];
+        const int64_t expected = i < axis ? 1 : x_shape.GetDim(i);
+        if (dim != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+   mean = ReduceMean(x, axes, keepdims)
+   d = Sub(x, mean)
+   var = ReduceMean(Pow(d, 2) | Mul(d, d), axes, keepdims)
+   y = Div(d, Sqrt(Add(var, eps)))
+   [y = Mul(y, gamma)]
+   [y = Add(y, beta)]
+*/
+bool FuseLayerNorm(const OptKernelOptions &options) {
+    bool graph_changed = false;
+    auto graph_topo = options.graph_topo;
+    auto &tensors = *options.tensors;
+
+    for (auto it = graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto mean_node = it->Get();
+        if (!IsOnnxNode(mean_node, "ReduceMean")) {
+            continue;
+        }
+
+        auto x_edge = graph_topo->GetEdgeById(mean_node->GetInput(0));
+        auto& x_shape = *tensors[x_edge->GetId()]->GetShape();
+        const uint32_t dim_count = x_shape.GetDimCount();
+        if (dim_count < 1 || x_shape.GetDataType() != ppl::common::DATATYPE_FLOAT32 ||
+            x_shape.GetDataFormat() != ppl::common::DATAFORMAT_NDARRAY) {
+            continue;
+        }
+        const int32_t axis = GetTrailingReduceAxis(options, mean_node, dim_count);
+        if (axis <= 0) { // normalizing over all dims is not a layer norm in bert graphs
+            continue;
+        }
+
+        // mean -> sub
+        auto mean_edge = graph_topo->GetEdgeById(mean_node->GetOutput(0));
+        auto sub_node = GetSoleConsumer(graph_topo, mean_edge);
+        if (!IsOnnxNode(sub_node, "Sub") || sub_node->GetInputCount() != 2 || sub_node->GetInput(0) != x_edge->GetId() ||
+            sub_node->GetInput(1) != mean_edge->GetId()) {
+            continue;
+        }
+
+        // d -> {pow | mul, div}
+        auto d_edge = graph_topo->GetEdgeById(sub_node->GetOutput(0));
+        if (d_edge->CalcConsumerCount() != 2 || IsGraphOutput(graph_topo, d_edge->GetId())) {
+            continue;
+        }
+        ir::Node* square_node = nullptr;
+        ir::Node* div_node = nullptr;
+        for (auto consumer_it = d_edge->CreateConsumerIter(); consumer_it.IsValid(); consumer_it.Forward()) {
+            auto consumer = graph_topo->GetNodeById(consumer_it.Get());
+            if (IsOnnxNode(consumer, "Div") && consumer->GetInput(0) == d_edge->GetId()) {
+                div_node = consumer;
+            } else if (IsOnnxNode(consumer, "Mul") && consumer->GetInputCount() == 2 &&
+                       consumer->GetInput(0) == d_edge->GetId() && consumer->GetInput(1) == d_edge->GetId()) {
+                square_node = consumer;
+            } else if (IsOnnxNode(consumer, "Pow")) {
+                float exponent = 0.0f;
+                if (consumer->GetInput(0) == d_edge->GetId() &&
+                    GetScalarConstant(options, graph_topo->GetEdgeById(consumer->GetInput(1)), &exponent) &&
+                    exponent == 2.0f) {
+                    square_node = consumer;
+                }
+            }
+        }
+        if (!square_node || !div_node) {
+            continue;
+        }
+
+        // square -> var -> add eps -> sqrt -> div
+        auto var_node = GetSoleConsumer(graph_topo, graph_topo->GetEdgeById(square_node->GetOutput(0)));
+        if (!IsOnnxNode(var_node, "ReduceMean") || GetTrailingReduceAxis(options, var_node, dim_count) != axis) {
+            continue;
+        }
+        auto var_edge = graph_topo->GetEdgeById(var_node->GetOutput(0));
+        auto eps_node = GetSoleConsumer(graph_topo, var_edge);
+        if (!IsOnnxNode(eps_node, "Add")) {
+            continue;
+        }
+        float epsilon = 0.0f;
+        if (!GetScalarConstant(options, GetOtherInput(graph_topo, eps_node, var_edge), &epsilon)) {
+            continue;
+        }
+        auto sqrt_node = GetSoleConsumer(graph_topo, graph_topo->GetEdgeById(eps_node->GetOutput(0)));
+        if (!IsOnnxNode(sqrt_node, "Sqrt")) {
+            continue;
+        }
+        auto std_edge = graph_topo->GetEdgeById(sqrt_node->GetOutput(0));
+        if (GetSoleConsumer(graph_topo, std_edge) != div_node || div_node->GetInput(1) != std_edge->GetId()) {
+            continue;
+        }
+
+        std::vector<ir::Node*> nodes{mean_node, sub_node, square_node, var_node, eps_node, sqrt_node, div_node};
+        std::vector<ir::Edge*> inputs{x_edge};
+        auto y_edge = graph_topo->GetEdgeById(div_node->GetOutput(0));
+
+        // optional affine transform
+        ir::Edge* gamma_edge = nullptr;
+        ir::Edge* beta_edge = nullptr;
+        auto next_node = GetSoleConsumer(graph_topo, y_edge);
+        if (IsOnnxNode(next_node, "Mul")) {
+            auto edge = GetOtherInput(graph_topo, next_node, y_edge);
+            if (IsConstantAffine(options, edge, x_shape, axis)) {
+                gamma_edge = edge;
+                nodes.push_back(next_node);
+                y_edge = graph_topo->GetEdgeById(next_node->GetOutput(0));
+                next_node = GetSoleConsumer(graph_topo, y_edge);
+            }
+        }
+        if (gamma_edge && IsOnnxNode(next_node, "Add")) {
+            auto edge = GetOtherInput(graph_topo, next_node, y_edge);
+            if (edge != gamma_edge && IsConstantAffine(options, edge, x_shape, axis)) {
+                beta_edge = edge;
+                nodes.push_back(next_node);
+                y_edge = graph_topo->GetEdgeById(next_node->GetOutput(0));
+            }
+        }
+        if (gamma_edge) {
+            inputs.push_back(gamma_edge);
+        }
+        if (beta_edge) {
+            inputs.push_back(beta_edge);
+        }
+
+        const std::string layer_norm_node_name = "Fused_LayerNorm_" + mean_node->GetName() + "_" + nodes.back()->GetName();
+        auto node_ret_pair = graph_topo->AddNode(layer_norm_node_name);
+        if (!node_ret_pair.second) {
+            LOG(ERROR) << "node[" << layer_norm_node_name << "] already exists.";
+            continue;
+        }
+        auto layer_norm_node = node_ret_pair.first;
+        layer_norm_node->SetType(ir::Node::Type("ppl", "LayerNorm", 1));
+
+        std::vector<ir::Edge*> outputs{y_edge};
+        if (ReplaceSubgraphWithOneNode(options, nodes, inputs, outputs, layer_norm_node) != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Replace sequence nodes with node [" << layer_norm_node_name << "] failed.";
+            graph_topo->DelNodeById(layer_norm_node->GetId());
+            continue;
+        }
+
+        X86OptKernel* opt_kernel = nullptr;
+        auto status = CreateX86OptKernel(options, layer_norm_node, &opt_kernel);
+        if (status != ppl::common::RC_SUCCESS) {
+            LOG(ERROR) << "Create OptKernel [" << layer_norm_node_name << "] failed: " << ppl::common::GetRetCodeStr(status);
+            return true; // the subgraph has already been replaced
+        }
+        auto layer_norm_kernel = (LayerNormOp*)opt_kernel;
+        layer_norm_kernel->SetAxis(axis - (int32_t)dim_count); // negative axis works for any batch dims
+        layer_norm_kernel->SetEpsilon(epsilon);
+        layer_norm_kernel->SetOutputDataFormat(0, ppl::common::DATAFORMAT_NDARRAY);
+
+        graph_changed = true;
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
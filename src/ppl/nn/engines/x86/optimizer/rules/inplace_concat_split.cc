@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/optimizer/rules/inplace_concat_split.h"
+#include "ppl/nn/engines/x86/optimizer/rules/utils.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/concat_op.h"
+#include "ppl/nn/engines/x86/optimizer/ops/onnx/split_op.h"
+#include <set>
+using namespace std;
+
+namespace ppl { namespace nn { namespace x86 {
+
+// kernels which may hand their input buffers over to outputs by TensorImpl::TransferBufferFrom()
+static bool MayForwardInputBuffer(const ir::Node* node) {
+    static const set<string> forwarding_ops = {"Add",  "Sub",      "Mul",       "Div",     "Identity", "Reshape",
+                                               "Cast", "Flatten", "Squeeze", "Unsqueeze", "Pad",     "Reorder"};
+    return (forwarding_ops.find(node->GetType().name) != forwarding_ops.end());
+}
+
+/*
+  in-place buffers are overwritten in the next run (or the next iteration of a Loop subgraph), so they must not
+  be seen from outputs of the graph, either directly or through buffers forwarded by consumers.
+*/
+static bool IsReachableFromGraphOutputs(const ir::GraphTopo* graph_topo, edgeid_t eid) {
+    if (IsGraphOutput(graph_topo, eid)) {
+        return true;
+    }
+
+    auto edge = graph_topo->GetEdgeById(eid);
+    for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+        auto consumer = graph_topo->GetNodeById(it.Get());
+        if (!MayForwardInputBuffer(consumer)) {
+            continue;
+        }
+        for (uint32_t i = 0; i < consumer->GetOutputCount(); ++i) {
+            auto output_eid = consumer->GetOutput(i);
+            if (output_eid != INVALID_EDGEID && IsReachableFromGraphOutputs(graph_topo, output_eid)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// returns the producer of `edge` and the index of `edge` in its outputs, or nullptr if it is not produced here
+static const ir::Node* GetProducer(const ir::GraphTopo* graph_topo, const ir::Edge* edge, uint32_t* output_idx) {
+    auto producer = graph_topo->GetNodeById(edge->GetProducer());
+    if (!producer) {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < producer->GetOutputCount(); ++i) {
+        if (producer->GetOutput(i) == edge->GetId()) {
+            *output_idx = i;
+            return producer;
+        }
+    }
+    return nullptr;
+}
+
+static bool TryInplaceConcat(ir::Node* node, const OptKernelOptions& options) {
+    auto graph_topo = options.graph_topo;
+    auto& kernels = options.info->kernels;
+
+    if (node->GetInputCount() < 2 || IsReachableFromGraphOutputs(graph_topo, node->GetOutput(0))) {
+        return false;
+    }
+
+    vector<pair<X86OptKernel*, uint32_t>> producers(node->GetInputCount());
+    set<edgeid_t> input_eids;
+    for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+        auto edge = graph_topo->GetEdgeById(node->GetInput(i));
+        if (!edge || !input_eids.insert(edge->GetId()).second || GetSoleConsumer(graph_topo, edge) != node) {
+            return false;
+        }
+
+        uint32_t output_idx = 0;
+        auto producer = GetProducer(graph_topo, edge, &output_idx);
+        if (!producer || kernels.find(producer->GetId()) == kernels.end()) {
+            return false;
+        }
+        producers[i] = make_pair(static_cast<X86OptKernel*>(kernels[producer->GetId()].get()), output_idx);
+    }
+
+    for (uint32_t i = 0; i < producers.size(); ++i) {
+        producers[i].first->SetOutputInplaceTarget(producers[i].second, node->GetId(), i);
+    }
+    static_cast<ConcatOp*>(kernels[node->GetId()].get())->SetInplace(true);
+
+    return true;
+}
+
+static bool TryInplaceSplit(ir::Node* node, const OptKernelOptions& options) {
+    auto graph_topo = options.graph_topo;
+    auto& kernels = options.info->kernels;
+
+    // consumers of outputs may write into the input buffer, so the input cannot be used by others
+    auto edge = graph_topo->GetEdgeById(node->GetInput(0));
+    if (!edge || GetSoleConsumer(graph_topo, edge) != node) {
+        return false;
+    }
+    for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+        if (IsReachableFromGraphOutputs(graph_topo, node->GetOutput(i))) {
+            return false;
+        }
+    }
+
+    uint32_t output_idx = 0;
+    auto producer = GetProducer(graph_topo, edge, &output_idx);
+    if (!producer || kernels.find(producer->GetId()) == kernels.end()) {
+        return false;
+    }
+
+    auto producer_kernel = static_cast<X86OptKernel*>(kernels[producer->GetId()].get());
+    if (producer_kernel->HasOutputInplaceTarget(output_idx)) {
+        return false;
+    }
+
+    producer_kernel->SetOutputInplaceTarget(output_idx, node->GetId(), 0);
+    static_cast<SplitOp*>(kernels[node->GetId()].get())->SetInplace(true);
+
+    return true;
+}
+
+bool InplaceConcatSplit(const OptKernelOptions& options) {
+    bool graph_changed = false;
+
+    for (auto it = options.graph_topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        if (IsOnnxNode(node, "Concat")) {
+            graph_changed = TryInplaceConcat(node, options) || graph_changed;
+        } else if (IsOnnxNode(node, "Split")) {
+            graph_changed = TryInplaceSplit(node, options) || graph_changed;
+        }
+    }
+
+    return graph_changed;
+}
+
+}}} // namespace ppl::nn::x86
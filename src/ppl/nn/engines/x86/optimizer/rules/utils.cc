@@ -19,6 +19,24 @@
 
 namespace ppl { namespace nn { namespace x86 {
 
+bool GetScalarConstant(const OptKernelOptions& options, const ir::Edge* edge, float* value) {
+    if (!edge) {
+        return false;
+    }
+    auto graph_data = options.graph_data;
+    auto data_it = graph_data->constants.find(edge->GetId());
+    auto shape_it = graph_data->shapes.find(edge->GetId());
+    if (data_it == graph_data->constants.end() || shape_it == graph_data->shapes.end()) {
+        return false;
+    }
+    if (shape_it->second.data_type != ppl::common::DATATYPE_FLOAT32 ||
+        data_it->second.data.size() != sizeof(float)) {
+        return false;
+    }
+    *value = *(const float*)data_it->second.data.data();
+    return true;
+}
+
 // replace subgraph with one node
 ppl::common::RetCode ReplaceSubgraphWithOneNode(
     const OptKernelOptions& options, std::vector<ir::Node*>& nodes,
@@ -64,6 +64,21 @@ inline bool IsGraphOutput(const ir::GraphTopo* graph_topo, edgeid_t edge_id) {
     return false;
 }
 
+// returns the only consumer of `edge`, or nullptr if `edge` has other consumers or is an output of graph
+inline ir::Node* GetSoleConsumer(ir::GraphTopo* graph_topo, const ir::Edge* edge) {
+    if (!edge || edge->CalcConsumerCount() != 1 || IsGraphOutput(graph_topo, edge->GetId())) {
+        return nullptr;
+    }
+    return graph_topo->GetNodeById(edge->CreateConsumerIter().Get());
+}
+
+inline bool IsOnnxNode(const ir::Node* node, const char* name) {
+    return node && node->GetType().domain == "" && node->GetType().name == name;
+}
+
+// returns true if `edge` is a constant fp32 tensor of exactly one element and stores it in `value`
+bool GetScalarConstant(const OptKernelOptions& options, const ir::Edge* edge, float* value);
+
 // replace subgraph with one node
 ppl::common::RetCode ReplaceSubgraphWithOneNode(
     const OptKernelOptions& options, std::vector<ir::Node*>& nodes,
@@ -0,0 +1,271 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/engines/x86/packed_weights_cache.h"
+#include "ppl/nn/utils/version.h"
+#include "ppl/nn/common/logger.h"
+#include <string.h>
+#include <stdio.h>
+#include <fstream>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+namespace ppl { namespace nn { namespace x86 {
+
+/*
+  file layout:
+    FileHeader
+    [EntryHeader, name(padded to 8 bytes)] * entry_count
+    weights, each of them is aligned to g_data_alignment
+*/
+
+static const char g_magic[8] = {'P', 'P', 'L', 'N', 'N', 'X', '8', '6'};
+
+// changes whenever layout of the file or structs of kernel params change
+static const uint32_t g_format_version = 2;
+
+static const uint64_t g_data_alignment = 64;
+
+struct FileHeader final {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t isa;
+    char lib_version[64];
+    uint32_t entry_count;
+    uint32_t reserved;
+};
+
+struct EntryHeader final {
+    uint32_t name_len;
+    uint32_t reserved;
+    conv2d_fp32_param param;
+    conv2d_fp32_algo_info algo_info;
+    uint64_t filter_offset;
+    uint64_t filter_bytes;
+    uint64_t bias_offset;
+    uint64_t bias_bytes;
+    uint64_t weights_hash;
+};
+
+static inline uint64_t Align(uint64_t v, uint64_t alignment) {
+    return (v + alignment - 1) / alignment * alignment;
+}
+
+static bool Conv2dParamEqual(const conv2d_fp32_param& a, const conv2d_fp32_param& b) {
+    return (a.kernel_h == b.kernel_h && a.kernel_w == b.kernel_w && a.stride_h == b.stride_h &&
+            a.stride_w == b.stride_w && a.dilation_h == b.dilation_h && a.dilation_w == b.dilation_w &&
+            a.pad_h == b.pad_h && a.pad_w == b.pad_w && a.channels == b.channels && a.num_output == b.num_output &&
+            a.group == b.group);
+}
+
+RetCode PackedWeightsCache::Import(const char* filename, isa_t isa) {
+    if (fm_.Data()) {
+        LOG(ERROR) << "packed weights have been imported.";
+        return RC_EXISTS;
+    }
+
+    auto status = fm_.Init(filename);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "map file[" << filename << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    auto base = fm_.Data();
+    const uint64_t size = fm_.Size();
+
+    if (size < sizeof(FileHeader)) {
+        LOG(ERROR) << "invalid packed weights file[" << filename << "]: size [" << size << "] is too small.";
+        return RC_INVALID_VALUE;
+    }
+
+    auto header = (const FileHeader*)base;
+    if (memcmp(header->magic, g_magic, sizeof(g_magic)) != 0) {
+        LOG(ERROR) << "[" << filename << "] is not a packed weights file.";
+        return RC_INVALID_VALUE;
+    }
+    if (header->format_version != g_format_version) {
+        LOG(ERROR) << "format version [" << header->format_version << "] of [" << filename
+                   << "] is different from the current version [" << g_format_version << "].";
+        return RC_UNSUPPORTED;
+    }
+    if (header->isa != isa) {
+        LOG(ERROR) << "isa [" << header->isa << "] of [" << filename << "] is different from the current isa [" << isa
+                   << "].";
+        return RC_UNSUPPORTED;
+    }
+    if (strncmp(header->lib_version, GetVersionString(), sizeof(header->lib_version)) != 0) {
+        LOG(ERROR) << "[" << filename << "] is generated by library version ["
+                   << string(header->lib_version, strnlen(header->lib_version, sizeof(header->lib_version)))
+                   << "], which is different from the current version [" << GetVersionString() << "].";
+        return RC_UNSUPPORTED;
+    }
+
+    uint64_t offset = sizeof(FileHeader);
+    for (uint32_t i = 0; i < header->entry_count; ++i) {
+        if (offset + sizeof(EntryHeader) > size) {
+            LOG(ERROR) << "invalid packed weights file[" << filename << "]: entry [" << i << "] is out of range.";
+            return RC_INVALID_VALUE;
+        }
+        auto entry = (const EntryHeader*)(base + offset);
+        offset += sizeof(EntryHeader);
+
+        if (offset + entry->name_len > size || entry->filter_offset + entry->filter_bytes > size ||
+            entry->bias_offset + entry->bias_bytes > size) {
+            LOG(ERROR) << "invalid packed weights file[" << filename << "]: data of entry [" << i
+                       << "] is out of range.";
+            return RC_INVALID_VALUE;
+        }
+
+        string name(base + offset, entry->name_len);
+        offset += Align(entry->name_len, 8);
+
+        Conv2dInfo info;
+        info.param = entry->param;
+        info.algo_info = entry->algo_info;
+        info.cvt_filter = (const float*)(base + entry->filter_offset);
+        info.cvt_filter_size = entry->filter_bytes / sizeof(float);
+        info.cvt_bias = (const float*)(base + entry->bias_offset);
+        info.cvt_bias_size = entry->bias_bytes / sizeof(float);
+        info.weights_hash = entry->weights_hash;
+        imported_conv2d_infos_.insert(make_pair(name, info));
+    }
+
+    LOG(INFO) << "[" << imported_conv2d_infos_.size() << "] packed weights are imported from [" << filename << "].";
+    return RC_SUCCESS;
+}
+
+RetCode PackedWeightsCache::Export(const char* filename, isa_t isa) const {
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, g_magic, sizeof(g_magic));
+    header.format_version = g_format_version;
+    header.isa = isa;
+    strncpy(header.lib_version, GetVersionString(), sizeof(header.lib_version) - 1);
+    header.entry_count = exported_conv2d_infos_.size();
+
+    uint64_t data_offset = sizeof(FileHeader);
+    for (auto it = exported_conv2d_infos_.begin(); it != exported_conv2d_infos_.end(); ++it) {
+        data_offset += sizeof(EntryHeader) + Align(it->first.size(), 8);
+    }
+    data_offset = Align(data_offset, g_data_alignment);
+
+    vector<EntryHeader> entries;
+    entries.reserve(exported_conv2d_infos_.size());
+    for (auto it = exported_conv2d_infos_.begin(); it != exported_conv2d_infos_.end(); ++it) {
+        auto& info = it->second;
+
+        EntryHeader entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.name_len = it->first.size();
+        entry.param = info.param;
+        entry.algo_info = info.algo_info;
+        entry.weights_hash = info.weights_hash;
+
+        entry.filter_offset = data_offset;
+        entry.filter_bytes = info.cvt_filter_size * sizeof(float);
+        data_offset = Align(data_offset + entry.filter_bytes, g_data_alignment);
+
+        entry.bias_offset = data_offset;
+        entry.bias_bytes = info.cvt_bias_size * sizeof(float);
+        data_offset = Align(data_offset + entry.bias_bytes, g_data_alignment);
+
+        entries.push_back(entry);
+    }
+
+    // writes to a temporary file in case that `filename` is being mapped
+    const string tmp_filename = string(filename) + ".tmp";
+    ofstream ofs(tmp_filename, ios_base::out | ios_base::binary | ios_base::trunc);
+    if (!ofs.is_open()) {
+        LOG(ERROR) << "open file[" << tmp_filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    const char padding[g_data_alignment] = {0};
+
+    ofs.write((const char*)&header, sizeof(header));
+    uint32_t idx = 0;
+    for (auto it = exported_conv2d_infos_.begin(); it != exported_conv2d_infos_.end(); ++it, ++idx) {
+        ofs.write((const char*)&entries[idx], sizeof(EntryHeader));
+        ofs.write(it->first.data(), it->first.size());
+        ofs.write(padding, Align(it->first.size(), 8) - it->first.size());
+    }
+
+    idx = 0;
+    for (auto it = exported_conv2d_infos_.begin(); it != exported_conv2d_infos_.end(); ++it, ++idx) {
+        auto& entry = entries[idx];
+        ofs.write(padding, entry.filter_offset - (uint64_t)ofs.tellp());
+        ofs.write((const char*)it->second.cvt_filter, entry.filter_bytes);
+        ofs.write(padding, entry.bias_offset - (uint64_t)ofs.tellp());
+        ofs.write((const char*)it->second.cvt_bias, entry.bias_bytes);
+    }
+
+    if (!ofs.good()) {
+        LOG(ERROR) << "write file[" << tmp_filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+    ofs.close();
+
+    if (rename(tmp_filename.c_str(), filename) != 0) {
+        LOG(ERROR) << "rename [" << tmp_filename << "] to [" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    LOG(INFO) << "[" << exported_conv2d_infos_.size() << "] packed weights are exported to [" << filename << "].";
+    return RC_SUCCESS;
+}
+
+const PackedWeightsCache::Conv2dInfo* PackedWeightsCache::FindConv2dInfo(const string& name,
+                                                                         const conv2d_fp32_param& param,
+                                                                         uint64_t weights_hash) const {
+    auto ref = imported_conv2d_infos_.find(name);
+    if (ref == imported_conv2d_infos_.end()) {
+        return nullptr;
+    }
+    if (!Conv2dParamEqual(ref->second.param, param)) {
+        LOG(WARNING) << "param of conv2d[" << name << "] is different from the imported one.";
+        return nullptr;
+    }
+    if (ref->second.weights_hash != weights_hash) {
+        LOG(WARNING) << "weights of conv2d[" << name << "] are different from the imported ones.";
+        return nullptr;
+    }
+    return &ref->second;
+}
+
+// FNV-1a over 64-bit words, followed by the remaining bytes
+uint64_t PackedWeightsCache::HashWeights(const void* data, uint64_t bytes, uint64_t seed) {
+    static const uint64_t offset_basis = 14695981039346656037ull;
+    static const uint64_t prime = 1099511628211ull;
+
+    uint64_t h = offset_basis ^ seed;
+    auto p = (const uint8_t*)data;
+
+    const uint64_t word_count = bytes / sizeof(uint64_t);
+    for (uint64_t i = 0; i < word_count; ++i) {
+        uint64_t word;
+        memcpy(&word, p + i * sizeof(uint64_t), sizeof(uint64_t));
+        h = (h ^ word) * prime;
+    }
+    for (uint64_t i = word_count * sizeof(uint64_t); i < bytes; ++i) {
+        h = (h ^ p[i]) * prime;
+    }
+
+    return (h ^ bytes) * prime;
+}
+
+}}} // namespace ppl::nn::x86
@@ -0,0 +1,130 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_PACKED_WEIGHTS_CACHE_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_PACKED_WEIGHTS_CACHE_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/common/allocator.h"
+#include "ppl/common/file_mapping.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include <string>
+#include <vector>
+#include <map>
+
+namespace ppl { namespace nn { namespace x86 {
+
+/**
+   @class PackedWeightsCache
+   @brief selected algorithms and converted weights of kernels, which can be saved into a file and
+   mapped into memory in later processes to skip algorithm selection and weight conversion.
+   @note the file is valid only for the same ISA and library version.
+*/
+class PackedWeightsCache final {
+public:
+    struct Conv2dInfo final {
+        ppl::kernel::x86::conv2d_fp32_param param;
+        ppl::kernel::x86::conv2d_fp32_algo_info algo_info;
+        const float* cvt_filter = nullptr;
+        uint64_t cvt_filter_size = 0; // number of elements
+        const float* cvt_bias = nullptr;
+        uint64_t cvt_bias_size = 0; // number of elements
+        uint64_t weights_hash = 0; // hash of the source filter and bias, see `HashWeights()`
+    };
+
+public:
+    PackedWeightsCache(ppl::common::Allocator* ar) : allocator_(this, ar) {}
+
+    /** @brief maps file `filename` into memory */
+    ppl::common::RetCode Import(const char* filename, ppl::common::isa_t isa);
+
+    /**
+       @brief saves infos added by `AddConv2dInfo()` into file `filename`.
+       @note `filename` may be the imported file. it is written to a temporary file and renamed, so the
+       imported mapping stays valid.
+    */
+    ppl::common::RetCode Export(const char* filename, ppl::common::isa_t isa) const;
+
+    /**
+       @brief finds imported info of conv2d kernel named `name`.
+       @return nullptr if not found, or param or weights hash of the found info is different from `param` or
+       `weights_hash`, in which case the weights should be converted again.
+    */
+    const Conv2dInfo* FindConv2dInfo(const std::string& name, const ppl::kernel::x86::conv2d_fp32_param& param,
+                                     uint64_t weights_hash) const;
+
+    uint32_t GetImportedConv2dInfoCount() const {
+        return imported_conv2d_infos_.size();
+    }
+
+    /** @brief hashes `bytes` bytes of source weights starting from `data`, continuing from `seed` */
+    static uint64_t HashWeights(const void* data, uint64_t bytes, uint64_t seed = 0);
+
+    /**
+       @brief adds info of conv2d kernel named `name` to be exported.
+       @note weights are not copied and MUST be valid until `Export()` is called. imported infos can be added as
+       they are.
+    */
+    void AddConv2dInfo(const std::string& name, const Conv2dInfo& info) {
+        exported_conv2d_infos_[name] = info;
+    }
+
+    /**
+       @brief allocator that should be used by managers using imported weights. it does nothing
+       when freeing imported weights, and uses the given allocator otherwise.
+    */
+    ppl::common::Allocator* GetAllocator() {
+        return &allocator_;
+    }
+
+private:
+    class MappedAllocator final : public ppl::common::Allocator {
+    public:
+        MappedAllocator(const PackedWeightsCache* cache, ppl::common::Allocator* ar) : cache_(cache), allocator_(ar) {}
+        void* Alloc(uint64_t bytes) override {
+            return allocator_->Alloc(bytes);
+        }
+        void Free(void* ptr) override {
+            if (!cache_->IsMapped(ptr)) {
+                allocator_->Free(ptr);
+            }
+        }
+
+    private:
+        const PackedWeightsCache* cache_;
+        ppl::common::Allocator* allocator_;
+    };
+
+    bool IsMapped(const void* ptr) const {
+        auto base = fm_.Data();
+        return (base && ptr >= base && ptr < base + fm_.Size());
+    }
+
+private:
+    MappedAllocator allocator_;
+    ppl::common::FileMapping fm_;
+    std::map<std::string, Conv2dInfo> imported_conv2d_infos_;
+    std::map<std::string, Conv2dInfo> exported_conv2d_infos_;
+
+private:
+    PackedWeightsCache(const PackedWeightsCache&) = delete;
+    PackedWeightsCache& operator=(const PackedWeightsCache&) = delete;
+};
+
+}}} // namespace ppl::nn::x86
+
+#endif
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_CONV_TRANSPOSE_PARAM_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_CONV_TRANSPOSE_PARAM_H_
+
+#include "ppl/kernel/x86/common/conv_common.h"
+#include "ppl/common/allocator.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+/** @brief converted constant weights of ConvTranspose running in N16CX */
+struct ConvTransposeN16cxParam {
+    int32_t channels = 0;
+    int32_t num_output = 0;
+    float* cvt_filter = nullptr;
+    float* cvt_bias = nullptr;
+    ppl::kernel::x86::conv_fuse_flag_t fuse_flag = 0;
+    ppl::common::Allocator* allocator = nullptr;
+
+    ~ConvTransposeN16cxParam() {
+        if (cvt_filter != nullptr) {
+            allocator->Free(cvt_filter);
+        }
+        if (cvt_bias != nullptr) {
+            allocator->Free(cvt_bias);
+        }
+    }
+};
+
+}}}; // namespace ppl::nn::x86
+
+#endif
@@ -0,0 +1,42 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_MATMUL_FC_PARAM_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_MATMUL_FC_PARAM_H_
+
+#include "ppl/nn/engines/x86/params/fc_param.h"
+#include <vector>
+
+namespace ppl { namespace nn { namespace x86 {
+
+struct MatMulFCParam {
+    std::vector<int64_t> weight_dims; // dims of the constant B, [..., K, N]
+    std::vector<FCParam*> fc_params; // one pre-packed matrix for each batch of B
+
+    ~MatMulFCParam() {
+        for (auto p : fc_params) {
+            if (p->mgr != nullptr) {
+                p->mgr->release_cvt_weights();
+            }
+            delete p;
+        }
+    }
+};
+
+}}}; // namespace ppl::nn::x86
+
+#endif
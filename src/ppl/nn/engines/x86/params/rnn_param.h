@@ -0,0 +1,53 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_RNN_PARAM_H_
+#define _ST_HPC_PPL_NN_ENGINES_X86_PARAMS_RNN_PARAM_H_
+
+#include "ppl/nn/engines/x86/params/fc_param.h"
+
+namespace ppl { namespace nn { namespace x86 {
+
+/** @brief pre-packed constant weights of LSTM and GRU */
+struct RNNParam {
+    // W as fc weights [num_direction * num_gate * hidden_size, input_size], with biases folded in
+    FCParam* fc_param = nullptr;
+    // R packed by rnn_fp32_fma_pack_recurrent_weight()
+    float* packed_R = nullptr;
+    // recurrent bias of gate h, only used by GRU with linear_before_reset
+    float* Rbh = nullptr;
+    ppl::common::Allocator* allocator = nullptr;
+
+    ~RNNParam() {
+        if (fc_param != nullptr) {
+            if (fc_param->mgr != nullptr) {
+                fc_param->mgr->release_cvt_weights();
+            }
+            delete fc_param;
+        }
+        if (packed_R != nullptr) {
+            allocator->Free(packed_R);
+        }
+        if (Rbh != nullptr) {
+            allocator->Free(Rbh);
+        }
+    }
+};
+
+}}}; // namespace ppl::nn::x86
+
+#endif
@@ -29,14 +29,23 @@ namespace ppl { namespace nn { namespace x86 {
 
 static void DummyDeleter(ppl::common::Allocator*) {}
 
-RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_policy)
-    : X86Device(alignment, isa), mm_policy_(mm_policy), tmp_buffer_size_(0) {
+RuntimeX86Device::RuntimeX86Device(uint64_t alignment, isa_t isa, uint32_t mm_policy,
+                                   const shared_ptr<Allocator>& allocator)
+    : X86Device(alignment, isa), mm_policy_(mm_policy), concurrent_access_(false), tmp_buffer_size_(0) {
+    if (allocator) {
+        allocator_ = allocator;
+        SetAllocator(allocator.get());
+    }
+
     if (mm_policy_ == X86_MM_MRU) {
-        auto allocator_ptr = X86Device::GetAllocator();
-        allocator_ = std::shared_ptr<Allocator>(allocator_ptr, DummyDeleter);
-        buffer_manager_.reset(new utils::StackBufferManager(allocator_ptr));
+        if (!allocator_) {
+            allocator_ = std::shared_ptr<Allocator>(X86Device::GetAllocator(), DummyDeleter);
+        }
+        buffer_manager_.reset(new utils::StackBufferManager(allocator_.get()));
     } else if (mm_policy_ == X86_MM_COMPACT) {
-        allocator_.reset(new utils::CpuBlockAllocator());
+        if (!allocator_) {
+            allocator_.reset(new utils::CpuBlockAllocator());
+        }
         buffer_manager_.reset(new utils::CompactBufferManager(allocator_.get(), alignment, 64u));
     }
 }
@@ -48,9 +57,20 @@ RuntimeX86Device::~RuntimeX86Device() {
         buffer_manager_->Free(&shared_tmp_buffer_);
     }
     buffer_manager_.reset();
+
+    for (auto it = inplace_buffers_.begin(); it != inplace_buffers_.end(); ++it) {
+        if (it->second.addr) {
+            allocator_->Free(it->second.addr);
+        }
+    }
 }
 
 RetCode RuntimeX86Device::AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
+    if (concurrent_access_) {
+        *buffer = BufferDesc();
+        return Realloc(bytes, buffer);
+    }
+
     if (mm_policy_ == X86_MM_COMPACT) {
         auto ret = buffer_manager_->Realloc(bytes, &shared_tmp_buffer_);
         if (RC_SUCCESS != ret) {
@@ -70,11 +90,59 @@ RetCode RuntimeX86Device::AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) {
 }
 
 void RuntimeX86Device::FreeTmpBuffer(BufferDesc* buffer) {
+    if (concurrent_access_) {
+        Free(buffer);
+        return;
+    }
+
     if (mm_policy_ == X86_MM_COMPACT) {
         buffer_manager_->Free(&shared_tmp_buffer_);
     }
 }
 
+RetCode RuntimeX86Device::SetConcurrentAccess(bool enable) {
+    if (enable && tmp_buffer_size_) {
+        // shared tmp buffer of MRU policy is not used any more
+        buffer_manager_->Free(&shared_tmp_buffer_);
+        tmp_buffer_size_ = 0;
+    }
+    concurrent_access_ = enable;
+    return RC_SUCCESS;
+}
+
+InplaceBuffer* RuntimeX86Device::GetInplaceBuffer(nodeid_t nid) {
+    if (concurrent_access_) {
+        std::lock_guard<std::mutex> __guard__(mm_lock_);
+        return &inplace_buffers_[nid];
+    }
+    return &inplace_buffers_[nid];
+}
+
+RetCode RuntimeX86Device::ReserveInplaceBuffer(uint64_t bytes, InplaceBuffer* buffer) {
+    if (bytes <= buffer->capacity) {
+        return RC_SUCCESS;
+    }
+
+    std::unique_lock<std::mutex> __guard__(mm_lock_, std::defer_lock);
+    if (concurrent_access_) {
+        __guard__.lock();
+    }
+
+    if (buffer->addr) {
+        allocator_->Free(buffer->addr);
+    }
+    buffer->capacity = 0;
+
+    buffer->addr = allocator_->Alloc(bytes);
+    if (!buffer->addr) {
+        LOG(ERROR) << "allocate [" << bytes << "] bytes for in-place buffer failed.";
+        return RC_OUT_OF_MEMORY;
+    }
+    buffer->capacity = bytes;
+
+    return RC_SUCCESS;
+}
+
 /* -------------------------------------------------------------------------- */
 
 RetCode RuntimeX86Device::DoMemDefrag(RuntimeX86Device* dev, va_list) {
@@ -21,6 +21,9 @@
 #include "ppl/nn/engines/x86/x86_device.h"
 #include "ppl/nn/utils/buffer_manager.h"
 #include "ppl/common/allocator.h"
+#include <memory>
+#include <mutex>
+#include <map>
 
 namespace ppl { namespace nn { namespace x86 {
 
@@ -31,7 +34,9 @@ private:
     }
 
 public:
-    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mm_policy);
+    /** @param allocator used by buffer managers instead of the default ones if it is not nullptr */
+    RuntimeX86Device(uint64_t alignment, ppl::common::isa_t isa, uint32_t mm_policy,
+                     const std::shared_ptr<ppl::common::Allocator>& allocator = nullptr);
     ~RuntimeX86Device();
 
     ppl::common::Allocator* GetAllocator() const override {
@@ -39,16 +44,37 @@ public:
     }
 
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
+        if (concurrent_access_) {
+            std::lock_guard<std::mutex> __guard__(mm_lock_);
+            return buffer_manager_->Realloc(bytes, buffer);
+        }
         return buffer_manager_->Realloc(bytes, buffer);
     }
 
     void Free(BufferDesc* buffer) override {
+        if (concurrent_access_) {
+            std::lock_guard<std::mutex> __guard__(mm_lock_);
+            buffer_manager_->Free(buffer);
+            return;
+        }
         buffer_manager_->Free(buffer);
     }
 
     ppl::common::RetCode AllocTmpBuffer(uint64_t bytes, BufferDesc* buffer) override;
     void FreeTmpBuffer(BufferDesc* buffer) override;
 
+    ppl::common::RetCode SetConcurrentAccess(bool) override;
+
+    InplaceBuffer* GetInplaceBuffer(nodeid_t nid) override;
+    ppl::common::RetCode ReserveInplaceBuffer(uint64_t bytes, InplaceBuffer* buffer) override;
+
+    void InitThreadPool(uint32_t num_threads, const std::vector<int32_t>& cores) {
+        thread_pool_.Init(num_threads, cores);
+    }
+    const OmpThreadPool* GetThreadPool() const override {
+        return &thread_pool_;
+    }
+
     // ----- configurations ----- //
 
     /**
@@ -64,10 +90,19 @@ public:
 
 private:
     uint32_t mm_policy_;
+
+    /** kernels may run in parallel. tmp buffers are allocated separately for each kernel. */
+    bool concurrent_access_;
+    std::mutex mm_lock_;
+
     BufferDesc shared_tmp_buffer_;
     uint64_t tmp_buffer_size_;
     std::unique_ptr<utils::BufferManager> buffer_manager_;
     std::shared_ptr<ppl::common::Allocator> allocator_;
+
+    /** buffers are kept until this device is destroyed and are not managed by `buffer_manager_` */
+    std::map<nodeid_t, InplaceBuffer> inplace_buffers_;
+    OmpThreadPool thread_pool_;
 };
 
 }}} // namespace ppl::nn::x86
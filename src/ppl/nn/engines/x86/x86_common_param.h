@@ -18,12 +18,21 @@
 #ifndef _ST_HPC_PPL_NN_ENGINES_X86_X86_COMMON_PARAM_H_
 #define _ST_HPC_PPL_NN_ENGINES_X86_X86_COMMON_PARAM_H_
 
+#include "ppl/nn/common/types.h"
 #include <stdint.h>
+#include <vector>
 
 namespace ppl { namespace nn { namespace x86 {
 
+/** @brief slot `slot` of the in-place buffer of node `nid`. see `InplaceBuffer`. */
+struct X86InplaceTarget {
+    nodeid_t nid = INVALID_NODEID;
+    uint32_t slot = 0;
+};
+
 struct X86CommonParam {
     std::vector<ppl::common::dataformat_t> output_formats;
+    std::vector<X86InplaceTarget> output_inplace_targets; // empty if no output is written in-place
 };
 
 }}} // namespace ppl::nn::x86
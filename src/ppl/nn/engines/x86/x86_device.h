@@ -20,6 +20,9 @@
 
 #include "ppl/nn/common/device.h"
 #include "ppl/nn/engines/x86/data_converter.h"
+#include "ppl/nn/engines/x86/omp_thread_pool.h"
+#include "ppl/nn/engines/x86/inplace_buffer.h"
+#include "ppl/nn/common/types.h"
 #include "ppl/common/generic_cpu_allocator.h"
 #include <cstring> // memcpy
 
@@ -27,7 +30,13 @@ namespace ppl { namespace nn { namespace x86 {
 
 class X86Device : public Device {
 public:
-    X86Device(uint64_t alignment, ppl::common::isa_t isa) : isa_(isa), data_converter_(isa), allocator_(alignment) {}
+    X86Device(uint64_t alignment, ppl::common::isa_t isa)
+        : isa_(isa), data_converter_(isa), allocator_(alignment), cur_allocator_(&allocator_) {}
+
+    /** @brief replaces the default allocator. nullptr restores it. `allocator` MUST outlive this device. */
+    void SetAllocator(ppl::common::Allocator* allocator) {
+        cur_allocator_ = (allocator ? allocator : &allocator_);
+    }
 
     void SetISA(ppl::common::isa_t isa) {
         isa_ = isa;
@@ -46,12 +55,27 @@ public:
     }
 
     virtual ppl::common::Allocator* GetAllocator() const {
-        return &allocator_;
+        return cur_allocator_;
+    }
+
+    /** @brief threads that kernels running on this device use. nullptr means omp settings of the caller. */
+    virtual const OmpThreadPool* GetThreadPool() const {
+        return nullptr;
+    }
+
+    /** @brief returns the in-place buffer of node `nid`. nullptr means that in-place buffers are not supported. */
+    virtual InplaceBuffer* GetInplaceBuffer(nodeid_t nid) {
+        return nullptr;
+    }
+
+    /** @brief makes sure that `buffer` can hold `bytes` bytes. contents are not preserved. */
+    virtual ppl::common::RetCode ReserveInplaceBuffer(uint64_t bytes, InplaceBuffer* buffer) {
+        return ppl::common::RC_UNSUPPORTED;
     }
 
     ppl::common::RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
         if (buffer->addr) {
-            allocator_.Free(buffer->addr);
+            cur_allocator_->Free(buffer->addr);
         }
 
         if (bytes == 0) {
@@ -59,7 +83,7 @@ public:
             return ppl::common::RC_SUCCESS;
         }
 
-        buffer->addr = allocator_.Alloc(bytes);
+        buffer->addr = cur_allocator_->Alloc(bytes);
         if (!buffer->addr) {
             return ppl::common::RC_OUT_OF_MEMORY;
         }
@@ -70,7 +94,7 @@ public:
 
     void Free(BufferDesc* buffer) override {
         if (buffer->addr) {
-            allocator_.Free(buffer->addr);
+            cur_allocator_->Free(buffer->addr);
             buffer->addr = nullptr;
         }
     }
@@ -119,6 +143,7 @@ private:
     ppl::common::isa_t isa_;
     X86DataConverter data_converter_;
     mutable ppl::common::GenericCpuAllocator allocator_;
+    ppl::common::Allocator* cur_allocator_;
 };
 
 }}} // namespace ppl::nn::x86
@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <algorithm> // std::min
 
 namespace ppl { namespace nn { namespace ir {
 
@@ -31,8 +33,83 @@ struct Shape final {
     std::vector<int64_t> dims;
 };
 
+/**
+   @class ConstantData
+   @brief bytes of a constant. it either owns the data like a `std::string`, or refers to memory kept alive by
+   others, e.g. weights in a memory-mapped external data file of an onnx model.
+   @note writing through the non-const `data()` of a reference modifies the referred memory, which must be writable.
+   `resize()` and assignments turn a reference into an owned copy.
+*/
+class ConstantData final {
+public:
+    ConstantData() {}
+    ConstantData(const std::string& s) : owned_(s) {}
+    ConstantData(std::string&& s) : owned_(std::move(s)) {}
+
+    ConstantData& operator=(const std::string& s) {
+        owned_ = s;
+        ResetReference();
+        return *this;
+    }
+    ConstantData& operator=(std::string&& s) {
+        owned_ = std::move(s);
+        ResetReference();
+        return *this;
+    }
+
+    /** @brief refers to `size` bytes starting from `ptr`, which is valid as long as `holder` is alive. */
+    void Refer(char* ptr, uint64_t size, const std::shared_ptr<void>& holder) {
+        owned_.clear();
+        ref_ = ptr;
+        ref_size_ = size;
+        holder_ = holder;
+    }
+
+    bool IsReference() const {
+        return (ref_ != nullptr);
+    }
+
+    const char* data() const {
+        return (ref_ ? ref_ : owned_.data());
+    }
+    char* data() {
+        return (ref_ ? ref_ : &owned_[0]);
+    }
+
+    uint64_t size() const {
+        return (ref_ ? ref_size_ : owned_.size());
+    }
+    uint64_t length() const {
+        return size();
+    }
+    bool empty() const {
+        return (size() == 0);
+    }
+
+    void resize(uint64_t bytes, char c = 0) {
+        if (ref_) {
+            owned_.assign(ref_, std::min(bytes, ref_size_));
+            ResetReference();
+        }
+        owned_.resize(bytes, c);
+    }
+
+private:
+    void ResetReference() {
+        ref_ = nullptr;
+        ref_size_ = 0;
+        holder_.reset();
+    }
+
+private:
+    std::string owned_;
+    char* ref_ = nullptr;
+    uint64_t ref_size_ = 0;
+    std::shared_ptr<void> holder_;
+};
+
 struct Constant final {
-    std::string data;
+    ConstantData data;
 };
 
 struct GraphData final {
@@ -0,0 +1,265 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/models/onnx/external_data_loader.h"
+#include "ppl/nn/models/onnx/utils.h"
+#include "ppl/nn/common/logger.h"
+#include <stdlib.h> // strtoull
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <string.h> // strerror
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace onnx {
+
+/*
+  pages are mapped privately, so that optimizers modifying constants in place(fusing BatchNormalization into Conv
+  for example) get their own copies of touched pages, while untouched pages stay backed by the file.
+*/
+struct ExternalDataLoader::MappedFile final {
+    ~MappedFile() {
+        if (!base) {
+            return;
+        }
+#ifdef _MSC_VER
+        UnmapViewOfFile(base);
+#else
+        munmap(base, size);
+#endif
+    }
+
+    RetCode Init(const string& path) {
+#ifdef _MSC_VER
+        auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            LOG(ERROR) << "open file[" << path << "] failed.";
+            return RC_NOT_FOUND;
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size)) {
+            LOG(ERROR) << "get size of file[" << path << "] failed.";
+            CloseHandle(file);
+            return RC_OTHER_ERROR;
+        }
+        size = file_size.QuadPart;
+        if (size == 0) {
+            CloseHandle(file);
+            return RC_SUCCESS;
+        }
+
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) {
+            LOG(ERROR) << "create file mapping of [" << path << "] failed.";
+            return RC_OTHER_ERROR;
+        }
+
+        base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!base) {
+            LOG(ERROR) << "map file[" << path << "] failed.";
+            return RC_OTHER_ERROR;
+        }
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            LOG(ERROR) << "open file[" << path << "] failed: " << strerror(errno);
+            return RC_NOT_FOUND;
+        }
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            LOG(ERROR) << "stat file[" << path << "] failed: " << strerror(errno);
+            close(fd);
+            return RC_OTHER_ERROR;
+        }
+        size = file_stat.st_size;
+        if (size == 0) {
+            close(fd);
+            return RC_SUCCESS;
+        }
+
+        auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED) {
+            LOG(ERROR) << "mmap file[" << path << "] failed: " << strerror(errno);
+            return RC_OTHER_ERROR;
+        }
+        base = addr;
+#endif
+        return RC_SUCCESS;
+    }
+
+    void* base = nullptr;
+    uint64_t size = 0;
+};
+
+static thread_local ExternalDataLoader* g_current_loader = nullptr;
+
+ExternalDataLoader* ExternalDataLoader::Current() {
+    return g_current_loader;
+}
+
+ExternalDataLoader::Scope::Scope(ExternalDataLoader* loader) {
+    prev_ = g_current_loader;
+    g_current_loader = loader;
+}
+
+ExternalDataLoader::Scope::~Scope() {
+    g_current_loader = prev_;
+}
+
+/*
+  like the onnx checker, locations must be relative paths which stay in the model directory, so that a model cannot
+  make the loader map arbitrary files such as "/etc/passwd" or "../../secret".
+*/
+static bool IsLocationInModelDir(const string& location) {
+    if (location.empty() || location[0] == '/' || location[0] == '\\') {
+        return false;
+    }
+    if (location.size() >= 2 && location[1] == ':') { // windows drive letters
+        return false;
+    }
+
+    int64_t depth = 0;
+    string::size_type begin = 0;
+    while (begin <= location.size()) {
+        auto end = location.find_first_of("/\\", begin);
+        if (end == string::npos) {
+            end = location.size();
+        }
+
+        auto component = location.substr(begin, end - begin);
+        if (component == "..") {
+            --depth;
+            if (depth < 0) {
+                return false;
+            }
+        } else if (!component.empty() && component != ".") {
+            ++depth;
+        }
+
+        begin = end + 1;
+    }
+
+    return true;
+}
+
+RetCode ExternalDataLoader::GetMappedFile(const string& location, shared_ptr<MappedFile>* file) {
+    auto ref = location2file_.find(location);
+    if (ref != location2file_.end()) {
+        *file = ref->second;
+        return RC_SUCCESS;
+    }
+
+    if (!IsLocationInModelDir(location)) {
+        LOG(ERROR) << "location of external data[" << location
+                   << "] must be a relative path inside the model directory.";
+        return RC_INVALID_VALUE;
+    }
+
+    string path;
+    if (model_dir_.empty()) {
+        path = location;
+    } else {
+        path = model_dir_ + "/" + location;
+    }
+
+    auto mapped = make_shared<MappedFile>();
+    auto status = mapped->Init(path);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "map external data file[" << path << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    location2file_.insert(make_pair(location, mapped));
+    *file = std::move(mapped);
+    return RC_SUCCESS;
+}
+
+RetCode ExternalDataLoader::Load(const ::onnx::TensorProto& pb_tensor, ir::ConstantData* data, ir::Shape* shape) {
+    string location;
+    uint64_t offset = 0;
+    bool has_length = false;
+    uint64_t length = 0;
+    for (int i = 0; i < pb_tensor.external_data_size(); ++i) {
+        auto& entry = pb_tensor.external_data(i);
+        if (entry.key() == "location") {
+            location = entry.value();
+        } else if (entry.key() == "offset") {
+            offset = strtoull(entry.value().c_str(), nullptr, 10);
+        } else if (entry.key() == "length") {
+            length = strtoull(entry.value().c_str(), nullptr, 10);
+            has_length = true;
+        }
+    }
+
+    if (location.empty()) {
+        LOG(ERROR) << "location of external data of tensor[" << pb_tensor.name() << "] is not set.";
+        return RC_INVALID_VALUE;
+    }
+
+    shape->data_type = utils::ConvertOnnxDataTypeToPplDataType(pb_tensor.data_type());
+    shape->data_format = DATAFORMAT_NDARRAY; // default data format
+    uint64_t expected_length = GetSizeOfDataType(shape->data_type);
+    for (int j = 0; j < pb_tensor.dims_size(); ++j) {
+        auto dim = pb_tensor.dims(j);
+        shape->dims.push_back(dim);
+        expected_length *= dim;
+    }
+
+    if (expected_length == 0 || shape->data_type == DATATYPE_UNKNOWN) {
+        LOG(ERROR) << "unsupported data type or no elements of external tensor[" << pb_tensor.name() << "]";
+        return RC_UNSUPPORTED;
+    }
+    if (has_length && length != expected_length) {
+        LOG(ERROR) << "length [" << length << "] of external data of tensor[" << pb_tensor.name()
+                   << "] != size of its shape [" << expected_length << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    shared_ptr<MappedFile> file;
+    auto status = GetMappedFile(location, &file);
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    if (offset > file->size || file->size - offset < expected_length) {
+        LOG(ERROR) << "external data of tensor[" << pb_tensor.name() << "] [offset " << offset << ", length "
+                   << expected_length << "] is out of range of file[" << location << "] of [" << file->size
+                   << "] bytes.";
+        return RC_INVALID_VALUE;
+    }
+
+    // `file` is kept alive by constants referring to it
+    data->Refer(static_cast<char*>(file->base) + offset, expected_length, file);
+    return RC_SUCCESS;
+}
+
+}}} // namespace ppl::nn::onnx
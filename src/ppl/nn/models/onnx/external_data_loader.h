@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_MODELS_ONNX_EXTERNAL_DATA_LOADER_H_
+#define _ST_HPC_PPL_NN_MODELS_ONNX_EXTERNAL_DATA_LOADER_H_
+
+#include "ppl/common/retcode.h"
+#include "ppl/nn/ir/graph.h"
+#include "ppl/nn/models/onnx/generated/onnx.pb.h"
+#include <map>
+
+namespace ppl { namespace nn { namespace onnx {
+
+/**
+   @class ExternalDataLoader
+   @brief loads initializers whose data are stored in external files. each file is memory-mapped once with
+   copy-on-write pages, and constants refer to the mapped pages directly instead of copying them.
+*/
+class ExternalDataLoader final {
+public:
+    /**
+       @param model_dir directory used to resolve locations of external data. locations which are absolute or
+       outside this directory are rejected.
+    */
+    ExternalDataLoader(const std::string& model_dir) : model_dir_(model_dir) {}
+
+    ppl::common::RetCode Load(const ::onnx::TensorProto&, ir::ConstantData*, ir::Shape*);
+
+    /** @brief returns the loader used by the model being parsed in the current thread, or nullptr. */
+    static ExternalDataLoader* Current();
+
+    /** @brief sets `loader` as the current loader of this thread during its lifetime */
+    class Scope final {
+    public:
+        Scope(ExternalDataLoader* loader);
+        ~Scope();
+
+    private:
+        ExternalDataLoader* prev_;
+    };
+
+private:
+    struct MappedFile;
+    ppl::common::RetCode GetMappedFile(const std::string& location, std::shared_ptr<MappedFile>*);
+
+private:
+    const std::string model_dir_;
+    std::map<std::string, std::shared_ptr<MappedFile>> location2file_;
+};
+
+}}} // namespace ppl::nn::onnx
+
+#endif
@@ -18,6 +18,7 @@
 #include "ppl/nn/models/onnx/graph_parser.h"
 #include "ppl/nn/models/onnx/param_parser_manager.h"
 #include "ppl/nn/models/onnx/utils.h"
+#include "ppl/nn/models/onnx/external_data_loader.h"
 #include "ppl/nn/ir/full_graph_topo.h"
 #include "ppl/nn/common/logger.h"
 using namespace std;
@@ -28,11 +29,6 @@ namespace ppl { namespace nn { namespace onnx {
 static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, ir::GraphTopo* topo, ir::GraphData* data) {
     for (int i = 0; i < pb_graph.initializer_size(); ++i) {
         const ::onnx::TensorProto& pb_initializer = pb_graph.initializer(i);
-        if (pb_initializer.external_data_size() > 0) {
-            LOG(ERROR) << "external data is not supported now.";
-            return RC_UNSUPPORTED;
-        }
-
         auto ret_pair = topo->AddEdge(pb_initializer.name());
         if (!ret_pair.second) {
             LOG(ERROR) << "duplicated initializer[" << pb_initializer.name() << "].";
@@ -42,10 +38,26 @@ static RetCode ParseGraphInitializer(const ::onnx::GraphProto& pb_graph, ir::Gra
 
         ir::Shape shape;
         ir::Constant constant;
-        auto status = utils::ParseTensorProto(pb_initializer, &constant.data, &shape);
-        if (status != RC_SUCCESS) {
-            LOG(ERROR) << "ParseTensorProto failed: " << GetRetCodeStr(status);
-            return status;
+        if (pb_initializer.external_data_size() > 0) {
+            auto loader = ExternalDataLoader::Current();
+            if (!loader) {
+                LOG(ERROR) << "external data of initializer[" << pb_initializer.name() << "] is not supported here.";
+                return RC_UNSUPPORTED;
+            }
+            auto status = loader->Load(pb_initializer, &constant.data, &shape);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "load external data of initializer[" << pb_initializer.name()
+                           << "] failed: " << GetRetCodeStr(status);
+                return status;
+            }
+        } else {
+            string content;
+            auto status = utils::ParseTensorProto(pb_initializer, &content, &shape);
+            if (status != RC_SUCCESS) {
+                LOG(ERROR) << "ParseTensorProto failed: " << GetRetCodeStr(status);
+                return status;
+            }
+            constant.data = std::move(content);
         }
 
         data->shapes.insert(make_pair(edge->GetId(), shape));
@@ -17,6 +17,7 @@
 
 #include "ppl/nn/models/onnx/model_parser.h"
 #include "ppl/nn/models/onnx/graph_parser.h"
+#include "ppl/nn/models/onnx/external_data_loader.h"
 #include "ppl/nn/common/logger.h"
 #include "ppl/common/file_mapping.h"
 
@@ -60,7 +61,7 @@ static map<string, uint64_t> ParseOpSets(const ::onnx::ModelProto pb_model) {
     return res;
 }
 
-RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, ir::Graph* graph) {
+RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, const char* model_dir, ir::Graph* graph) {
     ::onnx::ModelProto pb_model;
     if (!ParseFromBinaryBuffer(buf, buf_len, &pb_model)) {
         LOG(ERROR) << "load onnx model from model buffer failed.";
@@ -74,6 +75,10 @@ RetCode ModelParser::Parse(const char* buf, uint64_t buf_len, ir::Graph* graph)
 
     map<string, uint64_t> op_sets = ParseOpSets(pb_model);
 
+    // also used by subgraphs of Loop/If
+    ExternalDataLoader loader(model_dir ? model_dir : "");
+    ExternalDataLoader::Scope __loader_scope__(&loader);
+
     GraphParser graph_parser;
     auto status = graph_parser.Parse(pb_model.graph(), op_sets, graph);
     if (status != RC_SUCCESS) {
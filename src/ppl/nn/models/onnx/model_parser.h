@@ -25,7 +25,12 @@ namespace ppl { namespace nn { namespace onnx {
 
 class ModelParser final {
 public:
-    static ppl::common::RetCode Parse(const char* model_buf, uint64_t buf_len, ir::Graph* graph);
+    /**
+       @param model_dir directory used to resolve locations of external data. nullptr means the current working
+       directory.
+    */
+    static ppl::common::RetCode Parse(const char* model_buf, uint64_t buf_len, const char* model_dir,
+                                      ir::Graph* graph);
 };
 
 }}} // namespace ppl::nn::onnx
@@ -25,17 +25,9 @@ using namespace ppl::common;
 
 namespace ppl { namespace nn {
 
-RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_file, Engine** engines, uint32_t engine_num) {
-    FileMapping fm;
-    if (fm.Init(model_file) != RC_SUCCESS) {
-        LOG(ERROR) << "Init filemapping from file [" << model_file << "] error.";
-        return nullptr;
-    }
-    return OnnxRuntimeBuilderFactory::Create(fm.Data(), fm.Size(), engines, engine_num);
-}
-
-RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_buf, uint64_t buf_len, Engine** engines,
-                                                  uint32_t engine_num) {
+static RuntimeBuilder* CreateRuntimeBuilder(const char* model_buf, uint64_t buf_len, const char* model_dir,
+                                            Engine** engines, uint32_t engine_num,
+                                            const OnnxRuntimeBuilderOptions& options) {
     set<string> engine_names;
     for (uint32_t i = 0; i < engine_num; ++i) {
         auto e = engines[i];
@@ -53,7 +45,7 @@ RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_buf, uint64_
 
     auto builder = new onnx::RuntimeBuilderImpl();
     if (builder) {
-        auto status = builder->Init(model_buf, buf_len, std::move(engine_impls));
+        auto status = builder->Init(model_buf, buf_len, model_dir, std::move(engine_impls), options);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "init RuntimeBuilder failed: " << GetRetCodeStr(status);
             delete builder;
@@ -64,4 +56,38 @@ RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_buf, uint64_
     return builder;
 }
 
+RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_file, Engine** engines, uint32_t engine_num) {
+    return Create(model_file, engines, engine_num, OnnxRuntimeBuilderOptions());
+}
+
+RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_buf, uint64_t buf_len, Engine** engines,
+                                                  uint32_t engine_num) {
+    return Create(model_buf, buf_len, engines, engine_num, OnnxRuntimeBuilderOptions());
+}
+
+RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_file, Engine** engines, uint32_t engine_num,
+                                                  const OnnxRuntimeBuilderOptions& options) {
+    FileMapping fm;
+    if (fm.Init(model_file) != RC_SUCCESS) {
+        LOG(ERROR) << "Init filemapping from file [" << model_file << "] error.";
+        return nullptr;
+    }
+
+    // locations of external data are relative to the directory of the model file
+    string model_dir(model_file);
+    auto pos = model_dir.find_last_of("/\\");
+    if (pos == string::npos) {
+        model_dir = ".";
+    } else {
+        model_dir.resize(pos);
+    }
+
+    return CreateRuntimeBuilder(fm.Data(), fm.Size(), model_dir.c_str(), engines, engine_num, options);
+}
+
+RuntimeBuilder* OnnxRuntimeBuilderFactory::Create(const char* model_buf, uint64_t buf_len, Engine** engines,
+                                                  uint32_t engine_num, const OnnxRuntimeBuilderOptions& options) {
+    return CreateRuntimeBuilder(model_buf, buf_len, nullptr, engines, engine_num, options);
+}
+
 }} // namespace ppl::nn
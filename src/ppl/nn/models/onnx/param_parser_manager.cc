@@ -33,6 +33,7 @@
 #include "ppl/nn/models/onnx/parsers/onnx/parse_gather_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_gather_nd_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_gemm_param.h"
+#include "ppl/nn/models/onnx/parsers/onnx/parse_gru_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_if_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_leaky_relu_param.h"
 #include "ppl/nn/models/onnx/parsers/onnx/parse_loop_param.h"
@@ -166,6 +167,7 @@ ParamParserManager::ParamParserManager() {
     PPL_REGISTER_OP_WITH_PARAM("", "Gemm", 11, 12, ppl::nn::common::GemmParam, ParseGemmParam);
     PPL_REGISTER_OP_WITH_PARAM("", "GlobalAveragePool", 1, 16, ppl::nn::common::PoolingParam, ParsePoolingParam);
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Greater", 9, 12);
+    PPL_REGISTER_OP_WITH_PARAM("", "GRU", 7, 13, ppl::nn::common::GRUParam, ParseGRUParam);
     // I
     PPL_REGISTER_OP_WITHOUT_PARAM("", "Identity", 1, 12);
     PPL_REGISTER_OP_WITH_PARAM("", "If", 11, 12, ppl::nn::common::IfParam, ParseIfParam);
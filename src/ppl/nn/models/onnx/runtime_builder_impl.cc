@@ -20,7 +20,7 @@
 #include "ppl/nn/runtime/runtime_impl.h"
 #include "ppl/nn/models/onnx/model_parser.h"
 #include "ppl/nn/models/onnx/runtime_builder_impl.h"
-#include "ppl/nn/optimizers/engine_graph_partitioner.h"
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
 using namespace std;
 using namespace ppl::common;
 
@@ -38,16 +38,68 @@ RuntimeBuilderImpl::~RuntimeBuilderImpl() {
     resource_.reset();
 }
 
-RetCode RuntimeBuilderImpl::Init(const char* model_buf, size_t buf_len, vector<EngineImpl*>&& engines) {
+RetCode RuntimeBuilderImpl::SetFixedInputDims(const vector<vector<int64_t>>& input_dims) {
+    auto topo = graph_.topo.get();
+    if (input_dims.size() != topo->GetInputCount()) {
+        LOG(ERROR) << "the number of input dims [" << input_dims.size() << "] != input count ["
+                   << topo->GetInputCount() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    auto& shapes = graph_.data->shapes;
+    for (uint32_t i = 0; i < input_dims.size(); ++i) {
+        auto& dims = input_dims[i];
+        if (dims.empty()) {
+            continue;
+        }
+
+        auto eid = topo->GetInput(i);
+        auto edge = topo->GetEdgeById(eid);
+        auto shape_ref = shapes.find(eid);
+        if (shape_ref == shapes.end()) {
+            LOG(ERROR) << "cannot find shape of input[" << edge->GetName() << "]";
+            return RC_NOT_FOUND;
+        }
+
+        auto& shape = shape_ref->second;
+        if (!shape.dims.empty() && shape.dims.size() != dims.size()) {
+            LOG(ERROR) << "dim count [" << dims.size() << "] of input[" << edge->GetName()
+                       << "] != dim count in model [" << shape.dims.size() << "]";
+            return RC_INVALID_VALUE;
+        }
+        for (auto d = dims.begin(); d != dims.end(); ++d) {
+            if (*d <= 0) {
+                LOG(ERROR) << "invalid dim [" << *d << "] of input[" << edge->GetName() << "]";
+                return RC_INVALID_VALUE;
+            }
+        }
+
+        shape.dims = dims;
+        resource_->fixed_input_dims[edge->GetName()] = dims;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode RuntimeBuilderImpl::Init(const char* model_buf, size_t buf_len, const char* model_dir,
+                                 vector<EngineImpl*>&& engines, const OnnxRuntimeBuilderOptions& options) {
     resource_->engines = std::move(engines);
-    resource_->graph_partitioner = make_shared<EngineGraphPartitioner>();
+    resource_->graph_partitioner = make_shared<CostGraphPartitioner>();
 
-    auto status = ModelParser::Parse(model_buf, buf_len, &graph_);
+    auto status = ModelParser::Parse(model_buf, buf_len, model_dir, &graph_);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse graph failed: " << GetRetCodeStr(status);
         return status;
     }
 
+    if (!options.input_dims.empty()) {
+        status = SetFixedInputDims(options.input_dims);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "SetFixedInputDims failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
     status = utils::ProcessGraph(resource_.get(), &graph_, graph_info_.get());
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "process graph failed: " << GetRetCodeStr(status);
@@ -26,6 +26,7 @@
 #include "ppl/nn/runtime/runtime_builder.h"
 #include "ppl/nn/runtime/runtime_graph_info.h"
 #include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/models/onnx/onnx_runtime_builder_factory.h"
 
 namespace ppl { namespace nn { namespace onnx {
 
@@ -33,9 +34,13 @@ class RuntimeBuilderImpl final : public RuntimeBuilder {
 public:
     RuntimeBuilderImpl();
     ~RuntimeBuilderImpl();
-    ppl::common::RetCode Init(const char* model_buf, size_t buf_len, std::vector<EngineImpl*>&&);
+    ppl::common::RetCode Init(const char* model_buf, size_t buf_len, const char* model_dir,
+                              std::vector<EngineImpl*>&&, const OnnxRuntimeBuilderOptions&);
     Runtime* CreateRuntime() override;
 
+private:
+    ppl::common::RetCode SetFixedInputDims(const std::vector<std::vector<int64_t>>&);
+
 private:
     ir::Graph graph_;
     std::shared_ptr<utils::SharedResource> resource_;
@@ -0,0 +1,363 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
+#include "ppl/nn/optimizers/engine_graph_partitioner.h"
+#include "ppl/nn/common/logger.h"
+#include <algorithm>
+#include <set>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+// max rounds of moving single nodes to other engines after the greedy assignment
+static const uint32_t g_max_refine_rounds = 16;
+
+CostGraphPartitioner::CostGraphPartitioner(const shared_ptr<PartitionCostModel>& cost_model)
+    : cost_model_(cost_model) {
+    if (!cost_model_) {
+        cost_model_ = make_shared<DefaultPartitionCostModel>();
+    }
+}
+
+namespace {
+
+class PartitionState final {
+public:
+    PartitionState(const ir::GraphTopo* topo, const PartitionCostModel* cost_model)
+        : topo_(topo), cost_model_(cost_model), node2engine_(topo->GetMaxNodeId(), nullptr) {}
+
+    EngineImpl* GetEngine(nodeid_t nid) const {
+        return node2engine_[nid];
+    }
+    void SetEngine(nodeid_t nid, EngineImpl* engine) {
+        node2engine_[nid] = engine;
+    }
+
+    // one converter is needed for each engine other than the producer's that consumes `edge`
+    double CalcEdgeCost(const ir::Edge* edge) const {
+        auto producer_engine = GetProducerEngine(edge);
+        if (!producer_engine) {
+            return 0;
+        }
+
+        set<EngineImpl*> consumer_engines;
+        for (auto it = edge->CreateConsumerIter(); it.IsValid(); it.Forward()) {
+            auto engine = node2engine_[it.Get()];
+            if (engine && engine != producer_engine) {
+                consumer_engines.insert(engine);
+            }
+        }
+
+        double cost = 0;
+        for (auto engine : consumer_engines) {
+            cost += cost_model_->GetConversionCost(producer_engine, engine, edge);
+        }
+        return cost;
+    }
+
+    // cost of `node` and edges it produces or consumes if it runs on `engine`
+    double CalcLocalCost(const ir::Node* node, EngineImpl* engine) {
+        auto nid = node->GetId();
+        auto saved = node2engine_[nid];
+        node2engine_[nid] = engine;
+
+        double cost = cost_model_->GetNodeCost(engine, node);
+        set<edgeid_t> visited;
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            cost += CalcEdgeCostOnce(node->GetInput(i), &visited);
+        }
+        for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+            cost += CalcEdgeCostOnce(node->GetExtraInput(i), &visited);
+        }
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            cost += CalcEdgeCostOnce(node->GetOutput(i), &visited);
+        }
+
+        node2engine_[nid] = saved;
+        return cost;
+    }
+
+    // cost change of moving `nids` to `engine`. only the moved nodes and the edges they produce or consume change.
+    double CalcMoveCostDelta(const vector<nodeid_t>& nids, EngineImpl* engine) {
+        double delta = 0;
+        set<edgeid_t> edges;
+        for (auto nid : nids) {
+            auto node = topo_->GetNodeById(nid);
+            delta += cost_model_->GetNodeCost(engine, node) - cost_model_->GetNodeCost(node2engine_[nid], node);
+            for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+                edges.insert(node->GetInput(i));
+            }
+            for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+                edges.insert(node->GetExtraInput(i));
+            }
+            for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+                edges.insert(node->GetOutput(i));
+            }
+        }
+
+        vector<EngineImpl*> saved(nids.size());
+        for (uint32_t i = 0; i < nids.size(); ++i) {
+            saved[i] = node2engine_[nids[i]];
+        }
+
+        for (auto eid : edges) {
+            auto edge = topo_->GetEdgeById(eid);
+            if (edge) {
+                delta -= CalcEdgeCost(edge);
+            }
+        }
+        for (auto nid : nids) {
+            node2engine_[nid] = engine;
+        }
+        for (auto eid : edges) {
+            auto edge = topo_->GetEdgeById(eid);
+            if (edge) {
+                delta += CalcEdgeCost(edge);
+            }
+        }
+
+        for (uint32_t i = 0; i < nids.size(); ++i) {
+            node2engine_[nids[i]] = saved[i];
+        }
+        return delta;
+    }
+
+    double CalcTotalCost() const {
+        double node_cost, conversion_cost;
+        uint32_t converted_edge_count;
+        CalcTotalCost(&node_cost, &conversion_cost, &converted_edge_count);
+        return node_cost + conversion_cost;
+    }
+
+    void CalcTotalCost(double* node_cost, double* conversion_cost, uint32_t* converted_edge_count) const {
+        *node_cost = 0;
+        *conversion_cost = 0;
+        *converted_edge_count = 0;
+        for (auto it = topo_->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            *node_cost += cost_model_->GetNodeCost(node2engine_[node->GetId()], node);
+        }
+        for (auto it = topo_->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+            auto cost = CalcEdgeCost(it->Get());
+            if (cost > 0) {
+                *conversion_cost += cost;
+                ++(*converted_edge_count);
+            }
+        }
+    }
+
+private:
+    EngineImpl* GetProducerEngine(const ir::Edge* edge) const {
+        auto producer = edge->GetProducer();
+        return (producer < node2engine_.size()) ? node2engine_[producer] : nullptr;
+    }
+
+    double CalcEdgeCostOnce(edgeid_t eid, set<edgeid_t>* visited) const {
+        auto edge = topo_->GetEdgeById(eid);
+        if (!edge || !visited->insert(eid).second) {
+            return 0;
+        }
+        return CalcEdgeCost(edge);
+    }
+
+private:
+    const ir::GraphTopo* topo_;
+    const PartitionCostModel* cost_model_;
+    vector<EngineImpl*> node2engine_;
+};
+
+} // namespace
+
+/*
+  assigns nodes in topological order to the engine with the least cost of the node and its inputs. `preferred`, if
+  not nullptr, is used whenever it supports the node.
+*/
+static void AssignGreedily(const ir::GraphTopo* topo, const vector<nodeid_t>& sorted_nodes,
+                           const vector<vector<EngineImpl*>>& candidates, EngineImpl* preferred,
+                           PartitionState* state) {
+    for (auto nid : sorted_nodes) {
+        auto node = topo->GetNodeById(nid);
+        auto& node_candidates = candidates[nid];
+        if (preferred && std::find(node_candidates.begin(), node_candidates.end(), preferred) != node_candidates.end()) {
+            state->SetEngine(nid, preferred);
+            continue;
+        }
+
+        EngineImpl* best_engine = nullptr;
+        double best_cost = 0;
+        for (auto engine : node_candidates) {
+            auto cost = state->CalcLocalCost(node, engine);
+            if (!best_engine || cost < best_cost) {
+                best_engine = engine;
+                best_cost = cost;
+            }
+        }
+        state->SetEngine(nid, best_engine);
+    }
+}
+
+static bool MoveNodes(const ir::GraphTopo* topo, const vector<nodeid_t>& sorted_nodes,
+                      const vector<vector<EngineImpl*>>& candidates, PartitionState* state) {
+    bool changed = false;
+    for (auto nid : sorted_nodes) {
+        auto node = topo->GetNodeById(nid);
+        auto cur_engine = state->GetEngine(nid);
+        auto best_cost = state->CalcLocalCost(node, cur_engine);
+        EngineImpl* best_engine = cur_engine;
+        for (auto engine : candidates[nid]) {
+            if (engine == cur_engine) {
+                continue;
+            }
+            auto cost = state->CalcLocalCost(node, engine);
+            if (cost < best_cost - 1e-9) {
+                best_engine = engine;
+                best_cost = cost;
+            }
+        }
+        if (best_engine != cur_engine) {
+            state->SetEngine(nid, best_engine);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// moves each connected group of nodes on the same engine to another engine that supports all of them
+static bool MoveGroups(const ir::GraphTopo* topo, const vector<nodeid_t>& sorted_nodes,
+                       const vector<vector<EngineImpl*>>& candidates, const vector<EngineImpl*>& engines,
+                       PartitionState* state) {
+    map<EngineImpl*, vector<nodeid_t>> engine_nodes;
+    for (auto nid : sorted_nodes) {
+        engine_nodes[state->GetEngine(nid)].push_back(nid);
+    }
+    vector<pair<EngineImpl*, vector<nodeid_t>>> groups;
+    GenEnginePartitions(engine_nodes, topo, &groups);
+    if (groups.size() < 2) {
+        return false;
+    }
+
+    bool changed = false;
+    for (auto& group : groups) {
+        auto cur_engine = state->GetEngine(group.second[0]);
+        for (auto engine : engines) {
+            if (engine == cur_engine) {
+                continue;
+            }
+            bool supported = true;
+            for (auto nid : group.second) {
+                auto& node_candidates = candidates[nid];
+                if (std::find(node_candidates.begin(), node_candidates.end(), engine) == node_candidates.end()) {
+                    supported = false;
+                    break;
+                }
+            }
+            if (!supported) {
+                continue;
+            }
+
+            if (state->CalcMoveCostDelta(group.second, engine) < -1e-9) {
+                for (auto nid : group.second) {
+                    state->SetEngine(nid, engine);
+                }
+                cur_engine = engine;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+RetCode CostGraphPartitioner::Partition(const vector<EngineImpl*>& engines, const ir::GraphTopo* topo,
+                                        vector<pair<EngineImpl*, vector<nodeid_t>>>* partitions) const {
+    vector<vector<EngineImpl*>> candidates(topo->GetMaxNodeId());
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto node = it->Get();
+        auto& node_candidates = candidates[node->GetId()];
+        for (auto engine : engines) {
+            if (engine->Supports(node)) {
+                node_candidates.push_back(engine);
+            }
+        }
+        if (node_candidates.empty()) {
+            const ir::Node::Type& type = node->GetType();
+            LOG(ERROR) << "cannot find implementation of op: domain[" << type.domain << "], type[" << type.name
+                       << "], version[" << type.version << "]";
+            return RC_UNSUPPORTED;
+        }
+    }
+
+    vector<nodeid_t> sorted_nodes;
+    topo->TopologicalSort([&sorted_nodes](nodeid_t nid) -> void {
+        sorted_nodes.push_back(nid);
+    });
+
+    /*
+      local moves cannot merge fragments that need several groups to be moved together, so the search starts from a
+      plain greedy assignment and from one that prefers each engine, and keeps the cheapest result.
+    */
+    PartitionState best_state(topo, cost_model_.get());
+    double best_cost = 0;
+    const uint32_t start_count = (engines.size() > 1) ? engines.size() + 1 : 1;
+    for (uint32_t s = 0; s < start_count; ++s) {
+        PartitionState state(topo, cost_model_.get());
+        AssignGreedily(topo, sorted_nodes, candidates, (s == 0) ? nullptr : engines[s - 1], &state);
+        if (engines.size() > 1) {
+            for (uint32_t round = 0; round < g_max_refine_rounds; ++round) {
+                bool changed = MoveNodes(topo, sorted_nodes, candidates, &state);
+                changed = MoveGroups(topo, sorted_nodes, candidates, engines, &state) || changed;
+                if (!changed) {
+                    break;
+                }
+            }
+        }
+
+        auto cost = state.CalcTotalCost();
+        if (s == 0 || cost < best_cost - 1e-9) {
+            best_state = state;
+            best_cost = cost;
+        }
+    }
+
+    map<EngineImpl*, vector<nodeid_t>> engine_partitions;
+    for (auto nid : sorted_nodes) {
+        auto engine = best_state.GetEngine(nid);
+        auto node = topo->GetNodeById(nid);
+        LOG(DEBUG) << "node[" << node->GetName() << "] type[" << node->GetType().domain << ":"
+                   << node->GetType().name << "] -> engine[" << engine->GetName() << "], cost["
+                   << cost_model_->GetNodeCost(engine, node) << "]";
+        auto ret_pair = engine_partitions.insert(make_pair(engine, vector<nodeid_t>()));
+        ret_pair.first->second.push_back(nid);
+    }
+
+    GenEnginePartitions(engine_partitions, topo, partitions);
+
+    double node_cost, conversion_cost;
+    uint32_t converted_edge_count;
+    best_state.CalcTotalCost(&node_cost, &conversion_cost, &converted_edge_count);
+    LOG(INFO) << "total partition(s) of graph[" << topo->GetName() << "]: " << partitions->size()
+              << ", estimated cost: " << node_cost + conversion_cost << " (nodes " << node_cost << ", conversions "
+              << conversion_cost << " of " << converted_edge_count << " edge(s)).";
+    for (auto it = engine_partitions.begin(); it != engine_partitions.end(); ++it) {
+        LOG(INFO) << "engine[" << it->first->GetName() << "]: " << it->second.size() << " node(s).";
+    }
+
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_OPTIMIZERS_COST_GRAPH_PARTITIONER_H_
+#define _ST_HPC_PPL_NN_OPTIMIZERS_COST_GRAPH_PARTITIONER_H_
+
+#include "ppl/nn/optimizers/graph_partitioner.h"
+#include <memory>
+#include <vector>
+
+namespace ppl { namespace nn {
+
+/**
+   @class PartitionCostModel
+   @brief estimates costs used by `CostGraphPartitioner`. all costs are times in the unit of
+   `EngineImpl::EstimateNodeCost()`, i.e. the time a reference cpu takes to run an elementwise op.
+*/
+class PartitionCostModel {
+public:
+    virtual ~PartitionCostModel() {}
+
+    /** @brief cost of running `node` on `engine`, which supports `node` */
+    virtual double GetNodeCost(const EngineImpl* engine, const ir::Node* node) const = 0;
+
+    /** @brief cost of converting `edge` produced by engine `from` for consumers running on engine `to` */
+    virtual double GetConversionCost(const EngineImpl* from, const EngineImpl* to, const ir::Edge* edge) const = 0;
+};
+
+/**
+   @brief uses `EngineImpl::EstimateNodeCost()` and a fixed cost for each converted edge. a converter reads and
+   writes the edge once, which takes about the time of two elementwise ops.
+*/
+class DefaultPartitionCostModel final : public PartitionCostModel {
+public:
+    DefaultPartitionCostModel(double conversion_cost = 2.0) : conversion_cost_(conversion_cost) {}
+
+    double GetNodeCost(const EngineImpl* engine, const ir::Node* node) const override {
+        return engine->EstimateNodeCost(node);
+    }
+    double GetConversionCost(const EngineImpl*, const EngineImpl*, const ir::Edge*) const override {
+        return conversion_cost_;
+    }
+
+private:
+    const double conversion_cost_;
+};
+
+/**
+   @class CostGraphPartitioner
+   @brief assigns nodes to engines so that the estimated time of nodes and converters at partition boundaries is
+   minimized. engines earlier in the list are preferred when costs are equal. decisions are logged in DEBUG level.
+*/
+class CostGraphPartitioner final : public GraphPartitioner {
+public:
+    /** @param cost_model `DefaultPartitionCostModel` is used if it is nullptr */
+    CostGraphPartitioner(const std::shared_ptr<PartitionCostModel>& cost_model = nullptr);
+
+    ppl::common::RetCode Partition(const std::vector<EngineImpl*>&, const ir::GraphTopo*,
+                                   std::vector<std::pair<EngineImpl*, std::vector<nodeid_t>>>*) const override;
+
+private:
+    std::shared_ptr<PartitionCostModel> cost_model_;
+};
+
+}} // namespace ppl::nn
+
+#endif
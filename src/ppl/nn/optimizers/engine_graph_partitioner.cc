@@ -63,6 +63,18 @@ static void DoPartition(const vector<nodeid_t>& nodes, const ir::GraphTopo* topo
     } while (!nodes_left.empty());
 }
 
+void GenEnginePartitions(const map<EngineImpl*, vector<nodeid_t>>& engine_nodes, const ir::GraphTopo* topo,
+                         vector<pair<EngineImpl*, vector<nodeid_t>>>* partitions) {
+    if (engine_nodes.size() == 1) {
+        auto ref = engine_nodes.begin();
+        partitions->emplace_back(ref->first, ref->second);
+    } else {
+        for (auto it = engine_nodes.begin(); it != engine_nodes.end(); ++it) {
+            DoPartition(it->second, topo, it->first, partitions);
+        }
+    }
+}
+
 static EngineImpl* FindEngine(const vector<EngineImpl*>& engines, const ir::Node* node) {
     for (auto it = engines.begin(); it != engines.end(); ++it) {
         auto engine = *it;
@@ -91,14 +103,7 @@ RetCode EngineGraphPartitioner::Partition(const vector<EngineImpl*>& engines, co
         ret_pair.first->second.push_back(node->GetId());
     }
 
-    if (engine_partitions.size() == 1) {
-        auto ref = engine_partitions.begin();
-        partitions->emplace_back(ref->first, std::move(ref->second));
-    } else {
-        for (auto it = engine_partitions.begin(); it != engine_partitions.end(); ++it) {
-            DoPartition(it->second, topo, it->first, partitions);
-        }
-    }
+    GenEnginePartitions(engine_partitions, topo, partitions);
 
     LOG(INFO) << "total partition(s) of graph[" << topo->GetName() << "]: " << partitions->size() << ".";
 
@@ -19,10 +19,15 @@
 #define _ST_HPC_PPL_NN_OPTIMIZERS_ENGINE_GRAPH_PARTITIONER_H_
 
 #include "ppl/nn/optimizers/graph_partitioner.h"
+#include <map>
 #include <vector>
 
 namespace ppl { namespace nn {
 
+/** @brief splits nodes assigned to each engine into connected partitions */
+void GenEnginePartitions(const std::map<EngineImpl*, std::vector<nodeid_t>>& engine_nodes, const ir::GraphTopo*,
+                         std::vector<std::pair<EngineImpl*, std::vector<nodeid_t>>>*);
+
 class EngineGraphPartitioner final : public GraphPartitioner {
 public:
     ppl::common::RetCode Partition(const std::vector<EngineImpl*>&, const ir::GraphTopo*,
@@ -269,6 +269,13 @@ static RetCode GenPartitionsInfo(const vector<pair<EngineImpl*, vector<nodeid_t>
             return status;
         }
 
+        // engines may fold parts of the subgraph into new constants
+        if (sub_graph.topo != graph->topo) {
+            for (auto c = subgraph_info.constants.begin(); c != subgraph_info.constants.end(); ++c) {
+                graph->topo->MarkAsConstant(c->first);
+            }
+        }
+
         RuntimeGraphInfo::Partition par_info;
         par_info.engine = engine;
         par_info.constants = std::move(subgraph_info.constants);
@@ -31,12 +31,19 @@ RetCode ReshapeConvTranspose(InputOutputInfo* info, const void* arg) {
     int src_h = in_shape0.GetDim(2);
     int src_w = in_shape0.GetDim(3);
 
+    // pads are [h_begin, w_begin, h_end, w_end], and output_padding is only added to the end
+    int pad_h_end = param->pads.size() >= 4 ? param->pads[2] : param->pads[0];
+    int pad_w_end = param->pads.size() >= 4 ? param->pads[3] : param->pads[1];
+    int output_padding_h = param->output_padding.size() >= 2 ? param->output_padding[0] : 0;
+    int output_padding_w = param->output_padding.size() >= 2 ? param->output_padding[1] : 0;
+
     int batch = in_shape0.GetDim(0);
-    int out_h = param->strides[0] * (src_h - 1) + kernel_h_eff - 2 * param->pads[0];
-    int out_w = param->strides[1] * (src_w - 1) + kernel_w_eff - 2 * param->pads[1];
+    int out_h = param->strides[0] * (src_h - 1) + output_padding_h + kernel_h_eff - param->pads[0] - pad_h_end;
+    int out_w = param->strides[1] * (src_w - 1) + output_padding_w + kernel_w_eff - param->pads[1] - pad_w_end;
+    // W is (channels, num_output / group, kernel_h, kernel_w)
+    int64_t num_output = info->GetInput<TensorImpl>(1)->GetShape()->GetDim(1) * param->group;
 
-    info->GetOutput<TensorImpl>(0)->GetShape()->Reshape(
-        {batch, info->GetInput<TensorImpl>(1)->GetShape()->GetDim(1), out_h, out_w});
+    info->GetOutput<TensorImpl>(0)->GetShape()->Reshape({batch, num_output, out_h, out_w});
     return RC_SUCCESS;
 }
 
@@ -19,6 +19,7 @@
 #define _ST_HPC_PPL_NN_QUANTIZATION_QUANT_PARAM_INFO_H_
 
 #include <stdint.h>
+#include <string.h>
 #include <string>
 #include <map>
 
@@ -26,8 +27,37 @@ namespace ppl { namespace nn {
 
 struct QuantParam {
     struct Value {
+        enum {
+            TYPE_UNKNOWN = 0,
+            TYPE_BOOL,
+            TYPE_DOUBLE,
+            TYPE_INT64,
+            TYPE_STRING,
+            TYPE_DOUBLE_ARRAY,
+        };
+
+        /** json type of this value, which decides how `content` is interpreted */
+        uint32_t type = TYPE_UNKNOWN;
         /** `content` is binary data. */
         std::string content;
+
+        /**
+           @brief converts a number, or the first element of a number array, to double.
+           @return false if this value is not a number or the array is empty.
+        */
+        bool GetDouble(double* v) const {
+            if ((type == TYPE_DOUBLE || type == TYPE_DOUBLE_ARRAY) && content.size() >= sizeof(double)) {
+                memcpy(v, content.data(), sizeof(double));
+                return true;
+            }
+            if (type == TYPE_INT64 && content.size() >= sizeof(int64_t)) {
+                int64_t i;
+                memcpy(&i, content.data(), sizeof(int64_t));
+                *v = (double)i;
+                return true;
+            }
+            return false;
+        }
     };
     std::map<std::string, Value> fields;
 };
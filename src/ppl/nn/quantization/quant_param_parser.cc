@@ -37,17 +37,22 @@ static RetCode ParseParam(const rapidjson::Value& v, QuantParam* param) {
         const string key(it->name.GetString(), it->name.GetStringLength());
         QuantParam::Value value;
         if (it->value.IsBool()) {
+            value.type = QuantParam::Value::TYPE_BOOL;
             auto field_value = it->value.GetBool();
             value.content.assign((const char*)&field_value, sizeof(field_value));
         } else if (it->value.IsDouble()) {
+            value.type = QuantParam::Value::TYPE_DOUBLE;
             auto field_value = it->value.GetDouble();
             value.content.assign((const char*)&field_value, sizeof(field_value));
         } else if (it->value.IsInt64()) {
+            value.type = QuantParam::Value::TYPE_INT64;
             auto field_value = it->value.GetInt64();
             value.content.assign((const char*)&field_value, sizeof(field_value));
         } else if (it->value.IsString()) {
+            value.type = QuantParam::Value::TYPE_STRING;
             value.content.assign(it->value.GetString(), it->value.GetStringLength());
         } else if (it->value.IsArray()) {
+            value.type = QuantParam::Value::TYPE_DOUBLE_ARRAY;
             value.content.clear();
             for (auto iter = it->value.GetArray().Begin(); iter != it->value.GetArray().End(); ++iter) {
                 auto field_value = iter->GetDouble();
@@ -0,0 +1,305 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/batch_runner_impl.h"
+#include "ppl/nn/common/logger.h"
+#include <cstring>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+BatchRunnerImpl::~BatchRunnerImpl() {
+    {
+        lock_guard<mutex> lck(lock_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto it = workers_.begin(); it != workers_.end(); ++it) {
+        if ((*it)->thread.joinable()) {
+            (*it)->thread.join();
+        }
+    }
+}
+
+RetCode BatchRunnerImpl::Init(RuntimeBuilder* builder, const BatchRunnerOptions& options) {
+    if (options.max_batch_size == 0) {
+        LOG(ERROR) << "max_batch_size of BatchRunner is 0.";
+        return RC_INVALID_VALUE;
+    }
+    if (options.runtime_num == 0) {
+        LOG(ERROR) << "runtime_num of BatchRunner is 0.";
+        return RC_INVALID_VALUE;
+    }
+
+    options_ = options;
+
+    workers_.reserve(options.runtime_num);
+    for (uint32_t i = 0; i < options.runtime_num; ++i) {
+        auto runtime = builder->CreateRuntime();
+        if (!runtime) {
+            LOG(ERROR) << "create runtime[" << i << "] of BatchRunner failed.";
+            return RC_OTHER_ERROR;
+        }
+
+        auto worker = unique_ptr<Worker>(new Worker());
+        worker->runtime.reset(runtime);
+        worker->input_buffers.resize(runtime->GetInputCount());
+        worker->output_buffers.resize(runtime->GetOutputCount());
+        workers_.emplace_back(std::move(worker));
+    }
+
+    input_count_ = workers_[0]->runtime->GetInputCount();
+    output_count_ = workers_[0]->runtime->GetOutputCount();
+
+    for (auto it = workers_.begin(); it != workers_.end(); ++it) {
+        auto worker = it->get();
+        worker->thread = thread([this, worker]() -> void {
+            WorkerLoop(worker);
+        });
+    }
+
+    return RC_SUCCESS;
+}
+
+static RetCode CheckRequest(const BatchRequest& req, uint32_t input_count) {
+    if (req.inputs.size() != input_count || req.input_shapes.size() != input_count) {
+        LOG(ERROR) << "number of inputs [" << req.inputs.size() << "] and input shapes [" << req.input_shapes.size()
+                   << "] of request != number of inputs of model [" << input_count << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    for (uint32_t i = 0; i < input_count; ++i) {
+        auto& shape = req.input_shapes[i];
+        if (shape.GetDimCount() == 0 || shape.GetDim(0) <= 0) {
+            LOG(ERROR) << "dim 0 of input[" << i << "] is not the number of samples.";
+            return RC_INVALID_VALUE;
+        }
+        if (shape.GetDim(0) != req.input_shapes[0].GetDim(0)) {
+            LOG(ERROR) << "dim 0 of input[" << i << "] [" << shape.GetDim(0) << "] != dim 0 of input[0] ["
+                       << req.input_shapes[0].GetDim(0) << "]";
+            return RC_INVALID_VALUE;
+        }
+        if (!req.inputs[i]) {
+            LOG(ERROR) << "data of input[" << i << "] is empty.";
+            return RC_INVALID_VALUE;
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+future<BatchResult> BatchRunnerImpl::Submit(const BatchRequest& req) {
+    PendingRequest pending;
+    auto fut = pending.promise.get_future();
+
+    auto status = CheckRequest(req, input_count_);
+    if (status != RC_SUCCESS) {
+        BatchResult result;
+        result.status = status;
+        pending.promise.set_value(std::move(result));
+        return fut;
+    }
+
+    pending.request = req;
+    pending.sample_num = req.input_shapes[0].GetDim(0);
+    pending.arrival = chrono::steady_clock::now();
+
+    {
+        lock_guard<mutex> lck(lock_);
+        queued_sample_num_ += pending.sample_num;
+        queue_.emplace_back(std::move(pending));
+    }
+    cond_.notify_all();
+
+    return fut;
+}
+
+// requests can be concatenated if all inputs have the same data types and dims except dim 0
+static bool CanBeBatched(const BatchRequest& a, const BatchRequest& b) {
+    for (uint32_t i = 0; i < a.input_shapes.size(); ++i) {
+        auto& sa = a.input_shapes[i];
+        auto& sb = b.input_shapes[i];
+        if (sa.GetDataType() != sb.GetDataType() || sa.GetDimCount() != sb.GetDimCount()) {
+            return false;
+        }
+        for (uint32_t j = 1; j < sa.GetDimCount(); ++j) {
+            if (sa.GetDim(j) != sb.GetDim(j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+  waits until `max_batch_size` samples are queued or the earliest request has waited for `timeout_us`, then takes
+  the earliest request and following requests that can be batched with it. returns false if the runner is stopped
+  and no requests are left.
+*/
+bool BatchRunnerImpl::PopBatch(vector<PendingRequest>* batch) {
+    const int64_t max_batch_size = options_.max_batch_size;
+
+    unique_lock<mutex> lck(lock_);
+    while (true) {
+        cond_.wait(lck, [this]() -> bool {
+            return stop_ || !queue_.empty();
+        });
+        if (queue_.empty()) {
+            return false;
+        }
+
+        auto deadline = queue_.front().arrival + chrono::microseconds(options_.timeout_us);
+        cond_.wait_until(lck, deadline, [this, max_batch_size]() -> bool {
+            return stop_ || queued_sample_num_ >= max_batch_size;
+        });
+
+        // requests may be taken by other workers
+        if (!queue_.empty()) {
+            break;
+        }
+    }
+
+    batch->emplace_back(std::move(queue_.front()));
+    queue_.pop_front();
+
+    int64_t sample_num = batch->front().sample_num;
+    auto& first = batch->front().request;
+    for (auto it = queue_.begin(); it != queue_.end() && sample_num < max_batch_size;) {
+        if (sample_num + it->sample_num <= max_batch_size && CanBeBatched(first, it->request)) {
+            sample_num += it->sample_num;
+            batch->emplace_back(std::move(*it));
+            it = queue_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    queued_sample_num_ -= sample_num;
+    return true;
+}
+
+void BatchRunnerImpl::RunBatch(Worker* worker, vector<PendingRequest>* batch) {
+    auto runtime = worker->runtime.get();
+
+    int64_t batch_size = 0;
+    for (auto it = batch->begin(); it != batch->end(); ++it) {
+        batch_size += it->sample_num;
+    }
+
+    vector<BatchResult> results(batch->size());
+
+    RetCode status = RC_SUCCESS;
+    for (uint32_t i = 0; i < input_count_ && status == RC_SUCCESS; ++i) {
+        auto& first_shape = batch->front().request.input_shapes[i];
+        TensorShape host_shape(first_shape);
+        host_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+        host_shape.SetDim(0, batch_size);
+
+        // a single request is converted from its own data directly
+        const void* src = batch->front().request.inputs[i];
+        if (batch->size() > 1) {
+            auto& buffer = worker->input_buffers[i];
+            buffer.resize(host_shape.GetBytesExcludingPadding());
+
+            char* cursor = buffer.data();
+            for (auto it = batch->begin(); it != batch->end(); ++it) {
+                const uint64_t bytes = it->request.input_shapes[i].GetBytesExcludingPadding();
+                memcpy(cursor, it->request.inputs[i], bytes);
+                cursor += bytes;
+            }
+            src = buffer.data();
+        }
+
+        auto tensor = runtime->GetInputTensor(i);
+        tensor->GetShape()->Reshape(host_shape.GetDims(), host_shape.GetDimCount());
+        status = tensor->ReallocBuffer();
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "ReallocBuffer for tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            break;
+        }
+
+        status = tensor->ConvertFromHost(src, host_shape);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "set data of tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+        }
+    }
+
+    if (status == RC_SUCCESS) {
+        status = runtime->Run();
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "run batch of [" << batch_size << "] samples failed: " << GetRetCodeStr(status);
+        }
+    }
+
+    for (auto it = results.begin(); it != results.end(); ++it) {
+        it->output_shapes.resize(output_count_);
+        it->outputs.resize(output_count_);
+    }
+
+    for (uint32_t i = 0; i < output_count_ && status == RC_SUCCESS; ++i) {
+        auto tensor = runtime->GetOutputTensor(i);
+
+        TensorShape host_shape(*tensor->GetShape());
+        host_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+
+        const uint64_t bytes = host_shape.GetBytesExcludingPadding();
+        auto& buffer = worker->output_buffers[i];
+        buffer.resize(bytes);
+        status = tensor->ConvertToHost(buffer.data(), host_shape);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "get data of tensor[" << tensor->GetName() << "] failed: " << GetRetCodeStr(status);
+            break;
+        }
+
+        // outputs without the batch dimension are copied to every request
+        const bool is_batched = (host_shape.GetDimCount() > 0 && host_shape.GetDim(0) == batch_size);
+        const uint64_t bytes_per_sample = is_batched ? bytes / batch_size : 0;
+
+        const char* cursor = buffer.data();
+        for (uint32_t j = 0; j < batch->size(); ++j) {
+            auto& result = results[j];
+            result.output_shapes[i] = host_shape;
+            if (is_batched) {
+                const int64_t sample_num = batch->at(j).sample_num;
+                result.output_shapes[i].SetDim(0, sample_num);
+                result.outputs[i].assign(cursor, cursor + bytes_per_sample * sample_num);
+                cursor += bytes_per_sample * sample_num;
+            } else {
+                result.outputs[i].assign(buffer.begin(), buffer.end());
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < batch->size(); ++i) {
+        results[i].status = status;
+        batch->at(i).promise.set_value(std::move(results[i]));
+    }
+}
+
+void BatchRunnerImpl::WorkerLoop(Worker* worker) {
+    vector<PendingRequest> batch;
+    batch.reserve(options_.max_batch_size);
+
+    while (PopBatch(&batch)) {
+        RunBatch(worker, &batch);
+        batch.clear();
+    }
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_BATCH_RUNNER_IMPL_H_
+#define _ST_HPC_PPL_NN_RUNTIME_BATCH_RUNNER_IMPL_H_
+
+#include "ppl/nn/runtime/batch_runner.h"
+#include "ppl/nn/runtime/runtime_builder.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ppl { namespace nn {
+
+class BatchRunnerImpl final : public BatchRunner {
+public:
+    BatchRunnerImpl() {}
+    ~BatchRunnerImpl();
+
+    ppl::common::RetCode Init(RuntimeBuilder*, const BatchRunnerOptions&);
+
+    uint32_t GetInputCount() const override {
+        return input_count_;
+    }
+    uint32_t GetOutputCount() const override {
+        return output_count_;
+    }
+    std::future<BatchResult> Submit(const BatchRequest&) override;
+
+private:
+    struct PendingRequest final {
+        BatchRequest request;
+        int64_t sample_num;
+        std::chrono::steady_clock::time_point arrival;
+        std::promise<BatchResult> promise;
+    };
+
+    struct Worker final {
+        std::unique_ptr<Runtime> runtime;
+        std::thread thread;
+        // host buffers of concatenated inputs and outputs, reused across batches
+        std::vector<std::vector<char>> input_buffers;
+        std::vector<std::vector<char>> output_buffers;
+    };
+
+private:
+    bool PopBatch(std::vector<PendingRequest>*);
+    void RunBatch(Worker*, std::vector<PendingRequest>*);
+    void WorkerLoop(Worker*);
+
+private:
+    uint32_t input_count_ = 0;
+    uint32_t output_count_ = 0;
+    BatchRunnerOptions options_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex lock_;
+    std::condition_variable cond_;
+    bool stop_ = false;
+    int64_t queued_sample_num_ = 0;
+    std::deque<PendingRequest> queue_;
+
+private:
+    BatchRunnerImpl(const BatchRunnerImpl&) = delete;
+    BatchRunnerImpl& operator=(const BatchRunnerImpl&) = delete;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -0,0 +1,351 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/common/logger.h"
+#include "ppl/nn/runtime/parallel_scheduler.h"
+#include "ppl/nn/runtime/scheduler_common.h"
+#include <set>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+class ParallelScheduler::WorkerAcquireObject final : public InputOutputInfo::AcquireObject {
+public:
+    WorkerAcquireObject(ParallelScheduler* sched) : device_(nullptr), sched_(sched) {}
+
+    void SetDevice(Device* d) {
+        device_ = d;
+    }
+
+    EdgeObject* Acquire(edgeid_t eid, uint32_t etype) override {
+        return sched_->AcquireObject(eid, etype, device_);
+    }
+
+private:
+    Device* device_;
+    ParallelScheduler* sched_;
+};
+
+ParallelScheduler::ParallelScheduler(uint32_t thread_num) : thread_num_(thread_num) {
+    if (thread_num_ == 0) {
+        thread_num_ = std::thread::hardware_concurrency();
+        if (thread_num_ == 0) {
+            thread_num_ = 1;
+        }
+    }
+}
+
+ParallelScheduler::~ParallelScheduler() {
+    {
+        lock_guard<mutex> __guard__(lock_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+
+    for (auto t = workers_.begin(); t != workers_.end(); ++t) {
+        t->join();
+    }
+
+    for (auto d = concurrent_devices_.begin(); d != concurrent_devices_.end(); ++d) {
+        (*d)->SetConcurrentAccess(false);
+    }
+}
+
+RetCode ParallelScheduler::Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info, RuntimeGraph* g) {
+    graph_ = g;
+    topo_ = topo;
+    aux_info_ = aux_info;
+    edgeid2object_ = utils::InitObjectInUse(topo->GetMaxEdgeId(), g);
+
+    nodeid2successors_.clear();
+    nodeid2successors_.resize(topo->GetMaxNodeId());
+    nodeid2indegree_.assign(topo->GetMaxNodeId(), 0);
+    edgeid2refcount_.assign(topo->GetMaxEdgeId(), 0);
+
+    const nodeid_t reserved_edge_consumer = topo->GetMaxNodeId();
+    auto add_edge_ref = [this, aux_info, reserved_edge_consumer](edgeid_t eid) -> void {
+        // inputs/extra_inputs/outputs/constants are never released in Run()
+        if (eid < edgeid2refcount_.size() && aux_info->tensor_last_consumer[eid] != reserved_edge_consumer) {
+            ++edgeid2refcount_[eid];
+        }
+    };
+
+    set<Device*> devices;
+    for (auto x = aux_info->sorted_nodes.begin(); x != aux_info->sorted_nodes.end(); ++x) {
+        auto nid = *x;
+        auto node = topo->GetNodeById(nid);
+
+        nodeid2indegree_[nid] = topo->FindPredecessors(nid).size();
+        nodeid2successors_[nid] = topo->FindSuccessors(nid);
+
+        for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+            add_edge_ref(node->GetInput(i));
+        }
+        for (uint32_t i = 0; i < node->GetExtraInputCount(); ++i) {
+            add_edge_ref(node->GetExtraInput(i));
+        }
+        for (uint32_t i = 0; i < node->GetOutputCount(); ++i) {
+            add_edge_ref(node->GetOutput(i));
+        }
+
+        auto kernel = g->nodeid2kernel[nid].get();
+        if (!kernel) {
+            LOG(ERROR) << "cannot find kernel of node[" << node->GetName() << "]";
+            return RC_NOT_FOUND;
+        }
+        devices.insert(kernel->GetDevice());
+    }
+
+    for (auto d = devices.begin(); d != devices.end(); ++d) {
+        auto dev = *d;
+        if (dev->SetConcurrentAccess(true) == RC_SUCCESS) {
+            concurrent_devices_.push_back(dev);
+        } else {
+            LOG(DEBUG) << "kernels using device[" << dev->GetType() << "] will be executed one by one.";
+            device2lock_.insert(make_pair(dev, unique_ptr<mutex>(new mutex())));
+        }
+    }
+
+    if (workers_.empty()) {
+        workers_.reserve(thread_num_ - 1);
+        for (uint32_t i = 1; i < thread_num_; ++i) {
+            workers_.emplace_back(&ParallelScheduler::WorkerFunc, this);
+        }
+    }
+
+    return RC_SUCCESS;
+}
+
+mutex* ParallelScheduler::GetDeviceLock(Device* dev) {
+    auto ref = device2lock_.find(dev);
+    if (ref == device2lock_.end()) {
+        return nullptr;
+    }
+    return ref->second.get();
+}
+
+EdgeObject* ParallelScheduler::AcquireObject(edgeid_t eid, uint32_t etype, Device* device) {
+    if (eid >= edgeid2object_.size()) {
+        return nullptr;
+    }
+
+    lock_guard<mutex> __guard__(lock_);
+
+    auto object = edgeid2object_[eid];
+    if (!object) {
+        auto edge = topo_->GetEdgeById(eid);
+
+        if (etype == EdgeObject::T_TENSOR) {
+            auto tensor = tensor_pool_.Alloc(edge, TENSORTYPE_NORMAL);
+            tensor->SetDevice(device);
+            object = tensor;
+        } else if (etype == EdgeObject::T_TENSOR_SEQUENCE) {
+            object = tensor_sequence_pool_.Alloc(edge);
+        } else if (etype == EdgeObject::T_EDGE_OBJECT) {
+            return nullptr;
+        } else {
+            LOG(ERROR) << "invalid object type[" << etype << "] of edge[" << edge->GetName() << "]";
+            return nullptr;
+        }
+
+        if (!object) {
+            LOG(ERROR) << "create output object[" << edge->GetName() << "] failed, oom";
+            return nullptr;
+        }
+        edgeid2object_[eid] = object;
+    }
+
+    return object;
+}
+
+template <typename T>
+static void FreeBufferWithLock(T* buffer_info, mutex* dev_lock) {
+    if (dev_lock) {
+        lock_guard<mutex> __guard__(*dev_lock);
+        buffer_info->FreeBuffer();
+    } else {
+        buffer_info->FreeBuffer();
+    }
+}
+
+RetCode ParallelScheduler::ReleaseObject(EdgeObject* object, nodeid_t) {
+    auto eid = object->GetEdge()->GetId();
+
+    {
+        lock_guard<mutex> __guard__(lock_);
+        uint32_t& refcount = pending_refcount_[eid];
+        if (refcount == 0) { // reserved objects
+            return RC_SUCCESS;
+        }
+
+        --refcount;
+        if (refcount > 0) {
+            return RC_SUCCESS;
+        }
+
+        edgeid2object_[eid] = nullptr;
+    }
+
+    // buffers are freed outside `lock_` because their devices may be locked by other threads
+    if (object->GetObjectType() == EdgeObject::T_TENSOR) {
+        auto tensor = static_cast<TensorImpl*>(object);
+        FreeBufferWithLock(tensor, GetDeviceLock(tensor->GetDevice()));
+
+        lock_guard<mutex> __guard__(lock_);
+        tensor_pool_.Free(tensor);
+    } else if (object->GetObjectType() == EdgeObject::T_TENSOR_SEQUENCE) {
+        auto seq = static_cast<TensorSequence*>(object);
+        for (uint32_t i = 0; i < seq->GetElementCount(); ++i) {
+            auto element = seq->GetElement(i);
+            FreeBufferWithLock(element, GetDeviceLock(element->GetDevice()));
+        }
+
+        lock_guard<mutex> __guard__(lock_);
+        tensor_sequence_pool_.Free(seq);
+    } else {
+        LOG(ERROR) << "invalid edge object type[" << object->GetObjectType() << "]";
+        return RC_INVALID_VALUE;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode ParallelScheduler::ExecuteNode(nodeid_t nid, WorkerAcquireObject* getter) {
+    auto kernel = graph_->nodeid2kernel[nid].get();
+    auto device = kernel->GetDevice();
+
+    KernelExecContext ctx;
+    ctx.SetProfilingFlag(profiler_->IsProfilingEnabled());
+    ctx.SetAcquireObject(getter);
+    ctx.SetNode(kernel->GetNode());
+    getter->SetDevice(device);
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    Profiler::KernelTraceGuard __trace_guard__(profiler_, kernel);
+#endif
+
+    RetCode exec_status;
+    auto dev_lock = GetDeviceLock(device);
+    if (dev_lock) {
+        lock_guard<mutex> __guard__(*dev_lock);
+        exec_status = kernel->Execute(&ctx);
+    } else {
+        exec_status = kernel->Execute(&ctx);
+    }
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    __trace_guard__.EndKernel();
+    profiler_->CollectStatistics(kernel);
+#endif
+
+    auto release_func = [this](EdgeObject* object, nodeid_t user) -> RetCode {
+        return ReleaseObject(object, user);
+    };
+    auto status = utils::AfterExecuteKernel(kernel, &ctx, release_func);
+
+    if (exec_status != RC_SUCCESS) {
+        auto& type = kernel->GetNode()->GetType();
+        LOG(ERROR) << "exec kernel[" << kernel->GetName() << "] of type[" << type.domain << ":" << type.name << ":"
+                   << type.version << "] failed: " << GetRetCodeStr(exec_status);
+        return exec_status;
+    }
+
+    return status;
+}
+
+void ParallelScheduler::ProcessReadyNodes(WorkerAcquireObject* getter, bool is_caller) {
+    unique_lock<mutex> lck(lock_);
+
+    while (true) {
+        cond_.wait(lck, [this, is_caller]() -> bool {
+            if (status_ == RC_SUCCESS && !ready_nodes_.empty()) {
+                return true;
+            }
+            if (is_caller) {
+                return (remaining_count_ == 0 || (status_ != RC_SUCCESS && running_count_ == 0));
+            }
+            return stop_;
+        });
+
+        if (status_ != RC_SUCCESS || ready_nodes_.empty()) {
+            // caller: all nodes are finished or some of them failed. worker: stopped.
+            return;
+        }
+
+        auto nid = ready_nodes_.back();
+        ready_nodes_.pop_back();
+        ++running_count_;
+        lck.unlock();
+
+        auto status = ExecuteNode(nid, getter);
+
+        lck.lock();
+        --running_count_;
+        --remaining_count_;
+        if (status != RC_SUCCESS) {
+            if (status_ == RC_SUCCESS) {
+                status_ = status;
+            }
+        } else {
+            auto& successors = nodeid2successors_[nid];
+            for (auto x = successors.begin(); x != successors.end(); ++x) {
+                uint32_t& indegree = pending_indegree_[*x];
+                --indegree;
+                if (indegree == 0) {
+                    ready_nodes_.push_back(*x);
+                }
+            }
+        }
+        cond_.notify_all();
+    }
+}
+
+void ParallelScheduler::WorkerFunc() {
+    WorkerAcquireObject getter(this);
+    ProcessReadyNodes(&getter, false);
+}
+
+RetCode ParallelScheduler::Run(Profiler* profiler) {
+    {
+        lock_guard<mutex> __guard__(lock_);
+        profiler_ = profiler;
+        status_ = RC_SUCCESS;
+        running_count_ = 0;
+        remaining_count_ = aux_info_->sorted_nodes.size();
+        pending_indegree_ = nodeid2indegree_;
+        pending_refcount_ = edgeid2refcount_;
+
+        // `ready_nodes_` is used as a stack. keeps roots in topological order.
+        ready_nodes_.clear();
+        for (auto x = aux_info_->sorted_nodes.rbegin(); x != aux_info_->sorted_nodes.rend(); ++x) {
+            if (nodeid2indegree_[*x] == 0) {
+                ready_nodes_.push_back(*x);
+            }
+        }
+    }
+    cond_.notify_all();
+
+    // the caller thread also executes kernels
+    WorkerAcquireObject getter(this);
+    ProcessReadyNodes(&getter, true);
+
+    lock_guard<mutex> __guard__(lock_);
+    return status_;
+}
+
+}} // namespace ppl::nn
@@ -0,0 +1,104 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_PARALLEL_SCHEDULER_H_
+#define _ST_HPC_PPL_NN_RUNTIME_PARALLEL_SCHEDULER_H_
+
+#include "ppl/nn/runtime/scheduler.h"
+#include "ppl/common/object_pool.h"
+#include "ppl/nn/runtime/tensor_sequence.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <map>
+
+namespace ppl { namespace nn {
+
+/**
+   @class ParallelScheduler
+   @brief runs kernels whose predecessors have finished in multiple threads.
+   @note kernels of devices which do not support `SetConcurrentAccess()` are executed one at a time.
+*/
+class ParallelScheduler final : public Scheduler {
+public:
+    /** @param thread_num number of threads including the caller of `Run()`. 0 means hardware concurrency. */
+    ParallelScheduler(uint32_t thread_num);
+    ~ParallelScheduler();
+
+    ppl::common::RetCode Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info, RuntimeGraph* g) override;
+    ppl::common::RetCode Run(Profiler*) override;
+
+private:
+    class WorkerAcquireObject;
+
+    void WorkerFunc();
+    void ProcessReadyNodes(WorkerAcquireObject*, bool is_caller);
+    ppl::common::RetCode ExecuteNode(nodeid_t, WorkerAcquireObject*);
+    ppl::common::RetCode ReleaseObject(EdgeObject*, nodeid_t);
+    EdgeObject* AcquireObject(edgeid_t, uint32_t etype, Device*);
+    std::mutex* GetDeviceLock(Device*);
+
+private:
+    uint32_t thread_num_;
+    std::vector<std::thread> workers_;
+
+    const ir::GraphTopo* topo_ = nullptr;
+    const RuntimeAuxInfo* aux_info_ = nullptr;
+    RuntimeGraph* graph_ = nullptr;
+
+    /** nodes which consume outputs of a node */
+    std::vector<std::vector<nodeid_t>> nodeid2successors_;
+
+    /** number of predecessors of a node */
+    std::vector<uint32_t> nodeid2indegree_;
+
+    /** number of references(consumers' inputs + producer's output) of each edge released in Run() */
+    std::vector<uint32_t> edgeid2refcount_;
+
+    /** devices enabled by `Device::SetConcurrentAccess()` */
+    std::vector<Device*> concurrent_devices_;
+
+    /** kernels using these devices are serialized */
+    std::map<Device*, std::unique_ptr<std::mutex>> device2lock_;
+
+    // ----- states used during Run(), protected by `lock_` ----- //
+
+    std::mutex lock_;
+    std::condition_variable cond_;
+    bool stop_ = false;
+    Profiler* profiler_ = nullptr;
+    ppl::common::RetCode status_ = ppl::common::RC_SUCCESS;
+    uint32_t running_count_ = 0;
+    uint32_t remaining_count_ = 0;
+    std::vector<nodeid_t> ready_nodes_;
+    std::vector<uint32_t> pending_indegree_;
+    std::vector<uint32_t> pending_refcount_;
+
+    /** used to hold objects that are used during Run() */
+    std::vector<EdgeObject*> edgeid2object_;
+
+    /** used to accelerlate tensor allocations */
+    ppl::common::ObjectPool<TensorImpl> tensor_pool_;
+
+    /** used to accelerlate tensor sequence allocations */
+    ppl::common::ObjectPool<TensorSequence> tensor_sequence_pool_;
+};
+
+}} // namespace ppl::nn
+
+#endif
@@ -17,6 +17,12 @@
 
 #include "ppl/nn/runtime/profiler.h"
 #include "ppl/nn/common/logger.h"
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+#include <atomic>
+#include <fstream>
+#endif
+
 using namespace std;
 using namespace ppl::common;
 
@@ -69,6 +75,159 @@ RetCode Profiler::GetProfilingStatistics(ProfilingStatistics* stat) const {
 void Profiler::StopProfiling() {
     nodeid2info_.clear();
 }
+
+/* -------------------------------------------------------------------------- */
+
+// small sequential ids are easier to read than native thread ids in trace viewers
+static uint32_t GetTraceThreadId() {
+    static atomic<uint32_t> g_thread_id_seq(0);
+    static thread_local uint32_t tid = g_thread_id_seq.fetch_add(1);
+    return tid;
+}
+
+void Profiler::StartTracing() {
+    lock_guard<mutex> __guard__(trace_lock_);
+    run_count_ = 0;
+    trace_events_.clear();
+    trace_begin_ = chrono::steady_clock::now();
+}
+
+void Profiler::StopTracing() {
+    lock_guard<mutex> __guard__(trace_lock_);
+    trace_events_.clear();
+    trace_events_.shrink_to_fit();
+}
+
+void Profiler::AddTraceEvent(const TraceEvent& event) {
+    lock_guard<mutex> __guard__(trace_lock_);
+    trace_events_.push_back(event);
+    trace_events_.back().run_idx = run_count_;
+    trace_events_.back().tid = GetTraceThreadId();
+}
+
+void Profiler::TraceRun(const TimePoint& begin) {
+    if (conf_->tracing_flag) {
+        TraceEvent event;
+        event.type = TraceEvent::RUN;
+        event.begin = begin;
+        event.end = chrono::steady_clock::now();
+        AddTraceEvent(event);
+
+        lock_guard<mutex> __guard__(trace_lock_);
+        ++run_count_;
+    }
+}
+
+void Profiler::OnRealloc(uint64_t bytes, const TimePoint& begin, const TimePoint& end) {
+    TraceEvent event;
+    event.type = TraceEvent::REALLOC;
+    event.bytes = bytes;
+    event.begin = begin;
+    event.end = end;
+    AddTraceEvent(event);
+}
+
+void Profiler::OnFree(const TimePoint& begin, const TimePoint& end) {
+    TraceEvent event;
+    event.type = TraceEvent::FREE;
+    event.begin = begin;
+    event.end = end;
+    AddTraceEvent(event);
+}
+
+Profiler::KernelTraceGuard::KernelTraceGuard(Profiler* profiler, const KernelImpl* kernel)
+    : profiler_(profiler->conf_->tracing_flag ? profiler : nullptr), kernel_(kernel), prev_listener_(nullptr) {
+    if (profiler_) {
+        prev_listener_ = SetThreadBufferEventListener(profiler_);
+        begin_ = chrono::steady_clock::now();
+    }
+}
+
+Profiler::KernelTraceGuard::~KernelTraceGuard() {
+    if (profiler_) {
+        SetThreadBufferEventListener(prev_listener_);
+    }
+}
+
+void Profiler::KernelTraceGuard::EndKernel() {
+    if (profiler_) {
+        TraceEvent event;
+        event.type = TraceEvent::KERNEL;
+        event.nid = kernel_->GetNode()->GetId();
+        event.begin = begin_;
+        event.end = chrono::steady_clock::now();
+        profiler_->AddTraceEvent(event);
+    }
+}
+
+static void WriteJsonString(const string& s, ofstream* ofs) {
+    *ofs << '"';
+    for (auto c = s.begin(); c != s.end(); ++c) {
+        if (*c == '"' || *c == '\\') {
+            *ofs << '\\' << *c;
+        } else if ((unsigned char)(*c) < 0x20) {
+            *ofs << ' ';
+        } else {
+            *ofs << *c;
+        }
+    }
+    *ofs << '"';
+}
+
+RetCode Profiler::SaveTrace(const char* filename) const {
+    if (!conf_->tracing_flag) {
+        LOG(ERROR) << "RUNTIME_CONF_SET_TRACING_FLAG is not enabled.";
+        return RC_INVALID_VALUE;
+    }
+
+    ofstream ofs(filename, ios_base::out | ios_base::trunc);
+    if (!ofs.is_open()) {
+        LOG(ERROR) << "open file[" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    lock_guard<mutex> __guard__(trace_lock_);
+
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    ofs.precision(3);
+    ofs.setf(ios_base::fixed, ios_base::floatfield);
+
+    for (uint32_t i = 0; i < trace_events_.size(); ++i) {
+        auto& event = trace_events_[i];
+        // timestamps are in microseconds
+        double ts = chrono::duration<double, micro>(event.begin - trace_begin_).count();
+        double dur = chrono::duration<double, micro>(event.end - event.begin).count();
+
+        ofs << (i == 0 ? "\n" : ",\n") << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << event.tid << ",\"ts\":" << ts
+            << ",\"dur\":" << dur << ",";
+        if (event.type == TraceEvent::RUN) {
+            ofs << "\"name\":\"Run\",\"cat\":\"runtime\",\"args\":{\"run\":" << event.run_idx << "}}";
+        } else if (event.type == TraceEvent::KERNEL) {
+            auto kernel = graph_->nodeid2kernel[event.nid].get();
+            auto& type = kernel->GetType();
+            ofs << "\"name\":";
+            WriteJsonString(kernel->GetName(), &ofs);
+            ofs << ",\"cat\":\"kernel\",\"args\":{\"run\":" << event.run_idx << ",\"type\":";
+            WriteJsonString(type.domain.empty() ? type.name : type.domain + ":" + type.name, &ofs);
+            ofs << "}}";
+        } else if (event.type == TraceEvent::REALLOC) {
+            ofs << "\"name\":\"Realloc\",\"cat\":\"memory\",\"args\":{\"run\":" << event.run_idx
+                << ",\"bytes\":" << event.bytes << "}}";
+        } else {
+            ofs << "\"name\":\"Free\",\"cat\":\"memory\",\"args\":{\"run\":" << event.run_idx << "}}";
+        }
+    }
+
+    ofs << "\n]}\n";
+    if (!ofs.good()) {
+        LOG(ERROR) << "write trace to file[" << filename << "] failed.";
+        return RC_OTHER_ERROR;
+    }
+
+    LOG(INFO) << "[" << trace_events_.size() << "] trace event(s) of [" << run_count_ << "] run(s) are saved to ["
+              << filename << "].";
+    return RC_SUCCESS;
+}
 #endif
 
 }} // namespace ppl::nn
@@ -25,12 +25,18 @@
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
 #include "ppl/nn/runtime/profiling_statistics.h"
+#include "ppl/nn/common/tensor_buffer_info.h"
 #include <chrono>
+#include <mutex>
 #endif
 
 namespace ppl { namespace nn {
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+class Profiler final : public BufferEventListener {
+#else
 class Profiler final {
+#endif
 public:
     void Init(const RuntimeInternalConf* conf, const RuntimeGraph* graph, const RuntimeAuxInfo* aux_info);
 
@@ -50,6 +56,44 @@ public:
     ppl::common::RetCode GetProfilingStatistics(ProfilingStatistics*) const;
     void StopProfiling();
 
+public:
+    typedef BufferEventListener::TimePoint TimePoint;
+
+    bool IsTracingEnabled() const {
+        return conf_->tracing_flag;
+    }
+
+    /** @brief discards recorded events and starts recording */
+    void StartTracing();
+    void StopTracing();
+
+    /** @brief writes recorded events to `filename` in Chrome trace event format(chrome://tracing or Perfetto) */
+    ppl::common::RetCode SaveTrace(const char* filename) const;
+
+    /** @brief records a `Run()` which starts at `begin` */
+    void TraceRun(const TimePoint& begin);
+
+    /**
+       @class KernelTraceGuard
+       @brief records execution of `kernel` from construction to `EndKernel()`, and buffer events in the current
+       thread until destruction.
+    */
+    class KernelTraceGuard final {
+    public:
+        KernelTraceGuard(Profiler*, const KernelImpl*);
+        ~KernelTraceGuard();
+        void EndKernel();
+
+    private:
+        Profiler* profiler_;
+        const KernelImpl* kernel_;
+        TimePoint begin_;
+        BufferEventListener* prev_listener_;
+    };
+
+    void OnRealloc(uint64_t bytes, const TimePoint& begin, const TimePoint& end) override;
+    void OnFree(const TimePoint& begin, const TimePoint& end) override;
+
 private:
     struct KernelExecInfo {
         uint32_t exec_count = 0;
@@ -57,6 +101,25 @@ private:
     };
 
     std::vector<KernelExecInfo> nodeid2info_;
+
+private:
+    struct TraceEvent final {
+        enum { RUN, KERNEL, REALLOC, FREE };
+        uint32_t type;
+        uint32_t tid;
+        uint32_t run_idx;
+        nodeid_t nid; // KERNEL only
+        uint64_t bytes; // REALLOC only
+        TimePoint begin;
+        TimePoint end;
+    };
+
+    void AddTraceEvent(const TraceEvent&);
+
+    mutable std::mutex trace_lock_; // kernels may be run in multiple threads
+    uint32_t run_count_ = 0; // index of the running `Run()`
+    TimePoint trace_begin_;
+    std::vector<TraceEvent> trace_events_;
 #endif
 
 private:
@@ -145,6 +145,28 @@ static RetCode InitTensorLastConsumer(const ir::GraphTopo* topo, const vector<no
     return RC_SUCCESS;
 }
 
+static void InitTensorLifetime(const ir::GraphTopo* topo, const vector<nodeid_t>& sorted_nodes,
+                               const vector<nodeid_t>& tensor_last_consumer,
+                               vector<RuntimeAuxInfo::TensorLifetime>* tensor_lifetime) {
+    vector<uint32_t> nid2position(topo->GetMaxNodeId(), RuntimeAuxInfo::TensorLifetime::INVALID_POSITION);
+    for (uint32_t i = 0; i < sorted_nodes.size(); ++i) {
+        nid2position[sorted_nodes[i]] = i;
+    }
+
+    tensor_lifetime->resize(topo->GetMaxEdgeId());
+    for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+        auto edge = it->Get();
+        auto& lifetime = tensor_lifetime->at(edge->GetId());
+
+        auto producer = edge->GetProducer();
+        lifetime.first = (producer == INVALID_NODEID) ? 0 : nid2position[producer];
+
+        auto last_consumer = tensor_last_consumer[edge->GetId()];
+        lifetime.last = (last_consumer < nid2position.size()) ? nid2position[last_consumer]
+                                                              : RuntimeAuxInfo::TensorLifetime::INVALID_POSITION;
+    }
+}
+
 RetCode GenerateRuntimeAuxInfo(const ir::GraphTopo* topo, RuntimeAuxInfo* info) {
     utils::DfsDeeperFirst(topo, [info](nodeid_t nid) -> void {
         info->sorted_nodes.push_back(nid);
@@ -156,6 +178,8 @@ RetCode GenerateRuntimeAuxInfo(const ir::GraphTopo* topo, RuntimeAuxInfo* info)
         return status;
     }
 
+    InitTensorLifetime(topo, info->sorted_nodes, info->tensor_last_consumer, &info->tensor_lifetime);
+
     return RC_SUCCESS;
 }
 
@@ -34,6 +34,17 @@ struct RuntimeAuxInfo final {
 
     /** a tensor can be released right after the last consumer finish executing in `sorted_nodes` */
     std::vector<nodeid_t> tensor_last_consumer;
+
+    /**
+       positions of the producer and the last consumer of each tensor in `sorted_nodes`. tensors that
+       are not released during Run() have `last` == INVALID_POSITION.
+    */
+    struct TensorLifetime final {
+        static constexpr uint32_t INVALID_POSITION = UINT32_MAX;
+        uint32_t first;
+        uint32_t last;
+    };
+    std::vector<TensorLifetime> tensor_lifetime;
 };
 
 ppl::common::RetCode GenerateRuntimeAuxInfo(const ir::GraphTopo*, RuntimeAuxInfo*);
@@ -19,6 +19,7 @@
 #include "ppl/nn/engines/engine.h"
 #include "ppl/nn/runtime/runtime_impl.h"
 #include "ppl/nn/runtime/sequential_scheduler.h"
+#include "ppl/nn/runtime/parallel_scheduler.h"
 #include "ppl/nn/runtime/runtime_internal_conf.h"
 #include "ppl/nn/utils/utils.h"
 #include <stdarg.h>
@@ -282,10 +283,42 @@ RetCode RuntimeImpl::Init(const shared_ptr<ir::GraphTopo>& topo, const shared_pt
         return status;
     }
 
+    if (!resource->fixed_input_dims.empty()) {
+        fixed_input_dims_.resize(graph_.inputs.size(), nullptr);
+        for (uint32_t i = 0; i < graph_.inputs.size(); ++i) {
+            auto ref = resource->fixed_input_dims.find(graph_.inputs[i]->GetName());
+            if (ref != resource->fixed_input_dims.end()) {
+                fixed_input_dims_[i] = &ref->second;
+            }
+        }
+    }
+
     sched_.reset(new SequentialScheduler());
     return sched_->Init(topo.get(), aux_info.get(), &graph_);
 }
 
+RetCode RuntimeImpl::CheckFixedInputShapes() const {
+    for (uint32_t i = 0; i < fixed_input_dims_.size(); ++i) {
+        auto dims = fixed_input_dims_[i];
+        if (!dims) {
+            continue;
+        }
+
+        auto input = graph_.inputs[i];
+        auto shape = input->GetShape();
+        bool matched = (shape->GetDimCount() == dims->size());
+        for (uint32_t j = 0; matched && j < dims->size(); ++j) {
+            matched = (shape->GetDim(j) == dims->at(j));
+        }
+        if (!matched) {
+            LOG(ERROR) << "shape of input[" << input->GetName()
+                       << "] differs from the one declared when building the graph.";
+            return RC_INVALID_VALUE;
+        }
+    }
+    return RC_SUCCESS;
+}
+
 RetCode RuntimeImpl::Sync() {
     for (uint32_t i = 0; i < GetOutputCount(); ++i) {
         auto output = GetOutputTensorImpl(i);
@@ -304,6 +337,15 @@ RetCode RuntimeImpl::Sync() {
 RetCode RuntimeImpl::Run() {
     RetCode status;
 
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto run_begin_ts = std::chrono::steady_clock::now();
+#endif
+
+    status = CheckFixedInputShapes();
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
     for (auto x = engctx_.begin(); x != engctx_.end(); ++x) {
         status = x->get()->BeforeRun();
         if (status != RC_SUCCESS) {
@@ -319,7 +361,13 @@ RetCode RuntimeImpl::Run() {
         return status;
     }
 
-    return Sync();
+    status = Sync();
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    profiler_.TraceRun(run_begin_ts);
+#endif
+
+    return status;
 }
 
 RetCode RuntimeImpl::GetProfilingStatistics(ProfilingStatistics* stat) const {
@@ -352,8 +400,59 @@ RetCode RuntimeImpl::SetProfilingFlag(RuntimeImpl* rt, va_list args) {
 #endif
 }
 
+RetCode RuntimeImpl::SetTracingFlag(RuntimeImpl* rt, va_list args) {
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto flag = va_arg(args, uint32_t);
+    bool tracing_flag = (flag > 0);
+    rt->conf_.tracing_flag = tracing_flag;
+
+    if (tracing_flag) {
+        rt->profiler_.StartTracing();
+    } else {
+        rt->profiler_.StopTracing();
+    }
+
+    return RC_SUCCESS;
+#else
+    LOG(ERROR) << "this version does not support tracing.";
+    return RC_UNSUPPORTED;
+#endif
+}
+
+RetCode RuntimeImpl::SaveTrace(RuntimeImpl* rt, va_list args) {
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    auto filename = va_arg(args, const char*);
+    return rt->profiler_.SaveTrace(filename);
+#else
+    LOG(ERROR) << "this version does not support tracing.";
+    return RC_UNSUPPORTED;
+#endif
+}
+
+RetCode RuntimeImpl::UseSequentialScheduler(RuntimeImpl* rt, va_list) {
+    rt->sched_.reset(new SequentialScheduler());
+    return rt->sched_->Init(rt->topo_.get(), rt->aux_info_.get(), &rt->graph_);
+}
+
+RetCode RuntimeImpl::UseParallelScheduler(RuntimeImpl* rt, va_list args) {
+    auto thread_num = va_arg(args, uint32_t);
+    rt->sched_.reset(new ParallelScheduler(thread_num));
+    return rt->sched_->Init(rt->topo_.get(), rt->aux_info_.get(), &rt->graph_);
+}
+
+RetCode RuntimeImpl::SetMemoryPlanFlag(RuntimeImpl* rt, va_list args) {
+    auto flag = va_arg(args, uint32_t);
+    rt->sched_.reset(new SequentialScheduler(flag > 0));
+    return rt->sched_->Init(rt->topo_.get(), rt->aux_info_.get(), &rt->graph_);
+}
+
 RuntimeImpl::ConfHandlerFunc RuntimeImpl::conf_handlers_[] = {
-    RuntimeImpl::SetProfilingFlag,
+    RuntimeImpl::SetProfilingFlag, // RUNTIME_CONF_SET_KERNEL_PROFILING_FLAG
+    RuntimeImpl::UseSequentialScheduler, // RUNTIME_CONF_SCHED_SEQ
+    RuntimeImpl::UseParallelScheduler, // RUNTIME_CONF_SCHED_PARALLEL
+    RuntimeImpl::SetMemoryPlanFlag, // RUNTIME_CONF_SET_MEMORY_PLAN_FLAG
+    RuntimeImpl::SetTracingFlag, // RUNTIME_CONF_SET_TRACING_FLAG
+    RuntimeImpl::SaveTrace, // RUNTIME_CONF_SAVE_TRACE
 };
 
 RetCode RuntimeImpl::Configure(uint32_t option, ...) {
@@ -91,6 +91,8 @@ private:
     */
     ppl::common::RetCode Sync();
 
+    ppl::common::RetCode CheckFixedInputShapes() const;
+
 private:
     RuntimeGraph graph_;
     std::unique_ptr<Scheduler> sched_;
@@ -98,6 +100,9 @@ private:
     RuntimeInternalConf conf_;
     Profiler profiler_;
 
+    // dims of inputs the graph is specialized for, nullptr if the corresponding input is dynamic
+    std::vector<const std::vector<int64_t>*> fixed_input_dims_;
+
     // ----- shared data ----- //
 
     std::shared_ptr<ir::GraphTopo> topo_;
@@ -111,6 +116,11 @@ private:
       defined as member functions can avoid exporting unnecessary APIs
     */
     static ppl::common::RetCode SetProfilingFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode UseSequentialScheduler(RuntimeImpl*, va_list);
+    static ppl::common::RetCode UseParallelScheduler(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetMemoryPlanFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SetTracingFlag(RuntimeImpl*, va_list);
+    static ppl::common::RetCode SaveTrace(RuntimeImpl*, va_list);
 
     typedef ppl::common::RetCode (*ConfHandlerFunc)(RuntimeImpl*, va_list);
     static ConfHandlerFunc conf_handlers_[RUNTIME_CONF_MAX];
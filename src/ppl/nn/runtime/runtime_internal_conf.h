@@ -23,6 +23,7 @@ namespace ppl { namespace nn {
 struct RuntimeInternalConf {
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
     bool profiling_flag = false;
+    bool tracing_flag = false;
 #endif
 };
 
@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/runtime_pool_impl.h"
+#include "ppl/nn/common/logger.h"
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn {
+
+RetCode RuntimePoolImpl::Init(RuntimeBuilder* builder, uint32_t runtime_num) {
+    if (runtime_num == 0) {
+        LOG(ERROR) << "runtime_num of RuntimePool is 0.";
+        return RC_INVALID_VALUE;
+    }
+
+    runtimes_.reserve(runtime_num);
+    idle_runtimes_.reserve(runtime_num);
+
+    for (uint32_t i = 0; i < runtime_num; ++i) {
+        auto runtime = builder->CreateRuntime();
+        if (!runtime) {
+            LOG(ERROR) << "create runtime[" << i << "] of RuntimePool failed.";
+            return RC_OTHER_ERROR;
+        }
+        runtimes_.emplace_back(unique_ptr<Runtime>(runtime));
+        idle_runtimes_.push_back(runtime);
+    }
+
+    return RC_SUCCESS;
+}
+
+Runtime* RuntimePoolImpl::Acquire() {
+    unique_lock<mutex> lck(lock_);
+    cond_.wait(lck, [this]() -> bool {
+        return !idle_runtimes_.empty();
+    });
+
+    auto runtime = idle_runtimes_.back();
+    idle_runtimes_.pop_back();
+    busy_runtimes_.insert(runtime);
+    return runtime;
+}
+
+Runtime* RuntimePoolImpl::TryAcquire() {
+    lock_guard<mutex> lck(lock_);
+    if (idle_runtimes_.empty()) {
+        return nullptr;
+    }
+
+    auto runtime = idle_runtimes_.back();
+    idle_runtimes_.pop_back();
+    busy_runtimes_.insert(runtime);
+    return runtime;
+}
+
+RetCode RuntimePoolImpl::Release(Runtime* runtime) {
+    {
+        lock_guard<mutex> lck(lock_);
+        auto ref = busy_runtimes_.find(runtime);
+        if (ref == busy_runtimes_.end()) {
+            LOG(ERROR) << "runtime[" << runtime << "] is not acquired from this RuntimePool or has been released.";
+            return RC_INVALID_VALUE;
+        }
+        busy_runtimes_.erase(ref);
+        idle_runtimes_.push_back(runtime);
+    }
+    cond_.notify_one();
+    return RC_SUCCESS;
+}
+
+}} // namespace ppl::nn
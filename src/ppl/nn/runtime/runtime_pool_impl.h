@@ -0,0 +1,58 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_RUNTIME_RUNTIME_POOL_IMPL_H_
+#define _ST_HPC_PPL_NN_RUNTIME_RUNTIME_POOL_IMPL_H_
+
+#include "ppl/nn/runtime/runtime_pool.h"
+#include "ppl/nn/runtime/runtime_builder.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace ppl { namespace nn {
+
+class RuntimePoolImpl final : public RuntimePool {
+public:
+    RuntimePoolImpl() {}
+    ppl::common::RetCode Init(RuntimeBuilder*, uint32_t runtime_num);
+
+    uint32_t GetRuntimeCount() const override {
+        return runtimes_.size();
+    }
+    Runtime* Acquire() override;
+    Runtime* TryAcquire() override;
+    ppl::common::RetCode Release(Runtime*) override;
+
+private:
+    std::vector<std::unique_ptr<Runtime>> runtimes_;
+
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::vector<Runtime*> idle_runtimes_;
+    std::set<Runtime*> busy_runtimes_;
+
+private:
+    RuntimePoolImpl(const RuntimePoolImpl&) = delete;
+    RuntimePoolImpl& operator=(const RuntimePoolImpl&) = delete;
+};
+
+}} // namespace ppl::nn
+
+#endif
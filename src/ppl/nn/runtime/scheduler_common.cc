@@ -50,8 +50,8 @@ vector<EdgeObject*> InitObjectInUse(edgeid_t max_edge_id, RuntimeGraph* graph) {
     return objects_in_use;
 }
 
-static RetCode AfterExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
-                                  const function<RetCode(EdgeObject*, nodeid_t)>& release_func) {
+RetCode AfterExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
+                           const function<RetCode(EdgeObject*, nodeid_t)>& release_func) {
     auto nid = kernel->GetNode()->GetId();
 
     for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
@@ -94,9 +94,14 @@ static RetCode AfterExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
 
 RetCode ExecuteKernel(KernelImpl* kernel, KernelExecContext* ctx,
                       const function<RetCode(EdgeObject*, nodeid_t)>& release_func, Profiler* profiler) {
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    Profiler::KernelTraceGuard __trace_guard__(profiler, kernel);
+#endif
+
     auto exec_status = kernel->Execute(ctx);
 
 #ifdef PPLNN_ENABLE_KERNEL_PROFILING
+    __trace_guard__.EndKernel();
     profiler->CollectStatistics(kernel);
 #endif
 
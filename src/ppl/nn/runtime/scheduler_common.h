@@ -29,6 +29,10 @@ namespace ppl { namespace nn { namespace utils {
 /** @brief put inputs/extra_inputs/outputs/constants into a vector */
 std::vector<EdgeObject*> InitObjectInUse(edgeid_t max_edge_id, RuntimeGraph* graph);
 
+/** @brief calls `release_func` for each input/extra input/output object of `kernel` */
+ppl::common::RetCode AfterExecuteKernel(KernelImpl*, KernelExecContext*,
+                                        const std::function<ppl::common::RetCode(EdgeObject*, nodeid_t)>& release_func);
+
 ppl::common::RetCode ExecuteKernel(KernelImpl*, KernelExecContext*,
                                    const std::function<ppl::common::RetCode(EdgeObject*, nodeid_t)>& release_func,
                                    Profiler*);
@@ -22,11 +22,17 @@
 #include "ppl/nn/common/logger.h"
 #include "ppl/nn/runtime/sequential_scheduler.h"
 #include "ppl/nn/runtime/scheduler_common.h"
+#include "ppl/nn/utils/memory_planner.h"
+#include <map>
 using namespace std;
 using namespace ppl::common;
 
 namespace ppl { namespace nn {
 
+SequentialScheduler::~SequentialScheduler() {
+    ReleaseMemoryPlan();
+}
+
 RetCode SequentialScheduler::Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info, RuntimeGraph* g) {
     graph_ = g;
     topo_ = topo;
@@ -38,9 +44,14 @@ RetCode SequentialScheduler::Init(const ir::GraphTopo* topo, const RuntimeAuxInf
 class SchedulerAcquireObject final : public InputOutputInfo::AcquireObject {
 public:
     SchedulerAcquireObject(const ir::GraphTopo* topo, vector<EdgeObject*>* edgeid2object,
-                           ObjectPool<TensorImpl>* tensor_pool, ObjectPool<TensorSequence>* tensor_sequence_pool)
-        : device_(nullptr), topo_(topo), edgeid2object_(edgeid2object), tensor_pool_(tensor_pool)
-        , tensor_sequence_pool_(tensor_sequence_pool) {}
+                           ObjectPool<TensorImpl>* tensor_pool, ObjectPool<TensorSequence>* tensor_sequence_pool,
+                           const vector<SequentialScheduler::PlannedBuffer>* edgeid2planned_buffer)
+        : device_(nullptr)
+        , topo_(topo)
+        , edgeid2object_(edgeid2object)
+        , tensor_pool_(tensor_pool)
+        , tensor_sequence_pool_(tensor_sequence_pool)
+        , edgeid2planned_buffer_(edgeid2planned_buffer) {}
 
     void SetDevice(Device* d) {
         device_ = d;
@@ -58,6 +69,12 @@ public:
             if (etype == EdgeObject::T_TENSOR) {
                 auto tensor = tensor_pool_->Alloc(edge, TENSORTYPE_NORMAL);
                 tensor->SetDevice(device_);
+                if (eid < edgeid2planned_buffer_->size()) {
+                    auto& planned = edgeid2planned_buffer_->at(eid);
+                    if (planned.bytes > 0) {
+                        tensor->SetPlannedBuffer(planned.buffer, planned.bytes);
+                    }
+                }
                 object = tensor;
             } else if (etype == EdgeObject::T_TENSOR_SEQUENCE) {
                 object = tensor_sequence_pool_->Alloc(edge);
@@ -83,11 +100,218 @@ private:
     vector<EdgeObject*>* edgeid2object_;
     ObjectPool<TensorImpl>* tensor_pool_;
     ObjectPool<TensorSequence>* tensor_sequence_pool_;
+    const vector<SequentialScheduler::PlannedBuffer>* edgeid2planned_buffer_;
 };
 
+static bool TensorShapeEqual(const TensorShape& a, const TensorShape& b) {
+    if (a.GetDataType() != b.GetDataType() || a.GetDataFormat() != b.GetDataFormat() ||
+        a.GetDimCount() != b.GetDimCount()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetDimCount(); ++i) {
+        if (a.GetDim(i) != b.GetDim(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SequentialScheduler::IsMemoryPlanValid() const {
+    if (!is_memory_plan_valid_) {
+        return false;
+    }
+
+    uint32_t idx = 0;
+    for (auto it = graph_->inputs.begin(); it != graph_->inputs.end(); ++it, ++idx) {
+        if (!TensorShapeEqual(*(*it)->GetShape(), planned_input_shapes_[idx])) {
+            return false;
+        }
+    }
+    for (auto it = graph_->extra_inputs.begin(); it != graph_->extra_inputs.end(); ++it, ++idx) {
+        if (!TensorShapeEqual(*(*it)->GetShape(), planned_input_shapes_[idx])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SequentialScheduler::ReleaseMemoryPlan() {
+    for (auto it = arenas_.begin(); it != arenas_.end(); ++it) {
+        it->first->Free(&it->second);
+    }
+    arenas_.clear();
+    edgeid2planned_buffer_.clear();
+    planned_input_shapes_.clear();
+    is_memory_plan_valid_ = false;
+}
+
+static edgeid_t FindAliasRoot(const vector<edgeid_t>& alias_parent, edgeid_t eid) {
+    while (alias_parent[eid] != eid) {
+        eid = alias_parent[eid];
+    }
+    return eid;
+}
+
+// arena offsets are aligned to this value, which is large enough for all devices
+static const uint64_t g_memory_plan_alignment = 256;
+
+/*
+  edges sharing the same buffer(by `TensorImpl::TransferBufferFrom()` for example) are merged into one block which
+  is alive from the first producer to the last consumer. blocks that contain edges not released during Run() are not
+  planned.
+*/
+RetCode SequentialScheduler::GenerateMemoryPlan(const vector<TensorUsage>& edgeid2usage,
+                                                const vector<edgeid_t>& alias_parent) {
+    struct AliasGroup final {
+        utils::MemoryBlock block = {0, UINT32_MAX, 0};
+        Device* device = nullptr;
+        bool is_plannable = true;
+        bool has_buffer_owner = false;
+        vector<edgeid_t> members;
+    };
+
+    vector<edgeid_t> edgeid2root(edgeid2usage.size());
+    vector<uint32_t> root2size(edgeid2usage.size(), 0);
+    for (edgeid_t eid = 0; eid < edgeid2usage.size(); ++eid) {
+        edgeid2root[eid] = FindAliasRoot(alias_parent, eid);
+        ++root2size[edgeid2root[eid]];
+    }
+
+    map<edgeid_t, AliasGroup> root2group;
+    for (edgeid_t eid = 0; eid < edgeid2usage.size(); ++eid) {
+        auto& usage = edgeid2usage[eid];
+        auto root = edgeid2root[eid];
+        if (!usage.is_recorded && root2size[root] == 1) {
+            continue;
+        }
+
+        auto& group = root2group[root];
+        group.members.push_back(eid);
+
+        auto& lifetime = aux_info_->tensor_lifetime[eid];
+        if (!usage.is_recorded || lifetime.last == RuntimeAuxInfo::TensorLifetime::INVALID_POSITION ||
+            (group.device && group.device != usage.device)) {
+            group.is_plannable = false;
+            continue;
+        }
+
+        group.device = usage.device;
+        group.has_buffer_owner = group.has_buffer_owner || usage.is_buffer_owner;
+        group.block.bytes = std::max(group.block.bytes, usage.bytes);
+        group.block.first = std::min(group.block.first, lifetime.first);
+        group.block.last = std::max(group.block.last, lifetime.last);
+    }
+
+    map<Device*, vector<const AliasGroup*>> dev2groups;
+    for (auto it = root2group.begin(); it != root2group.end(); ++it) {
+        auto& group = it->second;
+        // skips tensors whose buffers are not allocated by devices
+        if (group.is_plannable && group.has_buffer_owner && group.block.bytes > 0) {
+            dev2groups[group.device].push_back(&group);
+        }
+    }
+
+    edgeid2planned_buffer_.resize(edgeid2usage.size());
+
+    for (auto it = dev2groups.begin(); it != dev2groups.end(); ++it) {
+        auto device = it->first;
+        auto& groups = it->second;
+
+        vector<utils::MemoryBlock> blocks(groups.size());
+        for (uint32_t i = 0; i < groups.size(); ++i) {
+            blocks[i] = groups[i]->block;
+        }
+
+        vector<uint64_t> offsets;
+        auto arena_bytes = utils::PlanMemoryBlocks(blocks, g_memory_plan_alignment, &offsets);
+
+        BufferDesc arena;
+        auto status = device->Realloc(arena_bytes, &arena);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "alloc arena of [" << arena_bytes << "] bytes failed: " << GetRetCodeStr(status);
+            return status;
+        }
+        arenas_.push_back(make_pair(device, arena));
+
+        for (uint32_t i = 0; i < groups.size(); ++i) {
+            auto group = groups[i];
+            for (auto m = group->members.begin(); m != group->members.end(); ++m) {
+                auto& planned = edgeid2planned_buffer_[*m];
+                planned.buffer = BufferDesc(static_cast<char*>(arena.addr) + offsets[i]);
+                planned.bytes = group->block.bytes;
+            }
+        }
+
+        LOG(INFO) << "memory plan of [" << groups.size() << "] buffer(s): arena [" << arena_bytes
+                  << "] bytes, peak of live tensors [" << utils::CalcPeakMemoryBytes(blocks) << "] bytes.";
+    }
+
+    for (auto it = graph_->inputs.begin(); it != graph_->inputs.end(); ++it) {
+        planned_input_shapes_.push_back(*(*it)->GetShape());
+    }
+    for (auto it = graph_->extra_inputs.begin(); it != graph_->extra_inputs.end(); ++it) {
+        planned_input_shapes_.push_back(*(*it)->GetShape());
+    }
+
+    is_memory_plan_valid_ = true;
+    return RC_SUCCESS;
+}
+
 RetCode SequentialScheduler::Run(Profiler* profiler) {
-    auto release_object_func = [this](EdgeObject* object, nodeid_t user) -> RetCode {
+    /*
+      buffer usages are recorded during the first Run() after enabling memory plan or changing input shapes.
+      following Run()s use buffers in arenas generated by the recorded usages.
+    */
+    const bool is_recording = (enable_memory_plan_ && !IsMemoryPlanValid());
+    if (is_recording) {
+        ReleaseMemoryPlan();
+    }
+
+    vector<TensorUsage> edgeid2usage;
+    vector<edgeid_t> alias_parent;
+    vector<pair<void*, edgeid_t>> input_addrs; // buffers of inputs of the running kernel
+    if (is_recording) {
+        edgeid2usage.resize(topo_->GetMaxEdgeId());
+        alias_parent.resize(topo_->GetMaxEdgeId());
+        for (edgeid_t i = 0; i < alias_parent.size(); ++i) {
+            alias_parent[i] = i;
+        }
+    }
+
+    auto record_usage_func = [this, &edgeid2usage, &alias_parent, &input_addrs](TensorImpl* tensor) -> void {
+        auto eid = tensor->GetEdge()->GetId();
+        auto& usage = edgeid2usage[eid];
+        usage.is_recorded = true;
+        usage.is_buffer_owner = tensor->IsBufferOwner();
+        usage.bytes = tensor->GetShape()->GetBytesIncludingPadding();
+        usage.device = tensor->GetDevice();
+        usage.addr = tensor->GetBufferPtr();
+
+        if (usage.addr) {
+            for (auto x = input_addrs.begin(); x != input_addrs.end(); ++x) {
+                if (x->first == usage.addr) {
+                    alias_parent[FindAliasRoot(alias_parent, eid)] = FindAliasRoot(alias_parent, x->second);
+                }
+            }
+        }
+    };
+
+    auto release_object_func = [this, is_recording, &record_usage_func](EdgeObject* object, nodeid_t user) -> RetCode {
         auto eid = object->GetEdge()->GetId();
+
+        if (enable_memory_plan_ && object->GetEdge()->GetProducer() == user &&
+            object->GetObjectType() == EdgeObject::T_TENSOR) {
+            auto tensor = static_cast<TensorImpl*>(object);
+            if (is_recording) {
+                record_usage_func(tensor);
+            } else if (eid < edgeid2planned_buffer_.size() && edgeid2planned_buffer_[eid].bytes > 0 &&
+                       tensor->IsBufferOwner()) {
+                // planned buffer is not used. generates a new plan in the next Run().
+                is_memory_plan_valid_ = false;
+            }
+        }
+
         if (aux_info_->tensor_last_consumer[eid] == user) {
             auto obj = edgeid2object_[eid];
             if (obj->GetObjectType() == EdgeObject::T_TENSOR) {
@@ -115,7 +339,8 @@ RetCode SequentialScheduler::Run(Profiler* profiler) {
     KernelExecContext ctx;
     ctx.SetProfilingFlag(profiler->IsProfilingEnabled());
 
-    SchedulerAcquireObject getter(topo_, &edgeid2object_, &tensor_pool_, &tensor_sequence_pool_);
+    SchedulerAcquireObject getter(topo_, &edgeid2object_, &tensor_pool_, &tensor_sequence_pool_,
+                                  &edgeid2planned_buffer_);
     ctx.SetAcquireObject(&getter);
 
     for (auto x = aux_info_->sorted_nodes.begin(); x != aux_info_->sorted_nodes.end(); ++x) {
@@ -123,6 +348,23 @@ RetCode SequentialScheduler::Run(Profiler* profiler) {
         ctx.SetNode(kernel->GetNode());
         getter.SetDevice(kernel->GetDevice());
 
+        if (is_recording) {
+            auto node = kernel->GetNode();
+            input_addrs.clear();
+            for (uint32_t i = 0; i < node->GetInputCount() + node->GetExtraInputCount(); ++i) {
+                auto eid = (i < node->GetInputCount()) ? node->GetInput(i)
+                                                       : node->GetExtraInput(i - node->GetInputCount());
+                if (eid >= edgeid2object_.size() || !edgeid2object_[eid] ||
+                    edgeid2object_[eid]->GetObjectType() != EdgeObject::T_TENSOR) {
+                    continue;
+                }
+                auto addr = static_cast<TensorImpl*>(edgeid2object_[eid])->GetBufferPtr();
+                if (addr) {
+                    input_addrs.push_back(make_pair(addr, eid));
+                }
+            }
+        }
+
         auto status = utils::ExecuteKernel(kernel, &ctx, release_object_func, profiler);
         if (status != RC_SUCCESS) {
             LOG(ERROR) << "execute kernel[" << kernel->GetName() << "] failed: " << GetRetCodeStr(status);
@@ -167,6 +409,15 @@ RetCode SequentialScheduler::Run(Profiler* profiler) {
     }
 #endif
 
+    if (is_recording) {
+        auto status = GenerateMemoryPlan(edgeid2usage, alias_parent);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "GenerateMemoryPlan failed: " << GetRetCodeStr(status);
+            ReleaseMemoryPlan();
+            return status;
+        }
+    }
+
     return RC_SUCCESS;
 }
 
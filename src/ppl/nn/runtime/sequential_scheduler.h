@@ -26,9 +26,36 @@ namespace ppl { namespace nn {
 
 class SequentialScheduler final : public Scheduler {
 public:
+    /** @param enable_memory_plan see `RUNTIME_CONF_SET_MEMORY_PLAN_FLAG` */
+    SequentialScheduler(bool enable_memory_plan = false)
+        : enable_memory_plan_(enable_memory_plan), is_memory_plan_valid_(false) {}
+    ~SequentialScheduler();
+
     ppl::common::RetCode Init(const ir::GraphTopo* topo, const RuntimeAuxInfo* aux_info, RuntimeGraph* g) override;
     ppl::common::RetCode Run(Profiler*) override;
 
+public:
+    /** a slice of an arena that is assigned to an edge */
+    struct PlannedBuffer final {
+        BufferDesc buffer;
+        uint64_t bytes = 0; // 0 if the edge is not planned
+    };
+
+    /** buffer usage of an output tensor recorded during Run() */
+    struct TensorUsage final {
+        bool is_recorded = false;
+        bool is_buffer_owner = false;
+        uint64_t bytes = 0;
+        Device* device = nullptr;
+        void* addr = nullptr;
+    };
+
+private:
+    bool IsMemoryPlanValid() const;
+    ppl::common::RetCode GenerateMemoryPlan(const std::vector<TensorUsage>& edgeid2usage,
+                                            const std::vector<edgeid_t>& alias_parent);
+    void ReleaseMemoryPlan();
+
 private:
     const ir::GraphTopo* topo_;
     const RuntimeAuxInfo* aux_info_;
@@ -42,6 +69,19 @@ private:
 
     /** used to accelerlate tensor sequence allocations */
     ppl::common::ObjectPool<TensorSequence> tensor_sequence_pool_;
+
+    // ----- memory plan ----- //
+
+    bool enable_memory_plan_;
+    bool is_memory_plan_valid_;
+
+    /** shapes of inputs and extra inputs with which the current plan is generated */
+    std::vector<TensorShape> planned_input_shapes_;
+
+    /** one arena for each device */
+    std::vector<std::pair<Device*, BufferDesc>> arenas_;
+
+    std::vector<PlannedBuffer> edgeid2planned_buffer_;
 };
 
 }} // namespace ppl::nn
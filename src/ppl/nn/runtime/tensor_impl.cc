@@ -23,7 +23,7 @@ using namespace ppl::common;
 namespace ppl { namespace nn {
 
 RetCode TensorImpl::ReallocBuffer() {
-    if (!buffer_info_.IsBufferOwner() && buffer_info_.GetBufferPtr()) {
+    if (!buffer_info_.IsBufferOwner() && !buffer_info_.IsPlannedBuffer() && buffer_info_.GetBufferPtr()) {
         LOG(WARNING) << "tensor[" << GetName() << "] is not the buffer owner. ReallocBuffer() does nothing.";
         return RC_SUCCESS;
     }
@@ -67,6 +67,15 @@ public:
         buffer_info_.SetBuffer(buf, device, is_buffer_owner);
     }
 
+    /** @brief see `TensorBufferInfo::SetPlannedBuffer()` */
+    void SetPlannedBuffer(const BufferDesc& buf, uint64_t capacity) {
+        buffer_info_.SetPlannedBuffer(buf, capacity);
+    }
+
+    bool IsPlannedBuffer() const {
+        return buffer_info_.IsPlannedBuffer();
+    }
+
     /**
        @brief move buffer from tensor `another`. old buffer of this tensor will be freed(or detached).
        @note this tensor will inherits the ownership of `another`.
@@ -0,0 +1,245 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/huge_page_allocator.h"
+#include "ppl/nn/common/logger.h"
+#include <vector>
+using namespace std;
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <string.h> // strerror
+#include <sys/mman.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace ppl { namespace nn { namespace utils {
+
+static const uint64_t kRegularPageSize = 4096;
+static const uint64_t kMinArenaSize = 32ull << 20;
+
+static inline uint64_t Align(uint64_t x, uint64_t n) {
+    return (x + n - 1) / n * n;
+}
+
+static inline uint32_t Log2(uint64_t x) {
+    uint32_t n = 0;
+    while (x > 1) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+}
+
+HugePageAllocator::HugePageAllocator(uint64_t page_size, int32_t numa_node_id, uint64_t alignment)
+    : page_size_(page_size)
+    , numa_node_id_(numa_node_id)
+    , alignment_(alignment)
+    , arena_size_(page_size > kMinArenaSize ? page_size : kMinArenaSize) {
+#ifndef __linux__
+    if (page_size_ > 0 || numa_node_id_ >= 0) {
+        LOG(WARNING) << "huge pages and numa binding are only supported on linux. regular pages are used.";
+    }
+#endif
+}
+
+HugePageAllocator::~HugePageAllocator() {
+    uint32_t leaked = 0;
+    for (auto x = arenas_.begin(); x != arenas_.end(); ++x) {
+        if (x->second.refcount > 0) {
+            ++leaked;
+        }
+        UnmapArena(x->first, x->second.size);
+    }
+    if (leaked > 0) {
+        LOG(WARNING) << "[" << leaked << "] arena(s) are not freed.";
+    }
+}
+
+#ifdef __linux__
+static bool BindToNumaNode(void* addr, uint64_t bytes, int32_t numa_node_id) {
+    const uint32_t bits_per_ulong = sizeof(unsigned long) * 8;
+    vector<unsigned long> nodemask(numa_node_id / bits_per_ulong + 1, 0);
+    nodemask[numa_node_id / bits_per_ulong] |= (1ul << (numa_node_id % bits_per_ulong));
+    // the kernel ignores the last bit of `maxnode`
+    const unsigned long maxnode = nodemask.size() * bits_per_ulong + 1;
+    return (syscall(SYS_mbind, addr, bytes, MPOL_BIND, nodemask.data(), maxnode, 0) == 0);
+}
+#endif
+
+char* HugePageAllocator::MapArena(uint64_t bytes) {
+#ifdef _MSC_VER
+    auto addr = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!addr) {
+        LOG(ERROR) << "VirtualAlloc [" << bytes << "] bytes failed: " << GetLastError();
+        return nullptr;
+    }
+#else
+    void* addr = MAP_FAILED;
+
+#ifdef __linux__
+    if (page_size_ > 0) {
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (Log2(page_size_) << MAP_HUGE_SHIFT);
+        addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (addr == MAP_FAILED && !huge_page_warned_) {
+            LOG(WARNING) << "mapping [" << bytes << "] bytes of huge pages of size [" << page_size_
+                         << "] failed: " << strerror(errno) << ". transparent huge pages are used instead.";
+            huge_page_warned_ = true;
+        }
+    }
+#endif
+
+    if (addr == MAP_FAILED) {
+        // transparent huge pages only work in aligned areas, so that the mapping is trimmed to be aligned
+        const uint64_t extra = (page_size_ > 0 ? page_size_ : 0);
+        auto raw = mmap(nullptr, bytes + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            LOG(ERROR) << "mmap [" << bytes << "] bytes failed: " << strerror(errno);
+            return nullptr;
+        }
+
+        auto raw_begin = (char*)raw;
+        auto begin = raw_begin + Align((uintptr_t)raw_begin, extra > 0 ? extra : 1) - (uintptr_t)raw_begin;
+        if (begin > raw_begin) {
+            munmap(raw_begin, begin - raw_begin);
+        }
+        auto raw_end = raw_begin + bytes + extra;
+        if (raw_end > begin + bytes) {
+            munmap(begin + bytes, raw_end - (begin + bytes));
+        }
+        addr = begin;
+
+#ifdef __linux__
+        if (page_size_ > 0) {
+            madvise(addr, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+#ifdef __linux__
+    if (numa_node_id_ >= 0 && !BindToNumaNode(addr, bytes, numa_node_id_)) {
+        LOG(WARNING) << "binding [" << bytes << "] bytes to numa node [" << numa_node_id_
+                     << "] failed: " << strerror(errno);
+    }
+#endif
+#endif
+
+    mapped_bytes_ += bytes;
+    return (char*)addr;
+}
+
+void HugePageAllocator::UnmapArena(char* base, uint64_t bytes) {
+#ifdef _MSC_VER
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, bytes);
+#endif
+    mapped_bytes_ -= bytes;
+}
+
+void* HugePageAllocator::Alloc(uint64_t bytes) {
+    if (bytes == 0) {
+        return nullptr;
+    }
+
+    const uint64_t size = Align(bytes, alignment_);
+
+    lock_guard<mutex> __guard__(lock_);
+
+    if (size > arena_size_ / 2) {
+        const uint64_t arena_size = Align(size, page_size_ > 0 ? page_size_ : kRegularPageSize);
+        auto base = MapArena(arena_size);
+        if (!base) {
+            return nullptr;
+        }
+        auto& arena = arenas_[base];
+        arena.size = arena_size;
+        arena.used = arena_size;
+        arena.refcount = 1;
+        return base;
+    }
+
+    if (cur_arena_) {
+        auto& arena = arenas_[cur_arena_];
+        if (arena.used + size <= arena.size) {
+            auto addr = cur_arena_ + arena.used;
+            arena.used += size;
+            ++arena.refcount;
+            return addr;
+        }
+        // the full arena is unmapped when its last buffer is freed
+        cur_arena_ = nullptr;
+    }
+
+    auto base = MapArena(arena_size_);
+    if (!base) {
+        return nullptr;
+    }
+    auto& arena = arenas_[base];
+    arena.size = arena_size_;
+    arena.used = size;
+    arena.refcount = 1;
+    cur_arena_ = base;
+    return base;
+}
+
+void HugePageAllocator::Free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    auto addr = (char*)ptr;
+
+    lock_guard<mutex> __guard__(lock_);
+
+    auto ref = arenas_.upper_bound(addr);
+    if (ref == arenas_.begin()) {
+        LOG(ERROR) << "buffer [" << ptr << "] is not allocated by this allocator.";
+        return;
+    }
+    --ref;
+    auto& arena = ref->second;
+    if (addr >= ref->first + arena.size || arena.refcount == 0) {
+        LOG(ERROR) << "buffer [" << ptr << "] is not allocated by this allocator.";
+        return;
+    }
+
+    --arena.refcount;
+    if (arena.refcount > 0) {
+        return;
+    }
+
+    // the current arena is kept for subsequent allocations
+    if (ref->first == cur_arena_) {
+        arena.used = 0;
+        return;
+    }
+
+    UnmapArena(ref->first, arena.size);
+    arenas_.erase(ref);
+}
+
+}}} // namespace ppl::nn::utils
@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_UTILS_HUGE_PAGE_ALLOCATOR_H_
+#define _ST_HPC_PPL_NN_UTILS_HUGE_PAGE_ALLOCATOR_H_
+
+#include "ppl/common/allocator.h"
+#include <map>
+#include <mutex>
+
+namespace ppl { namespace nn { namespace utils {
+
+/**
+   @brief allocates memory from arenas backed by huge pages and optionally bound to a numa node.
+   small buffers are carved out of shared arenas, which are unmapped after all their buffers are freed.
+   buffers larger than half of an arena get their own mappings.
+   @note falls back to transparent huge pages if the system has no huge pages of `page_size` reserved.
+*/
+class HugePageAllocator final : public ppl::common::Allocator {
+public:
+    static const uint64_t kPageSize2M = 2ull << 20;
+    static const uint64_t kPageSize1G = 1ull << 30;
+
+    /**
+       @param page_size 0 for regular pages, or `kPageSize2M`/`kPageSize1G`
+       @param numa_node_id memory is bound to this node if it is not negative
+    */
+    HugePageAllocator(uint64_t page_size, int32_t numa_node_id, uint64_t alignment);
+    ~HugePageAllocator();
+
+    void* Alloc(uint64_t bytes) override;
+    void Free(void*) override;
+
+    uint64_t GetMappedBytes() const {
+        return mapped_bytes_;
+    }
+
+private:
+    struct Arena final {
+        uint64_t size = 0;
+        uint64_t used = 0;
+        uint32_t refcount = 0;
+    };
+
+    char* MapArena(uint64_t bytes);
+    void UnmapArena(char* base, uint64_t bytes);
+
+private:
+    const uint64_t page_size_;
+    const int32_t numa_node_id_;
+    const uint64_t alignment_;
+    const uint64_t arena_size_;
+
+    std::mutex lock_;
+    std::map<char*, Arena> arenas_; // base address => arena
+    char* cur_arena_ = nullptr; // arena that small buffers are allocated from
+    uint64_t mapped_bytes_ = 0;
+    bool huge_page_warned_ = false;
+
+private:
+    HugePageAllocator(const HugePageAllocator&) = delete;
+    void operator=(const HugePageAllocator&) = delete;
+};
+
+}}} // namespace ppl::nn::utils
+
+#endif
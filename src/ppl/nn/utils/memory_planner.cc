@@ -0,0 +1,101 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/memory_planner.h"
+#include <algorithm>
+#include <map>
+using namespace std;
+
+namespace ppl { namespace nn { namespace utils {
+
+static inline uint64_t Align(uint64_t v, uint64_t alignment) {
+    return (v + alignment - 1) / alignment * alignment;
+}
+
+static inline bool IsOverlapped(const MemoryBlock& a, const MemoryBlock& b) {
+    return (a.first <= b.last && b.first <= a.last);
+}
+
+uint64_t PlanMemoryBlocks(const vector<MemoryBlock>& blocks, uint64_t alignment, vector<uint64_t>* offsets) {
+    if (alignment == 0) {
+        alignment = 1;
+    }
+
+    vector<uint32_t> order(blocks.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&blocks](uint32_t a, uint32_t b) -> bool {
+        return (blocks[a].bytes > blocks[b].bytes);
+    });
+
+    offsets->resize(blocks.size());
+
+    uint64_t arena_bytes = 0;
+    vector<uint32_t> placed;
+    vector<pair<uint64_t, uint64_t>> conflicts; // [begin, end) of overlapped blocks that have been placed
+    placed.reserve(blocks.size());
+    conflicts.reserve(blocks.size());
+
+    for (auto x = order.begin(); x != order.end(); ++x) {
+        auto& block = blocks[*x];
+        auto bytes = Align(block.bytes, alignment);
+
+        conflicts.clear();
+        for (auto p = placed.begin(); p != placed.end(); ++p) {
+            if (IsOverlapped(block, blocks[*p])) {
+                auto begin = offsets->at(*p);
+                conflicts.push_back(make_pair(begin, begin + Align(blocks[*p].bytes, alignment)));
+            }
+        }
+        std::sort(conflicts.begin(), conflicts.end());
+
+        // lowest gap that is large enough
+        uint64_t offset = 0;
+        for (auto c = conflicts.begin(); c != conflicts.end(); ++c) {
+            if (c->first >= offset + bytes) {
+                break;
+            }
+            offset = std::max(offset, c->second);
+        }
+
+        offsets->at(*x) = offset;
+        arena_bytes = std::max(arena_bytes, offset + bytes);
+        placed.push_back(*x);
+    }
+
+    return arena_bytes;
+}
+
+uint64_t CalcPeakMemoryBytes(const vector<MemoryBlock>& blocks) {
+    // bytes allocated/freed at each step
+    map<uint32_t, int64_t> events;
+    for (auto b = blocks.begin(); b != blocks.end(); ++b) {
+        events[b->first] += b->bytes;
+        events[b->last + 1] -= b->bytes;
+    }
+
+    int64_t cur = 0, peak = 0;
+    for (auto e = events.begin(); e != events.end(); ++e) {
+        cur += e->second;
+        peak = std::max(peak, cur);
+    }
+
+    return peak;
+}
+
+}}} // namespace ppl::nn::utils
@@ -0,0 +1,47 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_UTILS_MEMORY_PLANNER_H_
+#define _ST_HPC_PPL_NN_UTILS_MEMORY_PLANNER_H_
+
+#include <stdint.h>
+#include <vector>
+
+namespace ppl { namespace nn { namespace utils {
+
+/** a buffer of `bytes` bytes that is alive during steps [first, last]. */
+struct MemoryBlock final {
+    uint64_t bytes;
+    uint32_t first;
+    uint32_t last;
+};
+
+/**
+   @brief assigns each block an offset in one arena so that blocks alive at the same time do not overlap.
+   blocks are placed from the largest to the smallest, each at the lowest offset that fits.
+   @param offsets offset of each block, aligned to `alignment`
+   @return size of the arena
+*/
+uint64_t PlanMemoryBlocks(const std::vector<MemoryBlock>& blocks, uint64_t alignment,
+                          std::vector<uint64_t>* offsets);
+
+/** @brief max sum of bytes of blocks alive at the same step, which is the lower bound of any plan. */
+uint64_t CalcPeakMemoryBytes(const std::vector<MemoryBlock>& blocks);
+
+}}} // namespace ppl::nn::utils
+
+#endif
@@ -20,7 +20,9 @@
 
 #include "ppl/nn/engines/engine_impl.h"
 #include "ppl/nn/optimizers/graph_partitioner.h"
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace ppl { namespace nn { namespace utils {
@@ -28,6 +30,12 @@ namespace ppl { namespace nn { namespace utils {
 struct SharedResource {
     std::vector<EngineImpl*> engines; // engines are allocated/freed by the caller
     std::shared_ptr<GraphPartitioner> graph_partitioner;
+
+    /*
+      input name => dims declared when the graph was built. graphs are specialized for these dims and runtimes
+      refuse inputs of other shapes. empty if all inputs are dynamic.
+    */
+    std::map<std::string, std::vector<int64_t>> fixed_input_dims;
 };
 
 }}} // namespace ppl::nn::utils
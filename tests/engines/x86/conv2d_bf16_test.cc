@@ -0,0 +1,148 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "ppl/kernel/x86/bf16/conv2d.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <random>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+using ppl::nn::TensorShape;
+
+static void Conv2dRefFp32(const conv2d_bf16_param& p, int64_t batch, int64_t src_h, int64_t src_w, int64_t dst_h,
+                          int64_t dst_w, const float* src, const float* filter, const float* bias, float* dst) {
+    const int64_t ic_per_gp = p.channels / p.group;
+    const int64_t oc_per_gp = p.num_output / p.group;
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t oc = 0; oc < p.num_output; ++oc) {
+            const int64_t g = oc / oc_per_gp;
+            for (int64_t oh = 0; oh < dst_h; ++oh) {
+                for (int64_t ow = 0; ow < dst_w; ++ow) {
+                    double sum = bias[oc];
+                    for (int64_t ic = 0; ic < ic_per_gp; ++ic) {
+                        for (int64_t kh = 0; kh < p.kernel_h; ++kh) {
+                            const int64_t ih = oh * p.stride_h - p.pad_h + kh * p.dilation_h;
+                            for (int64_t kw = 0; kw < p.kernel_w; ++kw) {
+                                const int64_t iw = ow * p.stride_w - p.pad_w + kw * p.dilation_w;
+                                if (ih < 0 || ih >= src_h || iw < 0 || iw >= src_w) {
+                                    continue;
+                                }
+                                sum += src[((b * p.channels + g * ic_per_gp + ic) * src_h + ih) * src_w + iw] *
+                                    filter[((oc * ic_per_gp + ic) * p.kernel_h + kh) * p.kernel_w + kw];
+                            }
+                        }
+                    }
+                    if (p.fuse_flag & (conv_fuse_flag::RELU | conv_fuse_flag::RELU6)) {
+                        sum = max(sum, 0.0);
+                    }
+                    if (p.fuse_flag & conv_fuse_flag::RELU6) {
+                        sum = min(sum, 6.0);
+                    }
+                    dst[((b * p.num_output + oc) * dst_h + oh) * dst_w + ow] = sum;
+                }
+            }
+        }
+    }
+}
+
+static void TestConv2dBf16(const conv2d_bf16_param& param, int64_t batch, int64_t src_h, int64_t src_w) {
+    const int64_t dst_h = (src_h + 2 * param.pad_h - param.dilation_h * (param.kernel_h - 1) - 1) / param.stride_h + 1;
+    const int64_t dst_w = (src_w + 2 * param.pad_w - param.dilation_w * (param.kernel_w - 1) - 1) / param.stride_w + 1;
+    const int64_t K = param.channels / param.group * param.kernel_h * param.kernel_w;
+
+    mt19937 rng(1357);
+    uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    vector<float> src(batch * param.channels * src_h * src_w);
+    vector<float> filter(param.num_output * K);
+    vector<float> bias(param.num_output);
+    for (auto& v : src) {
+        v = dist(rng);
+    }
+    for (auto& v : filter) {
+        v = dist(rng);
+    }
+    for (auto& v : bias) {
+        v = dist(rng);
+    }
+
+    vector<float> ref(batch * param.num_output * dst_h * dst_w);
+    Conv2dRefFp32(param, batch, src_h, src_w, dst_h, dst_w, src.data(), filter.data(), bias.data(), ref.data());
+
+    // bf16 keeps 8 bits of mantissa, each product is off by at most about 2^-8 of |x| * |w| <= 1
+    const float tolerance = K * 1.0f / 128.0f + 1e-5f;
+
+    TensorShape src_shape, dst_shape;
+    src_shape.SetDataType(DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    src_shape.Reshape({batch, param.channels, src_h, src_w});
+    dst_shape.SetDataType(DATATYPE_FLOAT32);
+    dst_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    dst_shape.Reshape({batch, param.num_output, dst_h, dst_w});
+
+    GenericCpuAllocator ar;
+    const gemm_bf16_isa_t best_isa = gemm_bf16_select_isa(GetCpuISA());
+    for (gemm_bf16_isa_t isa = gemm_bf16_isa::REF; isa <= best_isa; ++isa) {
+        conv2d_bf16_manager mgr(param, isa, &ar);
+        ASSERT_EQ(RC_SUCCESS, mgr.gen_cvt_weights(filter.data(), bias.data()));
+
+        vector<uint8_t> tmp(mgr.cal_temp_buffer_size(src_shape, dst_shape));
+        vector<float> dst(ref.size(), 0.0f);
+        ASSERT_EQ(RC_SUCCESS, mgr.execute(src_shape, src.data(), dst_shape, dst.data(), tmp.data()));
+
+        double err_sum = 0.0, ref_sum = 0.0;
+        for (uint64_t i = 0; i < ref.size(); ++i) {
+            EXPECT_NEAR(ref[i], dst[i], tolerance) << "isa " << isa << " at " << i;
+            err_sum += fabs(ref[i] - dst[i]);
+            ref_sum += fabs(ref[i]);
+        }
+        EXPECT_LT(err_sum / ref_sum, 0.01) << "isa " << isa;
+    }
+}
+
+static conv2d_bf16_param MakeParam(int64_t channels, int64_t num_output, int64_t kernel, int64_t stride, int64_t pad,
+                                   int64_t group, conv_fuse_flag_t fuse_flag) {
+    conv2d_bf16_param param;
+    param.kernel_h = kernel;
+    param.kernel_w = kernel;
+    param.stride_h = stride;
+    param.stride_w = stride;
+    param.dilation_h = 1;
+    param.dilation_w = 1;
+    param.pad_h = pad;
+    param.pad_w = pad;
+    param.channels = channels;
+    param.num_output = num_output;
+    param.group = group;
+    param.fuse_flag = fuse_flag;
+    return param;
+}
+
+TEST(Conv2dBf16Test, compare_with_fp32) {
+    TestConv2dBf16(MakeParam(16, 32, 3, 1, 1, 1, 0), 1, 14, 14);
+    TestConv2dBf16(MakeParam(3, 17, 3, 2, 1, 1, conv_fuse_flag::RELU), 2, 15, 13);
+    TestConv2dBf16(MakeParam(24, 40, 1, 1, 0, 1, conv_fuse_flag::RELU6), 1, 7, 9);
+    TestConv2dBf16(MakeParam(8, 12, 3, 1, 0, 4, 0), 1, 10, 10);
+}
+
+#endif
@@ -0,0 +1,162 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "ppl/kernel/x86/int8/conv2d.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <random>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+using ppl::nn::TensorShape;
+
+static void Conv2dRefFp32(const conv2d_int8_param& p, int64_t batch, int64_t src_h, int64_t src_w, int64_t dst_h,
+                          int64_t dst_w, const float* src, const float* filter, const float* bias, float* dst) {
+    const int64_t ic_per_gp = p.channels / p.group;
+    const int64_t oc_per_gp = p.num_output / p.group;
+    for (int64_t b = 0; b < batch; ++b) {
+        for (int64_t oc = 0; oc < p.num_output; ++oc) {
+            const int64_t g = oc / oc_per_gp;
+            for (int64_t oh = 0; oh < dst_h; ++oh) {
+                for (int64_t ow = 0; ow < dst_w; ++ow) {
+                    double sum = bias[oc];
+                    for (int64_t ic = 0; ic < ic_per_gp; ++ic) {
+                        for (int64_t kh = 0; kh < p.kernel_h; ++kh) {
+                            const int64_t ih = oh * p.stride_h - p.pad_h + kh * p.dilation_h;
+                            for (int64_t kw = 0; kw < p.kernel_w; ++kw) {
+                                const int64_t iw = ow * p.stride_w - p.pad_w + kw * p.dilation_w;
+                                if (ih < 0 || ih >= src_h || iw < 0 || iw >= src_w) {
+                                    continue;
+                                }
+                                sum += src[((b * p.channels + g * ic_per_gp + ic) * src_h + ih) * src_w + iw] *
+                                    filter[((oc * ic_per_gp + ic) * p.kernel_h + kh) * p.kernel_w + kw];
+                            }
+                        }
+                    }
+                    dst[((b * p.num_output + oc) * dst_h + oh) * dst_w + ow] = sum;
+                }
+            }
+        }
+    }
+}
+
+static void TestConv2dInt8(const conv2d_int8_param& base_param, int64_t batch, int64_t src_h, int64_t src_w) {
+    conv2d_int8_param param = base_param;
+    const int64_t dst_h = (src_h + 2 * param.pad_h - param.dilation_h * (param.kernel_h - 1) - 1) / param.stride_h + 1;
+    const int64_t dst_w = (src_w + 2 * param.pad_w - param.dilation_w * (param.kernel_w - 1) - 1) / param.stride_w + 1;
+    const int64_t K = param.channels / param.group * param.kernel_h * param.kernel_w;
+
+    mt19937 rng(1234);
+    uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    vector<float> src(batch * param.channels * src_h * src_w);
+    vector<float> filter(param.num_output * K);
+    vector<float> bias(param.num_output);
+    for (auto& v : src) {
+        v = dist(rng);
+    }
+    for (auto& v : filter) {
+        v = dist(rng);
+    }
+    for (auto& v : bias) {
+        v = dist(rng);
+    }
+
+    float src_abs_max = 0.0f;
+    for (auto v : src) {
+        src_abs_max = max(src_abs_max, fabsf(v));
+    }
+    param.src_scale = src_abs_max / 127.0f;
+
+    vector<float> ref(batch * param.num_output * dst_h * dst_w);
+    Conv2dRefFp32(param, batch, src_h, src_w, dst_h, dst_w, src.data(), filter.data(), bias.data(), ref.data());
+
+    // rounding error of each product is at most half a quantization step of either operand
+    vector<float> tolerance(param.num_output);
+    for (int64_t oc = 0; oc < param.num_output; ++oc) {
+        float w_abs_max = 0.0f, w_abs_sum = 0.0f;
+        for (int64_t k = 0; k < K; ++k) {
+            w_abs_max = max(w_abs_max, fabsf(filter[oc * K + k]));
+            w_abs_sum += fabsf(filter[oc * K + k]);
+        }
+        const float w_scale = w_abs_max / 127.0f;
+        tolerance[oc] = 0.5f * param.src_scale * w_abs_sum + 0.5f * w_scale * src_abs_max * K +
+            0.25f * param.src_scale * w_scale * K + 1e-4f;
+    }
+
+    TensorShape src_shape, dst_shape;
+    src_shape.SetDataType(DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    src_shape.Reshape({batch, param.channels, src_h, src_w});
+    dst_shape.SetDataType(DATATYPE_FLOAT32);
+    dst_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    dst_shape.Reshape({batch, param.num_output, dst_h, dst_w});
+
+    GenericCpuAllocator ar;
+    const gemm_s8u8_isa_t best_isa = gemm_s8u8_select_isa(GetCpuISA());
+    for (gemm_s8u8_isa_t isa = gemm_s8u8_isa::REF; isa <= best_isa; ++isa) {
+        conv2d_int8_manager mgr(param, isa, &ar);
+        ASSERT_EQ(RC_SUCCESS, mgr.gen_cvt_weights(filter.data(), bias.data()));
+
+        vector<uint8_t> tmp(mgr.cal_temp_buffer_size(src_shape, dst_shape));
+        vector<float> dst(ref.size(), 0.0f);
+        ASSERT_EQ(RC_SUCCESS, mgr.execute(src_shape, src.data(), dst_shape, dst.data(), tmp.data()));
+
+        double err_sum = 0.0, ref_sum = 0.0;
+        for (uint64_t i = 0; i < ref.size(); ++i) {
+            const int64_t oc = i / (dst_h * dst_w) % param.num_output;
+            EXPECT_NEAR(ref[i], dst[i], tolerance[oc]) << "isa " << isa << " at " << i;
+            err_sum += fabs(ref[i] - dst[i]);
+            ref_sum += fabs(ref[i]);
+        }
+        // the bound above is the worst case. on average int8 should be within a few percent of fp32
+        EXPECT_LT(err_sum / ref_sum, 0.02) << "isa " << isa;
+    }
+}
+
+static conv2d_int8_param MakeParam(int64_t channels, int64_t num_output, int64_t kernel, int64_t stride, int64_t pad,
+                                   int64_t group) {
+    conv2d_int8_param param;
+    param.kernel_h = kernel;
+    param.kernel_w = kernel;
+    param.stride_h = stride;
+    param.stride_w = stride;
+    param.dilation_h = 1;
+    param.dilation_w = 1;
+    param.pad_h = pad;
+    param.pad_w = pad;
+    param.channels = channels;
+    param.num_output = num_output;
+    param.group = group;
+    param.src_scale = 1.0f;
+    param.fuse_flag = 0;
+    return param;
+}
+
+TEST(Conv2dInt8Test, compare_with_fp32) {
+    TestConv2dInt8(MakeParam(16, 32, 3, 1, 1, 1), 1, 14, 14);
+    TestConv2dInt8(MakeParam(3, 17, 3, 2, 1, 1), 2, 15, 13);
+    TestConv2dInt8(MakeParam(24, 40, 1, 1, 0, 1), 1, 7, 9);
+    TestConv2dInt8(MakeParam(8, 12, 3, 1, 0, 4), 1, 10, 10);
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/kernel/x86/fp32/conv2d.h"
+#include "ppl/kernel/x86/fp32/reorder.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <memory>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+using ppl::nn::TensorShape;
+using ppl::nn::test::RandomData;
+
+// runs `algo_type` on n16cx tensors and compares the result with conv2d_ref_fp32
+static void TestConv2dWinograd(conv2d_fp32_algo_t algo_type, isa_t isa, const conv2d_fp32_param& param,
+                               int64_t batch, int64_t src_h, int64_t src_w) {
+    const int64_t dst_h = (src_h + 2 * param.pad_h - param.dilation_h * (param.kernel_h - 1) - 1) / param.stride_h + 1;
+    const int64_t dst_w = (src_w + 2 * param.pad_w - param.dilation_w * (param.kernel_w - 1) - 1) / param.stride_w + 1;
+    const int64_t K = param.channels / param.group * param.kernel_h * param.kernel_w;
+
+    TensorShape src_shape, dst_shape;
+    src_shape.SetDataType(DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    src_shape.Reshape({batch, param.channels, src_h, src_w});
+    dst_shape.SetDataType(DATATYPE_FLOAT32);
+    dst_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    dst_shape.Reshape({batch, param.num_output, dst_h, dst_w});
+    TensorShape src_trans_shape = src_shape, dst_trans_shape = dst_shape;
+    src_trans_shape.SetDataFormat(DATAFORMAT_N16CX);
+    dst_trans_shape.SetDataFormat(DATAFORMAT_N16CX);
+
+    const auto src = RandomData(src_shape.GetElementsExcludingPadding(), 1);
+    const auto sum_src = RandomData(dst_shape.GetElementsExcludingPadding(), 2);
+    const auto filter = RandomData(param.num_output * K, 3);
+    const auto bias = RandomData(param.num_output, 4);
+
+    vector<float> ref(dst_shape.GetElementsExcludingPadding());
+    ASSERT_EQ(RC_SUCCESS,
+              conv2d_ref_fp32(&src_shape, &dst_shape, &dst_shape, src.data(), sum_src.data(), filter.data(),
+                              bias.data(), param, ref.data()));
+
+    GenericCpuAllocator ar;
+    const conv2d_fp32_algo_info algo_info = {algo_type, isa, DATAFORMAT_N16CX, DATAFORMAT_N16CX};
+    unique_ptr<conv2d_fp32_manager> mgr(conv2d_algo_selector::gen_algo(param, algo_info, &ar));
+    ASSERT_NE(nullptr, mgr.get());
+    ASSERT_TRUE(mgr->is_supported());
+    ASSERT_EQ(RC_SUCCESS, mgr->gen_cvt_weights(filter.data(), bias.data()));
+
+    vector<float> src_trans(src_trans_shape.GetElementsIncludingPadding());
+    vector<float> sum_src_trans(dst_trans_shape.GetElementsIncludingPadding());
+    vector<float> dst_trans(dst_trans_shape.GetElementsIncludingPadding());
+    vector<float> dst(ref.size());
+    ASSERT_EQ(RC_SUCCESS, reorder_ndarray_n16cx_fp32(&src_shape, src.data(), src_trans.data()));
+    ASSERT_EQ(RC_SUCCESS, reorder_ndarray_n16cx_fp32(&dst_shape, sum_src.data(), sum_src_trans.data()));
+
+    unique_ptr<conv2d_fp32_executor> exe(mgr->gen_executor());
+    exe->set_src_shape(&src_shape);
+    exe->set_dst_shape(&dst_shape);
+    exe->set_sum_src_shape(&dst_shape);
+    ASSERT_EQ(RC_SUCCESS, exe->prepare());
+    vector<uint8_t> tmp(exe->cal_temp_buffer_size());
+    exe->set_temp_buffer(tmp.data());
+    exe->set_src(src_trans.data());
+    exe->set_sum_src(sum_src_trans.data());
+    exe->set_dst(dst_trans.data());
+    ASSERT_EQ(RC_SUCCESS, exe->execute());
+    ASSERT_EQ(RC_SUCCESS, reorder_n16cx_ndarray_fp32(&dst_trans_shape, dst_trans.data(), dst.data()));
+    mgr->release_cvt_weights();
+
+    // transforms of larger tiles amplify rounding errors, which still stay within about 2e-6 of each |x| * |w| <= 1
+    const float tolerance = K * 2e-6f + 1e-4f;
+    double err_sum = 0.0, ref_sum = 0.0;
+    for (uint64_t i = 0; i < ref.size(); ++i) {
+        EXPECT_NEAR(ref[i], dst[i], tolerance) << "algo " << algo_type << " isa " << isa << " at " << i;
+        err_sum += fabs(ref[i] - dst[i]);
+        ref_sum += fabs(ref[i]);
+    }
+    EXPECT_LT(err_sum / ref_sum, 1e-5) << "algo " << algo_type << " isa " << isa;
+}
+
+static conv2d_fp32_param MakeParam(int64_t channels, int64_t num_output, int64_t kernel, int64_t pad, int64_t group,
+                                   conv_fuse_flag_t fuse_flag) {
+    conv2d_fp32_param param;
+    param.kernel_h = kernel;
+    param.kernel_w = kernel;
+    param.stride_h = 1;
+    param.stride_w = 1;
+    param.dilation_h = 1;
+    param.dilation_w = 1;
+    param.pad_h = pad;
+    param.pad_w = pad;
+    param.channels = channels;
+    param.num_output = num_output;
+    param.group = group;
+    param.fuse_flag = fuse_flag;
+    return param;
+}
+
+static vector<isa_t> GetWinogradISAs() {
+    vector<isa_t> isas;
+    if (GetCpuISA() & ISA_X86_FMA) {
+        isas.push_back(ISA_X86_FMA);
+    }
+#ifdef PPL_USE_X86_AVX512
+    if (GetCpuISA() & ISA_X86_AVX512) {
+        isas.push_back(ISA_X86_AVX512);
+    }
+#endif
+    return isas;
+}
+
+// output sizes are not multiples of the tiles, so that partial tiles at the bottom and right are covered.
+// winograd needs more than 16 (fma) or 28 (avx512) input channels per group
+static void TestConv2dWinogradAlgo(conv2d_fp32_algo_t algo_type, int64_t kernel) {
+    const int64_t pad = kernel / 2;
+    auto isas = GetWinogradISAs();
+    for (auto isa = isas.begin(); isa != isas.end(); ++isa) {
+        TestConv2dWinograd(algo_type, *isa, MakeParam(32, 32, kernel, pad, 1, 0), 1, 14, 14);
+        TestConv2dWinograd(algo_type, *isa, MakeParam(37, 17, kernel, pad, 1, 0), 2, 15, 13);
+        TestConv2dWinograd(algo_type, *isa, MakeParam(33, 24, kernel, 0, 1, conv_fuse_flag::RELU), 1, 17, 11);
+        TestConv2dWinograd(algo_type, *isa, MakeParam(64, 64, kernel, pad, 2, conv_fuse_flag::SUM), 1, 9, 23);
+        TestConv2dWinograd(algo_type, *isa,
+                           MakeParam(48, 16, kernel, 1, 1, conv_fuse_flag::SUM | conv_fuse_flag::RELU6), 1, 11, 7);
+    }
+}
+
+TEST(Conv2dWinogradTest, b4f3_compare_with_ref) {
+    TestConv2dWinogradAlgo(conv2d_fp32_algo::WINOGRAD_B4F3, 3);
+}
+
+TEST(Conv2dWinogradTest, b6f3_compare_with_ref) {
+    TestConv2dWinogradAlgo(conv2d_fp32_algo::WINOGRAD_B6F3, 3);
+}
+
+TEST(Conv2dWinogradTest, b2f5_compare_with_ref) {
+    TestConv2dWinogradAlgo(conv2d_fp32_algo::WINOGRAD_B2F5, 5);
+}
+
+TEST(Conv2dWinogradTest, b4f5_compare_with_ref) {
+    TestConv2dWinogradAlgo(conv2d_fp32_algo::WINOGRAD_B4F5, 5);
+}
+
+#endif
@@ -0,0 +1,225 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/params/onnx/convtranspose_param.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+static const int64_t g_batch = 2;
+static const int64_t g_src_h = 6;
+static const int64_t g_src_w = 5;
+
+/*
+   x: (g_batch, channels, g_src_h, g_src_w), w: (channels, num_output / group, kernel, kernel).
+   `activation` is "", "Relu" or "Relu6", which is a Clip(0, 6) after the ConvTranspose.
+*/
+struct ConvTransposeCase final {
+    int64_t channels;
+    int64_t num_output;
+    int64_t kernel;
+    int32_t stride;
+    int32_t pad;
+    int32_t dilation;
+    int32_t output_padding;
+    int64_t group;
+    bool has_bias;
+    string activation;
+
+    int64_t GetDstH() const {
+        return stride * (g_src_h - 1) + output_padding + (kernel - 1) * dilation + 1 - 2 * pad;
+    }
+    int64_t GetDstW() const {
+        return stride * (g_src_w - 1) + output_padding + (kernel - 1) * dilation + 1 - 2 * pad;
+    }
+    vector<int64_t> GetXDims() const {
+        return {g_batch, channels, g_src_h, g_src_w};
+    }
+    vector<int64_t> GetWDims() const {
+        return {channels, num_output / group, kernel, kernel};
+    }
+};
+
+static vector<float> ConvTransposeRef(const ConvTransposeCase& c, const vector<float>& x, const vector<float>& w,
+                                      const vector<float>& b) {
+    const int64_t dst_h = c.GetDstH(), dst_w = c.GetDstW();
+    const int64_t ic_per_group = c.channels / c.group;
+    const int64_t oc_per_group = c.num_output / c.group;
+    vector<float> y(g_batch * c.num_output * dst_h * dst_w);
+    for (int64_t n = 0; n < g_batch; ++n) {
+        for (int64_t oc = 0; oc < c.num_output; ++oc) {
+            float* dst = y.data() + (n * c.num_output + oc) * dst_h * dst_w;
+            fill(dst, dst + dst_h * dst_w, c.has_bias ? b[oc] : 0.0f);
+            const int64_t g = oc / oc_per_group;
+            for (int64_t ic = g * ic_per_group; ic < (g + 1) * ic_per_group; ++ic) {
+                for (int64_t ih = 0; ih < g_src_h; ++ih) {
+                    for (int64_t iw = 0; iw < g_src_w; ++iw) {
+                        const float xv = x[((n * c.channels + ic) * g_src_h + ih) * g_src_w + iw];
+                        for (int64_t kh = 0; kh < c.kernel; ++kh) {
+                            for (int64_t kw = 0; kw < c.kernel; ++kw) {
+                                const int64_t oh = ih * c.stride - c.pad + kh * c.dilation;
+                                const int64_t ow = iw * c.stride - c.pad + kw * c.dilation;
+                                if (oh < 0 || oh >= dst_h || ow < 0 || ow >= dst_w) {
+                                    continue;
+                                }
+                                const float wv =
+                                    w[((ic * oc_per_group + oc % oc_per_group) * c.kernel + kh) * c.kernel + kw];
+                                dst[oh * dst_w + ow] += xv * wv;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (auto& v : y) {
+        if (c.activation == "Relu") {
+            v = max(v, 0.0f);
+        } else if (c.activation == "Relu6") {
+            v = min(max(v, 0.0f), 6.0f);
+        }
+    }
+    return y;
+}
+
+/*
+   runs x -> ConvTranspose [-> activation] -> y. constant weights select the N16CX kernel when possible, into which
+   the activation is fused, and weights as inputs keep the NDARRAY kernel and the activation node.
+*/
+static void RunConvTranspose(const ConvTransposeCase& c, bool constant_weights, const vector<float>& x,
+                             const vector<float>& w, const vector<float>& b, vector<float>* y) {
+    auto param = make_shared<ppl::nn::common::ConvTransposeParam>();
+    param->group = c.group;
+    param->kernel_shape = {(int32_t)c.kernel, (int32_t)c.kernel};
+    param->strides = {c.stride, c.stride};
+    param->dilations = {c.dilation, c.dilation};
+    param->pads = {c.pad, c.pad, c.pad, c.pad};
+    param->output_padding = {c.output_padding, c.output_padding};
+
+    X86GraphRunner runner("conv_transpose");
+    const vector<int64_t> b_dims{c.num_output};
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("x", DATATYPE_FLOAT32, c.GetXDims()));
+    if (constant_weights) {
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("w", DATATYPE_FLOAT32, c.GetWDims(), w.data()));
+        if (c.has_bias) {
+            ASSERT_EQ(RC_SUCCESS, runner.AddConstant("b", DATATYPE_FLOAT32, b_dims, b.data()));
+        }
+    } else {
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput("w", DATATYPE_FLOAT32, c.GetWDims()));
+        if (c.has_bias) {
+            ASSERT_EQ(RC_SUCCESS, runner.AddInput("b", DATATYPE_FLOAT32, b_dims));
+        }
+    }
+
+    vector<string> inputs{"x", "w"};
+    if (c.has_bias) {
+        inputs.push_back("b");
+    }
+    const string conv_output = c.activation.empty() ? "y" : "conv_out";
+    ASSERT_EQ(RC_SUCCESS,
+              runner.AddNode("conv_transpose", ir::Node::Type("", "ConvTranspose", 11), inputs, {conv_output}, param));
+    if (c.activation == "Relu") {
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("relu", ir::Node::Type("", "Relu", 6), {conv_output}, {"y"}));
+    } else if (c.activation == "Relu6") {
+        const float min_value = 0.0f, max_value = 6.0f;
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("min", DATATYPE_FLOAT32, {}, &min_value));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("max", DATATYPE_FLOAT32, {}, &max_value));
+        ASSERT_EQ(RC_SUCCESS,
+                  runner.AddNode("relu6", ir::Node::Type("", "Clip", 11), {conv_output, "min", "max"}, {"y"}));
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.AddOutput("y"));
+    ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+    const bool expect_n16cx = constant_weights && c.group == 1 && (GetCpuISA() & ISA_X86_FMA);
+    auto graph = runner.GetGraph();
+    EXPECT_EQ(expect_n16cx, HasNode(graph, "ppl", "Reorder"));
+    if (c.activation == "Relu") {
+        EXPECT_EQ(!expect_n16cx, HasNode(graph, "", "Relu"));
+    } else if (c.activation == "Relu6") {
+        EXPECT_EQ(!expect_n16cx, HasNode(graph, "", "Clip"));
+    }
+
+    ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x", c.GetXDims(), x.data()));
+    if (!constant_weights) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("w", c.GetWDims(), w.data()));
+        if (c.has_bias) {
+            ASSERT_EQ(RC_SUCCESS, runner.SetInputData("b", b_dims, b.data()));
+        }
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.Run());
+
+    vector<int64_t> y_dims;
+    ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", y, &y_dims));
+    EXPECT_EQ((vector<int64_t>{g_batch, c.num_output, c.GetDstH(), c.GetDstW()}), y_dims);
+}
+
+static void TestConvTranspose(const ConvTransposeCase& c) {
+    auto x = RandomData(g_batch * c.channels * g_src_h * g_src_w, 1);
+    auto w = RandomData(c.channels * (c.num_output / c.group) * c.kernel * c.kernel, 2);
+    auto b = RandomData(c.num_output, 3);
+    auto expected = ConvTransposeRef(c, x, w, b);
+
+    for (bool constant_weights : {true, false}) {
+        SCOPED_TRACE(constant_weights ? "constant weights" : "weights as inputs");
+        vector<float> y;
+        RunConvTranspose(c, constant_weights, x, w, b, &y);
+        ASSERT_EQ(expected.size(), y.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(expected[i], y[i], 1e-4) << "at " << i;
+        }
+    }
+}
+
+TEST(ConvTransposeTest, channels_not_multiple_of_16) {
+    TestConvTranspose({5, 7, 3, 1, 1, 1, 0, 1, true, ""});
+    TestConvTranspose({19, 35, 3, 1, 0, 1, 0, 1, false, ""});
+}
+
+TEST(ConvTransposeTest, stride) {
+    TestConvTranspose({16, 16, 4, 2, 1, 1, 0, 1, true, ""});
+    TestConvTranspose({7, 20, 3, 3, 2, 2, 0, 1, true, ""});
+}
+
+TEST(ConvTransposeTest, output_padding) {
+    TestConvTranspose({19, 17, 3, 2, 1, 1, 1, 1, true, ""});
+    TestConvTranspose({3, 9, 2, 3, 0, 1, 2, 1, false, ""});
+}
+
+TEST(ConvTransposeTest, group) {
+    TestConvTranspose({6, 10, 3, 2, 1, 1, 1, 2, true, ""});
+    TestConvTranspose({8, 4, 3, 1, 1, 1, 0, 4, false, "Relu"});
+}
+
+TEST(ConvTransposeTest, relu) {
+    TestConvTranspose({5, 7, 3, 1, 1, 1, 0, 1, true, "Relu"});
+    TestConvTranspose({19, 33, 3, 2, 1, 1, 1, 1, true, "Relu"});
+}
+
+TEST(ConvTransposeTest, relu6) {
+    TestConvTranspose({5, 7, 3, 1, 1, 1, 0, 1, true, "Relu6"});
+    TestConvTranspose({19, 33, 4, 2, 1, 2, 1, 1, true, "Relu6"});
+}
+
+#endif
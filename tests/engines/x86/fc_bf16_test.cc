@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "ppl/kernel/x86/bf16/fc.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <random>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+using ppl::nn::TensorShape;
+
+static void TestFcBf16(int64_t batch, int64_t channels, int64_t num_output, bool filter_trans, bool has_bias,
+                       bool relu) {
+    mt19937 rng(2468);
+    uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    vector<float> src(batch * channels), filter(channels * num_output), bias(num_output);
+    for (auto& v : src) {
+        v = dist(rng);
+    }
+    for (auto& v : filter) {
+        v = dist(rng);
+    }
+    for (auto& v : bias) {
+        v = dist(rng);
+    }
+
+    vector<float> ref(batch * num_output);
+    for (int64_t m = 0; m < batch; ++m) {
+        for (int64_t n = 0; n < num_output; ++n) {
+            double sum = has_bias ? bias[n] : 0.0;
+            for (int64_t k = 0; k < channels; ++k) {
+                const float w = filter_trans ? filter[n * channels + k] : filter[k * num_output + n];
+                sum += src[m * channels + k] * w;
+            }
+            ref[m * num_output + n] = (relu && sum < 0.0) ? 0.0f : sum;
+        }
+    }
+
+    fc_bf16_param param;
+    param.channels = channels;
+    param.num_output = num_output;
+    param.fuse_flag = relu ? fc_fuse_flag::RELU : fc_fuse_flag::NONE;
+
+    TensorShape src_shape;
+    src_shape.SetDataType(DATATYPE_FLOAT32);
+    src_shape.SetDataFormat(DATAFORMAT_NDARRAY);
+    src_shape.Reshape({batch, channels});
+
+    // bf16 keeps 8 bits of mantissa, each product is off by at most about 2^-8 of |x| * |w| <= 1
+    const float tolerance = channels * 1.0f / 128.0f + 1e-5f;
+
+    GenericCpuAllocator ar;
+    const gemm_bf16_isa_t best_isa = gemm_bf16_select_isa(GetCpuISA());
+    for (gemm_bf16_isa_t isa = gemm_bf16_isa::REF; isa <= best_isa; ++isa) {
+        fc_bf16_manager mgr(param, isa, &ar);
+        ASSERT_EQ(RC_SUCCESS, mgr.gen_cvt_weights(filter.data(), filter_trans, has_bias ? bias.data() : nullptr));
+
+        vector<uint8_t> tmp(mgr.cal_temp_buffer_size(src_shape));
+        vector<float> dst(ref.size(), 0.0f);
+        ASSERT_EQ(RC_SUCCESS, mgr.execute(src_shape, src.data(), dst.data(), tmp.data()));
+
+        double err_sum = 0.0, ref_sum = 0.0;
+        for (uint64_t i = 0; i < ref.size(); ++i) {
+            EXPECT_NEAR(ref[i], dst[i], tolerance) << "isa " << isa << " at " << i;
+            err_sum += fabs(ref[i] - dst[i]);
+            ref_sum += fabs(ref[i]);
+        }
+        EXPECT_LT(err_sum / ref_sum, 0.01) << "isa " << isa;
+    }
+}
+
+TEST(FcBf16Test, compare_with_fp32) {
+    TestFcBf16(1, 64, 32, true, true, false);
+    TestFcBf16(7, 100, 33, true, false, true);
+    TestFcBf16(33, 47, 70, false, true, true);
+    TestFcBf16(16, 31, 9, false, false, false);
+}
+
+#endif
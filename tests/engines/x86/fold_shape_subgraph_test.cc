@@ -0,0 +1,160 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/constant_of_shape_param.h"
+#include "ppl/nn/params/onnx/gather_param.h"
+#include "ppl/nn/params/onnx/unsqueeze_param.h"
+#include "ppl/nn/params/mmcv/mmcv_non_max_suppression_param.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+// Shape and the following ops may have been fused into ppl:Shape before the x86 engine optimizes the graph
+static bool HasShapeNode(const ir::Graph* graph) {
+    return (HasNode(graph, "", "Shape") || HasNode(graph, "ppl", "Shape"));
+}
+
+/*
+   y = Reshape(x, Concat(Unsqueeze(Gather(Shape(x), 0)), -1))
+*/
+static void BuildFlattenByShape(const vector<int64_t>& x_dims, bool specialize_input_dims, X86GraphRunner* runner) {
+    const int64_t index = 0;
+    const int64_t minus_one = -1;
+    auto gather_param = make_shared<ppl::nn::common::GatherParam>();
+    gather_param->axis = 0;
+    auto unsqueeze_param = make_shared<ppl::nn::common::UnsqueezeParam>();
+    unsqueeze_param->axes = {0};
+    auto concat_param = make_shared<ppl::nn::common::ConcatParam>();
+    concat_param->axis = 0;
+
+    ASSERT_EQ(RC_SUCCESS, runner->AddInput("x", DATATYPE_FLOAT32, x_dims));
+    ASSERT_EQ(RC_SUCCESS, runner->AddConstant("index", DATATYPE_INT64, {}, &index));
+    ASSERT_EQ(RC_SUCCESS, runner->AddConstant("minus_one", DATATYPE_INT64, {1}, &minus_one));
+    ASSERT_EQ(RC_SUCCESS, runner->AddNode("shape", ir::Node::Type("", "Shape", 1), {"x"}, {"s"}));
+    ASSERT_EQ(RC_SUCCESS,
+              runner->AddNode("gather", ir::Node::Type("", "Gather", 11), {"s", "index"}, {"n"}, gather_param));
+    ASSERT_EQ(RC_SUCCESS,
+              runner->AddNode("unsqueeze", ir::Node::Type("", "Unsqueeze", 11), {"n"}, {"n_1d"}, unsqueeze_param));
+    ASSERT_EQ(RC_SUCCESS,
+              runner->AddNode("concat", ir::Node::Type("", "Concat", 11), {"n_1d", "minus_one"}, {"new_shape"},
+                              concat_param));
+    ASSERT_EQ(RC_SUCCESS, runner->AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"x", "new_shape"}, {"y"}));
+    ASSERT_EQ(RC_SUCCESS, runner->AddOutput("y"));
+    ASSERT_EQ(RC_SUCCESS, runner->Build(X86EngineOptions(), specialize_input_dims));
+}
+
+TEST(FoldShapeSubgraphTest, fold_shape_of_declared_input) {
+    const vector<int64_t> x_dims = {2, 3, 4};
+    vector<float> x(24);
+    for (uint32_t i = 0; i < x.size(); ++i) {
+        x[i] = (float)i;
+    }
+
+    X86GraphRunner runner("fold");
+    BuildFlattenByShape(x_dims, true, &runner);
+    ASSERT_TRUE(runner.GetRuntime() != nullptr);
+    EXPECT_FALSE(HasShapeNode(runner.GetGraph()));
+    EXPECT_FALSE(HasNode(runner.GetGraph(), "", "Gather"));
+    EXPECT_FALSE(HasNode(runner.GetGraph(), "", "Concat"));
+    EXPECT_TRUE(HasNode(runner.GetGraph(), "", "Reshape"));
+
+    ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x", x_dims, x.data()));
+    ASSERT_EQ(RC_SUCCESS, runner.Run());
+    vector<float> y;
+    vector<int64_t> y_dims;
+    ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", &y, &y_dims));
+    EXPECT_EQ(vector<int64_t>({2, 12}), y_dims);
+    EXPECT_EQ(x, y);
+}
+
+// shapes are folded only if the graph is built for declared input dims, which are checked by Run()
+TEST(FoldShapeSubgraphTest, reject_inputs_of_other_shapes) {
+    const vector<int64_t> x_dims = {2, 3, 4};
+    const vector<int64_t> other_dims = {3, 3, 4};
+    const vector<float> x(36, 1.0f);
+
+    for (int specialized = 0; specialized < 2; ++specialized) {
+        X86GraphRunner runner("fold");
+        BuildFlattenByShape(x_dims, specialized, &runner);
+        ASSERT_TRUE(runner.GetRuntime() != nullptr);
+        EXPECT_EQ(!specialized, HasShapeNode(runner.GetGraph()));
+
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x", other_dims, x.data()));
+        if (specialized) {
+            EXPECT_EQ(RC_INVALID_VALUE, runner.Run());
+            continue;
+        }
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+        vector<float> y;
+        vector<int64_t> y_dims;
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", &y, &y_dims));
+        EXPECT_EQ(vector<int64_t>({3, 12}), y_dims);
+    }
+}
+
+/*
+   y = ConstantOfShape(Shape(mmcv:NonMaxSuppression(boxes, scores)))
+   dims of the output of NonMaxSuppression depend on data of its inputs, so that Shape must not be folded.
+*/
+TEST(FoldShapeSubgraphTest, keep_shape_of_data_dependent_output) {
+    const float one = 1.0f;
+    auto nms_param = make_shared<ppl::nn::common::MMCVNMSParam>();
+    nms_param->iou_threshold = 0.5f;
+    nms_param->offset = 0;
+    auto constant_param = make_shared<ppl::nn::common::ConstantOfShapeParam>();
+    constant_param->data_type = DATATYPE_FLOAT32;
+    constant_param->dims = {1};
+    constant_param->data.assign((const char*)&one, sizeof(one));
+
+    X86GraphRunner runner("nms");
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("boxes", DATATYPE_FLOAT32, {3, 4}));
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("scores", DATATYPE_FLOAT32, {3}));
+    ASSERT_EQ(RC_SUCCESS,
+              runner.AddNode("nms", ir::Node::Type("mmcv", "NonMaxSuppression", 1), {"boxes", "scores"}, {"indices"},
+                             nms_param));
+    ASSERT_EQ(RC_SUCCESS, runner.AddNode("shape", ir::Node::Type("", "Shape", 1), {"indices"}, {"s"}));
+    ASSERT_EQ(RC_SUCCESS,
+              runner.AddNode("fill", ir::Node::Type("", "ConstantOfShape", 9), {"s"}, {"y"}, constant_param));
+    ASSERT_EQ(RC_SUCCESS, runner.AddOutput("y"));
+    ASSERT_EQ(RC_SUCCESS, runner.AddOutput("indices"));
+    ASSERT_EQ(RC_SUCCESS, runner.Build(X86EngineOptions(), true));
+    EXPECT_TRUE(HasShapeNode(runner.GetGraph()));
+
+    const vector<float> scores = {0.9f, 0.8f, 0.7f};
+    const vector<float> disjoint_boxes = {0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5};
+    const vector<float> overlapped_boxes = {0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1};
+    const vector<float>* boxes[] = {&disjoint_boxes, &overlapped_boxes};
+    const int64_t expected_counts[] = {3, 1};
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("boxes", {3, 4}, boxes[i]->data()));
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("scores", {3}, scores.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+        vector<float> y;
+        vector<int64_t> y_dims;
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", &y, &y_dims));
+        EXPECT_EQ(vector<int64_t>({expected_counts[i]}), y_dims);
+    }
+}
+
+#endif
@@ -0,0 +1,181 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/params/onnx/softmax_param.h"
+#include "ppl/nn/params/onnx/reduce_param.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+/*
+   y = MatMul(Softmax(Add(Div(MatMul(q, kt), 4), mask)), v)
+   runs the graph with and without FuseAttention and returns whether it has been fused.
+*/
+static void TestFuseAttention(const vector<int64_t>& q_dims, const vector<int64_t>& kt_dims,
+                              const vector<int64_t>& v_dims, const vector<int64_t>& mask_dims, bool expect_fused) {
+    const float divisor = 4.0f;
+    auto q = RandomData(q_dims, 1);
+    auto kt = RandomData(kt_dims, 2);
+    auto v = RandomData(v_dims, 3);
+    auto mask = RandomData(mask_dims, 4);
+
+    vector<float> outputs[2];
+    vector<int64_t> output_dims[2];
+    for (int fused = 0; fused < 2; ++fused) {
+        unique_ptr<X86OptRuleDisabler> disabler;
+        if (!fused) {
+            disabler.reset(new X86OptRuleDisabler("AfterLayoutOptimize", "FuseAttention"));
+        }
+
+        X86GraphRunner runner("attention");
+        auto softmax_param = make_shared<ppl::nn::common::SoftmaxParam>();
+        softmax_param->axis = -1;
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput("q", DATATYPE_FLOAT32, q_dims));
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput("kt", DATATYPE_FLOAT32, kt_dims));
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput("v", DATATYPE_FLOAT32, v_dims));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("mask", DATATYPE_FLOAT32, mask_dims, mask.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("divisor", DATATYPE_FLOAT32, {}, &divisor));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("qk", ir::Node::Type("", "MatMul", 11), {"q", "kt"}, {"qk_out"}));
+        ASSERT_EQ(RC_SUCCESS,
+                  runner.AddNode("scale", ir::Node::Type("", "Div", 11), {"qk_out", "divisor"}, {"scale_out"}));
+        ASSERT_EQ(RC_SUCCESS,
+                  runner.AddNode("add_mask", ir::Node::Type("", "Add", 11), {"scale_out", "mask"}, {"scores"}));
+        ASSERT_EQ(RC_SUCCESS,
+                  runner.AddNode("softmax", ir::Node::Type("", "Softmax", 11), {"scores"}, {"prob"}, softmax_param));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("pv", ir::Node::Type("", "MatMul", 11), {"prob", "v"}, {"y"}));
+        ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+        EXPECT_EQ(fused && expect_fused, HasNode(runner.GetGraph(), "ppl", "Attention"));
+
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("q", q_dims, q.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("kt", kt_dims, kt.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("v", v_dims, v.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", &outputs[fused], &output_dims[fused]));
+    }
+
+    EXPECT_EQ(output_dims[0], output_dims[1]);
+    ASSERT_EQ(outputs[0].size(), outputs[1].size());
+    for (size_t i = 0; i < outputs[0].size(); ++i) {
+        EXPECT_NEAR(outputs[0][i], outputs[1][i], 1e-4f) << "at " << i;
+    }
+}
+
+TEST(FuseAttentionTest, same_batch_dims) {
+    TestFuseAttention({2, 3, 5, 8}, {2, 3, 8, 7}, {2, 3, 7, 6}, {2, 1, 1, 7}, true);
+}
+
+TEST(FuseAttentionTest, mask_of_full_scores) {
+    TestFuseAttention({1, 2, 17, 16}, {1, 2, 16, 33}, {1, 2, 33, 16}, {1, 2, 17, 33}, true);
+}
+
+TEST(FuseAttentionTest, kv_shared_by_heads) {
+    TestFuseAttention({2, 4, 5, 8}, {2, 1, 8, 7}, {2, 1, 7, 6}, {7}, true);
+}
+
+TEST(FuseAttentionTest, kv_shared_by_batches) {
+    TestFuseAttention({3, 4, 5, 8}, {1, 4, 8, 7}, {1, 4, 7, 6}, {1, 1, 5, 7}, true);
+}
+
+TEST(FuseAttentionTest, q_broadcast_to_kv) {
+    TestFuseAttention({1, 5, 8}, {3, 8, 9}, {3, 9, 4}, {1, 9}, true);
+}
+
+TEST(FuseAttentionTest, mask_enlarges_scores) {
+    TestFuseAttention({1, 4, 5, 8}, {1, 4, 8, 7}, {1, 4, 7, 6}, {2, 1, 5, 7}, false);
+}
+
+TEST(FuseAttentionTest, mask_has_more_dims) {
+    TestFuseAttention({4, 5, 8}, {4, 8, 7}, {4, 7, 6}, {2, 4, 5, 7}, false);
+}
+
+/*
+   y = Add(Mul(Div(Sub(x, mean), Sqrt(Add(ReduceMean(Pow(Sub(x, mean), 2)), eps))), gamma), beta)
+   with mean = ReduceMean(x) over the last dim
+*/
+static void TestFuseLayerNorm(const vector<int64_t>& x_dims, const vector<int64_t>& gamma_dims, bool expect_fused) {
+    const float two = 2.0f, eps = 1e-5f;
+    auto x = RandomData(x_dims, 5);
+    auto gamma = RandomData(gamma_dims, 6);
+    auto beta = RandomData(gamma_dims, 7);
+
+    vector<float> outputs[2];
+    vector<int64_t> output_dims[2];
+    for (int fused = 0; fused < 2; ++fused) {
+        unique_ptr<X86OptRuleDisabler> disabler;
+        if (!fused) {
+            disabler.reset(new X86OptRuleDisabler("AfterLayoutOptimize", "FuseLayerNorm"));
+        }
+
+        X86GraphRunner runner("layer_norm");
+        auto reduce_param = make_shared<ppl::nn::common::ReduceParam>();
+        reduce_param->axes = {-1};
+        reduce_param->keep_dims = true;
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput("x", DATATYPE_FLOAT32, x_dims));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("two", DATATYPE_FLOAT32, {}, &two));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("eps", DATATYPE_FLOAT32, {}, &eps));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("gamma", DATATYPE_FLOAT32, gamma_dims, gamma.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.AddConstant("beta", DATATYPE_FLOAT32, gamma_dims, beta.data()));
+        ASSERT_EQ(RC_SUCCESS,
+                  runner.AddNode("mean", ir::Node::Type("", "ReduceMean", 11), {"x"}, {"mean_out"}, reduce_param));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("sub", ir::Node::Type("", "Sub", 11), {"x", "mean_out"}, {"d"}));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("pow", ir::Node::Type("", "Pow", 11), {"d", "two"}, {"sq"}));
+        ASSERT_EQ(RC_SUCCESS,
+                  runner.AddNode("var", ir::Node::Type("", "ReduceMean", 11), {"sq"}, {"var_out"}, reduce_param));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("add_eps", ir::Node::Type("", "Add", 11), {"var_out", "eps"}, {"ve"}));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("sqrt", ir::Node::Type("", "Sqrt", 11), {"ve"}, {"std"}));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("div", ir::Node::Type("", "Div", 11), {"d", "std"}, {"norm"}));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("mul", ir::Node::Type("", "Mul", 11), {"norm", "gamma"}, {"scaled"}));
+        ASSERT_EQ(RC_SUCCESS, runner.AddNode("add", ir::Node::Type("", "Add", 11), {"scaled", "beta"}, {"y"}));
+        ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+        EXPECT_EQ(fused == 1, HasNode(runner.GetGraph(), "ppl", "LayerNorm"));
+        if (fused) {
+            // gamma and beta are fused only if they are applied along the normalized dims
+            EXPECT_EQ(expect_fused, !HasNode(runner.GetGraph(), "", "Mul"));
+        }
+
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x", x_dims, x.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", &outputs[fused], &output_dims[fused]));
+    }
+
+    EXPECT_EQ(output_dims[0], output_dims[1]);
+    ASSERT_EQ(outputs[0].size(), outputs[1].size());
+    for (size_t i = 0; i < outputs[0].size(); ++i) {
+        EXPECT_NEAR(outputs[0][i], outputs[1][i], 1e-4f) << "at " << i;
+    }
+}
+
+TEST(FuseLayerNormTest, affine_of_normalized_dims) {
+    TestFuseLayerNorm({2, 4, 4}, {4}, true);
+    TestFuseLayerNorm({2, 4, 4}, {1, 1, 4}, true);
+}
+
+TEST(FuseLayerNormTest, affine_of_other_dims) {
+    // same element count as the normalized dims, but broadcast along dim 1
+    TestFuseLayerNorm({2, 4, 4}, {4, 1}, false);
+}
+
+#endif
@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "ppl/kernel/x86/bf16/gemm_v2.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <math.h>
+#include <random>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static void TestGemmV2Bf16(int64_t M, int64_t N, int64_t K, int32_t trans_A, int32_t trans_B, float alpha, float beta,
+                           gemm_v2_C_type_t c_type, bool relu) {
+    mt19937 rng(4321);
+    uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    vector<float> A(M * K), B(K * N), C(M * N);
+    for (auto& v : A) {
+        v = dist(rng);
+    }
+    for (auto& v : B) {
+        v = dist(rng);
+    }
+    for (auto& v : C) {
+        v = dist(rng);
+    }
+
+    gemm_v2_param_fp32 param;
+    param.src_A = A.data();
+    param.src_B = B.data();
+    param.M = M;
+    param.N = N;
+    param.K = K;
+    param.trans_A = trans_A;
+    param.trans_B = trans_B;
+    param.lda = trans_A ? M : K;
+    param.ldb = trans_B ? K : N;
+    param.ldy = N;
+    param.alpha = alpha;
+    param.beta = beta;
+    param.c_type = c_type;
+    param.src_C = (c_type == gemm_v2_C_type::EMPTY) ? nullptr : C.data();
+    param.ldc = (c_type == gemm_v2_C_type::MATRIX) ? N : 0;
+    param.fuse_flag = relu ? gemm_v2_fuse_flag::RELU : gemm_v2_fuse_flag::NONE;
+
+    vector<float> ref(M * N);
+    for (int64_t m = 0; m < M; ++m) {
+        for (int64_t n = 0; n < N; ++n) {
+            double sum = 0.0;
+            for (int64_t k = 0; k < K; ++k) {
+                const float a = trans_A ? A[k * M + m] : A[m * K + k];
+                const float b = trans_B ? B[n * K + k] : B[k * N + n];
+                sum += a * b;
+            }
+            float c = 0.0f;
+            if (c_type == gemm_v2_C_type::SCALAR) {
+                c = C[0];
+            } else if (c_type == gemm_v2_C_type::VECTOR_H) {
+                c = C[m];
+            } else if (c_type == gemm_v2_C_type::VECTOR_W) {
+                c = C[n];
+            } else if (c_type == gemm_v2_C_type::MATRIX) {
+                c = C[m * N + n];
+            }
+            float v = alpha * sum + beta * c;
+            ref[m * N + n] = (relu && v < 0.0f) ? 0.0f : v;
+        }
+    }
+
+    // bf16 keeps 8 bits of mantissa, each product is off by at most about 2^-8 of |a| * |b| <= 1
+    const float tolerance = fabsf(alpha) * K * 1.0f / 128.0f + 1e-5f;
+
+    const gemm_bf16_isa_t best_isa = gemm_bf16_select_isa(GetCpuISA());
+    for (gemm_bf16_isa_t isa = gemm_bf16_isa::REF; isa <= best_isa; ++isa) {
+        vector<uint8_t> tmp(gemm_v2_bf16_get_buffer_bytes(param));
+        vector<float> Y(M * N, 0.0f);
+        param.dst_Y = Y.data();
+        ASSERT_EQ(RC_SUCCESS, gemm_v2_bf16(isa, param, tmp.data()));
+
+        double err_sum = 0.0, ref_sum = 0.0;
+        for (int64_t i = 0; i < M * N; ++i) {
+            EXPECT_NEAR(ref[i], Y[i], tolerance) << "isa " << isa << " at " << i;
+            err_sum += fabs(ref[i] - Y[i]);
+            ref_sum += fabs(ref[i]);
+        }
+        EXPECT_LT(err_sum / ref_sum, 0.01) << "isa " << isa;
+    }
+}
+
+TEST(GemmV2Bf16Test, compare_with_fp32) {
+    TestGemmV2Bf16(33, 47, 70, 0, 0, 1.0f, 0.0f, gemm_v2_C_type::EMPTY, false);
+    TestGemmV2Bf16(64, 64, 64, 0, 1, 1.0f, 0.0f, gemm_v2_C_type::EMPTY, true);
+    TestGemmV2Bf16(17, 40, 31, 1, 0, 0.5f, 1.0f, gemm_v2_C_type::VECTOR_W, false);
+    TestGemmV2Bf16(20, 9, 100, 1, 1, 1.0f, 2.0f, gemm_v2_C_type::VECTOR_H, true);
+    TestGemmV2Bf16(5, 70, 33, 0, 1, 2.0f, 0.5f, gemm_v2_C_type::MATRIX, false);
+    TestGemmV2Bf16(8, 8, 8, 0, 0, 1.0f, 1.0f, gemm_v2_C_type::SCALAR, true);
+}
+
+#endif
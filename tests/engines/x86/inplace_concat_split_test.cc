@@ -0,0 +1,221 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/split_param.h"
+#include "gtest/gtest.h"
+#include <functional>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+// all inputs and constants are (1, 16, 4, 4), so that every slot of concatenated tensors is aligned
+static const vector<int64_t> g_dims{1, 16, 4, 4};
+static const int64_t g_count = 16 * 4 * 4;
+
+static shared_ptr<void> MakeConcatParam(int32_t axis) {
+    auto param = make_shared<ppl::nn::common::ConcatParam>();
+    param->axis = axis;
+    return param;
+}
+
+static shared_ptr<void> MakeSplitParam(int32_t axis, const vector<int32_t>& split_point) {
+    auto param = make_shared<ppl::nn::common::SplitParam>();
+    param->axis = axis;
+    param->split_point = split_point;
+    return param;
+}
+
+static ir::Node::Type OnnxType(const string& name) {
+    return ir::Node::Type("", name, 11);
+}
+
+/*
+   runs the graph built by `build_graph` several times with different inputs, with or without InplaceConcatSplit.
+   in-place buffers are laid out in the first run and written by producers from the second run on, so results of
+   later runs show whether buffers of other tensors are overwritten.
+*/
+static void RunGraph(const function<void(X86GraphRunner*)>& build_graph, const vector<string>& inputs,
+                     const vector<string>& outputs, bool inplace, vector<vector<float>>* results) {
+    unique_ptr<X86OptRuleDisabler> disabler;
+    if (!inplace) {
+        disabler.reset(new X86OptRuleDisabler("", "InplaceConcatSplit"));
+    }
+
+    X86GraphRunner runner("inplace_concat_split");
+    for (auto& name : inputs) {
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput(name, DATATYPE_FLOAT32, g_dims));
+    }
+    build_graph(&runner);
+    for (auto& name : outputs) {
+        ASSERT_EQ(RC_SUCCESS, runner.AddOutput(name));
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+    const uint32_t run_count = 3;
+    for (uint32_t r = 0; r < run_count; ++r) {
+        for (uint32_t i = 0; i < inputs.size(); ++i) {
+            auto data = RandomData(g_count, r * 16 + i);
+            ASSERT_EQ(RC_SUCCESS, runner.SetInputData(inputs[i], g_dims, data.data()));
+        }
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+        for (auto& name : outputs) {
+            vector<float> result;
+            ASSERT_EQ(RC_SUCCESS, runner.GetOutputData(name, &result));
+            results->push_back(result);
+        }
+    }
+}
+
+static void TestInplaceConcatSplit(const function<void(X86GraphRunner*)>& build_graph, const vector<string>& inputs,
+                                   const vector<string>& outputs) {
+    vector<vector<float>> expected, actual;
+    RunGraph(build_graph, inputs, outputs, false, &expected);
+    RunGraph(build_graph, inputs, outputs, true, &actual);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], actual[i]) << "output " << outputs[i % outputs.size()] << " of run "
+                                          << i / outputs.size();
+    }
+}
+
+TEST(InplaceConcatSplitTest, concat) {
+    TestInplaceConcatSplit(
+        [](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_b", OnnxType("Exp"), {"b"}, {"eb"}));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat", OnnxType("Concat"), {"ea", "eb"}, {"c"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"c"}, {"y"}));
+        },
+        {"a", "b"}, {"y"});
+}
+
+/*
+   `add0` takes over the buffer of `c` and writes into it before `ea` is read by `add1`, so `ea` cannot be
+   placed in the buffer of the Concat.
+*/
+TEST(InplaceConcatSplitTest, concat_input_consumed_elsewhere) {
+    const auto constant = RandomData(g_count * 2, 1234);
+    TestInplaceConcatSplit(
+        [&constant](X86GraphRunner* runner) {
+            const vector<int64_t> k_dims{1, 32, 4, 4};
+            ASSERT_EQ(RC_SUCCESS, runner->AddConstant("k", DATATYPE_FLOAT32, k_dims, constant.data()));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_b", OnnxType("Exp"), {"b"}, {"eb"}));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat", OnnxType("Concat"), {"ea", "eb"}, {"c"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("add0", OnnxType("Add"), {"c", "k"}, {"t"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("split", OnnxType("Split"), {"t"}, {"t0", "t1"},
+                                                  MakeSplitParam(1, {16, 16})));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"t1"}, {"y0"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("add1", OnnxType("Add"), {"ea", "t0"}, {"u"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("tanh", OnnxType("Tanh"), {"u"}, {"y1"}));
+        },
+        {"a", "b"}, {"y0", "y1"});
+}
+
+TEST(InplaceConcatSplitTest, concat_input_used_twice) {
+    TestInplaceConcatSplit(
+        [](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat", OnnxType("Concat"), {"ea", "ea"}, {"c"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"c"}, {"y"}));
+        },
+        {"a"}, {"y"});
+}
+
+TEST(InplaceConcatSplitTest, concat_of_graph_input_and_constant) {
+    const auto constant = RandomData(g_count, 1234);
+    TestInplaceConcatSplit(
+        [&constant](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddConstant("k", DATATYPE_FLOAT32, g_dims, constant.data()));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_b", OnnxType("Exp"), {"b"}, {"eb"}));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat", OnnxType("Concat"), {"a", "eb", "k"}, {"c"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"c"}, {"y0"}));
+            // `a` and `k` are read again after the Concat
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("add", OnnxType("Add"), {"a", "k"}, {"t"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("tanh", OnnxType("Tanh"), {"t"}, {"y1"}));
+        },
+        {"a", "b"}, {"y0", "y1"});
+}
+
+TEST(InplaceConcatSplitTest, chained_concats) {
+    TestInplaceConcatSplit(
+        [](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_b", OnnxType("Exp"), {"b"}, {"eb"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_x", OnnxType("Exp"), {"x"}, {"ex"}));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat0", OnnxType("Concat"), {"ea", "eb"}, {"c0"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat1", OnnxType("Concat"), {"ex", "c0"}, {"c1"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"c1"}, {"y"}));
+        },
+        {"a", "b", "x"}, {"y"});
+}
+
+TEST(InplaceConcatSplitTest, split) {
+    TestInplaceConcatSplit(
+        [](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("split", OnnxType("Split"), {"ea"}, {"s0", "s1"},
+                                                  MakeSplitParam(1, {4, 12})));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"s0"}, {"y0"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("tanh", OnnxType("Tanh"), {"s1"}, {"y1"}));
+        },
+        {"a"}, {"y0", "y1"});
+}
+
+// outputs of the Split are swapped and concatenated with another tensor
+TEST(InplaceConcatSplitTest, split_output_feeding_concat) {
+    TestInplaceConcatSplit(
+        [](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_b", OnnxType("Exp"), {"b"}, {"eb"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("split", OnnxType("Split"), {"ea"}, {"s0", "s1"},
+                                                  MakeSplitParam(1, {8, 8})));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("concat", OnnxType("Concat"), {"s1", "eb", "s0"}, {"c"},
+                                                  MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"c"}, {"y"}));
+        },
+        {"a", "b"}, {"y"});
+}
+
+TEST(InplaceConcatSplitTest, concat_feeding_split) {
+    TestInplaceConcatSplit(
+        [](X86GraphRunner* runner) {
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_a", OnnxType("Exp"), {"a"}, {"ea"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("exp_b", OnnxType("Exp"), {"b"}, {"eb"}));
+            ASSERT_EQ(RC_SUCCESS,
+                      runner->AddNode("concat", OnnxType("Concat"), {"ea", "eb"}, {"c"}, MakeConcatParam(1)));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("split", OnnxType("Split"), {"c"}, {"s0", "s1"},
+                                                  MakeSplitParam(1, {24, 8})));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("sigmoid", OnnxType("Sigmoid"), {"s0"}, {"y0"}));
+            ASSERT_EQ(RC_SUCCESS, runner->AddNode("tanh", OnnxType("Tanh"), {"s1"}, {"y1"}));
+        },
+        {"a", "b"}, {"y0", "y1"});
+}
+
+#endif
@@ -0,0 +1,263 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/params/onnx/loop_param.h"
+#include "ppl/nn/params/onnx/concat_param.h"
+#include "ppl/nn/params/onnx/reduce_param.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+static shared_ptr<void> CreateLoopParam(X86GraphRunner* body) {
+    auto param = make_shared<ppl::nn::common::LoopParam>();
+    if (body->Finalize() != RC_SUCCESS) {
+        return shared_ptr<void>();
+    }
+    param->graph = *body->GetGraph();
+    return param;
+}
+
+/*
+   a grows by `c` in each iteration, and b keeps the value of a in the last iteration:
+     b_out = Identity(a_in), or b_out is a_in itself if `pass_through` is true
+     a_out = Concat(a_in, c)
+     s = ReduceSum(b_in) for each iteration
+*/
+static void BuildGrowingLoop(int64_t trip_count, const vector<float>& a0, const vector<float>& b0,
+                             const vector<float>& c, bool pass_through, X86GraphRunner* runner) {
+    X86GraphRunner body("loop_body");
+    auto concat_param = make_shared<ppl::nn::common::ConcatParam>();
+    concat_param->axis = 0;
+    auto reduce_param = make_shared<ppl::nn::common::ReduceParam>();
+    reduce_param->axes = {0};
+    reduce_param->keep_dims = true;
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("iter", DATATYPE_INT64, {}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("cond_in", DATATYPE_BOOL, {}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("a_in", DATATYPE_FLOAT32, {(int64_t)a0.size()}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("b_in", DATATYPE_FLOAT32, {(int64_t)b0.size()}));
+    ASSERT_EQ(RC_SUCCESS, body.AddConstant("c", DATATYPE_FLOAT32, {(int64_t)c.size()}, c.data()));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("cond", ir::Node::Type("", "Identity", 11), {"cond_in"}, {"cond_out"}));
+    if (!pass_through) {
+        ASSERT_EQ(RC_SUCCESS, body.AddNode("keep", ir::Node::Type("", "Identity", 11), {"a_in"}, {"b_out"}));
+    }
+    ASSERT_EQ(RC_SUCCESS,
+              body.AddNode("grow", ir::Node::Type("", "Concat", 11), {"a_in", "c"}, {"a_out"}, concat_param));
+    ASSERT_EQ(RC_SUCCESS,
+              body.AddNode("sum", ir::Node::Type("", "ReduceSum", 11), {"b_in"}, {"s"}, reduce_param));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("cond_out"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("a_out"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput(pass_through ? "a_in" : "b_out"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("s"));
+    auto loop_param = CreateLoopParam(&body);
+    ASSERT_TRUE(loop_param.get() != nullptr);
+
+    const bool keep_going = true;
+    ASSERT_EQ(RC_SUCCESS, runner->AddConstant("trip_count", DATATYPE_INT64, {}, &trip_count));
+    ASSERT_EQ(RC_SUCCESS, runner->AddConstant("keep_going", DATATYPE_BOOL, {}, &keep_going));
+    ASSERT_EQ(RC_SUCCESS, runner->AddInput("a0", DATATYPE_FLOAT32, {(int64_t)a0.size()}));
+    ASSERT_EQ(RC_SUCCESS, runner->AddInput("b0", DATATYPE_FLOAT32, {(int64_t)b0.size()}));
+    ASSERT_EQ(RC_SUCCESS,
+              runner->AddNode("loop", ir::Node::Type("", "Loop", 11), {"trip_count", "keep_going", "a0", "b0"},
+                              {"a", "b", "sums"}, loop_param));
+    ASSERT_EQ(RC_SUCCESS, runner->Build());
+}
+
+static void TestGrowingLoop(bool pass_through) {
+    const int64_t trip_count = 9;
+    const vector<float> a0 = {1, 2};
+    const vector<float> b0 = {0.5f};
+    const vector<float> c = {3, 4, 5};
+
+    // b of iteration i is a of iteration i - 1
+    vector<vector<float>> a_values{a0}, b_values{b0};
+    for (int64_t i = 0; i < trip_count; ++i) {
+        auto a = a_values.back();
+        a.insert(a.end(), c.begin(), c.end());
+        b_values.push_back(a_values.back());
+        a_values.push_back(a);
+    }
+    vector<float> expected_sums;
+    for (int64_t i = 0; i < trip_count; ++i) {
+        float sum = 0;
+        for (auto v : b_values[i]) {
+            sum += v;
+        }
+        expected_sums.push_back(sum);
+    }
+
+    X86GraphRunner runner("growing_loop");
+    BuildGrowingLoop(trip_count, a0, b0, c, pass_through, &runner);
+    ASSERT_TRUE(runner.GetRuntime() != nullptr);
+
+    // buffers of the loop kernel are reused by the second run
+    for (int run = 0; run < 2; ++run) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("a0", {(int64_t)a0.size()}, a0.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("b0", {(int64_t)b0.size()}, b0.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+
+        vector<float> a, b, sums;
+        vector<int64_t> sums_dims;
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("a", &a));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("b", &b));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("sums", &sums, &sums_dims));
+        EXPECT_EQ(a_values.back(), a);
+        EXPECT_EQ(b_values.back(), b);
+        EXPECT_EQ(vector<int64_t>({trip_count, 1}), sums_dims);
+        EXPECT_EQ(expected_sums, sums);
+    }
+}
+
+TEST(LoopTest, growing_loop_carried_dep) {
+    TestGrowingLoop(false);
+}
+
+// b is passed without a producer, so it refers to the buffer of a that is replaced when a grows
+TEST(LoopTest, growing_loop_carried_dep_passed_through) {
+    TestGrowingLoop(true);
+}
+
+/*
+   x_out = Add(x_in, 1)
+   scan0 = Mul(x_out, 2)
+   scan1 = Identity(x_in)
+*/
+TEST(LoopTest, scan_outputs) {
+    const int64_t trip_count = 5;
+    const vector<int64_t> dims = {2, 3};
+    const vector<float> x0 = {0, 1, 2, 3, 4, 5};
+    const float one = 1.0f, two = 2.0f;
+
+    X86GraphRunner body("loop_body");
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("iter", DATATYPE_INT64, {}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("cond_in", DATATYPE_BOOL, {}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("x_in", DATATYPE_FLOAT32, dims));
+    ASSERT_EQ(RC_SUCCESS, body.AddConstant("one", DATATYPE_FLOAT32, {}, &one));
+    ASSERT_EQ(RC_SUCCESS, body.AddConstant("two", DATATYPE_FLOAT32, {}, &two));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("cond", ir::Node::Type("", "Identity", 11), {"cond_in"}, {"cond_out"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("inc", ir::Node::Type("", "Add", 11), {"x_in", "one"}, {"x_out"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("double", ir::Node::Type("", "Mul", 11), {"x_out", "two"}, {"scan0"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("copy", ir::Node::Type("", "Identity", 11), {"x_in"}, {"scan1"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("cond_out"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("x_out"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("scan0"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("scan1"));
+    auto loop_param = CreateLoopParam(&body);
+    ASSERT_TRUE(loop_param.get() != nullptr);
+
+    const bool keep_going = true;
+    X86GraphRunner runner("scan_loop");
+    ASSERT_EQ(RC_SUCCESS, runner.AddConstant("trip_count", DATATYPE_INT64, {}, &trip_count));
+    ASSERT_EQ(RC_SUCCESS, runner.AddConstant("keep_going", DATATYPE_BOOL, {}, &keep_going));
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("x0", DATATYPE_FLOAT32, dims));
+    ASSERT_EQ(RC_SUCCESS,
+              runner.AddNode("loop", ir::Node::Type("", "Loop", 11), {"trip_count", "keep_going", "x0"},
+                             {"x", "scans0", "scans1"}, loop_param));
+    ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+    for (int run = 0; run < 2; ++run) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x0", dims, x0.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+
+        vector<float> x, scans0, scans1;
+        vector<int64_t> x_dims, scans0_dims, scans1_dims;
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("x", &x, &x_dims));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("scans0", &scans0, &scans0_dims));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("scans1", &scans1, &scans1_dims));
+        EXPECT_EQ(dims, x_dims);
+        EXPECT_EQ(vector<int64_t>({trip_count, 2, 3}), scans0_dims);
+        EXPECT_EQ(vector<int64_t>({trip_count, 2, 3}), scans1_dims);
+        for (int64_t i = 0; i < trip_count; ++i) {
+            for (size_t j = 0; j < x0.size(); ++j) {
+                EXPECT_EQ((x0[j] + i + 1) * 2, scans0[i * x0.size() + j]);
+                EXPECT_EQ(x0[j] + i, scans1[i * x0.size() + j]);
+            }
+        }
+        for (size_t j = 0; j < x0.size(); ++j) {
+            EXPECT_EQ(x0[j] + trip_count, x[j]);
+        }
+    }
+}
+
+/*
+   x and y are swapped in each iteration without any node:
+     x_out is y_in, y_out is x_in
+     s = Identity(x_in), t = Identity(y_in) for each iteration
+*/
+TEST(LoopTest, swapped_loop_carried_deps) {
+    const int64_t trip_count = 5;
+    const vector<float> x0 = {1, 2, 3};
+    const vector<float> y0 = {4, 5, 6};
+
+    X86GraphRunner body("loop_body");
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("iter", DATATYPE_INT64, {}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("cond_in", DATATYPE_BOOL, {}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("x_in", DATATYPE_FLOAT32, {(int64_t)x0.size()}));
+    ASSERT_EQ(RC_SUCCESS, body.AddInput("y_in", DATATYPE_FLOAT32, {(int64_t)y0.size()}));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("cond", ir::Node::Type("", "Identity", 11), {"cond_in"}, {"cond_out"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("copy_x", ir::Node::Type("", "Identity", 11), {"x_in"}, {"s"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddNode("copy_y", ir::Node::Type("", "Identity", 11), {"y_in"}, {"t"}));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("cond_out"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("y_in"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("x_in"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("s"));
+    ASSERT_EQ(RC_SUCCESS, body.AddOutput("t"));
+    auto loop_param = CreateLoopParam(&body);
+    ASSERT_TRUE(loop_param.get() != nullptr);
+
+    const bool keep_going = true;
+    X86GraphRunner runner("swap_loop");
+    ASSERT_EQ(RC_SUCCESS, runner.AddConstant("trip_count", DATATYPE_INT64, {}, &trip_count));
+    ASSERT_EQ(RC_SUCCESS, runner.AddConstant("keep_going", DATATYPE_BOOL, {}, &keep_going));
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("x0", DATATYPE_FLOAT32, {(int64_t)x0.size()}));
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("y0", DATATYPE_FLOAT32, {(int64_t)y0.size()}));
+    ASSERT_EQ(RC_SUCCESS,
+              runner.AddNode("loop", ir::Node::Type("", "Loop", 11), {"trip_count", "keep_going", "x0", "y0"},
+                             {"x", "y", "xs", "ys"}, loop_param));
+    ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+    vector<float> expected_xs, expected_ys;
+    for (int64_t i = 0; i < trip_count; ++i) {
+        auto& x = (i % 2 == 0) ? x0 : y0;
+        auto& y = (i % 2 == 0) ? y0 : x0;
+        expected_xs.insert(expected_xs.end(), x.begin(), x.end());
+        expected_ys.insert(expected_ys.end(), y.begin(), y.end());
+    }
+
+    for (int run = 0; run < 2; ++run) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x0", {(int64_t)x0.size()}, x0.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("y0", {(int64_t)y0.size()}, y0.data()));
+        ASSERT_EQ(RC_SUCCESS, runner.Run());
+
+        vector<float> x, y, xs, ys;
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("x", &x));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", &y));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("xs", &xs));
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("ys", &ys));
+        EXPECT_EQ(y0, x); // odd trip count
+        EXPECT_EQ(x0, y);
+        EXPECT_EQ(expected_xs, xs);
+        EXPECT_EQ(expected_ys, ys);
+    }
+}
+
+#endif
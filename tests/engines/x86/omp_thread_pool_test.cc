@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#if defined(PPLNN_USE_X86) && defined(__linux__)
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+
+#include "ppl/nn/engines/x86/omp_thread_pool.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+using namespace std;
+using namespace ppl::nn::x86;
+
+static vector<int32_t> GetAffinity() {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    vector<int32_t> cores;
+    for (int32_t i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &cpuset)) {
+            cores.push_back(i);
+        }
+    }
+    return cores;
+}
+
+TEST(OmpThreadPoolTest, concurrent_callers_do_not_share_pinned_cores) {
+    cpu_set_t saved;
+    CPU_ZERO(&saved);
+    ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved));
+
+    // both cores are the same one on single core machines, which still checks that nothing fails
+    auto allowed = GetAffinity();
+    ASSERT_FALSE(allowed.empty());
+    const vector<int32_t> cores = {allowed.front(), allowed.back()};
+    const vector<int32_t> all_cores = (cores[0] == cores[1]) ? vector<int32_t>({cores[0]}) : cores;
+
+    OmpThreadPool pool;
+    pool.Init(2, cores);
+
+    // the only caller pins thread 0 of its team, i.e. itself, to the first core
+    pool.Acquire();
+    EXPECT_EQ(vector<int32_t>({cores[0]}), GetAffinity());
+
+    // a caller arriving meanwhile may run on all cores of the pool
+    vector<int32_t> concurrent_affinity;
+    thread t([&pool, &concurrent_affinity]() -> void {
+        pool.Acquire();
+        concurrent_affinity = GetAffinity();
+        pool.Release();
+    });
+    t.join();
+    EXPECT_EQ(all_cores, concurrent_affinity);
+
+    pool.Release();
+
+    // and is pinned again once it is the only caller
+    vector<int32_t> alone_affinity;
+    thread t2([&pool, &alone_affinity]() -> void {
+        pool.Acquire();
+        alone_affinity = GetAffinity();
+        pool.Release();
+    });
+    t2.join();
+    EXPECT_EQ(vector<int32_t>({cores[0]}), alone_affinity);
+
+    // acquiring an applied pool again changes nothing
+    pool.Acquire();
+    EXPECT_EQ(vector<int32_t>({cores[0]}), GetAffinity());
+    pool.Release();
+
+    ASSERT_EQ(0, pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved));
+    EXPECT_EQ(allowed, GetAffinity());
+}
+
+#endif
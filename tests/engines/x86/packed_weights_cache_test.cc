@@ -0,0 +1,189 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/engines/x86/packed_weights_cache.h"
+#include "ppl/nn/engines/x86/x86_options.h"
+#include "ppl/nn/params/onnx/convolution_param.h"
+#include "ppl/common/generic_cpu_allocator.h"
+#include "ppl/common/sys.h"
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::x86;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+using namespace ppl::kernel::x86;
+
+static conv2d_fp32_param MakeParam() {
+    conv2d_fp32_param param;
+    memset(&param, 0, sizeof(param));
+    param.kernel_h = 3;
+    param.kernel_w = 3;
+    param.stride_h = 1;
+    param.stride_w = 1;
+    param.dilation_h = 1;
+    param.dilation_w = 1;
+    param.pad_h = 1;
+    param.pad_w = 1;
+    param.channels = 4;
+    param.num_output = 2;
+    param.group = 1;
+    return param;
+}
+
+TEST(PackedWeightsCacheTest, weights_hash_mismatch) {
+    const string filename = "/tmp/pplnn_packed_weights_cache_test.bin";
+    const auto param = MakeParam();
+
+    vector<float> filter(param.num_output * param.channels * param.kernel_h * param.kernel_w, 1.0f);
+    vector<float> bias(param.num_output, 0.5f);
+    const uint64_t hash = PackedWeightsCache::HashWeights(
+        bias.data(), bias.size() * sizeof(float),
+        PackedWeightsCache::HashWeights(filter.data(), filter.size() * sizeof(float)));
+
+    GenericCpuAllocator ar;
+    {
+        PackedWeightsCache cache(&ar);
+        PackedWeightsCache::Conv2dInfo info;
+        info.param = param;
+        memset(&info.algo_info, 0, sizeof(info.algo_info));
+        info.cvt_filter = filter.data();
+        info.cvt_filter_size = filter.size();
+        info.cvt_bias = bias.data();
+        info.cvt_bias_size = bias.size();
+        info.weights_hash = hash;
+        cache.AddConv2dInfo("conv", info);
+        EXPECT_EQ(RC_SUCCESS, cache.Export(filename.c_str(), 0));
+    }
+
+    PackedWeightsCache cache(&ar);
+    EXPECT_EQ(RC_SUCCESS, cache.Import(filename.c_str(), 0));
+
+    auto found = cache.FindConv2dInfo("conv", param, hash);
+    EXPECT_NE(nullptr, found);
+    if (found) {
+        EXPECT_EQ(filter.size(), found->cvt_filter_size);
+        EXPECT_EQ(0, memcmp(filter.data(), found->cvt_filter, filter.size() * sizeof(float)));
+    }
+
+    // same shapes with different weights must not hit the cache
+    filter[filter.size() / 2] = 2.0f;
+    const uint64_t new_hash = PackedWeightsCache::HashWeights(
+        bias.data(), bias.size() * sizeof(float),
+        PackedWeightsCache::HashWeights(filter.data(), filter.size() * sizeof(float)));
+    EXPECT_NE(hash, new_hash);
+    EXPECT_EQ(nullptr, cache.FindConv2dInfo("conv", param, new_hash));
+
+    EXPECT_EQ(nullptr, cache.FindConv2dInfo("not_exist", param, hash));
+
+    remove(filename.c_str());
+}
+
+/*
+   builds x -> conv0 -> conv1 -> y with packed weights imported from `import_file` and exported to `export_file` if
+   they are not empty, and runs it.
+*/
+static void RunConvs(const string& import_file, const string& export_file, vector<float>* y) {
+    const int64_t channels = 4, num_output = 8, height = 6, width = 6;
+    const vector<int64_t> x_dims{1, channels, height, width};
+    const auto x = RandomData(channels * height * width, 1);
+    const auto w0 = RandomData(num_output * channels * 3 * 3, 2);
+    const auto w1 = RandomData(num_output * num_output, 3);
+
+    auto conv0_param = make_shared<ppl::nn::common::ConvolutionParam>();
+    conv0_param->kernel_shape = {3, 3};
+    conv0_param->dilations = {1, 1};
+    conv0_param->strides = {1, 1};
+    conv0_param->pads = {1, 1, 1, 1};
+    conv0_param->group = 1;
+    auto conv1_param = make_shared<ppl::nn::common::ConvolutionParam>(*conv0_param);
+    conv1_param->kernel_shape = {1, 1};
+    conv1_param->pads = {0, 0, 0, 0};
+
+    X86GraphRunner runner("packed_weights");
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("x", DATATYPE_FLOAT32, x_dims));
+    ASSERT_EQ(RC_SUCCESS, runner.AddConstant("w0", DATATYPE_FLOAT32, {num_output, channels, 3, 3}, w0.data()));
+    ASSERT_EQ(RC_SUCCESS, runner.AddConstant("w1", DATATYPE_FLOAT32, {num_output, num_output, 1, 1}, w1.data()));
+    ASSERT_EQ(RC_SUCCESS, runner.AddNode("conv0", ir::Node::Type("", "Conv", 11), {"x", "w0"}, {"c0"}, conv0_param));
+    ASSERT_EQ(RC_SUCCESS, runner.AddNode("conv1", ir::Node::Type("", "Conv", 11), {"c0", "w1"}, {"y"}, conv1_param));
+    ASSERT_EQ(RC_SUCCESS, runner.AddOutput("y"));
+
+    auto configure_engine = [&import_file, &export_file](Engine* engine) -> RetCode {
+        if (!import_file.empty()) {
+            auto status = engine->Configure(X86_CONF_IMPORT_PACKED_WEIGHTS, import_file.c_str());
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+        }
+        if (!export_file.empty()) {
+            return engine->Configure(X86_CONF_EXPORT_PACKED_WEIGHTS, export_file.c_str());
+        }
+        return RC_SUCCESS;
+    };
+    ASSERT_EQ(RC_SUCCESS, runner.Build(X86EngineOptions(), false, configure_engine));
+
+    ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x", x_dims, x.data()));
+    ASSERT_EQ(RC_SUCCESS, runner.Run());
+    ASSERT_EQ(RC_SUCCESS, runner.GetOutputData("y", y));
+}
+
+static uint32_t GetEntryCount(const string& filename) {
+    isa_t isa = GetCpuISA();
+#ifndef PPL_USE_X86_AVX512
+    isa &= ~ISA_X86_AVX512; // the same as the engine
+#endif
+    GenericCpuAllocator ar;
+    PackedWeightsCache cache(&ar);
+    if (cache.Import(filename.c_str(), isa) != RC_SUCCESS) {
+        return 0;
+    }
+    return cache.GetImportedConv2dInfoCount();
+}
+
+// convolutions served from the imported file must be exported again, also when both files are the same
+TEST(PackedWeightsCacheTest, export_imported_weights) {
+    const string filename = "/tmp/pplnn_packed_weights_cache_export_test.bin";
+    remove(filename.c_str());
+
+    vector<float> expected;
+    RunConvs("", filename, &expected);
+    EXPECT_EQ(2u, GetEntryCount(filename));
+
+    const string another_filename = filename + ".another";
+    vector<float> y;
+    RunConvs(filename, another_filename, &y);
+    EXPECT_EQ(expected, y);
+    EXPECT_EQ(2u, GetEntryCount(another_filename));
+
+    RunConvs(filename, filename, &y);
+    EXPECT_EQ(expected, y);
+    EXPECT_EQ(2u, GetEntryCount(filename));
+
+    RunConvs(filename, "", &y);
+    EXPECT_EQ(expected, y);
+
+    remove(filename.c_str());
+    remove(another_filename.c_str());
+}
+
+#endif
@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+/*
+   y = Relu(Reshape(x, shape))
+   x is larger than the inputs whose values are recorded by x86 kernels, so that running again with new values of x
+   and the same `shape` reuses output shapes of the last run without calling Reshape() of the kernels.
+*/
+static void RunReshapeRelu(X86GraphRunner* runner, const vector<int64_t>& x_dims, const vector<float>& x,
+                           const vector<int64_t>& shape, const vector<int64_t>& expected_dims) {
+    ASSERT_EQ(RC_SUCCESS, runner->SetInputData("x", x_dims, x.data()));
+    ASSERT_EQ(RC_SUCCESS, runner->SetInputData("shape", {(int64_t)shape.size()}, shape.data()));
+    ASSERT_EQ(RC_SUCCESS, runner->Run());
+
+    vector<float> y;
+    vector<int64_t> y_dims;
+    ASSERT_EQ(RC_SUCCESS, runner->GetOutputData("y", &y, &y_dims));
+    EXPECT_EQ(expected_dims, y_dims);
+    ASSERT_EQ(x.size(), y.size());
+    for (uint32_t i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(x[i] > 0.0f ? x[i] : 0.0f, y[i]) << "at " << i;
+    }
+}
+
+static vector<float> MakeData(uint32_t size, float offset) {
+    vector<float> data(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        data[i] = (float)i - offset;
+    }
+    return data;
+}
+
+TEST(ReshapeSkipTest, reuse_shapes_of_last_run) {
+    X86GraphRunner runner("reshape_relu");
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("x", DATATYPE_FLOAT32, {4, 16}));
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("shape", DATATYPE_INT64, {2}));
+    ASSERT_EQ(RC_SUCCESS, runner.AddNode("reshape", ir::Node::Type("", "Reshape", 5), {"x", "shape"}, {"r"}));
+    ASSERT_EQ(RC_SUCCESS, runner.AddNode("relu", ir::Node::Type("", "Relu", 6), {"r"}, {"y"}));
+    ASSERT_EQ(RC_SUCCESS, runner.AddOutput("y"));
+    ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+    const vector<float> x0 = MakeData(64, 10.0f);
+    const vector<float> x1 = MakeData(64, 50.0f);
+    const vector<float> x2 = MakeData(32, 7.0f);
+
+    RunReshapeRelu(&runner, {4, 16}, x0, {8, 8}, {8, 8});
+    // same shapes, other values of x: shapes of the last run are reused
+    RunReshapeRelu(&runner, {4, 16}, x1, {8, 8}, {8, 8});
+    RunReshapeRelu(&runner, {4, 16}, x0, {8, 8}, {8, 8});
+    // same dims of `shape` with other values
+    RunReshapeRelu(&runner, {4, 16}, x1, {16, 4}, {16, 4});
+    // other dims of x
+    RunReshapeRelu(&runner, {2, 16}, x2, {-1, 8}, {4, 8});
+    RunReshapeRelu(&runner, {4, 16}, x0, {-1, 8}, {8, 8});
+    RunReshapeRelu(&runner, {4, 16}, x1, {8, 8}, {8, 8});
+}
+
+#endif
@@ -0,0 +1,284 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/params/onnx/gru_param.h"
+#include "ppl/nn/params/onnx/lstm_param.h"
+#include "ppl/kernel/x86/fp32/gru.h"
+#include "ppl/kernel/x86/fp32/lstm.h"
+#include "gtest/gtest.h"
+#include <float.h>
+#include <math.h>
+#include <vector>
+using namespace std;
+using namespace ppl::common;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+
+// values in [-0.5, 0.5) keep the gates out of saturation
+static vector<float> GateData(int64_t count, uint32_t seed) {
+    return RandomData(count, seed, -0.5f, 0.5f);
+}
+
+static void ExpectNear(const vector<float>& expected, const vector<float>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(expected[i], actual[i], 1e-4) << "at " << i;
+    }
+}
+
+/*
+   x: (seq_len, batch, input_size), with hidden units not a multiple of the packed panel (8).
+   rows of the batch stop at different lengths if `short_sequences` is true.
+*/
+struct RNNCase final {
+    ppl::kernel::x86::rnn_direction_t direction;
+    bool short_sequences;
+    int64_t seq_len = 5;
+    int64_t batch = 3;
+    int64_t input_size = 7;
+    int64_t hidden_size = 19;
+
+    int64_t GetDirectionCount() const {
+        return (direction == ppl::kernel::x86::rnn_direction::BIDIRECTIONAL) ? 2 : 1;
+    }
+    vector<int32_t> GetSequenceLens() const {
+        return vector<int32_t>{(int32_t)seq_len, 2, 1};
+    }
+    TensorShape GetXShape() const {
+        TensorShape shape;
+        shape.SetDataType(DATATYPE_FLOAT32);
+        shape.SetDataFormat(DATAFORMAT_NDARRAY);
+        shape.Reshape({seq_len, batch, input_size});
+        return shape;
+    }
+};
+
+/** @brief inputs of a GRU or LSTM in the order of onnx, from W. empty ones are skipped. */
+struct RNNWeight final {
+    string name;
+    vector<int64_t> dims;
+    vector<float> data;
+};
+
+/*
+   builds a graph of one `type` node, whose weights are constants (packed at optimize time) or inputs (packed at
+   runtime), runs it and returns outputs in `outputs`.
+*/
+static void RunRNN(const string& type, const shared_ptr<void>& param, const RNNCase& c,
+                   const vector<RNNWeight>& weights, bool constant_weights, const vector<float>& x,
+                   const vector<int32_t>* sequence_lens, const vector<RNNWeight>& states,
+                   const vector<string>& output_names, vector<vector<float>>* outputs) {
+    X86GraphRunner runner("rnn");
+    const vector<int64_t> x_dims{c.seq_len, c.batch, c.input_size};
+    const vector<int64_t> lens_dims{c.batch};
+    ASSERT_EQ(RC_SUCCESS, runner.AddInput("x", DATATYPE_FLOAT32, x_dims));
+    if (sequence_lens) {
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput("sequence_lens", DATATYPE_INT32, lens_dims));
+    }
+    for (auto& s : states) {
+        ASSERT_EQ(RC_SUCCESS, runner.AddInput(s.name, DATATYPE_FLOAT32, s.dims));
+    }
+
+    // X, W, R, B, sequence_lens, initial_h, [initial_c, P]
+    vector<string> inputs{"x"};
+    for (auto& w : weights) {
+        if (w.name == "sequence_lens") {
+            inputs.push_back(sequence_lens ? w.name : "");
+            continue;
+        }
+        if (w.data.empty()) {
+            inputs.push_back(w.name.empty() ? "" : w.name);
+            continue;
+        }
+        if (constant_weights) {
+            ASSERT_EQ(RC_SUCCESS, runner.AddConstant(w.name, DATATYPE_FLOAT32, w.dims, w.data.data()));
+        } else {
+            ASSERT_EQ(RC_SUCCESS, runner.AddInput(w.name, DATATYPE_FLOAT32, w.dims));
+        }
+        inputs.push_back(w.name);
+    }
+    while (!inputs.empty() && inputs.back().empty()) {
+        inputs.pop_back();
+    }
+
+    ASSERT_EQ(RC_SUCCESS, runner.AddNode("rnn", ir::Node::Type("", type, 7), inputs, output_names, param));
+    for (auto& name : output_names) {
+        ASSERT_EQ(RC_SUCCESS, runner.AddOutput(name));
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.Build());
+
+    ASSERT_EQ(RC_SUCCESS, runner.SetInputData("x", x_dims, x.data()));
+    if (sequence_lens) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData("sequence_lens", lens_dims, sequence_lens->data()));
+    }
+    for (auto& s : states) {
+        ASSERT_EQ(RC_SUCCESS, runner.SetInputData(s.name, s.dims, s.data.data()));
+    }
+    if (!constant_weights) {
+        for (auto& w : weights) {
+            if (!w.data.empty()) {
+                ASSERT_EQ(RC_SUCCESS, runner.SetInputData(w.name, w.dims, w.data.data()));
+            }
+        }
+    }
+    ASSERT_EQ(RC_SUCCESS, runner.Run());
+
+    outputs->resize(output_names.size());
+    for (size_t i = 0; i < output_names.size(); ++i) {
+        ASSERT_EQ(RC_SUCCESS, runner.GetOutputData(output_names[i], &outputs->at(i)));
+    }
+}
+
+static void TestGRU(const RNNCase& c, bool linear_before_reset) {
+    const int64_t num_direction = c.GetDirectionCount();
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::GRU;
+    const int64_t hidden_size = c.hidden_size;
+    const vector<RNNWeight> weights{
+        {"W", {num_direction, num_gate * hidden_size, c.input_size},
+         GateData(num_direction * num_gate * hidden_size * c.input_size, 1)},
+        {"R", {num_direction, num_gate * hidden_size, hidden_size},
+         GateData(num_direction * num_gate * hidden_size * hidden_size, 2)},
+        {"B", {num_direction, 2 * num_gate * hidden_size}, GateData(num_direction * 2 * num_gate * hidden_size, 3)},
+        {"sequence_lens", {}, {}},
+        {"initial_h", {}, {}},
+    };
+    const vector<RNNWeight> states{
+        {"initial_h", {num_direction, c.batch, hidden_size}, GateData(num_direction * c.batch * hidden_size, 4)},
+    };
+    const auto x = GateData(c.seq_len * c.batch * c.input_size, 5);
+    const auto sequence_lens = c.GetSequenceLens();
+    const int32_t* lens = c.short_sequences ? sequence_lens.data() : nullptr;
+
+    auto param = make_shared<ppl::nn::common::GRUParam>();
+    param->clip = FLT_MAX;
+    param->direction = (ppl::nn::common::GRUParam::direction_t)c.direction;
+    param->hidden_size = hidden_size;
+    param->linear_before_reset = linear_before_reset;
+
+    auto x_shape = c.GetXShape();
+    vector<float> y(c.seq_len * num_direction * c.batch * hidden_size);
+    vector<float> y_h(num_direction * c.batch * hidden_size);
+    vector<char> tmp(ppl::kernel::x86::gru_ref_fp32_get_buffer_bytes(&x_shape, c.direction, hidden_size, true, true));
+    ASSERT_EQ(RC_SUCCESS,
+              ppl::kernel::x86::gru_ref_fp32(&x_shape, x.data(), weights[0].data.data(), weights[1].data.data(),
+                                             weights[2].data.data(), lens, states[0].data.data(), c.direction,
+                                             hidden_size, linear_before_reset, tmp.data(), y.data(), y_h.data()));
+
+    for (int constant_weights = 0; constant_weights < 2; ++constant_weights) {
+        vector<vector<float>> outputs;
+        RunRNN("GRU", param, c, weights, constant_weights, x, c.short_sequences ? &sequence_lens : nullptr, states,
+               {"y", "y_h"}, &outputs);
+        ASSERT_EQ(2u, outputs.size());
+        ExpectNear(y, outputs[0]);
+        ExpectNear(y_h, outputs[1]);
+    }
+}
+
+static void TestLSTM(const RNNCase& c, bool has_peephole) {
+    const int64_t num_direction = c.GetDirectionCount();
+    const int64_t num_gate = ppl::kernel::x86::rnn_num_gate::LSTM;
+    const int64_t hidden_size = c.hidden_size;
+    const vector<RNNWeight> weights{
+        {"W", {num_direction, num_gate * hidden_size, c.input_size},
+         GateData(num_direction * num_gate * hidden_size * c.input_size, 1)},
+        {"R", {num_direction, num_gate * hidden_size, hidden_size},
+         GateData(num_direction * num_gate * hidden_size * hidden_size, 2)},
+        {"B", {num_direction, 2 * num_gate * hidden_size}, GateData(num_direction * 2 * num_gate * hidden_size, 3)},
+        {"sequence_lens", {}, {}},
+        {"initial_h", {}, {}},
+        {"initial_c", {}, {}},
+        {has_peephole ? "P" : "", {num_direction, 3 * hidden_size},
+         has_peephole ? GateData(num_direction * 3 * hidden_size, 4) : vector<float>()},
+    };
+    const vector<RNNWeight> states{
+        {"initial_h", {num_direction, c.batch, hidden_size}, GateData(num_direction * c.batch * hidden_size, 5)},
+        {"initial_c", {num_direction, c.batch, hidden_size}, GateData(num_direction * c.batch * hidden_size, 6)},
+    };
+    const auto x = GateData(c.seq_len * c.batch * c.input_size, 7);
+    const auto sequence_lens = c.GetSequenceLens();
+    const int32_t* lens = c.short_sequences ? sequence_lens.data() : nullptr;
+
+    auto param = make_shared<ppl::nn::common::LSTMParam>();
+    param->clip = FLT_MAX;
+    param->direction = (ppl::nn::common::LSTMParam::direction_t)c.direction;
+    param->hidden_size = hidden_size;
+    param->input_forget = 0;
+
+    auto x_shape = c.GetXShape();
+    vector<float> y(c.seq_len * num_direction * c.batch * hidden_size);
+    vector<float> y_h(num_direction * c.batch * hidden_size);
+    vector<float> y_c(num_direction * c.batch * hidden_size);
+    vector<char> tmp(
+        ppl::kernel::x86::lstm_ref_fp32_get_buffer_bytes(&x_shape, c.direction, hidden_size, true, true, true));
+    ASSERT_EQ(RC_SUCCESS,
+              ppl::kernel::x86::lstm_ref_fp32(
+                  &x_shape, x.data(), weights[0].data.data(), weights[1].data.data(),
+                  has_peephole ? weights[6].data.data() : nullptr, weights[2].data.data(), lens,
+                  states[0].data.data(), states[1].data.data(), c.direction, hidden_size, tmp.data(), y.data(),
+                  y_h.data(), y_c.data()));
+
+    for (int constant_weights = 0; constant_weights < 2; ++constant_weights) {
+        vector<vector<float>> outputs;
+        RunRNN("LSTM", param, c, weights, constant_weights, x, c.short_sequences ? &sequence_lens : nullptr, states,
+               {"y", "y_h", "y_c"}, &outputs);
+        ASSERT_EQ(3u, outputs.size());
+        ExpectNear(y, outputs[0]);
+        ExpectNear(y_h, outputs[1]);
+        ExpectNear(y_c, outputs[2]);
+    }
+}
+
+static const ppl::kernel::x86::rnn_direction_t g_directions[] = {
+    ppl::kernel::x86::rnn_direction::FORWARD,
+    ppl::kernel::x86::rnn_direction::REVERSE,
+    ppl::kernel::x86::rnn_direction::BIDIRECTIONAL,
+};
+
+TEST(RNNTest, gru) {
+    for (auto direction : g_directions) {
+        for (int linear_before_reset = 0; linear_before_reset < 2; ++linear_before_reset) {
+            for (int short_sequences = 0; short_sequences < 2; ++short_sequences) {
+                SCOPED_TRACE("direction " + to_string(direction) + ", linear_before_reset " +
+                             to_string(linear_before_reset) + ", short_sequences " + to_string(short_sequences));
+                RNNCase c;
+                c.direction = direction;
+                c.short_sequences = short_sequences;
+                TestGRU(c, linear_before_reset);
+            }
+        }
+    }
+}
+
+TEST(RNNTest, lstm) {
+    for (auto direction : g_directions) {
+        for (int has_peephole = 0; has_peephole < 2; ++has_peephole) {
+            for (int short_sequences = 0; short_sequences < 2; ++short_sequences) {
+                SCOPED_TRACE("direction " + to_string(direction) + ", has_peephole " + to_string(has_peephole) +
+                             ", short_sequences " + to_string(short_sequences));
+                RNNCase c;
+                c.direction = direction;
+                c.short_sequences = short_sequences;
+                TestLSTM(c, has_peephole);
+            }
+        }
+    }
+}
+
+#endif
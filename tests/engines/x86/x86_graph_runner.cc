@@ -0,0 +1,318 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifdef PPLNN_USE_X86
+
+#include "tests/engines/x86/x86_graph_runner.h"
+#include "ppl/nn/engines/x86/engine_factory.h"
+#include "ppl/nn/ir/full_graph_topo.h"
+#include "ppl/nn/optimizers/utils.h"
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
+#include "ppl/nn/runtime/runtime_impl.h"
+#include "ppl/nn/common/logger.h"
+#include <random>
+#include <set>
+using namespace std;
+using namespace ppl::common;
+
+namespace ppl { namespace nn { namespace test {
+
+X86GraphRunner::X86GraphRunner(const string& graph_name) {
+    graph_.topo = make_shared<ir::FullGraphTopo>(graph_name);
+    graph_.data = make_shared<ir::GraphData>();
+}
+
+X86GraphRunner::~X86GraphRunner() {
+    runtime_.reset();
+    aux_info_.reset();
+    graph_info_.reset();
+    resource_.reset();
+    engine_.reset();
+}
+
+RetCode X86GraphRunner::AddNode(const string& name, const ir::Node::Type& type, const vector<string>& inputs,
+                                const vector<string>& outputs, const shared_ptr<void>& param) {
+    auto topo = graph_.topo.get();
+    auto ret_pair = topo->AddNode(name);
+    if (!ret_pair.second) {
+        LOG(ERROR) << "node[" << name << "] already exists.";
+        return RC_EXISTS;
+    }
+    auto node = ret_pair.first;
+    node->SetType(type);
+
+    for (auto x = inputs.begin(); x != inputs.end(); ++x) {
+        if (x->empty()) { // optional inputs
+            node->AddInput(INVALID_EDGEID);
+            continue;
+        }
+        auto edge = topo->AddEdge(*x).first;
+        node->AddInput(edge->GetId());
+        edge->AddConsumer(node->GetId());
+    }
+
+    for (auto x = outputs.begin(); x != outputs.end(); ++x) {
+        auto edge = topo->AddEdge(*x).first;
+        if (edge->GetProducer() != INVALID_NODEID) {
+            LOG(ERROR) << "output[" << *x << "] already exists.";
+            return RC_EXISTS;
+        }
+        node->AddOutput(edge->GetId());
+        edge->SetProducer(node->GetId());
+    }
+
+    if (param) {
+        graph_.data->attrs[node->GetId()] = param;
+    }
+
+    return RC_SUCCESS;
+}
+
+RetCode X86GraphRunner::AddInput(const string& name, datatype_t data_type, const vector<int64_t>& dims) {
+    auto edge = graph_.topo->AddEdge(name).first;
+    inputs_.push_back(name);
+    auto& shape = graph_.data->shapes[edge->GetId()];
+    shape.data_type = data_type;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+    return RC_SUCCESS;
+}
+
+RetCode X86GraphRunner::AddConstant(const string& name, datatype_t data_type, const vector<int64_t>& dims,
+                                    const void* data) {
+    auto edge = graph_.topo->AddEdge(name).first;
+    auto& shape = graph_.data->shapes[edge->GetId()];
+    shape.data_type = data_type;
+    shape.data_format = DATAFORMAT_NDARRAY;
+    shape.dims = dims;
+
+    uint64_t bytes = GetSizeOfDataType(data_type);
+    for (auto d = dims.begin(); d != dims.end(); ++d) {
+        bytes *= *d;
+    }
+    graph_.data->constants[edge->GetId()].data = string((const char*)data, bytes);
+    return RC_SUCCESS;
+}
+
+RetCode X86GraphRunner::AddOutput(const string& name) {
+    outputs_.push_back(name);
+    return RC_SUCCESS;
+}
+
+RetCode X86GraphRunner::Finalize() {
+    if (is_finalized_) {
+        return RC_SUCCESS;
+    }
+
+    auto topo = graph_.topo.get();
+    set<edgeid_t> inputs, outputs;
+    for (auto x = inputs_.begin(); x != inputs_.end(); ++x) {
+        auto edge = topo->GetEdgeByName(*x);
+        topo->MarkAsInput(edge->GetId());
+        inputs.insert(edge->GetId());
+    }
+    for (auto x = outputs_.begin(); x != outputs_.end(); ++x) {
+        auto edge = topo->GetEdgeByName(*x);
+        if (!edge) {
+            LOG(ERROR) << "cannot find output[" << *x << "]";
+            return RC_NOT_FOUND;
+        }
+        topo->MarkAsOutput(edge->GetId());
+        outputs.insert(edge->GetId());
+    }
+
+    for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+        auto edge = it->Get();
+        if (edge->GetProducer() == INVALID_NODEID) {
+            if (graph_.data->constants.find(edge->GetId()) != graph_.data->constants.end()) {
+                topo->MarkAsConstant(edge->GetId());
+            } else if (inputs.find(edge->GetId()) == inputs.end()) {
+                topo->MarkAsInput(edge->GetId());
+            }
+        }
+        if (edge->CalcConsumerCount() == 0 && outputs.find(edge->GetId()) == outputs.end()) {
+            topo->MarkAsOutput(edge->GetId());
+        }
+    }
+
+    is_finalized_ = true;
+    return RC_SUCCESS;
+}
+
+RetCode X86GraphRunner::Build(const X86EngineOptions& options, bool specialize_input_dims,
+                              const function<RetCode(Engine*)>& configure_engine) {
+    auto status = Finalize();
+    if (status != RC_SUCCESS) {
+        return status;
+    }
+
+    auto topo = graph_.topo.get();
+    engine_.reset(X86EngineFactory::Create(options));
+    if (!engine_) {
+        LOG(ERROR) << "create x86 engine failed.";
+        return RC_OTHER_ERROR;
+    }
+    if (configure_engine) {
+        status = configure_engine(engine_.get());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "configure engine failed: " << GetRetCodeStr(status);
+            return status;
+        }
+    }
+
+    resource_ = make_shared<utils::SharedResource>();
+    resource_->engines.push_back(static_cast<EngineImpl*>(engine_.get()));
+    resource_->graph_partitioner = make_shared<CostGraphPartitioner>();
+    if (specialize_input_dims) {
+        for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+            auto eid = topo->GetInput(i);
+            auto shape_ref = graph_.data->shapes.find(eid);
+            if (shape_ref != graph_.data->shapes.end()) {
+                resource_->fixed_input_dims[topo->GetEdgeById(eid)->GetName()] = shape_ref->second.dims;
+            }
+        }
+    }
+
+    graph_info_ = make_shared<RuntimeGraphInfo>();
+    status = utils::ProcessGraph(resource_.get(), &graph_, graph_info_.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "process graph failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    aux_info_ = make_shared<RuntimeAuxInfo>();
+    status = GenerateRuntimeAuxInfo(graph_.topo.get(), aux_info_.get());
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "GenerateRuntimeAuxInfo failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    auto runtime = new RuntimeImpl();
+    runtime_.reset(runtime);
+    status = runtime->Init(graph_.topo, graph_info_, aux_info_, resource_);
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "init runtime failed: " << GetRetCodeStr(status);
+        runtime_.reset();
+        return status;
+    }
+
+    return RC_SUCCESS;
+}
+
+Tensor* X86GraphRunner::FindTensor(const string& name, bool is_input) const {
+    if (!runtime_) {
+        return nullptr;
+    }
+    const uint32_t count = is_input ? runtime_->GetInputCount() : runtime_->GetOutputCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        auto tensor = is_input ? runtime_->GetInputTensor(i) : runtime_->GetOutputTensor(i);
+        if (name == tensor->GetName()) {
+            return tensor;
+        }
+    }
+    return nullptr;
+}
+
+RetCode X86GraphRunner::SetInputData(const string& name, const vector<int64_t>& dims, const void* data) {
+    auto tensor = FindTensor(name, true);
+    if (!tensor) {
+        LOG(ERROR) << "cannot find input[" << name << "]";
+        return RC_NOT_FOUND;
+    }
+
+    tensor->GetShape()->Reshape(dims);
+    auto status = tensor->ReallocBuffer();
+    if (status != RC_SUCCESS) {
+        LOG(ERROR) << "ReallocBuffer for tensor[" << name << "] failed: " << GetRetCodeStr(status);
+        return status;
+    }
+
+    TensorShape src_desc = *tensor->GetShape();
+    src_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    return tensor->ConvertFromHost(data, src_desc);
+}
+
+RetCode X86GraphRunner::Run() {
+    if (!runtime_) {
+        return RC_INVALID_VALUE;
+    }
+    return runtime_->Run();
+}
+
+RetCode X86GraphRunner::GetOutputData(const string& name, vector<char>* data, vector<int64_t>* dims) const {
+    auto tensor = FindTensor(name, false);
+    if (!tensor) {
+        LOG(ERROR) << "cannot find output[" << name << "]";
+        return RC_NOT_FOUND;
+    }
+
+    TensorShape dst_desc = *tensor->GetShape();
+    dst_desc.SetDataFormat(DATAFORMAT_NDARRAY);
+    data->resize(dst_desc.GetBytesExcludingPadding());
+    if (dims) {
+        dims->assign(dst_desc.GetDims(), dst_desc.GetDims() + dst_desc.GetDimCount());
+    }
+    if (data->empty()) {
+        return RC_SUCCESS;
+    }
+    return tensor->ConvertToHost(data->data(), dst_desc);
+}
+
+vector<float> RandomData(int64_t count, uint32_t seed, float min_value, float max_value) {
+    mt19937 rng(seed);
+    uniform_real_distribution<float> dist(min_value, max_value);
+    vector<float> data(count);
+    for (auto& v : data) {
+        v = dist(rng);
+    }
+    return data;
+}
+
+vector<float> RandomData(const vector<int64_t>& dims, uint32_t seed, float min_value, float max_value) {
+    int64_t count = 1;
+    for (auto d : dims) {
+        count *= d;
+    }
+    return RandomData(count, seed, min_value, max_value);
+}
+
+bool HasNode(const ir::Graph* graph, const string& domain, const string& type) {
+    auto topo = graph->topo.get();
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        auto& node_type = it->Get()->GetType();
+        if (node_type.domain == domain && node_type.name == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+X86OptRuleDisabler::X86OptRuleDisabler(const string& tag, const string& name) : tag_(tag), name_(name) {
+    auto mgr = x86::OptRuleManager::Instance();
+    rule_ = mgr->Find(tag, name);
+    mgr->Remove(tag, name);
+}
+
+X86OptRuleDisabler::~X86OptRuleDisabler() {
+    if (rule_) {
+        x86::OptRuleManager::Instance()->Register(tag_, name_, rule_);
+    }
+}
+
+}}} // namespace ppl::nn::test
+
+#endif
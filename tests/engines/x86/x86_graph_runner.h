@@ -0,0 +1,145 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef _ST_HPC_PPL_NN_TESTS_ENGINES_X86_X86_GRAPH_RUNNER_H_
+#define _ST_HPC_PPL_NN_TESTS_ENGINES_X86_X86_GRAPH_RUNNER_H_
+
+#ifdef PPLNN_USE_X86
+
+#include "ppl/nn/ir/graph.h"
+#include "ppl/nn/engines/engine.h"
+#include "ppl/nn/engines/x86/x86_engine_options.h"
+#include "ppl/nn/engines/x86/optimizer/opt_rule_manager.h"
+#include "ppl/nn/runtime/runtime.h"
+#include "ppl/nn/runtime/runtime_graph_info.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/utils/shared_resource.h"
+#include <functional>
+#include <memory>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace ppl { namespace nn { namespace test {
+
+/**
+   @class X86GraphRunner
+   @brief builds a graph node by node, optimizes it by the x86 engine and runs it like a model loaded from a file.
+   used to compare results of graphs with and without some optimizer rules.
+*/
+class X86GraphRunner final {
+public:
+    X86GraphRunner(const std::string& graph_name = "");
+    ~X86GraphRunner();
+
+    ir::Graph* GetGraph() {
+        return &graph_;
+    }
+
+    /** @brief `param` is the attribute of the node, e.g. a `ppl::nn::common::SoftmaxParam`. */
+    ppl::common::RetCode AddNode(const std::string& name, const ir::Node::Type& type,
+                                 const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+                                 const std::shared_ptr<void>& param = std::shared_ptr<void>());
+    ppl::common::RetCode AddInput(const std::string& name, ppl::common::datatype_t data_type,
+                                  const std::vector<int64_t>& dims);
+    ppl::common::RetCode AddConstant(const std::string& name, ppl::common::datatype_t data_type,
+                                     const std::vector<int64_t>& dims, const void* data);
+    /** @brief marks `name` as an output. outputs are in the order they are added. */
+    ppl::common::RetCode AddOutput(const std::string& name);
+
+    /**
+       @brief marks inputs, constants and outputs of the graph. inputs are those added by `AddInput()` in order,
+       followed by other edges without producers, and outputs are those added by `AddOutput()` in order, followed by
+       other edges without consumers. the graph can be used as a subgraph, e.g. the body of a Loop, afterwards.
+    */
+    ppl::common::RetCode Finalize();
+
+    /**
+       @brief finalizes and optimizes the graph and creates the runtime.
+       @param specialize_input_dims builds the graph for the dims passed to `AddInput()` only
+       @param configure_engine called with the engine before optimizing, e.g. to set files by `Engine::Configure()`
+    */
+    ppl::common::RetCode Build(const X86EngineOptions& options = X86EngineOptions(),
+                               bool specialize_input_dims = false,
+                               const std::function<ppl::common::RetCode(Engine*)>& configure_engine = nullptr);
+
+    Runtime* GetRuntime() const {
+        return runtime_.get();
+    }
+
+    /** @brief reshapes input `name` to `dims` and copies `data` in ndarray format into it */
+    ppl::common::RetCode SetInputData(const std::string& name, const std::vector<int64_t>& dims, const void* data);
+    ppl::common::RetCode Run();
+    /** @brief copies output `name` in ndarray format to `data` */
+    ppl::common::RetCode GetOutputData(const std::string& name, std::vector<char>* data,
+                                       std::vector<int64_t>* dims = nullptr) const;
+
+    template <typename T>
+    ppl::common::RetCode GetOutputData(const std::string& name, std::vector<T>* data,
+                                       std::vector<int64_t>* dims = nullptr) const {
+        std::vector<char> bytes;
+        auto status = GetOutputData(name, &bytes, dims);
+        if (status == ppl::common::RC_SUCCESS) {
+            data->resize(bytes.size() / sizeof(T));
+            memcpy(data->data(), bytes.data(), data->size() * sizeof(T));
+        }
+        return status;
+    }
+
+private:
+    Tensor* FindTensor(const std::string& name, bool is_input) const;
+
+private:
+    ir::Graph graph_;
+    bool is_finalized_ = false;
+    std::vector<std::string> inputs_;
+    std::vector<std::string> outputs_;
+    std::unique_ptr<Engine> engine_;
+    std::shared_ptr<utils::SharedResource> resource_;
+    std::shared_ptr<RuntimeGraphInfo> graph_info_;
+    std::shared_ptr<RuntimeAuxInfo> aux_info_;
+    std::unique_ptr<Runtime> runtime_;
+};
+
+/** @brief `count` floats uniformly distributed in [`min_value`, `max_value`). the same `seed` gives the same data. */
+std::vector<float> RandomData(int64_t count, uint32_t seed, float min_value = -1.0f, float max_value = 1.0f);
+/** @brief random data of a tensor of `dims`, see `RandomData()` above */
+std::vector<float> RandomData(const std::vector<int64_t>& dims, uint32_t seed, float min_value = -1.0f,
+                              float max_value = 1.0f);
+
+/** @brief tells whether `graph` has a node of type `domain`:`type` */
+bool HasNode(const ir::Graph* graph, const std::string& domain, const std::string& type);
+
+/**
+   @class X86OptRuleDisabler
+   @brief removes an x86 optimizer rule during its lifetime, so that a graph can be run without it.
+*/
+class X86OptRuleDisabler final {
+public:
+    X86OptRuleDisabler(const std::string& tag, const std::string& name);
+    ~X86OptRuleDisabler();
+
+private:
+    std::string tag_;
+    std::string name_;
+    x86::OptRule rule_;
+};
+
+}}} // namespace ppl::nn::test
+
+#endif
+#endif
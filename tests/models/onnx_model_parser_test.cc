@@ -16,9 +16,13 @@
 // under the License.
 
 #include "ppl/nn/models/onnx/model_parser.h"
+#include "ppl/nn/models/onnx/generated/onnx.pb.h"
 #include "ppl/common/file_mapping.h"
 #include "gtest/gtest.h"
 #include <string>
+#include <fstream>
+#include <string.h>
+#include <stdio.h>
 using namespace std;
 using namespace ppl::nn;
 using namespace ppl::common;
@@ -30,6 +34,96 @@ TEST_F(ModelParserTest, TestModelParser) {
     const string onnx_file = PPLNN_TESTDATA_DIR + string("/conv.onnx");
     FileMapping fm;
     EXPECT_EQ(RC_SUCCESS, fm.Init(onnx_file.c_str()));
-    auto res = onnx::ModelParser::Parse(fm.Data(), fm.Size(), &graph);
+    auto res = ppl::nn::onnx::ModelParser::Parse(fm.Data(), fm.Size(), PPLNN_TESTDATA_DIR, &graph);
     EXPECT_EQ(RC_SUCCESS, res);
 }
+
+// a model whose only initializer `w` of 2x3 floats is stored in `location` from `offset`
+static string SerializeExternalDataModel(const string& location, uint64_t offset) {
+    ::onnx::ModelProto pb_model;
+    pb_model.add_opset_import()->set_version(11);
+    auto pb_graph = pb_model.mutable_graph();
+    pb_graph->set_name("external_data");
+    auto pb_initializer = pb_graph->add_initializer();
+    pb_initializer->set_name("w");
+    pb_initializer->set_data_type(::onnx::TensorProto_DataType_FLOAT);
+    pb_initializer->add_dims(2);
+    pb_initializer->add_dims(3);
+    pb_initializer->set_data_location(::onnx::TensorProto_DataLocation_EXTERNAL);
+    auto entry = pb_initializer->add_external_data();
+    entry->set_key("location");
+    entry->set_value(location);
+    entry = pb_initializer->add_external_data();
+    entry->set_key("offset");
+    entry->set_value(to_string(offset));
+    pb_graph->add_output()->set_name("w");
+
+    string buf;
+    pb_model.SerializeToString(&buf);
+    return buf;
+}
+
+TEST_F(ModelParserTest, external_data) {
+    const string data_file = "onnx_model_parser_test_external.bin";
+    const vector<float> weights = {1, 2, 3, 4, 5, 6};
+    const uint64_t offset = 16;
+    {
+        ofstream ofs(data_file, ios_base::out | ios_base::binary | ios_base::trunc);
+        ofs << string(offset, '\0');
+        ofs.write((const char*)weights.data(), weights.size() * sizeof(float));
+    }
+
+    const string buf = SerializeExternalDataModel(data_file, offset);
+    ir::Graph graph;
+    auto status = ppl::nn::onnx::ModelParser::Parse(buf.data(), buf.size(), ".", &graph);
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    auto edge = graph.topo->GetEdgeByName("w");
+    ASSERT_NE(nullptr, edge);
+    auto& constant = graph.data->constants[edge->GetId()];
+    EXPECT_TRUE(constant.data.IsReference());
+    ASSERT_EQ(weights.size() * sizeof(float), constant.data.size());
+    EXPECT_EQ(0, memcmp(weights.data(), constant.data.data(), constant.data.size()));
+
+    auto& shape = graph.data->shapes[edge->GetId()];
+    EXPECT_EQ(DATATYPE_FLOAT32, shape.data_type);
+    EXPECT_EQ(vector<int64_t>({2, 3}), shape.dims);
+
+    // writing to the constant does not modify the file
+    ((float*)constant.data.data())[0] = 100;
+    graph = ir::Graph();
+    ifstream ifs(data_file, ios_base::in | ios_base::binary);
+    ifs.seekg(offset);
+    float first = 0;
+    ifs.read((char*)&first, sizeof(float));
+    EXPECT_EQ(weights[0], first);
+
+    remove(data_file.c_str());
+}
+
+TEST_F(ModelParserTest, reject_external_data_outside_model_dir) {
+    const string data_file = "onnx_model_parser_test_external.bin";
+    {
+        ofstream ofs(data_file, ios_base::out | ios_base::binary | ios_base::trunc);
+        ofs << string(6 * sizeof(float), '\0');
+    }
+
+    // the data file exists in the model dir "." but these locations are absolute or leave "."
+    const string invalid_locations[] = {
+        "/dev/zero",
+        "../" + data_file,
+        "sub/../../" + data_file,
+        "./sub/./../../" + data_file,
+    };
+    for (auto& location : invalid_locations) {
+        const string buf = SerializeExternalDataModel(location, 0);
+        ir::Graph graph;
+        EXPECT_NE(RC_SUCCESS, ppl::nn::onnx::ModelParser::Parse(buf.data(), buf.size(), ".", &graph)) << location;
+    }
+
+    const string buf = SerializeExternalDataModel("./" + data_file, 0);
+    ir::Graph graph;
+    EXPECT_EQ(RC_SUCCESS, ppl::nn::onnx::ModelParser::Parse(buf.data(), buf.size(), ".", &graph));
+
+    remove(data_file.c_str());
+}
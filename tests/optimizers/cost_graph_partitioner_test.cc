@@ -0,0 +1,211 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/optimizers/cost_graph_partitioner.h"
+
+#include "gtest/gtest.h"
+#include "tests/ir/graph_builder.h"
+#include "tests/engines/tmp_engine.h"
+
+#include <vector>
+#include <memory>
+#include <set>
+
+#ifdef PPLNN_USE_X86
+#include "ppl/nn/engines/x86/engine_factory.h"
+#endif
+
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+using namespace ppl::nn::test;
+
+class TestCostGraphPartitioner : public testing::Test {
+protected:
+    virtual void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.AddNode("b", ir::Node::Type("test", "op2", 1), {"output_of_a"}, {"output_of_b"});
+        builder_.AddNode("c", ir::Node::Type("test", "op1", 1), {"output_of_b"}, {"output_of_c"});
+        builder_.AddNode("d", ir::Node::Type("test", "op2", 1), {"output_of_c"}, {"output_of_d"});
+        builder_.Finalize();
+    }
+
+    GraphBuilder builder_;
+};
+
+TEST_F(TestCostGraphPartitioner, avoid_fragments) {
+    // TmpEngine supports all ops, but a first-fit assignment alternates between TmpEngine1 and TmpEngine2
+    TmpEngine1 engine1;
+    TmpEngine2 engine2;
+    TmpEngine engine;
+    vector<EngineImpl*> engines = {&engine1, &engine2, &engine};
+
+    CostGraphPartitioner partitioner;
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(engines, builder_.GetGraph()->topo.get(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(1, partitions.size());
+    EXPECT_EQ(string("TmpEngine"), partitions[0].first->GetName());
+    EXPECT_EQ(4, partitions[0].second.size());
+}
+
+class CheapConversionCostModel final : public PartitionCostModel {
+public:
+    double GetNodeCost(const EngineImpl* engine, const ir::Node*) const override {
+        return (string(engine->GetName()) == "TmpEngine") ? 10.0 : 1.0;
+    }
+    double GetConversionCost(const EngineImpl*, const EngineImpl*, const ir::Edge*) const override {
+        return 0.5;
+    }
+};
+
+TEST_F(TestCostGraphPartitioner, custom_cost_model) {
+    TmpEngine1 engine1;
+    TmpEngine2 engine2;
+    TmpEngine engine;
+    vector<EngineImpl*> engines = {&engine, &engine1, &engine2};
+
+    CostGraphPartitioner partitioner(make_shared<CheapConversionCostModel>());
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(engines, builder_.GetGraph()->topo.get(), &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(4, partitions.size());
+    for (auto& partition : partitions) {
+        EXPECT_NE(string("TmpEngine"), partition.first->GetName());
+    }
+}
+
+// engines other than TmpEngine are cheap but need expensive conversions, and op2 runs faster on TmpEngine2
+class GroupCostModel final : public PartitionCostModel {
+public:
+    double GetNodeCost(const EngineImpl* engine, const ir::Node* node) const override {
+        auto name = string(engine->GetName());
+        if (name == "TmpEngine") {
+            return 3.0;
+        }
+        return (name == "TmpEngine2") ? 0.5 : 1.0;
+    }
+    double GetConversionCost(const EngineImpl*, const EngineImpl*, const ir::Edge*) const override {
+        return 2.5;
+    }
+};
+
+static double CalcPartitionCost(const ir::GraphTopo* topo, const PartitionCostModel& cost_model,
+                                const vector<EngineImpl*>& node2engine) {
+    double cost = 0;
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        cost += cost_model.GetNodeCost(node2engine[it->Get()->GetId()], it->Get());
+    }
+    for (auto it = topo->CreateEdgeIter(); it->IsValid(); it->Forward()) {
+        auto edge = it->Get();
+        if (edge->GetProducer() == INVALID_NODEID) {
+            continue;
+        }
+        auto producer_engine = node2engine[edge->GetProducer()];
+        set<EngineImpl*> consumer_engines;
+        for (auto c = edge->CreateConsumerIter(); c.IsValid(); c.Forward()) {
+            if (node2engine[c.Get()] != producer_engine) {
+                consumer_engines.insert(node2engine[c.Get()]);
+            }
+        }
+        for (auto engine : consumer_engines) {
+            cost += cost_model.GetConversionCost(producer_engine, engine, edge);
+        }
+    }
+    return cost;
+}
+
+TEST(TestCostGraphPartitioner, move_groups_with_shared_edges) {
+    // outputs of a and c are consumed by nodes of both groups
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("test", "op1", 1), {"in"}, {"out_a"});
+    builder.AddNode("b", ir::Node::Type("test", "op2", 1), {"out_a"}, {"out_b"});
+    builder.AddNode("c", ir::Node::Type("test", "op1", 1), {"out_a", "out_b"}, {"out_c"});
+    builder.AddNode("d", ir::Node::Type("test", "op2", 1), {"out_c", "out_a"}, {"out_d"});
+    builder.AddNode("e", ir::Node::Type("test", "op2", 1), {"out_c", "out_d"}, {"out_e"});
+    builder.Finalize();
+    auto topo = builder.GetGraph()->topo.get();
+
+    TmpEngine1 engine1;
+    TmpEngine2 engine2;
+    TmpEngine engine;
+    vector<EngineImpl*> engines = {&engine, &engine1, &engine2};
+    GroupCostModel cost_model;
+
+    // exhaustive search for the best assignment
+    vector<nodeid_t> nids;
+    for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+        nids.push_back(it->Get()->GetId());
+    }
+    vector<EngineImpl*> node2engine(topo->GetMaxNodeId(), nullptr);
+    double best_cost = -1;
+    for (uint32_t mask = 0; mask < (1u << nids.size()); ++mask) {
+        for (uint32_t i = 0; i < nids.size(); ++i) {
+            auto node = topo->GetNodeById(nids[i]);
+            if (mask & (1u << i)) {
+                node2engine[nids[i]] = &engine;
+            } else {
+                node2engine[nids[i]] = engine1.Supports(node) ? (EngineImpl*)&engine1 : (EngineImpl*)&engine2;
+            }
+        }
+        auto cost = CalcPartitionCost(topo, cost_model, node2engine);
+        if (best_cost < 0 || cost < best_cost) {
+            best_cost = cost;
+        }
+    }
+
+    CostGraphPartitioner partitioner(make_shared<GroupCostModel>());
+    vector<pair<EngineImpl*, vector<nodeid_t>>> partitions;
+    auto status = partitioner.Partition(engines, topo, &partitions);
+    EXPECT_EQ(RC_SUCCESS, status);
+    for (auto& partition : partitions) {
+        for (auto nid : partition.second) {
+            node2engine[nid] = partition.first;
+        }
+    }
+    EXPECT_NEAR(best_cost, CalcPartitionCost(topo, cost_model, node2engine), 1e-9);
+}
+
+TEST(TestCostGraphPartitioner, default_costs_in_common_unit) {
+    GraphBuilder builder;
+    builder.AddNode("matmul", ir::Node::Type("", "MatMul", 11), {"a", "b"}, {"c"});
+    builder.AddNode("add", ir::Node::Type("", "Add", 11), {"c", "d"}, {"e"});
+    builder.Finalize();
+    auto topo = builder.GetGraph()->topo.get();
+    auto matmul = topo->GetNodeByName("matmul");
+    auto add = topo->GetNodeByName("add");
+
+    TmpEngine engine;
+    EXPECT_DOUBLE_EQ(1.0, engine.EstimateNodeCost(add));
+    EXPECT_DOUBLE_EQ(EngineImpl::EstimateNodeWork(matmul), engine.EstimateNodeCost(matmul));
+    EXPECT_GT(engine.EstimateNodeCost(matmul), engine.EstimateNodeCost(add));
+
+#ifdef PPLNN_USE_X86
+    // fp32 x86 is the reference, so that its costs equal those of engines without estimations
+    unique_ptr<Engine> x86_engine(X86EngineFactory::Create(X86EngineOptions()));
+    auto x86_engine_impl = static_cast<EngineImpl*>(x86_engine.get());
+    EXPECT_DOUBLE_EQ(engine.EstimateNodeCost(matmul), x86_engine_impl->EstimateNodeCost(matmul));
+    EXPECT_DOUBLE_EQ(engine.EstimateNodeCost(add), x86_engine_impl->EstimateNodeCost(add));
+
+    X86EngineOptions bf16_options;
+    bf16_options.forward_precision = DATATYPE_BFLOAT16;
+    unique_ptr<Engine> bf16_engine(X86EngineFactory::Create(bf16_options));
+    auto bf16_engine_impl = static_cast<EngineImpl*>(bf16_engine.get());
+    EXPECT_LT(bf16_engine_impl->EstimateNodeCost(matmul), x86_engine_impl->EstimateNodeCost(matmul));
+    EXPECT_DOUBLE_EQ(x86_engine_impl->EstimateNodeCost(add), bf16_engine_impl->EstimateNodeCost(add));
+#endif
+}
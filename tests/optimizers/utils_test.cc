@@ -19,6 +19,7 @@
 #include "tests/ir/graph_builder.h"
 #include "tests/engines/tmp_engine.h"
 #include "ppl/nn/optimizers/utils.h"
+#include "ppl/nn/engines/utils.h"
 #include "ppl/nn/auxtools/to_graphviz.h"
 #include "ppl/nn/optimizers/special_type_graph_partitioner.h"
 #include "ppl/nn/common/logger.h"
@@ -171,3 +172,77 @@ TEST_F(OptimizerUtilsTest, partition_sorting) {
     }
 }
 #endif
+
+// replaces outputs of "op1" nodes with constants when processing graphs, like folding by engines
+class TmpFoldingEngine final : public EngineImpl {
+public:
+    TmpFoldingEngine() : EngineImpl("TmpFoldingEngine") {}
+    ppl::common::RetCode Configure(uint32_t, ...) override {
+        return ppl::common::RC_UNSUPPORTED;
+    }
+    EngineContext* CreateEngineContext() override {
+        return new TmpEngineContext();
+    }
+    bool Supports(const ir::Node* node) const override {
+        return (node->GetType().name == "op1");
+    }
+    ppl::common::RetCode ProcessGraph(utils::SharedResource*, ir::Graph* graph, RuntimePartitionInfo* info) override {
+        auto topo = graph->topo.get();
+        vector<nodeid_t> nodes;
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            nodes.push_back(it->Get()->GetId());
+        }
+        for (auto x = nodes.begin(); x != nodes.end(); ++x) {
+            auto node = topo->GetNodeById(*x);
+            if (node->GetType().name != "op1") {
+                info->kernels.emplace(node->GetId(), unique_ptr<OptKernel>(new TmpOptKernelOne(node)));
+                continue;
+            }
+
+            auto eid = node->GetOutput(0);
+            graph->data->constants[eid].data = string(sizeof(float), '\0');
+            auto& shape = graph->data->shapes[eid];
+            shape.data_type = DATATYPE_FLOAT32;
+            shape.data_format = DATAFORMAT_NDARRAY;
+            shape.dims = {1};
+            topo->MarkAsConstant(eid);
+            topo->GetEdgeById(eid)->SetProducer(INVALID_NODEID);
+            for (uint32_t i = 0; i < node->GetInputCount(); ++i) {
+                topo->GetEdgeById(node->GetInput(i))->DelConsumer(node->GetId());
+            }
+            topo->DelNodeById(node->GetId());
+        }
+        return utils::LoadConstants(*graph, &device_, &info->constants);
+    }
+
+private:
+    utils::GenericCpuDevice device_;
+};
+
+TEST_F(OptimizerUtilsTest, constants_created_by_engines) {
+    GraphBuilder builder;
+    builder.AddNode("a", ir::Node::Type("test", "op2", 1), {"in1"}, {"out1"});
+    builder.AddNode("b", ir::Node::Type("test", "op1", 1), {"out1"}, {"out2"});
+    builder.AddNode("c", ir::Node::Type("test", "op2", 1), {"out1", "out2"}, {"out3"});
+    builder.Finalize();
+
+    auto graph = builder.GetGraph();
+    auto topo = graph->topo.get();
+
+    TmpFoldingEngine folding_engine;
+    resource_->engines[0] = &folding_engine;
+
+    auto graph_info = make_shared<RuntimeGraphInfo>();
+    auto status = utils::ProcessGraph(resource_.get(), graph, graph_info.get());
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    auto edge_out2 = topo->GetEdgeByName("out2");
+    ASSERT_TRUE(edge_out2 != nullptr);
+    EXPECT_EQ(INVALID_NODEID, edge_out2->GetProducer());
+
+    bool is_constant = false;
+    for (uint32_t i = 0; i < topo->GetConstantCount(); ++i) {
+        is_constant = is_constant || (topo->GetConstant(i) == edge_out2->GetId());
+    }
+    EXPECT_TRUE(is_constant);
+}
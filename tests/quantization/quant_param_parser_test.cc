@@ -34,3 +34,44 @@ TEST(QuantParamParserTest, misc) {
     EXPECT_NE(item_iter->second.fields.end(), field_iter);
     EXPECT_EQ("KL", field_iter->second.content);
 }
+
+TEST(QuantParamParserTest, number_types) {
+    const char* buf = "{\"quant_info\": {\"x\": {\"tensor_max\": 1, \"tensor_min\": -0.5, \"per_channel\": false, "
+                      "\"algorithm\": \"KL\", \"scales\": [2, 0.25]}}}";
+    QuantParamParser parser;
+    QuantParamInfo info;
+    EXPECT_EQ(RC_SUCCESS, parser.ParseBuffer(buf, &info));
+
+    auto item_iter = info.tensor_params.find("x");
+    ASSERT_NE(info.tensor_params.end(), item_iter);
+    auto& fields = item_iter->second.fields;
+
+    double v = 0;
+    auto field_iter = fields.find("tensor_max");
+    ASSERT_NE(fields.end(), field_iter);
+    EXPECT_EQ(QuantParam::Value::TYPE_INT64, field_iter->second.type);
+    EXPECT_TRUE(field_iter->second.GetDouble(&v));
+    EXPECT_EQ(1.0, v);
+
+    field_iter = fields.find("tensor_min");
+    ASSERT_NE(fields.end(), field_iter);
+    EXPECT_EQ(QuantParam::Value::TYPE_DOUBLE, field_iter->second.type);
+    EXPECT_TRUE(field_iter->second.GetDouble(&v));
+    EXPECT_EQ(-0.5, v);
+
+    field_iter = fields.find("scales");
+    ASSERT_NE(fields.end(), field_iter);
+    EXPECT_EQ(QuantParam::Value::TYPE_DOUBLE_ARRAY, field_iter->second.type);
+    EXPECT_TRUE(field_iter->second.GetDouble(&v));
+    EXPECT_EQ(2.0, v);
+
+    field_iter = fields.find("algorithm");
+    ASSERT_NE(fields.end(), field_iter);
+    EXPECT_EQ(QuantParam::Value::TYPE_STRING, field_iter->second.type);
+    EXPECT_FALSE(field_iter->second.GetDouble(&v));
+
+    field_iter = fields.find("per_channel");
+    ASSERT_NE(fields.end(), field_iter);
+    EXPECT_EQ(QuantParam::Value::TYPE_BOOL, field_iter->second.type);
+    EXPECT_FALSE(field_iter->second.GetDouble(&v));
+}
@@ -0,0 +1,238 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/batch_runner_factory.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <memory>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+class HostTensor final : public Tensor {
+public:
+    HostTensor(const char* name) : name_(name) {
+        shape_.SetDataType(DATATYPE_FLOAT32);
+        shape_.SetDataFormat(DATAFORMAT_NDARRAY);
+    }
+    const char* GetName() const override {
+        return name_;
+    }
+    TensorShape* GetShape() const override {
+        return &shape_;
+    }
+    RetCode ReallocBuffer() override {
+        data_.resize(shape_.GetBytesIncludingPadding());
+        return RC_SUCCESS;
+    }
+    void FreeBuffer() override {
+        data_.clear();
+    }
+    RetCode CopyToHost(void* dst) const override {
+        memcpy(dst, data_.data(), data_.size());
+        return RC_SUCCESS;
+    }
+    RetCode CopyFromHost(const void* src) override {
+        memcpy(&data_[0], src, data_.size());
+        return RC_SUCCESS;
+    }
+    RetCode ConvertToHost(void* dst, const TensorShape&) const override {
+        return CopyToHost(dst);
+    }
+    RetCode ConvertFromHost(const void* src, const TensorShape&) override {
+        return CopyFromHost(src);
+    }
+    DeviceContext* GetDeviceContext() const override {
+        return nullptr;
+    }
+    void SetBufferPtr(void*) override {}
+    void* GetBufferPtr() const override {
+        return (void*)data_.data();
+    }
+
+private:
+    const char* name_;
+    mutable TensorShape shape_;
+    vector<char> data_;
+};
+
+// output = input * 2
+class DoubleRuntime final : public Runtime {
+public:
+    DoubleRuntime(vector<int64_t>* batch_sizes) : input_("input"), output_("output"), batch_sizes_(batch_sizes) {}
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+    uint32_t GetInputCount() const override {
+        return 1;
+    }
+    Tensor* GetInputTensor(uint32_t) const override {
+        return const_cast<HostTensor*>(&input_);
+    }
+    RetCode Run() override {
+        auto in_shape = input_.GetShape();
+        batch_sizes_->push_back(in_shape->GetDim(0));
+
+        output_.GetShape()->Reshape(in_shape->GetDims(), in_shape->GetDimCount());
+        output_.ReallocBuffer();
+        auto src = (const float*)input_.GetBufferPtr();
+        auto dst = (float*)output_.GetBufferPtr();
+        for (uint64_t i = 0; i < in_shape->GetElementsExcludingPadding(); ++i) {
+            dst[i] = src[i] * 2;
+        }
+        return RC_SUCCESS;
+    }
+    uint32_t GetOutputCount() const override {
+        return 1;
+    }
+    Tensor* GetOutputTensor(uint32_t) const override {
+        return const_cast<HostTensor*>(&output_);
+    }
+    uint32_t GetDeviceContextCount() const override {
+        return 0;
+    }
+    DeviceContext* GetDeviceContext(uint32_t) const override {
+        return nullptr;
+    }
+    RetCode GetProfilingStatistics(ProfilingStatistics*) const override {
+        return RC_UNSUPPORTED;
+    }
+
+private:
+    HostTensor input_;
+    HostTensor output_;
+    vector<int64_t>* batch_sizes_;
+};
+
+class DoubleRuntimeBuilder final : public RuntimeBuilder {
+public:
+    Runtime* CreateRuntime() override {
+        return new DoubleRuntime(&batch_sizes);
+    }
+    vector<int64_t> batch_sizes;
+};
+
+static BatchRequest MakeRequest(const float* data, int64_t sample_num, int64_t channels) {
+    BatchRequest req;
+    req.inputs.push_back(data);
+    req.input_shapes.resize(1);
+    req.input_shapes[0].SetDataType(DATATYPE_FLOAT32);
+    req.input_shapes[0].SetDataFormat(DATAFORMAT_NDARRAY);
+    req.input_shapes[0].Reshape({sample_num, channels});
+    return req;
+}
+
+TEST(BatchRunnerTest, batch_until_full) {
+    BatchRunnerOptions options;
+    options.max_batch_size = 4;
+    options.timeout_us = 10 * 1000 * 1000; // never expires in this test
+
+    DoubleRuntimeBuilder builder;
+    unique_ptr<BatchRunner> runner(BatchRunnerFactory::Create(&builder, options));
+    ASSERT_NE(nullptr, runner.get());
+    EXPECT_EQ(1, runner->GetInputCount());
+    EXPECT_EQ(1, runner->GetOutputCount());
+
+    const float data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    vector<future<BatchResult>> futures;
+    futures.push_back(runner->Submit(MakeRequest(data, 1, 2)));
+    futures.push_back(runner->Submit(MakeRequest(data + 2, 2, 2)));
+    futures.push_back(runner->Submit(MakeRequest(data + 6, 1, 2)));
+
+    for (uint32_t i = 0; i < futures.size(); ++i) {
+        auto result = futures[i].get();
+        EXPECT_EQ(RC_SUCCESS, result.status);
+        ASSERT_EQ(1, result.outputs.size());
+    }
+    ASSERT_EQ(1, builder.batch_sizes.size());
+    EXPECT_EQ(4, builder.batch_sizes[0]);
+}
+
+TEST(BatchRunnerTest, scatter_outputs) {
+    BatchRunnerOptions options;
+    options.max_batch_size = 3;
+    options.timeout_us = 10 * 1000 * 1000;
+
+    DoubleRuntimeBuilder builder;
+    unique_ptr<BatchRunner> runner(BatchRunnerFactory::Create(&builder, options));
+    ASSERT_NE(nullptr, runner.get());
+
+    const float data[] = {1, 2, 3, 4, 5, 6};
+    auto f0 = runner->Submit(MakeRequest(data, 2, 2));
+    auto f1 = runner->Submit(MakeRequest(data + 4, 1, 2));
+
+    auto r0 = f0.get();
+    EXPECT_EQ(RC_SUCCESS, r0.status);
+    EXPECT_EQ(2, r0.output_shapes[0].GetDim(0));
+    ASSERT_EQ(4 * sizeof(float), r0.outputs[0].size());
+    auto out0 = (const float*)r0.outputs[0].data();
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(data[i] * 2, out0[i]);
+    }
+
+    auto r1 = f1.get();
+    EXPECT_EQ(RC_SUCCESS, r1.status);
+    EXPECT_EQ(1, r1.output_shapes[0].GetDim(0));
+    ASSERT_EQ(2 * sizeof(float), r1.outputs[0].size());
+    auto out1 = (const float*)r1.outputs[0].data();
+    EXPECT_EQ(10, out1[0]);
+    EXPECT_EQ(12, out1[1]);
+}
+
+TEST(BatchRunnerTest, run_after_timeout) {
+    BatchRunnerOptions options;
+    options.max_batch_size = 16;
+    options.timeout_us = 1000;
+
+    DoubleRuntimeBuilder builder;
+    unique_ptr<BatchRunner> runner(BatchRunnerFactory::Create(&builder, options));
+    ASSERT_NE(nullptr, runner.get());
+
+    const float data[] = {1, 2};
+    auto result = runner->Submit(MakeRequest(data, 1, 2)).get();
+    EXPECT_EQ(RC_SUCCESS, result.status);
+    ASSERT_EQ(1, builder.batch_sizes.size());
+    EXPECT_EQ(1, builder.batch_sizes[0]);
+}
+
+TEST(BatchRunnerTest, incompatible_shapes) {
+    BatchRunnerOptions options;
+    options.max_batch_size = 2;
+    options.timeout_us = 1000;
+
+    DoubleRuntimeBuilder builder;
+    unique_ptr<BatchRunner> runner(BatchRunnerFactory::Create(&builder, options));
+    ASSERT_NE(nullptr, runner.get());
+
+    const float data[] = {1, 2, 3};
+    auto f0 = runner->Submit(MakeRequest(data, 1, 2));
+    auto f1 = runner->Submit(MakeRequest(data, 1, 3));
+    EXPECT_EQ(RC_SUCCESS, f0.get().status);
+    EXPECT_EQ(RC_SUCCESS, f1.get().status);
+    ASSERT_EQ(2, builder.batch_sizes.size());
+    EXPECT_EQ(1, builder.batch_sizes[0]);
+    EXPECT_EQ(1, builder.batch_sizes[1]);
+}
+
+TEST(BatchRunnerTest, invalid_request) {
+    DoubleRuntimeBuilder builder;
+    unique_ptr<BatchRunner> runner(BatchRunnerFactory::Create(&builder));
+    ASSERT_NE(nullptr, runner.get());
+
+    BatchRequest req;
+    EXPECT_NE(RC_SUCCESS, runner->Submit(req).get().status);
+}
@@ -0,0 +1,128 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/parallel_scheduler.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+#include <atomic>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class RecordingKernel final : public KernelImpl {
+public:
+    RecordingKernel(const ir::Node* node, atomic<uint32_t>* counter, vector<uint32_t>* nodeid2order)
+        : KernelImpl(node), counter_(counter), nodeid2order_(nodeid2order) {}
+
+    RetCode Execute(KernelExecContext* ctx) override {
+        for (uint32_t i = 0; i < ctx->GetInputCount(); ++i) {
+            auto input = ctx->GetInput<TensorImpl>(i);
+            if (!input) {
+                return RC_NOT_FOUND;
+            }
+        }
+        for (uint32_t i = 0; i < ctx->GetOutputCount(); ++i) {
+            auto output = ctx->GetOutput<TensorImpl>(i);
+            if (!output) {
+                return RC_NOT_FOUND;
+            }
+            output->GetShape()->SetDataType(DATATYPE_FLOAT32);
+            output->GetShape()->Reshape({16});
+            auto status = output->ReallocBuffer();
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+        }
+        nodeid2order_->at(GetNode()->GetId()) = counter_->fetch_add(1);
+        return RC_SUCCESS;
+    }
+
+private:
+    atomic<uint32_t>* counter_;
+    vector<uint32_t>* nodeid2order_;
+};
+
+class ParallelSchedulerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.AddNode("b", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_b"});
+        builder_.AddNode("c", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_c"});
+        builder_.AddNode("d", ir::Node::Type("test", "op1", 1), {"output_of_b", "output_of_c"}, {"output_of_d"});
+        builder_.Finalize();
+
+        auto topo = builder_.GetGraph()->topo.get();
+        GenerateRuntimeAuxInfo(topo, &aux_info_);
+
+        nodeid2order_.resize(topo->GetMaxNodeId());
+        graph_.nodeid2kernel.resize(topo->GetMaxNodeId());
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            auto kernel = new RecordingKernel(node, &counter_, &nodeid2order_);
+            kernel->SetDevice(&device_);
+            graph_.nodeid2kernel[node->GetId()].reset(kernel);
+        }
+
+        for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+            auto edge = topo->GetEdgeById(topo->GetInput(i));
+            auto ret_pair = graph_.tensors.insert(make_pair(edge->GetId(), TensorImpl(edge, TENSORTYPE_RESERVED)));
+            graph_.inputs.push_back(&ret_pair.first->second);
+        }
+        for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+            auto edge = topo->GetEdgeById(topo->GetOutput(i));
+            auto ret_pair = graph_.tensors.insert(make_pair(edge->GetId(), TensorImpl(edge, TENSORTYPE_RESERVED)));
+            ret_pair.first->second.SetDevice(&device_);
+            graph_.outputs.push_back(&ret_pair.first->second);
+        }
+
+        profiler_.Init(&conf_, &graph_, &aux_info_);
+    }
+
+protected:
+    GraphBuilder builder_;
+    utils::GenericCpuDevice device_;
+    RuntimeAuxInfo aux_info_;
+    RuntimeGraph graph_;
+    RuntimeInternalConf conf_;
+    Profiler profiler_;
+    atomic<uint32_t> counter_;
+    vector<uint32_t> nodeid2order_;
+};
+
+TEST_F(ParallelSchedulerTest, run) {
+    auto topo = builder_.GetGraph()->topo.get();
+
+    ParallelScheduler sched(3);
+    auto status = sched.Init(topo, &aux_info_, &graph_);
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    for (uint32_t iter = 0; iter < 16; ++iter) {
+        counter_ = 0;
+        status = sched.Run(&profiler_);
+        EXPECT_EQ(RC_SUCCESS, status);
+        EXPECT_EQ(topo->GetMaxNodeId(), counter_.load());
+
+        // a -> (b, c) -> d
+        EXPECT_EQ(0, nodeid2order_[0]);
+        EXPECT_LT(nodeid2order_[0], nodeid2order_[1]);
+        EXPECT_LT(nodeid2order_[0], nodeid2order_[2]);
+        EXPECT_EQ(3, nodeid2order_[3]);
+    }
+}
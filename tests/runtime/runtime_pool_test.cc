@@ -0,0 +1,130 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/runtime_pool_factory.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <set>
+#include <thread>
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::common;
+
+class DummyRuntime final : public Runtime {
+public:
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+    uint32_t GetInputCount() const override {
+        return 0;
+    }
+    Tensor* GetInputTensor(uint32_t) const override {
+        return nullptr;
+    }
+    RetCode Run() override {
+        return RC_SUCCESS;
+    }
+    uint32_t GetOutputCount() const override {
+        return 0;
+    }
+    Tensor* GetOutputTensor(uint32_t) const override {
+        return nullptr;
+    }
+    uint32_t GetDeviceContextCount() const override {
+        return 0;
+    }
+    DeviceContext* GetDeviceContext(uint32_t) const override {
+        return nullptr;
+    }
+    RetCode GetProfilingStatistics(ProfilingStatistics*) const override {
+        return RC_UNSUPPORTED;
+    }
+};
+
+class DummyRuntimeBuilder final : public RuntimeBuilder {
+public:
+    Runtime* CreateRuntime() override {
+        return new DummyRuntime();
+    }
+};
+
+TEST(RuntimePoolTest, acquire_and_release) {
+    const uint32_t runtime_num = 3;
+
+    DummyRuntimeBuilder builder;
+    unique_ptr<RuntimePool> pool(RuntimePoolFactory::Create(&builder, runtime_num));
+    EXPECT_NE(nullptr, pool.get());
+    EXPECT_EQ(runtime_num, pool->GetRuntimeCount());
+
+    set<Runtime*> runtimes;
+    for (uint32_t i = 0; i < runtime_num; ++i) {
+        auto runtime = pool->TryAcquire();
+        EXPECT_NE(nullptr, runtime);
+        runtimes.insert(runtime);
+    }
+    EXPECT_EQ(runtime_num, runtimes.size());
+    EXPECT_EQ(nullptr, pool->TryAcquire());
+
+    auto first = *runtimes.begin();
+    thread releaser([&pool, first]() -> void {
+        EXPECT_EQ(RC_SUCCESS, pool->Release(first));
+    });
+    auto runtime = pool->Acquire(); // blocks until `first` is released
+    releaser.join();
+    EXPECT_EQ(first, runtime);
+}
+
+TEST(RuntimePoolTest, empty_pool) {
+    DummyRuntimeBuilder builder;
+    unique_ptr<RuntimePool> pool(RuntimePoolFactory::Create(&builder, 0));
+    EXPECT_EQ(nullptr, pool.get());
+}
+
+TEST(RuntimePoolTest, release_foreign_runtime) {
+    DummyRuntimeBuilder builder;
+    unique_ptr<RuntimePool> pool(RuntimePoolFactory::Create(&builder, 1));
+    EXPECT_NE(nullptr, pool.get());
+
+    DummyRuntime foreign;
+    EXPECT_EQ(RC_INVALID_VALUE, pool->Release(&foreign));
+    EXPECT_EQ(RC_INVALID_VALUE, pool->Release(nullptr));
+
+    // the free list is untouched: the only runtime can be acquired exactly once
+    auto runtime = pool->TryAcquire();
+    EXPECT_NE(nullptr, runtime);
+    EXPECT_NE(&foreign, runtime);
+    EXPECT_EQ(nullptr, pool->TryAcquire());
+}
+
+TEST(RuntimePoolTest, release_twice) {
+    DummyRuntimeBuilder builder;
+    unique_ptr<RuntimePool> pool(RuntimePoolFactory::Create(&builder, 2));
+    EXPECT_NE(nullptr, pool.get());
+
+    auto runtime = pool->TryAcquire();
+    EXPECT_NE(nullptr, runtime);
+    EXPECT_EQ(RC_SUCCESS, pool->Release(runtime));
+    EXPECT_EQ(RC_INVALID_VALUE, pool->Release(runtime));
+
+    // an idle runtime that was never acquired cannot be released either
+    auto r0 = pool->TryAcquire();
+    auto r1 = pool->TryAcquire();
+    EXPECT_NE(nullptr, r0);
+    EXPECT_NE(nullptr, r1);
+    EXPECT_NE(r0, r1);
+    EXPECT_EQ(nullptr, pool->TryAcquire());
+}
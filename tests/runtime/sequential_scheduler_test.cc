@@ -0,0 +1,235 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/runtime/sequential_scheduler.h"
+#include "ppl/nn/runtime/runtime_aux_info.h"
+#include "ppl/nn/utils/generic_cpu_device.h"
+#include "tests/ir/graph_builder.h"
+#include "gtest/gtest.h"
+using namespace std;
+using namespace ppl::nn;
+using namespace ppl::nn::test;
+using namespace ppl::common;
+
+class CountingDevice final : public Device {
+public:
+    RetCode Realloc(uint64_t bytes, BufferDesc* buffer) override {
+        ++realloc_count;
+        return device_.Realloc(bytes, buffer);
+    }
+    RetCode Realloc(const TensorShape& shape, BufferDesc* buffer) override {
+        return Realloc(shape.GetBytesIncludingPadding(), buffer);
+    }
+    void Free(BufferDesc* buffer) override {
+        device_.Free(buffer);
+    }
+    RetCode CopyFromHost(BufferDesc* dst, const void* src, uint64_t bytes) const override {
+        return device_.CopyFromHost(dst, src, bytes);
+    }
+    RetCode CopyFromHost(BufferDesc* dst, const void* src, const TensorShape& shape) const override {
+        return device_.CopyFromHost(dst, src, shape);
+    }
+    RetCode CopyToHost(void* dst, const BufferDesc& src, uint64_t bytes) const override {
+        return device_.CopyToHost(dst, src, bytes);
+    }
+    RetCode CopyToHost(void* dst, const BufferDesc& src, const TensorShape& shape) const override {
+        return device_.CopyToHost(dst, src, shape);
+    }
+    RetCode Copy(BufferDesc* dst, const BufferDesc& src, uint64_t bytes) const override {
+        return device_.Copy(dst, src, bytes);
+    }
+    RetCode Copy(BufferDesc* dst, const BufferDesc& src, const TensorShape& shape) const override {
+        return device_.Copy(dst, src, shape);
+    }
+    const DataConverter* GetDataConverter() const override {
+        return device_.GetDataConverter();
+    }
+    const char* GetType() const override {
+        return "cpu";
+    }
+    RetCode Configure(uint32_t, ...) override {
+        return RC_UNSUPPORTED;
+    }
+
+public:
+    uint32_t realloc_count = 0;
+
+private:
+    utils::GenericCpuDevice device_;
+};
+
+/** output has the same shape as the first input. moves buffer of the input to output if `inplace` is true. */
+class PlanTestKernel final : public KernelImpl {
+public:
+    PlanTestKernel(const ir::Node* node, bool inplace, map<string, void*>* name2addr)
+        : KernelImpl(node), inplace_(inplace), name2addr_(name2addr) {}
+
+    RetCode Execute(KernelExecContext* ctx) override {
+        auto input = ctx->GetInput<TensorImpl>(0);
+        auto output = ctx->GetOutput<TensorImpl>(0);
+        *output->GetShape() = *input->GetShape();
+
+        if (inplace_ && input->GetType() == TENSORTYPE_NORMAL) {
+            output->TransferBufferFrom(input);
+        } else {
+            auto status = output->ReallocBuffer();
+            if (status != RC_SUCCESS) {
+                return status;
+            }
+        }
+
+        (*name2addr_)[output->GetName()] = output->GetBufferPtr();
+        return RC_SUCCESS;
+    }
+
+private:
+    bool inplace_;
+    map<string, void*>* name2addr_;
+};
+
+class SequentialSchedulerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // a -> b -> c(inplace) -> d
+        builder_.AddNode("a", ir::Node::Type("test", "op1", 1), {"input_of_a"}, {"output_of_a"});
+        builder_.AddNode("b", ir::Node::Type("test", "op1", 1), {"output_of_a"}, {"output_of_b"});
+        builder_.AddNode("c", ir::Node::Type("test", "op1", 1), {"output_of_b"}, {"output_of_c"});
+        builder_.AddNode("d", ir::Node::Type("test", "op1", 1), {"output_of_c"}, {"output_of_d"});
+        builder_.Finalize();
+
+        auto topo = builder_.GetGraph()->topo.get();
+        GenerateRuntimeAuxInfo(topo, &aux_info_);
+
+        graph_.nodeid2kernel.resize(topo->GetMaxNodeId());
+        for (auto it = topo->CreateNodeIter(); it->IsValid(); it->Forward()) {
+            auto node = it->Get();
+            auto kernel = new PlanTestKernel(node, (node->GetName() == "c"), &name2addr_);
+            kernel->SetDevice(&device_);
+            graph_.nodeid2kernel[node->GetId()].reset(kernel);
+        }
+
+        for (uint32_t i = 0; i < topo->GetInputCount(); ++i) {
+            auto edge = topo->GetEdgeById(topo->GetInput(i));
+            auto ret_pair = graph_.tensors.insert(make_pair(edge->GetId(), TensorImpl(edge, TENSORTYPE_RESERVED)));
+            auto tensor = &ret_pair.first->second;
+            tensor->SetDevice(&device_);
+            tensor->GetShape()->SetDataType(DATATYPE_FLOAT32);
+            tensor->GetShape()->Reshape({1, 3, 16, 16});
+            graph_.inputs.push_back(tensor);
+        }
+        for (uint32_t i = 0; i < topo->GetOutputCount(); ++i) {
+            auto edge = topo->GetEdgeById(topo->GetOutput(i));
+            auto ret_pair = graph_.tensors.insert(make_pair(edge->GetId(), TensorImpl(edge, TENSORTYPE_RESERVED)));
+            ret_pair.first->second.SetDevice(&device_);
+            graph_.outputs.push_back(&ret_pair.first->second);
+        }
+
+        profiler_.Init(&conf_, &graph_, &aux_info_);
+    }
+
+protected:
+    GraphBuilder builder_;
+    CountingDevice device_;
+    RuntimeAuxInfo aux_info_;
+    RuntimeGraph graph_;
+    RuntimeInternalConf conf_;
+    Profiler profiler_;
+    map<string, void*> name2addr_;
+};
+
+TEST_F(SequentialSchedulerTest, memory_plan) {
+    auto topo = builder_.GetGraph()->topo.get();
+
+    SequentialScheduler sched(true);
+    auto status = sched.Init(topo, &aux_info_, &graph_);
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    // generates plan
+    status = sched.Run(&profiler_);
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        device_.realloc_count = 0;
+        status = sched.Run(&profiler_);
+        EXPECT_EQ(RC_SUCCESS, status);
+        // only the output of the graph is allocated by device
+        EXPECT_EQ(1, device_.realloc_count);
+
+        // output_of_a and output_of_b are alive at the same time
+        EXPECT_NE(name2addr_["output_of_a"], name2addr_["output_of_b"]);
+        // c moves buffer from b
+        EXPECT_EQ(name2addr_["output_of_b"], name2addr_["output_of_c"]);
+    }
+
+    // changes input shape
+    graph_.inputs[0]->GetShape()->Reshape({1, 3, 32, 32});
+    device_.realloc_count = 0;
+    status = sched.Run(&profiler_);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_LT(1, device_.realloc_count);
+
+    device_.realloc_count = 0;
+    status = sched.Run(&profiler_);
+    EXPECT_EQ(RC_SUCCESS, status);
+    EXPECT_EQ(1, device_.realloc_count);
+}
+
+#ifdef PPLNN_ENABLE_KERNEL_PROFILING
+#include <fstream>
+#include <sstream>
+
+static uint32_t CountSubstr(const string& s, const string& sub) {
+    uint32_t count = 0;
+    for (auto pos = s.find(sub); pos != string::npos; pos = s.find(sub, pos + sub.size())) {
+        ++count;
+    }
+    return count;
+}
+
+TEST_F(SequentialSchedulerTest, trace) {
+    auto topo = builder_.GetGraph()->topo.get();
+
+    SequentialScheduler sched;
+    auto status = sched.Init(topo, &aux_info_, &graph_);
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    conf_.tracing_flag = true;
+    profiler_.StartTracing();
+    for (uint32_t i = 0; i < 2; ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        status = sched.Run(&profiler_);
+        EXPECT_EQ(RC_SUCCESS, status);
+        profiler_.TraceRun(begin);
+    }
+
+    const string filename = "sequential_scheduler_test_trace.json";
+    status = profiler_.SaveTrace(filename.c_str());
+    EXPECT_EQ(RC_SUCCESS, status);
+
+    ifstream ifs(filename);
+    stringstream ss;
+    ss << ifs.rdbuf();
+    auto content = ss.str();
+    remove(filename.c_str());
+
+    EXPECT_EQ(2, CountSubstr(content, "\"name\":\"Run\""));
+    EXPECT_EQ(8, CountSubstr(content, "\"cat\":\"kernel\""));
+    EXPECT_EQ(2, CountSubstr(content, "\"name\":\"c\""));
+    // outputs of a, b and d are allocated by device in each run. c reuses the buffer of b.
+    EXPECT_EQ(6, CountSubstr(content, "\"name\":\"Realloc\""));
+}
+#endif
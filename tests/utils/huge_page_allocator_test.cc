@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/huge_page_allocator.h"
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+using namespace std;
+using namespace ppl::nn;
+
+TEST(HugePageAllocatorTest, alloc_and_free) {
+    const uint64_t alignment = 64;
+    utils::HugePageAllocator ar(0, -1, alignment);
+
+    vector<void*> buffers;
+    for (uint32_t i = 1; i <= 16; ++i) {
+        auto addr = ar.Alloc(i * 100);
+        EXPECT_NE(nullptr, addr);
+        EXPECT_EQ(0, (uintptr_t)addr % alignment);
+        memset(addr, i, i * 100);
+        buffers.push_back(addr);
+    }
+    EXPECT_LT(0, ar.GetMappedBytes());
+
+    for (auto x = buffers.begin(); x != buffers.end(); ++x) {
+        ar.Free(*x);
+    }
+    // the current arena is kept for reuse
+    auto mapped = ar.GetMappedBytes();
+    auto addr = ar.Alloc(100);
+    EXPECT_EQ(buffers[0], addr);
+    EXPECT_EQ(mapped, ar.GetMappedBytes());
+    ar.Free(addr);
+}
+
+TEST(HugePageAllocatorTest, large_buffer) {
+    utils::HugePageAllocator ar(0, -1, 64);
+
+    auto small = ar.Alloc(128);
+    EXPECT_NE(nullptr, small);
+    auto mapped = ar.GetMappedBytes();
+
+    const uint64_t bytes = 64ull << 20;
+    auto large = ar.Alloc(bytes);
+    EXPECT_NE(nullptr, large);
+    EXPECT_LE(mapped + bytes, ar.GetMappedBytes());
+    memset(large, 0, bytes);
+
+    ar.Free(large);
+    EXPECT_EQ(mapped, ar.GetMappedBytes());
+    ar.Free(small);
+}
+
+TEST(HugePageAllocatorTest, full_arena_is_unmapped) {
+    utils::HugePageAllocator ar(0, -1, 64);
+
+    const uint64_t bytes = 12ull << 20;
+    auto a = ar.Alloc(bytes);
+    auto b = ar.Alloc(bytes);
+    auto mapped = ar.GetMappedBytes();
+    auto c = ar.Alloc(bytes); // does not fit in the first arena
+    EXPECT_NE(nullptr, c);
+    EXPECT_LT(mapped, ar.GetMappedBytes());
+
+    ar.Free(a);
+    ar.Free(b);
+    EXPECT_EQ(mapped, ar.GetMappedBytes());
+    ar.Free(c);
+}
+
+TEST(HugePageAllocatorTest, huge_page) {
+    // falls back to transparent huge pages if no huge page is reserved
+    utils::HugePageAllocator ar(utils::HugePageAllocator::kPageSize2M, -1, 64);
+
+    auto addr = ar.Alloc(4096);
+    EXPECT_NE(nullptr, addr);
+    EXPECT_EQ(0, (uintptr_t)addr % utils::HugePageAllocator::kPageSize2M);
+    memset(addr, 0, 4096);
+    EXPECT_EQ(0, ar.GetMappedBytes() % utils::HugePageAllocator::kPageSize2M);
+    ar.Free(addr);
+}
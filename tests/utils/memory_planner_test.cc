@@ -0,0 +1,63 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "ppl/nn/utils/memory_planner.h"
+#include "gtest/gtest.h"
+using namespace std;
+using namespace ppl::nn;
+
+TEST(MemoryPlannerTest, reuse_after_free) {
+    vector<utils::MemoryBlock> blocks = {
+        {100, 0, 1},
+        {200, 1, 2},
+        {100, 2, 3}, // can reuse the first block
+    };
+
+    vector<uint64_t> offsets;
+    auto arena_bytes = utils::PlanMemoryBlocks(blocks, 64, &offsets);
+    EXPECT_EQ(3, offsets.size());
+    EXPECT_EQ(0, offsets[1]);
+    EXPECT_EQ(offsets[0], offsets[2]);
+    EXPECT_EQ(256 + 128, arena_bytes);
+    EXPECT_EQ(300, utils::CalcPeakMemoryBytes(blocks));
+}
+
+TEST(MemoryPlannerTest, overlapped_blocks) {
+    vector<utils::MemoryBlock> blocks = {
+        {64, 0, 3},
+        {128, 1, 2},
+        {32, 2, 2},
+        {256, 4, 5}, // reuses space of all blocks above
+    };
+
+    vector<uint64_t> offsets;
+    auto arena_bytes = utils::PlanMemoryBlocks(blocks, 32, &offsets);
+
+    for (uint32_t i = 0; i < blocks.size(); ++i) {
+        EXPECT_EQ(0, offsets[i] % 32);
+        for (uint32_t j = i + 1; j < blocks.size(); ++j) {
+            if (blocks[i].first <= blocks[j].last && blocks[j].first <= blocks[i].last) {
+                bool disjoint = (offsets[i] + blocks[i].bytes <= offsets[j] ||
+                                 offsets[j] + blocks[j].bytes <= offsets[i]);
+                EXPECT_TRUE(disjoint);
+            }
+        }
+    }
+
+    EXPECT_EQ(256, arena_bytes);
+    EXPECT_EQ(256, utils::CalcPeakMemoryBytes(blocks));
+}
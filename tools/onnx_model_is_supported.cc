@@ -37,8 +37,16 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    string model_dir(model_file);
+    auto pos = model_dir.find_last_of("/\\");
+    if (pos == string::npos) {
+        model_dir = ".";
+    } else {
+        model_dir.resize(pos);
+    }
+
     ir::Graph graph;
-    status = ppl::nn::onnx::ModelParser::Parse(fm.Data(), fm.Size(), &graph);
+    status = ppl::nn::onnx::ModelParser::Parse(fm.Data(), fm.Size(), model_dir.c_str(), &graph);
     if (status != RC_SUCCESS) {
         LOG(ERROR) << "parse model failed: " << GetRetCodeStr(status);
         return 1;
@@ -62,6 +62,9 @@ Define_string_opt("--in-shapes", g_flag_input_shapes, "",
                   "shapes of input tensors."
                   " dims are separated by underline, inputs are separated by comma. example:"
                   " 1_3_128_128,2_3_400_640,3_3_768_1024");
+Define_bool_opt("--specialize-in-shapes", g_flag_specialize_input_shapes, false,
+                "build the graph for shapes specified by '--in-shapes' and fold shape computations into constants."
+                " inputs of other shapes are rejected.");
 
 Define_bool_opt("--save-input", g_flag_save_input, false, "save input tensors in one file in NDARRAY format");
 Define_bool_opt("--save-inputs", g_flag_save_inputs, false, "save separated input tensors in NDARRAY format");
@@ -69,9 +72,39 @@ Define_bool_opt("--save-outputs", g_flag_save_outputs, false, "save separated ou
 Define_string_opt("--save-data-dir", g_flag_save_data_dir, ".",
                   "directory to save input/output data if '--save-*' options are enabled.");
 Define_bool_opt("--perf-with-io", g_flag_perf_with_io, false, "profiling with io copy");
+Define_string_opt("--trace-file", g_flag_trace_file, "",
+                  "save timelines of kernels and buffer allocations of all runs to this file in Chrome trace format."
+                  " requires PPLNN_ENABLE_KERNEL_PROFILING");
+
+Define_uint32_opt("--sched-threads", g_flag_sched_threads, 1,
+                  "number of threads used to run independent kernels in parallel. 1 => sequential scheduler,"
+                  " 0 => use all hardware threads");
+Define_bool_opt("--enable-memory-plan", g_flag_enable_memory_plan, false,
+                "assign intermediate tensors fixed offsets in one arena after the first run."
+                " works with the sequential scheduler only");
+
+Define_string_opt("--quant-file", g_flag_quant_file, "",
+                  "a json file containing quantization information. used by cuda and x86 engines");
 
 /* -------------------------------------------------------------------------- */
 
+static RetCode ReadFileContent(const char* fname, string* buf) {
+    ifstream ifile;
+
+    ifile.open(fname, ios_base::in);
+    if (!ifile.is_open()) {
+        LOG(ERROR) << "open file[" << fname << "] failed.";
+        return RC_NOT_FOUND;
+    }
+
+    stringstream ss;
+    ss << ifile.rdbuf();
+    *buf = ss.str();
+
+    ifile.close();
+    return RC_SUCCESS;
+}
+
 template <typename T>
 static string ToString(T v) {
     stringstream ss;
@@ -185,29 +218,10 @@ Define_string_opt("--export-algo-file", g_flag_export_algo_file, "",
 Define_string_opt("--import-algo-file", g_flag_import_algo_file, "",
                   "The objects in the json file declare best algo info for certain conv input shape");
 
-Define_string_opt("--quant-file", g_flag_quant_file, "", "a json file containing quantization information");
-
 #include "ppl/nn/engines/cuda/engine_factory.h"
 #include "ppl/nn/engines/cuda/cuda_options.h"
 #include "ppl/nn/utils/array.h"
 
-static RetCode ReadFileContent(const char* fname, string* buf) {
-    ifstream ifile;
-
-    ifile.open(fname, ios_base::in);
-    if (!ifile.is_open()) {
-        LOG(ERROR) << "open file[" << fname << "] failed.";
-        return RC_NOT_FOUND;
-    }
-
-    stringstream ss;
-    ss << ifile.rdbuf();
-    *buf = ss.str();
-
-    ifile.close();
-    return RC_SUCCESS;
-}
-
 static inline bool RegisterCudaEngine(vector<unique_ptr<Engine>>* engines) {
     CudaEngineOptions options;
     options.device_id = g_flag_device_id;
@@ -303,7 +317,23 @@ Define_bool_opt("--use-x86", g_flag_use_x86, false, "use x86 engine");
 
 Define_bool_opt("--disable-avx512", g_flag_disable_avx512, false, "disable avx512 feature");
 Define_bool_opt("--disable-avx-fma3", g_flag_disable_avx_fma3, false, "disable avx, fma3 and avx512 feature");
-Define_bool_opt("--core-binding", g_flag_core_binding, false, "core binding");
+Define_bool_opt("--core-binding", g_flag_core_binding, false, "bind kernel threads of the runtime to cores [0, num-threads)");
+Define_uint32_opt("--num-threads", g_flag_num_threads, 0, "number of threads the x86 runtime uses. 0 means omp default");
+Define_bool_opt("--use-bf16", g_flag_use_bf16, false,
+                "run conv/gemm/matmul with bf16 weights on avx512-bf16 or amx-bf16, fall back to fp32 if unavailable");
+Define_string_opt("--huge-page", g_flag_huge_page, "none",
+                  "huge pages for weights and runtime buffers of x86 engine: none, 2m or 1g. linux only");
+Define_int32_opt("--numa-node-id", g_flag_numa_node_id, -1,
+                 "bind weights and runtime buffers of x86 engine to specified numa node, -1 means not bind");
+
+Define_int32_opt("--tuning-level", g_flag_tuning_level, 0, "select conv algo dynamic tuning level[0-1]. 0: off. 1: on");
+Define_string_opt("--tuning-cache-file", g_flag_tuning_cache_file, "",
+                  "a file to load and save conv algo tuning results, used when tuning-level is not 0");
+
+Define_string_opt("--export-packed-weights-file", g_flag_export_packed_weights_file, "",
+                  "export selected algorithms and converted weights of kernels into the file");
+Define_string_opt("--import-packed-weights-file", g_flag_import_packed_weights_file, "",
+                  "import selected algorithms and converted weights of kernels from the file");
 
 #include "ppl/nn/engines/x86/engine_factory.h"
 #include "ppl/nn/engines/x86/x86_options.h"
@@ -316,8 +346,26 @@ static inline bool RegisterX86Engine(vector<unique_ptr<Engine>>* engines) {
     } else if (g_flag_mm_policy == "mem") {
         options.mm_policy = X86_MM_COMPACT;
     }
+    options.dynamic_tuning_level = g_flag_tuning_level;
+    options.num_threads = g_flag_num_threads;
+    if (g_flag_use_bf16) {
+        options.forward_precision = ppl::common::DATATYPE_BFLOAT16;
+    }
+    if (g_flag_huge_page == "2m") {
+        options.huge_page = X86_HUGE_PAGE_2M;
+    } else if (g_flag_huge_page == "1g") {
+        options.huge_page = X86_HUGE_PAGE_1G;
+    } else if (g_flag_huge_page != "none") {
+        LOG(ERROR) << "unknown huge page option [" << g_flag_huge_page << "]";
+        return false;
+    }
+    options.numa_node_id = g_flag_numa_node_id;
 
     auto x86_engine = X86EngineFactory::Create(options);
+    if (!x86_engine) {
+        LOG(ERROR) << "create x86 engine failed.";
+        return false;
+    }
     if (g_flag_disable_avx512) {
         x86_engine->Configure(ppl::nn::X86_CONF_DISABLE_AVX512);
     }
@@ -325,8 +373,49 @@ static inline bool RegisterX86Engine(vector<unique_ptr<Engine>>* engines) {
         x86_engine->Configure(ppl::nn::X86_CONF_DISABLE_AVX_FMA3);
     }
     if (g_flag_core_binding) {
-        ppl::kernel::x86::set_omp_core_binding(nullptr, 0, 1);
+        uint32_t num_cores = g_flag_num_threads;
+        if (num_cores == 0) {
+            num_cores = ppl::kernel::x86::get_omp_max_threads();
+        }
+        vector<int32_t> cores(num_cores);
+        for (uint32_t i = 0; i < num_cores; ++i) {
+            cores[i] = i;
+        }
+        x86_engine->Configure(ppl::nn::X86_CONF_SET_CORE_BINDING, cores.data(), num_cores);
     }
+
+    if (!g_flag_tuning_cache_file.empty()) {
+        x86_engine->Configure(ppl::nn::X86_CONF_SET_TUNING_CACHE_FILE, g_flag_tuning_cache_file.c_str());
+    }
+
+    if (!g_flag_export_packed_weights_file.empty()) {
+        x86_engine->Configure(ppl::nn::X86_CONF_EXPORT_PACKED_WEIGHTS, g_flag_export_packed_weights_file.c_str());
+    }
+
+    if (!g_flag_quant_file.empty()) {
+        string file_content;
+        auto status = ReadFileContent(g_flag_quant_file.c_str(), &file_content);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "read file[" << g_flag_quant_file << "] failed: " << GetRetCodeStr(status);
+            return false;
+        }
+        x86_engine->Configure(ppl::nn::X86_CONF_SET_QUANT_INFO, file_content.c_str());
+    }
+
+    if (!g_flag_import_packed_weights_file.empty()) {
+        bool skip_import = false;
+        // import and export from the same file
+        if (g_flag_import_packed_weights_file == g_flag_export_packed_weights_file) {
+            // file will be generated in this run if it does not exist
+            ifstream ifs(g_flag_import_packed_weights_file);
+            skip_import = !ifs.is_open();
+        }
+
+        if (!skip_import) {
+            x86_engine->Configure(ppl::nn::X86_CONF_IMPORT_PACKED_WEIGHTS, g_flag_import_packed_weights_file.c_str());
+        }
+    }
+
     // configure engine
     engines->emplace_back(unique_ptr<Engine>(x86_engine));
     LOG(INFO) << "***** register X86Engine *****";
@@ -1067,8 +1156,21 @@ int main(int argc, char* argv[]) {
         for (uint32_t i = 0; i < engines.size(); ++i) {
             engine_ptrs[i] = engines[i].get();
         }
-        auto builder = unique_ptr<RuntimeBuilder>(
-            OnnxRuntimeBuilderFactory::Create(g_flag_onnx_model.c_str(), engine_ptrs.data(), engine_ptrs.size()));
+
+        OnnxRuntimeBuilderOptions builder_options;
+        if (g_flag_specialize_input_shapes) {
+            if (g_flag_input_shapes.empty()) {
+                LOG(ERROR) << "'--specialize-in-shapes' requires '--in-shapes'.";
+                return -1;
+            }
+            if (!ParseInputShapes(g_flag_input_shapes, &builder_options.input_dims)) {
+                LOG(ERROR) << "ParseInputShapes failed.";
+                return -1;
+            }
+        }
+
+        auto builder = unique_ptr<RuntimeBuilder>(OnnxRuntimeBuilderFactory::Create(
+            g_flag_onnx_model.c_str(), engine_ptrs.data(), engine_ptrs.size(), builder_options));
         if (!builder) {
             LOG(ERROR) << "create RuntimeBuilder failed.";
             return -1;
@@ -1082,6 +1184,26 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    if (g_flag_sched_threads != 1) {
+        status = runtime->Configure(RUNTIME_CONF_SCHED_PARALLEL, g_flag_sched_threads);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "use parallel scheduler failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    }
+
+    if (g_flag_enable_memory_plan) {
+        if (g_flag_sched_threads != 1) {
+            LOG(ERROR) << "'--enable-memory-plan' cannot be used with '--sched-threads'.";
+            return -1;
+        }
+        status = runtime->Configure(RUNTIME_CONF_SET_MEMORY_PLAN_FLAG, true);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "enable memory plan failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    }
+
     vector<vector<int64_t>> input_shapes;
     if (!g_flag_input_shapes.empty()) {
         if (!ParseInputShapes(g_flag_input_shapes, &input_shapes)) {
@@ -1137,6 +1259,14 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (!g_flag_trace_file.empty()) {
+        status = runtime->Configure(RUNTIME_CONF_SET_TRACING_FLAG, true);
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "enable tracing failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    }
+
     auto prepare_end_ts = std::chrono::system_clock::now();
     auto prepare_diff = std::chrono::duration_cast<std::chrono::microseconds>(prepare_end_ts - prepare_begin_ts);
     LOG(INFO) << "Prepare costs: " << (float)prepare_diff.count() / 1000 << " ms.";
@@ -1169,5 +1299,13 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (!g_flag_trace_file.empty()) {
+        status = runtime->Configure(RUNTIME_CONF_SAVE_TRACE, g_flag_trace_file.c_str());
+        if (status != RC_SUCCESS) {
+            LOG(ERROR) << "save trace to [" << g_flag_trace_file << "] failed: " << GetRetCodeStr(status);
+            return -1;
+        }
+    }
+
     return 0;
 }
@@ -79,6 +79,9 @@ def ParseCommandLineArgs():
                                 default = False, required = False)
             parser.add_argument("--disable-avx-fma3", dest = "disable_avx_fma3", action = "store_true",
                                 default = False, required = False)
+            parser.add_argument("--use-bf16", dest = "use_bf16", action = "store_true",
+                                default = False, required = False,
+                                help = "run conv/gemm/matmul with bf16 weights on avx512-bf16 or amx-bf16.")
         elif dev == "cuda":
             parser.add_argument("--quick-select", dest = "quick_select", action = "store_true",
                                 default = False, required = False)
@@ -155,6 +158,8 @@ def CreateX86Engine(args):
         x86_options.mm_policy = pplnn.X86_MM_MRU
     elif args.mm_policy == "mem":
         x86_options.mm_policy = pplnn.X86_MM_COMPACT
+    if args.use_bf16:
+        x86_options.forward_precision = pplcommon.DATATYPE_BFLOAT16
 
     x86_engine = pplnn.X86EngineFactory.Create(x86_options)
     if not x86_engine:
@@ -461,7 +466,7 @@ def SaveOutputsOneByOne(save_data_dir, runtime):
         dims = tensor.GetShape().GetDims()
         element_count = CalcElementCount(dims)
         if element_count > 0:
-            tensor_data = tensor.ConvertToHost()
+            tensor_data = tensor.GetHostView()
             if not tensor_data:
                 logging.error("copy data from tensor[" + tensor.GetName() + "] failed.")
                 sys.exit(-1)